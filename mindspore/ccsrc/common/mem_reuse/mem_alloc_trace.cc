@@ -0,0 +1,184 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/mem_reuse/mem_alloc_trace.h"
+#include <cstring>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+constexpr size_t kMemAllocTraceMagicSize = 8;
+constexpr size_t kByteBits = 8;
+
+template <typename T>
+bool ReadValue(std::ifstream *ifs, T *value) {
+  uint8_t bytes[sizeof(T)];
+  if (!ifs->read(reinterpret_cast<char *>(bytes), sizeof(T))) {
+    return false;
+  }
+  T result = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    result |= static_cast<T>(bytes[i]) << (i * kByteBits);
+  }
+  *value = result;
+  return true;
+}
+}  // namespace
+
+bool MemAllocTraceRecorder::Open(const std::string &file_path) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (ofs_.is_open()) {
+    MS_LOG(WARNING) << "The memory alloc trace is recording to " << file_path_ << ", can not record to " << file_path;
+    return false;
+  }
+  ofs_.open(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!ofs_.is_open()) {
+    MS_LOG(ERROR) << "Open memory alloc trace file " << file_path << " failed.";
+    return false;
+  }
+  (void)ofs_.write(kMemAllocTraceMagic, kMemAllocTraceMagicSize);
+  Write<uint32_t>(kMemAllocTraceVersion);
+  Write<uint32_t>(0);
+  file_path_ = file_path;
+  start_time_ = std::chrono::steady_clock::now();
+  name_ids_.clear();
+  record_count_ = 0;
+  enabled_ = true;
+  MS_LOG(INFO) << "Start recording the memory alloc trace to " << file_path;
+  return true;
+}
+
+void MemAllocTraceRecorder::Close() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (!ofs_.is_open()) {
+    return;
+  }
+  enabled_ = false;
+  ofs_.close();
+  MS_LOG(INFO) << "Stop recording the memory alloc trace to " << file_path_ << ", record count: " << record_count_;
+}
+
+void MemAllocTraceRecorder::RecordAlloc(const void *device_addr, size_t size, uint8_t flags,
+                                        const std::string &allocator_name, uint8_t allocator_type) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (!ofs_.is_open()) {
+    return;
+  }
+  auto iter = name_ids_.find(allocator_name);
+  if (iter == name_ids_.end()) {
+    iter = name_ids_.emplace(allocator_name, static_cast<uint32_t>(name_ids_.size())).first;
+    Write<uint8_t>(static_cast<uint8_t>(MemAllocTraceRecordType::kName));
+    Write<uint32_t>(iter->second);
+    Write<uint32_t>(static_cast<uint32_t>(allocator_name.size()));
+    (void)ofs_.write(allocator_name.data(), static_cast<std::streamsize>(allocator_name.size()));
+  }
+  Write<uint8_t>(static_cast<uint8_t>(MemAllocTraceRecordType::kAlloc));
+  Write<uint8_t>(flags);
+  Write<uint8_t>(allocator_type);
+  Write<uint32_t>(iter->second);
+  Write<uint64_t>(size);
+  Write<uint64_t>(reinterpret_cast<uintptr_t>(device_addr));
+  Write<uint64_t>(Timestamp());
+  ++record_count_;
+}
+
+void MemAllocTraceRecorder::RecordFree(const void *device_addr) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (!ofs_.is_open()) {
+    return;
+  }
+  Write<uint8_t>(static_cast<uint8_t>(MemAllocTraceRecordType::kFree));
+  Write<uint64_t>(reinterpret_cast<uintptr_t>(device_addr));
+  Write<uint64_t>(Timestamp());
+  ++record_count_;
+}
+
+template <typename T>
+void MemAllocTraceRecorder::Write(T value) {
+  char bytes[sizeof(T)];
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    bytes[i] = static_cast<char>((value >> (i * kByteBits)) & 0xFF);
+  }
+  (void)ofs_.write(bytes, sizeof(T));
+}
+
+uint64_t MemAllocTraceRecorder::Timestamp() const {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time_).count());
+}
+
+bool ReadMemAllocTrace(const std::string &file_path, std::vector<MemAllocTraceEvent> *events) {
+  MS_EXCEPTION_IF_NULL(events);
+  std::ifstream ifs(file_path, std::ios::in | std::ios::binary);
+  if (!ifs.is_open()) {
+    MS_LOG(ERROR) << "Open memory alloc trace file " << file_path << " failed.";
+    return false;
+  }
+  char magic[kMemAllocTraceMagicSize] = {0};
+  uint32_t version = 0;
+  uint32_t reserved = 0;
+  if (!ifs.read(magic, kMemAllocTraceMagicSize) || memcmp(magic, kMemAllocTraceMagic, kMemAllocTraceMagicSize) != 0 ||
+      !ReadValue(&ifs, &version) || !ReadValue(&ifs, &reserved)) {
+    MS_LOG(ERROR) << "The file " << file_path << " is not a memory alloc trace file.";
+    return false;
+  }
+  if (version != kMemAllocTraceVersion) {
+    MS_LOG(ERROR) << "The version " << version << " of memory alloc trace file " << file_path << " is not supported.";
+    return false;
+  }
+
+  std::vector<std::string> names;
+  uint8_t type = 0;
+  while (ReadValue(&ifs, &type)) {
+    bool ret = false;
+    if (type == static_cast<uint8_t>(MemAllocTraceRecordType::kName)) {
+      uint32_t name_id = 0;
+      uint32_t name_len = 0;
+      ret = ReadValue(&ifs, &name_id) && ReadValue(&ifs, &name_len) && name_id == names.size();
+      if (ret) {
+        std::string name(name_len, '\0');
+        ret = static_cast<bool>(ifs.read(&name[0], name_len));
+        names.emplace_back(std::move(name));
+      }
+    } else if (type == static_cast<uint8_t>(MemAllocTraceRecordType::kAlloc)) {
+      MemAllocTraceEvent event;
+      uint32_t name_id = 0;
+      ret = ReadValue(&ifs, &event.flags_) && ReadValue(&ifs, &event.allocator_type_) && ReadValue(&ifs, &name_id) &&
+            ReadValue(&ifs, &event.size_) && ReadValue(&ifs, &event.device_addr_) &&
+            ReadValue(&ifs, &event.timestamp_) && name_id < names.size();
+      if (ret) {
+        event.allocator_name_ = names[name_id];
+        events->emplace_back(std::move(event));
+      }
+    } else if (type == static_cast<uint8_t>(MemAllocTraceRecordType::kFree)) {
+      MemAllocTraceEvent event;
+      event.type_ = MemAllocTraceRecordType::kFree;
+      ret = ReadValue(&ifs, &event.device_addr_) && ReadValue(&ifs, &event.timestamp_);
+      if (ret) {
+        events->emplace_back(std::move(event));
+      }
+    }
+    if (!ret) {
+      MS_LOG(ERROR) << "The memory alloc trace file " << file_path << " is broken after " << events->size()
+                    << " events.";
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace device
+}  // namespace mindspore
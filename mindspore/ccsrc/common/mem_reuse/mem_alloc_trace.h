@@ -0,0 +1,93 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_ALLOC_TRACE_H_
+#define MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_ALLOC_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace device {
+// The binary trace file of memory pool is composed of the header and the records in little endian:
+//   header: magic "MSMEMTRC"(8 bytes), version(uint32), reserved(uint32).
+//   name record: type(uint8) = 0, name id(uint32), name length(uint32), name bytes.
+//   alloc record: type(uint8) = 1, flags(uint8), allocator type(uint8), name id(uint32), size(uint64),
+//                 device address(uint64), timestamp in microseconds(uint64).
+//   free record: type(uint8) = 2, device address(uint64), timestamp in microseconds(uint64).
+// The size of alloc record is the size requested by the caller, and the device address is 0 if the alloc fails.
+// The name of allocator is recorded once by the name record and referred by the name id in the alloc records.
+constexpr char kMemAllocTraceMagic[] = "MSMEMTRC";
+constexpr uint32_t kMemAllocTraceVersion = 1;
+
+enum class MemAllocTraceRecordType : uint8_t { kName = 0, kAlloc = 1, kFree = 2 };
+
+// The flags of alloc record.
+constexpr uint8_t kMemAllocTraceFlagPersistent = 1;
+constexpr uint8_t kMemAllocTraceFlagContinuous = 1 << 1;
+
+struct MemAllocTraceEvent {
+  MemAllocTraceRecordType type_{MemAllocTraceRecordType::kAlloc};
+  uint8_t flags_{0};
+  uint8_t allocator_type_{0};
+  std::string allocator_name_;
+  uint64_t size_{0};
+  uint64_t device_addr_{0};
+  uint64_t timestamp_{0};
+};
+
+// Record the alloc and free of memory pool to the binary trace file, it can be called by multiple threads.
+class MemAllocTraceRecorder {
+ public:
+  MemAllocTraceRecorder() = default;
+  ~MemAllocTraceRecorder() { Close(); }
+
+  bool Open(const std::string &file_path);
+  void Close();
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  void RecordAlloc(const void *device_addr, size_t size, uint8_t flags, const std::string &allocator_name,
+                   uint8_t allocator_type);
+  void RecordFree(const void *device_addr);
+
+ private:
+  DISABLE_COPY_AND_ASSIGN(MemAllocTraceRecorder);
+  template <typename T>
+  void Write(T value);
+  uint64_t Timestamp() const;
+
+  std::atomic<bool> enabled_{false};
+  std::mutex mutex_;
+  std::ofstream ofs_;
+  std::string file_path_;
+  std::chrono::steady_clock::time_point start_time_;
+  std::unordered_map<std::string, uint32_t> name_ids_;
+  size_t record_count_{0};
+};
+
+// Read all the alloc and free events from the binary trace file, the name records are resolved to the allocator names.
+bool ReadMemAllocTrace(const std::string &file_path, std::vector<MemAllocTraceEvent> *events);
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_ALLOC_TRACE_H_
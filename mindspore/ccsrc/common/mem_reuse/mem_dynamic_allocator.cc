@@ -15,7 +15,10 @@
  */
 
 #include "common/mem_reuse/mem_dynamic_allocator.h"
+#include <cstdint>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include "include/common/utils/convert_utils.h"
 #include "utils/log_adapter.h"
 #include "utils/ms_context.h"
@@ -43,6 +46,221 @@ static const std::map<AllocatorType, std::string> kAllocatorTypeString = {
   {AllocatorType::kOther, "other"},
 };
 
+namespace {
+// The size classes are 512, 1024, 1536, 2048 and then four geometric steps per power of two up to
+// SIZE_CLASS_MAX_SIZE, so the internal fragmentation of a size class is not larger than 25%.
+constexpr size_t kSizeClassLinearNum = 4;
+constexpr size_t kSizeClassLinearMax = DYNAMIC_MEM_ALIGN_SIZE * kSizeClassLinearNum;
+constexpr size_t kSizeClassStepsPerPower = 4;
+constexpr size_t kSizeClassLinearMaxPower = 11;
+constexpr size_t kSizeClassNum = 40;
+// The maximum count of the device addresses cached by one thread for each size class.
+constexpr size_t kThreadCacheMaxCount = 64;
+// The count of the device addresses moved between the thread cache and the central free list once.
+constexpr size_t kSizeClassBatchCount = 16;
+// The shard count of the device address registry.
+constexpr size_t kRegistryShardNum = 64;
+
+size_t SizeClassIndex(size_t size) {
+  if (size <= kSizeClassLinearMax) {
+    return (size - 1) / DYNAMIC_MEM_ALIGN_SIZE;
+  }
+  size_t power = kSizeClassLinearMaxPower;
+  while (((size - 1) >> (power + 1)) != 0) {
+    ++power;
+  }
+  size_t base = static_cast<size_t>(1) << power;
+  size_t step = base / kSizeClassStepsPerPower;
+  return kSizeClassLinearNum + (power - kSizeClassLinearMaxPower) * kSizeClassStepsPerPower + (size - 1 - base) / step;
+}
+
+size_t SizeClassSize(size_t index) {
+  if (index < kSizeClassLinearNum) {
+    return (index + 1) * DYNAMIC_MEM_ALIGN_SIZE;
+  }
+  size_t base = kSizeClassLinearMax << ((index - kSizeClassLinearNum) / kSizeClassStepsPerPower);
+  return base + ((index - kSizeClassLinearNum) % kSizeClassStepsPerPower + 1) * (base / kSizeClassStepsPerPower);
+}
+
+struct SizeClassThreadCache;
+}  // namespace
+
+// The central free lists shared by all threads and the registry of the device addresses owned by the size classes.
+// The device addresses in the size classes are still the used memory bufs of the best fit pool.
+class SizeClassCentral {
+ public:
+  SizeClassCentral() : id_(next_id_.fetch_add(1)) {}
+  ~SizeClassCentral() = default;
+
+  size_t id() const { return id_; }
+  size_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+  std::atomic<size_t> &cached_size() { return cached_size_; }
+
+  void Register(const DeviceMemPtr &device_addr, size_t index) {
+    auto shard = Shard(device_addr);
+    std::lock_guard<std::mutex> locker(shard_mutex_[shard]);
+    registry_[shard][device_addr] = index;
+  }
+
+  bool Find(const DeviceMemPtr &device_addr, size_t *index) {
+    auto shard = Shard(device_addr);
+    std::lock_guard<std::mutex> locker(shard_mutex_[shard]);
+    const auto &iter = registry_[shard].find(device_addr);
+    if (iter == registry_[shard].end()) {
+      return false;
+    }
+    *index = iter->second;
+    return true;
+  }
+
+  void Unregister(const DeviceMemPtr &device_addr) {
+    auto shard = Shard(device_addr);
+    std::lock_guard<std::mutex> locker(shard_mutex_[shard]);
+    (void)registry_[shard].erase(device_addr);
+  }
+
+  // Move the tail of the thread free list to the central free list, drop them if they are from the old epoch.
+  void Push(size_t index, size_t epoch, std::vector<DeviceMemPtr> *from, size_t count) {
+    count = std::min(count, from->size());
+    std::lock_guard<std::mutex> locker(list_mutex_[index]);
+    if (epoch == epoch_.load(std::memory_order_acquire)) {
+      (void)free_lists_[index].insert(free_lists_[index].end(), from->end() - count, from->end());
+    }
+    from->resize(from->size() - count);
+  }
+
+  void Pop(size_t index, std::vector<DeviceMemPtr> *to, size_t count) {
+    std::lock_guard<std::mutex> locker(list_mutex_[index]);
+    auto &free_list = free_lists_[index];
+    count = std::min(count, free_list.size());
+    (void)to->insert(to->end(), free_list.end() - count, free_list.end());
+    free_list.resize(free_list.size() - count);
+  }
+
+  void AddThreadCache(SizeClassThreadCache *cache) {
+    std::lock_guard<std::mutex> locker(cache_mutex_);
+    (void)thread_caches_.insert(cache);
+  }
+
+  void RemoveThreadCache(SizeClassThreadCache *cache) {
+    std::lock_guard<std::mutex> locker(cache_mutex_);
+    (void)thread_caches_.erase(cache);
+  }
+
+  // Take the device addresses cached by all the threads and the central free lists.
+  void TakeAll(std::vector<DeviceMemPtr> *to);
+
+  void TakeAllFromCentral(std::vector<DeviceMemPtr> *to) {
+    for (size_t i = 0; i < kSizeClassNum; ++i) {
+      std::lock_guard<std::mutex> locker(list_mutex_[i]);
+      (void)to->insert(to->end(), free_lists_[i].begin(), free_lists_[i].end());
+      free_lists_[i].clear();
+    }
+  }
+
+  // Invalidate all the cached device addresses, which is used when the device memory is released.
+  void Reset() {
+    (void)epoch_.fetch_add(1, std::memory_order_acq_rel);
+    for (size_t i = 0; i < kSizeClassNum; ++i) {
+      std::lock_guard<std::mutex> locker(list_mutex_[i]);
+      free_lists_[i].clear();
+    }
+    for (size_t i = 0; i < kRegistryShardNum; ++i) {
+      std::lock_guard<std::mutex> locker(shard_mutex_[i]);
+      registry_[i].clear();
+    }
+    cached_size_ = 0;
+  }
+
+ private:
+  static size_t Shard(const DeviceMemPtr &device_addr) {
+    return (reinterpret_cast<uintptr_t>(device_addr) / DYNAMIC_MEM_ALIGN_SIZE) % kRegistryShardNum;
+  }
+
+  static std::atomic<size_t> next_id_;
+  size_t id_;
+  std::atomic<size_t> epoch_{0};
+  std::atomic<size_t> cached_size_{0};
+  std::mutex list_mutex_[kSizeClassNum];
+  std::vector<DeviceMemPtr> free_lists_[kSizeClassNum];
+  std::mutex shard_mutex_[kRegistryShardNum];
+  std::unordered_map<DeviceMemPtr, size_t> registry_[kRegistryShardNum];
+  std::mutex cache_mutex_;
+  std::set<SizeClassThreadCache *> thread_caches_;
+};
+std::atomic<size_t> SizeClassCentral::next_id_{0};
+
+namespace {
+// The size class free lists of one thread, which are returned to the central free lists when the thread exits.
+// The mutex is taken by the owner thread, and by the flush from any thread, so it is not contended mostly.
+struct SizeClassThreadCache {
+  ~SizeClassThreadCache() {
+    auto central = central_.lock();
+    if (central == nullptr) {
+      return;
+    }
+    central->RemoveThreadCache(this);
+    std::lock_guard<std::mutex> locker(mutex_);
+    for (size_t i = 0; i < kSizeClassNum; ++i) {
+      central->Push(i, epoch_, &free_lists_[i], free_lists_[i].size());
+    }
+  }
+
+  // The device memory has been released, the cached device addresses are invalid. It is called with the mutex held.
+  void CheckEpoch(size_t epoch) {
+    if (epoch_ == epoch) {
+      return;
+    }
+    for (auto &free_list : free_lists_) {
+      free_list.clear();
+    }
+    epoch_ = epoch;
+  }
+
+  std::mutex mutex_;
+  std::weak_ptr<SizeClassCentral> central_;
+  size_t epoch_{0};
+  std::vector<DeviceMemPtr> free_lists_[kSizeClassNum];
+};
+
+SizeClassThreadCache *GetSizeClassThreadCache(const SizeClassCentralPtr &central) {
+  static thread_local std::unordered_map<size_t, SizeClassThreadCache> thread_caches;
+  static thread_local size_t last_id = SIZE_MAX;
+  static thread_local SizeClassThreadCache *last_cache = nullptr;
+  MS_EXCEPTION_IF_NULL(central);
+  if (last_id != central->id()) {
+    last_cache = &thread_caches[central->id()];
+    last_id = central->id();
+    if (last_cache->central_.expired()) {
+      last_cache->central_ = central;
+      last_cache->epoch_ = central->epoch();
+      central->AddThreadCache(last_cache);
+    }
+  }
+  return last_cache;
+}
+}  // namespace
+
+void SizeClassCentral::TakeAll(std::vector<DeviceMemPtr> *to) {
+  {
+    std::lock_guard<std::mutex> locker(cache_mutex_);
+    for (auto cache : thread_caches_) {
+      std::lock_guard<std::mutex> cache_locker(cache->mutex_);
+      cache->CheckEpoch(epoch());
+      for (auto &free_list : cache->free_lists_) {
+        (void)to->insert(to->end(), free_list.begin(), free_list.end());
+        free_list.clear();
+      }
+    }
+  }
+  TakeAllFromCentral(to);
+}
+
+DynamicMemPoolBestFit::DynamicMemPoolBestFit()
+    : persistent_mem_(std::make_shared<MemStatusManager>()),
+      common_mem_(std::make_shared<MemStatusManager>()),
+      size_class_central_(std::make_shared<SizeClassCentral>()) {}
+
 DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
   persistent_mem_->clear();
   common_mem_->clear();
@@ -50,6 +268,107 @@ DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
 
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persistent_mem) {
   size_t align_size = AlignMemorySize(size);
+  DeviceMemPtr device_addr = nullptr;
+  if (enable_size_class_ && !from_persistent_mem && align_size <= SIZE_CLASS_MAX_SIZE) {
+    device_addr = AllocSizeClassMem(align_size);
+  } else {
+    device_addr = AllocBestFitMem(align_size, from_persistent_mem);
+  }
+  if (alloc_trace_recorder_.enabled()) {
+    const auto &debug_info = DynamicMemAllocatorDebugInfo::GetDebugInfo();
+    alloc_trace_recorder_.RecordAlloc(device_addr, size, from_persistent_mem ? kMemAllocTraceFlagPersistent : 0,
+                                      debug_info.name_, static_cast<uint8_t>(debug_info.type_));
+  }
+  return device_addr;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocSizeClassMem(size_t size) {
+  auto index = SizeClassIndex(size);
+  auto class_size = SizeClassSize(index);
+  auto cache = GetSizeClassThreadCache(size_class_central_);
+  {
+    std::lock_guard<std::mutex> locker(cache->mutex_);
+    cache->CheckEpoch(size_class_central_->epoch());
+    auto &free_list = cache->free_lists_[index];
+    if (free_list.empty()) {
+      size_class_central_->Pop(index, &free_list, kSizeClassBatchCount);
+    }
+    if (!free_list.empty()) {
+      auto device_addr = free_list.back();
+      free_list.pop_back();
+      (void)size_class_central_->cached_size().fetch_sub(class_size, std::memory_order_relaxed);
+      return device_addr;
+    }
+  }
+
+  // Refill from the best fit, and return the cached memory to combine the memory buf if it fails.
+  auto device_addr = AllocBestFitMem(class_size, false);
+  if (device_addr == nullptr) {
+    MS_LOG(INFO) << "Alloc size class memory failed, flush the size class memory and retry.";
+    FlushSizeClassMem();
+    device_addr = AllocBestFitMem(class_size, false);
+  }
+  if (device_addr != nullptr) {
+    size_class_central_->Register(device_addr, index);
+  }
+  return device_addr;
+}
+
+bool DynamicMemPoolBestFit::FreeSizeClassMem(const DeviceMemPtr &device_addr) {
+  size_t index = 0;
+  if (!size_class_central_->Find(device_addr, &index)) {
+    return false;
+  }
+  auto cache = GetSizeClassThreadCache(size_class_central_);
+  std::lock_guard<std::mutex> locker(cache->mutex_);
+  cache->CheckEpoch(size_class_central_->epoch());
+  auto &free_list = cache->free_lists_[index];
+  free_list.push_back(device_addr);
+  (void)size_class_central_->cached_size().fetch_add(SizeClassSize(index), std::memory_order_relaxed);
+  if (free_list.size() > kThreadCacheMaxCount) {
+    size_class_central_->Push(index, cache->epoch_, &free_list, kSizeClassBatchCount);
+  }
+  return true;
+}
+
+void DynamicMemPoolBestFit::FlushSizeClassMem() {
+  std::vector<DeviceMemPtr> device_addrs;
+  size_class_central_->TakeAll(&device_addrs);
+  if (device_addrs.empty()) {
+    return;
+  }
+
+  size_t flush_size = 0;
+  std::lock_guard<std::mutex> locker(mutex_);
+  for (const auto &device_addr : device_addrs) {
+    size_t index = 0;
+    if (size_class_central_->Find(device_addr, &index)) {
+      flush_size += SizeClassSize(index);
+      size_class_central_->Unregister(device_addr);
+      FreeBestFitMem(device_addr);
+    }
+  }
+  (void)size_class_central_->cached_size().fetch_sub(flush_size, std::memory_order_relaxed);
+  MS_LOG(INFO) << "Flush size class memory, count: " << device_addrs.size() << ", size: " << flush_size;
+}
+
+void DynamicMemPoolBestFit::SetEnableSizeClass(bool enable_size_class) {
+  if (enable_size_class_.exchange(enable_size_class) == enable_size_class) {
+    return;
+  }
+  MS_LOG(INFO) << "Set the size class mode of memory pool: " << enable_size_class;
+  if (!enable_size_class) {
+    // The device addresses in use are freed by the best fit directly from now on.
+    FlushSizeClassMem();
+    size_class_central_->Reset();
+  }
+}
+
+size_t DynamicMemPoolBestFit::SizeClassCachedMemStatistics() const {
+  return size_class_central_->cached_size().load(std::memory_order_relaxed);
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocBestFitMem(size_t align_size, bool from_persistent_mem) {
   std::lock_guard<std::mutex> locker(mutex_);
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
   DeviceMemPtr device_addr = FindIdleMemBuf(align_size, from_persistent_mem);
@@ -68,9 +387,14 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
 std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t total_size,
                                                                           const std::vector<size_t> &size_list) {
   std::vector<DeviceMemPtr> device_addr_list;
-  // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size, false);
+  // Pre-alloc the one whole piece memory, which is not from the size class free lists.
+  auto device_addr = AllocBestFitMem(AlignMemorySize(total_size), false);
   if (!device_addr) {
+    if (alloc_trace_recorder_.enabled()) {
+      const auto &debug_info = DynamicMemAllocatorDebugInfo::GetDebugInfo();
+      alloc_trace_recorder_.RecordAlloc(nullptr, total_size, kMemAllocTraceFlagContinuous, debug_info.name_,
+                                        static_cast<uint8_t>(debug_info.type_));
+    }
     return device_addr_list;
   }
   std::lock_guard<std::mutex> locker(mutex_);
@@ -107,6 +431,13 @@ std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t
   }
   // Update the size of the last memory buf.
   continuous_mem_buf->size_ += rest_size;
+  if (alloc_trace_recorder_.enabled()) {
+    const auto &debug_info = DynamicMemAllocatorDebugInfo::GetDebugInfo();
+    for (size_t i = 0; i < size_list.size(); ++i) {
+      alloc_trace_recorder_.RecordAlloc(device_addr_list[i], size_list[i], kMemAllocTraceFlagContinuous,
+                                        debug_info.name_, static_cast<uint8_t>(debug_info.type_));
+    }
+  }
   return device_addr_list;
 }
 
@@ -309,7 +640,17 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
   MS_EXCEPTION_IF_NULL(device_addr);
+  if (alloc_trace_recorder_.enabled()) {
+    alloc_trace_recorder_.RecordFree(device_addr);
+  }
+  if (enable_size_class_ && FreeSizeClassMem(device_addr)) {
+    return;
+  }
   std::lock_guard<std::mutex> locker(mutex_);
+  FreeBestFitMem(device_addr);
+}
+
+void DynamicMemPoolBestFit::FreeBestFitMem(const DeviceMemPtr &device_addr) {
   auto fn = [this](const MemStatusManagerPtr &mem_mng, const DeviceMemPtr &device_addr) -> DynamicMemBlockPtr {
     auto mem_block = FindMemBlock(device_addr, mem_mng);
     if (mem_block != nullptr) {
@@ -409,6 +750,7 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr &dev
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
   std::lock_guard<std::mutex> locker(mutex_);
   DumpDynamicMemPoolStateInfo();
+  size_class_central_->Reset();
 
   auto fn = [this](const MemStatusManagerPtr &mem_mng) {
     for (auto &iter : mem_mng->mem_block_list_) {
@@ -471,7 +813,7 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
                << "M, kernel output used size:"
                << total_used_size_list[static_cast<int>(AllocatorType::kKernelOutput)] / kMBToByte
                << "M, other used size:" << total_used_size_list[static_cast<int>(AllocatorType::kOther)] / kMBToByte
-               << "M.";
+               << "M, size class cached size:" << SizeClassCachedMemStatistics() / kMBToByte << "M.";
 }
 
 void DynamicMemPoolBestFit::DumpDynamicMemPoolDebugInfo() {
@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_H_
 #define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_H_
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include <vector>
@@ -26,6 +27,7 @@
 #include <mutex>
 #include <string>
 #include "utils/ms_utils.h"
+#include "common/mem_reuse/mem_alloc_trace.h"
 
 namespace mindspore {
 namespace device {
@@ -44,6 +46,9 @@ static const size_t DYNAMIC_MEM_ALIGN_SIZE = 512;
 // The minimum unit size (1G) of memory block used for dynamic extend.
 static const size_t DYNAMIC_MEM_ALLOC_UNIT_SIZE = 1024 << 20;
 
+// The maximum aligned size (1M) served by the size class free lists.
+static const size_t SIZE_CLASS_MAX_SIZE = 1 << 20;
+
 // The Comparator of device address from small to large.
 struct DeviceAddrCmp {
   bool operator()(const DeviceMemPtr &addr1, const DeviceMemPtr &addr2) const { return addr1 < addr2; }
@@ -144,11 +149,14 @@ struct MemStatusManager {
 };
 using MemStatusManagerPtr = std::shared_ptr<MemStatusManager>;
 
+// The shared state of the size class free lists, defined in the source file.
+class SizeClassCentral;
+using SizeClassCentralPtr = std::shared_ptr<SizeClassCentral>;
+
 // The main class of dynamic memory pool.
 class DynamicMemPoolBestFit {
  public:
-  DynamicMemPoolBestFit()
-      : persistent_mem_(std::make_shared<MemStatusManager>()), common_mem_(std::make_shared<MemStatusManager>()) {}
+  DynamicMemPoolBestFit();
   virtual ~DynamicMemPoolBestFit();
 
   // The main program entry of memory alloc.
@@ -168,6 +176,18 @@ class DynamicMemPoolBestFit {
   // Set mem pool block size
   void SetMemPoolBlockSize(size_t available_device_mem_size);
 
+  // Enable the size class mode: the common memory not larger than SIZE_CLASS_MAX_SIZE is served by the per thread
+  // caches and the size class free lists before falling back to the best fit, it should be set before memory alloc.
+  void SetEnableSizeClass(bool enable_size_class);
+  bool enable_size_class() const { return enable_size_class_; }
+  // Return the memory cached by the size class free lists of all the threads to the best fit pool, so that it can be
+  // combined.
+  void FlushSizeClassMem();
+
+  // Record the memory alloc and free to the binary trace file, which can be replayed offline.
+  bool StartAllocTrace(const std::string &file_path) { return alloc_trace_recorder_.Open(file_path); }
+  void StopAllocTrace() { alloc_trace_recorder_.Close(); }
+
   // The statistics information.
   size_t TotalMemStatistics() const {
     return common_mem_->mps_.total_mem_size_ + persistent_mem_->mps_.total_mem_size_;
@@ -178,6 +198,8 @@ class DynamicMemPoolBestFit {
   size_t UsedMemPeakStatistics() const {
     return common_mem_->mps_.used_mem_peak_size_ + persistent_mem_->mps_.used_mem_peak_size_;
   }
+  // The memory held by the size class free lists, which is counted as used memory by the best fit pool.
+  size_t SizeClassCachedMemStatistics() const;
 
   // Display the brief state information of memory block and memory buf.
   void DumpDynamicMemPoolStateInfo();
@@ -198,6 +220,15 @@ class DynamicMemPoolBestFit {
   virtual size_t CalMemBlockAllocSize(size_t size, bool from_persistent_mem);
 
  private:
+  // Alloc the aligned size by the best fit.
+  DeviceMemPtr AllocBestFitMem(size_t size, bool from_persistent_mem);
+  // Free the memory buf by the best fit, the mutex_ must be held by the caller.
+  void FreeBestFitMem(const DeviceMemPtr &device_addr);
+  // Alloc the aligned size from the size class free lists, refill from the best fit when they are empty.
+  DeviceMemPtr AllocSizeClassMem(size_t size);
+  // Put the device address back to the size class free lists, return false if it is not allocated by them.
+  bool FreeSizeClassMem(const DeviceMemPtr &device_addr);
+
   // Find the idle memory buf by aligned size when memory alloc.
   DeviceMemPtr FindIdleMemBuf(size_t size, bool from_persistent_mem);
   // Add the memory block and memory buf when memory alloc not find the idle memory buf.
@@ -223,6 +254,12 @@ class DynamicMemPoolBestFit {
   // In the graph mode, the unit size set in the context will be modified through the FetchMemUnitSize function, so it
   // needs to be changed back after that
   size_t config_unit_size_{DYNAMIC_MEM_ALLOC_UNIT_SIZE};
+
+  // Size class mode.
+  std::atomic<bool> enable_size_class_{false};
+  SizeClassCentralPtr size_class_central_{nullptr};
+
+  MemAllocTraceRecorder alloc_trace_recorder_;
 };
 }  // namespace device
 }  // namespace mindspore
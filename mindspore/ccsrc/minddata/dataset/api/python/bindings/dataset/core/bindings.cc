@@ -69,10 +69,26 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_enable_autotune", &ConfigManager::enable_autotune)
                     .def("set_autotune_interval", &ConfigManager::set_autotune_interval)
                     .def("get_autotune_interval", &ConfigManager::autotune_interval)
+                    .def("set_autotune_cpu_budget", &ConfigManager::set_autotune_cpu_budget)
+                    .def("get_autotune_cpu_budget", &ConfigManager::autotune_cpu_budget)
                     .def("set_enable_watchdog", &ConfigManager::set_enable_watchdog)
                     .def("get_enable_watchdog", &ConfigManager::enable_watchdog)
                     .def("set_multiprocessing_timeout_interval", &ConfigManager::set_multiprocessing_timeout_interval)
                     .def("get_multiprocessing_timeout_interval", &ConfigManager::multiprocessing_timeout_interval)
+                    .def("set_map_batch_size", &ConfigManager::set_map_batch_size)
+                    .def("get_map_batch_size", &ConfigManager::map_batch_size)
+                    .def("set_enable_tfrecord_index", &ConfigManager::set_enable_tfrecord_index)
+                    .def("get_enable_tfrecord_index", &ConfigManager::enable_tfrecord_index)
+                    .def("set_shuffle_num_shards", &ConfigManager::set_shuffle_num_shards)
+                    .def("get_shuffle_num_shards", &ConfigManager::shuffle_num_shards)
+                    .def("set_enable_jpeg_dct_scaling", &ConfigManager::set_enable_jpeg_dct_scaling)
+                    .def("get_enable_jpeg_dct_scaling", &ConfigManager::enable_jpeg_dct_scaling)
+                    .def("set_mindrecord_read_ahead_threads", &ConfigManager::set_mindrecord_read_ahead_threads)
+                    .def("get_mindrecord_read_ahead_threads", &ConfigManager::mindrecord_read_ahead_threads)
+                    .def("set_mindrecord_read_ahead_size", &ConfigManager::set_mindrecord_read_ahead_size)
+                    .def("get_mindrecord_read_ahead_size", &ConfigManager::mindrecord_read_ahead_size)
+                    .def("set_enable_lock_free_connector", &ConfigManager::set_enable_lock_free_connector)
+                    .def("get_enable_lock_free_connector", &ConfigManager::enable_lock_free_connector)
                     .def("load", [](ConfigManager &c, const std::string &s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
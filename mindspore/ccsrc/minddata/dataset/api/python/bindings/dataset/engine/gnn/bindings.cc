@@ -27,10 +27,11 @@ PYBIND_REGISTER(
   Graph, 0, ([](const py::module *m) {
     (void)py::class_<gnn::GraphData, std::shared_ptr<gnn::GraphData>>(*m, "GraphDataClient")
       .def(py::init([](const std::string &dataset_file, int32_t num_workers, const std::string &working_mode,
-                       const std::string &hostname, int32_t port) {
+                       const std::string &hostname, int32_t port, const std::string &storage_format) {
         std::shared_ptr<gnn::GraphData> out;
         if (working_mode == "local") {
-          out = std::make_shared<gnn::GraphDataImpl>(dataset_file, num_workers);
+          auto format = storage_format == "csr" ? gnn::GraphStorageFormat::kCsr : gnn::GraphStorageFormat::kDefault;
+          out = std::make_shared<gnn::GraphDataImpl>(dataset_file, num_workers, false, format);
         } else if (working_mode == "client") {
           out = std::make_shared<gnn::GraphDataClient>(dataset_file, hostname, port);
         }
@@ -111,14 +112,24 @@ PYBIND_REGISTER(
              THROW_IF_ERROR(g.RandomWalk(node_list, meta_path, step_home_param, step_away_param, default_node, &out));
              return out;
            })
+      .def("save_snapshot",
+           [](gnn::GraphData &g, const std::string &snapshot_file) {
+             auto graph_impl = dynamic_cast<gnn::GraphDataImpl *>(&g);
+             if (graph_impl == nullptr) {
+               THROW_IF_ERROR(
+                 Status(StatusCode::kMDUnexpectedError, "Graph snapshot can only be saved in local mode."));
+             }
+             THROW_IF_ERROR(graph_impl->SaveSnapshot(snapshot_file));
+           })
       .def("stop", [](gnn::GraphData &g) { THROW_IF_ERROR(g.Stop()); });
 
     (void)py::class_<gnn::GraphDataServer, std::shared_ptr<gnn::GraphDataServer>>(*m, "GraphDataServer")
       .def(py::init([](const std::string &dataset_file, int32_t num_workers, const std::string &hostname, int32_t port,
-                       int32_t client_num, bool auto_shutdown) {
+                       int32_t client_num, bool auto_shutdown, const std::string &storage_format) {
         std::shared_ptr<gnn::GraphDataServer> out;
-        out =
-          std::make_shared<gnn::GraphDataServer>(dataset_file, num_workers, hostname, port, client_num, auto_shutdown);
+        auto format = storage_format == "csr" ? gnn::GraphStorageFormat::kCsr : gnn::GraphStorageFormat::kDefault;
+        out = std::make_shared<gnn::GraphDataServer>(dataset_file, num_workers, hostname, port, client_num,
+                                                     auto_shutdown, format);
         THROW_IF_ERROR(out->Init());
         return out;
       }))
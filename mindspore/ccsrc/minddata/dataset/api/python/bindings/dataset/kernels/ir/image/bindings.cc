@@ -29,6 +29,7 @@
 #include "minddata/dataset/kernels/ir/vision/cutmix_batch_ir.h"
 #include "minddata/dataset/kernels/ir/vision/cutout_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/equalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/gaussian_blur_ir.h"
 #include "minddata/dataset/kernels/ir/vision/horizontal_flip_ir.h"
@@ -193,6 +194,17 @@ PYBIND_REGISTER(DecodeOperation, 1, ([](const py::module *m) {
                     }));
                 }));
 
+PYBIND_REGISTER(
+  DecodeResizeOperation, 1, ([](const py::module *m) {
+    (void)py::class_<vision::DecodeResizeOperation, TensorOperation, std::shared_ptr<vision::DecodeResizeOperation>>(
+      *m, "DecodeResizeOperation")
+      .def(py::init([](const std::vector<int32_t> &size, InterpolationMode interpolation) {
+        auto decode_resize = std::make_shared<vision::DecodeResizeOperation>(size, interpolation);
+        THROW_IF_ERROR(decode_resize->ValidateParams());
+        return decode_resize;
+      }));
+  }));
+
 PYBIND_REGISTER(EqualizeOperation, 1, ([](const py::module *m) {
                   (void)
                     py::class_<vision::EqualizeOperation, TensorOperation, std::shared_ptr<vision::EqualizeOperation>>(
@@ -31,6 +31,7 @@
 #include "minddata/dataset/kernels/ir/vision/cutmix_batch_ir.h"
 #include "minddata/dataset/kernels/ir/vision/cutout_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/equalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/gaussian_blur_ir.h"
 #include "minddata/dataset/kernels/ir/vision/horizontal_flip_ir.h"
@@ -278,6 +279,21 @@ CutOut::CutOut(int32_t length, int32_t num_patches) : data_(std::make_shared<Dat
 std::shared_ptr<TensorOperation> CutOut::Parse() {
   return std::make_shared<CutOutOperation>(data_->length_, data_->num_patches_);
 }
+
+// DecodeResize Transform Operation.
+struct DecodeResize::Data {
+  Data(const std::vector<int32_t> &size, InterpolationMode interpolation)
+      : size_(size), interpolation_(interpolation) {}
+  std::vector<int32_t> size_;
+  InterpolationMode interpolation_;
+};
+
+DecodeResize::DecodeResize(const std::vector<int32_t> &size, InterpolationMode interpolation)
+    : data_(std::make_shared<Data>(size, interpolation)) {}
+
+std::shared_ptr<TensorOperation> DecodeResize::Parse() {
+  return std::make_shared<DecodeResizeOperation>(data_->size_, data_->interpolation_);
+}
 #endif  // not ENABLE_ANDROID
 
 // Decode Transform Operation.
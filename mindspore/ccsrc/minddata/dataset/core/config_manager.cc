@@ -57,8 +57,16 @@ ConfigManager::ConfigManager()
       enable_autotune_(false),
       save_autoconfig_(false),
       autotune_interval_(kCfgAutoTuneInterval),
+      autotune_cpu_budget_(kCfgAutoTuneCpuBudget),
       enable_watchdog_(true),
-      multiprocessing_timeout_interval_(kCfgMultiprocessingTimeoutInterval) {
+      multiprocessing_timeout_interval_(kCfgMultiprocessingTimeoutInterval),
+      map_batch_size_(kCfgMapBatchSize),
+      enable_tfrecord_index_(false),
+      shuffle_num_shards_(kCfgShuffleNumShards),
+      enable_jpeg_dct_scaling_(false),
+      mindrecord_read_ahead_threads_(kCfgMindRecordReadAheadThreads),
+      mindrecord_read_ahead_size_(kCfgMindRecordReadAheadSize),
+      enable_lock_free_connector_(false) {
   autotune_json_filepath_ = kEmptyString;
   num_cpu_threads_ = num_cpu_threads_ > 0 ? num_cpu_threads_ : std::numeric_limits<uint16_t>::max();
   num_parallel_workers_ = num_parallel_workers_ < num_cpu_threads_ ? num_parallel_workers_ : num_cpu_threads_;
@@ -259,6 +259,14 @@ class ConfigManager {
   // @param interval - autotune interval in steps
   void set_autotune_interval(int64_t interval) { autotune_interval_ = interval; }
 
+  // getter function
+  // @return - number of cpu cores the pipeline can use when AutoTune adds workers, 0 means all the cores
+  int32_t autotune_cpu_budget() const { return autotune_cpu_budget_; }
+
+  // setter function
+  // @param cpu_budget - number of cpu cores the pipeline can use when AutoTune adds workers
+  void set_autotune_cpu_budget(int32_t cpu_budget) { autotune_cpu_budget_ = cpu_budget; }
+
   // setter function
   // @param enable - To enable watchdog python thread
   void set_enable_watchdog(bool enable) { enable_watchdog_ = enable; }
@@ -275,6 +283,69 @@ class ConfigManager {
   // @param interval - multiprocessing timeout interval in seconds
   void set_multiprocessing_timeout_interval(uint32_t interval) { multiprocessing_timeout_interval_ = interval; }
 
+  // getter function
+  // @return - The number of consecutive rows sent to a map worker at once
+  int32_t map_batch_size() const { return map_batch_size_; }
+
+  // setter function
+  // @param size - The number of consecutive rows sent to a map worker at once, the operations supporting batch
+  //     process them in one call
+  void set_map_batch_size(int32_t size) { map_batch_size_ = size; }
+
+  // getter function
+  // @return - Flag to indicate whether the offset index of tfrecord files is saved to sidecar files
+  bool enable_tfrecord_index() const { return enable_tfrecord_index_; }
+
+  // setter function
+  // @param enable - To save the offset index of tfrecord files to sidecar files, so counting and sharding the rows
+  //     do not need to scan the files again
+  void set_enable_tfrecord_index(bool enable) { enable_tfrecord_index_ = enable; }
+
+  // getter function
+  // @return - The number of shards the shuffle buffer is split into
+  int32_t shuffle_num_shards() const { return shuffle_num_shards_; }
+
+  // setter function
+  // @param num_shards - The number of shards the shuffle buffer is split into, each shard is shuffled by its own
+  //     thread
+  void set_shuffle_num_shards(int32_t num_shards) { shuffle_num_shards_ = num_shards; }
+
+  // getter function
+  // @return - Flag to indicate whether RandomCropDecodeResize and DecodeResize decode JPEG images with DCT downscaling
+  bool enable_jpeg_dct_scaling() const { return enable_jpeg_dct_scaling_; }
+
+  // setter function
+  // @param enable - To let RandomCropDecodeResize and DecodeResize decode JPEG images at 1/2, 1/4 or 1/8 of the size
+  //     when it is still larger than the target size, and to fuse Decode followed by Resize into DecodeResize. The
+  //     output is then close to but not the same as decoding at full size
+  void set_enable_jpeg_dct_scaling(bool enable) { enable_jpeg_dct_scaling_ = enable; }
+
+  // getter function
+  // @return - The number of threads reading the blobs of MindDataset ahead
+  int32_t mindrecord_read_ahead_threads() const { return mindrecord_read_ahead_threads_; }
+
+  // setter function
+  // @param num_threads - The number of threads reading the blobs of MindDataset ahead in the order of the sampler,
+  //     0 to read the blobs in the workers
+  void set_mindrecord_read_ahead_threads(int32_t num_threads) { mindrecord_read_ahead_threads_ = num_threads; }
+
+  // getter function
+  // @return - The max size in MB of the blobs of MindDataset read ahead and not taken yet
+  int32_t mindrecord_read_ahead_size() const { return mindrecord_read_ahead_size_; }
+
+  // setter function
+  // @param size - The max size in MB of the blobs of MindDataset read ahead and not taken yet
+  void set_mindrecord_read_ahead_size(int32_t size) { mindrecord_read_ahead_size_ = size; }
+
+  // getter function
+  // @return - Flag to indicate whether the workers of the non-mappable leaf ops pass the rows with LockFreeConnector
+  bool enable_lock_free_connector() const { return enable_lock_free_connector_; }
+
+  // setter function
+  // @param enable - To let the workers of the non-mappable leaf ops pass the rows to the master thread through lock
+  //     free ring buffers instead of mutex protected queues, the blocked threads poll instead of waiting
+  void set_enable_lock_free_connector(bool enable) { enable_lock_free_connector_ = enable; }
+
  private:
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -305,8 +376,16 @@ class ConfigManager {
   bool enable_autotune_;
   bool save_autoconfig_;  // True if should save AutoTune configuration
   int64_t autotune_interval_;
+  int32_t autotune_cpu_budget_;                // Number of cpu cores the pipeline can use under AutoTune
   bool enable_watchdog_;                       // Watchdog python thread enabled flag
   uint32_t multiprocessing_timeout_interval_;  // Multiprocessing timeout interval in seconds
+  int32_t map_batch_size_;                     // Number of consecutive rows sent to a map worker at once
+  bool enable_tfrecord_index_;                 // Save the offset index of tfrecord files to sidecar files
+  int32_t shuffle_num_shards_;                 // Number of shards the shuffle buffer is split into
+  bool enable_jpeg_dct_scaling_;               // Decode JPEG images with DCT downscaling when resized after decode
+  int32_t mindrecord_read_ahead_threads_;      // Number of threads reading the blobs of MindDataset ahead
+  int32_t mindrecord_read_ahead_size_;         // Max size in MB of the blobs of MindDataset read ahead
+  bool enable_lock_free_connector_;            // Pass the rows of the non-mappable leaf ops with LockFreeConnector
   std::string autotune_json_filepath_;         // Filepath name of the final AutoTune Configuration JSON file
 };
 }  // namespace dataset
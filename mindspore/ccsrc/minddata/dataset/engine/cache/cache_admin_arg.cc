@@ -41,6 +41,7 @@ CacheAdminArgHandler::CacheAdminArgHandler()
       shm_mem_sz_(kDefaultSharedMemorySize),
       log_level_(kDefaultLogLevel),
       memory_cap_ratio_(kDefaultMemoryCapRatio),
+      read_ahead_sz_(kDefaultReadAheadSize),
       hostname_(kCfgDefaultCacheHost),
       port_(kCfgDefaultCachePort),
       spill_dir_("") {
@@ -88,6 +89,8 @@ CacheAdminArgHandler::CacheAdminArgHandler()
   arg_map_["--loglevel"] = ArgValue::kArgLogLevel;
   arg_map_["-r"] = ArgValue::kArgMemoryCapRatio;
   arg_map_["--memory_cap_ratio"] = ArgValue::kArgMemoryCapRatio;
+  arg_map_["-a"] = ArgValue::kArgReadAheadSize;
+  arg_map_["--read_ahead_size"] = ArgValue::kArgReadAheadSize;
   arg_map_["--list_sessions"] = ArgValue::kArgListSessions;
   arg_map_["--server_info"] = ArgValue::kArgServerInfo;
   // Initialize argument tracker with false values
@@ -334,6 +337,10 @@ Status CacheAdminArgHandler::ParseArgStream(std::stringstream *arg_stream) {
         RETURN_IF_NOT_OK(AssignArg(tok, &memory_cap_ratio_, arg_stream));
         break;
       }
+      case ArgValue::kArgReadAheadSize: {
+        RETURN_IF_NOT_OK(AssignArg(tok, &read_ahead_sz_, arg_stream));
+        break;
+      }
       case ArgValue::kArgListSessions: {
         RETURN_IF_NOT_OK(AssignArg(tok, static_cast<std::string *>(nullptr), arg_stream, CommandId::kCmdListSessions));
         break;
@@ -388,6 +395,10 @@ Status CacheAdminArgHandler::Validate() {
     return Status(StatusCode::kMDSyntaxError, "Memory cap ratio should be positive and no greater than 1");
   }
 
+  if (read_ahead_sz_ < 0) {
+    return Status(StatusCode::kMDSyntaxError, "Read ahead size must not be negative.");
+  }
+
   if (port_ < kMinLegalPort || port_ > kMaxLegalPort) {
     return Status(StatusCode::kMDSyntaxError, "Port must be in range (1025..65535).");
   }
@@ -641,8 +652,9 @@ Status CacheAdminArgHandler::StartServer() {
     std::string minloglevel_string = std::to_string(log_level_);
     std::string daemonize_string = "true";
     std::string memory_cap_ratio_string = std::to_string(memory_cap_ratio_);
+    std::string read_ahead_string = std::to_string(read_ahead_sz_);
 
-    char *argv[9];
+    char *argv[10];
     argv[0] = cache_server_binary.data();
     argv[1] = spill_dir_.data();
     argv[2] = workers_string.data();
@@ -651,7 +663,8 @@ Status CacheAdminArgHandler::StartServer() {
     argv[5] = minloglevel_string.data();
     argv[6] = daemonize_string.data();
     argv[7] = memory_cap_ratio_string.data();
-    argv[8] = nullptr;
+    argv[8] = read_ahead_string.data();
+    argv[9] = nullptr;
 
     // Now exec the binary
     execv(cache_server_binary.data(), argv);
@@ -670,6 +683,7 @@ void CacheAdminArgHandler::Help() {
   std::cerr << "                [[-p | --port] <port number>]             Default is " << kCfgDefaultCachePort << ".\n";
   std::cerr << "                [[-w | --workers] <number of workers>]    Default is " << kDefaultNumWorkers << ".\n";
   std::cerr << "                [[-s | --spilldir] <spilling directory>]  Default is no spilling.\n";
+  std::cerr << "                [[-a | --read_ahead_size] <size in MB>]   Default is 0 (no read ahead).\n";
   std::cerr << "                [[-l | --loglevel] <log level>]           Default is 1 (INFO level).\n";
   std::cerr << "            [--destroy_session  | -d] <session id>\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
@@ -75,7 +75,8 @@ class CacheAdminArgHandler {
     kArgMemoryCapRatio = 12,
     kArgListSessions = 13,
     kArgServerInfo = 14,
-    kArgNumArgs = 15  // Must be the last position to provide a count
+    kArgReadAheadSize = 15,
+    kArgNumArgs = 16  // Must be the last position to provide a count
   };
 
   Status StartServer();
@@ -104,6 +105,7 @@ class CacheAdminArgHandler {
   int32_t shm_mem_sz_;
   int32_t log_level_;
   float memory_cap_ratio_;
+  int32_t read_ahead_sz_;
   std::string hostname_;
   int32_t port_;
   std::string spill_dir_;
@@ -144,6 +144,15 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   return rc;
 }
 
+Status CacheClient::ReadAhead(const std::vector<row_id_type> &row_id) const {
+  if (!spill_ || row_id.empty()) {
+    return Status::OK();
+  }
+  // It is only a hint, so we won't wait for the result.
+  auto rq = std::make_shared<ReadAheadRowsRequest>(this, row_id);
+  return PushRequest(rq);
+}
+
 Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
   UniqueLock lck(&mux_);
   // To create a cache, we identify ourself at the client by:
@@ -52,6 +52,7 @@ class CacheClient {
   friend class CreateCacheRequest;
   friend class CacheRowRequest;
   friend class BatchFetchRequest;
+  friend class ReadAheadRowsRequest;
   friend class BatchCacheRowsRequest;
 
   /// \brief A builder to help creating a CacheClient object
@@ -163,6 +164,12 @@ class CacheClient {
   /// \return return code
   Status GetRows(const std::vector<row_id_type> &row_id, TensorTable *out) const;
 
+  /// \brief Ask the server to read the rows spilled to disk ahead, without waiting for the reply. Nothing is sent if
+  /// the cache doesn't spill.
+  /// \param row_id A vector of row id's, in the order they are going to be fetched
+  /// \return return code
+  Status ReadAhead(const std::vector<row_id_type> &row_id) const;
+
   /// \brief Create a cache.
   /// \param tree_crc  A crc that was generated during tree prepare phase
   /// \param generate_id Let the cache service generate row id
@@ -28,7 +28,7 @@ namespace ms = mindspore;
 namespace ds = mindspore::dataset;
 
 namespace {
-const int32_t kTotalArgs = 8;
+const int32_t kTotalArgs = 9;
 enum ArgIndex : uint8_t {
   kProcessName = 0,
   kRootDir = 1,
@@ -37,7 +37,8 @@ enum ArgIndex : uint8_t {
   kSharedMemorySize = 4,
   kLogLevel = 5,
   kDemonize = 6,
-  kMemoryCapRatio = 7
+  kMemoryCapRatio = 7,
+  kReadAheadSize = 8
 };
 
 ms::Status BuildServer(ds::CacheServer::Builder *builder, ds::SharedMessage *msg, int32_t port, bool daemonize) {
@@ -137,7 +138,8 @@ ms::Status StartServer(int argc, char **argv) {
     .SetPort(port)
     .SetSharedMemorySizeInGB(static_cast<int32_t>(strtol(argv[ArgIndex::kSharedMemorySize], nullptr, ds::kDecimal)))
     .SetLogLevel(static_cast<int8_t>((strtol(argv[ArgIndex::kLogLevel], nullptr, ds::kDecimal))))
-    .SetMemoryCapRatio(strtof(argv[ArgIndex::kMemoryCapRatio], nullptr));
+    .SetMemoryCapRatio(strtof(argv[ArgIndex::kMemoryCapRatio], nullptr))
+    .SetReadAheadSizeInMB(static_cast<int32_t>(strtol(argv[ArgIndex::kReadAheadSize], nullptr, ds::kDecimal)));
 
   auto daemonize_string = argv[ArgIndex::kDemonize];
   bool daemonize = strcmp(daemonize_string, "true") == 0 || strcmp(daemonize_string, "TRUE") == 0 ||
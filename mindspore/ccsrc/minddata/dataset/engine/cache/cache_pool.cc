@@ -36,7 +36,13 @@ Status CachePool::DoServiceStart() {
     Path spill = GetSpillPath();
     RETURN_IF_NOT_OK(spill.CreateDirectories());
     auto &cs = CacheServer::GetInstance();
-    sm_ = std::make_shared<StorageManager>(spill, cs.GetNumWorkers());
+    // The read ahead is turned on by the server. The rows read ahead from the disk take no more than a small share of
+    // the memory the cache leaves to the system, and there is one read ahead task for each server worker.
+    const uint64_t kReadAheadShare = 4;
+    const uint64_t kMBToBytes = 1024 * 1024;
+    auto read_ahead_budget = std::min<uint64_t>(static_cast<uint64_t>(cs.GetReadAheadSizeInMB()) * kMBToBytes,
+                                                min_avail_mem_ / kReadAheadShare);
+    sm_ = std::make_shared<StorageManager>(spill, cs.GetNumWorkers(), read_ahead_budget, cs.GetNumWorkers());
     RETURN_IF_NOT_OK(sm_->ServiceStart());
     MS_LOG(INFO) << "CachePool will use disk folder: " << spill.ToString();
   }
@@ -183,6 +189,20 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
   return Status::OK();
 }
 
+Status CachePool::ReadAhead(const std::vector<key_type> &keys) const {
+  if (sm_ == nullptr) {
+    return Status::OK();
+  }
+  std::vector<StorageManager::key_type> storage_keys;
+  for (auto key : keys) {
+    auto r = tree_->Search(key);
+    if (r.second && r.first->ptr == nullptr && r.first->sz > 0) {
+      storage_keys.push_back(r.first->storage_key);
+    }
+  }
+  return sm_->ReadAhead(storage_keys);
+}
+
 Path CachePool::GetSpillPath() const {
   auto spill = Path(root_) / subfolder_;
   return spill;
@@ -129,6 +129,12 @@ class CachePool : public Service {
   /// \return Error code
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
 
+  /// \brief Start reading the spilled buffers of the given keys back into memory in the background, so a Read later
+  /// doesn't have to wait for the disk. Buffers cached in memory are skipped.
+  /// \param[in] keys Keys in the order they are going to be read
+  /// \return Error code
+  Status ReadAhead(const std::vector<key_type> &keys) const;
+
   /// \brief Serialize a DataLocator
   Status GetDataLocator(key_type, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &,
                         flatbuffers::Offset<DataLocatorMsg> *) const;
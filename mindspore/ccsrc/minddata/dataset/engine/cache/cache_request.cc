@@ -205,6 +205,20 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
   return Status::OK();
 }
 
+ReadAheadRowsRequest::ReadAheadRowsRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id)
+    : BaseRequest(RequestType::kReadAheadRows) {
+  rq_.set_connection_id(cc->server_connection_id_);
+  rq_.set_client_id(cc->client_id_);
+  // Convert the row id into a flatbuffer
+  flatbuffers::FlatBufferBuilder fbb;
+  auto off_t = fbb.CreateVector(row_id);
+  TensorRowIdsBuilder bld(fbb);
+  bld.add_row_id(off_t);
+  auto off = bld.Finish();
+  fbb.Finish(off);
+  rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
+}
+
 CreateCacheRequest::CreateCacheRequest(CacheClient *cc, const CacheClientInfo &cinfo, uint64_t cache_mem_sz,
                                        CreateCacheRequest::CreateCacheFlag flag)
     : BaseRequest(RequestType::kCreateCache), cache_mem_sz_(cache_mem_sz), flag_(flag), cc_(cc) {
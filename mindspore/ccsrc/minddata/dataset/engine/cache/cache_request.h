@@ -87,6 +87,7 @@ class BaseRequest {
     kBatchCacheRows = 19,
     kInternalCacheRow = 20,
     kGetCacheState = 21,
+    kReadAheadRows = 22,
     // Add new request before it.
     kRequestUnknown = 32767
   };
@@ -136,7 +137,7 @@ class BaseRequest {
   bool IsRowRequest() const {
     return type_ == RequestType::kBatchCacheRows || type_ == RequestType::kBatchFetchRows ||
            type_ == RequestType::kInternalCacheRow || type_ == RequestType::kInternalFetchRow ||
-           type_ == RequestType::kCacheRow;
+           type_ == RequestType::kCacheRow || type_ == RequestType::kReadAheadRows;
   }
 
   /// \brief Return if the request is of admin request type
@@ -240,6 +241,14 @@ class BatchFetchRequest : public BaseRequest {
   std::vector<row_id_type> row_id_;
 };
 
+/// \brief Request to read the spilled rows of the coming batches ahead, in the order they are going to be fetched
+class ReadAheadRowsRequest : public BaseRequest {
+ public:
+  friend class CacheServer;
+  ReadAheadRowsRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id);
+  ~ReadAheadRowsRequest() override = default;
+};
+
 /// \brief Request to create a cache for the current connection
 class CreateCacheRequest : public BaseRequest {
  public:
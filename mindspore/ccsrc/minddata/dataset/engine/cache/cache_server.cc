@@ -558,6 +558,27 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
   return Status::OK();
 }
 
+Status CacheServer::ReadAheadRows(CacheRequest *rq) {
+  auto connection_id = rq->connection_id();
+  // Hold the shared lock to prevent the cache from being dropped.
+  SharedLock lck(&rwLock_);
+  CacheService *cs = GetService(connection_id);
+  if (cs == nullptr) {
+    std::string errMsg = "Cache id " + std::to_string(connection_id) + " not found";
+    return Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__, errMsg);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(!rq->buf_data().empty(), "Missing row id");
+  auto &row_id_buf = rq->buf_data(0);
+  auto p = flatbuffers::GetRoot<TensorRowIds>(row_id_buf.data());
+  std::vector<row_id_type> row_id;
+  auto sz = p->row_id()->size();
+  row_id.reserve(sz);
+  for (uint32_t i = 0; i < sz; ++i) {
+    row_id.push_back(p->row_id()->Get(i));
+  }
+  return cs->ReadAhead(row_id);
+}
+
 Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
   auto connection_id = rq->connection_id();
   // Hold the shared lock to prevent the cache from being dropped.
@@ -828,6 +849,10 @@ Status CacheServer::ProcessRowRequest(CacheServerRequest *cache_req, bool *inter
       cache_req->rc_ = BatchFetchRows(&rq, &reply);
       break;
     }
+    case BaseRequest::RequestType::kReadAheadRows: {
+      cache_req->rc_ = ReadAheadRows(&rq);
+      break;
+    }
     case BaseRequest::RequestType::kInternalFetchRow: {
       *internal_request = true;
       cache_req->rc_ = InternalFetchRow(&rq);
@@ -993,8 +1018,8 @@ session_id_type CacheServer::GetSessionID(connection_id_type connection_id) cons
 }
 
 CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port,
-                         int32_t shared_meory_sz_in_gb, float memory_cap_ratio, int8_t log_level,
-                         std::shared_ptr<CacheServerHW> hw_info)
+                         int32_t shared_meory_sz_in_gb, float memory_cap_ratio, int32_t read_ahead_sz_in_mb,
+                         int8_t log_level, std::shared_ptr<CacheServerHW> hw_info)
     : top_(spill_path),
       num_workers_(num_workers),
       num_grpc_workers_(num_workers_),
@@ -1002,6 +1027,7 @@ CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int
       shared_memory_sz_in_gb_(shared_meory_sz_in_gb),
       global_shutdown_(false),
       memory_cap_ratio_(memory_cap_ratio),
+      read_ahead_sz_in_mb_(read_ahead_sz_in_mb),
       numa_affinity_(true),
       log_level_(log_level),
       hw_info_(std::move(hw_info)) {
@@ -1279,6 +1305,9 @@ Status CacheServer::Builder::SanityCheck() {
   if (memory_cap_ratio_ <= 0 || memory_cap_ratio_ > 1) {
     RETURN_STATUS_UNEXPECTED("Memory cap ratio should be positive and no greater than 1");
   }
+  if (read_ahead_sz_in_mb_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Read ahead size (in MB unit) must not be negative");
+  }
 
   // Check if the shared memory.
   RETURN_IF_NOT_OK(IpcResourceCleanup());
@@ -1305,6 +1334,7 @@ CacheServer::Builder::Builder()
       port_(kCfgDefaultCachePort),
       shared_memory_sz_in_gb_(kDefaultSharedMemorySize),
       memory_cap_ratio_(kDefaultMemoryCapRatio),
+      read_ahead_sz_in_mb_(kDefaultReadAheadSize),
       log_level_(kDefaultLogLevel) {
   if (num_workers_ == 0) {
     num_workers_ = 1;
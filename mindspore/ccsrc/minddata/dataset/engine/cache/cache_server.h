@@ -72,6 +72,7 @@ class CacheServer : public Service {
     int32_t GetPort() const { return port_; }
     int32_t GetSharedMemorySzInGb() const { return shared_memory_sz_in_gb_; }
     float GetMemoryCapRatio() const { return memory_cap_ratio_; }
+    int32_t GetReadAheadSizeInMB() const { return read_ahead_sz_in_mb_; }
     int8_t GetLogLevel() const { return log_level_; }
 
     Builder &SetRootDirectory(std::string root) {
@@ -94,6 +95,10 @@ class CacheServer : public Service {
       memory_cap_ratio_ = ratio;
       return *this;
     }
+    Builder &SetReadAheadSizeInMB(int32_t sz) {
+      read_ahead_sz_in_mb_ = sz;
+      return *this;
+    }
     Builder &SetLogLevel(int8_t log_level) {
       log_level_ = log_level;
       return *this;
@@ -108,6 +113,7 @@ class CacheServer : public Service {
           << "Tcp/ip port: " << GetPort() << "\n"
           << "Shared memory size (in GB): " << GetSharedMemorySzInGb() << "\n"
           << "Memory cap ratio: " << GetMemoryCapRatio() << "\n"
+          << "Read ahead size (in MB): " << GetReadAheadSizeInMB() << "\n"
           << "Log level: " << std::to_string(GetLogLevel());
     }
 
@@ -143,7 +149,8 @@ class CacheServer : public Service {
       // We need to bring up the Task Manager by bringing up the Services singleton.
       RETURN_IF_NOT_OK(Services::CreateInstance());
       RETURN_IF_NOT_OK(CacheServer::CreateInstance(top_, num_workers_, port_, shared_memory_sz_in_gb_,
-                                                   memory_cap_ratio_, log_level_, std::move(hw_info_)));
+                                                   memory_cap_ratio_, read_ahead_sz_in_mb_, log_level_,
+                                                   std::move(hw_info_)));
       return Status(StatusCode::kSuccess, warning_string);
     }
 
@@ -153,6 +160,7 @@ class CacheServer : public Service {
     int32_t port_;
     int32_t shared_memory_sz_in_gb_;
     float memory_cap_ratio_;
+    int32_t read_ahead_sz_in_mb_;
     int8_t log_level_;
     std::shared_ptr<CacheServerHW> hw_info_;
 
@@ -173,12 +181,12 @@ class CacheServer : public Service {
   ~CacheServer() override { (void)ServiceStop(); }
 
   static Status CreateInstance(const std::string &spill_path, int32_t num_workers, int32_t port,
-                               int32_t shared_memory_sz, float memory_cap_ratio, int8_t log_level,
-                               std::shared_ptr<CacheServerHW> hw_info) {
+                               int32_t shared_memory_sz, float memory_cap_ratio, int32_t read_ahead_sz_in_mb,
+                               int8_t log_level, std::shared_ptr<CacheServerHW> hw_info) {
     std::call_once(init_instance_flag_, [&]() -> Status {
       auto &SvcManager = Services::GetInstance();
       RETURN_IF_NOT_OK(SvcManager.AddHook(&instance_, spill_path, num_workers, port, shared_memory_sz, memory_cap_ratio,
-                                          log_level, hw_info));
+                                          read_ahead_sz_in_mb, log_level, hw_info));
       return Status::OK();
     });
     return Status::OK();
@@ -237,6 +245,9 @@ class CacheServer : public Service {
   /// \brief Return the memory cap ratio
   float GetMemoryCapRatio() const { return memory_cap_ratio_; }
 
+  /// \brief Return the size (in MB) of the memory to hold the spilled rows read ahead, 0 if the read ahead is off
+  int32_t GetReadAheadSizeInMB() const { return read_ahead_sz_in_mb_; }
+
   /// \brief Function to handle a row request
   /// \param[in] cache_req A row request to handle
   /// \param[out] internal_request Indicator if the request is an internal request
@@ -293,6 +304,7 @@ class CacheServer : public Service {
   int8_t log_level_;  // log_level is saved here for informational purpose only. It's not a functional field.
   std::atomic<bool> global_shutdown_;
   float memory_cap_ratio_;
+  int32_t read_ahead_sz_in_mb_;
   std::shared_ptr<CacheServerHW> hw_info_;
   std::map<worker_id_t, Task *> numa_tasks_;
   bool numa_affinity_;
@@ -303,7 +315,8 @@ class CacheServer : public Service {
   /// \param spill_path Top directory for spilling buffers to.
   /// \param num_workers Number of threads for handling requests.
   explicit CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port, int32_t share_memory_sz_in_gb,
-                       float memory_cap_ratio, int8_t log_level, std::shared_ptr<CacheServerHW> hw_info);
+                       float memory_cap_ratio, int32_t read_ahead_sz_in_mb, int8_t log_level,
+                       std::shared_ptr<CacheServerHW> hw_info);
 
   /// \brief Locate a cache service from connection id.
   /// \return Pointer to cache service. Null if not found
@@ -475,6 +488,11 @@ class CacheServer : public Service {
   /// \param[out] out A contiguous memory buffer that holds the requested rows.
   /// \return Status object
   Status BatchFetch(const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb, WritableSlice *out);
+
+  /// \brief Internal function to read the spilled rows of the coming batches ahead
+  /// \param rq Request
+  /// \return Status object
+  Status ReadAheadRows(CacheRequest *rq);
   Status BatchCacheRows(CacheRequest *rq);
 
   Status InternalFetchRow(CacheRequest *rq);
@@ -254,6 +254,15 @@ Status CacheService::PreBatchFetch(connection_id_type connection_id, const std::
   return Status::OK();
 }
 
+Status CacheService::ReadAhead(const std::vector<row_id_type> &v) {
+  SharedLock rw(&rw_lock_);
+  // It is only a hint. Nothing is read ahead until all the rows are cached.
+  if (HasBuildPhase() && st_ != CacheServiceState::kFetchPhase) {
+    return Status::OK();
+  }
+  return cp_->ReadAhead(v);
+}
+
 Status CacheService::InternalFetchRow(const FetchRowMsg *p) {
   RETURN_UNEXPECTED_IF_NULL(p);
   SharedLock rw(&rw_lock_);
@@ -75,6 +75,12 @@ class CacheService : public Service {
   Status PreBatchFetch(connection_id_type connection_id, const std::vector<row_id_type> &v,
                        const std::shared_ptr<flatbuffers::FlatBufferBuilder> &);
 
+  /// \brief Start reading the spilled rows ahead. The client sends the rows of each batch as soon as its sampler
+  /// produces them, so the rows are read in the order of the sampler, ahead of the batches being fetched.
+  /// \param v A vector of row id, in the order they are going to be fetched
+  /// \return Status object
+  Status ReadAhead(const std::vector<row_id_type> &v);
+
   /// \brief Getter function
   /// \return Spilling path
   Path GetSpillPath() const;
@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/engine/cache/storage_manager.h"
 
+#include <algorithm>
 #include <iomanip>
 
 #include "utils/ms_utils.h"
@@ -64,6 +65,14 @@ Status StorageManager::DoServiceStart() {
   } else {
     RETURN_STATUS_UNEXPECTED("Not a directory");
   }
+  if (read_ahead_budget_ > 0) {
+    read_ahead_queue_ = std::make_unique<Queue<ReadAheadRun>>(kReadAheadQueueSize);
+    RETURN_IF_NOT_OK(read_ahead_queue_->Register(&read_ahead_tasks_));
+    for (auto i = 0; i < num_read_ahead_tasks_; ++i) {
+      RETURN_IF_NOT_OK(
+        read_ahead_tasks_.CreateAsyncTask("Cache read ahead", std::bind(&StorageManager::ReadAheadWorker, this)));
+    }
+  }
   return Status::OK();
 }
 
@@ -129,8 +138,15 @@ Status StorageManager::Write(key_type *key, const std::vector<ReadableSlice> &bu
   return Status::OK();
 }
 
-Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, size_t *bytesRead) const {
+Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, size_t *bytesRead) {
   RETURN_UNEXPECTED_IF_NULL(dest);
+  if (read_ahead_queue_ != nullptr) {
+    bool found = false;
+    RETURN_IF_NOT_OK(ReadFromReadAhead(key, dest, bytesRead, &found));
+    if (found) {
+      return Status::OK();
+    }
+  }
   auto r = index_.Search(key);
   if (r.second) {
     auto &it = r.first;
@@ -154,9 +170,208 @@ Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, s
   return Status::OK();
 }
 
+Status StorageManager::ReadFromReadAhead(key_type key, WritableSlice *dest, size_t *bytesRead, bool *found) {
+  RETURN_UNEXPECTED_IF_NULL(found);
+  *found = false;
+  std::shared_ptr<uint8_t> buf;
+  size_t pos = 0;
+  size_t sz = 0;
+  {
+    std::unique_lock<std::mutex> lck(read_ahead_mux_);
+    auto it = read_ahead_entries_.find(key);
+    if (it == read_ahead_entries_.end()) {
+      return Status::OK();
+    }
+    // Wait for the read in progress. The entry is gone if the read fails, and then we go to the disk ourselves.
+    read_ahead_cv_.wait(lck, [this, key, &it]() {
+      it = read_ahead_entries_.find(key);
+      return it == read_ahead_entries_.end() || it->second.ready;
+    });
+    if (it == read_ahead_entries_.end()) {
+      return Status::OK();
+    }
+    auto &entry = it->second;
+    buf = entry.buf;
+    pos = entry.pos;
+    sz = entry.sz;
+    if (!entry.consumed) {
+      entry.consumed = true;
+      unread_lru_.erase(entry.lru_it);
+      entry.lru_it = consumed_lru_.insert(consumed_lru_.end(), key);
+    } else {
+      consumed_lru_.splice(consumed_lru_.end(), consumed_lru_, entry.lru_it);
+    }
+  }
+  // The buffer is held by us, so we can copy without the lock even if the row is evicted in the meantime.
+  if (dest->GetSize() < sz) {
+    std::string errMsg = "Destination buffer too small. Expect at least " + std::to_string(sz) +
+                         " but length = " + std::to_string(dest->GetSize());
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+  ReadableSlice src(buf.get() + pos, sz);
+  RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+  if (bytesRead != nullptr) {
+    *bytesRead = sz;
+  }
+  *found = true;
+  return Status::OK();
+}
+
+Status StorageManager::ReadAhead(const std::vector<key_type> &keys) {
+  if (read_ahead_queue_ == nullptr || keys.empty()) {
+    return Status::OK();
+  }
+  std::unique_lock<std::mutex> lck(read_ahead_mux_);
+  // Pick the rows in the given order until we run out of the budget, so the rows needed first are read first.
+  std::vector<std::pair<int, ReadAheadRow>> rows;
+  rows.reserve(keys.size());
+  for (auto key : keys) {
+    if (read_ahead_entries_.find(key) != read_ahead_entries_.end()) {
+      continue;
+    }
+    auto r = index_.Search(key);
+    if (!r.second) {
+      continue;
+    }
+    value_type v = *(r.first);
+    size_t sz = v.second.second;
+    if (!EvictReadAheadWhileHoldingLock(sz)) {
+      break;
+    }
+    ReadAheadEntry entry{nullptr, 0, sz, false, false, unread_lru_.end()};
+    (void)read_ahead_entries_.emplace(key, std::move(entry));
+    read_ahead_usage_ += sz;
+    rows.emplace_back(v.first, ReadAheadRow{key, v.second.first, sz});
+  }
+  // Sort the rows by where they are on the disk, and merge the ones close to each other into one read.
+  std::sort(rows.begin(), rows.end(),
+            [](const std::pair<int, ReadAheadRow> &a, const std::pair<int, ReadAheadRow> &b) {
+              return a.first != b.first ? a.first < b.first : a.second.offset < b.second.offset;
+            });
+  std::vector<ReadAheadRun> runs;
+  for (auto &row : rows) {
+    if (!runs.empty()) {
+      auto &run = runs.back();
+      off_t run_end = run.offset + static_cast<off_t>(run.sz);
+      off_t row_end = row.second.offset + static_cast<off_t>(row.second.sz);
+      if (run.container_inx == row.first && row.second.offset <= run_end + kMaxReadAheadGap &&
+          static_cast<size_t>(row_end - run.offset) <= kMaxReadAheadSize) {
+        run.sz = static_cast<size_t>(std::max(run_end, row_end) - run.offset);
+        run.rows.push_back(row.second);
+        continue;
+      }
+    }
+    runs.push_back(ReadAheadRun{row.first, row.second.offset, row.second.sz, {row.second}});
+  }
+  // The runs not finished yet are counted under the lock, so the queue has room and the Add below never blocks.
+  for (auto &run : runs) {
+    if (read_ahead_pending_ >= read_ahead_queue_->capacity()) {
+      for (auto &row : run.rows) {
+        EraseReadAheadWhileHoldingLock(row.key);
+      }
+      continue;
+    }
+    RETURN_IF_NOT_OK(read_ahead_queue_->Add(std::move(run)));
+    ++read_ahead_pending_;
+  }
+  return Status::OK();
+}
+
+Status StorageManager::ReadAheadWorker() {
+  TaskManager::FindMe()->Post();
+  while (true) {
+    ReadAheadRun run;
+    RETURN_IF_NOT_OK(read_ahead_queue_->PopFront(&run));
+    std::shared_ptr<uint8_t> buf(new (std::nothrow) uint8_t[run.sz], std::default_delete<uint8_t[]>());
+    Status rc;
+    if (buf == nullptr) {
+      rc = Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
+    } else {
+      std::shared_ptr<StorageContainer> cont;
+      {
+        SharedLock lock_s(&rw_lock_);
+        cont = containers_.at(run.container_inx);
+      }
+      WritableSlice dest(buf.get(), run.sz);
+      rc = cont->Read(&dest, run.offset);
+    }
+    if (rc.IsError()) {
+      // Not fatal. The rows will be read from the disk again by whoever needs them.
+      MS_LOG(WARNING) << "Read ahead of " << run.sz << " bytes failed. " << rc.ToString();
+    }
+    std::unique_lock<std::mutex> lck(read_ahead_mux_);
+    --read_ahead_pending_;
+    for (auto &row : run.rows) {
+      auto it = read_ahead_entries_.find(row.key);
+      if (it == read_ahead_entries_.end()) {
+        continue;
+      }
+      if (rc.IsError()) {
+        EraseReadAheadWhileHoldingLock(row.key);
+        continue;
+      }
+      auto &entry = it->second;
+      entry.buf = buf;
+      entry.pos = static_cast<size_t>(row.offset - run.offset);
+      entry.ready = true;
+      entry.lru_it = unread_lru_.insert(unread_lru_.end(), row.key);
+    }
+    read_ahead_cv_.notify_all();
+  }
+}
+
+bool StorageManager::EvictReadAheadWhileHoldingLock(size_t sz) {
+  if (sz > read_ahead_budget_) {
+    return false;
+  }
+  // Rows read already go first. Rows not read yet are evicted only if that is not enough, e.g. if the reader is gone.
+  while (read_ahead_usage_ + sz > read_ahead_budget_ && !consumed_lru_.empty()) {
+    EraseReadAheadWhileHoldingLock(consumed_lru_.front());
+  }
+  while (read_ahead_usage_ + sz > read_ahead_budget_ && !unread_lru_.empty()) {
+    EraseReadAheadWhileHoldingLock(unread_lru_.front());
+  }
+  return read_ahead_usage_ + sz <= read_ahead_budget_;
+}
+
+void StorageManager::EraseReadAheadWhileHoldingLock(key_type key) {
+  auto it = read_ahead_entries_.find(key);
+  if (it == read_ahead_entries_.end()) {
+    return;
+  }
+  auto &entry = it->second;
+  if (entry.ready) {
+    if (entry.consumed) {
+      consumed_lru_.erase(entry.lru_it);
+    } else {
+      unread_lru_.erase(entry.lru_it);
+    }
+  }
+  read_ahead_usage_ -= entry.sz;
+  read_ahead_entries_.erase(it);
+}
+
 Status StorageManager::DoServiceStop() noexcept {
   Status rc;
   Status rc1;
+  if (read_ahead_queue_ != nullptr) {
+    read_ahead_tasks_.interrupt_all();
+    rc = read_ahead_tasks_.join_all(Task::WaitFlag::kBlocking);
+    if (rc.IsError()) {
+      rc1 = rc;
+    }
+    // Wake up anyone waiting for a read which is never going to finish.
+    {
+      std::unique_lock<std::mutex> lck(read_ahead_mux_);
+      read_ahead_entries_.clear();
+      unread_lru_.clear();
+      consumed_lru_.clear();
+      read_ahead_usage_ = 0;
+      read_ahead_pending_ = 0;
+    }
+    read_ahead_cv_.notify_all();
+    read_ahead_queue_.reset();
+  }
   for (auto const &p : containers_) {
     // The destructor of StorageContainer is not called automatically until the use
     // count drops to 0. But it is not always the case. We will do it ourselves.
@@ -171,10 +386,26 @@ Status StorageManager::DoServiceStop() noexcept {
   return rc1;
 }
 
-StorageManager::StorageManager(const Path &root) : root_(root), file_id_(0), index_(), pool_size_(1) {}
+StorageManager::StorageManager(const Path &root)
+    : root_(root),
+      file_id_(0),
+      index_(),
+      pool_size_(1),
+      read_ahead_budget_(0),
+      num_read_ahead_tasks_(1),
+      read_ahead_usage_(0),
+      read_ahead_pending_(0) {}
 
-StorageManager::StorageManager(const Path &root, size_t pool_size)
-    : root_(root), file_id_(0), index_(), pool_size_(pool_size) {}
+StorageManager::StorageManager(const Path &root, size_t pool_size, size_t read_ahead_budget,
+                               int32_t num_read_ahead_tasks)
+    : root_(root),
+      file_id_(0),
+      index_(),
+      pool_size_(pool_size),
+      read_ahead_budget_(read_ahead_budget),
+      num_read_ahead_tasks_(num_read_ahead_tasks),
+      read_ahead_usage_(0),
+      read_ahead_pending_(0) {}
 
 StorageManager::~StorageManager() { (void)StorageManager::DoServiceStop(); }
 
@@ -18,8 +18,12 @@
 
 #include <unistd.h>
 
+#include <condition_variable>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -29,8 +33,10 @@
 #include "minddata/dataset/util/lock.h"
 #include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/service.h"
 #include "minddata/dataset/util/slice.h"
+#include "minddata/dataset/util/task_manager.h"
 
 using ListOfContainers = std::vector<std::shared_ptr<mindspore::dataset::StorageContainer>>;
 
@@ -51,10 +57,21 @@ class StorageManager : public Service {
   using storage_index = AutoIndexObj<value_type, std::allocator<value_type>, StorageBPlusTreeTraits>;
   using key_type = storage_index::key_type;
   constexpr static int32_t kMaxNumContainers = 1000;
+  /// \brief Max number of reads waiting for a read ahead task
+  constexpr static int32_t kReadAheadQueueSize = 1024;
+  /// \brief Rows of the same container are read in one go if the gap between them is not larger than this
+  constexpr static off_t kMaxReadAheadGap = 64 * 1024;
+  /// \brief Upper bound of the bytes read in one go
+  constexpr static size_t kMaxReadAheadSize = 4 * 1024 * 1024;
 
   explicit StorageManager(const Path &);
 
-  StorageManager(const Path &root, size_t pool_size);
+  /// \brief Constructor
+  /// \param root Directory of the containers
+  /// \param pool_size Number of containers open for write
+  /// \param read_ahead_budget Memory to hold the rows read ahead from the disk. 0, the default, turns it off
+  /// \param num_read_ahead_tasks Number of tasks reading ahead, which is also the number of disk reads outstanding
+  StorageManager(const Path &root, size_t pool_size, size_t read_ahead_budget = 0, int32_t num_read_ahead_tasks = 1);
 
   ~StorageManager() override;
 
@@ -64,7 +81,17 @@ class StorageManager : public Service {
 
   Status Write(key_type *out_key, const std::vector<ReadableSlice> &buf);
 
-  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead) const;
+  /// \brief Read a buffer back. If the buffer is read ahead, it is copied from memory, or we wait for the read in
+  /// progress, rather than reading the disk again.
+  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead);
+
+  /// \brief Read the buffers of the given keys ahead into memory by the read ahead tasks.
+  /// The keys are expected in the order they are going to be read. Buffers which are close to each other on the disk
+  /// are read in one go. Buffers which are already read ahead, or don't fit into the memory budget after evicting the
+  /// ones read already (least recently used first) and then the ones not read yet (oldest first), are skipped.
+  /// \param keys Keys returned from Write
+  /// \return Status object
+  Status ReadAhead(const std::vector<key_type> &keys);
 
   Status DoServiceStart() override;
 
@@ -72,7 +99,7 @@ class StorageManager : public Service {
 
   friend std::ostream &operator<<(std::ostream &os, const StorageManager &s);
 
- private:
+ protected:
   Path root_;
   ListOfContainers containers_;
   int file_id_;
@@ -81,6 +108,40 @@ class StorageManager : public Service {
   std::vector<size_t> writable_containers_pool_;
   size_t pool_size_;
 
+  // A row read ahead, and where it is on the disk
+  struct ReadAheadRow {
+    key_type key;
+    off_t offset;
+    size_t sz;
+  };
+  // Rows of the same container which are read in one go
+  struct ReadAheadRun {
+    int container_inx;
+    off_t offset;
+    size_t sz;
+    std::vector<ReadAheadRow> rows;
+  };
+  // A row in the read ahead tier. It shares the buffer with all the rows of the same run.
+  struct ReadAheadEntry {
+    std::shared_ptr<uint8_t> buf;
+    size_t pos;
+    size_t sz;
+    bool ready;
+    bool consumed;
+    std::list<key_type>::iterator lru_it;
+  };
+  size_t read_ahead_budget_;
+  int32_t num_read_ahead_tasks_;
+  size_t read_ahead_usage_;
+  size_t read_ahead_pending_;  // runs in the queue or being read
+  std::mutex read_ahead_mux_;
+  std::condition_variable read_ahead_cv_;
+  std::unordered_map<key_type, ReadAheadEntry> read_ahead_entries_;
+  std::list<key_type> unread_lru_;    // rows read ahead but not read yet, the oldest first
+  std::list<key_type> consumed_lru_;  // rows read ahead and read already, the least recently used first
+  std::unique_ptr<Queue<ReadAheadRun>> read_ahead_queue_;
+  TaskGroup read_ahead_tasks_;
+
   static std::string GetBaseName(const std::string &prefix, int32_t file_id);
 
   static std::string ConstructFileName(const std::string &prefix, int32_t file_id, const std::string &suffix);
@@ -91,6 +152,20 @@ class StorageManager : public Service {
   /// container in the pool. If not provided, will just append the newly created container to the end of the pool.
   /// \return Status object
   Status AddOneContainer(int replaced_container_pos = -1);
+
+  /// \brief Entry point of the read ahead tasks.
+  Status ReadAheadWorker();
+
+  /// \brief Evict the rows read ahead until there is room for sz bytes. Must be called with read_ahead_mux_ held.
+  /// \return True if there is room for sz bytes
+  bool EvictReadAheadWhileHoldingLock(size_t sz);
+
+  /// \brief Remove a row from the read ahead tier. Must be called with read_ahead_mux_ held.
+  void EraseReadAheadWhileHoldingLock(key_type key);
+
+  /// \brief Copy a row out of the read ahead tier, waiting for it if the read is in progress.
+  /// \param[out] found False if the row is not read ahead, and the caller should read it from the disk
+  Status ReadFromReadAhead(key_type key, WritableSlice *dest, size_t *bytesRead, bool *found);
 };
 }  // namespace dataset
 }  // namespace mindspore
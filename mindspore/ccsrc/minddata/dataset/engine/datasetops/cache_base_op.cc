@@ -101,6 +101,8 @@ Status CacheBase::FetchSamplesToWorkers() {
         prefetch_keys.push_back(*itr);
         // Batch enough rows for performance reason.
         if (row_cnt_ % prefetch_size_ == 0) {
+          // The server can read the spilled rows ahead while the batches queued before this one are fetched.
+          RETURN_IF_NOT_OK(cache_client_->ReadAhead(prefetch_keys));
           RETURN_IF_NOT_OK(send_to_que(prefetch_queues_, prefetch_cnt++ % num_prefetchers_, prefetch_keys));
           // Now we tell the WorkerEntry to wait for them to come back.
           for (auto row_id : prefetch_keys) {
@@ -115,6 +117,7 @@ Status CacheBase::FetchSamplesToWorkers() {
     }
     // Deal with any partial keys left.
     if (!prefetch_keys.empty()) {
+      RETURN_IF_NOT_OK(cache_client_->ReadAhead(prefetch_keys));
       RETURN_IF_NOT_OK(send_to_que(prefetch_queues_, prefetch_cnt++ % num_prefetchers_, prefetch_keys));
       for (auto row_id : prefetch_keys) {
         keys.push_back(row_id);
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <set>
 #include <string>
 #include <utility>
@@ -34,6 +35,10 @@ CpuMapJob::~CpuMapJob() = default;
 // A function to execute a cpu map job
 Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
+  if (in.size() > 1 &&
+      std::any_of(ops_.begin(), ops_.end(), [](const auto &op) { return op != nullptr && op->SupportBatch(); })) {
+    return RunBatch(std::move(in), out);
+  }
   int32_t num_rows = in.size();
   for (int32_t row = 0; row < num_rows; row++) {
     TensorRow input_row = in[row];
@@ -55,6 +60,38 @@ Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
   return Status::OK();
 }
 
+Status CpuMapJob::RunBatch(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
+  std::vector<TensorRow> result_table;
+  for (size_t i = 0; i < ops_.size(); i++) {
+    Status rc;
+    if (ops_[i]->SupportBatch()) {
+      result_table.clear();
+      rc = ops_[i]->BatchCompute(in, &result_table);
+      if (rc.IsOk() && result_table.size() != in.size()) {
+        rc = Status(StatusCode::kMDUnexpectedError, "[Internal ERROR] BatchCompute should produce " +
+                                                      std::to_string(in.size()) + " rows, but got " +
+                                                      std::to_string(result_table.size()) + " rows.");
+      }
+    }
+    if (!ops_[i]->SupportBatch() || rc.IsError()) {
+      // Run the rows one by one, so that the error is reported with the data files of the failed row.
+      result_table.clear();
+      result_table.resize(in.size());
+      for (size_t row = 0; row < in.size(); row++) {
+        rc = ops_[i]->Compute(in[row], &result_table[row]);
+        if (rc.IsError()) {
+          RETURN_IF_NOT_OK(RebuildMapErrorMsg(in[row], i, &rc));
+        }
+      }
+    }
+    in = std::move(result_table);
+  }
+  for (auto &row : in) {
+    out->push_back(std::move(row));
+  }
+  return Status::OK();
+}
+
 Status CpuMapJob::RebuildMapErrorMsg(const TensorRow &input_row, const size_t &i, Status *rc) {
   std::string err_msg = "";
   std::string op_name = ops_[i]->Name();
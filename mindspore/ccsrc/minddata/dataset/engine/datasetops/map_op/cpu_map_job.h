@@ -37,6 +37,9 @@ class CpuMapJob : public MapJob {
   Status Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) override;
 
  private:
+  // Run the operations one by one over all the rows, so that the operations supporting batch get all the rows at once.
+  Status RunBatch(std::vector<TensorRow> in, std::vector<TensorRow> *out);
+
   Status RebuildMapErrorMsg(const TensorRow &input_row, const size_t &i, Status *rc);
 };
 
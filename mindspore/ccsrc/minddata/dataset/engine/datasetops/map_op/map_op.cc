@@ -38,7 +38,10 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
       tfuncs_(std::move(tensor_funcs)),
       in_columns_(in_col_names),
       out_columns_(out_col_names),
-      python_mp_(nullptr) {
+      python_mp_(nullptr),
+      map_batch_size_(GlobalContext::config_manager()->map_batch_size()),
+      collect_worker_id_(0),
+      collect_rows_left_(0) {
   // Set connector size via config.
   // If caller didn't specify the out_col_names, assume they are same as the in_columns.
   if (out_columns_.empty() || out_columns_[0].empty()) {
@@ -70,17 +73,35 @@ void MapOp::Print(std::ostream &out, bool show_all) const {
 }
 
 // A helper function that fetch worker map job from local queues and extract the data and map job list
-Status MapOp::FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list) {
+Status MapOp::FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<TensorRow> *batch_rows,
+                            std::vector<std::shared_ptr<MapJob>> *job_list) {
   std::unique_ptr<MapWorkerJob> worker_job;
   // Fetch the next worker job and TensorRow
   RETURN_IF_NOT_OK(worker_in_queues_[worker_id]->PopFront(&worker_job));
   // Extract the TensorRow and job list from the map worker job.
   *row = std::move(worker_job->tensor_row);
+  *batch_rows = std::move(worker_job->tensor_rows);
   *job_list = std::move(worker_job->jobs);
 
   return Status::OK();
 }
 
+Status MapOp::SendJobToWorker(std::unique_ptr<MapWorkerJob> worker_job, int32_t num_rows) {
+  int32_t worker_id = NextWorkerID();
+  if (job_order_queue_ != nullptr) {
+    RETURN_IF_NOT_OK(job_order_queue_->EmplaceBack(worker_id, num_rows));
+  }
+  return worker_in_queues_[worker_id]->Add(std::move(worker_job));
+}
+
+Status MapOp::SendBatchToWorker(std::vector<TensorRow> *batch_rows) {
+  int32_t num_rows = static_cast<int32_t>(batch_rows->size());
+  auto worker_job = std::make_unique<MapWorkerJob>(std::move(*batch_rows));
+  batch_rows->clear();
+  RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
+  return SendJobToWorker(std::move(worker_job), num_rows);
+}
+
 Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job) {
   std::shared_ptr<MapJob> map_job = nullptr;
   MapTargetDevice prev_target = MapTargetDevice::kCpu;
@@ -112,6 +133,11 @@ Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job)
 
 // This class functor will provide the master loop that drives the logic for performing the work
 Status MapOp::operator()() {
+  if (map_batch_size_ > 1) {
+    RETURN_UNEXPECTED_IF_NULL(tree_);
+    job_order_queue_ = std::make_unique<Queue<std::pair<int32_t, int32_t>>>(num_workers_ * worker_connector_size_);
+    RETURN_IF_NOT_OK(job_order_queue_->Register(tree_->AllTasks()));
+  }
   RETURN_IF_NOT_OK(RegisterAndLaunchThreads());
   // init callback
   RETURN_IF_NOT_OK(callback_manager_.Init(this));
@@ -125,6 +151,7 @@ Status MapOp::operator()() {
 
   child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
   TensorRow new_row;
+  std::vector<TensorRow> batch_rows;
   RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
 
   while (!new_row.eof()) {
@@ -139,27 +166,39 @@ Status MapOp::operator()() {
 
       RETURN_IF_NOT_OK(callback_manager_.StepBegin(CallbackParam(op_current_epochs_ + 1, ep_step, total_step)));
 
-      std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
+      if (map_batch_size_ > 1) {
+        // Collect the consecutive rows and push them to a worker at once
+        batch_rows.push_back(std::move(new_row));
+        if (batch_rows.size() == static_cast<size_t>(map_batch_size_)) {
+          RETURN_IF_NOT_OK(SendBatchToWorker(&batch_rows));
+        }
+      } else {
+        std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
 
-      // Populate map worker job for a worker to execute
-      RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
+        // Populate map worker job for a worker to execute
+        RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
 
-      // Push map worker job to the corresponding worker's queue
-      RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+        // Push map worker job to the corresponding worker's queue
+        RETURN_IF_NOT_OK(SendJobToWorker(std::move(worker_job), 1));
+      }
 
       RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
     }
+    // Push the rows left before the end of epoch
+    if (!batch_rows.empty()) {
+      RETURN_IF_NOT_OK(SendBatchToWorker(&batch_rows));
+    }
 
     // Propagate the eoe row to worker
     std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-    RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+    RETURN_IF_NOT_OK(SendJobToWorker(std::move(worker_job), 1));
     UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   }
   // End() is commented out because it might never be called due to the lack of EOF when EpochCtrl is -1
   // Handle eof logic, this code might never be reached if epoch_ctrl = -1.
   std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-  RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+  RETURN_IF_NOT_OK(SendJobToWorker(std::move(worker_job), 1));
 
   // Quit all workers, this code might never be reached if EpochCtrl is -1.
   for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
@@ -178,16 +217,25 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
   TaskManager::FindMe()->Post();
 
   TensorRow in_row;
+  std::vector<TensorRow> in_rows;
+  std::vector<TensorRow> out_rows;
   std::vector<std::shared_ptr<MapJob>> job_list;
   // Fetch next data row and map job list
-  RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
+  RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &in_rows, &job_list));
 
   // Now that init work is done, drop into the main fetching loop.
   // Map op does not use child iterator, and it needs to manually handle eoe and eof's itself
   // rather than use the base-class defaults.
   while (true) {
-    // Handle special logic where row carries a ctrl flag.
-    if (in_row.Flags() != TensorRow::kFlagNone) {
+    if (!in_rows.empty()) {
+      // Perform the compute function of TensorOp(s) on the batch, and push the rows in order.
+      out_rows.clear();
+      RETURN_IF_NOT_OK(WorkerCompute(std::move(in_rows), &out_rows, job_list));
+      for (auto &out_row : out_rows) {
+        RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(out_row)));
+      }
+    } else if (in_row.Flags() != TensorRow::kFlagNone) {
+      // Handle special logic where row carries a ctrl flag.
       if (in_row.quit()) {
         break;
       }
@@ -201,34 +249,42 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
       RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(out_row)));
     }
     // Fetch next data row and map job list
-    RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
+    RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &in_rows, &job_list));
   }
   return Status::OK();
 }
 
 Status MapOp::WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
                             const std::vector<std::shared_ptr<MapJob>> &job_list) {
-  int32_t num_cols = in_row.size();
+  std::vector<TensorRow> out_rows;
+  RETURN_IF_NOT_OK(WorkerCompute(std::vector<TensorRow>{in_row}, &out_rows, job_list));
+  *out_row = std::move(out_rows[0]);
+  return Status::OK();
+}
 
+Status MapOp::WorkerCompute(std::vector<TensorRow> in_rows, std::vector<TensorRow> *out_rows,
+                            const std::vector<std::shared_ptr<MapJob>> &job_list) {
   std::vector<TensorRow> job_input_table;
-  std::vector<TensorRow> original_table;
-  TensorRow to_process;
-  // Prepare the data that we need from in_row
+  job_input_table.reserve(in_rows.size());
+  // Prepare the data that we need from in_rows
   // to_process   : A vector of Tensors only holding cols in input_columns.
-
-  // From the current row, select the Tensor that need to be passed to TensorOp
-  (void)std::transform(to_process_indices_.begin(), to_process_indices_.end(), std::back_inserter(to_process),
-                       [&in_row](const auto &it) { return std::move(in_row[it]); });
-  to_process.setId(in_row.getId());
-  std::vector<std::string> cur_row_path = in_row.getPath();
-  if (cur_row_path.size() > 0) {
-    std::vector<std::string> to_process_path;
-    (void)std::transform(to_process_indices_.begin(), to_process_indices_.end(), std::back_inserter(to_process_path),
-                         [&cur_row_path](const auto &it) { return cur_row_path[it]; });
-    to_process.setPath(to_process_path);
+  for (const auto &in_row : in_rows) {
+    CHECK_FAIL_RETURN_UNEXPECTED(in_row.size() != 0, "[Internal ERROR] MapOp got an empty TensorRow.");
+    TensorRow to_process;
+    // From the current row, select the Tensor that need to be passed to TensorOp
+    (void)std::transform(to_process_indices_.begin(), to_process_indices_.end(), std::back_inserter(to_process),
+                         [&in_row](const auto &it) { return in_row[it]; });
+    to_process.setId(in_row.getId());
+    const std::vector<std::string> &cur_row_path = in_row.getPath();
+    if (cur_row_path.size() > 0) {
+      std::vector<std::string> to_process_path;
+      (void)std::transform(to_process_indices_.begin(), to_process_indices_.end(),
+                           std::back_inserter(to_process_path),
+                           [&cur_row_path](const auto &it) { return cur_row_path[it]; });
+      to_process.setPath(to_process_path);
+    }
+    job_input_table.push_back(std::move(to_process));
   }
-  job_input_table.push_back(std::move(to_process));
-  original_table.push_back(std::move(in_row));
 
   // Variable to keep the result after executing the job.
   std::vector<TensorRow> result_table;
@@ -240,8 +296,13 @@ Status MapOp::WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
     // Assign the processed data as an input for the next job processing, except for the last TensorOp in the list.
     if (i + 1 < job_list.size()) {
       job_input_table = std::move(result_table);
+      result_table.clear();
     }
   }
+  CHECK_FAIL_RETURN_UNEXPECTED(result_table.size() == in_rows.size(),
+                               "[Internal ERROR] MapOp expects " + std::to_string(in_rows.size()) +
+                                 " rows after executing the jobs, but got " + std::to_string(result_table.size()) +
+                                 " rows.");
 
   // Sanity check a row in result_table
   if (!result_table.empty() && out_columns_.size() != result_table[0].size()) {
@@ -253,25 +314,45 @@ Status MapOp::WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
   }
 
   // Merging the data processed by job (result_table) with the data that are not used.
-  if (in_columns_.size() == out_columns_.size()) {
-    // Place the processed tensor back into the original index of the input tensor
-    for (size_t i = 0; i < result_table[0].size(); i++) {
-      original_table[0][to_process_indices_[i]] = std::move(result_table[0][i]);
-    }
-    *out_row = std::move(original_table[0]);
-  } else {
-    // Append the data in the original table that we did not use to the end of each row in result_table.
-    for (int32_t i = 0; i < num_cols; i++) {
-      if (keep_input_columns_[i]) {
-        result_table[0].push_back(std::move(original_table[0][i]));
+  out_rows->reserve(out_rows->size() + result_table.size());
+  for (size_t row = 0; row < result_table.size(); row++) {
+    TensorRow &original_row = in_rows[row];
+    TensorRow &result_row = result_table[row];
+    if (in_columns_.size() == out_columns_.size()) {
+      // Place the processed tensor back into the original index of the input tensor
+      for (size_t i = 0; i < result_row.size(); i++) {
+        original_row[to_process_indices_[i]] = std::move(result_row[i]);
+      }
+      out_rows->push_back(std::move(original_row));
+    } else {
+      // Append the data in the original table that we did not use to the end of each row in result_table.
+      for (size_t i = 0; i < original_row.size(); i++) {
+        if (keep_input_columns_[i]) {
+          result_row.push_back(std::move(original_row[i]));
+        }
       }
+      out_rows->push_back(std::move(result_row));
     }
-    *out_row = std::move(result_table[0]);
   }
 
   return Status::OK();
 }
 
+Status MapOp::PopWorkerOutput(int64_t num_rows, TensorRow *row) {
+  if (job_order_queue_ == nullptr) {
+    return ParallelOp::PopWorkerOutput(num_rows, row);
+  }
+  // The rows of a job are pushed to the output queue of its worker together, pop them all before the next job.
+  if (collect_rows_left_ == 0) {
+    std::pair<int32_t, int32_t> job_order;
+    RETURN_IF_NOT_OK(job_order_queue_->PopFront(&job_order));
+    collect_worker_id_ = job_order.first;
+    collect_rows_left_ = job_order.second;
+  }
+  collect_rows_left_--;
+  return worker_out_queues_[collect_worker_id_]->PopFront(row);
+}
+
 Status MapOp::ComputeColMap() {
   // If the map has not been set up yet in the base class, then set it up
   if (column_name_id_map_.empty()) {
@@ -379,6 +460,9 @@ void MapOp::CreateFinalColMap(std::unordered_map<std::string, int32_t> *col_name
 
 Status MapOp::SendWaitFlagToWorker(int32_t worker_id) {
   TensorRow wait_row(TensorRow::kFlagWait);
+  if (job_order_queue_ != nullptr) {
+    RETURN_IF_NOT_OK(job_order_queue_->EmplaceBack(worker_id, 1));
+  }
   RETURN_IF_NOT_OK(worker_in_queues_[worker_id]->Add(std::make_unique<MapWorkerJob>(wait_row)));
   return Status::OK();
 }
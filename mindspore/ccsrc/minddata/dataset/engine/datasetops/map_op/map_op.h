@@ -41,8 +41,12 @@ class ExecutionTree;
 // MapWorkerJob holds a list of MapJob where each MapJob can be a CpuMapJob, GpuMapJob or DvppMapJob.
 struct MapWorkerJob {
   explicit MapWorkerJob(TensorRow tr) : tensor_row(std::move(tr)) {}
+  explicit MapWorkerJob(std::vector<TensorRow> rows) : tensor_rows(std::move(rows)) {}
   std::vector<std::shared_ptr<MapJob>> jobs;
   TensorRow tensor_row;
+  // The consecutive rows processed by the worker at once when map batch size is greater than 1.
+  // tensor_row is not used if it is not empty.
+  std::vector<TensorRow> tensor_rows;
 };
 
 // MapOp class implements the Map operator. It will apply a list of operations to each record specified by column names.
@@ -141,7 +145,17 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
   Status GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job);
 
   // A helper function that fetch worker map job from local queues and extract the data and map job list
-  Status FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list);
+  // @param[out] batch_rows The rows of a batched job, row is not used if it is not empty
+  Status FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<TensorRow> *batch_rows,
+                       std::vector<std::shared_ptr<MapJob>> *job_list);
+
+  // A helper function to push the worker job to the next worker.
+  // @param worker_job The job to push
+  // @param num_rows The number of rows the worker will output for the job
+  Status SendJobToWorker(std::unique_ptr<MapWorkerJob> worker_job, int32_t num_rows);
+
+  // A helper function to push the rows collected to the next worker as a batched job.
+  Status SendBatchToWorker(std::vector<TensorRow> *batch_rows);
 
   //  Tensorops to be read and applied by worker threads
   std::vector<std::shared_ptr<TensorOp>> tfuncs_;
@@ -162,6 +176,18 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
 
   std::shared_ptr<PythonMultiprocessingRuntime> python_mp_;  // python multiprocessing instance
 
+  // The number of consecutive rows sent to a worker at once, the rows are processed by the ops supporting batch
+  // in one call. 1 means the rows are sent one by one.
+  int32_t map_batch_size_;
+
+  // The worker id and the number of output rows of each job in the order they are sent to the workers, so that the
+  // collector outputs the rows in order when the number of rows in the jobs differ. Only used when batching.
+  std::unique_ptr<Queue<std::pair<int32_t, int32_t>>> job_order_queue_;
+
+  // The worker the collector is popping rows from, and the number of rows to pop from it for the current job.
+  int32_t collect_worker_id_;
+  int32_t collect_rows_left_;
+
   // Private function for worker/thread to loop continuously. It comprises the main
   // logic of MapOp: getting the data from previous Op, validating user specified column names,
   // applying a list of TensorOps to each of the data, process the results and then
@@ -176,6 +202,15 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
   Status WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
                        const std::vector<std::shared_ptr<MapJob>> &job_list);
 
+  // Private function for worker thread to perform TensorOp's compute function on a batch of rows.
+  // @param in_rows Input TensorRows
+  // @param[out] out_rows Generated TensorRows, one for each input row
+  Status WorkerCompute(std::vector<TensorRow> in_rows, std::vector<TensorRow> *out_rows,
+                       const std::vector<std::shared_ptr<MapJob>> &job_list);
+
+  // Pop the next row from the output queues of the workers, following the order the jobs are sent when batching.
+  Status PopWorkerOutput(int64_t num_rows, TensorRow *row) override;
+
   // Private function that create the final column name to index mapping and
   // get indices of the columns this mapop does not use.
   // @param col_name_id_map The column name to index mapping obtained from child operator
@@ -112,7 +112,7 @@ class ParallelOp : public DatasetOp {
     int32_t current_repeats = 0, current_epochs = 0;
     TensorRow row;
     do {
-      RETURN_IF_NOT_OK(worker_out_queues_[num_rows++ % num_workers_]->PopFront(&row));
+      RETURN_IF_NOT_OK(PopWorkerOutput(num_rows++, &row));
       if (row.wait()) {
         // When collector receives the signal from workere thread, it increments a atomic int
         // If num_worker signals are received, wakes up the main thread
@@ -143,6 +143,14 @@ class ParallelOp : public DatasetOp {
     return Status::OK();
   }
 
+  /// Pop the next row from the output queues of the workers, the rows are sent to the workers in round robin.
+  /// \param num_rows The number of rows received since the workers started or paused last time
+  /// \param[out] row The row popped
+  /// \return Status The status code returned
+  virtual Status PopWorkerOutput(int64_t num_rows, TensorRow *row) {
+    return worker_out_queues_[num_rows % num_workers_]->PopFront(row);
+  }
+
   Status WaitForWorkers() {
     // reset num_paused workers to 0
     num_workers_paused_ = 0;
@@ -16,15 +16,19 @@
 #if defined(_WIN32) || defined(_WIN64)
 #include <stdlib.h>
 #endif
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <random>
 #include <utility>
 
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
+#include "minddata/dataset/engine/execution_tree.h"
 
 #include "minddata/dataset/util/log_adapter.h"
 #include "minddata/dataset/util/random.h"
@@ -35,9 +39,12 @@ namespace dataset {
 constexpr int32_t ShuffleOp::kShuffleStateInit;
 constexpr int32_t ShuffleOp::kShuffleStateActive;
 constexpr int32_t ShuffleOp::kShuffleStateDrain;
+constexpr int32_t ShuffleOp::kShardEoe;
+constexpr int32_t ShuffleOp::kShardEof;
 
 // Constructor of the ShuffleOp
-ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch)
+ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
+                     int32_t num_shards)
     : PipelineOp(op_connector_size),
       shuffle_size_(shuffle_size),
       shuffle_seed_(shuffle_seed),
@@ -45,7 +52,11 @@ ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_con
       rng_(shuffle_seed),
       shuffle_buffer_(std::make_unique<TensorTable>()),
       shuffle_last_row_idx_(0),
-      shuffle_buffer_state_(kShuffleStateInit) {}
+      shuffle_buffer_state_(kShuffleStateInit),
+      num_shards_(std::max(1, std::min(num_shards, shuffle_size))),
+      shard_capacity_(0) {
+  shard_capacity_ = (shuffle_size_ + num_shards_ - 1) / num_shards_;
+}
 
 // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
 // itself rather than waiting for the reset driven from operators above it in the pipeline.
@@ -60,6 +71,7 @@ Status ShuffleOp::SelfReset() {
   }
 
   shuffle_buffer_ = std::make_unique<TensorTable>();
+  shuffle_handles_.clear();
   shuffle_last_row_idx_ = 0;
   shuffle_buffer_state_ = kShuffleStateInit;
   return Status::OK();
@@ -71,13 +83,13 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
     // Call the super class for displaying any common 1-liner info
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal 1-liner info for this op
-    out << " [shuffle size: " << shuffle_size_ << "]\n";
+    out << " [shuffle size: " << shuffle_size_ << "] [shards: " << num_shards_ << "]\n";
   } else {
     // Call the super class for displaying any common detailed info
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal stuff
     out << "\nShuffle size: " << shuffle_size_ << "\nShuffle buffer state: " << shuffle_buffer_state_
-        << "\nShuffle seed: " << shuffle_seed_ << "\n\n";
+        << "\nShuffle seed: " << shuffle_seed_ << "\nNumber of shards: " << num_shards_ << "\n\n";
   }
 }
 
@@ -91,13 +103,15 @@ Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
   // selection that was done previously!)
   if (shuffle_last_row_idx_ < (shuffle_size_ - 1)) {
     shuffle_buffer_->push_back(std::move(new_shuffle_row));
+    shuffle_handles_.push_back(static_cast<int32_t>(shuffle_buffer_->size()) - 1);
     shuffle_last_row_idx_ = (shuffle_buffer_->size()) - 1;
   } else {
-    if (!(*shuffle_buffer_)[shuffle_last_row_idx_].empty()) {
+    int32_t handle = shuffle_handles_[shuffle_last_row_idx_];
+    if (!(*shuffle_buffer_)[handle].empty()) {
       return Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__,
                     "[Internal ERROR] Last row of shuffle buffer should not be occupied!");
     }
-    (*shuffle_buffer_)[shuffle_last_row_idx_] = std::move(new_shuffle_row);
+    (*shuffle_buffer_)[handle] = std::move(new_shuffle_row);
   }
   return Status::OK();
 }
@@ -106,8 +120,13 @@ Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
 // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
 // provide the master loop that drives the logic for performing the work
 Status ShuffleOp::operator()() {
-  std::unique_ptr<TensorQTable> new_buffer_table;  // A tensor table to be used for output.
+  if (num_shards_ > 1) {
+    return ShuffleRowsSharded();
+  }
+  return ShuffleRows();
+}
 
+Status ShuffleOp::ShuffleRows() {
   // Synchronize with TaskManager once the thread is launched.
   TaskManager::FindMe()->Post();
 
@@ -133,29 +152,22 @@ Status ShuffleOp::operator()() {
     // fully drained the data from the shuffle buffer and we're done.
     while (shuffle_last_row_idx_ >= 0) {
       // Step 1)
-      // Create an output tensor table if one is not created yet.
-      if (!new_buffer_table) {
-        new_buffer_table = std::make_unique<TensorQTable>();
-      }
-
-      // Step 2)
-      // Randomly select a slot from our shuffle buffer and copy that row into the output
-      // tensor table. We remove the data from the shuffle buffer, leaving that slot
-      // in the table as an empty vector
+      // Randomly select a slot from our shuffle buffer and send that row to the output connector.
+      // We remove the data from the shuffle buffer, leaving that row in the table as an empty vector
       int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
-      TensorRow random_row = std::move((*shuffle_buffer_)[random_slot]);
+      int32_t random_handle = shuffle_handles_[random_slot];
+      TensorRow random_row = std::move((*shuffle_buffer_)[random_handle]);
       MS_LOG(DEBUG) << "Shuffle operator sending a row to output.";
       RETURN_IF_NOT_OK(out_connector_->Add(std::move(random_row)));
 
-      // Step 3)
-      // Take the last row from shuffle buffer, and swap it into the row position that was
-      // just vacated.  This makes the shuffle buffer contiguous, with an empty slot at the
-      // tail of the shuffle buffer.
-      if (random_slot != shuffle_last_row_idx_) {
-        (*shuffle_buffer_)[random_slot] = std::move((*shuffle_buffer_)[shuffle_last_row_idx_]);
-      }
+      // Step 2)
+      // Swap the handle of the row just vacated with the last handle. This keeps the handles of the
+      // buffered rows contiguous, with the handle of the empty row at the tail. Only the handles are
+      // moved, the rows stay where they are.
+      shuffle_handles_[random_slot] = shuffle_handles_[shuffle_last_row_idx_];
+      shuffle_handles_[shuffle_last_row_idx_] = random_handle;
 
-      // Step 4)
+      // Step 3)
       // Refill the last slot of the shuffle buffer with the next row from input if we are in the
       // active state.
       // If we are in the draining state, we do not need to fetch another row to replace the one we
@@ -248,6 +260,149 @@ Status ShuffleOp::InitShuffleBuffer() {
   return Status::OK();
 }
 
+Status ShuffleOp::ShuffleRowsSharded() {
+  RETURN_UNEXPECTED_IF_NULL(tree_);
+  // Each shard buffers at most shard_capacity_ rows and each queue holds at most oc_queue_size_ handles, plus the one
+  // row held by the op thread. So the slots of the shuffle buffer are never used up.
+  int32_t num_slots = num_shards_ * (shard_capacity_ + 2 * oc_queue_size_) + 1;
+  shuffle_buffer_ = std::make_unique<TensorTable>(num_slots);
+  free_handles_.resize(num_slots);
+  std::iota(free_handles_.rbegin(), free_handles_.rend(), 0);
+  shard_in_queues_.Init(num_shards_, oc_queue_size_);
+  shard_out_queues_.Init(num_shards_, oc_queue_size_);
+  RETURN_IF_NOT_OK(shard_in_queues_.Register(tree_->AllTasks()));
+  RETURN_IF_NOT_OK(shard_out_queues_.Register(tree_->AllTasks()));
+  RETURN_IF_NOT_OK(tree_->LaunchWorkers(num_shards_, std::bind(&ShuffleOp::ShardEntry, this, std::placeholders::_1),
+                                        Name() + "::ShardEntry", id()));
+  RETURN_IF_NOT_OK(tree_->AllTasks()->CreateAsyncTask(
+    Name() + "::CollectorEntry", std::bind(&ShuffleOp::CollectorEntry, this), nullptr, id()));
+  TaskManager::FindMe()->Post();
+  child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
+
+  // Every shard takes one row in each round, so the shards stay balanced and the collector never waits on a shard
+  // starving for rows. The order of the shards is shuffled in each round, so the rows next to each other in the
+  // input are spread to different shards.
+  std::vector<int32_t> shard_order(num_shards_);
+  std::iota(shard_order.begin(), shard_order.end(), 0);
+  int32_t next_shard = num_shards_;
+  TensorRow new_row;
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+  while (!child_iterator_->EofHandled()) {
+    if (new_row.empty()) {
+      // End of the epoch, the shards send all their rows and then the eoe
+      RETURN_IF_NOT_OK(SendMarkerToShards(kShardEoe));
+      next_shard = num_shards_;
+      if (!reshuffle_each_epoch_) {
+        rng_ = std::mt19937_64(shuffle_seed_);
+        std::iota(shard_order.begin(), shard_order.end(), 0);
+      }
+    } else {
+      if (next_shard == num_shards_) {
+        for (int32_t i = num_shards_ - 1; i > 0; --i) {
+          std::swap(shard_order[i], shard_order[rng_() % (i + 1)]);
+        }
+        next_shard = 0;
+      }
+      int32_t handle = 0;
+      {
+        std::unique_lock<std::mutex> lock(free_handles_mutex_);
+        CHECK_FAIL_RETURN_UNEXPECTED(!free_handles_.empty(), "[Internal ERROR] Shuffle buffer has no free slot.");
+        handle = free_handles_.back();
+        free_handles_.pop_back();
+      }
+      (*shuffle_buffer_)[handle] = std::move(new_row);
+      RETURN_IF_NOT_OK(shard_in_queues_[shard_order[next_shard++]]->Add(handle));
+    }
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+  }
+  MS_LOG(DEBUG) << "Shuffle operator picked up EOF. No more epochs.";
+  return SendMarkerToShards(kShardEof);
+}
+
+Status ShuffleOp::SendMarkerToShards(int32_t marker) {
+  for (int32_t i = 0; i < num_shards_; ++i) {
+    RETURN_IF_NOT_OK(shard_in_queues_[i]->Add(marker));
+  }
+  return Status::OK();
+}
+
+Status ShuffleOp::ShardEntry(int32_t shard_id) {
+  TaskManager::FindMe()->Post();
+  // Each shard has its own random generator, so the rows it picks do not depend on the other shards.
+  const uint32_t shard_seed = shuffle_seed_ + static_cast<uint32_t>(shard_id) + 1;
+  std::mt19937_64 rng(shard_seed);
+  std::vector<int32_t> shard;
+  shard.reserve(shard_capacity_);
+  int32_t handle = 0;
+  do {
+    RETURN_IF_NOT_OK(shard_in_queues_[shard_id]->PopFront(&handle));
+    if (handle >= 0) {
+      shard.push_back(handle);
+      if (shard.size() == static_cast<size_t>(shard_capacity_)) {
+        // The shard is full, send a random row and move the last handle into its place
+        size_t random_slot = rng() % shard.size();
+        std::swap(shard[random_slot], shard.back());
+        RETURN_IF_NOT_OK(shard_out_queues_[shard_id]->Add(shard.back()));
+        shard.pop_back();
+      }
+    } else {
+      RETURN_IF_NOT_OK(DrainShard(shard_id, &shard, &rng));
+      if (!reshuffle_each_epoch_) {
+        rng = std::mt19937_64(shard_seed);
+      }
+      RETURN_IF_NOT_OK(shard_out_queues_[shard_id]->Add(handle));
+    }
+  } while (handle != kShardEof);
+  return Status::OK();
+}
+
+Status ShuffleOp::DrainShard(int32_t shard_id, std::vector<int32_t> *shard, std::mt19937_64 *rng) {
+  while (!shard->empty()) {
+    size_t random_slot = (*rng)() % shard->size();
+    std::swap((*shard)[random_slot], shard->back());
+    RETURN_IF_NOT_OK(shard_out_queues_[shard_id]->Add(shard->back()));
+    shard->pop_back();
+  }
+  return Status::OK();
+}
+
+Status ShuffleOp::CollectorEntry() {
+  TaskManager::FindMe()->Post();
+  // The rows are taken from the shards in turn. A shard that has sent its eoe is skipped until all the shards have.
+  std::vector<bool> finished(num_shards_, false);
+  int32_t num_finished = 0;
+  int32_t shard_id = 0;
+  while (true) {
+    int32_t handle = 0;
+    RETURN_IF_NOT_OK(shard_out_queues_[shard_id]->PopFront(&handle));
+    if (handle >= 0) {
+      TensorRow row = std::move((*shuffle_buffer_)[handle]);
+      {
+        std::unique_lock<std::mutex> lock(free_handles_mutex_);
+        free_handles_.push_back(handle);
+      }
+      RETURN_IF_NOT_OK(out_connector_->Add(std::move(row)));
+    } else {
+      finished[shard_id] = true;
+      if (++num_finished == num_shards_) {
+        if (handle == kShardEof) {
+          break;
+        }
+        MS_LOG(DEBUG) << "Shuffle operator sending EOE.";
+        RETURN_IF_NOT_OK(out_connector_->SendEOE());
+        finished.assign(num_shards_, false);
+        num_finished = 0;
+        shard_id = 0;
+        continue;
+      }
+    }
+    do {
+      shard_id = (shard_id + 1) % num_shards_;
+    } while (finished[shard_id]);
+  }
+  return out_connector_->SendEOF();
+}
+
 Status ShuffleOp::EoeReceived(int32_t worker_id) {
   state_ = OpState::kDeOpIdle;
   return Status::OK();
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <random>
 #include <string>
@@ -28,6 +29,7 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/pipeline_op.h"
+#include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -45,13 +47,20 @@ class ShuffleOp : public PipelineOp {
   // Shuffle buffer is in a state of being drained
   static constexpr int32_t kShuffleStateDrain = 2;
 
+  // Markers passed through the shard queues in place of a row handle
+  static constexpr int32_t kShardEoe = -1;
+  static constexpr int32_t kShardEof = -2;
+
  public:
   // Constructor of the ShuffleOp
   // @note The builder class should be used to call it
   // @param shuffle_size - The size for the shuffle buffer
   // @param shuffle_seed - The seed to use for random number generation
   // @param op_connector_size - The output connector queue size
-  ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch);
+  // @param num_shards - The number of shards the shuffle buffer is split into, each shard is shuffled by its own
+  //     worker. 1 means the rows are shuffled by the op thread with a single buffer
+  ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
+            int32_t num_shards = 1);
 
   // Destructor
   ~ShuffleOp() = default;
@@ -102,6 +111,37 @@ class ShuffleOp : public PipelineOp {
   // @return Status The status code returned
   Status SelfReset();
 
+  // Private function to shuffle the rows with a single buffer on the op thread.
+  // @return Status The status code returned
+  Status ShuffleRows();
+
+  // Private function to shuffle the rows with the sharded buffer. The op thread reads the rows and dispatches their
+  // handles to the shard workers, one row per shard in a random order in each round. Each shard worker keeps its own
+  // buffer and random generator, and the collector takes the output rows from the shards in turn. So the order of the
+  // rows only depends on the seed, no matter how the threads are scheduled.
+  // @return Status The status code returned
+  Status ShuffleRowsSharded();
+
+  // Entry of a shard worker, see ShuffleRowsSharded
+  // @param shard_id - The id of the shard
+  // @return Status The status code returned
+  Status ShardEntry(int32_t shard_id);
+
+  // Entry of the collector thread sending the rows from the shards to the output connector
+  // @return Status The status code returned
+  Status CollectorEntry();
+
+  // Private function to send the handles left in the buffer of a shard in a random order
+  // @param shard_id - The id of the shard
+  // @param shard - The row handles in the buffer of the shard
+  // @param rng - The random generator of the shard
+  // @return Status The status code returned
+  Status DrainShard(int32_t shard_id, std::vector<int32_t> *shard, std::mt19937_64 *rng);
+
+  // Private function to send a marker to all the shards
+  // @return Status The status code returned
+  Status SendMarkerToShards(int32_t marker);
+
   int32_t shuffle_size_;  // User config for the size of the shuffle buffer (number of rows)
   uint32_t shuffle_seed_;
   bool reshuffle_each_epoch_;
@@ -111,12 +151,22 @@ class ShuffleOp : public PipelineOp {
   // (ie uniform_int_distribution) because we will need to create up to |dataset| instances
   // of the distribution object in the common case of a perfect shuffle
   std::mt19937_64 rng_;
-  // A single (potentially large) buffer of tensor rows for performing shuffling.
+  // A single (potentially large) buffer of tensor rows for performing shuffling. The rows stay where they are
+  // stored, only their handles (indexes into the buffer) are moved around when a random row is picked.
   std::unique_ptr<TensorTable> shuffle_buffer_;
+  std::vector<int32_t> shuffle_handles_;
   int32_t shuffle_last_row_idx_;  // Internal tracking of the last slot of our shuffle buffer
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
 
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
+
+  // Sharded mode
+  int32_t num_shards_;
+  int32_t shard_capacity_;                // Number of rows each shard buffers before sending any
+  std::vector<int32_t> free_handles_;     // Unused slots of shuffle_buffer_
+  std::mutex free_handles_mutex_;         // Guards free_handles_, taken by the op thread and the collector
+  QueueList<int32_t> shard_in_queues_;    // Handles sent from the op thread to the shard workers
+  QueueList<int32_t> shard_out_queues_;   // Handles sent from the shard workers to the collector
 };
 }  // namespace dataset
 }  // namespace mindspore
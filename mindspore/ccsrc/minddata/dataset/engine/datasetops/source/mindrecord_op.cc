@@ -297,6 +297,11 @@ Status MindRecordOp::PrepareData() {
 
 Status MindRecordOp::RegisterAndLaunchThreads() {
   RETURN_IF_NOT_OK(ParallelOp::RegisterAndLaunchThreads());
+  // read the blobs ahead in the order of the sampler, the workers take them from memory
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  const int64_t kBytesPerMB = 1024 * 1024;
+  shard_reader_->SetReadAhead(cfg->mindrecord_read_ahead_threads(),
+                              static_cast<int64_t>(cfg->mindrecord_read_ahead_size()) * kBytesPerMB);
   RETURN_IF_NOT_OK(shard_reader_->Launch(true));
   return Status::OK();
 }
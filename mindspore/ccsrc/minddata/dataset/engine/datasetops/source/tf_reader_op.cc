@@ -28,6 +28,7 @@
 #include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/engine/datasetops/source/tf_record_file.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 #include "minddata/dataset/util/status.h"
@@ -147,11 +148,31 @@ Status TFReaderOp::CalculateNumRowsPerShard() {
     return Status::OK();
   }
 
+  std::vector<std::string> files;
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    std::vector<std::string> file(1, it.value());
-    int64_t num = CountTotalRowsSectioned(file, 0, 1);
-    filename_numrows_[it.value()] = num;
-    num_rows_ += num;
+    files.push_back(it.value());
+  }
+  // Count the rows of the files in parallel, each file is indexed by one thread.
+  std::vector<int64_t> file_rows(files.size(), 0);
+  int64_t threads = std::min(static_cast<int64_t>(num_workers_), static_cast<int64_t>(files.size()));
+  try {
+    std::vector<std::future<void>> async_results;
+    for (int64_t t = 0; t < threads; ++t) {
+      async_results.push_back(std::async(std::launch::async, [&files, &file_rows, t, threads]() {
+        for (int64_t i = t; i < static_cast<int64_t>(files.size()); i += threads) {
+          file_rows[i] = CountTotalRowsSectioned(files, i, i + 1);
+        }
+      }));
+    }
+    for (auto &result : async_results) {
+      result.get();
+    }
+  } catch (const std::exception &e) {
+    RETURN_STATUS_UNEXPECTED("Unexpected error occurred: " + std::string(e.what()));
+  }
+  for (size_t i = 0; i < files.size(); ++i) {
+    filename_numrows_[files[i]] = file_rows[i];
+    num_rows_ += file_rows[i];
   }
   num_rows_per_shard_ = static_cast<int64_t>(std::ceil(num_rows_ * 1.0 / num_devices_));
   if (num_rows_per_shard_ == 0) {
@@ -271,53 +292,38 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
     RETURN_STATUS_UNEXPECTED("Invalid file path, " + filename + " does not exist.");
   }
 
-  std::ifstream reader;
-  reader.open(realpath.value());
-  if (!reader) {
-    RETURN_STATUS_UNEXPECTED("Invalid file, " + filename + " open failed: permission denied!");
-  }
+  TFRecordFile reader(realpath.value());
+  RETURN_IF_NOT_OK(reader.Open());
 
-  int64_t rows_read = 0;
-  int64_t rows_total = 0;
+  // Jump to the first row of the shard, only the record headers before it are visited if there is no index.
+  int64_t rows_total = start_offset == kInvalidOffset ? 0 : start_offset;
+  uint64_t offset = 0;
+  RETURN_IF_NOT_OK(reader.Seek(rows_total, &offset));
 
-  while (reader.peek() != EOF) {
+  int32_t num_columns = data_schema_->NumColumns();
+  while (offset < reader.FileSize() && (start_offset == kInvalidOffset || rows_total < end_offset)) {
     if (!load_jagged_connector_) {
       break;
     }
     RETURN_IF_INTERRUPTED();
 
-    // read length
-    int64_t record_length = 0;
-    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
+    // The serialized Example is parsed in place from the mapped file
+    const char *serialized_example = nullptr;
+    uint64_t record_length = 0;
+    RETURN_IF_NOT_OK(reader.ReadRecord(&offset, &serialized_example, &record_length));
 
-    // ignore crc header
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-    // read serialized Example
-    std::string serialized_example;
-    serialized_example.resize(record_length);
-    (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
-
-    int32_t num_columns = data_schema_->NumColumns();
-    TensorRow newRow(num_columns, nullptr);
-
-    if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
-        MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
-      }
-
-      std::vector<std::string> file_path(num_columns, filename);
-      newRow.setPath(file_path);
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &newRow));
-      rows_read++;
-      RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
+    dataengine::Example tf_file;
+    if (!tf_file.ParseFromArray(serialized_example, static_cast<int>(record_length))) {
+      std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
+      MS_LOG(DEBUG) << errMsg + ", details of string: " << std::string(serialized_example, record_length);
+      RETURN_STATUS_UNEXPECTED(errMsg);
     }
 
-    // ignore crc footer
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
+    TensorRow newRow(num_columns, nullptr);
+    std::vector<std::string> file_path(num_columns, filename);
+    newRow.setPath(file_path);
+    RETURN_IF_NOT_OK(LoadExample(&tf_file, &newRow));
+    RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
     rows_total++;
   }
 
@@ -697,28 +703,19 @@ int64_t TFReaderOp::CountTotalRowsSectioned(const std::vector<std::string> &file
       continue;
     }
 
-    std::ifstream reader;
-    reader.open(realpath.value());
-    if (!reader) {
-      MS_LOG(DEBUG) << "TFReader operator failed to open file " << filenames[i] << ".";
+    // The rows are counted from the sidecar index if it exists, otherwise only the record headers are visited.
+    TFRecordFile reader(realpath.value());
+    int64_t count = 0;
+    Status rc = reader.Open();
+    if (rc.IsOk()) {
+      rc = reader.CountRecords(&count);
     }
-
-    while (reader.peek() != EOF) {
-      // read length
-      int64_t record_length = 0;
-      (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
-
-      // ignore crc header
-      (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-      // ignore tf_file contents
-      (void)reader.ignore(static_cast<std::streamsize>(record_length));
-
-      // ignore crc footer
-      (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-      rows_read++;
+    if (rc.IsError()) {
+      MS_LOG(ERROR) << "TFReader operator failed to count rows of file " << filenames[i] << ", "
+                    << rc.GetErrDescription();
+      continue;
     }
+    rows_read += count;
   }
 
   return rows_read;
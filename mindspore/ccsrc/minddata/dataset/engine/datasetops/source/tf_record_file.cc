@@ -0,0 +1,235 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/tf_record_file.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/util/log_adapter.h"
+#include "./securec.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr uint64_t kRecordHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+constexpr uint64_t kRecordFooterSize = sizeof(uint32_t);
+
+struct TFRecordIndexHeader {
+  char magic[kTFRecordIndexMagicSize];
+  uint32_t version;
+  uint32_t endian_tag;
+  uint64_t file_size;
+  int64_t file_mtime;
+  uint64_t record_num;
+};
+}  // namespace
+
+TFRecordFile::TFRecordFile(const std::string &path)
+    : path_(path), file_size_(0), file_mtime_(0), data_(nullptr), has_index_(false) {}
+
+TFRecordFile::~TFRecordFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr) {
+    (void)munmap(const_cast<char *>(data_), file_size_);
+  }
+#endif
+  data_ = nullptr;
+}
+
+Status TFRecordFile::Open() {
+  struct stat file_stat {};
+  CHECK_FAIL_RETURN_UNEXPECTED(stat(common::SafeCStr(path_), &file_stat) == 0,
+                               "Invalid file, " + path_ + " open failed: permission denied!");
+  file_size_ = static_cast<uint64_t>(file_stat.st_size);
+  file_mtime_ = static_cast<int64_t>(file_stat.st_mtime);
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (file_size_ > 0) {
+    int fd = open(common::SafeCStr(path_), O_RDONLY);
+    CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Invalid file, " + path_ + " open failed: permission denied!");
+    void *addr = mmap(nullptr, file_size_, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr != MAP_FAILED) {
+      // The records are mostly read in order, let the kernel read ahead aggressively.
+      (void)madvise(addr, file_size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char *>(addr);
+    }
+  }
+#endif
+  if (data_ == nullptr) {
+    reader_.open(path_, std::ios::in | std::ios::binary);
+    CHECK_FAIL_RETURN_UNEXPECTED(reader_.is_open(), "Invalid file, " + path_ + " open failed: permission denied!");
+  }
+  LoadIndex();
+  return Status::OK();
+}
+
+Status TFRecordFile::ReadBytes(uint64_t offset, uint64_t size, const char **data) {
+  CHECK_FAIL_RETURN_UNEXPECTED(offset <= file_size_ && size <= file_size_ - offset,
+                               "Invalid data, tfrecord file: " + path_ + " is truncated at offset " +
+                                 std::to_string(offset) + ".");
+  if (data_ != nullptr) {
+    *data = data_ + offset;
+    return Status::OK();
+  }
+  buffer_.resize(size);
+  (void)reader_.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+  (void)reader_.read(&buffer_[0], static_cast<std::streamsize>(size));
+  CHECK_FAIL_RETURN_UNEXPECTED(reader_.good(), "Failed to read tfrecord file: " + path_ + " at offset " +
+                                                 std::to_string(offset) + ".");
+  *data = buffer_.data();
+  return Status::OK();
+}
+
+Status TFRecordFile::ReadLength(uint64_t offset, uint64_t *length) {
+  const char *header = nullptr;
+  RETURN_IF_NOT_OK(ReadBytes(offset, kRecordHeaderSize, &header));
+  CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(length, sizeof(uint64_t), header, sizeof(uint64_t)) == EOK,
+                               "Failed to read tfrecord file: " + path_);
+  uint64_t remain = file_size_ - offset - kRecordHeaderSize;
+  CHECK_FAIL_RETURN_UNEXPECTED(remain >= kRecordFooterSize && *length <= remain - kRecordFooterSize,
+                               "Invalid data, tfrecord file: " + path_ + " is truncated at offset " +
+                                 std::to_string(offset) + ".");
+  return Status::OK();
+}
+
+Status TFRecordFile::ReadRecord(uint64_t *offset, const char **data, uint64_t *length) {
+  RETURN_UNEXPECTED_IF_NULL(offset);
+  RETURN_UNEXPECTED_IF_NULL(data);
+  RETURN_UNEXPECTED_IF_NULL(length);
+  RETURN_IF_NOT_OK(ReadLength(*offset, length));
+  RETURN_IF_NOT_OK(ReadBytes(*offset + kRecordHeaderSize, *length, data));
+  *offset += kRecordHeaderSize + *length + kRecordFooterSize;
+  return Status::OK();
+}
+
+Status TFRecordFile::BuildIndex() {
+  std::vector<uint64_t> offsets;
+  uint64_t offset = 0;
+  while (offset < file_size_) {
+    uint64_t length = 0;
+    RETURN_IF_NOT_OK(ReadLength(offset, &length));
+    offsets.push_back(offset);
+    offset += kRecordHeaderSize + length + kRecordFooterSize;
+  }
+  offsets_ = std::move(offsets);
+  has_index_ = true;
+  return Status::OK();
+}
+
+Status TFRecordFile::CountRecords(int64_t *count) {
+  RETURN_UNEXPECTED_IF_NULL(count);
+  if (!has_index_) {
+    RETURN_IF_NOT_OK(BuildIndex());
+    if (GlobalContext::config_manager()->enable_tfrecord_index()) {
+      SaveIndex();
+    }
+  }
+  *count = static_cast<int64_t>(offsets_.size());
+  return Status::OK();
+}
+
+Status TFRecordFile::Seek(int64_t row, uint64_t *offset) {
+  RETURN_UNEXPECTED_IF_NULL(offset);
+  CHECK_FAIL_RETURN_UNEXPECTED(row >= 0, "Invalid row of tfrecord file, got: " + std::to_string(row));
+  if (has_index_) {
+    *offset = static_cast<size_t>(row) < offsets_.size() ? offsets_[row] : file_size_;
+    return Status::OK();
+  }
+  // Without an index only the record headers before the row are visited.
+  uint64_t pos = 0;
+  for (int64_t i = 0; i < row && pos < file_size_; ++i) {
+    uint64_t length = 0;
+    RETURN_IF_NOT_OK(ReadLength(pos, &length));
+    pos += kRecordHeaderSize + length + kRecordFooterSize;
+  }
+  *offset = pos;
+  return Status::OK();
+}
+
+void TFRecordFile::LoadIndex() {
+  std::ifstream index_file(IndexPath(path_), std::ios::in | std::ios::binary);
+  if (!index_file.is_open()) {
+    return;
+  }
+  TFRecordIndexHeader header{};
+  (void)index_file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!index_file.good() || memcmp(header.magic, kTFRecordIndexMagic, kTFRecordIndexMagicSize) != 0 ||
+      header.version != kTFRecordIndexVersion || header.endian_tag != kTFRecordIndexEndianTag) {
+    MS_LOG(WARNING) << "Invalid index file of tfrecord file: " << path_ << ", the index is ignored.";
+    return;
+  }
+  if (header.file_size != file_size_ || header.file_mtime != file_mtime_) {
+    MS_LOG(INFO) << "The index file of tfrecord file: " << path_ << " is out of date, the index is ignored.";
+    return;
+  }
+  // Each record takes at least the header and footer, an index with more records than that is broken.
+  if (header.record_num > file_size_ / (kRecordHeaderSize + kRecordFooterSize)) {
+    MS_LOG(WARNING) << "Invalid index file of tfrecord file: " << path_ << ", the index is ignored.";
+    return;
+  }
+  std::vector<uint64_t> offsets(header.record_num);
+  (void)index_file.read(reinterpret_cast<char *>(offsets.data()),
+                        static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+  if (!index_file.good()) {
+    MS_LOG(WARNING) << "Failed to read index file of tfrecord file: " << path_ << ", the index is ignored.";
+    return;
+  }
+  offsets_ = std::move(offsets);
+  has_index_ = true;
+}
+
+void TFRecordFile::SaveIndex() {
+  std::string index_path = IndexPath(path_);
+  std::string tmp_path = index_path + ".tmp" + std::to_string(getpid());
+  TFRecordIndexHeader header{};
+  if (memcpy_s(header.magic, kTFRecordIndexMagicSize, kTFRecordIndexMagic, kTFRecordIndexMagicSize) != EOK) {
+    MS_LOG(WARNING) << "Failed to save index file of tfrecord file: " << path_;
+    return;
+  }
+  header.version = kTFRecordIndexVersion;
+  header.endian_tag = kTFRecordIndexEndianTag;
+  header.file_size = file_size_;
+  header.file_mtime = file_mtime_;
+  header.record_num = offsets_.size();
+  std::ofstream index_file(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!index_file.is_open()) {
+    MS_LOG(WARNING) << "Failed to create index file: " << tmp_path << ", the directory may be read only.";
+    return;
+  }
+  (void)index_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  (void)index_file.write(reinterpret_cast<const char *>(offsets_.data()),
+                         static_cast<std::streamsize>(offsets_.size() * sizeof(uint64_t)));
+  index_file.close();
+  // Several processes may index the same file, the rename makes sure only a complete index is visible.
+  if (index_file.fail() || std::rename(tmp_path.c_str(), index_path.c_str()) != 0) {
+    MS_LOG(WARNING) << "Failed to save index file of tfrecord file: " << path_;
+    (void)std::remove(tmp_path.c_str());
+    return;
+  }
+  MS_LOG(INFO) << "Index of tfrecord file: " << path_ << " is saved to " << index_path;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_FILE_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// The sidecar index file layout, it is saved as "<tfrecord file>.msindex":
+//   header  | magic "MSTFRIDX" | uint32 version | uint32 endian tag | uint64 file size | int64 file mtime |
+//             uint64 record number |
+//   offsets | uint64 offset of each record
+// The index is ignored if the size or the modification time of the tfrecord file is changed.
+constexpr char kTFRecordIndexSuffix[] = ".msindex";
+constexpr char kTFRecordIndexMagic[] = "MSTFRIDX";
+constexpr size_t kTFRecordIndexMagicSize = 8;
+constexpr uint32_t kTFRecordIndexVersion = 1;
+constexpr uint32_t kTFRecordIndexEndianTag = 0x01020304;
+
+// Read the records of a tfrecord file. Each record is stored as:
+//   uint64 length | uint32 masked crc of length | data | uint32 masked crc of data
+// The file is mapped into memory if possible, so the serialized Example is parsed in place without being copied.
+// Otherwise the records are read by seeking in the file.
+class TFRecordFile {
+ public:
+  explicit TFRecordFile(const std::string &path);
+
+  ~TFRecordFile();
+
+  // Open the file and load the sidecar index if it is valid
+  // @return Status The status code returned
+  Status Open();
+
+  // @return uint64_t - size of the file in bytes
+  uint64_t FileSize() const { return file_size_; }
+
+  // @return bool - whether the offsets of all the records are known
+  bool HasIndex() const { return has_index_; }
+
+  // Get the number of records. The record headers are scanned if there is no index, and the index is saved to the
+  // sidecar file if it is enabled by ConfigManager::enable_tfrecord_index
+  // @param int64_t *count - returned number of records
+  // @return Status The status code returned
+  Status CountRecords(int64_t *count);
+
+  // Get the offset of a record, the offset of the end of file is returned if row equals the number of records
+  // @param int64_t row - index of the record
+  // @param uint64_t *offset - returned offset of the record
+  // @return Status The status code returned
+  Status Seek(int64_t row, uint64_t *offset);
+
+  // Read the record at the offset, the data stays valid until the next read
+  // @param uint64_t *offset - offset of the record, moved to the next record
+  // @param const char **data - returned serialized data of the record
+  // @param uint64_t *length - returned length of the data
+  // @return Status The status code returned
+  Status ReadRecord(uint64_t *offset, const char **data, uint64_t *length);
+
+  // @param std::string &path - path of the tfrecord file
+  // @return std::string - path of the sidecar index file
+  static std::string IndexPath(const std::string &path) { return path + kTFRecordIndexSuffix; }
+
+ private:
+  // Get the bytes of the file in [offset, offset + size)
+  Status ReadBytes(uint64_t offset, uint64_t size, const char **data);
+
+  // Get the length of the record at the offset from its header
+  Status ReadLength(uint64_t offset, uint64_t *length);
+
+  // Scan the record headers to collect the offsets of all the records
+  Status BuildIndex();
+
+  // Load the sidecar index, nothing is loaded if it does not exist or is out of date
+  void LoadIndex();
+
+  // Save the sidecar index, a failure only logs a warning as the index is an optimization
+  void SaveIndex();
+
+  std::string path_;
+  uint64_t file_size_;
+  int64_t file_mtime_;
+  const char *data_;
+  // Only used if the file can not be mapped
+  std::ifstream reader_;
+  std::string buffer_;
+  bool has_index_;
+  std::vector<uint64_t> offsets_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_FILE_H_
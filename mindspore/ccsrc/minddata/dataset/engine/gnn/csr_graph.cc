@@ -0,0 +1,641 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/csr_graph.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <utility>
+
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+namespace {
+// Reorder the values by the order, the i-th value of the result is the order[i]-th value of the input.
+template <typename T>
+void Reorder(const std::vector<int32_t> &order, std::vector<T> *values) {
+  std::vector<T> sorted(values->size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    sorted[i] = (*values)[order[i]];
+  }
+  *values = std::move(sorted);
+}
+
+template <typename T>
+Status SaveArray(const std::string &name, const CsrArray<T> &array, GraphSnapshotWriter *writer) {
+  return writer->Write(name, array.data(), array.size());
+}
+
+template <typename T>
+Status LoadArray(const std::string &name, const GraphSnapshotReader &reader, CsrArray<T> *array) {
+  const T *data = nullptr;
+  size_t size = 0;
+  RETURN_IF_NOT_OK(reader.Get(name, &data, &size));
+  array->Map(data, size);
+  return Status::OK();
+}
+
+constexpr size_t kFeatureMetaSize = 2;
+
+// Check that the indexes loaded from a snapshot are in [0, size), or -1 if allow_missing is true, they are used
+// without bound checks later.
+template <typename T>
+bool IndexesInRange(const CsrArray<T> &indexes, size_t size, bool allow_missing = false) {
+  return std::all_of(indexes.begin(), indexes.end(), [size, allow_missing](T index) {
+    return index >= 0 ? static_cast<size_t>(index) < size : (allow_missing && index == -1);
+  });
+}
+
+// Return the stable order of the ids, so that the first one of the duplicated ids is found by binary search.
+template <typename T>
+std::vector<int32_t> SortedOrder(const std::vector<T> &ids) {
+  std::vector<int32_t> order(ids.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&ids](int32_t a, int32_t b) { return ids[a] < ids[b]; });
+  return order;
+}
+
+template <typename T>
+int64_t SortedIndex(const CsrArray<T> &ids, T id) {
+  auto itr = std::lower_bound(ids.begin(), ids.end(), id);
+  if (itr == ids.end() || *itr != id) {
+    return -1;
+  }
+  return itr - ids.begin();
+}
+}  // namespace
+
+Status CsrGraph::AddNode(NodeIdType id, NodeType type, const std::vector<std::shared_ptr<Feature>> &features) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!built_, "Can not add node after the CSR graph is built.");
+  CHECK_FAIL_RETURN_UNEXPECTED(node_ids_.size() < static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                               "The number of nodes exceeds the limit of the CSR graph.");
+  RETURN_IF_NOT_OK(AppendFeatures(features, node_ids_.size(), &node_features_));
+  node_ids_.Owned().push_back(id);
+  node_types_.Owned().push_back(type);
+  return Status::OK();
+}
+
+Status CsrGraph::AddEdge(EdgeIdType id, EdgeType type, WeightType weight, NodeIdType src_id, NodeIdType dst_id,
+                         const std::vector<std::shared_ptr<Feature>> &features) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!built_, "Can not add edge after the CSR graph is built.");
+  CHECK_FAIL_RETURN_UNEXPECTED(edge_ids_.size() < static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                               "The number of edges exceeds the limit of the CSR graph.");
+  RETURN_IF_NOT_OK(AppendFeatures(features, edge_ids_.size(), &edge_features_));
+  edge_ids_.Owned().push_back(id);
+  edge_types_.Owned().push_back(type);
+  edge_weights_.push_back(weight);
+  edge_src_ids_.push_back(src_id);
+  edge_dst_ids_.push_back(dst_id);
+  return Status::OK();
+}
+
+Status CsrGraph::AppendFeatures(const std::vector<std::shared_ptr<Feature>> &features, size_t index,
+                                FeatureColumns *columns) {
+  for (const auto &feature : features) {
+    RETURN_UNEXPECTED_IF_NULL(feature);
+    const std::shared_ptr<Tensor> &value = feature->Value();
+    RETURN_UNEXPECTED_IF_NULL(value);
+    CHECK_FAIL_RETURN_UNEXPECTED(value->type().IsNumeric(),
+                                 "CSR graph only supports numeric feature, feature type:" +
+                                   std::to_string(feature->type()));
+    auto row_bytes = static_cast<size_t>(value->SizeInBytes());
+    FeatureColumn &column = (*columns)[feature->type()];
+    if (column.row_bytes == 0) {
+      column.type = value->type();
+      column.row_bytes = row_bytes;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(column.type == value->type() && column.row_bytes == row_bytes,
+                                 "The feature of the same type should have the same shape and data type in CSR graph, "
+                                 "feature type:" +
+                                   std::to_string(feature->type()));
+    std::vector<int32_t> &rows = column.rows.Owned();
+    std::vector<uint8_t> &values = column.values.Owned();
+    if (rows.size() <= index) {
+      rows.resize(index + 1, -1);
+    }
+    rows[index] = row_bytes == 0 ? 0 : static_cast<int32_t>(values.size() / row_bytes);
+    values.insert(values.end(), value->GetBuffer(), value->GetBuffer() + row_bytes);
+  }
+  return Status::OK();
+}
+
+void CsrGraph::SortFeatureRows(const std::vector<int32_t> &order, FeatureColumns *columns) {
+  for (auto &itr : *columns) {
+    itr.second.rows.Owned().resize(order.size(), -1);
+    Reorder(order, &itr.second.rows.Owned());
+    itr.second.values.Owned().shrink_to_fit();
+  }
+}
+
+Status CsrGraph::Build() {
+  CHECK_FAIL_RETURN_UNEXPECTED(!built_, "The CSR graph is already built.");
+  // Sort the nodes by id, so the node is found by binary search and the neighbors are referenced by index.
+  std::vector<int32_t> node_order = SortedOrder(node_ids_.Owned());
+  Reorder(node_order, &node_ids_.Owned());
+  Reorder(node_order, &node_types_.Owned());
+  SortFeatureRows(node_order, &node_features_);
+
+  size_t num_edges = edge_ids_.size();
+  std::vector<int32_t> &edge_src = edge_src_.Owned();
+  std::vector<int32_t> &edge_dst = edge_dst_.Owned();
+  edge_src.resize(num_edges);
+  edge_dst.resize(num_edges);
+  for (size_t i = 0; i < num_edges; ++i) {
+    int64_t src = NodeIndex(edge_src_ids_[i]);
+    int64_t dst = NodeIndex(edge_dst_ids_[i]);
+    CHECK_FAIL_RETURN_UNEXPECTED(src >= 0, "invalid src_id.");
+    CHECK_FAIL_RETURN_UNEXPECTED(dst >= 0, "invalid dst_id.");
+    edge_src[i] = static_cast<int32_t>(src);
+    edge_dst[i] = static_cast<int32_t>(dst);
+  }
+  std::vector<NodeIdType>().swap(edge_src_ids_);
+  std::vector<NodeIdType>().swap(edge_dst_ids_);
+
+  // Count the out edges of each node per neighbor type, then fill the edges in the order they are added, which is
+  // the same order as the neighbors of LocalNode.
+  size_t num_nodes = node_ids_.size();
+  for (size_t i = 0; i < num_edges; ++i) {
+    std::vector<int64_t> &offsets = adjacency_[node_types_[edge_dst[i]]].offsets.Owned();
+    if (offsets.empty()) {
+      offsets.resize(num_nodes + 1, 0);
+    }
+    ++offsets[edge_src[i] + 1];
+  }
+  for (auto &itr : adjacency_) {
+    std::vector<int64_t> &offsets = itr.second.offsets.Owned();
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    itr.second.neighbors.Owned().resize(offsets.back());
+    itr.second.edges.Owned().resize(offsets.back());
+  }
+  std::unordered_map<NodeType, std::vector<int64_t>> cursors;
+  std::unordered_map<NodeType, std::vector<WeightType>> weights;
+  for (auto &itr : adjacency_) {
+    cursors[itr.first].assign(itr.second.offsets.begin(), itr.second.offsets.end() - 1);
+    weights[itr.first].resize(itr.second.neighbors.size());
+  }
+  for (size_t i = 0; i < num_edges; ++i) {
+    NodeType type = node_types_[edge_dst[i]];
+    Adjacency &adjacency = adjacency_[type];
+    int64_t slot = cursors[type][edge_src[i]]++;
+    adjacency.neighbors.Owned()[slot] = edge_dst[i];
+    adjacency.edges.Owned()[slot] = static_cast<int32_t>(i);
+    weights[type][slot] = edge_weights_[i];
+  }
+  cursors.clear();
+  std::vector<WeightType>().swap(edge_weights_);
+  for (auto &itr : adjacency_) {
+    BuildAliasTable(weights[itr.first], &itr.second);
+    weights.erase(itr.first);
+  }
+
+  // Sort the edges by id and update the edge index in the adjacency arrays.
+  std::vector<int32_t> edge_order = SortedOrder(edge_ids_.Owned());
+  std::vector<int32_t> edge_position(num_edges);
+  for (size_t i = 0; i < num_edges; ++i) {
+    edge_position[edge_order[i]] = static_cast<int32_t>(i);
+  }
+  for (auto &itr : adjacency_) {
+    for (auto &edge : itr.second.edges.Owned()) {
+      edge = edge_position[edge];
+    }
+  }
+  Reorder(edge_order, &edge_ids_.Owned());
+  Reorder(edge_order, &edge_types_.Owned());
+  Reorder(edge_order, &edge_src);
+  Reorder(edge_order, &edge_dst);
+  SortFeatureRows(edge_order, &edge_features_);
+  built_ = true;
+  MS_LOG(INFO) << "CSR graph is built, node num:" << num_nodes << ", edge num:" << num_edges
+               << ", memory usage:" << MemoryUsage() << " bytes.";
+  return Status::OK();
+}
+
+void CsrGraph::BuildAliasTable(const std::vector<WeightType> &weights, Adjacency *adjacency) {
+  std::vector<float> &alias_prob = adjacency->alias_prob.Owned();
+  std::vector<int32_t> &alias_slot = adjacency->alias_slot.Owned();
+  alias_prob.assign(weights.size(), 1.0);
+  alias_slot.resize(weights.size());
+  std::vector<double> scaled;
+  std::vector<int32_t> smaller;
+  std::vector<int32_t> larger;
+  for (size_t i = 0; i + 1 < adjacency->offsets.size(); ++i) {
+    int64_t begin = adjacency->offsets[i];
+    int64_t degree = adjacency->offsets[i + 1] - begin;
+    for (int64_t k = 0; k < degree; ++k) {
+      alias_slot[begin + k] = static_cast<int32_t>(k);
+    }
+    double sum = std::accumulate(weights.begin() + begin, weights.begin() + begin + degree, 0.0);
+    // A row without positive weight is sampled uniformly, which keeps every slot.
+    if (degree <= 1 || sum <= 0) {
+      continue;
+    }
+    scaled.resize(degree);
+    smaller.clear();
+    larger.clear();
+    for (int64_t k = 0; k < degree; ++k) {
+      scaled[k] = std::max(static_cast<double>(weights[begin + k]), 0.0) * degree / sum;
+      scaled[k] < 1.0 ? smaller.push_back(static_cast<int32_t>(k)) : larger.push_back(static_cast<int32_t>(k));
+    }
+    while (!smaller.empty() && !larger.empty()) {
+      int32_t small = smaller.back();
+      smaller.pop_back();
+      int32_t large = larger.back();
+      alias_prob[begin + small] = static_cast<float>(scaled[small]);
+      alias_slot[begin + small] = large;
+      scaled[large] = scaled[large] + scaled[small] - 1.0;
+      if (scaled[large] < 1.0) {
+        larger.pop_back();
+        smaller.push_back(large);
+      }
+    }
+  }
+}
+
+int64_t CsrGraph::NodeIndex(NodeIdType id) const { return SortedIndex(node_ids_, id); }
+
+int64_t CsrGraph::EdgeIndex(EdgeIdType id) const { return built_ ? SortedIndex(edge_ids_, id) : -1; }
+
+Status CsrGraph::GetAllNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
+                                 bool exclude_itself) const {
+  RETURN_UNEXPECTED_IF_NULL(out_neighbors);
+  int64_t index = NodeIndex(id);
+  CHECK_FAIL_RETURN_UNEXPECTED(index >= 0, "Invalid node id:" + std::to_string(id));
+  out_neighbors->clear();
+  if (!exclude_itself) {
+    out_neighbors->push_back(id);
+  }
+  auto itr = adjacency_.find(neighbor_type);
+  if (itr == adjacency_.end()) {
+    return Status::OK();
+  }
+  const Adjacency &adjacency = itr->second;
+  int64_t begin = adjacency.offsets[index];
+  int64_t end = adjacency.offsets[index + 1];
+  out_neighbors->reserve(out_neighbors->size() + (end - begin));
+  for (int64_t slot = begin; slot < end; ++slot) {
+    out_neighbors->push_back(node_ids_[adjacency.neighbors[slot]]);
+  }
+  return Status::OK();
+}
+
+Status CsrGraph::GetSampledNeighbors(NodeIdType id, NodeType neighbor_type, int32_t samples_num,
+                                     SamplingStrategy strategy, std::mt19937 *rnd,
+                                     std::vector<NodeIdType> *out_neighbors) const {
+  RETURN_UNEXPECTED_IF_NULL(rnd);
+  RETURN_UNEXPECTED_IF_NULL(out_neighbors);
+  int64_t index = NodeIndex(id);
+  CHECK_FAIL_RETURN_UNEXPECTED(index >= 0, "Invalid node id:" + std::to_string(id));
+  size_t begin = out_neighbors->size();
+  out_neighbors->resize(begin + static_cast<size_t>(samples_num));
+  std::vector<int32_t> slots;
+  return SampleNeighbors(index, neighbor_type, samples_num, strategy, rnd, &slots, out_neighbors->data() + begin);
+}
+
+Status CsrGraph::GetMultiHopSampledNeighbors(NodeIdType id, const std::vector<NodeIdType> &neighbor_nums,
+                                             const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
+                                             std::mt19937 *rnd, NodeIdType *out) const {
+  RETURN_UNEXPECTED_IF_NULL(rnd);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(neighbor_nums.size() == neighbor_types.size(),
+                               "The sizes of neighbor_nums and neighbor_types are inconsistent.");
+  CHECK_FAIL_RETURN_UNEXPECTED(HasNode(id), "Invalid node id:" + std::to_string(id));
+  out[0] = id;
+  // The input nodes of each hop are the output of the previous hop, which are just before the output of this hop.
+  const NodeIdType *input = out;
+  size_t input_num = 1;
+  NodeIdType *output = out + 1;
+  std::vector<int32_t> slots;
+  for (size_t i = 0; i < neighbor_nums.size(); ++i) {
+    for (size_t k = 0; k < input_num; ++k) {
+      NodeIdType *neighbors = output + k * neighbor_nums[i];
+      if (input[k] == kDefaultNodeId) {
+        std::fill(neighbors, neighbors + neighbor_nums[i], kDefaultNodeId);
+        continue;
+      }
+      RETURN_IF_NOT_OK(
+        SampleNeighbors(NodeIndex(input[k]), neighbor_types[i], neighbor_nums[i], strategy, rnd, &slots, neighbors));
+    }
+    input = output;
+    input_num *= static_cast<size_t>(neighbor_nums[i]);
+    output += input_num;
+  }
+  return Status::OK();
+}
+
+Status CsrGraph::SampleNeighbors(int64_t index, NodeType neighbor_type, int32_t samples_num,
+                                 SamplingStrategy strategy, std::mt19937 *rnd, std::vector<int32_t> *slots,
+                                 NodeIdType *out) const {
+  auto itr = adjacency_.find(neighbor_type);
+  int64_t begin = 0;
+  int64_t degree = 0;
+  if (itr != adjacency_.end()) {
+    begin = itr->second.offsets[index];
+    degree = itr->second.offsets[index + 1] - begin;
+  }
+  if (degree == 0) {
+    MS_LOG(DEBUG) << "There are no neighbors. node_id:" << node_ids_[index] << " neighbor_type:" << neighbor_type;
+    // If there are no neighbors, they are filled with kDefaultNodeId
+    std::fill(out, out + samples_num, kDefaultNodeId);
+    return Status::OK();
+  }
+  const Adjacency &adjacency = itr->second;
+  if (strategy == SamplingStrategy::kRandom) {
+    // Sample without replacement by partial Fisher-Yates shuffle, and start another round if the neighbors are not
+    // enough, the same as LocalNode.
+    slots->resize(degree);
+    std::iota(slots->begin(), slots->end(), 0);
+    int32_t sampled = 0;
+    while (sampled < samples_num) {
+      int64_t num = std::min(static_cast<int64_t>(samples_num - sampled), degree);
+      for (int64_t k = 0; k < num; ++k) {
+        std::uniform_int_distribution<int64_t> dist(k, degree - 1);
+        std::swap((*slots)[k], (*slots)[dist(*rnd)]);
+        out[sampled + k] = node_ids_[adjacency.neighbors[begin + (*slots)[k]]];
+      }
+      sampled += static_cast<int32_t>(num);
+    }
+  } else if (strategy == SamplingStrategy::kEdgeWeight) {
+    std::uniform_int_distribution<int64_t> slot_dist(0, degree - 1);
+    std::uniform_real_distribution<float> prob_dist(0.0, 1.0);
+    for (int32_t i = 0; i < samples_num; ++i) {
+      int64_t slot = begin + slot_dist(*rnd);
+      if (prob_dist(*rnd) >= adjacency.alias_prob[slot]) {
+        slot = begin + adjacency.alias_slot[slot];
+      }
+      out[i] = node_ids_[adjacency.neighbors[slot]];
+    }
+  } else {
+    RETURN_STATUS_UNEXPECTED("Invalid strategy");
+  }
+  return Status::OK();
+}
+
+Status CsrGraph::GetEdgeByAdjNodeId(NodeIdType src_id, NodeIdType dst_id, EdgeIdType *out_edge_id) const {
+  RETURN_UNEXPECTED_IF_NULL(out_edge_id);
+  int64_t src = NodeIndex(src_id);
+  CHECK_FAIL_RETURN_UNEXPECTED(src >= 0, "Invalid node id:" + std::to_string(src_id));
+  *out_edge_id = -1;
+  int64_t dst = NodeIndex(dst_id);
+  if (dst >= 0) {
+    auto itr = adjacency_.find(node_types_[dst]);
+    if (itr != adjacency_.end()) {
+      const Adjacency &adjacency = itr->second;
+      for (int64_t slot = adjacency.offsets[src]; slot < adjacency.offsets[src + 1]; ++slot) {
+        if (adjacency.neighbors[slot] == dst) {
+          *out_edge_id = edge_ids_[adjacency.edges[slot]];
+          return Status::OK();
+        }
+      }
+    }
+  }
+  MS_LOG(WARNING) << "Number " << dst_id << " node is not adjacent to number " << src_id << " node.";
+  return Status::OK();
+}
+
+Status CsrGraph::GetEdgeNodes(EdgeIdType id, NodeIdType *src_id, NodeIdType *dst_id) const {
+  RETURN_UNEXPECTED_IF_NULL(src_id);
+  RETURN_UNEXPECTED_IF_NULL(dst_id);
+  int64_t index = EdgeIndex(id);
+  CHECK_FAIL_RETURN_UNEXPECTED(index >= 0, "Invalid edge id:" + std::to_string(id));
+  *src_id = node_ids_[edge_src_[index]];
+  *dst_id = node_ids_[edge_dst_[index]];
+  return Status::OK();
+}
+
+const uint8_t *CsrGraph::GetFeature(const FeatureColumns &columns, int64_t index, FeatureType feature_type,
+                                    size_t *size) {
+  if (index < 0) {
+    return nullptr;
+  }
+  auto itr = columns.find(feature_type);
+  if (itr == columns.end() || itr->second.rows[index] < 0) {
+    return nullptr;
+  }
+  const FeatureColumn &column = itr->second;
+  if (size != nullptr) {
+    *size = column.row_bytes;
+  }
+  return column.values.data() + static_cast<size_t>(column.rows[index]) * column.row_bytes;
+}
+
+size_t CsrGraph::MemoryUsage() const {
+  size_t bytes = node_ids_.OwnedBytes() + node_types_.OwnedBytes() + edge_ids_.OwnedBytes() +
+                 edge_types_.OwnedBytes() + edge_src_.OwnedBytes() + edge_dst_.OwnedBytes();
+  for (const auto &itr : adjacency_) {
+    const Adjacency &adjacency = itr.second;
+    bytes += adjacency.offsets.OwnedBytes() + adjacency.neighbors.OwnedBytes() + adjacency.edges.OwnedBytes() +
+             adjacency.alias_prob.OwnedBytes() + adjacency.alias_slot.OwnedBytes();
+  }
+  for (const auto *columns : {&node_features_, &edge_features_}) {
+    for (const auto &itr : *columns) {
+      bytes += itr.second.values.OwnedBytes() + itr.second.rows.OwnedBytes();
+    }
+  }
+  return bytes;
+}
+
+int64_t CsrGraph::FeatureBytes() const {
+  int64_t bytes = 0;
+  for (const auto *columns : {&node_features_, &edge_features_}) {
+    for (const auto &itr : *columns) {
+      bytes += static_cast<int64_t>(itr.second.values.size());
+    }
+  }
+  return bytes;
+}
+
+Status CsrGraph::Save(GraphSnapshotWriter *writer) const {
+  RETURN_UNEXPECTED_IF_NULL(writer);
+  CHECK_FAIL_RETURN_UNEXPECTED(built_, "The CSR graph is not built.");
+  RETURN_IF_NOT_OK(SaveArray("csr/node_ids", node_ids_, writer));
+  RETURN_IF_NOT_OK(SaveArray("csr/node_types", node_types_, writer));
+  RETURN_IF_NOT_OK(SaveArray("csr/edge_ids", edge_ids_, writer));
+  RETURN_IF_NOT_OK(SaveArray("csr/edge_types", edge_types_, writer));
+  RETURN_IF_NOT_OK(SaveArray("csr/edge_src", edge_src_, writer));
+  RETURN_IF_NOT_OK(SaveArray("csr/edge_dst", edge_dst_, writer));
+  std::vector<NodeType> neighbor_types;
+  for (const auto &itr : adjacency_) {
+    neighbor_types.push_back(itr.first);
+    const std::string prefix = "csr/adjacency/" + std::to_string(itr.first) + "/";
+    const Adjacency &adjacency = itr.second;
+    RETURN_IF_NOT_OK(SaveArray(prefix + "offsets", adjacency.offsets, writer));
+    RETURN_IF_NOT_OK(SaveArray(prefix + "neighbors", adjacency.neighbors, writer));
+    RETURN_IF_NOT_OK(SaveArray(prefix + "edges", adjacency.edges, writer));
+    RETURN_IF_NOT_OK(SaveArray(prefix + "alias_prob", adjacency.alias_prob, writer));
+    RETURN_IF_NOT_OK(SaveArray(prefix + "alias_slot", adjacency.alias_slot, writer));
+  }
+  RETURN_IF_NOT_OK(writer->Write("csr/adjacency_types", neighbor_types));
+  RETURN_IF_NOT_OK(SaveFeatures("csr/node_feature", node_features_, writer));
+  RETURN_IF_NOT_OK(SaveFeatures("csr/edge_feature", edge_features_, writer));
+  return Status::OK();
+}
+
+Status CsrGraph::SaveFeatures(const std::string &prefix, const FeatureColumns &columns,
+                              GraphSnapshotWriter *writer) {
+  std::vector<FeatureType> feature_types;
+  for (const auto &itr : columns) {
+    feature_types.push_back(itr.first);
+    const std::string name = prefix + "/" + std::to_string(itr.first) + "/";
+    std::vector<uint64_t> meta = {static_cast<uint64_t>(itr.second.type.value()),
+                                  static_cast<uint64_t>(itr.second.row_bytes)};
+    RETURN_IF_NOT_OK(writer->Write(name + "meta", meta));
+    RETURN_IF_NOT_OK(SaveArray(name + "values", itr.second.values, writer));
+    RETURN_IF_NOT_OK(SaveArray(name + "rows", itr.second.rows, writer));
+  }
+  return writer->Write(prefix + "_types", feature_types);
+}
+
+Status CsrGraph::Load(const std::shared_ptr<GraphSnapshotReader> &reader) {
+  RETURN_UNEXPECTED_IF_NULL(reader);
+  CHECK_FAIL_RETURN_UNEXPECTED(!built_ && node_ids_.empty() && edge_ids_.empty(),
+                               "Can not load the graph snapshot into a non-empty CSR graph.");
+  RETURN_IF_NOT_OK(LoadArray("csr/node_ids", *reader, &node_ids_));
+  RETURN_IF_NOT_OK(LoadArray("csr/node_types", *reader, &node_types_));
+  RETURN_IF_NOT_OK(LoadArray("csr/edge_ids", *reader, &edge_ids_));
+  RETURN_IF_NOT_OK(LoadArray("csr/edge_types", *reader, &edge_types_));
+  RETURN_IF_NOT_OK(LoadArray("csr/edge_src", *reader, &edge_src_));
+  RETURN_IF_NOT_OK(LoadArray("csr/edge_dst", *reader, &edge_dst_));
+  size_t num_nodes = node_ids_.size();
+  size_t num_edges = edge_ids_.size();
+  CHECK_FAIL_RETURN_UNEXPECTED(node_types_.size() == num_nodes && edge_types_.size() == num_edges &&
+                                 edge_src_.size() == num_edges && edge_dst_.size() == num_edges,
+                               "The size of the node or edge arrays in graph snapshot is inconsistent.");
+  CHECK_FAIL_RETURN_UNEXPECTED(IndexesInRange(edge_src_, num_nodes) && IndexesInRange(edge_dst_, num_nodes),
+                               "Invalid node index of the edges in graph snapshot.");
+
+  std::vector<NodeType> neighbor_types;
+  RETURN_IF_NOT_OK(reader->Get("csr/adjacency_types", &neighbor_types));
+  for (NodeType neighbor_type : neighbor_types) {
+    const std::string prefix = "csr/adjacency/" + std::to_string(neighbor_type) + "/";
+    Adjacency &adjacency = adjacency_[neighbor_type];
+    RETURN_IF_NOT_OK(LoadArray(prefix + "offsets", *reader, &adjacency.offsets));
+    RETURN_IF_NOT_OK(LoadArray(prefix + "neighbors", *reader, &adjacency.neighbors));
+    RETURN_IF_NOT_OK(LoadArray(prefix + "edges", *reader, &adjacency.edges));
+    RETURN_IF_NOT_OK(LoadArray(prefix + "alias_prob", *reader, &adjacency.alias_prob));
+    RETURN_IF_NOT_OK(LoadArray(prefix + "alias_slot", *reader, &adjacency.alias_slot));
+    RETURN_IF_NOT_OK(CheckAdjacency(adjacency, num_nodes, num_edges, neighbor_type));
+  }
+  RETURN_IF_NOT_OK(LoadFeatures("csr/node_feature", *reader, num_nodes, &node_features_));
+  RETURN_IF_NOT_OK(LoadFeatures("csr/edge_feature", *reader, num_edges, &edge_features_));
+  snapshot_ = reader;
+  built_ = true;
+  MS_LOG(INFO) << "CSR graph is loaded from snapshot, node num:" << num_nodes << ", edge num:" << num_edges << ".";
+  return Status::OK();
+}
+
+Status CsrGraph::CheckAdjacency(const Adjacency &adjacency, size_t num_nodes, size_t num_edges,
+                                NodeType neighbor_type) {
+  const std::string neighbor_type_str = std::to_string(neighbor_type);
+  const CsrArray<int64_t> &offsets = adjacency.offsets;
+  CHECK_FAIL_RETURN_UNEXPECTED(offsets.size() == num_nodes + 1 && offsets[0] == 0,
+                               "Invalid adjacency offsets in graph snapshot, neighbor type:" + neighbor_type_str);
+  size_t num_slots = adjacency.neighbors.size();
+  CHECK_FAIL_RETURN_UNEXPECTED(static_cast<uint64_t>(offsets[num_nodes]) == num_slots &&
+                                 adjacency.edges.size() == num_slots && adjacency.alias_prob.size() == num_slots &&
+                                 adjacency.alias_slot.size() == num_slots,
+                               "The size of the adjacency arrays in graph snapshot is inconsistent, neighbor type:" +
+                                 neighbor_type_str);
+  CHECK_FAIL_RETURN_UNEXPECTED(IndexesInRange(adjacency.neighbors, num_nodes) &&
+                                 IndexesInRange(adjacency.edges, num_edges),
+                               "Invalid neighbor or edge index in graph snapshot, neighbor type:" + neighbor_type_str);
+  // The offsets start from 0 and end at the size, so each row is inside the adjacency arrays if they do not decrease.
+  for (size_t i = 0; i < num_nodes; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(offsets[i] <= offsets[i + 1],
+                                 "The adjacency offsets in graph snapshot are not monotonic, neighbor type:" +
+                                   neighbor_type_str);
+  }
+  for (size_t i = 0; i < num_nodes; ++i) {
+    int64_t degree = offsets[i + 1] - offsets[i];
+    for (int64_t slot = offsets[i]; slot < offsets[i + 1]; ++slot) {
+      CHECK_FAIL_RETURN_UNEXPECTED(adjacency.alias_slot[slot] >= 0 && adjacency.alias_slot[slot] < degree,
+                                   "Invalid alias slot in graph snapshot, neighbor type:" + neighbor_type_str);
+    }
+  }
+  return Status::OK();
+}
+
+Status CsrGraph::LoadFeatures(const std::string &prefix, const GraphSnapshotReader &reader, size_t num_rows,
+                              FeatureColumns *columns) {
+  std::vector<FeatureType> feature_types;
+  RETURN_IF_NOT_OK(reader.Get(prefix + "_types", &feature_types));
+  for (FeatureType feature_type : feature_types) {
+    const std::string name = prefix + "/" + std::to_string(feature_type) + "/";
+    std::vector<uint64_t> meta;
+    RETURN_IF_NOT_OK(reader.Get(name + "meta", &meta));
+    CHECK_FAIL_RETURN_UNEXPECTED(meta.size() == kFeatureMetaSize, "Invalid feature meta in graph snapshot: " + name);
+    CHECK_FAIL_RETURN_UNEXPECTED(meta[0] < DataType::NUM_OF_TYPES &&
+                                   DataType(static_cast<DataType::Type>(meta[0])).IsNumeric(),
+                                 "Invalid feature data type in graph snapshot: " + name);
+    FeatureColumn &column = (*columns)[feature_type];
+    column.type = DataType(static_cast<DataType::Type>(meta[0]));
+    column.row_bytes = static_cast<size_t>(meta[1]);
+    RETURN_IF_NOT_OK(LoadArray(name + "values", reader, &column.values));
+    RETURN_IF_NOT_OK(LoadArray(name + "rows", reader, &column.rows));
+    CHECK_FAIL_RETURN_UNEXPECTED(column.rows.size() == num_rows, "Invalid feature rows in graph snapshot: " + name);
+    // A feature of zero bytes has the row 0 without values.
+    size_t num_values = column.row_bytes == 0 ? 1 : column.values.size() / column.row_bytes;
+    CHECK_FAIL_RETURN_UNEXPECTED(column.row_bytes == 0 ? column.values.empty()
+                                                       : column.values.size() % column.row_bytes == 0,
+                                 "Invalid feature values in graph snapshot: " + name);
+    CHECK_FAIL_RETURN_UNEXPECTED(IndexesInRange(column.rows, num_values, true),
+                                 "Invalid feature rows in graph snapshot: " + name);
+  }
+  return Status::OK();
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+Status CsrGraph::MoveFeaturesToSharedMemory(GraphSharedMemory *shared_memory) {
+  RETURN_UNEXPECTED_IF_NULL(shared_memory);
+  RETURN_IF_NOT_OK(MoveFeaturesToSharedMemory(shared_memory, &node_features_));
+  RETURN_IF_NOT_OK(MoveFeaturesToSharedMemory(shared_memory, &edge_features_));
+  return Status::OK();
+}
+
+Status CsrGraph::MoveFeaturesToSharedMemory(GraphSharedMemory *shared_memory, FeatureColumns *columns) {
+  // Each feature is replaced by its offset and length in the shared memory, the rows are unchanged.
+  const size_t kSharedMemoryFeatureSize = 2;
+  for (auto &itr : *columns) {
+    FeatureColumn &column = itr.second;
+    CHECK_FAIL_RETURN_UNEXPECTED(column.row_bytes > 0,
+                                 "Can not load empty feature into shared memory, feature type:" +
+                                   std::to_string(itr.first));
+    size_t num_rows = column.values.size() / column.row_bytes;
+    std::vector<int64_t> locations(num_rows * kSharedMemoryFeatureSize);
+    for (size_t row = 0; row < num_rows; ++row) {
+      int64_t offset = 0;
+      RETURN_IF_NOT_OK(shared_memory->InsertData(column.values.data() + row * column.row_bytes,
+                                                 static_cast<int64_t>(column.row_bytes), &offset));
+      locations[row * kSharedMemoryFeatureSize] = offset;
+      locations[row * kSharedMemoryFeatureSize + 1] = static_cast<int64_t>(column.row_bytes);
+    }
+    std::vector<uint8_t> values(locations.size() * sizeof(int64_t));
+    if (!values.empty()) {
+      CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(values.data(), values.size(), locations.data(), values.size()) == EOK,
+                                   "Failed to copy the feature locations in shared memory.");
+    }
+    column.type = DataType(DataType::DE_INT64);
+    column.row_bytes = kSharedMemoryFeatureSize * sizeof(int64_t);
+    column.values.Assign(std::move(values));
+  }
+  return Status::OK();
+}
+#endif
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,297 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_CSR_GRAPH_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_CSR_GRAPH_H_
+
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "include/dataset/constants.h"
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/engine/gnn/edge.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#if !defined(_WIN32) && !defined(_WIN64)
+#include "minddata/dataset/engine/gnn/graph_shared_memory.h"
+#endif
+#include "minddata/dataset/engine/gnn/graph_snapshot.h"
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+// An array of the CSR graph, which owns its values while the graph is built, or refers to the values mapped from a
+// graph snapshot after the graph is loaded.
+template <typename T>
+class CsrArray {
+ public:
+  CsrArray() = default;
+
+  CsrArray(const CsrArray &) = delete;
+
+  CsrArray &operator=(const CsrArray &) = delete;
+
+  CsrArray(CsrArray &&) = default;
+
+  CsrArray &operator=(CsrArray &&) = default;
+
+  ~CsrArray() = default;
+
+  // The owned values, only used while the graph is built
+  std::vector<T> &Owned() { return owned_; }
+
+  // Replace the values with the owned values
+  void Assign(std::vector<T> &&values) {
+    owned_ = std::move(values);
+    mapped_ = nullptr;
+    mapped_size_ = 0;
+  }
+
+  // Refer to the values mapped from a snapshot, the owned values are released
+  void Map(const T *data, size_t size) {
+    std::vector<T>().swap(owned_);
+    mapped_ = data;
+    mapped_size_ = size;
+  }
+
+  const T *data() const { return mapped_ != nullptr ? mapped_ : owned_.data(); }
+
+  size_t size() const { return mapped_ != nullptr ? mapped_size_ : owned_.size(); }
+
+  bool empty() const { return size() == 0; }
+
+  const T *begin() const { return data(); }
+
+  const T *end() const { return data() + size(); }
+
+  const T &operator[](size_t index) const { return data()[index]; }
+
+  // @return size_t - bytes of the owned values, the mapped values are not counted
+  size_t OwnedBytes() const { return owned_.capacity() * sizeof(T); }
+
+ private:
+  std::vector<T> owned_;
+  const T *mapped_ = nullptr;
+  size_t mapped_size_ = 0;
+};
+
+// Compact storage of the graph in compressed sparse row (CSR) format.
+// The nodes and the edges are kept in arrays sorted by id and referenced by their index in the arrays. The out edges
+// of the nodes are kept in one offset array and one neighbor array per neighbor node type, together with the alias
+// table of the edge weights for O(1) weighted sampling. The features of the same type are kept in one contiguous
+// column, so a feature lookup is a binary search plus a copy instead of several hash map lookups.
+class CsrGraph {
+ public:
+  CsrGraph() = default;
+
+  ~CsrGraph() = default;
+
+  // Add a node, all the nodes must be added before Build
+  // @param NodeIdType id - id of the node
+  // @param NodeType type - type of the node
+  // @param std::vector<std::shared_ptr<Feature>> &features - features of the node
+  // @return Status The status code returned
+  Status AddNode(NodeIdType id, NodeType type, const std::vector<std::shared_ptr<Feature>> &features);
+
+  // Add an edge, all the edges must be added before Build
+  // @param EdgeIdType id - id of the edge
+  // @param EdgeType type - type of the edge
+  // @param WeightType weight - weight of the edge, used by the weighted sampling
+  // @param NodeIdType src_id - id of the source node
+  // @param NodeIdType dst_id - id of the destination node
+  // @param std::vector<std::shared_ptr<Feature>> &features - features of the edge
+  // @return Status The status code returned
+  Status AddEdge(EdgeIdType id, EdgeType type, WeightType weight, NodeIdType src_id, NodeIdType dst_id,
+                 const std::vector<std::shared_ptr<Feature>> &features);
+
+  // Build the sorted index, the adjacency arrays and the alias tables from the added nodes and edges
+  // @return Status The status code returned
+  Status Build();
+
+  // @return bool - whether the node exists
+  bool HasNode(NodeIdType id) const { return NodeIndex(id) >= 0; }
+
+  // @return bool - whether the edge exists
+  bool HasEdge(EdgeIdType id) const { return EdgeIndex(id) >= 0; }
+
+  // Get all the neighbors of the node, the node itself is put at the front if exclude_itself is false
+  // @param NodeIdType id - id of the node
+  // @param NodeType neighbor_type - type of the neighbors
+  // @param std::vector<NodeIdType> *out_neighbors - returned neighbor ids
+  // @param bool exclude_itself - whether to exclude the node itself
+  // @return Status The status code returned
+  Status GetAllNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
+                         bool exclude_itself = false) const;
+
+  // Sample the neighbors of the node, filled with kDefaultNodeId if the node has no neighbor of the type
+  // @param NodeIdType id - id of the node
+  // @param NodeType neighbor_type - type of the neighbors
+  // @param int32_t samples_num - number of the sampled neighbors
+  // @param SamplingStrategy strategy - sampling strategy
+  // @param std::mt19937 *rnd - random generator
+  // @param std::vector<NodeIdType> *out_neighbors - returned neighbor ids, appended to the end
+  // @return Status The status code returned
+  Status GetSampledNeighbors(NodeIdType id, NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
+                             std::mt19937 *rnd, std::vector<NodeIdType> *out_neighbors) const;
+
+  // Sample the neighbors of the node hop by hop into out, which is the node itself followed by the neighbors of each
+  // hop, the neighbors of hop i are sampled from the neighbors of hop i-1. It is thread safe with different rnd.
+  // @param NodeIdType id - id of the node
+  // @param std::vector<NodeIdType> &neighbor_nums - number of the sampled neighbors of each hop
+  // @param std::vector<NodeType> &neighbor_types - type of the neighbors of each hop
+  // @param SamplingStrategy strategy - sampling strategy
+  // @param std::mt19937 *rnd - random generator
+  // @param NodeIdType *out - output buffer, it should be large enough for the neighbors of all hops
+  // @return Status The status code returned
+  Status GetMultiHopSampledNeighbors(NodeIdType id, const std::vector<NodeIdType> &neighbor_nums,
+                                     const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
+                                     std::mt19937 *rnd, NodeIdType *out) const;
+
+  // Get the id of the first edge from src to dst, -1 if they are not adjacent
+  // @param NodeIdType src_id - id of the source node
+  // @param NodeIdType dst_id - id of the destination node
+  // @param EdgeIdType *out_edge_id - returned edge id
+  // @return Status The status code returned
+  Status GetEdgeByAdjNodeId(NodeIdType src_id, NodeIdType dst_id, EdgeIdType *out_edge_id) const;
+
+  // Get the source and destination node of the edge
+  // @param EdgeIdType id - id of the edge
+  // @param NodeIdType *src_id - returned source node id
+  // @param NodeIdType *dst_id - returned destination node id
+  // @return Status The status code returned
+  Status GetEdgeNodes(EdgeIdType id, NodeIdType *src_id, NodeIdType *dst_id) const;
+
+  // Get the raw feature data of the node, nullptr if the node or the feature does not exist
+  // @param NodeIdType id - id of the node
+  // @param FeatureType feature_type - type of the feature
+  // @param size_t *size - returned size of the feature data in bytes
+  // @return const uint8_t * - the feature data
+  const uint8_t *GetNodeFeature(NodeIdType id, FeatureType feature_type, size_t *size) const {
+    return GetFeature(node_features_, NodeIndex(id), feature_type, size);
+  }
+
+  // Get the raw feature data of the edge, nullptr if the edge or the feature does not exist
+  // @param EdgeIdType id - id of the edge
+  // @param FeatureType feature_type - type of the feature
+  // @param size_t *size - returned size of the feature data in bytes
+  // @return const uint8_t * - the feature data
+  const uint8_t *GetEdgeFeature(EdgeIdType id, FeatureType feature_type, size_t *size) const {
+    return GetFeature(edge_features_, EdgeIndex(id), feature_type, size);
+  }
+
+  // @return size_t - bytes used by the arrays of the graph, excluding the arrays mapped from a snapshot
+  size_t MemoryUsage() const;
+
+  // Write the arrays of the built graph into the snapshot
+  // @param GraphSnapshotWriter *writer - writer of the snapshot
+  // @return Status The status code returned
+  Status Save(GraphSnapshotWriter *writer) const;
+
+  // Refer the arrays to the blocks of the snapshot without copying, the snapshot is kept alive by the graph
+  // @param std::shared_ptr<GraphSnapshotReader> &reader - reader of the opened snapshot
+  // @return Status The status code returned
+  Status Load(const std::shared_ptr<GraphSnapshotReader> &reader);
+
+#if !defined(_WIN32) && !defined(_WIN64)
+  // Copy the features into the shared memory, and replace each feature with its offset and length in the shared
+  // memory, the same as the features loaded by the graph data server
+  // @param GraphSharedMemory *shared_memory - the shared memory
+  // @return Status The status code returned
+  Status MoveFeaturesToSharedMemory(GraphSharedMemory *shared_memory);
+#endif
+
+  // @return int64_t - total bytes of the features
+  int64_t FeatureBytes() const;
+
+ private:
+  // The out edges of all the nodes to the neighbors of one node type
+  struct Adjacency {
+    CsrArray<int64_t> offsets;     // size is node number + 1, the edges of node i are in [offsets[i], offsets[i+1])
+    CsrArray<int32_t> neighbors;   // index of the neighbor node
+    CsrArray<int32_t> edges;       // index of the edge
+    CsrArray<float> alias_prob;    // probability to keep the slot in the alias table
+    CsrArray<int32_t> alias_slot;  // slot in the row to switch to if not kept
+  };
+
+  // The features of one feature type, the feature of each node or edge has the same size
+  struct FeatureColumn {
+    DataType type;
+    size_t row_bytes = 0;
+    CsrArray<uint8_t> values;
+    CsrArray<int32_t> rows;  // row of each node or edge in values, -1 if it does not have the feature
+  };
+
+  using FeatureColumns = std::unordered_map<FeatureType, FeatureColumn>;
+
+  static Status AppendFeatures(const std::vector<std::shared_ptr<Feature>> &features, size_t index,
+                               FeatureColumns *columns);
+
+  static void SortFeatureRows(const std::vector<int32_t> &order, FeatureColumns *columns);
+
+  static const uint8_t *GetFeature(const FeatureColumns &columns, int64_t index, FeatureType feature_type,
+                                   size_t *size);
+
+  static Status SaveFeatures(const std::string &prefix, const FeatureColumns &columns, GraphSnapshotWriter *writer);
+
+  static Status LoadFeatures(const std::string &prefix, const GraphSnapshotReader &reader, size_t num_rows,
+                             FeatureColumns *columns);
+
+  // Check the adjacency loaded from a snapshot, the offsets, the indexes and the alias slots are used without bound
+  // checks by the sampling
+  static Status CheckAdjacency(const Adjacency &adjacency, size_t num_nodes, size_t num_edges, NodeType neighbor_type);
+
+#if !defined(_WIN32) && !defined(_WIN64)
+  static Status MoveFeaturesToSharedMemory(GraphSharedMemory *shared_memory, FeatureColumns *columns);
+#endif
+
+  // Build the alias table of each row with the Vose's method
+  static void BuildAliasTable(const std::vector<WeightType> &weights, Adjacency *adjacency);
+
+  // Sample the neighbors of the node at the index into out, the slots are the buffer for the random sampling
+  Status SampleNeighbors(int64_t index, NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
+                         std::mt19937 *rnd, std::vector<int32_t> *slots, NodeIdType *out) const;
+
+  int64_t NodeIndex(NodeIdType id) const;
+
+  int64_t EdgeIndex(EdgeIdType id) const;
+
+  CsrArray<NodeIdType> node_ids_;
+  CsrArray<NodeType> node_types_;
+  CsrArray<EdgeIdType> edge_ids_;
+  CsrArray<EdgeType> edge_types_;
+  CsrArray<int32_t> edge_src_;
+  CsrArray<int32_t> edge_dst_;
+  // Only kept until Build, the node ids of the edges are resolved to index after the nodes are sorted
+  std::vector<NodeIdType> edge_src_ids_;
+  std::vector<NodeIdType> edge_dst_ids_;
+  std::vector<WeightType> edge_weights_;
+  std::unordered_map<NodeType, Adjacency> adjacency_;
+  FeatureColumns node_features_;
+  FeatureColumns edge_features_;
+  bool built_ = false;
+  // Keep the snapshot mapped while the arrays refer to it
+  std::shared_ptr<GraphSnapshotReader> snapshot_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_CSR_GRAPH_H_
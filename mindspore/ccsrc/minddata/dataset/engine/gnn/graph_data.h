@@ -33,6 +33,10 @@ namespace mindspore {
 namespace dataset {
 namespace gnn {
 
+// The in-memory storage format of the graph.
+// kDefault keeps a node object and an edge object per node and edge, kCsr keeps the graph in compact CSR arrays.
+enum class GraphStorageFormat { kDefault, kCsr };
+
 struct MetaInfo {
   std::vector<NodeType> node_type;
   std::vector<EdgeType> edge_type;
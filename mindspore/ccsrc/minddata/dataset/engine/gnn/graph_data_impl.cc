@@ -23,17 +23,22 @@
 
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
+#include "minddata/dataset/engine/gnn/graph_snapshot.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/task_manager.h"
+#include "./securec.h"
 namespace mindspore {
 namespace dataset {
 namespace gnn {
 
-GraphDataImpl::GraphDataImpl(const std::string &dataset_file, int32_t num_workers, bool server_mode)
+GraphDataImpl::GraphDataImpl(const std::string &dataset_file, int32_t num_workers, bool server_mode,
+                             GraphStorageFormat storage_format)
     : dataset_file_(dataset_file),
       num_workers_(num_workers),
       rnd_(GetRandomDevice()),
       random_walk_(this),
-      server_mode_(server_mode) {
+      server_mode_(server_mode),
+      storage_format_(storage_format) {
   rnd_.seed(GetSeed());
   MS_LOG(INFO) << "num_workers:" << num_workers;
 }
@@ -118,6 +123,13 @@ Status GraphDataImpl::GetNodesFromEdges(const std::vector<EdgeIdType> &edge_list
   std::vector<std::vector<NodeIdType>> node_list;
   node_list.reserve(edge_list.size());
   for (const auto &edge_id : edge_list) {
+    if (csr_graph_ != nullptr) {
+      NodeIdType src_id;
+      NodeIdType dst_id;
+      RETURN_IF_NOT_OK(csr_graph_->GetEdgeNodes(edge_id, &src_id, &dst_id));
+      node_list.push_back({src_id, dst_id});
+      continue;
+    }
     auto itr = edge_id_map_.find(edge_id);
     if (itr == edge_id_map_.end()) {
       std::string err_msg = "Invalid edge id:" + std::to_string(edge_id);
@@ -143,11 +155,14 @@ Status GraphDataImpl::GetEdgesFromNodes(const std::vector<std::pair<NodeIdType,
   edge_list.reserve(node_list.size());
 
   for (const auto &node_id : node_list) {
-    std::shared_ptr<Node> src_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_id.first, &src_node));
-
     EdgeIdType edge_id;
-    src_node->GetEdgeByAdjNodeId(node_id.second, &edge_id);
+    if (csr_graph_ != nullptr) {
+      RETURN_IF_NOT_OK(csr_graph_->GetEdgeByAdjNodeId(node_id.first, node_id.second, &edge_id));
+    } else {
+      std::shared_ptr<Node> src_node;
+      RETURN_IF_NOT_OK(GetNodeByNodeId(node_id.first, &src_node));
+      src_node->GetEdgeByAdjNodeId(node_id.second, &edge_id);
+    }
 
     std::vector<EdgeIdType> connection_edge = {edge_id};
     edge_list.emplace_back(std::move(connection_edge));
@@ -172,16 +187,14 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   // Collect information of adjacent table
   neighbors.resize(node_list.size());
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
     if (format == OutputFormat::kNormal) {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
+      RETURN_IF_NOT_OK(GetNodeNeighbors(node_list[i], neighbor_type, &neighbors[i]));
       max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
     } else if (format == OutputFormat::kCoo) {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i], true));
+      RETURN_IF_NOT_OK(GetNodeNeighbors(node_list[i], neighbor_type, &neighbors[i], true));
       total_edge_num += neighbors[i].size();
     } else {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i], true));
+      RETURN_IF_NOT_OK(GetNodeNeighbors(node_list[i], neighbor_type, &neighbors[i], true));
       total_edge_num += neighbors[i].size();
       if (i < node_list.size() - 1) {
         offset_table[i + 1] = total_edge_num;
@@ -258,33 +271,54 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
     RETURN_IF_NOT_OK(CheckNeighborType(type));
   }
   RETURN_UNEXPECTED_IF_NULL(out);
-  std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
+  // The row of each node is the node itself followed by the neighbors of each hop.
+  size_t row_size = 1;
+  size_t hop_size = 1;
+  for (const auto &num : neighbor_nums) {
+    hop_size *= static_cast<size_t>(num);
+    row_size += hop_size;
+  }
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(
+    TensorShape({static_cast<dsize_t>(node_list.size()), static_cast<dsize_t>(row_size)}),
+    DataType(DataType::DE_INT32), out));
+  auto out_data = reinterpret_cast<NodeIdType *>(const_cast<uchar *>((*out)->GetBuffer()));
+  if (csr_graph_ != nullptr) {
+    // The CSR graph is read only, so the nodes are sampled in parallel and written into their rows directly.
+    return ParallelFor(node_list.size(), num_workers_,
+                       [this, &node_list, &neighbor_nums, &neighbor_types, strategy, out_data, row_size](
+                         size_t begin, size_t end, std::mt19937 *rnd) -> Status {
+                         for (size_t i = begin; i < end; ++i) {
+                           RETURN_IF_NOT_OK(csr_graph_->GetMultiHopSampledNeighbors(
+                             node_list[i], neighbor_nums, neighbor_types, strategy, rnd, out_data + i * row_size));
+                         }
+                         return Status::OK();
+                       });
+  }
+  // The random generator of LocalNode is not thread safe, so the nodes are sampled one by one.
+  std::vector<NodeIdType> input_list;
+  std::vector<NodeIdType> neighbors;
   for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
-    neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
-    std::vector<NodeIdType> input_list = {node_list[node_idx]};
+    RETURN_IF_NOT_OK(CheckNodeId(node_list[node_idx]));
+    NodeIdType *row = out_data + node_idx * row_size;
+    row[0] = node_list[node_idx];
+    size_t pos = 1;
+    input_list.assign(1, node_list[node_idx]);
     for (size_t i = 0; i < neighbor_nums.size(); ++i) {
-      std::vector<NodeIdType> neighbors;
+      neighbors.clear();
       neighbors.reserve(input_list.size() * neighbor_nums[i]);
       for (const auto &node_id : input_list) {
         if (node_id == kDefaultNodeId) {
-          for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
-            neighbors.emplace_back(kDefaultNodeId);
-          }
+          neighbors.insert(neighbors.end(), static_cast<size_t>(neighbor_nums[i]), kDefaultNodeId);
         } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], strategy, &out));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
+          RETURN_IF_NOT_OK(SampleNodeNeighbors(node_id, neighbor_types[i], neighbor_nums[i], strategy, &neighbors));
         }
       }
-      neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
-      input_list = std::move(neighbors);
+      CHECK_FAIL_RETURN_UNEXPECTED(pos + neighbors.size() <= row_size, "The number of sampled neighbors is invalid.");
+      std::copy(neighbors.begin(), neighbors.end(), row + pos);
+      pos += neighbors.size();
+      input_list.swap(neighbors);
     }
   }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
   return Status::OK();
 }
 
@@ -326,15 +360,14 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
   neg_neighbors_vec.resize(node_list.size());
   for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
+    NodeIdType node_id = node_list[node_idx];
     std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
+    RETURN_IF_NOT_OK(GetNodeNeighbors(node_id, neg_neighbor_type, &neighbors));
     std::unordered_set<NodeIdType> exclude_nodes;
     (void)std::transform(neighbors.begin(), neighbors.end(),
                          std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
                          [](const NodeIdType node) { return node; });
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
+    neg_neighbors_vec[node_idx].emplace_back(node_id);
     if (all_nodes.size() > exclude_nodes.size()) {
       while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
         RETURN_IF_NOT_OK(NegativeSample(all_nodes, shuffled_id, &start_index, exclude_nodes, samples_num + 1,
@@ -345,7 +378,7 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
         }
       }
     } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
+      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node_id
                     << " neg_neighbor_type:" << neg_neighbor_type;
       // If there are no negative neighbors, they are filled with kDefaultNodeId
       for (int32_t i = 0; i < samples_num; ++i) {
@@ -366,10 +399,9 @@ Status GraphDataImpl::RandomWalk(const std::vector<NodeIdType> &node_list, const
                                  float step_home_param, float step_away_param, NodeIdType default_node,
                                  std::shared_ptr<Tensor> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
-  RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node));
-  std::vector<std::vector<NodeIdType>> walks;
-  RETURN_IF_NOT_OK(random_walk_.SimulateWalk(&walks));
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({walks}, DataType(DataType::DE_INT32), out));
+  RETURN_IF_NOT_OK(
+    random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node, 1, num_workers_));
+  RETURN_IF_NOT_OK(random_walk_.SimulateWalk(out));
   return Status::OK();
 }
 
@@ -419,6 +451,14 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
 
     dsize_t index = 0;
     for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+      if (csr_graph_ != nullptr) {
+        size_t size = 0;
+        const uint8_t *data =
+          *node_itr == kDefaultNodeId ? nullptr : csr_graph_->GetNodeFeature(*node_itr, f_type, &size);
+        RETURN_IF_NOT_OK(InsertCsrFeature(data, size, default_feature, index, &fea_tensor));
+        index++;
+        continue;
+      }
       std::shared_ptr<Feature> feature;
       if (*node_itr == kDefaultNodeId) {
         feature = default_feature;
@@ -462,6 +502,11 @@ Status GraphDataImpl::GetNodeFeatureSharedMemory(const std::shared_ptr<Tensor> &
       ++out_fea_itr;
       *out_fea_itr = -1;
       ++out_fea_itr;
+    } else if (csr_graph_ != nullptr) {
+      RETURN_IF_NOT_OK(CheckNodeId(*node_itr));
+      size_t size = 0;
+      const uint8_t *data = csr_graph_->GetNodeFeature(*node_itr, type, &size);
+      RETURN_IF_NOT_OK(InsertCsrFeatureSharedMemory(data, size, &out_fea_itr));
     } else {
       std::shared_ptr<Node> node;
       RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
@@ -509,6 +554,13 @@ Status GraphDataImpl::GetEdgeFeature(const std::shared_ptr<Tensor> &edges,
 
     dsize_t index = 0;
     for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
+      if (csr_graph_ != nullptr) {
+        size_t size = 0;
+        const uint8_t *data = csr_graph_->GetEdgeFeature(*edge_itr, f_type, &size);
+        RETURN_IF_NOT_OK(InsertCsrFeature(data, size, default_feature, index, &fea_tensor));
+        index++;
+        continue;
+      }
       std::shared_ptr<Edge> edge;
       std::shared_ptr<Feature> feature;
 
@@ -543,6 +595,13 @@ Status GraphDataImpl::GetEdgeFeatureSharedMemory(const std::shared_ptr<Tensor> &
 
   auto out_fea_itr = fea_tensor->begin<int64_t>();
   for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
+    if (csr_graph_ != nullptr) {
+      CHECK_FAIL_RETURN_UNEXPECTED(csr_graph_->HasEdge(*edge_itr), "Invalid edge id:" + std::to_string(*edge_itr));
+      size_t size = 0;
+      const uint8_t *data = csr_graph_->GetEdgeFeature(*edge_itr, type, &size);
+      RETURN_IF_NOT_OK(InsertCsrFeatureSharedMemory(data, size, &out_fea_itr));
+      continue;
+    }
     std::shared_ptr<Edge> edge;
     RETURN_IF_NOT_OK(GetEdgeByEdgeId(*edge_itr, &edge));
     std::shared_ptr<Feature> feature;
@@ -626,6 +685,12 @@ Status GraphDataImpl::GraphInfo(py::dict *out) {
 #endif
 
 Status GraphDataImpl::LoadNodeAndEdge() {
+  if (GraphSnapshotReader::IsSnapshot(dataset_file_)) {
+    return LoadSnapshot();
+  }
+  if (storage_format_ == GraphStorageFormat::kCsr) {
+    csr_graph_ = std::make_unique<CsrGraph>();
+  }
   GraphLoader gl(this, dataset_file_, num_workers_, server_mode_);
   // ask graph_loader to load everything into memory
   RETURN_IF_NOT_OK(gl.InitAndLoad());
@@ -634,6 +699,153 @@ Status GraphDataImpl::LoadNodeAndEdge() {
   return Status::OK();
 }
 
+namespace {
+// Save the values of each type, such as the node ids of each node type, as one block of the types and one block of
+// the values per type.
+template <typename K, typename C>
+Status SaveTypeMap(const std::string &prefix, const std::unordered_map<K, C> &type_map, GraphSnapshotWriter *writer) {
+  std::vector<K> types;
+  for (const auto &itr : type_map) {
+    types.push_back(itr.first);
+    std::vector<typename C::value_type> values(itr.second.begin(), itr.second.end());
+    RETURN_IF_NOT_OK(writer->Write(prefix + "/" + std::to_string(itr.first), values));
+  }
+  return writer->Write(prefix + "_types", types);
+}
+
+template <typename K, typename C>
+Status LoadTypeMap(const std::string &prefix, const GraphSnapshotReader &reader, std::unordered_map<K, C> *type_map) {
+  std::vector<K> types;
+  RETURN_IF_NOT_OK(reader.Get(prefix + "_types", &types));
+  for (K type : types) {
+    const typename C::value_type *values = nullptr;
+    size_t count = 0;
+    RETURN_IF_NOT_OK(reader.Get(prefix + "/" + std::to_string(type), &values, &count));
+    (*type_map)[type] = C(values, values + count);
+  }
+  return Status::OK();
+}
+
+// The default features are zero tensors, so only their shapes and data types are saved.
+Status SaveDefaultFeatures(const std::string &prefix,
+                           const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_features,
+                           GraphSnapshotWriter *writer) {
+  std::vector<FeatureType> types;
+  for (const auto &itr : default_features) {
+    RETURN_UNEXPECTED_IF_NULL(itr.second);
+    const std::shared_ptr<Tensor> &value = itr.second->Value();
+    RETURN_UNEXPECTED_IF_NULL(value);
+    types.push_back(itr.first);
+    const std::string name = prefix + "/" + std::to_string(itr.first);
+    RETURN_IF_NOT_OK(writer->Write(name + "/shape", value->shape().AsVector()));
+    std::vector<uint64_t> data_type = {static_cast<uint64_t>(value->type().value())};
+    RETURN_IF_NOT_OK(writer->Write(name + "/type", data_type));
+  }
+  return writer->Write(prefix + "_types", types);
+}
+
+Status LoadDefaultFeatures(const std::string &prefix, const GraphSnapshotReader &reader,
+                           std::unordered_map<FeatureType, std::shared_ptr<Feature>> *default_features) {
+  std::vector<FeatureType> types;
+  RETURN_IF_NOT_OK(reader.Get(prefix + "_types", &types));
+  for (FeatureType type : types) {
+    const std::string name = prefix + "/" + std::to_string(type);
+    std::vector<dsize_t> shape;
+    std::vector<uint64_t> data_type;
+    RETURN_IF_NOT_OK(reader.Get(name + "/shape", &shape));
+    RETURN_IF_NOT_OK(reader.Get(name + "/type", &data_type));
+    CHECK_FAIL_RETURN_UNEXPECTED(data_type.size() == 1, "Invalid default feature in graph snapshot: " + name);
+    std::shared_ptr<Tensor> zero_tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(shape), DataType(static_cast<DataType::Type>(data_type[0])),
+                                         &zero_tensor));
+    RETURN_IF_NOT_OK(zero_tensor->Zero());
+    (*default_features)[type] = std::make_shared<Feature>(type, zero_tensor);
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status GraphDataImpl::SaveSnapshot(const std::string &snapshot_file) {
+  CHECK_FAIL_RETURN_UNEXPECTED(csr_graph_ != nullptr, "Graph snapshot can only be saved in CSR storage format.");
+  CHECK_FAIL_RETURN_UNEXPECTED(!server_mode_,
+                               "Graph snapshot can not be saved in server mode, the features are in shared memory.");
+  GraphSnapshotWriter writer(snapshot_file);
+  RETURN_IF_NOT_OK(writer.Open());
+  std::string schema = data_schema_.dump();
+  RETURN_IF_NOT_OK(writer.WriteBlock("graph/schema", schema.data(), schema.size()));
+  RETURN_IF_NOT_OK(SaveTypeMap("graph/node_type", node_type_map_, &writer));
+  RETURN_IF_NOT_OK(SaveTypeMap("graph/edge_type", edge_type_map_, &writer));
+  RETURN_IF_NOT_OK(SaveTypeMap("graph/node_feature", node_feature_map_, &writer));
+  RETURN_IF_NOT_OK(SaveTypeMap("graph/edge_feature", edge_feature_map_, &writer));
+  RETURN_IF_NOT_OK(SaveDefaultFeatures("graph/default_node_feature", default_node_feature_map_, &writer));
+  RETURN_IF_NOT_OK(SaveDefaultFeatures("graph/default_edge_feature", default_edge_feature_map_, &writer));
+  RETURN_IF_NOT_OK(csr_graph_->Save(&writer));
+  return writer.Close();
+}
+
+Status GraphDataImpl::ParallelFor(size_t total, int32_t num_workers,
+                                  const std::function<Status(size_t, size_t, std::mt19937 *)> &func) {
+  size_t num_tasks = std::min(static_cast<size_t>(std::max(num_workers, 1)),
+                              (total + kMinSamplesPerTask - 1) / kMinSamplesPerTask);
+  if (num_tasks <= 1) {
+    return func(0, total, &rnd_);
+  }
+  std::vector<std::mt19937> rnds;
+  for (size_t i = 0; i < num_tasks; ++i) {
+    rnds.emplace_back(rnd_());
+  }
+  size_t range_size = (total + num_tasks - 1) / num_tasks;
+  TaskGroup vg;
+  for (size_t i = 0; i < num_tasks; ++i) {
+    size_t begin = i * range_size;
+    size_t end = std::min(total, begin + range_size);
+    if (begin >= end) {
+      break;
+    }
+    std::mt19937 *rnd = &rnds[i];
+    RETURN_IF_NOT_OK(vg.CreateAsyncTask("GraphSampler", [&func, begin, end, rnd]() -> Status {
+      TaskManager::FindMe()->Post();
+      return func(begin, end, rnd);
+    }));
+  }
+  RETURN_IF_NOT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+  RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
+  return Status::OK();
+}
+
+Status GraphDataImpl::LoadSnapshot() {
+  // The arrays of the snapshot are referred by the CSR graph without copying, so it is always in CSR storage format.
+  storage_format_ = GraphStorageFormat::kCsr;
+  auto reader = std::make_shared<GraphSnapshotReader>(dataset_file_);
+  RETURN_IF_NOT_OK(reader->Open());
+  const char *schema = nullptr;
+  size_t schema_size = 0;
+  RETURN_IF_NOT_OK(reader->Get("graph/schema", &schema, &schema_size));
+  try {
+    data_schema_ = mindrecord::json::parse(std::string(schema, schema_size));
+  } catch (const std::exception &e) {
+    RETURN_STATUS_UNEXPECTED("Invalid schema in graph snapshot: " + dataset_file_ + ", " + e.what());
+  }
+  RETURN_IF_NOT_OK(LoadTypeMap("graph/node_type", *reader, &node_type_map_));
+  RETURN_IF_NOT_OK(LoadTypeMap("graph/edge_type", *reader, &edge_type_map_));
+  RETURN_IF_NOT_OK(LoadTypeMap("graph/node_feature", *reader, &node_feature_map_));
+  RETURN_IF_NOT_OK(LoadTypeMap("graph/edge_feature", *reader, &edge_feature_map_));
+  RETURN_IF_NOT_OK(LoadDefaultFeatures("graph/default_node_feature", *reader, &default_node_feature_map_));
+  RETURN_IF_NOT_OK(LoadDefaultFeatures("graph/default_edge_feature", *reader, &default_edge_feature_map_));
+  csr_graph_ = std::make_unique<CsrGraph>();
+  RETURN_IF_NOT_OK(csr_graph_->Load(reader));
+  if (server_mode_) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    // The clients read the features from the shared memory instead of the snapshot.
+    int64_t feature_bytes = std::max(csr_graph_->FeatureBytes(), static_cast<int64_t>(1));
+    graph_shared_memory_ = std::make_unique<GraphSharedMemory>(feature_bytes, dataset_file_);
+    RETURN_IF_NOT_OK(graph_shared_memory_->CreateSharedMemory());
+    RETURN_IF_NOT_OK(csr_graph_->MoveFeaturesToSharedMemory(graph_shared_memory_.get()));
+#endif
+  }
+  return Status::OK();
+}
+
 Status GraphDataImpl::GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node) {
   RETURN_UNEXPECTED_IF_NULL(node);
   auto itr = node_id_map_.find(id);
@@ -658,6 +870,68 @@ Status GraphDataImpl::GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge
   return Status::OK();
 }
 
+Status GraphDataImpl::CheckNodeId(NodeIdType id) {
+  if (csr_graph_ != nullptr) {
+    CHECK_FAIL_RETURN_UNEXPECTED(csr_graph_->HasNode(id), "Invalid node id:" + std::to_string(id));
+    return Status::OK();
+  }
+  std::shared_ptr<Node> node;
+  return GetNodeByNodeId(id, &node);
+}
+
+Status GraphDataImpl::GetNodeNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
+                                       bool exclude_itself) {
+  if (csr_graph_ != nullptr) {
+    return csr_graph_->GetAllNeighbors(id, neighbor_type, out_neighbors, exclude_itself);
+  }
+  std::shared_ptr<Node> node;
+  RETURN_IF_NOT_OK(GetNodeByNodeId(id, &node));
+  return node->GetAllNeighbors(neighbor_type, out_neighbors, exclude_itself);
+}
+
+Status GraphDataImpl::SampleNodeNeighbors(NodeIdType id, NodeType neighbor_type, int32_t samples_num,
+                                          SamplingStrategy strategy, std::vector<NodeIdType> *out_neighbors) {
+  RETURN_UNEXPECTED_IF_NULL(out_neighbors);
+  if (csr_graph_ != nullptr) {
+    return csr_graph_->GetSampledNeighbors(id, neighbor_type, samples_num, strategy, &rnd_, out_neighbors);
+  }
+  std::shared_ptr<Node> node;
+  RETURN_IF_NOT_OK(GetNodeByNodeId(id, &node));
+  std::vector<NodeIdType> out;
+  RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_type, samples_num, strategy, &out));
+  out_neighbors->insert(out_neighbors->end(), out.begin(), out.end());
+  return Status::OK();
+}
+
+Status GraphDataImpl::InsertCsrFeature(const uint8_t *data, size_t size,
+                                       const std::shared_ptr<Feature> &default_feature, dsize_t index,
+                                       std::shared_ptr<Tensor> *fea_tensor) {
+  RETURN_UNEXPECTED_IF_NULL(fea_tensor);
+  if (data == nullptr) {
+    return (*fea_tensor)->InsertTensor({index}, default_feature->Value());
+  }
+  auto row_bytes = static_cast<size_t>(default_feature->Value()->SizeInBytes());
+  CHECK_FAIL_RETURN_UNEXPECTED(size == row_bytes, "The size of feature is different from the default feature, got " +
+                                                    std::to_string(size) + ", expected " + std::to_string(row_bytes));
+  auto dst = const_cast<uchar *>((*fea_tensor)->GetBuffer()) + static_cast<size_t>(index) * row_bytes;
+  CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(dst, row_bytes, data, size) == EOK, "Failed to copy the feature data.");
+  return Status::OK();
+}
+
+Status GraphDataImpl::InsertCsrFeatureSharedMemory(const uint8_t *data, size_t size,
+                                                   Tensor::TensorIterator<int64_t> *out_fea_itr) {
+  RETURN_UNEXPECTED_IF_NULL(out_fea_itr);
+  // The feature in shared memory is saved as the offset and the length
+  const size_t kSharedMemoryFeatureSize = 2;
+  CHECK_FAIL_RETURN_UNEXPECTED(data == nullptr || size == kSharedMemoryFeatureSize * sizeof(int64_t),
+                               "Invalid shared memory feature size:" + std::to_string(size));
+  for (size_t i = 0; i < kSharedMemoryFeatureSize; ++i) {
+    **out_fea_itr = data == nullptr ? -1 : reinterpret_cast<const int64_t *>(data)[i];
+    ++(*out_fea_itr);
+  }
+  return Status::OK();
+}
+
 GraphDataImpl::RandomWalkBase::RandomWalkBase(GraphDataImpl *graph)
     : graph_(graph), step_home_param_(1.0), step_away_param_(1.0), default_node_(-1), num_walks_(1), num_workers_(1) {}
 
@@ -702,7 +976,9 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
+Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::mt19937 *rnd,
+                                                   std::vector<NodeIdType> *walk_path) {
+  RETURN_UNEXPECTED_IF_NULL(rnd);
   RETURN_UNEXPECTED_IF_NULL(walk_path);
   // Simulate a random walk starting from start node.
   auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
@@ -710,12 +986,10 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
   while (walk.size() - 1 < meta_path_.size()) {
     // current nodE
     auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
 
     // current neighbors
     std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
+    RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(cur_node_id, meta_path_[walk.size() - 1], &cur_neighbors, true));
     std::sort(cur_neighbors.begin(), cur_neighbors.end());
 
     // break if no neighbors
@@ -726,12 +1000,12 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
     // walk by the fist node, then by the previous 2 nodes
     std::shared_ptr<StochasticIndex> stochastic_index;
     if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
+      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], rnd, &stochastic_index));
     } else {
       NodeIdType prev_node_id = walk[walk.size() - 2];
-      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
+      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, rnd, &stochastic_index));
     }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
+    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index, rnd)];
     walk.push_back(next_node_id);
   }
 
@@ -743,47 +1017,53 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
-  RETURN_UNEXPECTED_IF_NULL(walks);
-  for (int32_t i = 0; i < num_walks_; ++i) {
-    for (const auto &node : node_list_) {
+Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::shared_ptr<Tensor> *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  size_t walk_length = meta_path_.size() + 1;
+  size_t num_walks = static_cast<size_t>(num_walks_) * node_list_.size();
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(
+    TensorShape({static_cast<dsize_t>(num_walks), static_cast<dsize_t>(walk_length)}), DataType(DataType::DE_INT32),
+    out));
+  auto out_data = reinterpret_cast<NodeIdType *>(const_cast<uchar *>((*out)->GetBuffer()));
+  // The walks only read the graph, so they are simulated in parallel, the i-th walk starts from the
+  // (i % node number)-th node.
+  return graph_->ParallelFor(
+    num_walks, num_workers_,
+    [this, out_data, walk_length](size_t begin, size_t end, std::mt19937 *rnd) -> Status {
       std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
-      walks->push_back(walk);
-    }
-  }
-  return Status::OK();
+      for (size_t i = begin; i < end; ++i) {
+        RETURN_IF_NOT_OK(Node2vecWalk(node_list_[i % node_list_.size()], rnd, &walk));
+        CHECK_FAIL_RETURN_UNEXPECTED(walk.size() == walk_length, "The length of walk path is invalid.");
+        std::copy(walk.begin(), walk.end(), out_data + i * walk_length);
+      }
+      return Status::OK();
+    });
 }
 
 Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
+                                                         std::mt19937 *rnd,
                                                          std::shared_ptr<StochasticIndex> *node_probability) {
   RETURN_UNEXPECTED_IF_NULL(node_probability);
   // Generate alias nodes
-  std::shared_ptr<Node> node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(node_id, &node));
   std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(node_id, node_type, &neighbors, true));
   std::sort(neighbors.begin(), neighbors.end());
   auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
   *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability), rnd));
   return Status::OK();
 }
 
 Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst,
-                                                         uint32_t meta_path_index,
+                                                         uint32_t meta_path_index, std::mt19937 *rnd,
                                                          std::shared_ptr<StochasticIndex> *edge_probability) {
   RETURN_UNEXPECTED_IF_NULL(edge_probability);
   // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(src, &src_node));
   std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(src, meta_path_[meta_path_index], &src_neighbors, true));
 
-  std::shared_ptr<Node> dst_node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(dst, &dst_node));
   std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(dst, meta_path_[meta_path_index + 1], &dst_neighbors, true));
 
   CHECK_FAIL_RETURN_UNEXPECTED(step_home_param_ != 0, "Invalid data, step home parameter can't be zero.");
   CHECK_FAIL_RETURN_UNEXPECTED(step_away_param_ != 0, "Invalid data, step away parameter can't be zero.");
@@ -805,21 +1085,21 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
   }
 
   *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability), rnd));
   return Status::OK();
 }
 
-StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
+StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability,
+                                                                   std::mt19937 *rnd) {
   uint32_t K = probability.size();
   std::vector<int32_t> switch_to_large_index(K, 0);
   std::vector<float> weight(K, .0);
   std::vector<int32_t> smaller;
   std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
   std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
   float accumulate_threshold = 0.0;
   for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
+    float threshold_one = distribution(*rnd);
     accumulate_threshold += threshold_one;
     weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
     weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
@@ -837,18 +1117,17 @@ StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::ve
   return StochasticIndex(switch_to_large_index, weight);
 }
 
-uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
+uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index, std::mt19937 *rnd) {
+  const auto &switch_to_large_index = stochastic_index.first;
+  const auto &weight = stochastic_index.second;
   const uint32_t size_of_index = switch_to_large_index.size();
 
-  auto random_device = GetRandomDevice();
   std::uniform_real_distribution<> distribution(0.0, 1.0);
 
   // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
+  uint32_t random_idx = std::floor(distribution(*rnd) * size_of_index);
 
-  if (distribution(random_device) < weight[random_idx]) {
+  if (distribution(*rnd) < weight[random_idx]) {
     return random_idx;
   }
   return switch_to_large_index[random_idx];
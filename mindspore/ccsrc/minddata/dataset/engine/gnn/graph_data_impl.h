@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_DATA_IMPL_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 #include <map>
@@ -25,6 +26,7 @@
 #include <vector>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/csr_graph.h"
 #include "minddata/dataset/engine/gnn/graph_data.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
@@ -37,6 +39,8 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
+// The minimum number of nodes or walks handled by one sampling task
+const size_t kMinSamplesPerTask = 32;
 using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
 
 class GraphDataImpl : public GraphData {
@@ -44,7 +48,10 @@ class GraphDataImpl : public GraphData {
   // Constructor
   // @param std::string dataset_file -
   // @param int32_t num_workers - number of parallel threads
-  GraphDataImpl(const std::string &dataset_file, int32_t num_workers, bool server_mode = false);
+  // @param bool server_mode - whether to load the features into shared memory for the graph data server
+  // @param GraphStorageFormat storage_format - the in-memory storage format of the graph
+  GraphDataImpl(const std::string &dataset_file, int32_t num_workers, bool server_mode = false,
+                GraphStorageFormat storage_format = GraphStorageFormat::kDefault);
 
   ~GraphDataImpl() override;
 
@@ -164,6 +171,12 @@ class GraphDataImpl : public GraphData {
 
   std::string GetDataSchema() { return data_schema_.dump(); }
 
+  // Save the loaded graph into a snapshot file, which is memory mapped when it is loaded as the dataset file.
+  // Only supported in CSR storage format and not in server mode.
+  // @param std::string &snapshot_file - path of the snapshot file
+  // @return Status The status code returned
+  Status SaveSnapshot(const std::string &snapshot_file);
+
 #if !defined(_WIN32) && !defined(_WIN64)
   key_t GetSharedMemoryKey() { return graph_shared_memory_->memory_key(); }
 
@@ -182,20 +195,21 @@ class GraphDataImpl : public GraphData {
 
     ~RandomWalkBase() = default;
 
-    Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
+    // Simulate the walks in parallel and write them into the tensor, one walk per row
+    Status SimulateWalk(std::shared_ptr<Tensor> *out);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
+    Status Node2vecWalk(const NodeIdType &start_node, std::mt19937 *rnd, std::vector<NodeIdType> *walk_path);
 
-    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
+    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type, std::mt19937 *rnd,
                               std::shared_ptr<StochasticIndex> *node_probability);
 
     Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
+                              std::mt19937 *rnd, std::shared_ptr<StochasticIndex> *edge_probability);
 
-    static StochasticIndex GenerateProbability(const std::vector<float> &probability);
+    static StochasticIndex GenerateProbability(const std::vector<float> &probability, std::mt19937 *rnd);
 
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
+    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index, std::mt19937 *rnd);
 
     template <typename T>
     std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
@@ -255,6 +269,61 @@ class GraphDataImpl : public GraphData {
   // @return Status The status code returned
   Status GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge);
 
+  // Check whether the node exists
+  // @param NodeIdType id -
+  // @return Status The status code returned
+  Status CheckNodeId(NodeIdType id);
+
+  // Get all neighbors of a node from the node object or the CSR graph
+  // @param NodeIdType id - id of the node
+  // @param NodeType neighbor_type - type of the neighbors
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbor ids
+  // @param bool exclude_itself - whether to exclude the node itself from the returned neighbors
+  // @return Status The status code returned
+  Status GetNodeNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
+                          bool exclude_itself = false);
+
+  // Sample the neighbors of a node from the node object or the CSR graph
+  // @param NodeIdType id - id of the node
+  // @param NodeType neighbor_type - type of the neighbors
+  // @param int32_t samples_num - number of the sampled neighbors
+  // @param SamplingStrategy strategy - Sampling strategy
+  // @param std::vector<NodeIdType> *out_neighbors - Sampled neighbor ids are appended to it
+  // @return Status The status code returned
+  Status SampleNodeNeighbors(NodeIdType id, NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
+                             std::vector<NodeIdType> *out_neighbors);
+
+  // Split [0, total) into ranges and run func on them in parallel with the task group, each range with its own random
+  // generator seeded from rnd_. It runs in the current thread if the total is too small to split.
+  // @param size_t total - total number of the items
+  // @param int32_t num_workers - max number of the parallel tasks
+  // @param std::function<Status(size_t, size_t, std::mt19937 *)> &func - called with the begin and end of the range
+  // @return Status The status code returned
+  Status ParallelFor(size_t total, int32_t num_workers,
+                     const std::function<Status(size_t, size_t, std::mt19937 *)> &func);
+
+  // Load the graph from the snapshot file in CSR storage format, the features are copied into the shared memory in
+  // server mode
+  // @return Status The status code returned
+  Status LoadSnapshot();
+
+  // Copy the feature data from the CSR graph into the row of the feature tensor, use default feature if data is null
+  // @param const uint8_t *data - the feature data
+  // @param size_t size - size of the feature data in bytes
+  // @param std::shared_ptr<Feature> &default_feature - the default feature
+  // @param dsize_t index - the row of the feature tensor
+  // @param std::shared_ptr<Tensor> *fea_tensor - the feature tensor
+  // @return Status The status code returned
+  Status InsertCsrFeature(const uint8_t *data, size_t size, const std::shared_ptr<Feature> &default_feature,
+                          dsize_t index, std::shared_ptr<Tensor> *fea_tensor);
+
+  // Copy the shared memory offset and length of the feature from the CSR graph, -1 if data is null
+  // @param const uint8_t *data - the feature data
+  // @param size_t size - size of the feature data in bytes
+  // @param Tensor::TensorIterator<int64_t> *out_fea_itr - the output position
+  // @return Status The status code returned
+  Status InsertCsrFeatureSharedMemory(const uint8_t *data, size_t size, Tensor::TensorIterator<int64_t> *out_fea_itr);
+
   // Negative sampling
   // @param std::vector<NodeIdType> &input_data - The data set to be sampled
   // @param std::unordered_set<NodeIdType> &exclude_data - Data to be excluded
@@ -275,6 +344,9 @@ class GraphDataImpl : public GraphData {
   RandomWalkBase random_walk_;
   mindrecord::json data_schema_;
   bool server_mode_;
+  GraphStorageFormat storage_format_;
+  // Only created in CSR storage format, the node and edge objects are not created then
+  std::unique_ptr<CsrGraph> csr_graph_;
 #if !defined(_WIN32) && !defined(_WIN64)
   std::unique_ptr<GraphSharedMemory> graph_shared_memory_;
 #endif
@@ -26,6 +26,7 @@
 #include "minddata/dataset/engine/gnn/graph_data_service_impl.h"
 #include "minddata/dataset/engine/gnn/grpc_async_server.h"
 #endif
+#include "minddata/dataset/engine/gnn/graph_data.h"
 #include "minddata/dataset/util/task_manager.h"
 
 namespace mindspore {
@@ -38,7 +39,8 @@ class GraphDataServer {
  public:
   enum ServerState { kGdsUninit = 0, kGdsInitializing, kGdsRunning, kGdsStopped };
   GraphDataServer(const std::string &dataset_file, int32_t num_workers, const std::string &hostname, int32_t port,
-                  int32_t client_num, bool auto_shutdown);
+                  int32_t client_num, bool auto_shutdown,
+                  GraphStorageFormat storage_format = GraphStorageFormat::kDefault);
   ~GraphDataServer() = default;
 
   Status Init();
@@ -19,6 +19,7 @@
 #include <tuple>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/csr_graph.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 #include "minddata/dataset/engine/gnn/local_edge.h"
 #include "minddata/dataset/engine/gnn/local_node.h"
@@ -44,6 +45,9 @@ GraphLoader::GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int
       optional_key_({{"weight", false}}) {}
 
 Status GraphLoader::GetNodesAndEdges() {
+  if (graph_impl_->csr_graph_ != nullptr) {
+    return BuildCsrGraph();
+  }
   NodeIdMap *n_id_map = &graph_impl_->node_id_map_;
   EdgeIdMap *e_id_map = &graph_impl_->edge_id_map_;
   for (std::deque<std::shared_ptr<Node>> &dq : n_deques_) {
@@ -82,11 +86,41 @@ Status GraphLoader::GetNodesAndEdges() {
   return Status::OK();
 }
 
+Status GraphLoader::BuildCsrGraph() {
+  CsrGraph *csr_graph = graph_impl_->csr_graph_.get();
+  for (std::deque<NodeRecord> &dq : n_records_) {
+    while (dq.empty() == false) {
+      NodeRecord &node = dq.front();
+      RETURN_IF_NOT_OK(csr_graph->AddNode(node.id, node.type, node.features));
+      graph_impl_->node_type_map_[node.type].push_back(node.id);
+      dq.pop_front();
+    }
+  }
+
+  for (std::deque<EdgeRecord> &dq : e_records_) {
+    while (dq.empty() == false) {
+      EdgeRecord &edge = dq.front();
+      RETURN_IF_NOT_OK(csr_graph->AddEdge(edge.id, edge.type, edge.weight, edge.src_id, edge.dst_id, edge.features));
+      graph_impl_->edge_type_map_[edge.type].push_back(edge.id);
+      dq.pop_front();
+    }
+  }
+  RETURN_IF_NOT_OK(csr_graph->Build());
+
+  for (auto &itr : graph_impl_->node_type_map_) itr.second.shrink_to_fit();
+  for (auto &itr : graph_impl_->edge_type_map_) itr.second.shrink_to_fit();
+
+  MergeFeatureMaps();
+  return Status::OK();
+}
+
 Status GraphLoader::InitAndLoad() {
   CHECK_FAIL_RETURN_UNEXPECTED(num_workers_ > 0, "num_reader can't be < 1\n");
   CHECK_FAIL_RETURN_UNEXPECTED(row_id_ == 0, "InitAndLoad Can only be called once!\n");
   n_deques_.resize(num_workers_);
   e_deques_.resize(num_workers_);
+  n_records_.resize(num_workers_);
+  e_records_.resize(num_workers_);
   n_feature_maps_.resize(num_workers_);
   e_feature_maps_.resize(num_workers_);
   default_node_feature_maps_.resize(num_workers_);
@@ -133,105 +167,84 @@ Status GraphLoader::InitAndLoad() {
   return Status::OK();
 }
 
-Status GraphLoader::LoadNode(const std::vector<uint8_t> &col_blob, const mindrecord::json &col_jsn,
-                             std::shared_ptr<Node> *node, NodeFeatureMap *feature_map,
-                             DefaultNodeFeatureMap *default_feature) {
-  NodeIdType node_id = col_jsn["first_id"];
-  NodeType node_type = static_cast<NodeType>(col_jsn["type"]);
-  WeightType weight = 1;
-  if (optional_key_["weight"]) {
-    weight = col_jsn["weight"];
-  }
-  (*node) = std::make_shared<LocalNode>(node_id, node_type, weight);
+Status GraphLoader::LoadFeatures(const std::string &prefix, const std::vector<uint8_t> &col_blob,
+                                 std::unordered_set<FeatureType> *feature_set, DefaultFeatureMap *default_feature,
+                                 std::vector<std::shared_ptr<Feature>> *features) {
   std::vector<int32_t> indices;
-  RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureIndex("node_feature_index", col_blob, &indices));
-  if (graph_impl_->server_mode_) {
+  RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureIndex(prefix + "_index", col_blob, &indices));
+  for (int32_t ind : indices) {
+    const std::string key = prefix + "_" + std::to_string(ind);
+    std::shared_ptr<Tensor> tensor;
+    if (graph_impl_->server_mode_) {
 #if !defined(_WIN32) && !defined(_WIN64)
-    for (int32_t ind : indices) {
       std::shared_ptr<Tensor> tensor_sm;
       RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureToSharedMemory(
-        "node_feature_" + std::to_string(ind), col_blob, graph_impl_->graph_shared_memory_.get(), &tensor_sm));
-      RETURN_IF_NOT_OK((*node)->UpdateFeature(std::make_shared<Feature>(ind, tensor_sm, true)));
-      (*feature_map)[node_type].insert(ind);
+        key, col_blob, graph_impl_->graph_shared_memory_.get(), &tensor_sm));
+      features->push_back(std::make_shared<Feature>(ind, tensor_sm, true));
       if ((*default_feature)[ind] == nullptr) {
-        std::shared_ptr<Tensor> tensor;
-        RETURN_IF_NOT_OK(
-          graph_feature_parser_->LoadFeatureTensor("node_feature_" + std::to_string(ind), col_blob, &tensor));
-        std::shared_ptr<Tensor> zero_tensor;
-        RETURN_IF_NOT_OK(Tensor::CreateEmpty(tensor->shape(), tensor->type(), &zero_tensor));
-        RETURN_IF_NOT_OK(zero_tensor->Zero());
-        (*default_feature)[ind] = std::make_shared<Feature>(ind, zero_tensor);
+        RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureTensor(key, col_blob, &tensor));
       }
-    }
+#else
+      continue;
 #endif
-  } else {
-    for (int32_t ind : indices) {
-      std::shared_ptr<Tensor> tensor;
-      RETURN_IF_NOT_OK(
-        graph_feature_parser_->LoadFeatureTensor("node_feature_" + std::to_string(ind), col_blob, &tensor));
-      RETURN_IF_NOT_OK((*node)->UpdateFeature(std::make_shared<Feature>(ind, tensor)));
-      (*feature_map)[node_type].insert(ind);
-      if ((*default_feature)[ind] == nullptr) {
-        std::shared_ptr<Tensor> zero_tensor;
-        RETURN_IF_NOT_OK(Tensor::CreateEmpty(tensor->shape(), tensor->type(), &zero_tensor));
-        RETURN_IF_NOT_OK(zero_tensor->Zero());
-        (*default_feature)[ind] = std::make_shared<Feature>(ind, zero_tensor);
-      }
+    } else {
+      RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureTensor(key, col_blob, &tensor));
+      features->push_back(std::make_shared<Feature>(ind, tensor));
     }
+    feature_set->insert(ind);
+    if ((*default_feature)[ind] == nullptr) {
+      std::shared_ptr<Tensor> zero_tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(tensor->shape(), tensor->type(), &zero_tensor));
+      RETURN_IF_NOT_OK(zero_tensor->Zero());
+      (*default_feature)[ind] = std::make_shared<Feature>(ind, zero_tensor);
+    }
+  }
+  return Status::OK();
+}
+
+Status GraphLoader::LoadNode(const std::vector<uint8_t> &col_blob, const mindrecord::json &col_jsn,
+                             NodeRecord *node, NodeFeatureMap *feature_map, DefaultNodeFeatureMap *default_feature) {
+  node->id = col_jsn["first_id"];
+  node->type = static_cast<NodeType>(col_jsn["type"]);
+  node->weight = 1;
+  if (optional_key_["weight"]) {
+    node->weight = col_jsn["weight"];
   }
+  RETURN_IF_NOT_OK(
+    LoadFeatures("node_feature", col_blob, &(*feature_map)[node->type], default_feature, &node->features));
   return Status::OK();
 }
 
 Status GraphLoader::LoadEdge(const std::vector<uint8_t> &col_blob, const mindrecord::json &col_jsn,
-                             std::shared_ptr<Edge> *edge, EdgeFeatureMap *feature_map,
-                             DefaultEdgeFeatureMap *default_feature) {
-  EdgeIdType edge_id = col_jsn["first_id"];
-  EdgeType edge_type = static_cast<EdgeType>(col_jsn["type"]);
-  NodeIdType src_id = col_jsn["second_id"], dst_id = col_jsn["third_id"];
-  WeightType edge_weight = 1;
+                             EdgeRecord *edge, EdgeFeatureMap *feature_map, DefaultEdgeFeatureMap *default_feature) {
+  edge->id = col_jsn["first_id"];
+  edge->type = static_cast<EdgeType>(col_jsn["type"]);
+  edge->src_id = col_jsn["second_id"];
+  edge->dst_id = col_jsn["third_id"];
+  edge->weight = 1;
   if (optional_key_["weight"]) {
-    edge_weight = col_jsn["weight"];
+    edge->weight = col_jsn["weight"];
   }
-  std::shared_ptr<Node> src = std::make_shared<LocalNode>(src_id, -1, 1);
-  std::shared_ptr<Node> dst = std::make_shared<LocalNode>(dst_id, -1, 1);
-  (*edge) = std::make_shared<LocalEdge>(edge_id, edge_type, edge_weight, src, dst);
-  std::vector<int32_t> indices;
-  RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureIndex("edge_feature_index", col_blob, &indices));
-  if (graph_impl_->server_mode_) {
-#if !defined(_WIN32) && !defined(_WIN64)
-    for (int32_t ind : indices) {
-      std::shared_ptr<Tensor> tensor_sm;
-      RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureToSharedMemory(
-        "edge_feature_" + std::to_string(ind), col_blob, graph_impl_->graph_shared_memory_.get(), &tensor_sm));
-      RETURN_IF_NOT_OK((*edge)->UpdateFeature(std::make_shared<Feature>(ind, tensor_sm, true)));
-      (*feature_map)[edge_type].insert(ind);
-      if ((*default_feature)[ind] == nullptr) {
-        std::shared_ptr<Tensor> tensor;
-        RETURN_IF_NOT_OK(
-          graph_feature_parser_->LoadFeatureTensor("edge_feature_" + std::to_string(ind), col_blob, &tensor));
-        std::shared_ptr<Tensor> zero_tensor;
-        RETURN_IF_NOT_OK(Tensor::CreateEmpty(tensor->shape(), tensor->type(), &zero_tensor));
-        RETURN_IF_NOT_OK(zero_tensor->Zero());
-        (*default_feature)[ind] = std::make_shared<Feature>(ind, zero_tensor);
-      }
-    }
-#endif
-  } else {
-    for (int32_t ind : indices) {
-      std::shared_ptr<Tensor> tensor;
-      RETURN_IF_NOT_OK(
-        graph_feature_parser_->LoadFeatureTensor("edge_feature_" + std::to_string(ind), col_blob, &tensor));
-      RETURN_IF_NOT_OK((*edge)->UpdateFeature(std::make_shared<Feature>(ind, tensor)));
-      (*feature_map)[edge_type].insert(ind);
-      if ((*default_feature)[ind] == nullptr) {
-        std::shared_ptr<Tensor> zero_tensor;
-        RETURN_IF_NOT_OK(Tensor::CreateEmpty(tensor->shape(), tensor->type(), &zero_tensor));
-        RETURN_IF_NOT_OK(zero_tensor->Zero());
-        (*default_feature)[ind] = std::make_shared<Feature>(ind, zero_tensor);
-      }
-    }
+  RETURN_IF_NOT_OK(
+    LoadFeatures("edge_feature", col_blob, &(*feature_map)[edge->type], default_feature, &edge->features));
+  return Status::OK();
+}
+
+Status GraphLoader::CreateNode(const NodeRecord &record, std::shared_ptr<Node> *node) {
+  (*node) = std::make_shared<LocalNode>(record.id, record.type, record.weight);
+  for (const auto &feature : record.features) {
+    RETURN_IF_NOT_OK((*node)->UpdateFeature(feature));
   }
+  return Status::OK();
+}
 
+Status GraphLoader::CreateEdge(const EdgeRecord &record, std::shared_ptr<Edge> *edge) {
+  std::shared_ptr<Node> src = std::make_shared<LocalNode>(record.src_id, -1, 1);
+  std::shared_ptr<Node> dst = std::make_shared<LocalNode>(record.dst_id, -1, 1);
+  (*edge) = std::make_shared<LocalEdge>(record.id, record.type, record.weight, src, dst);
+  for (const auto &feature : record.features) {
+    RETURN_IF_NOT_OK((*edge)->UpdateFeature(feature));
+  }
   return Status::OK();
 }
 
@@ -247,15 +260,28 @@ Status GraphLoader::WorkerEntry(int32_t worker_id) {
       mindrecord::json col_jsn = std::get<1>(tupled_row);
       std::string attr = col_jsn["attribute"];
       if (attr == "n") {
-        std::shared_ptr<Node> node_ptr;
-        RETURN_IF_NOT_OK(LoadNode(col_blob, col_jsn, &node_ptr, &(n_feature_maps_[worker_id]),
+        NodeRecord node;
+        RETURN_IF_NOT_OK(LoadNode(col_blob, col_jsn, &node, &(n_feature_maps_[worker_id]),
                                   &default_node_feature_maps_[worker_id]));
-        n_deques_[worker_id].emplace_back(node_ptr);
+        if (graph_impl_->csr_graph_ != nullptr) {
+          // The node objects are not created for the CSR graph
+          n_records_[worker_id].emplace_back(std::move(node));
+        } else {
+          std::shared_ptr<Node> node_ptr;
+          RETURN_IF_NOT_OK(CreateNode(node, &node_ptr));
+          n_deques_[worker_id].emplace_back(node_ptr);
+        }
       } else if (attr == "e") {
-        std::shared_ptr<Edge> edge_ptr;
-        RETURN_IF_NOT_OK(LoadEdge(col_blob, col_jsn, &edge_ptr, &(e_feature_maps_[worker_id]),
+        EdgeRecord edge;
+        RETURN_IF_NOT_OK(LoadEdge(col_blob, col_jsn, &edge, &(e_feature_maps_[worker_id]),
                                   &default_edge_feature_maps_[worker_id]));
-        e_deques_[worker_id].emplace_back(edge_ptr);
+        if (graph_impl_->csr_graph_ != nullptr) {
+          e_records_[worker_id].emplace_back(std::move(edge));
+        } else {
+          std::shared_ptr<Edge> edge_ptr;
+          RETURN_IF_NOT_OK(CreateEdge(edge, &edge_ptr));
+          e_deques_[worker_id].emplace_back(edge_ptr);
+        }
       } else {
         MS_LOG(WARNING) << "attribute:" << attr << " is neither edge nor node.";
       }
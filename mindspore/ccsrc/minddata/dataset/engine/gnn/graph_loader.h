@@ -47,8 +47,9 @@ using NodeTypeMap = std::unordered_map<NodeType, std::vector<NodeIdType>>;
 using EdgeTypeMap = std::unordered_map<EdgeType, std::vector<EdgeIdType>>;
 using NodeFeatureMap = std::unordered_map<NodeType, std::unordered_set<FeatureType>>;
 using EdgeFeatureMap = std::unordered_map<EdgeType, std::unordered_set<FeatureType>>;
-using DefaultNodeFeatureMap = std::unordered_map<FeatureType, std::shared_ptr<Feature>>;
-using DefaultEdgeFeatureMap = std::unordered_map<FeatureType, std::shared_ptr<Feature>>;
+using DefaultFeatureMap = std::unordered_map<FeatureType, std::shared_ptr<Feature>>;
+using DefaultNodeFeatureMap = DefaultFeatureMap;
+using DefaultEdgeFeatureMap = DefaultFeatureMap;
 
 // this class interfaces with the underlying storage format (mindrecord)
 // it returns raw nodes and edges via GetNodesAndEdges
@@ -76,25 +77,64 @@ class GraphLoader {
   // @return Status - the status code
   Status WorkerEntry(int32_t worker_id);
 
-  // Load a node based on 1 row of mindrecord, returns a shared_ptr<Node>
+  // The raw node and edge read from the mindrecord. They are turned into the node and edge objects, or added to the
+  // CSR graph directly without creating the objects.
+  struct NodeRecord {
+    NodeIdType id;
+    NodeType type;
+    WeightType weight;
+    std::vector<std::shared_ptr<Feature>> features;
+  };
+
+  struct EdgeRecord {
+    EdgeIdType id;
+    EdgeType type;
+    WeightType weight;
+    NodeIdType src_id;
+    NodeIdType dst_id;
+    std::vector<std::shared_ptr<Feature>> features;
+  };
+
+  // Load a node based on 1 row of mindrecord
   // @param std::vector<uint8_t> &blob - contains data in blob field in mindrecord
   // @param mindrecord::json &jsn - contains raw data
-  // @param std::shared_ptr<Node> *node - return value
+  // @param NodeRecord *node - return value
   // @param NodeFeatureMap *feature_map -
   // @param DefaultNodeFeatureMap *default_feature -
   // @return Status - the status code
-  Status LoadNode(const std::vector<uint8_t> &blob, const mindrecord::json &jsn, std::shared_ptr<Node> *node,
+  Status LoadNode(const std::vector<uint8_t> &blob, const mindrecord::json &jsn, NodeRecord *node,
                   NodeFeatureMap *feature_map, DefaultNodeFeatureMap *default_feature);
 
   // @param std::vector<uint8_t> &blob - contains data in blob field in mindrecord
   // @param mindrecord::json &jsn - contains raw data
-  // @param std::shared_ptr<Edge> *edge - return value, the edge ptr, edge is not yet connected
+  // @param EdgeRecord *edge - return value, the edge is not yet connected
   // @param FeatureMap *feature_map
   // @param DefaultEdgeFeatureMap *default_feature -
   // @return Status - the status code
-  Status LoadEdge(const std::vector<uint8_t> &blob, const mindrecord::json &jsn, std::shared_ptr<Edge> *edge,
+  Status LoadEdge(const std::vector<uint8_t> &blob, const mindrecord::json &jsn, EdgeRecord *edge,
                   EdgeFeatureMap *feature_map, DefaultEdgeFeatureMap *default_feature);
 
+  // Load the node or edge features, the features are put into shared memory in server mode
+  // @param std::string &prefix - prefix of the feature column, node_feature or edge_feature
+  // @param std::vector<uint8_t> &blob - contains data in blob field in mindrecord
+  // @param std::unordered_set<FeatureType> *feature_set - feature types of the node type or edge type
+  // @param DefaultFeatureMap *default_feature -
+  // @param std::vector<std::shared_ptr<Feature>> *features - return value
+  // @return Status - the status code
+  Status LoadFeatures(const std::string &prefix, const std::vector<uint8_t> &blob,
+                      std::unordered_set<FeatureType> *feature_set, DefaultFeatureMap *default_feature,
+                      std::vector<std::shared_ptr<Feature>> *features);
+
+  // Create a node object, returns a shared_ptr<Node>
+  Status CreateNode(const NodeRecord &record, std::shared_ptr<Node> *node);
+
+  // Create an edge object, src_node and dst_node in Edge are node_id only with -1 as type
+  Status CreateEdge(const EdgeRecord &record, std::shared_ptr<Edge> *edge);
+
+  // Add all the loaded nodes and edges to the CSR graph of GraphDataImpl and build it
+  // @return Status - the status code
+  Status BuildCsrGraph();
+
   // merge NodeFeatureMap and EdgeFeatureMap of each worker into 1
   void MergeFeatureMaps();
 
@@ -106,6 +146,8 @@ class GraphLoader {
   std::unique_ptr<GraphFeatureParser> graph_feature_parser_;
   std::vector<std::deque<std::shared_ptr<Node>>> n_deques_;
   std::vector<std::deque<std::shared_ptr<Edge>>> e_deques_;
+  std::vector<std::deque<NodeRecord>> n_records_;
+  std::vector<std::deque<EdgeRecord>> e_records_;
   std::vector<NodeFeatureMap> n_feature_maps_;
   std::vector<EdgeFeatureMap> e_feature_maps_;
   std::vector<DefaultNodeFeatureMap> default_node_feature_maps_;
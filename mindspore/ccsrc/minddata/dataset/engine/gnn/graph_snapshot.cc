@@ -0,0 +1,215 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_snapshot.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <cstdio>
+#include <cstring>
+
+#include "minddata/dataset/util/log_adapter.h"
+#include "utils/file_utils.h"
+#include "./securec.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+namespace {
+struct SnapshotHeader {
+  char magic[kSnapshotMagicSize];
+  uint32_t version;
+  uint32_t endian_tag;
+  uint64_t directory_offset;
+  uint64_t block_num;
+};
+
+template <typename T>
+Status ReadValue(const uint8_t *src, T *value) {
+  CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(value, sizeof(T), src, sizeof(T)) == EOK, "Failed to read graph snapshot.");
+  return Status::OK();
+}
+}  // namespace
+
+GraphSnapshotWriter::GraphSnapshotWriter(const std::string &path)
+    : path_(path), tmp_path_(path + ".tmp"), offset_(0), closed_(false) {}
+
+GraphSnapshotWriter::~GraphSnapshotWriter() {
+  if (!closed_ && file_.is_open()) {
+    file_.close();
+    (void)std::remove(tmp_path_.c_str());
+  }
+}
+
+Status GraphSnapshotWriter::Open() {
+  file_.open(tmp_path_, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(file_.is_open(), "Failed to create graph snapshot file: " + tmp_path_);
+  // The header is rewritten with the directory offset when the snapshot is closed.
+  SnapshotHeader header{};
+  file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  offset_ = sizeof(header);
+  CHECK_FAIL_RETURN_UNEXPECTED(file_.good(), "Failed to write graph snapshot file: " + tmp_path_);
+  return Status::OK();
+}
+
+Status GraphSnapshotWriter::WriteBlock(const std::string &name, const void *data, size_t size) {
+  CHECK_FAIL_RETURN_UNEXPECTED(file_.is_open() && !closed_, "Graph snapshot file is not opened.");
+  CHECK_FAIL_RETURN_UNEXPECTED(data != nullptr || size == 0, "The data of snapshot block is null: " + name);
+  uint64_t padding = (kSnapshotAlignment - offset_ % kSnapshotAlignment) % kSnapshotAlignment;
+  if (padding > 0) {
+    const char zeros[kSnapshotAlignment] = {0};
+    file_.write(zeros, static_cast<std::streamsize>(padding));
+    offset_ += padding;
+  }
+  if (size > 0) {
+    file_.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(file_.good(), "Failed to write graph snapshot block: " + name);
+  blocks_.emplace_back(name, std::make_pair(offset_, static_cast<uint64_t>(size)));
+  offset_ += size;
+  return Status::OK();
+}
+
+Status GraphSnapshotWriter::Close() {
+  CHECK_FAIL_RETURN_UNEXPECTED(file_.is_open() && !closed_, "Graph snapshot file is not opened.");
+  SnapshotHeader header{};
+  CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(header.magic, kSnapshotMagicSize, kSnapshotMagic, kSnapshotMagicSize) == EOK,
+                               "Failed to write graph snapshot header.");
+  header.version = kSnapshotVersion;
+  header.endian_tag = kSnapshotEndianTag;
+  header.directory_offset = offset_;
+  header.block_num = blocks_.size();
+  for (const auto &block : blocks_) {
+    auto name_size = static_cast<uint32_t>(block.first.size());
+    file_.write(reinterpret_cast<const char *>(&block.second.first), sizeof(uint64_t));
+    file_.write(reinterpret_cast<const char *>(&block.second.second), sizeof(uint64_t));
+    file_.write(reinterpret_cast<const char *>(&name_size), sizeof(name_size));
+    file_.write(block.first.data(), name_size);
+  }
+  (void)file_.seekp(0);
+  file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file_.close();
+  closed_ = true;
+  CHECK_FAIL_RETURN_UNEXPECTED(!file_.fail(), "Failed to write graph snapshot file: " + tmp_path_);
+  if (std::rename(tmp_path_.c_str(), path_.c_str()) != 0) {
+    (void)std::remove(tmp_path_.c_str());
+    RETURN_STATUS_UNEXPECTED("Failed to rename graph snapshot file to: " + path_);
+  }
+  MS_LOG(INFO) << "Graph snapshot is saved to " << path_ << ", size:" << offset_ << " bytes.";
+  return Status::OK();
+}
+
+GraphSnapshotReader::GraphSnapshotReader(const std::string &path) : path_(path), data_(nullptr), size_(0) {}
+
+GraphSnapshotReader::~GraphSnapshotReader() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr && buffer_ == nullptr) {
+    (void)munmap(const_cast<uint8_t *>(data_), size_);
+  }
+#endif
+  data_ = nullptr;
+}
+
+bool GraphSnapshotReader::IsSnapshot(const std::string &path) {
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  char magic[kSnapshotMagicSize] = {0};
+  (void)file.read(magic, kSnapshotMagicSize);
+  return file.gcount() == static_cast<std::streamsize>(kSnapshotMagicSize) &&
+         memcmp(magic, kSnapshotMagic, kSnapshotMagicSize) == 0;
+}
+
+Status GraphSnapshotReader::Open() {
+  CHECK_FAIL_RETURN_UNEXPECTED(data_ == nullptr, "Graph snapshot is already opened: " + path_);
+  auto realpath = FileUtils::GetRealPath(path_.c_str());
+  CHECK_FAIL_RETURN_UNEXPECTED(realpath.has_value(), "Get real path failed, path=" + path_);
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(common::SafeCStr(realpath.value()), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Failed to open graph snapshot file: " + path_);
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED("Invalid graph snapshot file: " + path_);
+  }
+  size_ = static_cast<size_t>(file_stat.st_size);
+  void *addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED(addr != MAP_FAILED, "Failed to map graph snapshot file: " + path_);
+  data_ = static_cast<const uint8_t *>(addr);
+#else
+  std::ifstream file(realpath.value(), std::ios::in | std::ios::binary | std::ios::ate);
+  CHECK_FAIL_RETURN_UNEXPECTED(file.is_open(), "Failed to open graph snapshot file: " + path_);
+  size_ = static_cast<size_t>(file.tellg());
+  CHECK_FAIL_RETURN_UNEXPECTED(size_ >= sizeof(SnapshotHeader), "Invalid graph snapshot file: " + path_);
+  buffer_ = std::make_unique<uint8_t[]>(size_);
+  (void)file.seekg(0);
+  (void)file.read(reinterpret_cast<char *>(buffer_.get()), static_cast<std::streamsize>(size_));
+  CHECK_FAIL_RETURN_UNEXPECTED(file.good(), "Failed to read graph snapshot file: " + path_);
+  data_ = buffer_.get();
+#endif
+
+  SnapshotHeader header{};
+  RETURN_IF_NOT_OK(ReadValue(data_, &header));
+  CHECK_FAIL_RETURN_UNEXPECTED(memcmp(header.magic, kSnapshotMagic, kSnapshotMagicSize) == 0,
+                               "Invalid magic of graph snapshot file: " + path_);
+  CHECK_FAIL_RETURN_UNEXPECTED(header.version == kSnapshotVersion,
+                               "Unsupported graph snapshot version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(kSnapshotVersion) + ", file: " + path_);
+  CHECK_FAIL_RETURN_UNEXPECTED(header.endian_tag == kSnapshotEndianTag,
+                               "The byte order of graph snapshot file is not supported: " + path_);
+  CHECK_FAIL_RETURN_UNEXPECTED(header.directory_offset <= size_, "Invalid directory of graph snapshot: " + path_);
+  uint64_t pos = header.directory_offset;
+  const uint64_t kEntryHeadSize = sizeof(uint64_t) * 2 + sizeof(uint32_t);
+  for (uint64_t i = 0; i < header.block_num; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(pos + kEntryHeadSize <= size_, "Invalid directory of graph snapshot: " + path_);
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    uint32_t name_size = 0;
+    RETURN_IF_NOT_OK(ReadValue(data_ + pos, &offset));
+    RETURN_IF_NOT_OK(ReadValue(data_ + pos + sizeof(offset), &size));
+    RETURN_IF_NOT_OK(ReadValue(data_ + pos + sizeof(offset) + sizeof(size), &name_size));
+    pos += kEntryHeadSize;
+    // The blocks are aligned by the writer, so they can be read as the arrays of any type. The sum of offset and
+    // size is not computed, it can overflow.
+    CHECK_FAIL_RETURN_UNEXPECTED(pos + name_size <= size_ && offset % kSnapshotAlignment == 0 &&
+                                   offset <= header.directory_offset && size <= header.directory_offset - offset,
+                                 "Invalid directory of graph snapshot: " + path_);
+    std::string name(reinterpret_cast<const char *>(data_ + pos), name_size);
+    pos += name_size;
+    blocks_[name] = std::make_pair(offset, size);
+  }
+  MS_LOG(INFO) << "Graph snapshot is opened: " << path_ << ", block num:" << blocks_.size();
+  return Status::OK();
+}
+
+Status GraphSnapshotReader::GetBlock(const std::string &name, const void **data, size_t *size) const {
+  RETURN_UNEXPECTED_IF_NULL(data);
+  RETURN_UNEXPECTED_IF_NULL(size);
+  auto itr = blocks_.find(name);
+  CHECK_FAIL_RETURN_UNEXPECTED(itr != blocks_.end(), "Block " + name + " does not exist in graph snapshot " + path_);
+  *data = data_ + itr->second.first;
+  *size = static_cast<size_t>(itr->second.second);
+  return Status::OK();
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_SNAPSHOT_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_SNAPSHOT_H_
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+// The snapshot file layout:
+//   header    | magic "MSGNNSNP" | uint32 version | uint32 endian tag | uint64 directory offset | uint64 block number |
+//   blocks    | each block starts at a kSnapshotAlignment aligned offset
+//   directory | per block: uint64 offset | uint64 size | uint32 name length | name
+// The blocks are written with the native byte order, the endian tag is checked when the snapshot is opened.
+constexpr char kSnapshotMagic[] = "MSGNNSNP";
+constexpr size_t kSnapshotMagicSize = 8;
+constexpr uint32_t kSnapshotVersion = 1;
+constexpr uint32_t kSnapshotEndianTag = 0x01020304;
+constexpr size_t kSnapshotAlignment = 64;
+
+// Write the named blocks of a graph into a snapshot file. The file is written to a temporary path first and renamed
+// when it is closed, so a half written snapshot is never loaded.
+class GraphSnapshotWriter {
+ public:
+  explicit GraphSnapshotWriter(const std::string &path);
+
+  ~GraphSnapshotWriter();
+
+  // @return Status The status code returned
+  Status Open();
+
+  // Write a block, the name must be unique in the snapshot
+  // @param std::string &name - name of the block
+  // @param void *data - data of the block
+  // @param size_t size - size of the block in bytes
+  // @return Status The status code returned
+  Status WriteBlock(const std::string &name, const void *data, size_t size);
+
+  template <typename T>
+  Status Write(const std::string &name, const T *data, size_t count) {
+    return WriteBlock(name, data, count * sizeof(T));
+  }
+
+  template <typename T>
+  Status Write(const std::string &name, const std::vector<T> &values) {
+    return WriteBlock(name, values.data(), values.size() * sizeof(T));
+  }
+
+  // Write the directory and rename the temporary file to the snapshot path
+  // @return Status The status code returned
+  Status Close();
+
+ private:
+  std::string path_;
+  std::string tmp_path_;
+  std::ofstream file_;
+  uint64_t offset_;
+  std::vector<std::pair<std::string, std::pair<uint64_t, uint64_t>>> blocks_;
+  bool closed_;
+};
+
+// Map a snapshot file into memory and look up its blocks by name. The blocks stay valid while the reader is alive,
+// and the mapped pages are shared by all the processes loading the same snapshot through the page cache.
+class GraphSnapshotReader {
+ public:
+  explicit GraphSnapshotReader(const std::string &path);
+
+  ~GraphSnapshotReader();
+
+  // Check whether the file is a graph snapshot by its magic
+  // @param std::string &path - path of the file
+  // @return bool - whether it is a snapshot
+  static bool IsSnapshot(const std::string &path);
+
+  // @return Status The status code returned
+  Status Open();
+
+  // @param std::string &name - name of the block
+  // @return bool - whether the block exists
+  bool HasBlock(const std::string &name) const { return blocks_.find(name) != blocks_.end(); }
+
+  // Get a block, an error is returned if it does not exist
+  // @param std::string &name - name of the block
+  // @param void **data - returned data of the block
+  // @param size_t *size - returned size of the block in bytes
+  // @return Status The status code returned
+  Status GetBlock(const std::string &name, const void **data, size_t *size) const;
+
+  template <typename T>
+  Status Get(const std::string &name, const T **data, size_t *count) const {
+    const void *block = nullptr;
+    size_t size = 0;
+    RETURN_IF_NOT_OK(GetBlock(name, &block, &size));
+    CHECK_FAIL_RETURN_UNEXPECTED(size % sizeof(T) == 0, "Invalid size of snapshot block: " + name);
+    *data = static_cast<const T *>(block);
+    *count = size / sizeof(T);
+    return Status::OK();
+  }
+
+  template <typename T>
+  Status Get(const std::string &name, std::vector<T> *values) const {
+    const T *data = nullptr;
+    size_t count = 0;
+    RETURN_IF_NOT_OK(Get(name, &data, &count));
+    values->assign(data, data + count);
+    return Status::OK();
+  }
+
+ private:
+  std::string path_;
+  const uint8_t *data_;
+  size_t size_;
+  // Only used if the file can not be mapped
+  std::unique_ptr<uint8_t[]> buffer_;
+  std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> blocks_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_SNAPSHOT_H_
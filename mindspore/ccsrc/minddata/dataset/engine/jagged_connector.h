@@ -16,17 +16,71 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_JAGGED_CONNECTOR_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_JAGGED_CONNECTOR_H_
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/engine/connector.h"
+#include "minddata/dataset/engine/lock_free_connector.h"
 
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/include/dataset/constants.h"
 
 namespace mindspore {
 namespace dataset {
+// The lock free version of JaggedConnector, the queues of the producers which have sent EOE are skipped in the same way
+class LockFreeJaggedConnector : public LockFreeConnector<TensorRow> {
+ public:
+  LockFreeJaggedConnector(int32_t num_producers, int32_t num_consumers, int32_t queue_capacity)
+      : LockFreeConnector<TensorRow>(num_producers, num_consumers, queue_capacity),
+        is_queue_finished_(num_producers, false) {}
+
+  ~LockFreeJaggedConnector() override = default;
+
+  Status Pop(int32_t worker_id, TensorRow *result) noexcept {
+    RETURN_UNEXPECTED_IF_NULL(result);
+    MS_ASSERT(worker_id < num_consumers_);
+    RETURN_IF_NOT_OK(WaitForTurn(worker_id));
+    if (is_queue_finished_[pop_from_]) {
+      std::string errMsg = "ERROR: popping from a finished queue in JaggedConnector";
+      RETURN_STATUS_UNEXPECTED(errMsg);
+    }
+    SpinBackoff backoff;
+    while (!queues_[pop_from_]->TryPop(result)) {
+      RETURN_IF_INTERRUPTED();
+      backoff.Pause();
+    }
+    if (result->eoe()) {
+      is_queue_finished_[pop_from_] = true;
+    }
+    for (int offset = 1; offset <= num_producers_; offset++) {
+      size_t nextQueueIndex = (pop_from_ + offset) % num_producers_;
+      if (!is_queue_finished_[nextQueueIndex]) {
+        pop_from_ = nextQueueIndex;
+        break;
+      }
+    }
+    out_buffers_count_.fetch_add(1, std::memory_order_relaxed);
+    expect_consumer_.store((worker_id + 1) % num_consumers_, std::memory_order_release);
+    return Status::OK();
+  }
+
+  void DoReset() {
+    std::fill(is_queue_finished_.begin(), is_queue_finished_.end(), false);
+    LockFreeConnector<TensorRow>::Reset();
+  }
+
+ private:
+  std::vector<bool> is_queue_finished_;
+};
+
+// The connector between the workers and the master thread of the non-mappable leaf ops. A worker sends the rows of a
+// file and then an EOE, and the queue of the worker is skipped after its EOE is popped. The rows are passed with
+// LockFreeJaggedConnector if enable_lock_free_connector is set in the config.
 class JaggedConnector : public Connector<TensorRow> {
  public:
   JaggedConnector(int32_t num_producers, int32_t num_consumers, int32_t queue_capacity)
@@ -34,15 +88,24 @@ class JaggedConnector : public Connector<TensorRow> {
     for (int i = 0; i < num_producers; i++) {
       is_queue_finished_.push_back(false);
     }
+    if (GlobalContext::config_manager()->enable_lock_free_connector()) {
+      lock_free_connector_ = std::make_unique<LockFreeJaggedConnector>(num_producers, num_consumers, queue_capacity);
+    }
   }
 
   ~JaggedConnector() = default;
 
   Status Add(int32_t worker_d, TensorRow &&element) noexcept {
+    if (lock_free_connector_ != nullptr) {
+      return lock_free_connector_->Push(worker_d, std::move(element));
+    }
     return Connector<TensorRow>::Push(worker_d, std::move(element));
   }
 
   Status Pop(int32_t worker_id, TensorRow *result) noexcept override {
+    if (lock_free_connector_ != nullptr) {
+      return lock_free_connector_->Pop(worker_id, result);
+    }
     RETURN_UNEXPECTED_IF_NULL(result);
     {
       MS_ASSERT(worker_id < num_consumers_);
@@ -74,6 +137,10 @@ class JaggedConnector : public Connector<TensorRow> {
   }
 
   void DoReset() {
+    if (lock_free_connector_ != nullptr) {
+      lock_free_connector_->DoReset();
+      return;
+    }
     for (auto i = 0; i < is_queue_finished_.size(); i++) {
       is_queue_finished_[i] = false;
     }
@@ -81,8 +148,12 @@ class JaggedConnector : public Connector<TensorRow> {
     Connector<TensorRow>::Reset();
   }
 
+  // @return bool - whether the rows are passed with LockFreeJaggedConnector
+  bool IsLockFree() const { return lock_free_connector_ != nullptr; }
+
  private:
   std::vector<bool> is_queue_finished_;
+  std::unique_ptr<LockFreeJaggedConnector> lock_free_connector_;
 };
 }  // namespace dataset
 }  // namespace mindspore
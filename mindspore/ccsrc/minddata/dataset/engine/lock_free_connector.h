@@ -0,0 +1,218 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_LOCK_FREE_CONNECTOR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_LOCK_FREE_CONNECTOR_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/util/ring_buffer.h"
+#include "minddata/dataset/util/services.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+// LockFreeConnector has the same ordering contract as Connector (see connector.h): the producers push their elements
+// in round robin order of the worker id, and the consumers take turns to pop them in the same order. Instead of a
+// mutex protected queue per producer, each producer owns a lock free single-producer ring buffer, and the turn of the
+// consumers is passed with an atomic index. An element therefore costs one atomic store on each side when the queues
+// are neither full nor empty, and PushBatch/PopBatch move many elements with one store.
+//
+// Blocking conditions are the same as Connector. A blocked caller spins with yield and then sleeps a little between
+// the retries, checking the interrupt flag of its task on every retry. So Register() does not need to hook into the
+// interrupt service of the task group.
+//
+// JaggedConnector passes the rows of the non-mappable leaf ops with it if enable_lock_free_connector is set.
+template <class T>
+class LockFreeConnector {
+ public:
+  LockFreeConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
+      : num_producers_(n_producers), num_consumers_(n_consumers), expect_consumer_(0), pop_from_(0) {
+    MS_LOG(DEBUG) << "A lock free connector is created with " << n_producers << " producers and " << n_consumers
+                  << " consumers.";
+    my_name_ = Services::GetUniqueID();
+    queues_.reserve(num_producers_);
+    for (int32_t i = 0; i < num_producers_; ++i) {
+      queues_.emplace_back(std::make_unique<SpscRingBuffer<T>>(queue_capacity));
+    }
+  }
+
+  virtual ~LockFreeConnector() = default;
+
+  // Pop the next element, only the consumer whose turn it is can pop
+  // @param int32_t worker_id - the worker id of the consumer
+  // @param T *result - the element popped
+  // @return Status The status code returned
+  Status Pop(int32_t worker_id, T *result) noexcept {
+    RETURN_UNEXPECTED_IF_NULL(result);
+    MS_ASSERT(worker_id < num_consumers_);
+    RETURN_IF_NOT_OK(WaitForTurn(worker_id));
+    SpinBackoff backoff;
+    while (!queues_[pop_from_]->TryPop(result)) {
+      RETURN_IF_INTERRUPTED();
+      backoff.Pause();
+    }
+    pop_from_ = (pop_from_ + 1) % num_producers_;
+    out_buffers_count_.fetch_add(1, std::memory_order_relaxed);
+    expect_consumer_.store((worker_id + 1) % num_consumers_, std::memory_order_release);
+    return Status::OK();
+  }
+
+  // Pop up to max_num elements in the same order as Pop. It waits for the first element only, and returns as soon as
+  // the next element is not ready. The whole batch takes one turn of the consumers.
+  // @param int32_t worker_id - the worker id of the consumer
+  // @param size_t max_num - the max number of elements to pop
+  // @param std::vector<T> *result - the elements popped
+  // @return Status The status code returned
+  Status PopBatch(int32_t worker_id, size_t max_num, std::vector<T> *result) noexcept {
+    RETURN_UNEXPECTED_IF_NULL(result);
+    MS_ASSERT(worker_id < num_consumers_);
+    result->resize(max_num);
+    if (max_num == 0) {
+      return Status::OK();
+    }
+    RETURN_IF_NOT_OK(WaitForTurn(worker_id));
+    SpinBackoff backoff;
+    while (!queues_[pop_from_]->TryPop(&(*result)[0])) {
+      RETURN_IF_INTERRUPTED();
+      backoff.Pause();
+    }
+    size_t num = 1;
+    if (num_producers_ == 1) {
+      // All the elements come from the same queue, move them with one store
+      num += queues_[0]->TryPop(result->data() + 1, max_num - 1);
+    } else {
+      pop_from_ = (pop_from_ + 1) % num_producers_;
+      while (num < max_num && queues_[pop_from_]->TryPop(&(*result)[num])) {
+        ++num;
+        pop_from_ = (pop_from_ + 1) % num_producers_;
+      }
+    }
+    result->resize(num);
+    out_buffers_count_.fetch_add(num, std::memory_order_relaxed);
+    expect_consumer_.store((worker_id + 1) % num_consumers_, std::memory_order_release);
+    return Status::OK();
+  }
+
+  Status Push(int32_t worker_id, const T &el) noexcept {
+    T copy = el;
+    return Push(worker_id, std::move(copy));
+  }
+
+  Status Push(int32_t worker_id, T &&el) noexcept {
+    MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
+    SpinBackoff backoff;
+    while (!queues_[worker_id]->TryPush(&el)) {
+      RETURN_IF_INTERRUPTED();
+      backoff.Pause();
+    }
+    return Status::OK();
+  }
+
+  // Push all the elements of a producer, they are published with one store whenever there is enough room
+  // @param int32_t worker_id - the worker id of the producer
+  // @param std::vector<T> *elements - the elements to push, it is cleared after the push
+  // @return Status The status code returned
+  Status PushBatch(int32_t worker_id, std::vector<T> *elements) noexcept {
+    RETURN_UNEXPECTED_IF_NULL(elements);
+    MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
+    size_t pushed = 0;
+    SpinBackoff backoff;
+    while (pushed < elements->size()) {
+      size_t num = queues_[worker_id]->TryPush(elements->data() + pushed, elements->size() - pushed);
+      if (num == 0) {
+        RETURN_IF_INTERRUPTED();
+        backoff.Pause();
+      } else {
+        pushed += num;
+        backoff.Reset();
+      }
+    }
+    elements->clear();
+    return Status::OK();
+  }
+
+  auto out_rows_count() const { return out_buffers_count_.load(); }
+
+  // Must not be called while the connector is in use
+  void Reset() {
+    for (auto &queue : queues_) {
+      queue->Reset();
+    }
+    expect_consumer_ = 0;
+    pop_from_ = 0;
+    out_buffers_count_ = 0;
+    MS_LOG(DEBUG) << "Lock free connector counters reset.";
+  }
+
+  void Print(std::ostream &out, bool showAll) const {
+    out << "\n--------- LockFreeConnector ------------"
+        << "\nConnector Name           : " << my_name_ << "\nNumber of consumers      : " << num_consumers_
+        << "\nNumber of producers      : " << num_producers_ << "\n";
+  }
+
+  friend std::ostream &operator<<(std::ostream &out, const LockFreeConnector &con) {
+    con.Print(out, false);
+    return out;
+  }
+
+  size_t size() const {
+    size_t size = 0;
+    for (const auto &queue : queues_) {
+      size += queue->size();
+    }
+    return size;
+  }
+
+  size_t capacity() const {
+    size_t capacity = 0;
+    for (const auto &queue : queues_) {
+      capacity += queue->capacity();
+    }
+    return capacity;
+  }
+
+  // The waits check the interrupt flag of the calling task, nothing needs to be registered
+  Status Register(TaskGroup *vg) { return Status::OK(); }
+
+ protected:
+  Status WaitForTurn(int32_t worker_id) {
+    SpinBackoff backoff;
+    // The acquire pairs with the release of the previous consumer, so pop_from_ and the consumer side of the queues
+    // are seen as it left them.
+    while (expect_consumer_.load(std::memory_order_acquire) != worker_id) {
+      RETURN_IF_INTERRUPTED();
+      backoff.Pause();
+    }
+    return Status::OK();
+  }
+
+  std::string my_name_;
+  std::vector<std::unique_ptr<SpscRingBuffer<T>>> queues_;
+  int32_t num_producers_;
+  int32_t num_consumers_;
+  // The consumer whose turn it is to pop
+  std::atomic<int32_t> expect_consumer_;
+  // The index to the queues_ where the next data should be popped, only touched by the consumer holding the turn
+  size_t pop_from_;
+  std::atomic<std::int64_t> out_buffers_count_ = 0;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_LOCK_FREE_CONNECTOR_H_
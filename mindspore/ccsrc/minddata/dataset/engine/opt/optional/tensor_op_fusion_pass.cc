@@ -16,16 +16,24 @@
 
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/resize_ir.h"
 
 namespace mindspore {
 namespace dataset {
@@ -51,19 +59,90 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
   }  // end of temporary code, needs to be deleted when tensorOperation's pybind completes
 
   // logic below is for non-prebuilt TensorOperation
-  pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
-  itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
-                    [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
+  auto find_pattern = [&ops](const std::vector<std::string> &ir_pattern) {
+    return std::search(ops.begin(), ops.end(), ir_pattern.begin(), ir_pattern.end(),
+                       [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
+  };
+  itr = find_pattern({vision::kDecodeOperation, vision::kRandomResizedCropOperation});
+  if (itr != ops.end()) {
+    auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
+    RETURN_UNEXPECTED_IF_NULL(fused_ir);
+    // fuse the two ops
+    (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
+    ops.erase(itr + 1);
+    *modified = true;
+  } else if (GlobalContext::config_manager()->enable_jpeg_dct_scaling()) {
+    // Decode followed by Resize can decode the jpeg image close to the output size, but the output changes slightly
+    itr = find_pattern({vision::kDecodeOperation, vision::kResizeOperation});
+    if (itr != ops.end()) {
+      auto *resize_ir = dynamic_cast<vision::ResizeOperation *>((itr + 1)->get());
+      RETURN_UNEXPECTED_IF_NULL(resize_ir);
+      // fuse the two ops
+      (*itr) = std::make_shared<vision::DecodeResizeOperation>(*resize_ir);
+      ops.erase(itr + 1);
+      *modified = true;
+    }
+  }
 
-  // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
-  auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
-  RETURN_UNEXPECTED_IF_NULL(fused_ir);
-  // fuse the two ops
-  (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
-  ops.erase(itr + 1);
-  node->setOperations(ops);
-  *modified = true;
+  // Normalize followed by HwcToChw, with a TypeCast to float before or after HwcToChw, is done in one pass
+  RETURN_IF_NOT_OK(FuseNormalizeHwcToChw(&ops, modified));
+  if (*modified) {
+    node->setOperations(ops);
+  }
+  return Status::OK();
+}
+
+Status TensorOpFusionPass::FuseNormalizeHwcToChw(std::vector<std::shared_ptr<TensorOperation>> *ops,
+                                                 bool *const modified) {
+  // Only the casts to float can be fused, the output of Normalize is float32
+  auto float_cast_type = [](const std::shared_ptr<TensorOperation> &op, std::string *type) -> Status {
+    type->clear();
+    if (op == nullptr || op->Name() != transforms::kTypeCastOperation) {
+      return Status::OK();
+    }
+    nlohmann::json args;
+    RETURN_IF_NOT_OK(op->to_json(&args));
+    std::string data_type = args["data_type"];
+    if (data_type == "float32" || data_type == "float16") {
+      *type = data_type;
+    }
+    return Status::OK();
+  };
+  auto is_op = [](const std::shared_ptr<TensorOperation> &op, const std::string &name) {
+    return op != nullptr && op->Name() == name;
+  };
+  for (auto itr = ops->begin(); itr != ops->end(); ++itr) {
+    if (!is_op(*itr, vision::kNormalizeOperation) || itr + 1 == ops->end()) {
+      continue;
+    }
+    std::string output_type;
+    int32_t num_fused = 0;
+    if (is_op(*(itr + 1), vision::kHwcToChwOperation)) {
+      // Normalize, HwcToChw and an optional TypeCast
+      num_fused = 1;
+      output_type = "float32";
+      if (itr + 2 != ops->end()) {
+        std::string cast_type;
+        RETURN_IF_NOT_OK(float_cast_type(*(itr + 2), &cast_type));
+        if (!cast_type.empty()) {
+          output_type = cast_type;
+          num_fused = 2;
+        }
+      }
+    } else if (itr + 2 != ops->end() && is_op(*(itr + 2), vision::kHwcToChwOperation)) {
+      // Normalize, TypeCast and HwcToChw
+      RETURN_IF_NOT_OK(float_cast_type(*(itr + 1), &output_type));
+      num_fused = output_type.empty() ? 0 : 2;
+    }
+    if (num_fused == 0) {
+      continue;
+    }
+    auto *normalize_ir = dynamic_cast<vision::NormalizeOperation *>(itr->get());
+    RETURN_UNEXPECTED_IF_NULL(normalize_ir);
+    (*itr) = std::make_shared<vision::NormalizeHwcToChwOperation>(*normalize_ir, output_type);
+    itr = ops->erase(itr + 1, itr + 1 + num_fused) - 1;
+    *modified = true;
+  }
   return Status::OK();
 }
 }  // namespace dataset
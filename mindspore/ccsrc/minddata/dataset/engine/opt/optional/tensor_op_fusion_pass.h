@@ -17,7 +17,9 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 
 #include <memory>
+#include <vector>
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/kernels/ir/tensor_operation.h"
 
 namespace mindspore {
 namespace dataset {
@@ -31,6 +33,13 @@ class TensorOpFusionPass : public IRNodePass {
   /// \param[in, out] *modified indicates whether the node has been visited
   /// \return Status The status code returned
   Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+ private:
+  /// \brief Fuses Normalize, HwcToChw and an optional TypeCast to float into NormalizeHwcToChw
+  /// \param[in, out] ops The operations of the map node
+  /// \param[in, out] *modified set to true if any operation is fused
+  /// \return Status The status code returned
+  Status FuseNormalizeHwcToChw(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -39,9 +39,17 @@ AutoTune::AutoTune(TreeAdapter *tree_adap, ProfilingManager *profiling_mgr)
       cur_epoch_(1),
       mode_(0),
       skip_bool_(true),
-      last_step_profiled_(0) {
+      last_step_profiled_(0),
+      baseline_throughput_(0),
+      on_trial_(false),
+      trial_step_{} {
   tree_modifier_ = std::make_unique<TreeModifier>(tree_adapter_);
   max_workers_ = GlobalContext::config_manager()->num_cpu_threads();
+  int32_t cpu_budget = GlobalContext::config_manager()->autotune_cpu_budget();
+  if (cpu_budget > 0) {
+    max_workers_ = std::min(max_workers_, cpu_budget);
+  }
+  cpu_budget_ = max_workers_;
   step_gap_ = GlobalContext::config_manager()->autotune_interval();
   save_autoconfig_ = GlobalContext::config_manager()->save_autoconfig();
   autotune_json_filepath_ = GlobalContext::config_manager()->get_autotune_json_filepath();
@@ -213,13 +221,6 @@ Status AutoTune::CollectOpsInfo() {
   return Status::OK();
 }
 
-Status AutoTune::GetOpConnectorCapacity(int32_t op_id, int64_t *capacity) {
-  auto item = ops_.find(op_id);
-  CHECK_FAIL_RETURN_UNEXPECTED(item != ops_.end(), "Invalid Operator ID.");
-  *capacity = item->second->ConnectorCapacity();
-  return Status::OK();
-}
-
 Status AutoTune::GetOpsCpuUtil(std::map<int32_t, double> *ops_cpu_util) {
   // loop over all itr keys and get avg cpu usage
   for (auto itr = ops_.begin(); itr != ops_.end(); ++itr) {
@@ -352,9 +353,7 @@ Status AutoTune::RunIteration() {
   RETURN_IF_NOT_OK(RecordPipelineTime());
   bool isBottleneck = false;
   RETURN_IF_NOT_OK(IsDSaBottleneck(&isBottleneck));
-  if (isBottleneck) {
-    RETURN_IF_NOT_OK(Analyse());
-  }
+  RETURN_IF_NOT_OK(Analyse(isBottleneck));
   return Status::OK();
 }
 
@@ -445,7 +444,95 @@ Status AutoTune::RequestConnectorCapacityChange(int32_t op_id, int32_t old_size,
   return Status::OK();
 }
 
-Status AutoTune::Analyse() {
+bool AutoTune::IsStepRejected(int32_t op_id, TuneKnob knob, bool step_up) const {
+  return std::any_of(rejected_steps_.begin(), rejected_steps_.end(), [&](const auto &item) {
+    const TuneStep &step = item.first;
+    return step.op_id == op_id && step.knob == knob && (step.new_value > step.old_value) == step_up;
+  });
+}
+
+bool AutoTune::KeepTrialStep(double throughput) const {
+  if (baseline_throughput_ <= 0) {
+    return true;
+  }
+  if (trial_step_.new_value > trial_step_.old_value) {
+    // More workers or prefetch cost cpu or memory, they have to pay for themselves
+    return throughput >= baseline_throughput_ * (1 + MIN_THROUGHPUT_GAIN);
+  }
+  // Fewer workers free cpu for the other jobs on the host, a little noise in the throughput is acceptable
+  return throughput >= baseline_throughput_ * (1 - MAX_THROUGHPUT_LOSS);
+}
+
+bool AutoTune::FindStepUp(const std::vector<int32_t> &ops_id, const std::map<int32_t, int32_t> &ops_num_workers,
+                          const std::map<int32_t, double> &ops_cpu_util,
+                          const std::map<int32_t, double> &out_ops_queue_util,
+                          const std::map<int32_t, double> &in_ops_queue_util, double cpu_usage, TuneStep *step) {
+  // The ops whose input connector is much fuller than the output connector, or whose workers are busy, are most
+  // likely the bottleneck. They are tried first, the one with the largest difference of the connectors first.
+  std::vector<int32_t> candidates = ops_id;
+  auto queue_diff = [&](int32_t op_id) { return in_ops_queue_util.at(op_id) - out_ops_queue_util.at(op_id); };
+  auto worker_cpu = [&](int32_t op_id) { return ops_cpu_util.at(op_id) / ops_num_workers.at(op_id); };
+  auto is_slow = [&](int32_t op_id) {
+    return queue_diff(op_id) > INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD || worker_cpu(op_id) > MAP_OP_WORKER_HIGH_THRESHOLD;
+  };
+  std::stable_sort(candidates.begin(), candidates.end(), [&](int32_t a, int32_t b) {
+    if (is_slow(a) != is_slow(b)) {
+      return is_slow(a);
+    }
+    return queue_diff(a) != queue_diff(b) ? queue_diff(a) > queue_diff(b) : worker_cpu(a) > worker_cpu(b);
+  });
+  for (const auto &op_id : candidates) {
+    int32_t num_workers = ops_num_workers.at(op_id);
+    // A new worker is expected to be as busy as the current ones
+    double extra_cpu = worker_cpu(op_id) / TO_PERCENT;
+    if (num_workers < max_workers_ && cpu_usage + extra_cpu <= cpu_budget_ &&
+        !IsStepRejected(op_id, kTuneNumWorkers, true)) {
+      *step = {op_id, kTuneNumWorkers, num_workers, num_workers + INCREMENT_WORKER};
+      return true;
+    }
+    // The output connector is mostly full, a deeper prefetch lets the op run ahead through the jitter of the consumer
+    int64_t capacity = ops_[op_id]->ConnectorCapacity();
+    if (out_ops_queue_util.at(op_id) > LEAF_QUEUE_THRESHOLD && capacity < MAX_QUEUE_SIZE &&
+        !IsStepRejected(op_id, kTunePrefetchSize, true)) {
+      *step = {op_id, kTunePrefetchSize, static_cast<int32_t>(capacity),
+               static_cast<int32_t>(capacity + INCREMENT_QUEUE_SIZE)};
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AutoTune::FindStepDown(const std::vector<int32_t> &ops_id, const std::map<int32_t, int32_t> &ops_num_workers,
+                            const std::map<int32_t, double> &ops_cpu_util, bool skip_rejected, TuneStep *step) {
+  bool found = false;
+  double min_worker_cpu = 0;
+  for (const auto &op_id : ops_id) {
+    int32_t num_workers = ops_num_workers.at(op_id);
+    double worker_cpu = ops_cpu_util.at(op_id) / num_workers;
+    if (num_workers <= MIN_NUM_WORKERS || (skip_rejected && IsStepRejected(op_id, kTuneNumWorkers, false))) {
+      continue;
+    }
+    if (!found || worker_cpu < min_worker_cpu) {
+      *step = {op_id, kTuneNumWorkers, num_workers, num_workers + DECREMENT_WORKER};
+      min_worker_cpu = worker_cpu;
+      found = true;
+    }
+  }
+  // When the budget is not exceeded, only the workers that are mostly idle are given back
+  return found && (!skip_rejected || min_worker_cpu < MAP_OP_WORKER_LOW_THRESHOLD);
+}
+
+Status AutoTune::ApplyTuneStep(TuneStep *step) {
+  if (step->knob == kTuneNumWorkers) {
+    RETURN_IF_NOT_OK(RequestNumWorkerChange(step->op_id, step->old_value, &step->new_value));
+  } else {
+    step->new_value = std::min(std::max(step->new_value, MIN_QUEUE_SIZE), MAX_QUEUE_SIZE);
+    RETURN_IF_NOT_OK(RequestConnectorCapacityChange(step->op_id, step->old_value, step->new_value));
+  }
+  return Status::OK();
+}
+
+Status AutoTune::Analyse(bool is_bottleneck) {
   // collect stats
   std::map<int32_t, int32_t> ops_num_workers;
   RETURN_IF_NOT_OK(GetOpsNumWorker(&ops_num_workers));
@@ -455,8 +542,14 @@ Status AutoTune::Analyse() {
 
   std::map<int32_t, double> ops_cpu_util;
   RETURN_IF_NOT_OK(GetOpsCpuUtil(&ops_cpu_util));
+  double cpu_usage = 0;
+  for (const auto &op_cpu : ops_cpu_util) {
+    cpu_usage += op_cpu.second / TO_PERCENT;
+  }
+  double pipeline_time = avg_pipeline_times_.empty() ? 0 : avg_pipeline_times_.back();
+  double throughput = pipeline_time > 0 ? MS_PER_SECOND / pipeline_time : 0;
 
-  // check parallel ops in loop
+  std::vector<int32_t> tunable_ops;
   for (const auto &op_id : parallel_ops_ids_) {
     // Skip Generator op
     if (ops_[op_id]->Name() == "GeneratorOp") {
@@ -468,48 +561,56 @@ Status AutoTune::Analyse() {
       continue;
     }
 #endif
-
-    // op specifics
-    double output_queue_util = out_ops_queue_util[op_id];
-    double input_queue_util = in_ops_queue_util[op_id];
-
-    double cpu_util = ops_cpu_util[op_id];
-    int32_t num_workers = ops_num_workers[op_id];
-    CHECK_FAIL_RETURN_UNEXPECTED(num_workers != 0, "ParallelOp with num_workers=0");
-    // derived metrics
-    double queue_diff = input_queue_util - output_queue_util;
-    int64_t queue_capacity;
-    RETURN_IF_NOT_OK(GetOpConnectorCapacity(op_id, &queue_capacity));
-    int64_t new_queue_capacity = queue_capacity;
-
-    int32_t requested_workers = 0;
-
-    MS_LOG(DEBUG) << "Op (" << ops_[op_id]->NameWithID() << ") CPU=" << cpu_util / num_workers
-                  << ", in=" << input_queue_util << "out=" << output_queue_util;
-    // map decisions - queue
-    if (queue_diff > INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD) {
-      MS_LOG(WARNING) << "Op (" << ops_[op_id]->NameWithID()
-                      << ") is slow, input connector utilization=" << input_queue_util
-                      << ", output connector utilization=" << output_queue_util << ", diff= " << queue_diff << " > "
-                      << INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD << " threshold.";
-      requested_workers = num_workers + INCREMENT_WORKER;
-      RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, &requested_workers));
-    } else if ((cpu_util / num_workers) > MAP_OP_WORKER_HIGH_THRESHOLD) {
-      MS_LOG(WARNING) << "Op (" << ops_[op_id]->NameWithID() << ") getting high average worker cpu utilization "
-                      << (cpu_util / num_workers) << "% > " << MAP_OP_WORKER_HIGH_THRESHOLD << "% threshold.";
-      requested_workers = num_workers + INCREMENT_WORKER;
-      RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, &requested_workers));
+    CHECK_FAIL_RETURN_UNEXPECTED(ops_num_workers[op_id] != 0, "ParallelOp with num_workers=0");
+    tunable_ops.push_back(op_id);
+    MS_LOG(DEBUG) << "Op (" << ops_[op_id]->NameWithID() << ") CPU=" << ops_cpu_util[op_id] / ops_num_workers[op_id]
+                  << ", in=" << in_ops_queue_util[op_id] << "out=" << out_ops_queue_util[op_id];
+  }
+  MS_LOG(INFO) << "Pipeline throughput: " << throughput << " steps/s, cpu usage: " << cpu_usage
+               << " cores, cpu budget: " << cpu_budget_ << " cores.";
+
+  for (auto itr = rejected_steps_.begin(); itr != rejected_steps_.end();) {
+    if (--itr->second <= 0) {
+      itr = rejected_steps_.erase(itr);
+    } else {
+      ++itr;
     }
-    if ((cpu_util / num_workers) < MAP_OP_WORKER_LOW_THRESHOLD &&
-        ((input_queue_util < INPUT_QUEUE_LOW) || (-1 * queue_diff > INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD))) {
-      MS_LOG(WARNING) << "Op (" << ops_[op_id]->NameWithID() << ") getting low average worker cpu utilization "
-                      << (cpu_util / num_workers) << "% < " << MAP_OP_WORKER_LOW_THRESHOLD << "% threshold.";
-      new_queue_capacity = queue_capacity + INCREMENT_QUEUE_SIZE;
-      if (requested_workers == 0) {
-        requested_workers = num_workers;
-      }
-      new_queue_capacity = std::max(new_queue_capacity, static_cast<int64_t>(requested_workers));
-      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(op_id, queue_capacity, new_queue_capacity));
+  }
+  // Judge the step made in the last iteration
+  if (on_trial_) {
+    on_trial_ = false;
+    if (!KeepTrialStep(throughput)) {
+      MS_LOG(WARNING) << "Op (" << ops_[trial_step_.op_id]->NameWithID() << ") throughput " << throughput
+                      << " steps/s is not better than " << baseline_throughput_ << " steps/s, revert the last change.";
+      TuneStep revert = {trial_step_.op_id, trial_step_.knob, trial_step_.new_value, trial_step_.old_value};
+      RETURN_IF_NOT_OK(ApplyTuneStep(&revert));
+      rejected_steps_.emplace_back(trial_step_, REJECTED_STEP_ITERATIONS);
+      // The throughput of the next interval is the baseline again
+      baseline_throughput_ = 0;
+      return Status::OK();
+    }
+  }
+  baseline_throughput_ = throughput;
+
+  TuneStep step{};
+  // The cpu budget is a hard limit, the workers given back are not on trial
+  if (cpu_usage > cpu_budget_) {
+    if (FindStepDown(tunable_ops, ops_num_workers, ops_cpu_util, false, &step)) {
+      MS_LOG(WARNING) << "Pipeline cpu usage " << cpu_usage << " cores > " << cpu_budget_
+                      << " cores budget, remove workers from Op (" << ops_[step.op_id]->NameWithID() << ").";
+      RETURN_IF_NOT_OK(ApplyTuneStep(&step));
+      baseline_throughput_ = 0;
+    }
+    return Status::OK();
+  }
+  bool found = is_bottleneck ? FindStepUp(tunable_ops, ops_num_workers, ops_cpu_util, out_ops_queue_util,
+                                          in_ops_queue_util, cpu_usage, &step)
+                             : FindStepDown(tunable_ops, ops_num_workers, ops_cpu_util, true, &step);
+  if (found) {
+    RETURN_IF_NOT_OK(ApplyTuneStep(&step));
+    if (step.new_value != step.old_value) {
+      trial_step_ = step;
+      on_trial_ = true;
     }
   }
   return Status::OK();
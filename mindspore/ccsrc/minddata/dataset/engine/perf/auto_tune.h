@@ -21,6 +21,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/util/log_adapter.h"
@@ -39,13 +40,13 @@ class AutoTune {
   /// \param profiling_mgr_ pointer to the profiler manager
   AutoTune(TreeAdapter *tree_adap, ProfilingManager *profiling_mgr);
 
-  ~AutoTune() = default;
+  virtual ~AutoTune() = default;
 
   /// Function to create and launch the AutoTune thread.
   /// \return Status object
   Status LaunchThread();
 
- private:
+ protected:
   /// The main loop in AutoTune, it iterates every interval
   /// \return Status object
   Status Main();
@@ -127,35 +128,85 @@ class AutoTune {
   // CPU Specifics
   const float_t MAP_OP_WORKER_HIGH_THRESHOLD = 75;
   const float_t MAP_OP_WORKER_LOW_THRESHOLD = 35;
+  // Hill-climbing specifics
+  const float_t MIN_THROUGHPUT_GAIN = 0.03;
+  const float_t MAX_THROUGHPUT_LOSS = 0.02;
+  const int32_t REJECTED_STEP_ITERATIONS = 5;
+  const double MS_PER_SECOND = 1000.0;
   // Running mode specifics
   enum AutoTuneMode { kAutoTuneModeEpoch, kAutoTuneModeStep };
 
-  /// Get the out connector capacity of the operator
-  /// \param[in] op_id operator id
-  /// \param[out] capacity the capacity of the connector
-  /// \return Status code
-  Status GetOpConnectorCapacity(int32_t op_id, int64_t *capacity);
-
   /// Get the CPU usage of each operator in the pipeline
   /// \param[out] ops_cpu_util map from op_id to cpu utilization
   /// \return Status code
-  Status GetOpsCpuUtil(std::map<int32_t, double> *ops_cpu_util);
+  virtual Status GetOpsCpuUtil(std::map<int32_t, double> *ops_cpu_util);
 
   /// Get the queue utilization of each operator in the pipeline
   /// \param[out] ops_queue_util map from op_id to output queue utilization
   /// \param[out] ops_queue_util map from op_id to input queue utilization
   /// \note inline ops would report -1 in both input and output queue utilization
   /// \return Status code
-  Status GetOpsQueueUtil(std::map<int32_t, double> *out_ops_queue_util, std::map<int32_t, double> *in_ops_queue_util);
+  virtual Status GetOpsQueueUtil(std::map<int32_t, double> *out_ops_queue_util,
+                                 std::map<int32_t, double> *in_ops_queue_util);
 
   /// Get the number of workers for each operator in the pipeline
   /// \param[out] ops_num_workers map from op_id to num_workers
   /// \return Status code
-  Status GetOpsNumWorker(std::map<int32_t, int32_t> *ops_num_workers);
-
-  /// Main AutoTune algorithm
+  virtual Status GetOpsNumWorker(std::map<int32_t, int32_t> *ops_num_workers);
+
+  /// Main AutoTune algorithm. It is a hill-climbing controller: each iteration judges the step made in the last one
+  /// by the measured throughput, keeps or reverts it, and then takes the next step, all within the cpu budget
+  /// \note Workers are removed as well as added: from the least busy operator when the pipeline is not the
+  ///     bottleneck (kept only if the throughput holds), and unconditionally when the cpu usage exceeds the budget.
+  ///     So the tuned num_parallel_workers can be smaller than the one set by the user.
+  /// \param is_bottleneck whether the dataset pipeline is the bottleneck of the training
   /// \return Status code
-  Status Analyse();
+  Status Analyse(bool is_bottleneck);
+
+  /// Knobs the controller can turn on an operator
+  enum TuneKnob { kTuneNumWorkers, kTunePrefetchSize };
+
+  /// A change of one knob, it is on trial until the throughput of the next interval is measured
+  struct TuneStep {
+    int32_t op_id;
+    TuneKnob knob;
+    int32_t old_value;
+    int32_t new_value;
+  };
+
+  /// Keep the step on trial if it made the throughput better, or did not make it much worse for a step that frees
+  /// resources
+  /// \param throughput throughput measured with the step in effect
+  /// \return bool true if the step should be kept
+  bool KeepTrialStep(double throughput) const;
+
+  /// Find a step that adds workers or prefetch to the operator most likely to be the bottleneck, and fits in the
+  /// cpu budget
+  /// \param[in] ops_id tunable operators
+  /// \param[in] ops_num_workers, ops_cpu_util, out_ops_queue_util, in_ops_queue_util statistics of the operators
+  /// \param[in] cpu_usage cpu cores used by the pipeline
+  /// \param[out] step the step found
+  /// \return bool true if a step is found
+  bool FindStepUp(const std::vector<int32_t> &ops_id, const std::map<int32_t, int32_t> &ops_num_workers,
+                  const std::map<int32_t, double> &ops_cpu_util, const std::map<int32_t, double> &out_ops_queue_util,
+                  const std::map<int32_t, double> &in_ops_queue_util, double cpu_usage, TuneStep *step);
+
+  /// Find a step that removes a worker from the least busy operator
+  /// \param[in] ops_id tunable operators
+  /// \param[in] ops_num_workers, ops_cpu_util statistics of the operators
+  /// \param[in] skip_rejected whether the steps rejected recently are skipped
+  /// \param[out] step the step found
+  /// \return bool true if a step is found
+  bool FindStepDown(const std::vector<int32_t> &ops_id, const std::map<int32_t, int32_t> &ops_num_workers,
+                    const std::map<int32_t, double> &ops_cpu_util, bool skip_rejected, TuneStep *step);
+
+  /// Send the ChangeRequest of the step to the operator
+  /// \param step the step to apply, the new value is updated if it is clipped
+  /// \return Status code
+  Status ApplyTuneStep(TuneStep *step);
+
+  /// Check whether the same kind of step is rejected recently
+  bool IsStepRejected(int32_t op_id, TuneKnob knob, bool step_up) const;
 
   /// Send a ChangeRequest to the operator to update the number of workers
   /// \param op_id operator ID
@@ -203,6 +254,16 @@ class AutoTune {
   /// vector of pipeline time per epoch
   std::vector<double> avg_pipeline_times_;
 
+  /// number of cpu cores the pipeline can use
+  double cpu_budget_;
+  /// throughput measured before the step on trial, 0 if unknown
+  double baseline_throughput_;
+  /// whether trial_step_ is waiting to be judged
+  bool on_trial_;
+  TuneStep trial_step_;
+  /// steps that made the throughput worse, with the number of iterations they are not tried again
+  std::vector<std::pair<TuneStep, int32_t>> rejected_steps_;
+
   /// the current epoch and step indices (starts from 1)
   int32_t cur_epoch_;
   // step based auto-tuning specifics
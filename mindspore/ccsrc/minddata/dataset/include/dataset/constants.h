@@ -324,6 +324,13 @@ using session_id_type = uint32_t;
 using row_id_type = int64_t;
 
 constexpr uint32_t kCfgAutoTuneInterval = 0;  // default number of steps
+constexpr int32_t kCfgAutoTuneCpuBudget = 0;   // default number of cpu cores AutoTune can use, 0 means all of them
+constexpr int32_t kCfgMapBatchSize = 1;        // default number of rows sent to a map worker at once
+constexpr int32_t kCfgShuffleNumShards = 1;    // default number of shards of the shuffle buffer
+
+// default number of threads reading the blobs of mindrecord ahead, 0 means they are read by the workers
+constexpr int32_t kCfgMindRecordReadAheadThreads = 0;
+constexpr int32_t kCfgMindRecordReadAheadSize = 256;  // default MB of the blobs of mindrecord read ahead in memory
 }  // namespace dataset
 }  // namespace mindspore
 
@@ -20,6 +20,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -33,6 +34,7 @@ namespace mindspore {
 namespace dataset {
 class TensorOperation;
 class Vectors;
+class VocabTrie;
 
 using WordIdType = int32_t;
 using WordType = std::string;
@@ -119,6 +121,11 @@ class Vocab {
   /// \endcode
   std::vector<WordIdType> TokensToIds(const std::vector<WordType> &words) const;
 
+  /// Lookup the id of a word without copying it, if the word doesn't exist in vocab, return -1.
+  /// \param word Word to be looked up.
+  /// \return ID of the word in the vocab.
+  WordIdType LookupToken(std::string_view word) const;
+
   /// Lookup the word of an ID, if ID doesn't exist in vocab, return empty string.
   /// \param id ID to be looked up.
   /// \return Indicates the word corresponding to the ID.
@@ -156,17 +163,27 @@ class Vocab {
   const std::unordered_map<WordType, WordIdType> &GetVocab() const { return word2id_; }
 
   /// \brief Constructor.
-  Vocab() = default;
+  Vocab();
+
+  /// \brief Copy constructor, the copy builds its own trie.
+  Vocab(const Vocab &other);
+
+  /// \brief Copy assignment, the copy builds its own trie.
+  Vocab &operator=(const Vocab &other);
 
   /// \brief Destructor.
-  ~Vocab() = default;
+  ~Vocab();
 
   static const WordIdType kNoTokenExists;
   static const WordType kNoIdExists;
 
  private:
+  friend class VocabTrie;
+
   std::unordered_map<WordType, WordIdType> word2id_;
   std::unordered_map<WordIdType, WordType> id2word_;
+  struct Data;
+  std::shared_ptr<Data> data_;
 };
 
 /// \brief SentencePiece object that is used to do words segmentation.
@@ -287,6 +287,45 @@ class MS_API CutOut final : public TensorTransform {
   std::shared_ptr<Data> data_;
 };
 
+/// \brief Decode the input image and resize it to the given size. If enable_jpeg_dct_scaling is set in the config, a
+///     JPEG image is downscaled while it is decoded, which is much faster than Decode followed by Resize for large
+///     images. Otherwise the output is the same as Decode followed by Resize.
+class MS_API DecodeResize final : public TensorTransform {
+ public:
+  /// \brief Constructor.
+  /// \param[in] size A vector representing the output size of the resized image.
+  ///     If the size is a single value, the image will be resized to this value with
+  ///     the same image aspect ratio. If the size has 2 values, it should be (height, width).
+  /// \param[in] interpolation An enum for the mode of interpolation.
+  ///   - InterpolationMode::kLinear, Interpolation method is blinear interpolation.
+  ///   - InterpolationMode::kNearestNeighbour, Interpolation method is nearest-neighbor interpolation.
+  ///   - InterpolationMode::kCubic, Interpolation method is bicubic interpolation.
+  ///   - InterpolationMode::kArea, Interpolation method is pixel area interpolation.
+  ///   - InterpolationMode::kCubicPil, Interpolation method is bicubic interpolation like implemented in pillow.
+  /// \par Example
+  /// \code
+  ///     /* Define operations */
+  ///     auto decode_resize_op = vision::DecodeResize({224, 224}, InterpolationMode::kLinear);
+  ///
+  ///     /* dataset is an instance of Dataset object */
+  ///     dataset = dataset->Map({decode_resize_op},  // operations
+  ///                            {"image"});          // input columns
+  /// \endcode
+  explicit DecodeResize(const std::vector<int32_t> &size, InterpolationMode interpolation = InterpolationMode::kLinear);
+
+  /// \brief Destructor.
+  ~DecodeResize() = default;
+
+ protected:
+  /// \brief The function to convert a TensorTransform object into a TensorOperation object.
+  /// \return Shared pointer to TensorOperation object.
+  std::shared_ptr<TensorOperation> Parse() override;
+
+ private:
+  struct Data;
+  std::shared_ptr<Data> data_;
+};
+
 /// \brief Apply histogram equalization on the input image.
 class MS_API Equalize final : public TensorTransform {
  public:
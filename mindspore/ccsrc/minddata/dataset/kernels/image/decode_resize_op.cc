@@ -0,0 +1,74 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
+
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+
+namespace mindspore {
+namespace dataset {
+Status DecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    input->Rank() == 1,
+    "DecodeResize: invalid input shape, only support 1D input, got rank: " + std::to_string(input->Rank()));
+  if (!IsNonEmptyJPEG(input)) {
+    std::shared_ptr<Tensor> decoded;
+    DecodeOp op(true);
+    RETURN_IF_NOT_OK(op.Compute(input, &decoded));
+    return ResizeOp::Compute(decoded, output);
+  }
+  int input_h = 0;
+  int input_w = 0;
+  RETURN_IF_NOT_OK(GetJpegImageInfo(input, &input_w, &input_h));
+  int32_t output_h = 0;
+  int32_t output_w = 0;
+  RETURN_IF_NOT_OK(GetOutputSize(input_h, input_w, &output_h, &output_w));
+  // Decode the image close to the output size instead of at full resolution if it is enabled
+  int scale_denom = 1;
+  if (GlobalContext::config_manager()->enable_jpeg_dct_scaling()) {
+    scale_denom = GetJpegScaleDenom(input_w, input_h, output_w, output_h);
+  }
+  std::shared_ptr<Tensor> decoded;
+  RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, 0, 0, 0, 0, scale_denom));
+  return Resize(decoded, output, output_h, output_w, 0, 0, interpolation_);
+}
+
+Status DecodeResizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  constexpr int64_t kOutNumChannels = 3;
+  // The output size is only known if both the height and width are given
+  TensorShape out({size2_ != 0 ? size1_ : -1, size2_ != 0 ? size2_ : -1, kOutNumChannels});
+  if (inputs[0].Rank() == 1) {
+    (void)outputs.emplace_back(out);
+  }
+  if (!outputs.empty()) {
+    return Status::OK();
+  }
+  return Status(StatusCode::kMDUnexpectedError,
+                "DecodeResize: invalid input shape, expected 1D input, but got input dimension is:" +
+                  std::to_string(inputs[0].Rank()));
+}
+
+Status DecodeResizeOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_UINT8);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -372,8 +372,20 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
   throw std::runtime_error(jpeg_last_error_msg);
 }
 
+int GetJpegScaleDenom(int crop_w, int crop_h, int target_w, int target_h) {
+  // libjpeg-turbo has SIMD kernels for the 1/2 and 1/4 scaled IDCT, and the 1/8 scaling only uses the DC coefficient,
+  // so only the powers of 2 are used.
+  constexpr int kMaxScaleDenom = 8;
+  int scale_denom = 1;
+  while (scale_denom < kMaxScaleDenom && crop_w / (scale_denom * 2) >= target_w &&
+         crop_h / (scale_denom * 2) >= target_h) {
+    scale_denom *= 2;
+  }
+  return scale_denom;
+}
+
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int scale_denom) {
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -407,6 +419,23 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
       std::to_string(crop_w) + ", crop height:" + std::to_string(crop_h) +
       ", and crop x coordinate:" + std::to_string(crop_x) + ", crop y coordinate:" + std::to_string(crop_y));
   }
+  if (scale_denom > 1) {
+    // Let the IDCT produce the downscaled image directly, and map the region to the downscaled coordinates. The end
+    // of the region is rounded up so it is never empty.
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = static_cast<unsigned int>(scale_denom);
+    try {
+      jpeg_calc_output_dimensions(&cinfo);
+    } catch (std::runtime_error &e) {
+      return DestroyDecompressAndReturnError(e.what());
+    }
+    int crop_x_end = std::min((crop_x + crop_w + scale_denom - 1) / scale_denom, static_cast<int>(cinfo.output_width));
+    int crop_y_end = std::min((crop_y + crop_h + scale_denom - 1) / scale_denom, static_cast<int>(cinfo.output_height));
+    crop_x /= scale_denom;
+    crop_y /= scale_denom;
+    crop_w = std::max(crop_x_end - crop_x, 1);
+    crop_h = std::max(crop_y_end - crop_y, 1);
+  }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   CHECK_FAIL_RETURN_UNEXPECTED(mcu_size != 0, "JpegCropAndDecode: divisor mcu_size is zero.");
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
@@ -961,6 +990,95 @@ Status NormalizePad(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor
   }
 }
 
+namespace {
+// Normalize the image row by row, and write each channel of the row to its plane of the CHW output. A row of the input
+// stays in the cache while the channels are taken out of it.
+template <typename T, typename OUT_T>
+void NormalizeHwcToChwImpl(const T *in, OUT_T *out, int64_t height, int64_t width, int64_t num_channels,
+                           const std::vector<float> &mean, const std::vector<float> &std) {
+  int64_t plane_size = height * width;
+  for (int64_t h = 0; h < height; h++) {
+    const T *in_row = in + h * width * num_channels;
+    for (int64_t c = 0; c < num_channels; c++) {
+      OUT_T *out_row = out + c * plane_size + h * width;
+      float std_c = std[c];
+      float mean_c = mean[c];
+      for (int64_t w = 0; w < width; w++) {
+        out_row[w] = static_cast<OUT_T>(static_cast<float>(in_row[w * num_channels + c]) / std_c - mean_c);
+      }
+    }
+  }
+}
+
+// A uint8 image only has 256 values per channel, so the normalized values are looked up in a table built with the same
+// arithmetic as Normalize, instead of doing a division per element.
+template <typename OUT_T>
+void NormalizeHwcToChwLut(const uint8_t *in, OUT_T *out, int64_t height, int64_t width, int64_t num_channels,
+                          const std::vector<float> &mean, const std::vector<float> &std) {
+  constexpr int64_t kNumValues = 256;
+  std::vector<OUT_T> table(num_channels * kNumValues);
+  for (int64_t c = 0; c < num_channels; c++) {
+    for (int64_t v = 0; v < kNumValues; v++) {
+      table[c * kNumValues + v] = static_cast<OUT_T>(static_cast<float>(v) / std[c] - mean[c]);
+    }
+  }
+  int64_t plane_size = height * width;
+  for (int64_t h = 0; h < height; h++) {
+    const uint8_t *in_row = in + h * width * num_channels;
+    for (int64_t c = 0; c < num_channels; c++) {
+      OUT_T *out_row = out + c * plane_size + h * width;
+      const OUT_T *table_c = table.data() + c * kNumValues;
+      for (int64_t w = 0; w < width; w++) {
+        out_row[w] = table_c[in_row[w * num_channels + c]];
+      }
+    }
+  }
+}
+
+template <typename OUT_T>
+void NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                       const std::vector<float> &mean, const std::vector<float> &std) {
+  int64_t height = input->shape()[0];
+  int64_t width = input->shape()[1];
+  int64_t num_channels = input->shape()[CHANNEL_INDEX];
+  auto *out = reinterpret_cast<OUT_T *>((*output)->GetMutableBuffer());
+  if (input->type() == DataType::DE_UINT8) {
+    NormalizeHwcToChwLut<OUT_T>(input->GetBuffer(), out, height, width, num_channels, mean, std);
+  } else {
+    NormalizeHwcToChwImpl<float, OUT_T>(reinterpret_cast<const float *>(input->GetBuffer()), out, height, width,
+                                        num_channels, mean, std);
+  }
+}
+}  // namespace
+
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         const std::vector<float> &mean, const std::vector<float> &std, const DataType &output_type) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  RETURN_UNEXPECTED_IF_NULL(output);
+  CHECK_FAIL_RETURN_UNEXPECTED(input->Rank() == DEFAULT_IMAGE_RANK,
+                               "NormalizeHwcToChw: image shape should be <H,W,C>, but got rank: " +
+                                 std::to_string(input->Rank()));
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    input->type() == DataType::DE_UINT8 || input->type() == DataType::DE_FLOAT32,
+    "NormalizeHwcToChw: image type should be uint8 or float32, but got: " + input->type().ToString());
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    output_type == DataType::DE_FLOAT32 || output_type == DataType::DE_FLOAT16,
+    "NormalizeHwcToChw: output type should be float32 or float16, but got: " + output_type.ToString());
+  int64_t num_channels = input->shape()[CHANNEL_INDEX];
+  CHECK_FAIL_RETURN_UNEXPECTED(mean.size() == static_cast<size_t>(num_channels) && std.size() == mean.size(),
+                               "NormalizeHwcToChw: number of channels does not match the size of mean and std vectors, "
+                               "got channels: " +
+                                 std::to_string(num_channels) + ", size of mean:" + std::to_string(mean.size()));
+  RETURN_IF_NOT_OK(
+    Tensor::CreateEmpty(TensorShape{num_channels, input->shape()[0], input->shape()[1]}, output_type, output));
+  if (output_type == DataType::DE_FLOAT16) {
+    NormalizeHwcToChw<float16>(input, output, mean, std);
+  } else {
+    NormalizeHwcToChw<float>(input, output, mean, std);
+  }
+  return Status::OK();
+}
+
 Status AdjustBrightness(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float &alpha) {
   try {
     std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
@@ -115,8 +115,20 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+/// \brief Decode a region of a jpeg image, optionally downscaled by the DCT of the decoder
+/// \param input: Tensor containing the not decoded jpeg image 1D bytes
+/// \param output: Decoded image Tensor of shape <H,W,C> and type DE_UINT8. Pixel order is RGB
+/// \param x, y, w, h: the region to decode in the coordinates of the original image, the whole image if all are 0
+/// \param scale_denom: the region is decoded at 1/scale_denom of its size, it should be 1, 2, 4 or 8
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int scale_denom = 1);
+
+/// \brief Get the largest DCT scaling of the jpeg decoder which still decodes the region to at least the target
+///     size, so the resize afterwards only has to shrink the image a little
+/// \param crop_w, crop_h: size of the region to decode
+/// \param target_w, target_h: size of the image after resize
+/// \return int: the scale_denom for JpegCropAndDecode, 1 if the region can not be downscaled
+int GetJpegScaleDenom(int crop_w, int crop_h, int target_w, int target_h);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -215,6 +227,16 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
 Status NormalizePad(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                     const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std, const std::string &dtype);
 
+/// \brief Returns Normalized image swapped to CHW, computed in one pass without the intermediate HWC float image
+/// \param input: Tensor of shape <H,W,C> and type DE_UINT8 or DE_FLOAT32.
+/// \param mean: mean of each channel already divided by its std, as in NormalizeOp
+/// \param std: std of each channel
+/// \param output_type: DE_FLOAT32 or DE_FLOAT16
+/// \param output: Normalized image Tensor of shape <C,H,W> and type output_type, with the same values as Normalize
+///     followed by HwcToChw and TypeCast
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         const std::vector<float> &mean, const std::vector<float> &std, const DataType &output_type);
+
 /// \brief Returns image with adjusted brightness.
 /// \param input: Tensor of shape <H,W,3> in RGB order and any OpenCv compatible type, see CVTensor.
 /// \param alpha: Alpha value to adjust brightness by. Should be a positive number.
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+
+#include "minddata/dataset/kernels/data/data_utils.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+NormalizeHwcToChwOp::NormalizeHwcToChwOp(const std::vector<float> &mean, const std::vector<float> &std,
+                                         const DataType &output_type)
+    : NormalizeOp(mean, std), output_type_(output_type) {}
+
+Status NormalizeHwcToChwOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  bool fused = input->Rank() == DEFAULT_IMAGE_RANK &&
+               (input->type() == DataType::DE_UINT8 || input->type() == DataType::DE_FLOAT32) &&
+               std_.size() == mean_.size() &&
+               (mean_.size() == 1 || mean_.size() == static_cast<size_t>(input->shape()[CHANNEL_INDEX]));
+  if (!fused) {
+    std::shared_ptr<Tensor> normalized;
+    RETURN_IF_NOT_OK(NormalizeOp::Compute(input, &normalized));
+    if (output_type_ == DataType::DE_FLOAT32) {
+      return HwcToChw(normalized, output);
+    }
+    std::shared_ptr<Tensor> swapped;
+    RETURN_IF_NOT_OK(HwcToChw(normalized, &swapped));
+    return TypeCast(swapped, output, output_type_);
+  }
+  // caller provided 1 mean/std value and there are more than one channel --> duplicate mean/std value
+  int64_t num_channels = input->shape()[CHANNEL_INDEX];
+  if (mean_.size() == 1 && num_channels != 1) {
+    return NormalizeHwcToChw(input, output, std::vector<float>(num_channels, mean_[0]),
+                             std::vector<float>(num_channels, std_[0]), output_type_);
+  }
+  return NormalizeHwcToChw(input, output, mean_, std_, output_type_);
+}
+
+Status NormalizeHwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  CHECK_FAIL_RETURN_UNEXPECTED(!inputs.empty(), "NormalizeHwcToChw: inputs size should be greater than 0.");
+  TensorShape in = inputs[0];
+  // Normalize expands a <H,W> image to <H,W,1>
+  if (in.Rank() == DEFAULT_IMAGE_RANK) {
+    (void)outputs.emplace_back(TensorShape{in[CHANNEL_INDEX], in[0], in[1]});
+  } else if (in.Rank() == MIN_IMAGE_DIMENSION) {
+    (void)outputs.emplace_back(TensorShape{1, in[0], in[1]});
+  }
+  if (!outputs.empty()) {
+    return Status::OK();
+  }
+  return Status(StatusCode::kMDUnexpectedError,
+                "NormalizeHwcToChw: invalid input shape, expected 2D or 3D input, but got input dimension is:" +
+                  std::to_string(in.Rank()));
+}
+
+Status NormalizeHwcToChwOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = output_type_;
+  return Status::OK();
+}
+
+void NormalizeHwcToChwOp::Print(std::ostream &out) const {
+  out << "NormalizeHwcToChwOp, output type: " << output_type_ << std::endl;
+  NormalizeOp::Print(out);
+}
+}  // namespace dataset
+}  // namespace mindspore
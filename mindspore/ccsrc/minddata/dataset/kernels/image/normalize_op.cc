@@ -40,6 +40,46 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
   return Normalize(input, output, mean_, std_);
 }
 
+Status NormalizeOp::BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) {
+  RETURN_UNEXPECTED_IF_NULL(output);
+  output->resize(input.size());
+  std::vector<float> mean;
+  std::vector<float> std;
+  for (size_t i = 0; i < input.size(); i++) {
+    CHECK_FAIL_RETURN_UNEXPECTED(input[i].size() == 1, "Normalize: the op is OneToOne, can only accept one tensor.");
+    const std::shared_ptr<Tensor> &image = input[i][0];
+    TensorRow &out_row = (*output)[i];
+    out_row.resize(1);
+    constexpr int64_t kHWCRank = 3;
+    constexpr int64_t kChannelIndex = 2;
+    int64_t num_channels = (image != nullptr && image->Rank() == kHWCRank) ? image->shape()[kChannelIndex] : 0;
+    bool fast_path = num_channels > 0 && image->Size() > 0 && image->type() == DataType::DE_UINT8 &&
+                     std_.size() == mean_.size() &&
+                     (mean_.size() == 1 || mean_.size() == static_cast<size_t>(num_channels));
+    if (!fast_path) {
+      RETURN_IF_NOT_OK(Compute(image, &out_row[0]));
+      continue;
+    }
+    if (mean.size() != static_cast<size_t>(num_channels)) {
+      // caller provided 1 mean/std value and there are more than one channel --> duplicate mean/std value
+      mean = mean_.size() == 1 ? std::vector<float>(num_channels, mean_[0]) : mean_;
+      std = std_.size() == 1 ? std::vector<float>(num_channels, std_[0]) : std_;
+    }
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(image->shape(), DataType(DataType::DE_FLOAT32), &out_row[0]));
+    const uint8_t *in_ptr = image->GetBuffer();
+    auto *out_ptr = reinterpret_cast<float *>(&(*out_row[0]->begin<float>()));
+    int64_t num_pixels = image->Size() / num_channels;
+    for (int64_t pixel = 0; pixel < num_pixels; pixel++) {
+      for (int64_t c = 0; c < num_channels; c++) {
+        out_ptr[c] = static_cast<float>(in_ptr[c]) / std[c] - mean[c];
+      }
+      in_ptr += num_channels;
+      out_ptr += num_channels;
+    }
+  }
+  return Status::OK();
+}
+
 void NormalizeOp::Print(std::ostream &out) const {
   out << "NormalizeOp, mean: ";
   for (const auto &m : mean_) {
@@ -36,9 +36,15 @@ class NormalizeOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  bool SupportBatch() const override { return true; }
+
+  // Normalize the HWC uint8 images of the batch in one pass with the mean and std expanded once, other images are
+  // normalized by Compute().
+  Status BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) override;
+
   std::string Name() const override { return kNormalizeOp; }
 
- private:
+ protected:
   std::vector<float> mean_;
   std::vector<float> std_;
 };
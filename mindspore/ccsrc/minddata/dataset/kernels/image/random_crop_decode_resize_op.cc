@@ -17,6 +17,7 @@
 #include <random>
 #include "minddata/dataset/kernels/image/image_utils.h"
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
 
 namespace mindspore {
@@ -52,8 +53,13 @@ Status RandomCropDecodeResizeOp::Compute(const TensorRow &input, TensorRow *outp
       if (i == 0) {
         RETURN_IF_NOT_OK(GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width));
       }
+      // Decode the crop close to the target size instead of at full resolution if it is enabled
+      int scale_denom = 1;
+      if (GlobalContext::config_manager()->enable_jpeg_dct_scaling()) {
+        scale_denom = GetJpegScaleDenom(crop_width, crop_height, target_width_, target_height_);
+      }
       std::shared_ptr<Tensor> decoded_tensor = nullptr;
-      RETURN_IF_NOT_OK(JpegCropAndDecode(input[i], &decoded_tensor, x, y, crop_width, crop_height));
+      RETURN_IF_NOT_OK(JpegCropAndDecode(input[i], &decoded_tensor, x, y, crop_width, crop_height, scale_denom));
       RETURN_IF_NOT_OK(Resize(decoded_tensor, &(*output)[i], target_height_, target_width_, 0.0, 0.0, interpolation_));
     }
   }
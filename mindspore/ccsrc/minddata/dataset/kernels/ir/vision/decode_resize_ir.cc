@@ -0,0 +1,76 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/ir/vision/decode_resize_ir.h"
+
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
+#endif
+
+#include "minddata/dataset/kernels/ir/validators.h"
+#include "minddata/dataset/util/validators.h"
+
+namespace mindspore {
+namespace dataset {
+namespace vision {
+#ifndef ENABLE_ANDROID
+// DecodeResizeOperation
+DecodeResizeOperation::DecodeResizeOperation(const std::vector<int32_t> &size, InterpolationMode interpolation)
+    : ResizeOperation(size, interpolation) {}
+
+DecodeResizeOperation::DecodeResizeOperation(const ResizeOperation &base) : ResizeOperation(base) {}
+
+DecodeResizeOperation::~DecodeResizeOperation() = default;
+
+std::string DecodeResizeOperation::Name() const { return kDecodeResizeOperation; }
+
+std::shared_ptr<TensorOp> DecodeResizeOperation::Build() {
+  constexpr size_t dimension_zero = 0;
+  constexpr size_t dimension_one = 1;
+  constexpr size_t size_two = 2;
+
+  // If size is a single value, the smaller edge of the image will be
+  // resized to this value with the same image aspect ratio.
+  int32_t height = size_[dimension_zero];
+  int32_t width = 0;
+
+  // User specified the width value.
+  if (size_.size() == size_two) {
+    width = size_[dimension_one];
+  }
+
+  return std::make_shared<DecodeResizeOp>(height, width, interpolation_);
+}
+
+Status DecodeResizeOperation::to_json(nlohmann::json *out_json) {
+  nlohmann::json args;
+  args["size"] = size_;
+  args["interpolation"] = interpolation_;
+  *out_json = args;
+  return Status::OK();
+}
+
+Status DecodeResizeOperation::from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation) {
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "size", kDecodeResizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "interpolation", kDecodeResizeOperation));
+  std::vector<int32_t> size = op_params["size"];
+  InterpolationMode interpolation = static_cast<InterpolationMode>(op_params["interpolation"]);
+  *operation = std::make_shared<vision::DecodeResizeOperation>(size, interpolation);
+  return Status::OK();
+}
+#endif
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
@@ -51,7 +51,7 @@ class NormalizeOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
- private:
+ protected:
   std::vector<float> mean_;
   std::vector<float> std_;
 };
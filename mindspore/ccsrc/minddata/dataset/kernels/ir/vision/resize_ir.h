@@ -51,7 +51,7 @@ class ResizeOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
- private:
+ protected:
   std::vector<int32_t> size_;
   InterpolationMode interpolation_;
 };
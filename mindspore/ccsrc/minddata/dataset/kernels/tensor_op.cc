@@ -47,6 +47,15 @@ Status TensorOp::Compute(const TensorRow &input, TensorRow *output) {
                 "Is this TensorOp oneToOne? If no, please implement this Compute() in the derived class.");
 }
 
+Status TensorOp::BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) {
+  RETURN_UNEXPECTED_IF_NULL(output);
+  output->resize(input.size());
+  for (size_t i = 0; i < input.size(); i++) {
+    RETURN_IF_NOT_OK(Compute(input[i], &(*output)[i]));
+  }
+  return Status::OK();
+}
+
 Status TensorOp::Compute(const std::shared_ptr<DeviceTensor> &input, std::shared_ptr<DeviceTensor> *output) {
   IO_CHECK(input, output);
   return Status(StatusCode::kMDUnexpectedError,
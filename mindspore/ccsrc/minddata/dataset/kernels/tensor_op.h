@@ -59,6 +59,7 @@ constexpr char kAutoAugmentOp[] = "AutoAugmentOp";
 constexpr char kAutoContrastOp[] = "AutoContrastOp";
 constexpr char kBoundingBoxAugmentOp[] = "BoundingBoxAugmentOp";
 constexpr char kDecodeOp[] = "DecodeOp";
+constexpr char kDecodeResizeOp[] = "DecodeResizeOp";
 constexpr char kCenterCropOp[] = "CenterCropOp";
 constexpr char kConvertColorOp[] = "ConvertColorOp";
 constexpr char kCutMixBatchOp[] = "CutMixBatchOp";
@@ -78,6 +79,7 @@ constexpr char kHwcToChwOp[] = "HWC2CHWOp";
 constexpr char kInvertOp[] = "InvertOp";
 constexpr char kMixUpBatchOp[] = "MixUpBatchOp";
 constexpr char kNormalizeOp[] = "NormalizeOp";
+constexpr char kNormalizeHwcToChwOp[] = "NormalizeHwcToChwOp";
 constexpr char kNormalizePadOp[] = "NormalizePadOp";
 constexpr char kPadOp[] = "PadOp";
 constexpr char kRandomAdjustSharpnessOp[] = "RandomAdjustSharpnessOp";
@@ -247,6 +249,18 @@ class TensorOp {
   // @return Status
   virtual Status Compute(const std::shared_ptr<DeviceTensor> &input, std::shared_ptr<DeviceTensor> *output);
 
+  // Returns true if the TensorOp implements BatchCompute() to process the rows of a batch in one call, which
+  // saves the per-row dispatch and shares the per-call preparation among the rows.
+  // @return true/false
+  virtual bool SupportBatch() const { return false; }
+
+  // Perform an operation on a batch of rows, and produce one row for each input row.
+  // The default implementation calls Compute() on the rows one by one.
+  // @param input is a vector of TensorRow (pass by const reference).
+  // @param output is the address to an empty vector of TensorRow.
+  // @return Status
+  virtual Status BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output);
+
   // Returns true oif the TensorOp takes one input and returns one output.
   // @return true/false
   bool OneToOne() { return NumInput() == 1 && NumOutput() == 1; }
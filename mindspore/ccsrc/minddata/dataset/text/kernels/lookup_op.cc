@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/kernels/data/data_utils.h"
 #include "minddata/dataset/text/kernels/lookup_op.h"
+#include "minddata/dataset/text/vocab_trie.h"
 
 namespace mindspore {
 namespace dataset {
@@ -29,8 +30,10 @@ Status LookupOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
 
   std::vector<WordIdType> word_ids;
   word_ids.reserve(input->Size());
+  // take the trie of the current words, the vocab may be appended after the op is created
+  auto trie = VocabTrie::Of(*vocab_);
   for (auto itr = input->begin<std::string_view>(); itr != input->end<std::string_view>(); ++itr) {
-    WordIdType word_id = vocab_->TokensToIds(std::string(*itr));
+    WordIdType word_id = trie->Find(*itr);
     word_ids.emplace_back(word_id == Vocab::kNoTokenExists ? default_id_ : word_id);
     CHECK_FAIL_RETURN_UNEXPECTED(word_ids.back() != Vocab::kNoTokenExists,
                                  "Lookup: invalid data, token: \"" + std::string(*itr) +
@@ -35,20 +35,25 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       max_bytes_per_token_(max_bytes_per_token),
       unknown_token_(unknown_token) {}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
+Status WordpieceTokenizerOp::LookupWord(const VocabTrie &trie, int32_t suffix_node, const std::string &input_token,
+                                        const RuneStrArray &runes, const int start, bool *out_found,
+                                        int *out_end) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "WordpieceTokenizer: LookupWord Out of range");
   *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
-    }
-    if (vocab_->TokensToIds(word) != Vocab::kNoTokenExists) {
+  int32_t node = start > 0 ? suffix_node : VocabTrie::kRoot;
+  if (node < 0) {
+    return Status::OK();
+  }
+  // walk the trie rune by rune from the start, the last word on the path is the longest one
+  std::string_view token(input_token);
+  size_t i = 0;
+  while (i < runes.size() && static_cast<int>(runes[i].offset) < start) {
+    ++i;
+  }
+  for (; i < runes.size() && trie.Walk(token.substr(runes[i].offset, runes[i].len), &node); ++i) {
+    if (trie.Value(node) != Vocab::kNoTokenExists) {
       *out_found = true;
-      break;
+      *out_end = runes[i].offset + runes[i].len;
     }
   }
   return Status::OK();
@@ -81,8 +86,9 @@ Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const in
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
-                                       std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+Status WordpieceTokenizerOp::GetTokens(const VocabTrie &trie, int32_t suffix_node, const std::string &input_token,
+                                       const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+                                       std::vector<uint32_t> *offsets_start,
                                        std::vector<uint32_t> *offsets_limit) const {
   if (input_token.size() > static_cast<int>(max_bytes_per_token_)) {
     offsets_start->push_back(basic_start);
@@ -102,7 +108,7 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
   int end = 0;
   for (int start = 0; start < static_cast<int>(input_token.size());) {
     bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
+    RETURN_IF_NOT_OK(LookupWord(trie, suffix_node, input_token, runes, start, &found, &end));
     if (found) {
       RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
       offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
@@ -117,6 +123,7 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
 
 Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
+  RETURN_UNEXPECTED_IF_NULL(vocab_);
   if (input[0]->Rank() > 1 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED(
       "WordpieceTokenizer: The input shape should be 1D scalar the input datatype should be string.");
@@ -125,13 +132,20 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
   std::vector<std::string> out_tokens;
   std::vector<uint32_t> offsets_start, offsets_limit;
   std::shared_ptr<Tensor> token_tensor;
+  // take the trie of the current words, the vocab may be appended after the op is created
+  auto trie = VocabTrie::Of(*vocab_);
+  int32_t suffix_node = VocabTrie::kRoot;
+  if (!trie->Walk(suffix_indicator_, &suffix_node)) {
+    suffix_node = -1;
+  }
   for (auto iter = input[0]->begin<std::string_view>(); iter != input[0]->end<std::string_view>(); iter++) {
     uint32_t basic_start = 0;
     std::vector<std::string> temp_tokens;
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
+    RETURN_IF_NOT_OK(
+      GetTokens(*trie, suffix_node, std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
     out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
     count++;
   }
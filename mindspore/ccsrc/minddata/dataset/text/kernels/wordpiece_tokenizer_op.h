@@ -26,6 +26,7 @@
 #include "minddata/dataset/include/dataset/text.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/text/kernels/tokenizer_op.h"
+#include "minddata/dataset/text/vocab_trie.h"
 #include "minddata/dataset/util/status.h"
 
 using cppjieba::DecodeRunesInString;
@@ -51,9 +52,10 @@ class WordpieceTokenizerOp : public TokenizerOp {
                     std::vector<std::string> *out_token) const;
   Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                       std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
-                    int *out_end) const;
-  Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+  Status LookupWord(const VocabTrie &trie, int32_t suffix_node, const std::string &input_token,
+                    const RuneStrArray &runes, const int start, bool *out_found, int *out_end) const;
+  Status GetTokens(const VocabTrie &trie, int32_t suffix_node, const std::string &input_token,
+                   const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                    std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
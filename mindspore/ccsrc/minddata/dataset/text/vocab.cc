@@ -16,11 +16,14 @@
 
 #include <algorithm>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 #include "minddata/dataset/include/dataset/text.h"
+#include "minddata/dataset/text/vocab_trie.h"
 #include "minddata/dataset/util/status.h"
 #include "utils/file_utils.h"
 #ifndef ENABLE_ANDROID
@@ -31,7 +34,30 @@
 
 namespace mindspore {
 namespace dataset {
-Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) { word2id_ = std::move(word2id); }
+struct Vocab::Data {
+  std::mutex trie_mutex;                  // serializes building the trie
+  std::shared_ptr<const VocabTrie> trie;  // built on the first use, dropped when a word is added, accessed atomically
+};
+
+Vocab::Vocab() : data_(std::make_shared<Data>()) {}
+
+Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) : data_(std::make_shared<Data>()) {
+  word2id_ = std::move(word2id);
+}
+
+Vocab::Vocab(const Vocab &other)
+    : word2id_(other.word2id_), id2word_(other.id2word_), data_(std::make_shared<Data>()) {}
+
+Vocab &Vocab::operator=(const Vocab &other) {
+  if (this != &other) {
+    word2id_ = other.word2id_;
+    id2word_ = other.id2word_;
+    data_ = std::make_shared<Data>();
+  }
+  return *this;
+}
+
+Vocab::~Vocab() = default;
 
 WordIdType Vocab::TokensToIds(const WordType &word) const {
   auto itr = word2id_.find(word);
@@ -44,6 +70,22 @@ std::vector<WordIdType> Vocab::TokensToIds(const std::vector<WordType> &words) c
   return ids;
 }
 
+WordIdType Vocab::LookupToken(std::string_view word) const { return VocabTrie::Of(*this)->Find(word); }
+
+std::shared_ptr<const VocabTrie> VocabTrie::Of(const Vocab &vocab) {
+  auto trie = std::atomic_load(&vocab.data_->trie);
+  if (trie != nullptr) {
+    return trie;
+  }
+  std::lock_guard<std::mutex> lock(vocab.data_->trie_mutex);
+  trie = std::atomic_load(&vocab.data_->trie);
+  if (trie == nullptr) {
+    trie = std::make_shared<VocabTrie>(vocab.word2id_);
+    std::atomic_store(&vocab.data_->trie, trie);
+  }
+  return trie;
+}
+
 WordType Vocab::IdsToTokens(const WordIdType &id) {
   // lazy initialization, since I think it's not common use but waste memory
   if (id2word_.empty()) {
@@ -70,6 +112,7 @@ std::vector<WordType> Vocab::IdsToTokens(const std::vector<WordIdType> &ids) {
 void Vocab::AppendWord(const std::string &word) {
   if (word2id_.find(word) == word2id_.end()) {
     word2id_[word] = static_cast<WordIdType>(word2id_.size());
+    std::atomic_store(&data_->trie, std::shared_ptr<const VocabTrie>());
   }
 }
 
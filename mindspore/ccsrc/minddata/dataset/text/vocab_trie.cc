@@ -0,0 +1,115 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/text/vocab_trie.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+VocabTrie::VocabTrie(const std::unordered_map<WordType, WordIdType> &word2id) {
+  std::vector<std::pair<std::string_view, WordIdType>> words(word2id.begin(), word2id.end());
+  // the words with the same prefix are next to each other, and a prefix comes before the longer words
+  std::sort(words.begin(), words.end());
+  Reserve(kRoot);
+  check_[kRoot] = kRoot;
+
+  // the words of [begin, end) share the path to the node, which has the given depth
+  struct Range {
+    int32_t node;
+    size_t depth;
+    size_t begin;
+    size_t end;
+  };
+  std::vector<Range> ranges = {{kRoot, 0, 0, words.size()}};
+  std::vector<int32_t> codes;
+  std::vector<size_t> bounds;
+  while (!ranges.empty()) {
+    auto range = ranges.back();
+    ranges.pop_back();
+    size_t i = range.begin;
+    if (i < range.end && words[i].first.size() == range.depth) {
+      value_[range.node] = words[i].second;
+      ++i;
+    }
+    codes.clear();
+    bounds.clear();
+    for (; i < range.end; ++i) {
+      int32_t code = static_cast<unsigned char>(words[i].first[range.depth]) + 1;
+      if (codes.empty() || codes.back() != code) {
+        codes.push_back(code);
+        bounds.push_back(i);
+      }
+    }
+    if (codes.empty()) {
+      continue;
+    }
+    bounds.push_back(range.end);
+    int32_t base = FindBase(codes);
+    base_[range.node] = base;
+    for (size_t k = 0; k < codes.size(); ++k) {
+      check_[base + codes[k]] = range.node;
+    }
+    for (size_t k = 0; k < codes.size(); ++k) {
+      ranges.push_back({base + codes[k], range.depth + 1, bounds[k], bounds[k + 1]});
+    }
+  }
+
+  // drop the free nodes at the end, a transition beyond the arrays fails anyway
+  size_t size = check_.size();
+  while (size > 1 && check_[size - 1] < 0) {
+    --size;
+  }
+  base_.resize(size);
+  check_.resize(size);
+  value_.resize(size);
+  base_.shrink_to_fit();
+  check_.shrink_to_fit();
+  value_.shrink_to_fit();
+}
+
+int32_t VocabTrie::FindBase(const std::vector<int32_t> &codes) {
+  // codes are in ascending order, the first child takes the first free node which fits all the children
+  bool first = true;
+  for (int64_t pos = next_free_;; ++pos) {
+    Reserve(pos);
+    if (check_[pos] >= 0) {
+      continue;
+    }
+    if (first) {
+      next_free_ = pos;
+      first = false;
+    }
+    int64_t base = pos - codes.front();
+    Reserve(base + codes.back());
+    if (std::all_of(codes.begin() + 1, codes.end(), [this, base](int32_t code) { return check_[base + code] < 0; })) {
+      return static_cast<int32_t>(base);
+    }
+  }
+}
+
+void VocabTrie::Reserve(int64_t node) {
+  if (node < static_cast<int64_t>(check_.size())) {
+    return;
+  }
+  size_t size = std::max(static_cast<size_t>(node) + 1, check_.size() * 2);
+  base_.resize(size, 0);
+  check_.resize(size, -1);
+  value_.resize(size, Vocab::kNoTokenExists);
+}
+}  // namespace dataset
+}  // namespace mindspore
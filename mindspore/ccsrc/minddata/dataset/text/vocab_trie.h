@@ -0,0 +1,97 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/include/dataset/text.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Immutable double-array trie of the words of a vocab.
+///
+/// A node is an index of the arrays. The child of node s by byte c is node t = base_[s] + c + 1 if check_[t] == s,
+/// so a word is looked up by one array access per byte, without hashing or copying it. The path of a word can also
+/// be walked piece by piece, which finds the longest word of a prefix in a single pass.
+class VocabTrie {
+ public:
+  static constexpr int32_t kRoot = 0;
+
+  /// Constructor.
+  /// \param[in] word2id A map between words and ids.
+  explicit VocabTrie(const std::unordered_map<WordType, WordIdType> &word2id);
+
+  /// Destructor.
+  ~VocabTrie() = default;
+
+  /// \brief Get the trie of the current words of a vocab. It is built on the first call and shared by the callers
+  ///     until a word is added, the calls after it is built take no lock.
+  /// \param[in] vocab The vocab.
+  /// \return The trie of the words.
+  static std::shared_ptr<const VocabTrie> Of(const Vocab &vocab);
+
+  /// \brief Look up the id of a word.
+  /// \param[in] word Word to be looked up.
+  /// \return ID of the word, Vocab::kNoTokenExists if the word doesn't exist.
+  WordIdType Find(std::string_view word) const {
+    int32_t node = kRoot;
+    return Walk(word, &node) ? value_[node] : Vocab::kNoTokenExists;
+  }
+
+  /// \brief Move along the bytes of a piece.
+  /// \param[in] piece Bytes to walk along.
+  /// \param[in, out] node The node to start from, and the node reached if successful.
+  /// \return false if no word starts with the path, then the node is unchanged.
+  bool Walk(std::string_view piece, int32_t *node) const {
+    int32_t s = *node;
+    for (unsigned char c : piece) {
+      int64_t t = static_cast<int64_t>(base_[s]) + c + 1;
+      if (t <= 0 || t >= static_cast<int64_t>(check_.size()) || check_[t] != s) {
+        return false;
+      }
+      s = static_cast<int32_t>(t);
+    }
+    *node = s;
+    return true;
+  }
+
+  /// \brief ID of the word ending at a node, Vocab::kNoTokenExists if the path is only a prefix.
+  WordIdType Value(int32_t node) const { return value_[node]; }
+
+  /// \brief Number of the nodes.
+  size_t Size() const { return check_.size(); }
+
+ private:
+  /// \brief Find a base for the children of a node, all their nodes should be free.
+  int32_t FindBase(const std::vector<int32_t> &codes);
+
+  /// \brief Grow the arrays to hold the node.
+  void Reserve(int64_t node);
+
+  std::vector<int32_t> base_;
+  std::vector<int32_t> check_;  // parent of the node, -1 if the node is free
+  std::vector<WordIdType> value_;
+  int64_t next_free_ = 1;  // the nodes before it are all used
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_BUFFER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_BUFFER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+constexpr size_t kCacheLineSize = 64;
+
+// A bounded lock free ring buffer with a single producer and a single consumer. The producer and the consumer only
+// publish their index with one atomic store per push or pop, and a batch of elements is published with one store as
+// well. The consumer may be different threads over time as long as they are serialized by the caller with
+// acquire/release ordering.
+template <typename T>
+class SpscRingBuffer {
+ public:
+  // @param capacity - the capacity is rounded up to a power of 2
+  explicit SpscRingBuffer(size_t capacity) : head_(0), tail_(0), cached_head_(0), cached_tail_(0) {
+    size_t sz = 1;
+    while (sz < capacity) {
+      sz <<= 1;
+    }
+    slots_.resize(sz);
+    mask_ = sz - 1;
+  }
+
+  ~SpscRingBuffer() = default;
+
+  // Called by the producer, move in up to n elements
+  // @return size_t - the number of elements pushed, 0 if the buffer is full
+  size_t TryPush(T *elements, size_t n) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    // Only look at the index of the consumer if the cached one says the buffer is full
+    if (tail - cached_head_ + n > slots_.size()) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    size_t num = std::min(n, static_cast<size_t>(slots_.size() - (tail - cached_head_)));
+    for (size_t i = 0; i < num; ++i) {
+      slots_[(tail + i) & mask_] = std::move(elements[i]);
+    }
+    if (num > 0) {
+      tail_.store(tail + num, std::memory_order_release);
+    }
+    return num;
+  }
+
+  bool TryPush(T *element) { return TryPush(element, 1) == 1; }
+
+  // Called by the consumer, move out up to n elements
+  // @return size_t - the number of elements popped, 0 if the buffer is empty
+  size_t TryPop(T *elements, size_t n) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    // Only look at the index of the producer if the cached one says there is not enough data
+    if (cached_tail_ - head < n) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    size_t num = std::min(n, static_cast<size_t>(cached_tail_ - head));
+    for (size_t i = 0; i < num; ++i) {
+      elements[i] = std::move(slots_[(head + i) & mask_]);
+    }
+    if (num > 0) {
+      head_.store(head + num, std::memory_order_release);
+    }
+    return num;
+  }
+
+  bool TryPop(T *element) { return TryPop(element, 1) == 1; }
+
+  // @return size_t - the number of elements in the buffer, it is only a snapshot while the buffer is in use
+  size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+
+  size_t capacity() const { return slots_.size(); }
+
+  // Drop all the elements, must not be called while the buffer is in use
+  void Reset() {
+    for (auto &slot : slots_) {
+      slot = T();
+    }
+    head_ = 0;
+    tail_ = 0;
+    cached_head_ = 0;
+    cached_tail_ = 0;
+  }
+
+ private:
+  std::vector<T> slots_;
+  size_t mask_;
+  // The indexes keep growing and are masked when the slots are accessed. The two sides are kept on their own cache
+  // lines so the producer and the consumer do not invalidate each other on every operation.
+  alignas(kCacheLineSize) std::atomic<uint64_t> head_;
+  alignas(kCacheLineSize) std::atomic<uint64_t> tail_;
+  alignas(kCacheLineSize) uint64_t cached_head_;  // Producer's copy of head_
+  alignas(kCacheLineSize) uint64_t cached_tail_;  // Consumer's copy of tail_
+};
+
+// Wait strategy for the lock free structures. It spins with yield for a while, then sleeps a little between the
+// retries so an idle pipeline does not burn the cpu.
+class SpinBackoff {
+ public:
+  SpinBackoff() : count_(0) {}
+
+  void Pause() {
+    if (count_ < kYieldCount) {
+      ++count_;
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(kSleepMicroSeconds));
+    }
+  }
+
+  void Reset() { count_ = 0; }
+
+ private:
+  static constexpr int32_t kYieldCount = 128;
+  static constexpr int32_t kSleepMicroSeconds = 50;
+  int32_t count_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_BUFFER_H_
@@ -124,6 +124,22 @@ void BindShardWriter(py::module *m) {
            THROW_IF_ERROR(s.SetPageSize(page_size));
            return SUCCESS;
          })
+    .def("set_column_page",
+         [](ShardWriter &s, bool column_page) {
+           THROW_IF_ERROR(s.SetColumnPage(column_page));
+           return SUCCESS;
+         })
+    .def("set_pipeline",
+         [](ShardWriter &s, bool pipeline, int64_t max_memory) {
+           THROW_IF_ERROR(s.SetPipeline(pipeline, max_memory));
+           return SUCCESS;
+         })
+    .def("set_mmap_index",
+         [](ShardWriter &s, bool mmap_index) {
+           THROW_IF_ERROR(s.SetMmapIndex(mmap_index));
+           return SUCCESS;
+         })
+    .def("is_index_written", &ShardWriter::IsIndexWritten)
     .def("set_shard_header",
          [](ShardWriter &s, std::shared_ptr<ShardHeader> header_data) {
            THROW_IF_ERROR(s.SetShardHeader(header_data));
@@ -187,7 +203,7 @@ void BindShardReader(const py::module *m) {
 
 void BindShardIndexGenerator(const py::module *m) {
   (void)py::class_<ShardIndexGenerator>(*m, "ShardIndexGenerator", py::module_local())
-    .def(py::init<const std::string &, bool>())
+    .def(py::init<const std::string &, bool, bool>())
     .def("build",
          [](ShardIndexGenerator &s) {
            THROW_IF_ERROR(s.Build());
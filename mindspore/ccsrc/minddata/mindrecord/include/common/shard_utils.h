@@ -90,6 +90,9 @@ const int kThreadNumber = 14;
 const uint64_t kDefaultHeaderSize = 1 << 24;  // 16MB
 const uint64_t kDefaultPageSize = 1 << 25;    // 32MB
 
+// Max bytes of the rows queued in the pipeline of the writer
+const int64_t kDefaultPipelineMemory = 1 << 30;  // 1GB
+
 // HeaderSize [16KB, 128MB]
 const int kMinHeaderSize = 1 << 14;  // 16KB
 const int kMaxHeaderSize = 1 << 27;  // 128MB
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMN_PAGE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMN_PAGE_H_
+
+#include <string>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_column.h"
+
+namespace mindspore {
+namespace mindrecord {
+const uint64_t kColumnPageRowsLen = 8;
+const uint64_t kColumnPageColumnsLen = 4;
+const uint64_t kColumnChunkEntryLen = 17;   // encoding, offset and size of a chunk
+const uint64_t kMaxColumnStatsLength = 64;  // longer strings are not kept in the statistics
+
+enum ColumnEncoding : uint8_t { kColumnPlain = 0, kColumnDeltaVarint = 1, kColumnDictionary = 2 };
+
+/// \brief the location of a column in the column page, the offset is from the beginning of the page
+struct ColumnChunk {
+  ColumnEncoding encoding;
+  uint64_t offset;
+  uint64_t size;
+};
+
+/// \brief Codec of the column page, which keeps the non-blob fields of a row group column by column.
+///   Layout: [uint64 number of rows][uint32 number of columns][{uint8 encoding, uint64 offset, uint64 size} per
+///   column][chunk of each column]. Integers are stored as varint deltas to the minimum of the page, strings with a
+///   dictionary if they repeat, and the others as they are. The min and max of each column are kept in the page json
+///   so that the reader can skip the page.
+class __attribute__((visibility("default"))) ShardColumnPage {
+ public:
+  /// \brief the columns of the page are the non-blob fields of the schema, sorted by name
+  explicit ShardColumnPage(const json &schema);
+
+  ~ShardColumnPage() = default;
+
+  const std::vector<std::string> &GetColumns() const { return columns_; }
+
+  /// \brief get the id of the column in the page, -1 if the column is not in the page
+  int GetColumnId(const std::string &column) const;
+
+  /// \brief size of the number of rows and the chunk directory at the beginning of the page
+  uint64_t GetHeadSize() const {
+    return kColumnPageRowsLen + kColumnPageColumnsLen + columns_.size() * kColumnChunkEntryLen;
+  }
+
+  /// \brief encode the rows [start_row, end_row) into a column page
+  /// \param[in] rows the raw json rows
+  /// \param[out] page the serialized page
+  /// \param[out] column_stats the min and max of the columns
+  /// \return Status, an error if a row does not have exactly the columns of the page with the type of the schema
+  Status Encode(const std::vector<json> &rows, int start_row, int end_row, std::vector<uint8_t> *page,
+                json *column_stats) const;
+
+  /// \brief decode the number of rows and the chunk directory from the head of the page
+  Status DecodeHead(const std::vector<uint8_t> &head, uint64_t *num_rows, std::vector<ColumnChunk> *chunks) const;
+
+  /// \brief decode a column from its chunk
+  /// \param[in] column_id the id of the column in the page
+  /// \param[in] chunk the location and the encoding of the column
+  /// \param[in] data the bytes of the chunk
+  /// \param[in] num_rows the number of rows in the page
+  /// \param[out] values the values of the rows
+  Status DecodeColumn(int column_id, const ColumnChunk &chunk, const std::vector<uint8_t> &data, uint64_t num_rows,
+                      std::vector<json> *values) const;
+
+  /// \brief check with the statistics of a page if it may have a row whose column equals the value
+  bool MayContain(const json &column_stats, const std::string &column, const std::string &value) const;
+
+ private:
+  Status EncodeColumn(int column_id, const std::vector<json> &rows, int start_row, int end_row,
+                      ColumnEncoding *encoding, std::vector<uint8_t> *chunk, json *stats) const;
+
+  std::vector<std::string> columns_;
+  std::vector<ColumnDataType> column_types_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMN_PAGE_H_
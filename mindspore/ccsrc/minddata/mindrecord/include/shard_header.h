@@ -111,6 +111,12 @@ class __attribute__((visibility("default"))) ShardHeader {
 
   Status GetPageByGroupId(const int &group_id, const int &shard_id, std::shared_ptr<Page> *page_ptr);
 
+  /// \brief get the column pages of a shard in the order of rows
+  /// \param[in] shard_id the id of shard
+  /// \param[out] column_pages the column pages
+  /// \return true if the column pages cover all the rows of the shard, an empty shard is covered as well
+  bool GetColumnPages(const int &shard_id, std::vector<std::shared_ptr<Page>> *column_pages);
+
   std::vector<std::string> GetShardAddresses() const { return shard_addresses_; }
 
   int GetShardCount() const { return shard_count_; }
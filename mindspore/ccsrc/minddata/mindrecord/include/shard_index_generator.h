@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 #include "minddata/mindrecord/include/shard_header.h"
+#include "minddata/mindrecord/include/shard_mmap_index.h"
 #include "./sqlite3.h"
 
 namespace mindspore {
@@ -34,13 +35,16 @@ using INDEX_FIELDS = std::vector<std::tuple<std::string, std::string, std::strin
 using ROW_DATA = std::vector<std::vector<std::tuple<std::string, std::string, std::string>>>;
 class __attribute__((visibility("default"))) ShardIndexGenerator {
  public:
-  explicit ShardIndexGenerator(const std::string &file_path, bool append = false);
+  /// \param[in] file_path the path of any mindrecord file in the dataset
+  /// \param[in] append append to the existing mindrecord files or not
+  /// \param[in] mmap_index write the mmap index of each shard besides the database or not
+  explicit ShardIndexGenerator(const std::string &file_path, bool append = false, bool mmap_index = false);
 
   Status Build();
 
   static Status GenerateFieldName(const std::pair<uint64_t, std::string> &field, std::shared_ptr<std::string> *fn_ptr);
 
-  ~ShardIndexGenerator() {}
+  ~ShardIndexGenerator();
 
   /// \brief fetch value in json by field name
   /// \param[in] field
@@ -60,6 +64,31 @@ class __attribute__((visibility("default"))) ShardIndexGenerator {
 
   static Status Finalize(const std::vector<std::string> file_names);
 
+  /// \brief create the databases to be filled while the mindrecord files are written, instead of calling Build and
+  ///        WriteToDatabase after they are committed
+  /// \param[in] header the header of the mindrecord files being written
+  /// \param[in] file_paths the full paths of the mindrecord files, indexed by shard id
+  /// \return Status
+  Status OpenIncremental(const ShardHeader &header, const std::vector<std::string> &file_paths);
+
+  /// \brief insert the rows of a shard, the index fields of each row follow its location in the same order as the
+  ///        rows generated by WriteToDatabase
+  /// \param[in] shard_no id of the shard
+  /// \param[in] rows the rows to insert
+  /// \return Status
+  Status WriteRows(int shard_no, const ROW_DATA &rows);
+
+  /// \brief commit the databases and write the mmap indexes, called after the mindrecord files are committed
+  /// \return Status
+  Status CloseIncremental();
+
+  /// \brief append the index fields of a row to its row data
+  /// \param[in] schema_detail the raw data of the row, one json per schema
+  /// \param[out] row_data the row data to bind to the insert statement
+  /// \return Status
+  Status AddIndexFieldByRawData(const std::vector<json> &schema_detail,
+                                std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
+
  private:
   static int Callback(void *not_used, int argc, char **argv, char **az_col_name);
 
@@ -102,13 +131,11 @@ class __attribute__((visibility("default"))) ShardIndexGenerator {
   Status AddBlobPageInfo(std::vector<std::tuple<std::string, std::string, std::string>> &row_data,
                          const std::shared_ptr<Page> cur_blob_page, uint64_t &cur_blob_page_offset, std::fstream &in);
 
-  Status AddIndexFieldByRawData(const std::vector<json> &schema_detail,
-                                std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
-
   void DatabaseWriter();  // worker thread
 
   std::string file_path_;
   bool append_;
+  bool mmap_index_;
   ShardHeader shard_header_;
   uint64_t page_size_;
   uint64_t header_size_;
@@ -116,6 +143,12 @@ class __attribute__((visibility("default"))) ShardIndexGenerator {
   std::atomic_int task_;
   std::atomic_bool write_success_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
+
+  // databases filled while the mindrecord files are written, see OpenIncremental
+  std::vector<std::string> file_paths_;
+  std::vector<sqlite3 *> dbs_;
+  std::vector<ShardMmapIndexBuilder> mmap_index_builders_;
+  std::string insert_sql_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,150 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MMAP_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MMAP_INDEX_H_
+
+#include <array>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+// The mmap index is an alternative to the sqlite index of a shard, it is saved as "<mindrecord file>.idx":
+//   header  | magic "MSMRIDX1" | uint32 version | uint32 endian tag | uint64 file size | int64 file mtime |
+//             uint64 row number | uint64 field number | uint64 offset of the string pool
+//   fields  | {uint64 type, uint64 name length, name} of each index field
+//   rows    | uint64 columns of kIndexRowColumns of each row, sorted by ROW_ID
+//   values  | {uint64 value of each row, uint64 rows sorted by the value} of each index field
+//   strings | {uint64 length, bytes} of each string value, a string value is the offset in the pool
+// The rows are looked up by binary search, and the index is ignored if the mindrecord file is changed.
+const char kMmapIndexSuffix[] = ".idx";
+const char kMmapIndexMagic[] = "MSMRIDX1";
+const uint64_t kMmapIndexMagicSize = 8;
+const uint32_t kMmapIndexVersion = 1;
+const uint32_t kMmapIndexEndianTag = 0x01020304;
+const uint64_t kMmapIndexHeaderSize = 56;
+
+const uint64_t kIndexRowColumnCount = 8;
+const std::array<std::string, kIndexRowColumnCount> kIndexRowColumns = {
+  "ROW_ID",       "ROW_GROUP_ID",     "PAGE_ID_RAW",         "PAGE_OFFSET_RAW", "PAGE_OFFSET_RAW_END",
+  "PAGE_ID_BLOB", "PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"};
+const uint64_t kIndexRowIdColumn = 0;
+const uint64_t kIndexBlobPageColumn = 5;
+
+enum IndexFieldType : uint64_t { kIndexInteger = 0, kIndexNumeric = 1, kIndexText = 2 };
+
+/// \brief query of the mmap index, the records are returned in the order of ROW_ID like the sqlite index
+struct IndexQuery {
+  std::vector<std::string> columns;              // selected columns, e.g. PAGE_ID_RAW or label_0, empty for fields
+  int64_t row_id = -1;                           // only the row with the id if it is not negative
+  int64_t blob_page_id = -1;                     // only the rows in the blob page if it is not negative
+  std::pair<std::string, std::string> criteria;  // only the rows whose index field equals the value
+  bool distinct = false;                         // drop a record if it equals the previous one
+};
+
+/// \brief Read-only mmap index of a shard. The file is mapped into memory if possible, otherwise it is read at once.
+class __attribute__((visibility("default"))) ShardMmapIndex {
+ public:
+  /// \param[in] file the path of the mindrecord file
+  explicit ShardMmapIndex(const std::string &file);
+
+  ~ShardMmapIndex();
+
+  /// \brief open the index of the mindrecord file
+  /// \return Status, an error if the index is missing, broken or out of date
+  Status Open();
+
+  uint64_t GetRowCount() const { return num_rows_; }
+
+  /// \brief select the columns of the rows matching the query, the values are text like the sqlite callback
+  Status Select(const IndexQuery &query, std::vector<std::vector<std::string>> *records) const;
+
+  /// \brief get the distinct values of an index field in ascending order
+  Status GetDistinctValues(const std::string &field, std::vector<std::string> *values) const;
+
+  static std::string IndexPath(const std::string &file) { return file + kMmapIndexSuffix; }
+
+ private:
+  struct IndexField {
+    std::string name;
+    IndexFieldType type;
+    uint64_t values_offset;  // offset of the values, followed by the sorted rows
+  };
+
+  uint64_t ReadUint64(uint64_t offset) const;
+
+  uint64_t GetRowColumn(uint64_t row, uint64_t column) const;
+
+  uint64_t GetValue(const IndexField &field, uint64_t row) const;
+
+  uint64_t GetSortedRow(const IndexField &field, uint64_t i) const;
+
+  std::string ValueToString(const IndexField &field, uint64_t value) const;
+
+  /// \brief compare the value of a row with the criteria, the bits are the parsed criteria of a number field
+  int CompareValue(const IndexField &field, uint64_t value, uint64_t bits, const std::string &criteria) const;
+
+  /// \brief parse the criteria into the bits of an integer or a double, false if it can not match any value
+  static bool ParseCriteria(IndexFieldType type, const std::string &criteria, uint64_t *bits);
+
+  /// \brief get the rows whose field equals the criteria, the rows are sorted
+  Status GetMatchedRows(const std::pair<std::string, std::string> &criteria, uint64_t begin, uint64_t end,
+                        std::vector<uint64_t> *rows) const;
+
+  Status GetColumnReader(const std::string &column, std::pair<int64_t, const IndexField *> *reader) const;
+
+  std::string file_;
+  std::string index_file_;
+  uint64_t size_;
+  const uint8_t *data_;          // mapped index file
+  std::vector<uint8_t> buffer_;  // content of the index file if it can not be mapped
+  uint64_t num_rows_;
+  uint64_t rows_offset_;
+  uint64_t strings_offset_;
+  std::vector<IndexField> fields_;
+};
+
+/// \brief Collect the rows inserted into the sqlite index of a shard and write them into the mmap index.
+class __attribute__((visibility("default"))) ShardMmapIndexBuilder {
+ public:
+  ShardMmapIndexBuilder() = default;
+
+  ~ShardMmapIndexBuilder() = default;
+
+  /// \brief add a row with the place holders, types and values bound to the insert statement of the sqlite index
+  Status AddRow(const std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
+
+  /// \brief sort the rows and write the index of the mindrecord file
+  /// \param[in] file the path of the mindrecord file
+  Status Write(const std::string &file);
+
+ private:
+  std::vector<std::array<uint64_t, kIndexRowColumnCount>> rows_;
+  std::vector<std::string> field_names_;
+  std::vector<IndexFieldType> field_types_;
+  std::vector<std::vector<uint64_t>> field_values_;  // bits of the numbers or ids of the strings
+  std::vector<std::string> strings_;
+  std::unordered_map<std::string, uint64_t> string_ids_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MMAP_INDEX_H_
@@ -32,6 +32,7 @@ namespace mindrecord {
 const std::string kPageTypeRaw = "RAW_DATA";
 const std::string kPageTypeBlob = "BLOB_DATA";
 const std::string kPageTypeNewColumn = "NEW_COLUMN_DATA";
+const std::string kPageTypeColumn = "COLUMN_DATA";
 
 class __attribute__((visibility("default"))) Page {
  public:
@@ -79,6 +80,10 @@ class __attribute__((visibility("default"))) Page {
     row_group_ids_ = last_row_group_ids;
   }
 
+  json GetColumnStats() const { return column_stats_; }
+
+  void SetColumnStats(const json &column_stats) { column_stats_ = column_stats; }
+
   void DeleteLastGroupId();
 
  private:
@@ -90,15 +95,17 @@ class __attribute__((visibility("default"))) Page {
   uint64_t end_row_id_;
   std::vector<std::pair<int, uint64_t>> row_group_ids_;
   uint64_t page_size_;
+  json column_stats_;  // min and max of the columns, only for column page
   // JSON page: {
   //            "page_id":X,
   //            "shard_id":X,
-  //            "page_type":"XXX", (enum "raw_data", "blob_data", "new_column")
+  //            "page_type":"XXX", (enum "raw_data", "blob_data", "new_column", "column_data")
   //            "page_type_id":X,
   //            "start_row_id":X,
   //            "end_row_id":X,
   //            "row_group_ids":[{"id":X, "offset":X}],
   //            "page_size":X,
+  //            "column_stats":{"column":{"min":X, "max":X}}, (only for column page)
 };
 }  // namespace mindrecord
 }  // namespace mindspore
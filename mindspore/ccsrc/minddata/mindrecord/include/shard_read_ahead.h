@@ -0,0 +1,128 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_READ_AHEAD_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_READ_AHEAD_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+const int64_t kReadAheadBlockRows = 32;              // rows planned at once, their reads are merged if possible
+const uint64_t kReadAheadMaxGap = 64 * 1024;         // max gap between two blobs read by one request
+const uint64_t kReadAheadMaxRead = 4 * 1024 * 1024;  // max size of one request unless a single blob is larger
+
+/// \brief location of the blob of a row in the mindrecord files
+struct BlobLocation {
+  int shard_id = 0;
+  uint64_t offset = 0;
+  uint64_t length = 0;
+};
+
+/// \brief Read the blobs of the rows ahead in the order of the sampler.
+///
+/// The rows are planned in blocks of kReadAheadBlockRows. The blobs of a block are sorted by file and offset, and
+/// neighbours are merged into one request, so a random order still reads whole ranges when the rows are close. The
+/// blocks are read by a pool of threads with their own file handles, so several requests are outstanding at once,
+/// which hides the latency of network filesystems. The blobs stay in memory until the reader takes them; a new block
+/// waits while the blobs in memory exceed the cache size. A row which is not read ahead yet is read by the caller,
+/// and skipped by the read ahead threads.
+class __attribute__((visibility("default"))) ShardReadAhead {
+ public:
+  /// \brief locate the blob of a row, false if the row has no blob to read, e.g. a padded row
+  using BlobLocator = std::function<bool(int64_t task_id, BlobLocation *location)>;
+
+  /// \param[in] file_paths paths of the mindrecord files, indexed by shard id
+  /// \param[in] num_threads number of threads reading ahead
+  /// \param[in] cache_size max bytes of the blobs in memory
+  ShardReadAhead(const std::vector<std::string> &file_paths, int32_t num_threads, int64_t cache_size);
+
+  ~ShardReadAhead();
+
+  /// \brief start reading the rows in the order of the plan
+  /// \param[in] plan ids of the rows in the order they are taken
+  /// \param[in] locator function to locate the blob of a row, called by the read ahead threads
+  Status Start(const std::vector<int64_t> &plan, const BlobLocator &locator);
+
+  /// \brief stop the threads and drop the blobs in memory
+  void Stop();
+
+  /// \brief take the blob of a row, wait if it is being read
+  /// \param[in] task_id id of the row
+  /// \param[out] blob the blob of the row
+  /// \return false if the row is not read ahead, then the caller reads it
+  bool Get(int64_t task_id, std::vector<uint8_t> *blob);
+
+ private:
+  struct Entry {
+    bool ready = false;
+    bool failed = false;
+    int uses = 0;  // times the row appears in the planned blocks and is not taken yet
+    uint64_t length = 0;
+    std::vector<uint8_t> blob;
+  };
+
+  struct Request {
+    int64_t task_id;
+    BlobLocation location;
+  };
+
+  void ReadAheadWorker(int32_t worker_id);
+
+  /// \brief plan the next block, false if the plan is done or the read ahead is stopped
+  bool PlanBlock(std::vector<Request> *requests);
+
+  /// \brief read the merged ranges of the block and hand the blobs to the entries
+  void ReadBlock(std::vector<Request> *requests, std::vector<std::shared_ptr<std::ifstream>> *streams);
+
+  void Deliver(const Request &request, const uint8_t *data, bool failed);
+
+  std::vector<std::string> file_paths_;
+  int32_t num_threads_;
+  int64_t cache_size_;
+
+  std::vector<int64_t> plan_;
+  BlobLocator locator_;
+  size_t next_pos_ = 0;      // position of the next block in the plan
+  int64_t cached_size_ = 0;  // bytes of the entries planned and not taken yet
+  std::unordered_map<int64_t, std::shared_ptr<Entry>> entries_;
+  std::unordered_map<int64_t, int> taken_early_;  // rows read by the caller before they are planned
+  bool stop_ = true;
+  uint64_t generation_ = 0;  // increased when stopped, the entries of an old generation are dropped
+  std::mutex mtx_;
+  std::condition_variable cv_ready_;  // an entry is read
+  std::condition_variable cv_space_;  // an entry is taken
+  std::vector<std::thread> threads_;
+
+  std::atomic<int64_t> num_hits_;
+  std::atomic<int64_t> num_misses_;
+  std::atomic<int64_t> num_requests_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_READ_AHEAD_H_
@@ -45,11 +45,14 @@
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_column_page.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_mmap_index.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
+#include "minddata/mindrecord/include/shard_read_ahead.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "minddata/mindrecord/include/shard_shuffle.h"
@@ -191,6 +194,19 @@ class API_PUBLIC ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief set flag of reading the mmap index instead of the database if it is up to date
+  /// \return null
+  void SetMmapIndex(bool mmap_index) { mmap_index_ = mmap_index; }
+
+  /// \brief set the read ahead of the blobs in the order of the samples, used by GetNextById
+  /// \param[in] num_threads number of threads reading ahead, 0 to disable it
+  /// \param[in] cache_size max bytes of the blobs read ahead and not taken yet
+  /// \return null
+  void SetReadAhead(int32_t num_threads, int64_t cache_size) {
+    read_ahead_threads_ = num_threads;
+    read_ahead_cache_size_ = cache_size;
+  }
+
   /// \brief get all classes
   Status GetAllClasses(const std::string &category_field, std::shared_ptr<std::set<std::string>> category_ptr);
 
@@ -215,6 +231,16 @@ class API_PUBLIC ShardReader {
                             const std::vector<std::string> &columns,
                             std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
 
+  /// \brief get the sql filter of the rows whose column pages may match the criteria
+  /// \return false if no row of the shard can match the criteria
+  bool FilterRowsByColumnStats(int shard_id, const std::pair<std::string, std::string> &criteria,
+                               std::string *row_filter);
+
+  /// \brief read the selected columns of the rows from the column pages of a shard
+  Status ReadColumnPages(const std::vector<std::vector<std::string>> &labels, std::shared_ptr<std::fstream> fs,
+                         const std::vector<std::shared_ptr<Page>> &column_pages,
+                         const std::vector<std::string> &columns, std::vector<json> *values);
+
   /// \brief convert json format to expected type
   Status ConvertJsonValue(const std::vector<std::string> &label, const std::vector<std::string> &columns,
                           const json &schema, json *value);
@@ -226,8 +252,9 @@ class API_PUBLIC ShardReader {
   Status ReadRowGroupByShardIDAndSampleID(const std::vector<std::string> &columns, const uint32_t &shard_id,
                                           const uint32_t &sample_id, std::shared_ptr<ROW_GROUPS> *row_group_ptr);
 
-  /// \brief read all rows in one shard
-  Status ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
+  /// \brief read all rows in one shard, the query is used if the shard has the mmap index, otherwise the sql
+  Status ReadAllRowsInShard(int shard_id, const std::string &sql, const IndexQuery &query,
+                            const std::vector<std::string> &columns,
                             std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
                             std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
 
@@ -283,6 +310,9 @@ class API_PUBLIC ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
+  /// \brief start reading the blobs ahead in the order of the sample ids if it is enabled
+  Status StartReadAhead();
+
   /// \brief read one row by one task
   Status ConsumerOneTask(int64_t task_id, uint32_t consumer_id, std::shared_ptr<TASK_CONTENT> *task_content_pt);
 
@@ -295,6 +325,13 @@ class API_PUBLIC ShardReader {
   void GetClassesInShard(sqlite3 *db, int shard_id, const std::string &sql,
                          std::shared_ptr<std::set<std::string>> category_ptr);
 
+  /// \brief get classes in the mmap index of one shard
+  void GetClassesInIndex(int shard_id, const std::string &field, std::shared_ptr<std::set<std::string>> category_ptr);
+
+  /// \brief build the query of the mmap index for the rows in a blob page which match the criteria
+  IndexQuery BuildIndexQuery(const std::vector<std::string> &columns, int page_id,
+                             const std::pair<std::string, std::string> &criteria);
+
   /// \brief get number of classes
   int64_t GetNumClasses(const std::string &category_field);
 
@@ -308,8 +345,11 @@ class API_PUBLIC ShardReader {
   int shard_count_;                            // number of shards
   std::shared_ptr<ShardHeader> shard_header_;  // shard header
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
+  // codec of column pages, null if there are several schemas
+  std::shared_ptr<ShardColumnPage> shard_column_page_;
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardMmapIndex>> mmap_indexes_;                    // mmap index list
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
@@ -324,6 +364,7 @@ class API_PUBLIC ShardReader {
 
   // flags
   bool all_in_index_ = true;  // if all columns are stored in index-table
+  bool mmap_index_ = true;    // if the mmap index is read instead of the database
   bool interrupt_ = false;    // reader interrupted
 
   int64_t num_padded_;  // number of padding samples
@@ -350,6 +391,11 @@ class API_PUBLIC ShardReader {
   // 1 : 41  -  shard1 has 26 samples
   // 2 : 58  -  shard2 has 17 samples
   std::vector<int64_t> shard_sample_count_;
+
+  // read ahead of the blobs for GetNextById
+  int32_t read_ahead_threads_ = 0;
+  int64_t read_ahead_cache_size_ = 0;
+  std::unique_ptr<ShardReadAhead> read_ahead_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <exception>
 #include <fstream>
 #include <functional>
@@ -37,9 +39,11 @@
 #include <vector>
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_column_page.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_header.h"
 #include "minddata/mindrecord/include/shard_index.h"
+#include "minddata/mindrecord/include/shard_index_generator.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 #include "utils/log_adapter.h"
@@ -78,6 +82,29 @@ class __attribute__((visibility("default"))) ShardWriter {
   /// \return MSRStatus the status of MSRStatus
   Status SetPageSize(const uint64_t &page_size);
 
+  /// \brief Set whether to write column pages besides raw pages
+  /// \param[in] column_page write the non-blob fields column by column as well, so that the reader can decode only
+  ///            the selected columns
+  /// \return MSRStatus the status of MSRStatus
+  Status SetColumnPage(bool column_page);
+
+  /// \brief Set whether to write through a pipeline, where the blobs are compressed, the rows are validated and
+  ///        serialized, the pages are written and the index is generated by threads of their own, so the batches
+  ///        overlap and WriteRawData returns once the rows are queued. Errors of a batch are returned by the next
+  ///        WriteRawData or Commit. The index is generated while writing unless appending to existing files.
+  /// \param[in] pipeline write through the pipeline or not
+  /// \param[in] max_memory max bytes of the rows queued and not written yet, WriteRawData waits when exceeded
+  /// \return MSRStatus the status of MSRStatus
+  Status SetPipeline(bool pipeline, int64_t max_memory);
+
+  /// \brief Set whether to write the mmap index besides the database when the index is generated while writing
+  /// \param[in] mmap_index write the mmap index or not
+  /// \return MSRStatus the status of MSRStatus
+  Status SetMmapIndex(bool mmap_index);
+
+  /// \brief Whether the index was generated while writing, then there is no need to run ShardIndexGenerator
+  bool IsIndexWritten() const { return index_written_; }
+
   /// \brief Set shard header
   /// \param[in] header_data the info of header
   ///        WARNING, only called when file is empty
@@ -108,6 +135,58 @@ class __attribute__((visibility("default"))) ShardWriter {
   static Status Initialize(const std::unique_ptr<ShardWriter> *writer_ptr, const std::vector<std::string> &file_names);
 
  private:
+  /// \brief rows of a WriteRawData call in the pipeline
+  struct WriteBatch {
+    std::map<uint64_t, std::vector<json>> raw_data;
+    std::vector<std::vector<uint8_t>> blob_data;
+    std::vector<std::vector<uint8_t>> bin_raw_data;
+    std::vector<ROW_DATA> index_rows;  // rows whose locations are final, by shard
+    bool sign = true;
+    int64_t bytes = 0;  // bytes counted in the memory limit of the pipeline
+  };
+
+  /// \brief location of a row written while the index is generated, the page of its row group is known once the
+  ///        row group is full, as the last row group of a shard may be shifted to a new raw page
+  struct PendingRow {
+    uint64_t row_id;
+    int row_group_id;
+    uint64_t raw_offset;  // offset in the row group
+    uint64_t raw_size;
+    uint64_t blob_offset;  // offset in the blob page
+    uint64_t blob_size;
+    std::vector<std::tuple<std::string, std::string, std::string>> index_fields;
+  };
+
+  enum PipelineStage { kStageCompress = 0, kStageSerialize, kStageWrite, kStageIndex, kStageCount };
+
+  /// \brief start the threads of the pipeline and the index generation at the first batch
+  Status StartPipeline();
+
+  /// \brief wait for the batches in the pipeline and stop its threads
+  Status StopPipeline();
+
+  /// \brief queue a batch into the pipeline, wait while the memory limit is exceeded
+  Status PushPipeline(std::map<uint64_t, std::vector<json>> &raw_data, std::vector<std::vector<uint8_t>> &blob_data,
+                      bool sign);
+
+  /// \brief run one stage of the pipeline on the batches
+  void PipelineWorker(PipelineStage stage);
+
+  /// \brief run a stage on a batch
+  Status RunStage(PipelineStage stage, WriteBatch *batch);
+
+  /// \brief write the serialized rows of a batch into the pages
+  Status WriteBatchData(WriteBatch *batch);
+
+  /// \brief record the locations of the rows of a shard before they are written into the row groups
+  Status RecordRowLocations(int shard_id, uint64_t shard_start_row,
+                            const std::vector<std::pair<int, int>> &rows_in_group,
+                            const std::shared_ptr<Page> &last_raw_page, const std::shared_ptr<Page> &last_blob_page,
+                            const std::map<uint64_t, std::vector<json>> &raw_data);
+
+  /// \brief take the rows whose row groups are full, or all the rows, and locate their pages
+  Status CollectIndexRows(bool all, std::vector<ROW_DATA> *index_rows);
+
   /// \brief write shard header data to disk
   Status WriteShardHeader();
 
@@ -135,11 +214,13 @@ class __attribute__((visibility("default"))) ShardWriter {
 
   /// \brief write all data parallel
   Status ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
-                           const std::vector<std::vector<uint8_t>> &bin_raw_data);
+                           const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                           const std::map<uint64_t, std::vector<json>> &raw_data);
 
   /// \brief write data shard by shard
   Status WriteByShard(int shard_id, int start_row, int end_row, const std::vector<std::vector<uint8_t>> &blob_data,
-                      const std::vector<std::vector<uint8_t>> &bin_raw_data);
+                      const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                      const std::map<uint64_t, std::vector<json>> &raw_data);
 
   /// \brief break image data up into multiple row groups
   Status CutRowGroup(int start_row, int end_row, const std::vector<std::vector<uint8_t>> &blob_data,
@@ -172,6 +253,11 @@ class __attribute__((visibility("default"))) ShardWriter {
                        int &last_row_groupId, std::shared_ptr<Page> last_raw_page,
                        const std::vector<std::vector<uint8_t>> &bin_raw_data);
 
+  /// \brief write the row groups column by column into new column pages
+  Status WriteColumnPage(const int &shard_id, const uint64_t &shard_start_row,
+                         const std::vector<std::pair<int, int>> &rows_in_group,
+                         const std::map<uint64_t, std::vector<json>> &raw_data);
+
   /// \brief write blob chunk to disk
   Status FlushBlobChunk(const std::shared_ptr<std::fstream> &out, const std::vector<std::vector<uint8_t>> &blob_data,
                         const std::pair<int, int> &blob_row);
@@ -181,7 +267,7 @@ class __attribute__((visibility("default"))) ShardWriter {
                        const int &chunk_id, const std::vector<std::vector<uint8_t>> &bin_raw_data);
 
   /// \brief break up into tasks by shard
-  std::vector<std::pair<int, int>> BreakIntoShards();
+  std::vector<std::pair<int, int>> BreakIntoShards(uint32_t row_count);
 
   /// \brief calculate raw data size row by row
   Status SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data);
@@ -212,6 +298,16 @@ class __attribute__((visibility("default"))) ShardWriter {
   Status WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>> &raw_data, vector<vector<uint8_t>> &blob_data,
                               bool sign, int *schema_count, int *row_count);
 
+  /// \brief Check the free disk size
+  Status CheckDiskSize();
+
+  /// \brief Compress the blobs, with multi threads in the pipeline
+  Status CompressBlobData(std::vector<std::vector<uint8_t>> &blob_data, bool parallel);
+
+  /// \brief Add dummy data and validate the raw data
+  Status PrepareRawData(std::map<uint64_t, std::vector<json>> &raw_data, vector<vector<uint8_t>> &blob_data, bool sign,
+                        int *schema_count, int *row_count);
+
   /// \brief Get full path from file name
   Status GetFullPathFromFileName(const std::vector<std::string> &paths);
 
@@ -235,6 +331,8 @@ class __attribute__((visibility("default"))) ShardWriter {
   uint64_t page_size_;     // page size
   uint32_t row_count_;     // count of rows
   uint32_t schema_count_;  // count of schemas
+  bool column_page_;       // write column pages or not
+  bool append_;            // append to existing files or not
 
   std::vector<uint64_t> raw_data_size_;   // Raw data size
   std::vector<uint64_t> blob_data_size_;  // Blob data size
@@ -243,12 +341,28 @@ class __attribute__((visibility("default"))) ShardWriter {
   std::vector<std::shared_ptr<std::fstream>> file_streams_;  // file handles
   std::shared_ptr<ShardHeader> shard_header_;                // shard header
   std::shared_ptr<ShardColumn> shard_column_;                // shard columns
+  std::shared_ptr<ShardColumnPage> shard_column_page_;       // codec of column pages
 
   std::map<uint64_t, std::map<int, std::string>> err_mg_;  // used for storing error raw_data info
 
   std::mutex check_mutex_;  // mutex for data check
   std::atomic<bool> flag_{false};
   std::atomic<int64_t> compression_size_;
+
+  bool pipeline_;            // write through the pipeline or not
+  int64_t pipeline_memory_;  // max bytes of the batches in the pipeline
+  bool mmap_index_;          // write the mmap index when the index is generated while writing
+  bool index_written_;       // the index was generated while writing
+  std::vector<std::thread> pipeline_threads_;
+  std::vector<std::deque<std::shared_ptr<WriteBatch>>> pipeline_queues_;  // input of each stage
+  std::mutex pipeline_mutex_;
+  std::condition_variable pipeline_cv_;
+  Status pipeline_status_;        // first error raised in the pipeline
+  int64_t pipeline_bytes_ = 0;    // bytes of the batches not written yet
+  int64_t pipeline_batches_ = 0;  // batches in the pipeline
+  bool pipeline_stop_ = false;
+  std::shared_ptr<ShardIndexGenerator> index_generator_;  // generate the index while writing
+  std::vector<std::vector<PendingRow>> pending_rows_;     // rows not indexed yet, by shard
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -26,15 +26,25 @@ using mindspore::MsLogLevel::INFO;
 
 namespace mindspore {
 namespace mindrecord {
-ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool append)
+ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool append, bool mmap_index)
     : file_path_(file_path),
       append_(append),
+      mmap_index_(mmap_index),
       page_size_(0),
       header_size_(0),
       schema_count_(0),
       task_(0),
       write_success_(true) {}
 
+ShardIndexGenerator::~ShardIndexGenerator() {
+  for (auto &db : dbs_) {
+    if (db != nullptr) {
+      sqlite3_close(db);
+      db = nullptr;
+    }
+  }
+}
+
 Status ShardIndexGenerator::Build() {
   std::shared_ptr<json> header_ptr;
   RETURN_IF_NOT_OK(ShardHeader::BuildSingleHeader(file_path_, &header_ptr));
@@ -235,7 +245,9 @@ Status ShardIndexGenerator::CreateShardNameTable(sqlite3 *db, const std::string
 }
 
 Status ShardIndexGenerator::CreateDatabase(int shard_no, sqlite3 **db) {
-  std::string shard_address = shard_header_.GetShardAddressByID(shard_no);
+  // the header of files being written only has the file names
+  std::string shard_address =
+    file_paths_.empty() ? shard_header_.GetShardAddressByID(shard_no) : file_paths_[shard_no];
   std::shared_ptr<std::string> fn_ptr;
   RETURN_IF_NOT_OK(GetFileName(shard_address, &fn_ptr));
   shard_address += ".db";
@@ -517,6 +529,7 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
       "-a): " +
       shard_address);
   }
+  ShardMmapIndexBuilder mmap_index_builder;
   (void)sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
   for (int raw_page_id : raw_page_ids) {
     std::shared_ptr<std::string> sql_ptr;
@@ -525,6 +538,11 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
     RELEASE_AND_RETURN_IF_NOT_OK(GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in, &row_data_ptr), db, in);
     RELEASE_AND_RETURN_IF_NOT_OK(BindParameterExecuteSQL(db, *sql_ptr, *row_data_ptr), db, in);
     MS_LOG(INFO) << "Insert " << row_data_ptr->size() << " rows to index db.";
+    if (mmap_index_) {
+      for (const auto &row_data : *row_data_ptr) {
+        RELEASE_AND_RETURN_IF_NOT_OK(mmap_index_builder.AddRow(row_data), db, in);
+      }
+    }
   }
   (void)sqlite3_exec(db, "END TRANSACTION;", nullptr, nullptr, nullptr);
   in.close();
@@ -532,6 +550,9 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
   // Close database
   sqlite3_close(db);
   db = nullptr;
+  if (mmap_index_) {
+    RETURN_IF_NOT_OK(mmap_index_builder.Write(realpath.value()));
+  }
   return Status::OK();
 }
 
@@ -607,5 +628,71 @@ Status ShardIndexGenerator::Finalize(const std::vector<std::string> file_names)
   RETURN_IF_NOT_OK(sg.WriteToDatabase());
   return Status::OK();
 }
+
+Status ShardIndexGenerator::OpenIncremental(const ShardHeader &header, const std::vector<std::string> &file_paths) {
+  shard_header_ = header;
+  fields_ = shard_header_.GetFields();
+  page_size_ = shard_header_.GetPageSize();
+  header_size_ = shard_header_.GetHeaderSize();
+  schema_count_ = shard_header_.GetSchemaCount();
+  CHECK_FAIL_RETURN_UNEXPECTED(file_paths.size() == static_cast<size_t>(shard_header_.GetShardCount()),
+                               "[Internal ERROR] the number of mindrecord files: " + std::to_string(file_paths.size()) +
+                                 " is not equal to the shard count: " + std::to_string(shard_header_.GetShardCount()));
+  file_paths_ = file_paths;
+  std::shared_ptr<std::string> sql_ptr;
+  RETURN_IF_NOT_OK(GenerateRawSQL(fields_, &sql_ptr));
+  insert_sql_ = *sql_ptr;
+
+  dbs_.assign(file_paths_.size(), nullptr);
+  if (mmap_index_) {
+    mmap_index_builders_.resize(file_paths_.size());
+  }
+  for (size_t shard_no = 0; shard_no < file_paths_.size(); ++shard_no) {
+    RETURN_IF_NOT_OK(CreateDatabase(static_cast<int>(shard_no), &dbs_[shard_no]));
+    (void)sqlite3_exec(dbs_[shard_no], "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+  }
+  MS_LOG(INFO) << "Init index db for " << file_paths_.size() << " shards to be written incrementally.";
+  return Status::OK();
+}
+
+Status ShardIndexGenerator::WriteRows(int shard_no, const ROW_DATA &rows) {
+  CHECK_FAIL_RETURN_UNEXPECTED(shard_no >= 0 && shard_no < static_cast<int>(dbs_.size()) && dbs_[shard_no] != nullptr,
+                               "[Internal ERROR] the index db of shard: " + std::to_string(shard_no) + " is not open.");
+  auto rc = BindParameterExecuteSQL(dbs_[shard_no], insert_sql_, rows);
+  if (rc.IsError()) {
+    // the db may be closed on failure
+    dbs_[shard_no] = nullptr;
+    return rc;
+  }
+  if (mmap_index_) {
+    for (const auto &row_data : rows) {
+      RETURN_IF_NOT_OK(mmap_index_builders_[shard_no].AddRow(row_data));
+    }
+  }
+  MS_LOG(DEBUG) << "Insert " << rows.size() << " rows to index db of shard: " << shard_no;
+  return Status::OK();
+}
+
+Status ShardIndexGenerator::CloseIncremental() {
+  for (size_t shard_no = 0; shard_no < dbs_.size(); ++shard_no) {
+    CHECK_FAIL_RETURN_UNEXPECTED(dbs_[shard_no] != nullptr,
+                                 "[Internal ERROR] the index db of shard: " + std::to_string(shard_no) + " is not open.");
+    (void)sqlite3_exec(dbs_[shard_no], "END TRANSACTION;", nullptr, nullptr, nullptr);
+    sqlite3_close(dbs_[shard_no]);
+    dbs_[shard_no] = nullptr;
+    if (mmap_index_) {
+      // the mmap index records the size and modification time of the committed file
+      auto realpath = FileUtils::GetRealPath(file_paths_[shard_no].c_str());
+      CHECK_FAIL_RETURN_UNEXPECTED(realpath.has_value(),
+                                   "Invalid file, failed to get the realpath of mindrecord files. Please check file "
+                                   "path: " +
+                                     file_paths_[shard_no]);
+      RETURN_IF_NOT_OK(mmap_index_builders_[shard_no].Write(realpath.value()));
+    }
+    MS_LOG(INFO) << "Generate index db for shard: " << shard_no << " successfully.";
+  }
+  mmap_index_builders_.clear();
+  return Status::OK();
+}
 }  // namespace mindrecord
 }  // namespace mindspore
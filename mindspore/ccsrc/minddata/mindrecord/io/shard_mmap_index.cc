@@ -0,0 +1,587 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_mmap_index.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+
+#include "utils/ms_utils.h"
+#include "./securec.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::DEBUG;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+constexpr int kSqliteRealDigits = 15;  // the precision of sqlite to print a real
+
+uint64_t DoubleToBits(double value) {
+  uint64_t bits = 0;
+  (void)memcpy_s(&bits, sizeof(bits), &value, sizeof(value));
+  return bits;
+}
+
+double BitsToDouble(uint64_t bits) {
+  double value = 0;
+  (void)memcpy_s(&value, sizeof(value), &bits, sizeof(bits));
+  return value;
+}
+
+// the same text as sqlite gives for a real, which is printed by "%!.15g": the mantissa always has a decimal point,
+// e.g. "1.0" and "1.0e+20", and the infinities are "Inf" and "-Inf"
+std::string DoubleToString(double value) {
+  if (std::isinf(value)) {
+    return value > 0 ? "Inf" : "-Inf";
+  }
+  if (value == 0) {
+    return "0.0";
+  }
+  std::ostringstream oss;
+  oss << std::setprecision(kSqliteRealDigits) << value;
+  std::string text = oss.str();
+  auto mantissa_end = text.find('e');
+  if (mantissa_end == std::string::npos) {
+    mantissa_end = text.size();
+  }
+  if (!std::isnan(value) && text.find('.') > mantissa_end) {
+    (void)text.insert(mantissa_end, ".0");
+  }
+  return text;
+}
+
+// NaN is larger than the other values so that the order is strict
+bool DoubleLess(double a, double b) {
+  if (std::isnan(a) || std::isnan(b)) {
+    return !std::isnan(a) && std::isnan(b);
+  }
+  return a < b;
+}
+
+template <typename T>
+int ThreeWayCompare(const T &a, const T &b) {
+  return a < b ? -1 : (b < a ? 1 : 0);
+}
+}  // namespace
+
+ShardMmapIndex::ShardMmapIndex(const std::string &file)
+    : file_(file),
+      index_file_(IndexPath(file)),
+      size_(0),
+      data_(nullptr),
+      num_rows_(0),
+      rows_offset_(0),
+      strings_offset_(0) {}
+
+ShardMmapIndex::~ShardMmapIndex() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr && buffer_.empty()) {
+    (void)munmap(const_cast<uint8_t *>(data_), size_);
+  }
+#endif
+  data_ = nullptr;
+}
+
+Status ShardMmapIndex::Open() {
+  struct stat file_stat {};
+  CHECK_FAIL_RETURN_UNEXPECTED(stat(common::SafeCStr(file_), &file_stat) == 0,
+                               "Invalid file, failed to get the status of mindrecord file: " + file_);
+  struct stat index_stat {};
+  CHECK_FAIL_RETURN_UNEXPECTED(stat(common::SafeCStr(index_file_), &index_stat) == 0,
+                               "Invalid file, mmap index file: " + index_file_ + " does not exist.");
+  size_ = static_cast<uint64_t>(index_stat.st_size);
+  CHECK_FAIL_RETURN_UNEXPECTED(size_ >= kMmapIndexHeaderSize, "Invalid file, mmap index file: " + index_file_ +
+                                                                 " is truncated, its size is " + std::to_string(size_));
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(common::SafeCStr(index_file_), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Invalid file, failed to open mmap index file: " + index_file_);
+  void *addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (addr != MAP_FAILED) {
+    data_ = static_cast<const uint8_t *>(addr);
+  }
+#endif
+  if (data_ == nullptr) {
+    std::ifstream in(index_file_, std::ios::in | std::ios::binary);
+    buffer_.resize(size_);
+    (void)in.read(reinterpret_cast<char *>(buffer_.data()), static_cast<std::streamsize>(size_));
+    CHECK_FAIL_RETURN_UNEXPECTED(in.good(), "Invalid file, failed to read mmap index file: " + index_file_);
+    data_ = buffer_.data();
+  }
+
+  CHECK_FAIL_RETURN_UNEXPECTED(memcmp(data_, kMmapIndexMagic, kMmapIndexMagicSize) == 0,
+                               "Invalid file, " + index_file_ + " is not a mmap index file of mindrecord.");
+  uint32_t version = 0;
+  uint32_t endian_tag = 0;
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    memcpy_s(&version, sizeof(version), data_ + kMmapIndexMagicSize, sizeof(version)) == EOK &&
+      memcpy_s(&endian_tag, sizeof(endian_tag), data_ + kMmapIndexMagicSize + sizeof(version), sizeof(endian_tag)) ==
+        EOK,
+    "[Internal ERROR] Failed to call securec func [memcpy_s]");
+  CHECK_FAIL_RETURN_UNEXPECTED(version == kMmapIndexVersion && endian_tag == kMmapIndexEndianTag,
+                               "Invalid file, the version or the byte order of mmap index file: " + index_file_ +
+                                 " is not supported.");
+  uint64_t offset = kMmapIndexMagicSize + sizeof(version) + sizeof(endian_tag);
+  uint64_t file_size = ReadUint64(offset);
+  auto file_mtime = static_cast<int64_t>(ReadUint64(offset + kInt64Len));
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    file_size == static_cast<uint64_t>(file_stat.st_size) && file_mtime == static_cast<int64_t>(file_stat.st_mtime),
+    "Invalid file, mmap index file: " + index_file_ + " is out of date.");
+  num_rows_ = ReadUint64(offset + kInt64Len * 2);
+  uint64_t num_fields = ReadUint64(offset + kInt64Len * 3);
+  strings_offset_ = ReadUint64(offset + kInt64Len * 4);
+  CHECK_FAIL_RETURN_UNEXPECTED(num_fields <= kMaxFieldCount,
+                               "Invalid file, the number of fields in mmap index file: " + index_file_ + " is " +
+                                 std::to_string(num_fields));
+
+  offset = kMmapIndexHeaderSize;
+  for (uint64_t i = 0; i < num_fields; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(size_ - offset >= kInt64Len * 2,
+                                 "Invalid file, mmap index file: " + index_file_ + " is truncated.");
+    uint64_t type = ReadUint64(offset);
+    uint64_t name_length = ReadUint64(offset + kInt64Len);
+    offset += kInt64Len * 2;
+    CHECK_FAIL_RETURN_UNEXPECTED(type <= kIndexText && name_length <= size_ - offset,
+                                 "Invalid file, mmap index file: " + index_file_ + " is broken.");
+    std::string name(reinterpret_cast<const char *>(data_ + offset), name_length);
+    offset += name_length;
+    fields_.push_back({name, static_cast<IndexFieldType>(type), 0});
+  }
+  rows_offset_ = offset;
+  const uint64_t row_size = kIndexRowColumnCount * kInt64Len;
+  CHECK_FAIL_RETURN_UNEXPECTED(num_rows_ <= (size_ - offset) / row_size,
+                               "Invalid file, mmap index file: " + index_file_ + " is truncated.");
+  offset += num_rows_ * row_size;
+  for (auto &field : fields_) {
+    CHECK_FAIL_RETURN_UNEXPECTED(num_rows_ <= (size_ - offset) / (kInt64Len * 2),
+                                 "Invalid file, mmap index file: " + index_file_ + " is truncated.");
+    field.values_offset = offset;
+    offset += num_rows_ * kInt64Len * 2;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(offset == strings_offset_ && strings_offset_ <= size_,
+                               "Invalid file, mmap index file: " + index_file_ + " is broken.");
+  // the row ids are continuous, so the position of a row is its id
+  CHECK_FAIL_RETURN_UNEXPECTED(num_rows_ == 0 || GetRowColumn(num_rows_ - 1, kIndexRowIdColumn) == num_rows_ - 1,
+                               "Invalid file, the row ids in mmap index file: " + index_file_ + " are not continuous.");
+  // the lookups use the sorted rows as positions without checking them again
+  for (const auto &field : fields_) {
+    for (uint64_t i = 0; i < num_rows_; ++i) {
+      CHECK_FAIL_RETURN_UNEXPECTED(GetSortedRow(field, i) < num_rows_, "Invalid file, the sorted rows of field: " +
+                                                                          field.name + " in mmap index file: " +
+                                                                          index_file_ + " are out of range.");
+    }
+  }
+  MS_LOG(DEBUG) << "Succeed to open mmap index file: " << index_file_ << " with " << num_rows_ << " rows.";
+  return Status::OK();
+}
+
+uint64_t ShardMmapIndex::ReadUint64(uint64_t offset) const {
+  uint64_t value = 0;
+  (void)memcpy_s(&value, sizeof(value), data_ + offset, sizeof(value));
+  return value;
+}
+
+uint64_t ShardMmapIndex::GetRowColumn(uint64_t row, uint64_t column) const {
+  return ReadUint64(rows_offset_ + (row * kIndexRowColumnCount + column) * kInt64Len);
+}
+
+uint64_t ShardMmapIndex::GetValue(const IndexField &field, uint64_t row) const {
+  return ReadUint64(field.values_offset + row * kInt64Len);
+}
+
+uint64_t ShardMmapIndex::GetSortedRow(const IndexField &field, uint64_t i) const {
+  return ReadUint64(field.values_offset + (num_rows_ + i) * kInt64Len);
+}
+
+std::string ShardMmapIndex::ValueToString(const IndexField &field, uint64_t value) const {
+  if (field.type == kIndexInteger) {
+    return std::to_string(static_cast<int64_t>(value));
+  }
+  if (field.type == kIndexNumeric) {
+    return DoubleToString(BitsToDouble(value));
+  }
+  uint64_t offset = strings_offset_ + value;
+  if (value > size_ - strings_offset_ || size_ - offset < kInt64Len) {
+    return "";
+  }
+  uint64_t length = ReadUint64(offset);
+  if (length > size_ - offset - kInt64Len) {
+    return "";
+  }
+  return std::string(reinterpret_cast<const char *>(data_ + offset + kInt64Len), length);
+}
+
+int ShardMmapIndex::CompareValue(const IndexField &field, uint64_t value, uint64_t bits,
+                                 const std::string &criteria) const {
+  if (field.type == kIndexInteger) {
+    return ThreeWayCompare(static_cast<int64_t>(value), static_cast<int64_t>(bits));
+  }
+  if (field.type == kIndexNumeric) {
+    double a = BitsToDouble(value);
+    double b = BitsToDouble(bits);
+    return DoubleLess(a, b) ? -1 : (DoubleLess(b, a) ? 1 : 0);
+  }
+  return ValueToString(field, value).compare(criteria);
+}
+
+bool ShardMmapIndex::ParseCriteria(IndexFieldType type, const std::string &criteria, uint64_t *bits) {
+  if (type == kIndexText) {
+    return true;
+  }
+  if (criteria.empty()) {
+    return false;
+  }
+  char *end = nullptr;
+  if (type == kIndexInteger) {
+    errno = 0;
+    int64_t value = std::strtoll(criteria.c_str(), &end, 10);
+    if (errno == 0 && *end == '\0') {
+      *bits = static_cast<uint64_t>(value);
+      return true;
+    }
+  }
+  double value = std::strtod(criteria.c_str(), &end);
+  if (*end != '\0' || std::isnan(value)) {
+    return false;
+  }
+  if (type == kIndexNumeric) {
+    *bits = DoubleToBits(value);
+    return true;
+  }
+  // like sqlite, an integer equals a real without fraction
+  if (std::trunc(value) != value || value < static_cast<double>(std::numeric_limits<int64_t>::min()) ||
+      value >= static_cast<double>(std::numeric_limits<int64_t>::max())) {
+    return false;
+  }
+  *bits = static_cast<uint64_t>(static_cast<int64_t>(value));
+  return true;
+}
+
+Status ShardMmapIndex::GetColumnReader(const std::string &column,
+                                       std::pair<int64_t, const IndexField *> *reader) const {
+  auto it = std::find(kIndexRowColumns.begin(), kIndexRowColumns.end(), column);
+  if (it != kIndexRowColumns.end()) {
+    *reader = std::make_pair(static_cast<int64_t>(it - kIndexRowColumns.begin()), nullptr);
+    return Status::OK();
+  }
+  auto field =
+    std::find_if(fields_.begin(), fields_.end(), [&column](const IndexField &f) { return f.name == column; });
+  CHECK_FAIL_RETURN_UNEXPECTED(field != fields_.end(),
+                               "Invalid data, column: " + column + " is not in mmap index file: " + index_file_);
+  *reader = std::make_pair(-1, &(*field));
+  return Status::OK();
+}
+
+Status ShardMmapIndex::GetMatchedRows(const std::pair<std::string, std::string> &criteria, uint64_t begin,
+                                      uint64_t end, std::vector<uint64_t> *rows) const {
+  std::pair<int64_t, const IndexField *> reader;
+  RETURN_IF_NOT_OK(GetColumnReader(criteria.first, &reader));
+  CHECK_FAIL_RETURN_UNEXPECTED(reader.second != nullptr,
+                               "Invalid data, column: " + criteria.first + " is not an index field.");
+  const IndexField &field = *reader.second;
+  uint64_t bits = 0;
+  if (!ParseCriteria(field.type, criteria.second, &bits)) {
+    return Status::OK();
+  }
+  // find the range of the sorted rows whose value equals the criteria
+  auto bound = [this, &field, bits, &criteria](bool upper) {
+    uint64_t low = 0;
+    uint64_t high = num_rows_;
+    while (low < high) {
+      uint64_t mid = low + (high - low) / 2;
+      int cmp = CompareValue(field, GetValue(field, GetSortedRow(field, mid)), bits, criteria.second);
+      if (cmp < 0 || (upper && cmp == 0)) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  };
+  uint64_t first = bound(false);
+  uint64_t last = bound(true);
+  // the rows with the same value are sorted, skip the rows before begin
+  uint64_t low = first;
+  uint64_t high = last;
+  while (low < high) {
+    uint64_t mid = low + (high - low) / 2;
+    if (GetSortedRow(field, mid) < begin) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  for (uint64_t i = low; i < last; ++i) {
+    uint64_t row = GetSortedRow(field, i);
+    if (row >= end) {
+      break;
+    }
+    rows->push_back(row);
+  }
+  return Status::OK();
+}
+
+Status ShardMmapIndex::Select(const IndexQuery &query, std::vector<std::vector<std::string>> *records) const {
+  RETURN_UNEXPECTED_IF_NULL(records);
+  std::vector<std::pair<int64_t, const IndexField *>> readers;
+  if (query.columns.empty()) {
+    for (const auto &field : fields_) {
+      readers.emplace_back(-1, &field);
+    }
+  }
+  for (const auto &column : query.columns) {
+    std::pair<int64_t, const IndexField *> reader;
+    RETURN_IF_NOT_OK(GetColumnReader(column, &reader));
+    readers.push_back(reader);
+  }
+
+  uint64_t begin = 0;
+  uint64_t end = num_rows_;
+  if (query.row_id >= 0) {
+    begin = std::min(static_cast<uint64_t>(query.row_id), num_rows_);
+    end = std::min(begin + 1, num_rows_);
+  }
+  if (query.blob_page_id >= 0) {
+    // the blob pages are written in the order of rows
+    auto blob_page_id = static_cast<uint64_t>(query.blob_page_id);
+    auto bound = [this, blob_page_id](uint64_t low, uint64_t high, bool upper) {
+      while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        uint64_t page_id = GetRowColumn(mid, kIndexBlobPageColumn);
+        if (page_id < blob_page_id || (upper && page_id == blob_page_id)) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      return low;
+    };
+    uint64_t page_begin = bound(begin, end, false);
+    end = bound(page_begin, end, true);
+    begin = page_begin;
+  }
+
+  std::vector<uint64_t> rows;
+  bool filtered = !query.criteria.first.empty();
+  if (filtered) {
+    RETURN_IF_NOT_OK(GetMatchedRows(query.criteria, begin, end, &rows));
+  }
+  uint64_t count = filtered ? rows.size() : end - begin;
+  size_t first_record = records->size();
+  for (uint64_t i = 0; i < count; ++i) {
+    uint64_t row = filtered ? rows[i] : begin + i;
+    std::vector<std::string> record;
+    record.reserve(readers.size());
+    for (const auto &reader : readers) {
+      if (reader.second == nullptr) {
+        record.emplace_back(std::to_string(GetRowColumn(row, static_cast<uint64_t>(reader.first))));
+      } else {
+        record.emplace_back(ValueToString(*reader.second, GetValue(*reader.second, row)));
+      }
+    }
+    if (query.distinct && records->size() > first_record && records->back() == record) {
+      continue;
+    }
+    records->push_back(std::move(record));
+  }
+  return Status::OK();
+}
+
+Status ShardMmapIndex::GetDistinctValues(const std::string &field_name, std::vector<std::string> *values) const {
+  RETURN_UNEXPECTED_IF_NULL(values);
+  std::pair<int64_t, const IndexField *> reader;
+  RETURN_IF_NOT_OK(GetColumnReader(field_name, &reader));
+  CHECK_FAIL_RETURN_UNEXPECTED(reader.second != nullptr,
+                               "Invalid data, column: " + field_name + " is not an index field.");
+  const IndexField &field = *reader.second;
+  // the strings are deduplicated in the pool, so the same value has the same bits except the numbers
+  for (uint64_t i = 0; i < num_rows_; ++i) {
+    uint64_t value = GetValue(field, GetSortedRow(field, i));
+    if (i > 0) {
+      uint64_t previous = GetValue(field, GetSortedRow(field, i - 1));
+      if (field.type == kIndexNumeric ? BitsToDouble(previous) == BitsToDouble(value) : previous == value) {
+        continue;
+      }
+    }
+    values->push_back(ValueToString(field, value));
+  }
+  return Status::OK();
+}
+
+Status ShardMmapIndexBuilder::AddRow(const std::vector<std::tuple<std::string, std::string, std::string>> &row_data) {
+  std::array<uint64_t, kIndexRowColumnCount> row{};
+  uint64_t num_columns = 0;
+  uint64_t field_id = 0;
+  for (const auto &item : row_data) {
+    const auto &place_holder = std::get<0>(item);
+    const auto &field_type = std::get<1>(item);
+    const auto &field_value = std::get<2>(item);
+    CHECK_FAIL_RETURN_UNEXPECTED(!place_holder.empty() && place_holder[0] == ':',
+                                 "[Internal ERROR] Invalid place holder: " + place_holder);
+    std::string name = place_holder.substr(1);
+    if (name.compare(0, strlen("INC_"), "INC_") == 0) {
+      continue;
+    }
+    auto it = std::find(kIndexRowColumns.begin(), kIndexRowColumns.end(), name);
+    bool is_field = it == kIndexRowColumns.end();
+    if (is_field && rows_.empty()) {
+      field_names_.push_back(name);
+      field_types_.push_back(field_type == "INTEGER" ? kIndexInteger
+                                                     : (field_type == "NUMERIC" ? kIndexNumeric : kIndexText));
+      field_values_.emplace_back();
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(!is_field || (field_id < field_names_.size() && field_names_[field_id] == name),
+                                 "[Internal ERROR] The index fields of the rows are different, field: " + name);
+    uint64_t value = 0;
+    try {
+      if (!is_field) {
+        row[it - kIndexRowColumns.begin()] = std::stoull(field_value);
+        num_columns++;
+        continue;
+      }
+      if (field_types_[field_id] == kIndexInteger) {
+        value = static_cast<uint64_t>(std::stoll(field_value));
+      } else if (field_types_[field_id] == kIndexNumeric) {
+        value = DoubleToBits(std::stod(field_value));
+      } else {
+        auto id = string_ids_.emplace(field_value, strings_.size());
+        if (id.second) {
+          strings_.push_back(field_value);
+        }
+        value = id.first->second;
+      }
+    } catch (const std::exception &) {
+      RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to convert the value: " + field_value + " of field: " + name +
+                               " in the mmap index.");
+    }
+    field_values_[field_id++].push_back(value);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(num_columns == kIndexRowColumnCount && field_id == field_names_.size(),
+                               "[Internal ERROR] The row of the mmap index is incomplete.");
+  rows_.push_back(row);
+  return Status::OK();
+}
+
+Status ShardMmapIndexBuilder::Write(const std::string &file) {
+  struct stat file_stat {};
+  CHECK_FAIL_RETURN_UNEXPECTED(stat(common::SafeCStr(file), &file_stat) == 0,
+                               "Invalid file, failed to get the status of mindrecord file: " + file);
+  uint64_t num_rows = rows_.size();
+  std::vector<uint64_t> order(num_rows);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [this](uint64_t a, uint64_t b) { return rows_[a][kIndexRowIdColumn] < rows_[b][kIndexRowIdColumn]; });
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(rows_[order[i]][kIndexRowIdColumn] == i,
+                                 "[Internal ERROR] The row ids of mindrecord file: " + file + " are not continuous.");
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      i == 0 || rows_[order[i - 1]][kIndexBlobPageColumn] <= rows_[order[i]][kIndexBlobPageColumn],
+      "[Internal ERROR] The blob pages of mindrecord file: " + file + " are not in the order of rows.");
+  }
+  std::vector<uint64_t> string_offsets;
+  string_offsets.reserve(strings_.size());
+  uint64_t strings_size = 0;
+  for (const auto &str : strings_) {
+    string_offsets.push_back(strings_size);
+    strings_size += kInt64Len + str.size();
+  }
+
+  uint64_t fields_size = 0;
+  for (const auto &name : field_names_) {
+    fields_size += kInt64Len * 2 + name.size();
+  }
+  uint64_t strings_offset = kMmapIndexHeaderSize + fields_size + num_rows * kIndexRowColumnCount * kInt64Len +
+                            field_names_.size() * num_rows * kInt64Len * 2;
+
+  std::string index_file = ShardMmapIndex::IndexPath(file);
+  std::ofstream out(index_file, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(out.good(), "Invalid file, failed to open mmap index file: " + index_file +
+                                             " for writing. Please check file path and permission.");
+  auto write_uint64s = [&out](const std::vector<uint64_t> &values) {
+    (void)out.write(reinterpret_cast<const char *>(values.data()),
+                    static_cast<std::streamsize>(values.size() * kInt64Len));
+  };
+  (void)out.write(kMmapIndexMagic, kMmapIndexMagicSize);
+  (void)out.write(reinterpret_cast<const char *>(&kMmapIndexVersion), sizeof(kMmapIndexVersion));
+  (void)out.write(reinterpret_cast<const char *>(&kMmapIndexEndianTag), sizeof(kMmapIndexEndianTag));
+  write_uint64s({static_cast<uint64_t>(file_stat.st_size), static_cast<uint64_t>(file_stat.st_mtime), num_rows,
+                 field_names_.size(), strings_offset});
+  for (size_t i = 0; i < field_names_.size(); ++i) {
+    write_uint64s({static_cast<uint64_t>(field_types_[i]), field_names_[i].size()});
+    (void)out.write(field_names_[i].data(), static_cast<std::streamsize>(field_names_[i].size()));
+  }
+
+  std::vector<uint64_t> buffer;
+  buffer.reserve(num_rows * kIndexRowColumnCount);
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    (void)buffer.insert(buffer.end(), rows_[order[i]].begin(), rows_[order[i]].end());
+  }
+  write_uint64s(buffer);
+
+  for (size_t f = 0; f < field_names_.size(); ++f) {
+    const auto &values = field_values_[f];
+    buffer.clear();
+    for (uint64_t i = 0; i < num_rows; ++i) {
+      uint64_t value = values[order[i]];
+      buffer.push_back(field_types_[f] == kIndexText ? string_offsets[value] : value);
+    }
+    write_uint64s(buffer);
+
+    // the rows with the same value are kept in the order of rows
+    std::vector<uint64_t> sorted_rows(num_rows);
+    std::iota(sorted_rows.begin(), sorted_rows.end(), 0);
+    auto type = field_types_[f];
+    std::stable_sort(sorted_rows.begin(), sorted_rows.end(), [this, type, &values, &order](uint64_t a, uint64_t b) {
+      uint64_t x = values[order[a]];
+      uint64_t y = values[order[b]];
+      if (type == kIndexInteger) {
+        return static_cast<int64_t>(x) < static_cast<int64_t>(y);
+      }
+      if (type == kIndexNumeric) {
+        return DoubleLess(BitsToDouble(x), BitsToDouble(y));
+      }
+      return strings_[x] < strings_[y];
+    });
+    write_uint64s(sorted_rows);
+  }
+
+  for (const auto &str : strings_) {
+    write_uint64s({static_cast<uint64_t>(str.size())});
+    (void)out.write(str.data(), static_cast<std::streamsize>(str.size()));
+  }
+  out.close();
+  CHECK_FAIL_RETURN_UNEXPECTED(!out.fail(), "Invalid file, failed to write mmap index file: " + index_file);
+  MS_LOG(INFO) << "Succeed to write " << num_rows << " rows to mmap index file: " << index_file;
+  return Status::OK();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
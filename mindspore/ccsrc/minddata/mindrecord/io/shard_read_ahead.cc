@@ -0,0 +1,250 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_read_ahead.h"
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+#include <sys/prctl.h>
+#endif
+#include <algorithm>
+#include <utility>
+
+#include "utils/ms_utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::DEBUG;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const char kReadAheadThreadName[] = "THRD_READ_AHEAD_";
+}  // namespace
+
+ShardReadAhead::ShardReadAhead(const std::vector<std::string> &file_paths, int32_t num_threads, int64_t cache_size)
+    : file_paths_(file_paths),
+      num_threads_(num_threads),
+      cache_size_(cache_size),
+      num_hits_(0),
+      num_misses_(0),
+      num_requests_(0) {}
+
+ShardReadAhead::~ShardReadAhead() { Stop(); }
+
+Status ShardReadAhead::Start(const std::vector<int64_t> &plan, const BlobLocator &locator) {
+  CHECK_FAIL_RETURN_UNEXPECTED(num_threads_ > 0, "[Internal ERROR] The number of read ahead threads should be "
+                                                 "greater than 0, but got: " + std::to_string(num_threads_));
+  CHECK_FAIL_RETURN_UNEXPECTED(cache_size_ > 0, "[Internal ERROR] The read ahead cache size should be greater than 0, "
+                                                "but got: " + std::to_string(cache_size_));
+  Stop();
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    plan_ = plan;
+    locator_ = locator;
+    next_pos_ = 0;
+    stop_ = false;
+  }
+  num_hits_ = 0;
+  num_misses_ = 0;
+  num_requests_ = 0;
+  for (int32_t i = 0; i < num_threads_; ++i) {
+    threads_.emplace_back(&ShardReadAhead::ReadAheadWorker, this, i);
+  }
+  MS_LOG(DEBUG) << "Start to read " << plan.size() << " rows ahead with " << num_threads_ << " threads.";
+  return Status::OK();
+}
+
+void ShardReadAhead::Stop() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    stop_ = true;
+    ++generation_;
+    entries_.clear();
+    taken_early_.clear();
+    cached_size_ = 0;
+  }
+  cv_ready_.notify_all();
+  cv_space_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  if (!threads_.empty()) {
+    MS_LOG(INFO) << "Read ahead served " << num_hits_ << " rows with " << num_requests_ << " requests, and "
+                 << num_misses_ << " rows were read by the reader.";
+  }
+  threads_.clear();
+}
+
+bool ShardReadAhead::Get(int64_t task_id, std::vector<uint8_t> *blob) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (stop_) {
+    return false;
+  }
+  auto it = entries_.find(task_id);
+  if (it == entries_.end()) {
+    // not planned yet, the caller reads it and the read ahead threads skip it
+    ++taken_early_[task_id];
+    ++num_misses_;
+    return false;
+  }
+  auto entry = it->second;
+  auto generation = generation_;
+  cv_ready_.wait(lck, [this, &entry, generation] { return generation_ != generation || entry->ready; });
+  if (generation_ != generation) {
+    return false;
+  }
+  bool hit = !entry->failed;
+  if (--entry->uses == 0) {
+    if (hit) {
+      *blob = std::move(entry->blob);
+    }
+    cached_size_ -= static_cast<int64_t>(entry->length);
+    (void)entries_.erase(task_id);
+    cv_space_.notify_all();
+  } else if (hit) {
+    *blob = entry->blob;
+  }
+  if (hit) {
+    ++num_hits_;
+  } else {
+    ++num_misses_;
+  }
+  return hit;
+}
+
+void ShardReadAhead::ReadAheadWorker(int32_t worker_id) {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+  auto thread_name = kReadAheadThreadName + std::to_string(worker_id);
+  prctl(PR_SET_NAME, common::SafeCStr(thread_name), 0, 0, 0);
+#endif
+  std::vector<std::shared_ptr<std::ifstream>> streams(file_paths_.size());
+  std::vector<Request> requests;
+  while (PlanBlock(&requests)) {
+    ReadBlock(&requests, &streams);
+  }
+  for (auto &stream : streams) {
+    if (stream != nullptr) {
+      stream->close();
+    }
+  }
+}
+
+bool ShardReadAhead::PlanBlock(std::vector<Request> *requests) {
+  requests->clear();
+  std::unique_lock<std::mutex> lck(mtx_);
+  while (requests->empty()) {
+    cv_space_.wait(lck, [this] { return stop_ || cached_size_ < cache_size_; });
+    if (stop_ || next_pos_ >= plan_.size()) {
+      return false;
+    }
+    auto end_pos = std::min(plan_.size(), next_pos_ + static_cast<size_t>(kReadAheadBlockRows));
+    for (; next_pos_ < end_pos; ++next_pos_) {
+      auto task_id = plan_[next_pos_];
+      auto early = taken_early_.find(task_id);
+      if (early != taken_early_.end()) {
+        if (--early->second == 0) {
+          (void)taken_early_.erase(early);
+        }
+        continue;
+      }
+      auto it = entries_.find(task_id);
+      if (it != entries_.end()) {
+        // the row is sampled again before it is taken, keep the blob for both
+        ++it->second->uses;
+        continue;
+      }
+      BlobLocation location;
+      if (!locator_(task_id, &location)) {
+        continue;
+      }
+      auto entry = std::make_shared<Entry>();
+      entry->uses = 1;
+      entry->length = location.length;
+      entries_[task_id] = entry;
+      cached_size_ += static_cast<int64_t>(location.length);
+      requests->push_back({task_id, location});
+    }
+  }
+  return true;
+}
+
+void ShardReadAhead::ReadBlock(std::vector<Request> *requests, std::vector<std::shared_ptr<std::ifstream>> *streams) {
+  std::sort(requests->begin(), requests->end(), [](const Request &a, const Request &b) {
+    return a.location.shard_id != b.location.shard_id ? a.location.shard_id < b.location.shard_id
+                                                      : a.location.offset < b.location.offset;
+  });
+  std::vector<uint8_t> buffer;
+  size_t i = 0;
+  while (i < requests->size()) {
+    // merge the neighbours in the same file into one request
+    const auto &first = (*requests)[i].location;
+    uint64_t begin = first.offset;
+    uint64_t end = first.offset + first.length;
+    size_t j = i + 1;
+    for (; j < requests->size(); ++j) {
+      const auto &next = (*requests)[j].location;
+      uint64_t next_end = std::max(end, next.offset + next.length);
+      if (next.shard_id != first.shard_id || next.offset > end + kReadAheadMaxGap ||
+          next_end - begin > kReadAheadMaxRead) {
+        break;
+      }
+      end = next_end;
+    }
+
+    auto &stream = (*streams)[first.shard_id];
+    if (stream == nullptr) {
+      stream = std::make_shared<std::ifstream>(file_paths_[first.shard_id], std::ios::in | std::ios::binary);
+    }
+    buffer.resize(end - begin);
+    bool failed = !stream->is_open();
+    if (!failed) {
+      stream->clear();
+      failed = !stream->seekg(static_cast<std::streamoff>(begin), std::ios::beg).good() ||
+               !stream->read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(end - begin)).good();
+    }
+    if (failed) {
+      MS_LOG(DEBUG) << "Failed to read ahead " << (end - begin) << " bytes at " << begin << " of file "
+                    << file_paths_[first.shard_id] << ", the rows are read by the reader.";
+    }
+    ++num_requests_;
+    for (; i < j; ++i) {
+      Deliver((*requests)[i], buffer.data() + ((*requests)[i].location.offset - begin), failed);
+    }
+  }
+}
+
+void ShardReadAhead::Deliver(const Request &request, const uint8_t *data, bool failed) {
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    auto it = entries_.find(request.task_id);
+    if (it == entries_.end() || it->second->ready) {
+      // dropped by Stop
+      return;
+    }
+    auto &entry = it->second;
+    entry->failed = failed;
+    if (!failed) {
+      entry->blob.assign(data, data + request.location.length);
+    }
+    entry->ready = true;
+  }
+  cv_ready_.notify_all();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -17,6 +17,7 @@
 #include "minddata/mindrecord/include/shard_reader.h"
 
 #include <algorithm>
+#include <numeric>
 #include <thread>
 
 #include "utils/file_utils.h"
@@ -31,6 +32,9 @@ using mindspore::MsLogLevel::INFO;
 
 namespace mindspore {
 namespace mindrecord {
+// ROW_ID follows ROW_GROUP_ID, PAGE_OFFSET_BLOB(_END) and PAGE_ID_RAW, PAGE_OFFSET_RAW(_END) in the full scan
+const size_t kRowIdLabelIndex = 6;
+
 template <class Type>
 // convert the string to exactly number type (int32_t/int64_t/float/double)
 Type StringToNum(const std::string &str) {
@@ -88,9 +92,20 @@ Status ShardReader::Init(const std::vector<std::string> &file_paths, bool load_d
       *meta_data_ptr == *first_meta_data_ptr,
       "Invalid file, the metadata of mindrecord file: " + file +
         " is different from others, please make sure all the mindrecord files generated by the same script.");
+    if (mmap_index_ && std::ifstream(ShardMmapIndex::IndexPath(file)).good()) {
+      auto mmap_index = std::make_shared<ShardMmapIndex>(file);
+      auto rc = mmap_index->Open();
+      if (rc.IsOk()) {
+        mmap_indexes_.push_back(mmap_index);
+        database_paths_.push_back(nullptr);
+        continue;
+      }
+      MS_LOG(INFO) << rc.GetErrDescription() << " Read the meta file: " << file << ".db instead.";
+    }
     sqlite3 *db = nullptr;
     RETURN_IF_NOT_OK(VerifyDataset(&db, file));
     database_paths_.push_back(db);
+    mmap_indexes_.push_back(nullptr);
   }
   ShardHeader sh = ShardHeader();
   RETURN_IF_NOT_OK(sh.BuildDataset(file_paths_, load_dataset));
@@ -103,6 +118,9 @@ Status ShardReader::Init(const std::vector<std::string> &file_paths, bool load_d
   } else {
     shard_column_ = std::make_shared<ShardColumn>(shard_header_, true);
   }
+  if (shard_header_->GetSchemaCount() == 1) {
+    shard_column_page_ = std::make_shared<ShardColumnPage>(shard_header_->GetSchemas()[0]->GetSchema());
+  }
   num_rows_ = 0;
   auto row_group_summary = ReadRowGroupSummary();
 
@@ -321,6 +339,9 @@ void ShardReader::FileStreamsOperator() {
       database_paths_[i] = nullptr;
     }
   }
+  for (auto &mmap_index : mmap_indexes_) {
+    mmap_index = nullptr;
+  }
 }
 
 ShardReader::~ShardReader() { Close(); }
@@ -338,6 +359,9 @@ void ShardReader::Close() {
       i_thread.join();
     }
   }
+  if (read_ahead_ != nullptr) {
+    read_ahead_->Stop();
+  }
 
   FileStreamsOperator();
 }
@@ -391,6 +415,20 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
                                        int shard_id, const std::vector<std::string> &columns,
                                        std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
   auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+  // The full scan selects ROW_ID as well, so the selected columns can be decoded from the column pages page by page,
+  // instead of decoding the whole raw row one by one
+  std::vector<std::shared_ptr<Page>> column_pages;
+  std::vector<json> column_values;
+  bool read_column_page = !all_in_index_ && shard_column_page_ != nullptr && !labels.empty() &&
+                          labels[0].size() > kRowIdLabelIndex &&
+                          shard_header_->GetColumnPages(shard_id, &column_pages) && !column_pages.empty();
+  if (read_column_page) {
+    Status rc = ReadColumnPages(labels, fs, column_pages, columns, &column_values);
+    if (rc.IsError()) {
+      fs->close();
+      return rc;
+    }
+  }
   for (int i = 0; i < static_cast<int>(labels.size()); ++i) {
     try {
       uint64_t group_id = std::stoull(labels[i][0]);
@@ -398,7 +436,9 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
       uint64_t offset_end = std::stoull(labels[i][2]);
       (*offset_ptr)[shard_id].emplace_back(
         std::vector<uint64_t>{static_cast<uint64_t>(shard_id), group_id, offset_start, offset_end});
-      if (!all_in_index_) {
+      if (read_column_page) {
+        (*col_val_ptr)[shard_id].emplace_back(std::move(column_values[i]));
+      } else if (!all_in_index_) {
         int raw_page_id = std::stoi(labels[i][3]);
         uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
         uint64_t label_end = std::stoull(labels[i][5]);
@@ -449,6 +489,75 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
   return Status::OK();
 }
 
+Status ShardReader::ReadColumnPages(const std::vector<std::vector<std::string>> &labels,
+                                    std::shared_ptr<std::fstream> fs,
+                                    const std::vector<std::shared_ptr<Page>> &column_pages,
+                                    const std::vector<std::string> &columns, std::vector<json> *values) {
+  RETURN_UNEXPECTED_IF_NULL(values);
+  std::vector<int> column_ids;
+  if (columns.empty()) {
+    column_ids.resize(shard_column_page_->GetColumns().size());
+    std::iota(column_ids.begin(), column_ids.end(), 0);
+  } else {
+    for (const auto &col : columns) {
+      auto column_id = shard_column_page_->GetColumnId(col);
+      if (column_id >= 0) {
+        column_ids.push_back(column_id);
+      }
+    }
+  }
+  auto read_bytes = [&fs](uint64_t offset, uint64_t len, std::vector<uint8_t> *buf) -> Status {
+    buf->resize(len);
+    if (len == 0) {
+      return Status::OK();
+    }
+    auto &io_seekg = fs->seekg(offset, std::ios::beg);
+    CHECK_FAIL_RETURN_UNEXPECTED(io_seekg.good() && !io_seekg.fail() && !io_seekg.bad(),
+                                 "[Internal ERROR] Failed to seekg file.");
+    auto &io_read = fs->read(reinterpret_cast<char *>(buf->data()), len);
+    CHECK_FAIL_RETURN_UNEXPECTED(io_read.good() && !io_read.fail() && !io_read.bad(),
+                                 "[Internal ERROR] Failed to read file.");
+    return Status::OK();
+  };
+
+  values->assign(labels.size(), json());
+  std::shared_ptr<Page> page = nullptr;
+  // values of the selected columns in the current page
+  std::vector<std::vector<json>> page_values(column_ids.size());
+  for (size_t i = 0; i < labels.size(); ++i) {
+    auto row_id = StringToNum<uint64_t>(labels[i][kRowIdLabelIndex]);
+    if (page == nullptr || row_id < page->GetStartRowID() || row_id >= page->GetEndRowID()) {
+      // the column pages are sorted by rows
+      auto it = std::upper_bound(
+        column_pages.begin(), column_pages.end(), row_id,
+        [](uint64_t id, const std::shared_ptr<Page> &column_page) { return id < column_page->GetStartRowID(); });
+      CHECK_FAIL_RETURN_UNEXPECTED(it != column_pages.begin() && row_id < (*(it - 1))->GetEndRowID(),
+                                   "[Internal ERROR] row: " + std::to_string(row_id) + " is not in column pages.");
+      page = *(it - 1);
+      uint64_t page_offset = page_size_ * page->GetPageID() + header_size_;
+      std::vector<uint8_t> head;
+      RETURN_IF_NOT_OK(read_bytes(page_offset, shard_column_page_->GetHeadSize(), &head));
+      uint64_t num_rows = 0;
+      std::vector<ColumnChunk> chunks;
+      RETURN_IF_NOT_OK(shard_column_page_->DecodeHead(head, &num_rows, &chunks));
+      CHECK_FAIL_RETURN_UNEXPECTED(num_rows == page->GetEndRowID() - page->GetStartRowID(),
+                                   "[Internal ERROR] the number of rows in column page: " + std::to_string(num_rows) +
+                                     " does not match the page info.");
+      // only the chunks of the selected columns are read and decoded
+      for (size_t j = 0; j < column_ids.size(); ++j) {
+        const auto &chunk = chunks[column_ids[j]];
+        std::vector<uint8_t> data;
+        RETURN_IF_NOT_OK(read_bytes(page_offset + chunk.offset, chunk.size, &data));
+        RETURN_IF_NOT_OK(shard_column_page_->DecodeColumn(column_ids[j], chunk, data, num_rows, &page_values[j]));
+      }
+    }
+    for (size_t j = 0; j < column_ids.size(); ++j) {
+      (*values)[i][shard_column_page_->GetColumns()[column_ids[j]]] = page_values[j][row_id - page->GetStartRowID()];
+    }
+  }
+  return Status::OK();
+}
+
 Status ShardReader::ConvertJsonValue(const std::vector<std::string> &label, const std::vector<std::string> &columns,
                                      const json &schema, json *value) {
   for (unsigned int j = 0; j < columns.size(); ++j) {
@@ -466,13 +575,19 @@ Status ShardReader::ConvertJsonValue(const std::vector<std::string> &label, cons
   }
   return Status::OK();
 }
-Status ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
+Status ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, const IndexQuery &query,
+                                       const std::vector<std::string> &columns,
                                        std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
                                        std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
   auto db = database_paths_[shard_id];
   std::vector<std::vector<std::string>> labels;
   char *errmsg = nullptr;
-  int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
+  int rc = SQLITE_OK;
+  if (mmap_indexes_[shard_id] != nullptr) {
+    RETURN_IF_NOT_OK(mmap_indexes_[shard_id]->Select(query, &labels));
+  } else {
+    rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
+  }
   if (rc != SQLITE_OK) {
     std::ostringstream oss;
     oss << "[Internal ERROR] Failed to execute the sql [ " << sql << " ] while reading meta file, " << errmsg;
@@ -524,6 +639,10 @@ Status ShardReader::GetAllClasses(const std::string &category_field,
   std::string sql = "SELECT DISTINCT " + *fn_ptr + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
+    if (mmap_indexes_[x] != nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInIndex, this, x, *fn_ptr, category_ptr);
+      continue;
+    }
     threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, category_ptr);
   }
 
@@ -558,10 +677,39 @@ void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string
   sqlite3_free(errmsg);
 }
 
+void ShardReader::GetClassesInIndex(int shard_id, const std::string &field,
+                                    std::shared_ptr<std::set<std::string>> category_ptr) {
+  std::vector<std::string> values;
+  auto rc = mmap_indexes_[shard_id]->GetDistinctValues(field, &values);
+  if (rc.IsError()) {
+    MS_LOG(ERROR) << "[Internal ERROR] Failed to get the classes from mmap index of shard " << shard_id << ", "
+                  << rc.GetErrDescription();
+    return;
+  }
+  MS_LOG(INFO) << "Succeed to get " << values.size() << " records from shard " << std::to_string(shard_id)
+               << " index.";
+  std::lock_guard<std::mutex> lck(shard_locker_);
+  category_ptr->insert(values.begin(), values.end());
+}
+
+IndexQuery ShardReader::BuildIndexQuery(const std::vector<std::string> &columns, int page_id,
+                                        const std::pair<std::string, std::string> &criteria) {
+  IndexQuery query;
+  query.columns = columns;
+  query.blob_page_id = page_id;
+  if (!criteria.first.empty()) {
+    query.criteria =
+      std::make_pair(criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]), criteria.second);
+  }
+  return query;
+}
+
 Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
                                     std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
   RETURN_UNEXPECTED_IF_NULL(row_group_ptr);
   std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
+  IndexQuery query;
+  query.columns = {"ROW_GROUP_ID", "PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"};
   auto offset_ptr = std::make_shared<std::vector<std::vector<std::vector<uint64_t>>>>(
     shard_count_, std::vector<std::vector<uint64_t>>{});
   auto col_val_ptr = std::make_shared<std::vector<std::vector<json>>>(shard_count_, std::vector<json>{});
@@ -573,16 +721,19 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
       RETURN_IF_NOT_OK(
         ShardIndexGenerator::GenerateFieldName(std::make_pair(column_schema_id_[columns[i]], columns[i]), &fn_ptr));
       fields += *fn_ptr;
+      query.columns.push_back(*fn_ptr);
     }
-  } else {  // fetch raw data from Raw page while some field is not index.
-    fields += ", PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END ";
+  } else {  // fetch raw data from Raw page or column page while some field is not index.
+    fields += ", PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END, ROW_ID ";
+    query.columns.insert(query.columns.end(), {"PAGE_ID_RAW", "PAGE_OFFSET_RAW", "PAGE_OFFSET_RAW_END", "ROW_ID"});
   }
 
   std::string sql = "SELECT " + fields + " FROM INDEXES ORDER BY ROW_ID ;";
 
   std::vector<std::thread> thread_read_db = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    thread_read_db[x] = std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, columns, offset_ptr, col_val_ptr);
+    thread_read_db[x] =
+      std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, query, columns, offset_ptr, col_val_ptr);
   }
 
   for (int x = 0; x < shard_count_; x++) {
@@ -597,6 +748,9 @@ Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::stri
                                                      std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
   RETURN_UNEXPECTED_IF_NULL(row_group_ptr);
   std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
+  IndexQuery query;
+  query.columns = {"ROW_GROUP_ID", "PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"};
+  query.row_id = sample_id;
   auto offset_ptr = std::make_shared<std::vector<std::vector<std::vector<uint64_t>>>>(
     shard_count_, std::vector<std::vector<uint64_t>>{});
   auto col_val_ptr = std::make_shared<std::vector<std::vector<json>>>(shard_count_, std::vector<json>{});
@@ -607,14 +761,16 @@ Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::stri
       RETURN_IF_NOT_OK(
         ShardIndexGenerator::GenerateFieldName(std::make_pair(column_schema_id_[columns[i]], columns[i]), &fn_ptr));
       fields += *fn_ptr;
+      query.columns.push_back(*fn_ptr);
     }
   } else {  // fetch raw data from Raw page while some field is not index.
     fields += ", PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END ";
+    query.columns.insert(query.columns.end(), {"PAGE_ID_RAW", "PAGE_OFFSET_RAW", "PAGE_OFFSET_RAW_END"});
   }
 
   std::string sql = "SELECT " + fields + " FROM INDEXES WHERE ROW_ID = " + std::to_string(sample_id);
 
-  RETURN_IF_NOT_OK(ReadAllRowsInShard(shard_id, sql, columns, offset_ptr, col_val_ptr));
+  RETURN_IF_NOT_OK(ReadAllRowsInShard(shard_id, sql, query, columns, offset_ptr, col_val_ptr));
   *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
   return Status::OK();
 }
@@ -691,7 +847,18 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
   sql += ";";
   std::vector<std::vector<std::string>> image_offsets;
   char *errmsg = nullptr;
-  int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &image_offsets, &errmsg);
+  int rc = SQLITE_OK;
+  if (mmap_indexes_[shard_id] != nullptr) {
+    auto query = BuildIndexQuery({"PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"}, page_id, criteria);
+    auto status = mmap_indexes_[shard_id]->Select(query, &image_offsets);
+    if (status.IsError()) {
+      MS_LOG(ERROR) << "[Internal ERROR] Failed to get the offsets of page " << page_id << " from mmap index, "
+                    << status.GetErrDescription();
+      return std::vector<std::vector<uint64_t>>();
+    }
+  } else {
+    rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &image_offsets, &errmsg);
+  }
   if (rc != SQLITE_OK) {
     MS_LOG(ERROR) << "[Internal ERROR] Failed to execute the sql [ " << common::SafeCStr(sql)
                   << " ] while reading meta file, " << errmsg;
@@ -729,11 +896,24 @@ Status ShardReader::GetPagesByCategory(int shard_id, const std::pair<std::string
       sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = '" +
              criteria.second + "'";
     }
+    std::string row_filter;
+    if (!FilterRowsByColumnStats(shard_id, criteria, &row_filter)) {
+      return Status::OK();
+    }
+    sql += row_filter;
   }
   sql += ";";
   std::vector<std::vector<std::string>> page_ids;
   char *errmsg = nullptr;
-  int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &page_ids, &errmsg);
+  int rc = SQLITE_OK;
+  if (mmap_indexes_[shard_id] != nullptr) {
+    // the rows matching the criteria are found by binary search, so the statistics of the column pages are not used
+    auto query = BuildIndexQuery({"PAGE_ID_BLOB"}, -1, criteria);
+    query.distinct = true;
+    RETURN_IF_NOT_OK(mmap_indexes_[shard_id]->Select(query, &page_ids));
+  } else {
+    rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &page_ids, &errmsg);
+  }
   if (rc != SQLITE_OK) {
     string ss(errmsg);
     sqlite3_free(errmsg);
@@ -751,6 +931,41 @@ Status ShardReader::GetPagesByCategory(int shard_id, const std::pair<std::string
   return Status::OK();
 }
 
+bool ShardReader::FilterRowsByColumnStats(int shard_id, const std::pair<std::string, std::string> &criteria,
+                                          std::string *row_filter) {
+  std::vector<std::shared_ptr<Page>> column_pages;
+  if (shard_column_page_ == nullptr || !shard_header_->GetColumnPages(shard_id, &column_pages) ||
+      column_pages.empty()) {
+    return true;
+  }
+  // Keep the rows of the column pages whose min and max do not exclude the criteria
+  std::vector<std::pair<uint64_t, uint64_t>> row_ranges;
+  for (const auto &page : column_pages) {
+    if (!shard_column_page_->MayContain(page->GetColumnStats(), criteria.first, criteria.second)) {
+      continue;
+    }
+    if (!row_ranges.empty() && row_ranges.back().second == page->GetStartRowID()) {
+      row_ranges.back().second = page->GetEndRowID();
+    } else {
+      row_ranges.emplace_back(page->GetStartRowID(), page->GetEndRowID());
+    }
+  }
+  if (row_ranges.empty()) {
+    return false;
+  }
+  if (row_ranges.size() == 1 && row_ranges[0].first == column_pages.front()->GetStartRowID() &&
+      row_ranges[0].second == column_pages.back()->GetEndRowID()) {
+    return true;
+  }
+  std::string ranges;
+  for (const auto &range : row_ranges) {
+    ranges += (ranges.empty() ? "" : " OR ") + std::string("(ROW_ID >= ") + std::to_string(range.first) +
+              " AND ROW_ID < " + std::to_string(range.second) + ")";
+  }
+  *row_filter = " AND (" + ranges + ")";
+  return true;
+}
+
 std::pair<ShardType, std::vector<std::string>> ShardReader::GetBlobFields() {
   std::vector<std::string> blob_fields;
   for (auto &p : GetShardHeader()->GetSchemas()) {
@@ -869,7 +1084,10 @@ Status ShardReader::GetLabelsFromPage(int page_id, int shard_id, const std::vect
   std::string sql = "SELECT PAGE_ID_RAW, PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END FROM INDEXES WHERE PAGE_ID_BLOB = " +
                     std::to_string(page_id);
   auto label_offset_ptr = std::make_shared<std::vector<std::vector<std::string>>>();
-  if (!criteria.first.empty()) {
+  if (mmap_indexes_[shard_id] != nullptr) {
+    auto query = BuildIndexQuery({"PAGE_ID_RAW", "PAGE_OFFSET_RAW", "PAGE_OFFSET_RAW_END"}, page_id, criteria);
+    RETURN_IF_NOT_OK(mmap_indexes_[shard_id]->Select(query, label_offset_ptr.get()));
+  } else if (!criteria.first.empty()) {
     sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = :criteria";
     RETURN_IF_NOT_OK(QueryWithCriteria(db, sql, criteria.second, label_offset_ptr));
   } else {
@@ -899,17 +1117,22 @@ Status ShardReader::GetLabels(int page_id, int shard_id, const std::vector<std::
   if (all_in_index_) {
     auto db = database_paths_[shard_id];
     std::string fields;
+    std::vector<std::string> index_columns;
     for (unsigned int i = 0; i < columns.size(); ++i) {
       if (i > 0) fields += ',';
       uint64_t schema_id = column_schema_id_[columns[i]];
       fields += columns[i] + "_" + std::to_string(schema_id);
+      index_columns.push_back(columns[i] + "_" + std::to_string(schema_id));
     }
     if (fields.empty()) {
       fields = "*";
     }
     auto labels = std::make_shared<std::vector<std::vector<std::string>>>();
     std::string sql = "SELECT " + fields + " FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
-    if (!criteria.first.empty()) {
+    if (mmap_indexes_[shard_id] != nullptr) {
+      auto query = BuildIndexQuery(index_columns, page_id, criteria);
+      RETURN_IF_NOT_OK(mmap_indexes_[shard_id]->Select(query, labels.get()));
+    } else if (!criteria.first.empty()) {
       sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = " + ":criteria";
       RETURN_IF_NOT_OK(QueryWithCriteria(db, sql, criteria.second, labels));
     } else {
@@ -984,6 +1207,10 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   auto category_ptr = std::make_shared<std::set<std::string>>();
   sqlite3 *db = nullptr;
   for (int x = 0; x < shard_count; x++) {
+    if (x < static_cast<int>(mmap_indexes_.size()) && mmap_indexes_[x] != nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInIndex, this, x, *fn_ptr, category_ptr);
+      continue;
+    }
     std::string path_utf8 = "";
 #if defined(_WIN32) || defined(_WIN64)
     path_utf8 = FileUtils::GB2312ToUTF_8((file_paths_[x] + ".db").data());
@@ -1109,7 +1336,7 @@ Status ShardReader::Launch(bool is_sample_read) {
     return status;
   }
   if (is_sample_read) {
-    return Status::OK();
+    return StartReadAhead();
   }
   // Start provider consumer threads
   thread_set_ = std::vector<std::thread>(n_consumer_);
@@ -1322,6 +1549,33 @@ Status ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, uint
   return Status::OK();
 }
 
+Status ShardReader::StartReadAhead() {
+  // the blobs are located by the tasks, which do not have the offsets in lazy load mode
+  if (read_ahead_threads_ <= 0 || lazy_load_) {
+    return Status::OK();
+  }
+  if (read_ahead_ == nullptr) {
+    read_ahead_ = std::make_unique<ShardReadAhead>(file_paths_, read_ahead_threads_, read_ahead_cache_size_);
+  }
+  auto locator = [this](int64_t task_id, BlobLocation *location) {
+    ShardTask &task = tasks_.GetTaskByID(task_id);
+    if (std::get<0>(task) == TaskType::kPaddedTask) {
+      return false;
+    }
+    int shard_id = std::get<0>(std::get<1>(task));
+    int group_id = std::get<1>(std::get<1>(task));
+    std::shared_ptr<Page> page_ptr;
+    if (shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr).IsError()) {
+      return false;
+    }
+    location->shard_id = shard_id;
+    location->offset = header_size_ + page_size_ * page_ptr->GetPageID() + std::get<2>(task)[0];
+    location->length = std::get<2>(task)[1] - std::get<2>(task)[0];
+    return true;
+  };
+  return read_ahead_->Start(tasks_.sample_ids_, locator);
+}
+
 Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
                                     std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
   RETURN_UNEXPECTED_IF_NULL(task_content_ptr);
@@ -1367,25 +1621,28 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
     var_fields = local_columns[shard_id][0];  // scalar variable field
   }
 
-  // read the blob from data file
-  std::shared_ptr<Page> page_ptr;
-  RETURN_IF_NOT_OK(shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr));
-  MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
-
   // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
-  auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  std::vector<uint8_t> images;
+  if (read_ahead_ == nullptr || !read_ahead_->Get(task_id, &images)) {
+    // read the blob from data file
+    std::shared_ptr<Page> page_ptr;
+    RETURN_IF_NOT_OK(shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr));
+    MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to seekg file.");
-  }
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to read file.");
+    images.resize(blob_end - blob_start);
+    auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      file_streams_random_[consumer_id][shard_id]->close();
+      RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to seekg file.");
+    }
+    auto &io_read =
+      file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      file_streams_random_[consumer_id][shard_id]->close();
+      RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to read file.");
+    }
   }
 
   // Deliver batch data to output map
@@ -1507,6 +1764,10 @@ void ShardReader::Reset() {
 }
 
 void ShardReader::ShuffleTask() {
+  // the plan of the read ahead is changed by the shuffle
+  if (read_ahead_ != nullptr) {
+    read_ahead_->Stop();
+  }
   // exist shuffle and distributed sampler in ops, skip shuffle
   bool has_sharding = false;
   for (const auto &op : operators_) {
@@ -1528,6 +1789,12 @@ void ShardReader::ShuffleTask() {
     }
   }
   if (tasks_.permutation_.empty()) tasks_.MakePerm();
+  if (read_ahead_ != nullptr) {
+    auto s = StartReadAhead();
+    if (s.IsError()) {
+      MS_LOG(WARNING) << "[Internal ERROR] Failed to restart read ahead in new epoch.";
+    }
+  }
 }
 
 const std::vector<int64_t> *ShardReader::GetSampleIds() {
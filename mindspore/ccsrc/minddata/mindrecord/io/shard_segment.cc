@@ -28,7 +28,11 @@ using mindspore::MsLogLevel::INFO;
 
 namespace mindspore {
 namespace mindrecord {
-ShardSegment::ShardSegment() { SetAllInIndex(false); }
+ShardSegment::ShardSegment() {
+  SetAllInIndex(false);
+  // the category info is queried by sql
+  SetMmapIndex(false);
+}
 
 Status ShardSegment::GetCategoryFields(std::shared_ptr<vector<std::string>> *fields_ptr) {
   RETURN_UNEXPECTED_IF_NULL(fields_ptr);
@@ -19,6 +19,7 @@
 #include "utils/file_utils.h"
 #include "utils/ms_utils.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_mmap_index.h"
 #include "./securec.h"
 
 using mindspore::LogStream;
@@ -26,15 +27,37 @@ using mindspore::ExceptionType::NoExceptionType;
 using mindspore::MsLogLevel::DEBUG;
 using mindspore::MsLogLevel::ERROR;
 using mindspore::MsLogLevel::INFO;
+using mindspore::MsLogLevel::WARNING;
 
 namespace mindspore {
 namespace mindrecord {
 ShardWriter::ShardWriter()
-    : shard_count_(1), header_size_(kDefaultHeaderSize), page_size_(kDefaultPageSize), row_count_(0), schema_count_(1) {
+    : shard_count_(1),
+      header_size_(kDefaultHeaderSize),
+      page_size_(kDefaultPageSize),
+      row_count_(0),
+      schema_count_(1),
+      column_page_(false),
+      append_(false),
+      pipeline_(false),
+      pipeline_memory_(kDefaultPipelineMemory),
+      mmap_index_(false),
+      index_written_(false) {
   compression_size_ = 0;
 }
 
 ShardWriter::~ShardWriter() {
+  // drop the batches not written yet
+  {
+    std::lock_guard<std::mutex> lck(pipeline_mutex_);
+    pipeline_stop_ = true;
+  }
+  pipeline_cv_.notify_all();
+  for (auto &thread : pipeline_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; i--) {
     file_streams_[i]->close();
   }
@@ -110,6 +133,8 @@ Status ShardWriter::OpenDataFiles(bool append, bool overwrite) {
           if (res2 == 0) {
             MS_LOG(WARNING) << "Succeed to remove the old mindrecord metadata files, path: " << file + ".db";
           }
+          // the mmap index is optional, it is out of date once the mindrecord file is overwritten
+          (void)std::remove((whole_path.value() + kMmapIndexSuffix).c_str());
         } else {
           RETURN_STATUS_UNEXPECTED(
             "Invalid file, mindrecord files already exist. Please check file path: " + file +
@@ -169,6 +194,7 @@ Status ShardWriter::InitLockFile() {
 
 Status ShardWriter::Open(const std::vector<std::string> &paths, bool append, bool overwrite) {
   shard_count_ = paths.size();
+  append_ = append;
   CHECK_FAIL_RETURN_UNEXPECTED(schema_count_ <= kMaxSchemaCount,
                                "[Internal ERROR] 'schema_count_' should be less than or equal to " +
                                  std::to_string(kMaxSchemaCount) + ", but got: " + std::to_string(schema_count_));
@@ -194,20 +220,40 @@ Status ShardWriter::OpenForAppend(const std::string &path) {
   RETURN_IF_NOT_OK(SetHeaderSize(shard_header_->GetHeaderSize()));
   RETURN_IF_NOT_OK(SetPageSize(shard_header_->GetPageSize()));
   compression_size_ = shard_header_->GetCompressionSize();
+  schema_count_ = shard_header_->GetSchemaCount();
   RETURN_IF_NOT_OK(Open(*ds, true));
   shard_column_ = std::make_shared<ShardColumn>(shard_header_);
+  shard_column_page_ = std::make_shared<ShardColumnPage>(shard_header_->GetSchemas()[0]->GetSchema());
   return Status::OK();
 }
 
 Status ShardWriter::Commit() {
+  // Wait for the batches in the pipeline
+  RETURN_IF_NOT_OK(StopPipeline());
   // Read pages file
   std::ifstream page_file(pages_file_.c_str());
   if (page_file.good()) {
     page_file.close();
     RETURN_IF_NOT_OK(shard_header_->FileToPages(pages_file_));
   }
+  // Index the last row groups
+  if (index_generator_ != nullptr) {
+    std::vector<ROW_DATA> index_rows;
+    RETURN_IF_NOT_OK(CollectIndexRows(true, &index_rows));
+    for (size_t shard_id = 0; shard_id < index_rows.size(); ++shard_id) {
+      if (!index_rows[shard_id].empty()) {
+        RETURN_IF_NOT_OK(index_generator_->WriteRows(static_cast<int>(shard_id), index_rows[shard_id]));
+      }
+    }
+  }
   RETURN_IF_NOT_OK(WriteShardHeader());
   MS_LOG(INFO) << "Succeed to write meta data.";
+  if (index_generator_ != nullptr) {
+    RETURN_IF_NOT_OK(index_generator_->CloseIncremental());
+    index_generator_ = nullptr;
+    index_written_ = true;
+    MS_LOG(INFO) << "Succeed to write the index while writing the data.";
+  }
   // Remove lock file
   RETURN_IF_NOT_OK(RemoveLockFile());
 
@@ -243,9 +289,11 @@ Status ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data) {
   }
 
   shard_header_ = header_data;
+  schema_count_ = shard_header_->GetSchemaCount();
   shard_header_->SetHeaderSize(header_size_);
   shard_header_->SetPageSize(page_size_);
   shard_column_ = std::make_shared<ShardColumn>(shard_header_);
+  shard_column_page_ = std::make_shared<ShardColumnPage>(shard_header_->GetSchemas()[0]->GetSchema());
   return Status::OK();
 }
 
@@ -271,6 +319,28 @@ Status ShardWriter::SetPageSize(const uint64_t &page_size) {
   return Status::OK();
 }
 
+Status ShardWriter::SetColumnPage(bool column_page) {
+  column_page_ = column_page;
+  return Status::OK();
+}
+
+Status ShardWriter::SetPipeline(bool pipeline, int64_t max_memory) {
+  CHECK_FAIL_RETURN_UNEXPECTED(pipeline_threads_.empty(),
+                               "Invalid data, the pipeline can not be changed after writing starts.");
+  CHECK_FAIL_RETURN_UNEXPECTED(max_memory > 0, "Invalid data, the memory limit of the pipeline: " +
+                                                 std::to_string(max_memory) + " should be positive.");
+  pipeline_ = pipeline;
+  pipeline_memory_ = max_memory;
+  return Status::OK();
+}
+
+Status ShardWriter::SetMmapIndex(bool mmap_index) {
+  CHECK_FAIL_RETURN_UNEXPECTED(pipeline_threads_.empty(),
+                               "Invalid data, the mmap index can not be changed after writing starts.");
+  mmap_index_ = mmap_index;
+  return Status::OK();
+}
+
 void ShardWriter::DeleteErrorData(std::map<uint64_t, std::vector<json>> &raw_data,
                                   std::vector<std::vector<uint8_t>> &blob_data) {
   // get wrong data location
@@ -424,18 +494,22 @@ Status ShardWriter::ValidateRawData(std::map<uint64_t, std::vector<json>> &raw_d
                                     std::shared_ptr<std::pair<int, int>> *count_ptr) {
   RETURN_UNEXPECTED_IF_NULL(count_ptr);
   auto rawdata_iter = raw_data.begin();
-  schema_count_ = raw_data.size();
-  CHECK_FAIL_RETURN_UNEXPECTED(schema_count_ > 0, "Invalid data, the number of schema should be positive but got: " +
-                                                    std::to_string(schema_count_) + ". Please check the input schema.");
+  uint32_t schema_count = raw_data.size();
+  // the pipeline writes the previous batches meanwhile, its schema count is set by the header
+  if (!pipeline_) {
+    schema_count_ = schema_count;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(schema_count > 0, "Invalid data, the number of schema should be positive but got: " +
+                                                   std::to_string(schema_count) + ". Please check the input schema.");
 
   // keep schema_id
   std::set<int64_t> schema_ids;
   row_count_ = (rawdata_iter->second).size();
 
   // Determine if the number of schemas is the same
-  CHECK_FAIL_RETURN_UNEXPECTED(shard_header_->GetSchemas().size() == schema_count_,
+  CHECK_FAIL_RETURN_UNEXPECTED(shard_header_->GetSchemas().size() == schema_count,
                                "[Internal ERROR] 'schema_count_' and the schema count in schema: " +
-                                 std::to_string(schema_count_) + " do not match.");
+                                 std::to_string(schema_count) + " do not match.");
   // Determine raw_data size == blob_data size
   CHECK_FAIL_RETURN_UNEXPECTED(raw_data[0].size() == blob_data.size(),
                                "[Internal ERROR] raw data size: " + std::to_string(raw_data[0].size()) +
@@ -456,7 +530,7 @@ Status ShardWriter::ValidateRawData(std::map<uint64_t, std::vector<json>> &raw_d
                                             }),
                                "[Internal ERROR] schema id in 'schemas' can not found in 'schema_ids'.");
   if (!sign) {
-    *count_ptr = std::make_shared<std::pair<int, int>>(schema_count_, row_count_);
+    *count_ptr = std::make_shared<std::pair<int, int>>(schema_count, row_count_);
     return Status::OK();
   }
 
@@ -468,7 +542,7 @@ Status ShardWriter::ValidateRawData(std::map<uint64_t, std::vector<json>> &raw_d
 
   // update raw count
   row_count_ = row_count_ - err_mg_.begin()->second.size();
-  *count_ptr = std::make_shared<std::pair<int, int>>(schema_count_, row_count_);
+  *count_ptr = std::make_shared<std::pair<int, int>>(schema_count, row_count_);
   return Status::OK();
 }
 
@@ -560,21 +634,66 @@ Status ShardWriter::UnlockWriter(int fd, bool parallel_writer) {
 Status ShardWriter::WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>> &raw_data,
                                          std::vector<std::vector<uint8_t>> &blob_data, bool sign, int *schema_count,
                                          int *row_count) {
+  RETURN_IF_NOT_OK(CheckDiskSize());
+  RETURN_IF_NOT_OK(CompressBlobData(blob_data, false));
+  RETURN_IF_NOT_OK(PrepareRawData(raw_data, blob_data, sign, schema_count, row_count));
+  return Status::OK();
+}
+
+Status ShardWriter::CheckDiskSize() {
   // check the free disk size
   std::shared_ptr<uint64_t> size_ptr;
   RETURN_IF_NOT_OK(GetDiskSize(file_paths_[0], kFreeSize, &size_ptr));
   CHECK_FAIL_RETURN_UNEXPECTED(
     *size_ptr >= kMinFreeDiskSize,
     "No free disk to be used while writing mindrecord files, available free disk size: " + std::to_string(*size_ptr));
-  // compress blob
-  if (shard_column_->CheckCompressBlob()) {
+  return Status::OK();
+}
+
+Status ShardWriter::CompressBlobData(std::vector<std::vector<uint8_t>> &blob_data, bool parallel) {
+  if (!shard_column_->CheckCompressBlob() || blob_data.empty()) {
+    return Status::OK();
+  }
+  if (!parallel) {
     for (auto &blob : blob_data) {
       int64_t compression_bytes = 0;
       blob = shard_column_->CompressBlob(blob, &compression_bytes);
       compression_size_ += compression_bytes;
     }
+    return Status::OK();
+  }
+  uint32_t thread_num = std::thread::hardware_concurrency();
+  if (thread_num == 0) {
+    thread_num = kThreadNumber;
   }
+  thread_num = std::min(thread_num, static_cast<uint32_t>(blob_data.size()));
+  size_t group_num = (blob_data.size() + thread_num - 1) / thread_num;
+  std::vector<std::thread> thread_set;
+  for (uint32_t x = 0; x < thread_num; ++x) {
+    size_t start_num = x * group_num;
+    size_t end_num = std::min(blob_data.size(), start_num + group_num);
+    if (start_num >= end_num) {
+      break;
+    }
+    thread_set.emplace_back([this, &blob_data, start_num, end_num]() {
+      int64_t compression_size = 0;
+      for (size_t i = start_num; i < end_num; ++i) {
+        int64_t compression_bytes = 0;
+        blob_data[i] = shard_column_->CompressBlob(blob_data[i], &compression_bytes);
+        compression_size += compression_bytes;
+      }
+      compression_size_ += compression_size;
+    });
+  }
+  for (auto &thread : thread_set) {
+    thread.join();
+  }
+  return Status::OK();
+}
 
+Status ShardWriter::PrepareRawData(std::map<uint64_t, std::vector<json>> &raw_data,
+                                   std::vector<std::vector<uint8_t>> &blob_data, bool sign, int *schema_count,
+                                   int *row_count) {
   // Add 4-bytes dummy blob data if no any blob fields
   if (blob_data.size() == 0 && raw_data.size() > 0) {
     blob_data = std::vector<std::vector<uint8_t>>(raw_data[0].size(), std::vector<uint8_t>(kUnsignedInt4, 0));
@@ -629,6 +748,11 @@ Status ShardWriter::MergeBlobData(const std::vector<string> &blob_fields,
 
 Status ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                                  std::vector<std::vector<uint8_t>> &blob_data, bool sign, bool parallel_writer) {
+  if (pipeline_) {
+    CHECK_FAIL_RETURN_UNEXPECTED(!parallel_writer,
+                                 "Invalid data, the pipeline of the writer can not be used with 'parallel_writer'.");
+    return PushPipeline(raw_data, blob_data, sign);
+  }
   // Lock Writer if loading data parallel
   std::unique_ptr<int> fd_ptr;
   RETURN_IF_NOT_OK(LockWriter(parallel_writer, &fd_ptr));
@@ -651,7 +775,7 @@ Status ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data
   // Set row size of blob data
   RETURN_IF_NOT_OK(SetBlobDataSize(blob_data));
   // Write data to disk with multi threads
-  RETURN_IF_NOT_OK(ParallelWriteData(blob_data, bin_raw_data));
+  RETURN_IF_NOT_OK(ParallelWriteData(blob_data, bin_raw_data, raw_data));
   MS_LOG(INFO) << "Succeed to write " << bin_raw_data.size() << " records.";
 
   RETURN_IF_NOT_OK(UnlockWriter(*fd_ptr, parallel_writer));
@@ -695,9 +819,168 @@ Status ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>> &ra
   return WriteRawData(raw_data_json, bin_blob_data, sign, parallel_writer);
 }
 
+Status ShardWriter::StartPipeline() {
+  if (!pipeline_threads_.empty()) {
+    return Status::OK();
+  }
+  RETURN_UNEXPECTED_IF_NULL(shard_header_);
+  // the rows appended to existing files are indexed by ShardIndexGenerator after commit
+  if (!append_ && index_generator_ == nullptr) {
+    auto index_generator = std::make_shared<ShardIndexGenerator>(file_paths_[0], false, mmap_index_);
+    RETURN_IF_NOT_OK(index_generator->OpenIncremental(*shard_header_, file_paths_));
+    index_generator_ = index_generator;
+    pending_rows_ = std::vector<std::vector<PendingRow>>(shard_count_);
+  }
+  pipeline_status_ = Status::OK();
+  pipeline_stop_ = false;
+  pipeline_bytes_ = 0;
+  pipeline_batches_ = 0;
+  pipeline_queues_ = std::vector<std::deque<std::shared_ptr<WriteBatch>>>(kStageCount);
+  for (int stage = 0; stage < kStageCount; ++stage) {
+    pipeline_threads_.emplace_back(&ShardWriter::PipelineWorker, this, static_cast<PipelineStage>(stage));
+  }
+  MS_LOG(INFO) << "Start the pipeline of the writer, the memory limit is " << pipeline_memory_ << " bytes.";
+  return Status::OK();
+}
+
+Status ShardWriter::StopPipeline() {
+  if (pipeline_threads_.empty()) {
+    return Status::OK();
+  }
+  {
+    std::unique_lock<std::mutex> lck(pipeline_mutex_);
+    pipeline_cv_.wait(lck, [this] { return pipeline_batches_ == 0; });
+    pipeline_stop_ = true;
+  }
+  pipeline_cv_.notify_all();
+  for (auto &thread : pipeline_threads_) {
+    thread.join();
+  }
+  pipeline_threads_.clear();
+  return pipeline_status_;
+}
+
+Status ShardWriter::PushPipeline(std::map<uint64_t, std::vector<json>> &raw_data,
+                                 std::vector<std::vector<uint8_t>> &blob_data, bool sign) {
+  RETURN_IF_NOT_OK(CheckDiskSize());
+  RETURN_IF_NOT_OK(StartPipeline());
+  auto batch = std::make_shared<WriteBatch>();
+  batch->raw_data = std::move(raw_data);
+  batch->blob_data = std::move(blob_data);
+  batch->sign = sign;
+  for (const auto &blob : batch->blob_data) {
+    batch->bytes += static_cast<int64_t>(blob.size());
+  }
+  {
+    std::unique_lock<std::mutex> lck(pipeline_mutex_);
+    // a batch larger than the limit is queued once the pipeline is empty
+    pipeline_cv_.wait(lck, [this, &batch] {
+      return pipeline_status_.IsError() || pipeline_bytes_ == 0 || pipeline_bytes_ + batch->bytes <= pipeline_memory_;
+    });
+    RETURN_IF_NOT_OK(pipeline_status_);
+    pipeline_bytes_ += batch->bytes;
+    ++pipeline_batches_;
+    pipeline_queues_[kStageCompress].push_back(batch);
+  }
+  pipeline_cv_.notify_all();
+  return Status::OK();
+}
+
+void ShardWriter::PipelineWorker(PipelineStage stage) {
+  while (true) {
+    std::shared_ptr<WriteBatch> batch;
+    bool skip = false;
+    {
+      std::unique_lock<std::mutex> lck(pipeline_mutex_);
+      pipeline_cv_.wait(lck, [this, stage] { return pipeline_stop_ || !pipeline_queues_[stage].empty(); });
+      if (pipeline_queues_[stage].empty()) {
+        return;
+      }
+      batch = pipeline_queues_[stage].front();
+      pipeline_queues_[stage].pop_front();
+      // drop the batches after an error, or when the writer is destroyed before commit
+      skip = pipeline_status_.IsError() || pipeline_stop_;
+    }
+    Status rc = skip ? Status::OK() : RunStage(stage, batch.get());
+    {
+      std::lock_guard<std::mutex> lck(pipeline_mutex_);
+      if (rc.IsError() && pipeline_status_.IsOk()) {
+        pipeline_status_ = rc;
+      }
+      bool next = !skip && rc.IsOk() && stage + 1 < kStageCount;
+      if (!next || stage >= kStageWrite) {
+        // the rows are written, only their index goes on
+        pipeline_bytes_ -= batch->bytes;
+        batch->bytes = 0;
+      }
+      if (next) {
+        pipeline_queues_[stage + 1].push_back(batch);
+      } else {
+        --pipeline_batches_;
+      }
+    }
+    pipeline_cv_.notify_all();
+  }
+}
+
+Status ShardWriter::RunStage(PipelineStage stage, WriteBatch *batch) {
+  switch (stage) {
+    case kStageCompress:
+      return CompressBlobData(batch->blob_data, true);
+    case kStageSerialize: {
+      int schema_count = 0;
+      int row_count = 0;
+      RETURN_IF_NOT_OK(PrepareRawData(batch->raw_data, batch->blob_data, batch->sign, &schema_count, &row_count));
+      CHECK_FAIL_RETURN_UNEXPECTED(row_count >= kInt0, "[Internal ERROR] the size of raw data should be positive.");
+      batch->bin_raw_data = std::vector<std::vector<uint8_t>>(row_count * schema_count);
+      RETURN_IF_NOT_OK(SerializeRawData(batch->raw_data, batch->bin_raw_data, row_count));
+      int64_t raw_bytes = 0;
+      for (const auto &row : batch->bin_raw_data) {
+        raw_bytes += static_cast<int64_t>(row.size());
+      }
+      std::lock_guard<std::mutex> lck(pipeline_mutex_);
+      pipeline_bytes_ += raw_bytes;
+      batch->bytes += raw_bytes;
+      return Status::OK();
+    }
+    case kStageWrite:
+      return WriteBatchData(batch);
+    case kStageIndex:
+      for (size_t shard_id = 0; shard_id < batch->index_rows.size(); ++shard_id) {
+        if (!batch->index_rows[shard_id].empty()) {
+          RETURN_IF_NOT_OK(index_generator_->WriteRows(static_cast<int>(shard_id), batch->index_rows[shard_id]));
+        }
+      }
+      return Status::OK();
+    default:
+      RETURN_STATUS_UNEXPECTED("[Internal ERROR] unknown stage of the pipeline: " + std::to_string(stage));
+  }
+}
+
+Status ShardWriter::WriteBatchData(WriteBatch *batch) {
+  if (!batch->bin_raw_data.empty()) {
+    // Set row size of raw data
+    RETURN_IF_NOT_OK(SetRawDataSize(batch->bin_raw_data));
+    // Set row size of blob data
+    RETURN_IF_NOT_OK(SetBlobDataSize(batch->blob_data));
+    // Write data to disk with multi threads
+    RETURN_IF_NOT_OK(ParallelWriteData(batch->blob_data, batch->bin_raw_data, batch->raw_data));
+    MS_LOG(INFO) << "Succeed to write " << batch->bin_raw_data.size() << " records.";
+    if (index_generator_ != nullptr) {
+      RETURN_IF_NOT_OK(CollectIndexRows(false, &batch->index_rows));
+    }
+  }
+  // release the rows
+  batch->raw_data.clear();
+  std::vector<std::vector<uint8_t>>().swap(batch->blob_data);
+  std::vector<std::vector<uint8_t>>().swap(batch->bin_raw_data);
+  return Status::OK();
+}
+
 Status ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
-                                      const std::vector<std::vector<uint8_t>> &bin_raw_data) {
-  auto shards = BreakIntoShards();
+                                      const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                                      const std::map<uint64_t, std::vector<json>> &raw_data) {
+  auto shards = BreakIntoShards(static_cast<uint32_t>(raw_data_size_.size()));
   // define the number of thread
   int thread_num = static_cast<int>(shard_count_);
   CHECK_FAIL_RETURN_UNEXPECTED(thread_num > 0, "[Internal ERROR] 'thread_num' should be positive.");
@@ -706,6 +989,7 @@ Status ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>> &b
   }
   int left_thread = shard_count_;
   int current_thread = 0;
+  std::vector<Status> shard_status(shard_count_);
   while (left_thread) {
     if (left_thread < thread_num) {
       thread_num = left_thread;
@@ -716,8 +1000,11 @@ Status ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>> &b
       for (int x = 0; x < thread_num; ++x) {
         int start_row = shards[current_thread + x].first;
         int end_row = shards[current_thread + x].second;
-        thread_set[x] = std::thread(&ShardWriter::WriteByShard, this, current_thread + x, start_row, end_row,
-                                    std::ref(blob_data), std::ref(bin_raw_data));
+        int shard_id = current_thread + x;
+        thread_set[x] = std::thread([this, shard_id, start_row, end_row, &blob_data, &bin_raw_data, &raw_data,
+                                     &shard_status]() {
+          shard_status[shard_id] = WriteByShard(shard_id, start_row, end_row, blob_data, bin_raw_data, raw_data);
+        });
       }
       // Wait for threads done
       for (int x = 0; x < thread_num; ++x) {
@@ -727,12 +1014,16 @@ Status ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>> &b
       current_thread += thread_num;
     }
   }
+  for (const auto &status : shard_status) {
+    RETURN_IF_NOT_OK(status);
+  }
   return Status::OK();
 }
 
 Status ShardWriter::WriteByShard(int shard_id, int start_row, int end_row,
                                  const std::vector<std::vector<uint8_t>> &blob_data,
-                                 const std::vector<std::vector<uint8_t>> &bin_raw_data) {
+                                 const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                                 const std::map<uint64_t, std::vector<json>> &raw_data) {
   MS_LOG(DEBUG) << "Shard: " << shard_id << ", start: " << start_row << ", end: " << end_row
                 << ", schema size: " << schema_count_;
   if (start_row == end_row) {
@@ -743,13 +1034,130 @@ Status ShardWriter::WriteByShard(int shard_id, int start_row, int end_row,
   std::shared_ptr<Page> last_blob_page = nullptr;
   SetLastRawPage(shard_id, last_raw_page);
   SetLastBlobPage(shard_id, last_blob_page);
+  // The reader can only use the column pages if they cover all the rows of the shard
+  std::vector<std::shared_ptr<Page>> column_pages;
+  bool write_column_page = column_page_ && shard_header_->GetColumnPages(shard_id, &column_pages);
+  uint64_t shard_start_row = last_blob_page ? last_blob_page->GetEndRowID() : 0;
 
   RETURN_IF_NOT_OK(CutRowGroup(start_row, end_row, blob_data, rows_in_group, last_raw_page, last_blob_page));
+  if (index_generator_ != nullptr) {
+    RETURN_IF_NOT_OK(
+      RecordRowLocations(shard_id, shard_start_row, rows_in_group, last_raw_page, last_blob_page, raw_data));
+  }
   RETURN_IF_NOT_OK(AppendBlobPage(shard_id, blob_data, rows_in_group, last_blob_page));
   RETURN_IF_NOT_OK(NewBlobPage(shard_id, blob_data, rows_in_group, last_blob_page));
   RETURN_IF_NOT_OK(ShiftRawPage(shard_id, rows_in_group, last_raw_page));
   RETURN_IF_NOT_OK(WriteRawPage(shard_id, rows_in_group, last_raw_page, bin_raw_data));
+  if (write_column_page) {
+    RETURN_IF_NOT_OK(WriteColumnPage(shard_id, shard_start_row, rows_in_group, raw_data));
+  }
+
+  return Status::OK();
+}
+
+Status ShardWriter::RecordRowLocations(int shard_id, uint64_t shard_start_row,
+                                       const std::vector<std::pair<int, int>> &rows_in_group,
+                                       const std::shared_ptr<Page> &last_raw_page,
+                                       const std::shared_ptr<Page> &last_blob_page,
+                                       const std::map<uint64_t, std::vector<json>> &raw_data) {
+  // the first row group goes on with the last one of the shard, see AppendBlobPage and AppendRawPage
+  int row_group_id = last_blob_page ? last_blob_page->GetPageTypeID() : -1;
+  uint64_t blob_offset = last_blob_page ? last_blob_page->GetPageSize() : 0;
+  uint64_t raw_offset = last_raw_page ? last_raw_page->GetPageSize() - last_raw_page->GetLastRowGroupID().second : 0;
+  auto row_id = shard_start_row;
+  auto &pending_rows = pending_rows_[shard_id];
+  std::vector<json> schema_detail(raw_data.size());
+  for (size_t i = 0; i < rows_in_group.size(); ++i) {
+    if (i > 0) {
+      ++row_group_id;
+      blob_offset = 0;
+      raw_offset = 0;
+    }
+    for (int row = rows_in_group[i].first; row < rows_in_group[i].second; ++row) {
+      PendingRow pending_row{row_id++, row_group_id, raw_offset, raw_data_size_[row], blob_offset,
+                             blob_data_size_[row], {}};
+      size_t schema_index = 0;
+      for (const auto &schema_rows : raw_data) {
+        schema_detail[schema_index++] = schema_rows.second[row];
+      }
+      RETURN_IF_NOT_OK(index_generator_->AddIndexFieldByRawData(schema_detail, pending_row.index_fields));
+      raw_offset += raw_data_size_[row];
+      blob_offset += blob_data_size_[row];
+      pending_rows.push_back(std::move(pending_row));
+    }
+  }
+  return Status::OK();
+}
+
+Status ShardWriter::CollectIndexRows(bool all, std::vector<ROW_DATA> *index_rows) {
+  RETURN_UNEXPECTED_IF_NULL(index_rows);
+  index_rows->assign(pending_rows_.size(), ROW_DATA());
+  for (size_t shard_id = 0; shard_id < pending_rows_.size(); ++shard_id) {
+    auto &pending_rows = pending_rows_[shard_id];
+    if (pending_rows.empty()) {
+      continue;
+    }
+    // the last row group may get more rows or be shifted to a new raw page by the next batch
+    int last_row_group_id = std::numeric_limits<int>::max();
+    if (!all) {
+      std::shared_ptr<Page> last_blob_page;
+      RETURN_IF_NOT_OK(SetLastBlobPage(shard_id, last_blob_page));
+      last_row_group_id = last_blob_page->GetPageTypeID();
+    }
+    auto end = std::find_if(pending_rows.begin(), pending_rows.end(), [last_row_group_id](const PendingRow &row) {
+      return row.row_group_id >= last_row_group_id;
+    });
+    if (end == pending_rows.begin()) {
+      continue;
+    }
+
+    // the row groups are written since the last time, look for their pages from the end of the shard
+    int first_group = pending_rows.front().row_group_id;
+    int last_group = (end - 1)->row_group_id;
+    auto num_groups = static_cast<size_t>(last_group - first_group + 1);
+    std::map<int, int> blob_page_ids;
+    std::map<int, std::pair<int, uint64_t>> raw_groups;
+    for (int64_t page_id = shard_header_->GetLastPageId(shard_id);
+         page_id >= 0 && (blob_page_ids.size() < num_groups || raw_groups.size() < num_groups); --page_id) {
+      std::shared_ptr<Page> page;
+      RETURN_IF_NOT_OK(shard_header_->GetPage(shard_id, page_id, &page));
+      if (page->GetPageType() == kPageTypeBlob) {
+        if (page->GetPageTypeID() >= first_group && page->GetPageTypeID() <= last_group) {
+          blob_page_ids[page->GetPageTypeID()] = page_id;
+        }
+      } else if (page->GetPageType() == kPageTypeRaw) {
+        for (const auto &group : page->GetRowGroupIds()) {
+          if (group.first >= first_group && group.first <= last_group) {
+            // a row group shifted to a new raw page is deleted from the previous one
+            (void)raw_groups.emplace(group.first, std::make_pair(static_cast<int>(page_id), group.second));
+          }
+        }
+      }
+    }
 
+    auto &rows = (*index_rows)[shard_id];
+    for (auto it = pending_rows.begin(); it != end; ++it) {
+      auto blob_page = blob_page_ids.find(it->row_group_id);
+      auto raw_group = raw_groups.find(it->row_group_id);
+      CHECK_FAIL_RETURN_UNEXPECTED(blob_page != blob_page_ids.end() && raw_group != raw_groups.end(),
+                                   "[Internal ERROR] Failed to locate the pages of row group: " +
+                                     std::to_string(it->row_group_id) + " in shard: " + std::to_string(shard_id));
+      auto raw_offset = raw_group->second.second + it->raw_offset;
+      std::vector<std::tuple<std::string, std::string, std::string>> row;
+      row.emplace_back(":ROW_ID", "INTEGER", std::to_string(it->row_id));
+      row.emplace_back(":ROW_GROUP_ID", "INTEGER", std::to_string(it->row_group_id));
+      row.emplace_back(":PAGE_ID_RAW", "INTEGER", std::to_string(raw_group->second.first));
+      row.emplace_back(":PAGE_OFFSET_RAW", "INTEGER", std::to_string(raw_offset));
+      row.emplace_back(":PAGE_OFFSET_RAW_END", "INTEGER", std::to_string(raw_offset + it->raw_size));
+      row.emplace_back(":PAGE_ID_BLOB", "INTEGER", std::to_string(blob_page->second));
+      row.emplace_back(":PAGE_OFFSET_BLOB", "INTEGER", std::to_string(it->blob_offset));
+      row.emplace_back(":PAGE_OFFSET_BLOB_END", "INTEGER", std::to_string(it->blob_offset + it->blob_size));
+      (void)row.insert(row.end(), std::make_move_iterator(it->index_fields.begin()),
+                       std::make_move_iterator(it->index_fields.end()));
+      rows.push_back(std::move(row));
+    }
+    (void)pending_rows.erase(pending_rows.begin(), end);
+  }
   return Status::OK();
 }
 
@@ -977,6 +1385,57 @@ Status ShardWriter::AppendRawPage(const int &shard_id, const std::vector<std::pa
   return Status::OK();
 }
 
+Status ShardWriter::WriteColumnPage(const int &shard_id, const uint64_t &shard_start_row,
+                                    const std::vector<std::pair<int, int>> &rows_in_group,
+                                    const std::map<uint64_t, std::vector<json>> &raw_data) {
+  if (schema_count_ != 1 || raw_data.size() != 1 || shard_column_page_ == nullptr ||
+      shard_column_page_->GetColumns().empty()) {
+    return Status::OK();
+  }
+  const auto &rows = raw_data.begin()->second;
+  auto current_row = shard_start_row;
+  int page_type_id = -1;
+  auto last_column_page_id = shard_header_->GetLastPageIdByType(shard_id, kPageTypeColumn);
+  if (last_column_page_id >= 0) {
+    std::shared_ptr<Page> last_column_page;
+    RETURN_IF_NOT_OK(shard_header_->GetPage(shard_id, last_column_page_id, &last_column_page));
+    page_type_id = last_column_page->GetPageTypeID();
+  }
+  for (const auto &blob_row : rows_in_group) {
+    if (blob_row.first == blob_row.second) {
+      continue;
+    }
+    std::vector<uint8_t> page_data;
+    json column_stats;
+    Status rc = shard_column_page_->Encode(rows, blob_row.first, blob_row.second, &page_data, &column_stats);
+    if (rc.IsError() || page_data.size() > page_size_) {
+      // Leave the rest of the shard in raw pages only, the reader falls back to them
+      MS_LOG(WARNING) << "Skip column pages of shard " << shard_id << " from row " << current_row << ", "
+                      << (rc.IsError() ? rc.GetErrDescription() : "the column page is larger than the page size.");
+      return Status::OK();
+    }
+    auto page_id = shard_header_->GetLastPageId(shard_id) + 1;
+    auto &io_seekp = file_streams_[shard_id]->seekp(page_size_ * page_id + header_size_, std::ios::beg);
+    if (!io_seekp.good() || io_seekp.fail() || io_seekp.bad()) {
+      file_streams_[shard_id]->close();
+      RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to seekg file.");
+    }
+    auto &io_handle = file_streams_[shard_id]->write(reinterpret_cast<char *>(&page_data[0]), page_data.size());
+    if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
+      file_streams_[shard_id]->close();
+      RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to write file.");
+    }
+
+    auto end_row = current_row + blob_row.second - blob_row.first;
+    auto page = std::make_shared<Page>(page_id, shard_id, kPageTypeColumn, ++page_type_id, current_row, end_row,
+                                       std::vector<std::pair<int, uint64_t>>(), page_data.size());
+    page->SetColumnStats(column_stats);
+    RETURN_IF_NOT_OK(shard_header_->AddPage(page));
+    current_row = end_row;
+  }
+  return Status::OK();
+}
+
 Status ShardWriter::FlushBlobChunk(const std::shared_ptr<std::fstream> &out,
                                    const std::vector<std::vector<uint8_t>> &blob_data,
                                    const std::pair<int, int> &blob_row) {
@@ -1031,10 +1490,10 @@ Status ShardWriter::FlushRawChunk(const std::shared_ptr<std::fstream> &out,
 }
 
 // Allocate data to shards evenly
-std::vector<std::pair<int, int>> ShardWriter::BreakIntoShards() {
+std::vector<std::pair<int, int>> ShardWriter::BreakIntoShards(uint32_t row_count) {
   std::vector<std::pair<int, int>> shards;
-  int row_in_shard = row_count_ / shard_count_;
-  int remains = row_count_ % shard_count_;
+  int row_in_shard = row_count / shard_count_;
+  int remains = row_count % shard_count_;
 
   std::vector<int> v_list(shard_count_);
   std::iota(v_list.begin(), v_list.end(), 0);
@@ -1129,8 +1588,9 @@ Status ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_
 }
 
 Status ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data) {
-  raw_data_size_ = std::vector<uint64_t>(row_count_, 0);
-  for (uint32_t i = 0; i < row_count_; ++i) {
+  uint32_t row_count = bin_raw_data.size() / schema_count_;
+  raw_data_size_ = std::vector<uint64_t>(row_count, 0);
+  for (uint32_t i = 0; i < row_count; ++i) {
     raw_data_size_[i] = std::accumulate(
       bin_raw_data.begin() + (i * schema_count_), bin_raw_data.begin() + (i * schema_count_) + schema_count_, 0,
       [](uint64_t accumulator, const std::vector<uint8_t> &row) { return accumulator + kInt64Len + row.size(); });
@@ -1143,7 +1603,7 @@ Status ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_
 }
 
 Status ShardWriter::SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data) {
-  blob_data_size_ = std::vector<uint64_t>(row_count_);
+  blob_data_size_ = std::vector<uint64_t>(blob_data.size());
   (void)std::transform(blob_data.begin(), blob_data.end(), blob_data_size_.begin(),
                        [](const std::vector<uint8_t> &row) { return kInt64Len + row.size(); });
   CHECK_FAIL_RETURN_SYNTAX_ERROR(*std::max_element(blob_data_size_.begin(), blob_data_size_.end()) <= page_size_,
@@ -0,0 +1,399 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_column_page.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+#include "minddata/mindrecord/include/shard_error.h"
+#include "./securec.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+constexpr uint8_t kVarintMask = 0x7f;
+constexpr uint8_t kVarintContinue = 0x80;
+constexpr uint32_t kVarintShift = 7;
+constexpr uint32_t kMaxVarintShift = 63;
+
+template <typename T>
+void AppendValue(const T &value, std::vector<uint8_t> *buf) {
+  auto bytes = reinterpret_cast<const uint8_t *>(&value);
+  (void)buf->insert(buf->end(), bytes, bytes + sizeof(T));
+}
+
+void AppendVarint(uint64_t value, std::vector<uint8_t> *buf) {
+  while (value >= kVarintContinue) {
+    buf->push_back(static_cast<uint8_t>(value & kVarintMask) | kVarintContinue);
+    value >>= kVarintShift;
+  }
+  buf->push_back(static_cast<uint8_t>(value));
+}
+
+void AppendString(const std::string &value, std::vector<uint8_t> *buf) {
+  AppendValue(static_cast<uint32_t>(value.size()), buf);
+  (void)buf->insert(buf->end(), value.begin(), value.end());
+}
+
+template <typename T>
+Status ReadValue(const std::vector<uint8_t> &buf, uint64_t *pos, T *value) {
+  CHECK_FAIL_RETURN_UNEXPECTED(*pos + sizeof(T) <= buf.size(), "[Internal ERROR] column page is truncated.");
+  CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(value, sizeof(T), buf.data() + *pos, sizeof(T)) == EOK,
+                               "[Internal ERROR] Failed to call securec func [memcpy_s]");
+  *pos += sizeof(T);
+  return Status::OK();
+}
+
+Status ReadVarint(const std::vector<uint8_t> &buf, uint64_t *pos, uint64_t *value) {
+  *value = 0;
+  for (uint32_t shift = 0; shift <= kMaxVarintShift; shift += kVarintShift) {
+    CHECK_FAIL_RETURN_UNEXPECTED(*pos < buf.size(), "[Internal ERROR] column page is truncated.");
+    uint8_t byte = buf[(*pos)++];
+    *value |= static_cast<uint64_t>(byte & kVarintMask) << shift;
+    if ((byte & kVarintContinue) == 0) {
+      return Status::OK();
+    }
+  }
+  RETURN_STATUS_UNEXPECTED("[Internal ERROR] varint in column page is too long.");
+}
+
+Status ReadString(const std::vector<uint8_t> &buf, uint64_t *pos, std::string *value) {
+  uint32_t len = 0;
+  RETURN_IF_NOT_OK(ReadValue(buf, pos, &len));
+  CHECK_FAIL_RETURN_UNEXPECTED(*pos + len <= buf.size(), "[Internal ERROR] column page is truncated.");
+  value->assign(reinterpret_cast<const char *>(buf.data() + *pos), len);
+  *pos += len;
+  return Status::OK();
+}
+
+Status GetInteger(const json &value, ColumnDataType type, int64_t *integer) {
+  CHECK_FAIL_RETURN_UNEXPECTED(value.is_number_integer(), "value: " + value.dump() + " is not an integer.");
+  if (value.is_number_unsigned()) {
+    CHECK_FAIL_RETURN_UNEXPECTED(value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()),
+                                 "value: " + value.dump() + " is out of the range of int64.");
+  }
+  *integer = value.get<int64_t>();
+  if (type == ColumnInt32) {
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      *integer >= std::numeric_limits<int32_t>::min() && *integer <= std::numeric_limits<int32_t>::max(),
+      "value: " + value.dump() + " is out of the range of int32.");
+  }
+  return Status::OK();
+}
+}  // namespace
+
+ShardColumnPage::ShardColumnPage(const json &schema) {
+  auto fields = schema["schema"];
+  auto blob_fields = schema["blob_fields"];
+  for (auto it = fields.begin(); it != fields.end(); ++it) {
+    if (std::find(blob_fields.begin(), blob_fields.end(), it.key()) != blob_fields.end()) {
+      continue;
+    }
+    auto type = ColumnDataTypeMap.find(it.value()["type"].get<std::string>());
+    if (type == ColumnDataTypeMap.end() || type->second == ColumnBytes) {
+      continue;
+    }
+    columns_.push_back(it.key());
+    column_types_.push_back(type->second);
+  }
+}
+
+int ShardColumnPage::GetColumnId(const std::string &column) const {
+  auto it = std::find(columns_.begin(), columns_.end(), column);
+  return it == columns_.end() ? -1 : static_cast<int>(it - columns_.begin());
+}
+
+Status ShardColumnPage::Encode(const std::vector<json> &rows, int start_row, int end_row, std::vector<uint8_t> *page,
+                               json *column_stats) const {
+  RETURN_UNEXPECTED_IF_NULL(page);
+  RETURN_UNEXPECTED_IF_NULL(column_stats);
+  CHECK_FAIL_RETURN_UNEXPECTED(start_row >= 0 && start_row <= end_row && end_row <= static_cast<int>(rows.size()),
+                               "[Internal ERROR] rows [" + std::to_string(start_row) + ", " + std::to_string(end_row) +
+                                 ") are out of range.");
+  // The raw pages of the rows are written as well, the column page is an extra copy the reader may use instead.
+  // So it has to rebuild the same json as the raw page, which needs every row to have exactly the columns.
+  for (int i = start_row; i < end_row; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(rows[i].is_object() && rows[i].size() == columns_.size(),
+                                 "row: " + std::to_string(i) + " has fields out of the column page.");
+    for (const auto &column : columns_) {
+      CHECK_FAIL_RETURN_UNEXPECTED(rows[i].find(column) != rows[i].end(),
+                                   "row: " + std::to_string(i) + " does not have field: " + column);
+    }
+  }
+
+  page->clear();
+  AppendValue(static_cast<uint64_t>(end_row - start_row), page);
+  AppendValue(static_cast<uint32_t>(columns_.size()), page);
+  // Reserve the chunk directory, it is filled after the chunks are encoded
+  page->resize(GetHeadSize(), 0);
+  *column_stats = json::object();
+  for (size_t column_id = 0; column_id < columns_.size(); ++column_id) {
+    ColumnEncoding encoding = kColumnPlain;
+    std::vector<uint8_t> chunk;
+    json stats;
+    RETURN_IF_NOT_OK(EncodeColumn(column_id, rows, start_row, end_row, &encoding, &chunk, &stats));
+    if (!stats.empty()) {
+      (*column_stats)[columns_[column_id]] = stats;
+    }
+
+    std::vector<uint8_t> entry;
+    entry.push_back(static_cast<uint8_t>(encoding));
+    AppendValue(static_cast<uint64_t>(page->size()), &entry);
+    AppendValue(static_cast<uint64_t>(chunk.size()), &entry);
+    std::copy(entry.begin(), entry.end(),
+              page->begin() + kColumnPageRowsLen + kColumnPageColumnsLen + column_id * kColumnChunkEntryLen);
+    (void)page->insert(page->end(), chunk.begin(), chunk.end());
+  }
+  return Status::OK();
+}
+
+Status ShardColumnPage::EncodeColumn(int column_id, const std::vector<json> &rows, int start_row, int end_row,
+                                     ColumnEncoding *encoding, std::vector<uint8_t> *chunk, json *stats) const {
+  const auto &column = columns_[column_id];
+  auto type = column_types_[column_id];
+  if (type == ColumnInt32 || type == ColumnInt64) {
+    std::vector<int64_t> values;
+    for (int i = start_row; i < end_row; ++i) {
+      int64_t value = 0;
+      RETURN_IF_NOT_OK(GetInteger(rows[i][column], type, &value));
+      values.push_back(value);
+    }
+    if (values.empty()) {
+      return Status::OK();
+    }
+    auto min_max = std::minmax_element(values.begin(), values.end());
+    int64_t min_value = *min_max.first;
+    (*stats)["min"] = *min_max.first;
+    (*stats)["max"] = *min_max.second;
+
+    // Store the deltas to the minimum as varint, unless it is larger than the plain values
+    std::vector<uint8_t> delta;
+    AppendValue(min_value, &delta);
+    for (auto value : values) {
+      AppendVarint(static_cast<uint64_t>(value) - static_cast<uint64_t>(min_value), &delta);
+    }
+    if (delta.size() < values.size() * ColumnDataTypeSize[type]) {
+      *encoding = kColumnDeltaVarint;
+      *chunk = std::move(delta);
+      return Status::OK();
+    }
+    *encoding = kColumnPlain;
+    for (auto value : values) {
+      if (type == ColumnInt32) {
+        AppendValue(static_cast<int32_t>(value), chunk);
+      } else {
+        AppendValue(value, chunk);
+      }
+    }
+    return Status::OK();
+  }
+
+  if (type == ColumnFloat32 || type == ColumnFloat64) {
+    *encoding = kColumnPlain;
+    bool has_nan = false;
+    double min_value = std::numeric_limits<double>::max();
+    double max_value = std::numeric_limits<double>::lowest();
+    for (int i = start_row; i < end_row; ++i) {
+      const auto &value = rows[i][column];
+      CHECK_FAIL_RETURN_UNEXPECTED(value.is_number(), "value: " + value.dump() + " is not a number.");
+      double number = value.get<double>();
+      if (type == ColumnFloat32) {
+        AppendValue(static_cast<float>(number), chunk);
+      } else {
+        AppendValue(number, chunk);
+      }
+      has_nan = has_nan || std::isnan(number);
+      min_value = std::min(min_value, number);
+      max_value = std::max(max_value, number);
+    }
+    if (!has_nan && start_row < end_row) {
+      (*stats)["min"] = min_value;
+      (*stats)["max"] = max_value;
+    }
+    return Status::OK();
+  }
+
+  std::vector<std::string> values;
+  for (int i = start_row; i < end_row; ++i) {
+    const auto &value = rows[i][column];
+    CHECK_FAIL_RETURN_UNEXPECTED(value.is_string(), "value: " + value.dump() + " is not a string.");
+    values.push_back(value.get<std::string>());
+  }
+  if (values.empty()) {
+    return Status::OK();
+  }
+  auto min_max = std::minmax_element(values.begin(), values.end());
+  if (min_max.first->size() <= kMaxColumnStatsLength && min_max.second->size() <= kMaxColumnStatsLength) {
+    (*stats)["min"] = *min_max.first;
+    (*stats)["max"] = *min_max.second;
+  }
+
+  std::unordered_map<std::string, uint64_t> dictionary;
+  for (const auto &value : values) {
+    (void)dictionary.emplace(value, dictionary.size());
+  }
+  // Labels and file names of a dataset usually repeat, keep them once in a dictionary
+  if (dictionary.size() * 2 <= values.size()) {
+    *encoding = kColumnDictionary;
+    std::vector<const std::string *> words(dictionary.size());
+    for (const auto &word : dictionary) {
+      words[word.second] = &word.first;
+    }
+    AppendValue(static_cast<uint32_t>(words.size()), chunk);
+    for (const auto word : words) {
+      AppendString(*word, chunk);
+    }
+    for (const auto &value : values) {
+      AppendVarint(dictionary[value], chunk);
+    }
+    return Status::OK();
+  }
+  *encoding = kColumnPlain;
+  for (const auto &value : values) {
+    AppendString(value, chunk);
+  }
+  return Status::OK();
+}
+
+Status ShardColumnPage::DecodeHead(const std::vector<uint8_t> &head, uint64_t *num_rows,
+                                   std::vector<ColumnChunk> *chunks) const {
+  RETURN_UNEXPECTED_IF_NULL(num_rows);
+  RETURN_UNEXPECTED_IF_NULL(chunks);
+  uint64_t pos = 0;
+  uint32_t num_columns = 0;
+  RETURN_IF_NOT_OK(ReadValue(head, &pos, num_rows));
+  RETURN_IF_NOT_OK(ReadValue(head, &pos, &num_columns));
+  CHECK_FAIL_RETURN_UNEXPECTED(num_columns == columns_.size(),
+                               "[Internal ERROR] column page has " + std::to_string(num_columns) +
+                                 " columns, but the schema has " + std::to_string(columns_.size()) + " columns.");
+  chunks->clear();
+  for (uint32_t i = 0; i < num_columns; ++i) {
+    uint8_t encoding = 0;
+    ColumnChunk chunk{kColumnPlain, 0, 0};
+    RETURN_IF_NOT_OK(ReadValue(head, &pos, &encoding));
+    RETURN_IF_NOT_OK(ReadValue(head, &pos, &chunk.offset));
+    RETURN_IF_NOT_OK(ReadValue(head, &pos, &chunk.size));
+    CHECK_FAIL_RETURN_UNEXPECTED(encoding <= kColumnDictionary,
+                                 "[Internal ERROR] unknown encoding: " + std::to_string(encoding) + " in column page.");
+    chunk.encoding = static_cast<ColumnEncoding>(encoding);
+    chunks->push_back(chunk);
+  }
+  return Status::OK();
+}
+
+Status ShardColumnPage::DecodeColumn(int column_id, const ColumnChunk &chunk, const std::vector<uint8_t> &data,
+                                     uint64_t num_rows, std::vector<json> *values) const {
+  RETURN_UNEXPECTED_IF_NULL(values);
+  CHECK_FAIL_RETURN_UNEXPECTED(column_id >= 0 && column_id < static_cast<int>(columns_.size()),
+                               "[Internal ERROR] column id: " + std::to_string(column_id) + " is out of range.");
+  auto type = column_types_[column_id];
+  values->clear();
+  values->reserve(num_rows);
+  uint64_t pos = 0;
+  if (chunk.encoding == kColumnDeltaVarint) {
+    int64_t min_value = 0;
+    RETURN_IF_NOT_OK(ReadValue(data, &pos, &min_value));
+    for (uint64_t i = 0; i < num_rows; ++i) {
+      uint64_t delta = 0;
+      RETURN_IF_NOT_OK(ReadVarint(data, &pos, &delta));
+      values->emplace_back(static_cast<int64_t>(static_cast<uint64_t>(min_value) + delta));
+    }
+    return Status::OK();
+  }
+  if (chunk.encoding == kColumnDictionary) {
+    uint32_t num_words = 0;
+    RETURN_IF_NOT_OK(ReadValue(data, &pos, &num_words));
+    std::vector<std::string> words(num_words);
+    for (auto &word : words) {
+      RETURN_IF_NOT_OK(ReadString(data, &pos, &word));
+    }
+    for (uint64_t i = 0; i < num_rows; ++i) {
+      uint64_t word_id = 0;
+      RETURN_IF_NOT_OK(ReadVarint(data, &pos, &word_id));
+      CHECK_FAIL_RETURN_UNEXPECTED(word_id < words.size(), "[Internal ERROR] word id in column page is out of range.");
+      values->emplace_back(words[word_id]);
+    }
+    return Status::OK();
+  }
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    switch (type) {
+      case ColumnInt32: {
+        int32_t value = 0;
+        RETURN_IF_NOT_OK(ReadValue(data, &pos, &value));
+        values->emplace_back(value);
+        break;
+      }
+      case ColumnInt64: {
+        int64_t value = 0;
+        RETURN_IF_NOT_OK(ReadValue(data, &pos, &value));
+        values->emplace_back(value);
+        break;
+      }
+      case ColumnFloat32: {
+        float value = 0;
+        RETURN_IF_NOT_OK(ReadValue(data, &pos, &value));
+        values->emplace_back(static_cast<double>(value));
+        break;
+      }
+      case ColumnFloat64: {
+        double value = 0;
+        RETURN_IF_NOT_OK(ReadValue(data, &pos, &value));
+        values->emplace_back(value);
+        break;
+      }
+      default: {
+        std::string value;
+        RETURN_IF_NOT_OK(ReadString(data, &pos, &value));
+        values->emplace_back(std::move(value));
+        break;
+      }
+    }
+  }
+  return Status::OK();
+}
+
+bool ShardColumnPage::MayContain(const json &column_stats, const std::string &column, const std::string &value) const {
+  int column_id = GetColumnId(column);
+  if (column_id < 0 || column_stats.find(column) == column_stats.end()) {
+    return true;
+  }
+  const auto &stats = column_stats[column];
+  try {
+    switch (column_types_[column_id]) {
+      case ColumnInt32:
+      case ColumnInt64: {
+        size_t end = 0;
+        auto number = std::stoll(value, &end);
+        return end != value.size() || (number >= stats["min"].get<int64_t>() && number <= stats["max"].get<int64_t>());
+      }
+      case ColumnFloat32:
+      case ColumnFloat64: {
+        size_t end = 0;
+        auto number = std::stod(value, &end);
+        return end != value.size() || (number >= stats["min"].get<double>() && number <= stats["max"].get<double>());
+      }
+      default:
+        return value >= stats["min"].get<std::string>() && value <= stats["max"].get<std::string>();
+    }
+  } catch (...) {
+    return true;
+  }
+}
+}  // namespace mindrecord
+}  // namespace mindspore
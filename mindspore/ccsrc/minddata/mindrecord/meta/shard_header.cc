@@ -16,6 +16,7 @@
 
 #include "minddata/mindrecord/include/shard_header.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -269,6 +270,9 @@ Status ShardHeader::ParsePage(const json &pages, int shard_index, bool load_data
 
     std::shared_ptr<Page> parsed_page = std::make_shared<Page>(page_id, shard_id, page_type, page_type_id, start_row_id,
                                                                end_row_id, row_group_ids, page_size);
+    if (page.find("column_stats") != page.end()) {
+      parsed_page->SetColumnStats(page["column_stats"]);
+    }
     if (load_dataset == true) {
       pages_[shard_id].push_back(std::move(parsed_page));
     } else {
@@ -455,6 +459,33 @@ Status ShardHeader::GetPageByGroupId(const int &group_id, const int &shard_id, s
   RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to get Page, 'group_id': " + std::to_string(group_id));
 }
 
+bool ShardHeader::GetColumnPages(const int &shard_id, std::vector<std::shared_ptr<Page>> *column_pages) {
+  if (column_pages == nullptr || shard_id < 0 || shard_id >= static_cast<int>(pages_.size())) {
+    return false;
+  }
+  column_pages->clear();
+  // column pages are appended in the order of rows, so they are contiguous if each one starts where the last one ends
+  uint64_t column_rows = 0;
+  uint64_t blob_rows = 0;
+  for (const auto &page : pages_[shard_id]) {
+    if (page->GetPageType() == kPageTypeBlob) {
+      blob_rows = std::max(blob_rows, page->GetEndRowID());
+    } else if (page->GetPageType() == kPageTypeColumn) {
+      if (page->GetStartRowID() != column_rows) {
+        column_pages->clear();
+        return false;
+      }
+      column_rows = page->GetEndRowID();
+      column_pages->push_back(page);
+    }
+  }
+  if (column_rows != blob_rows) {
+    column_pages->clear();
+    return false;
+  }
+  return true;
+}
+
 int ShardHeader::AddSchema(std::shared_ptr<Schema> schema) {
   if (schema == nullptr) {
     MS_LOG(ERROR) << "[Internal ERROR] The pointer of schema is NULL.";
@@ -41,6 +41,9 @@ json Page::GetPage() const {
     }
   }
   str_page["page_size"] = page_size_;
+  if (!column_stats_.empty()) {
+    str_page["column_stats"] = column_stats_;
+  }
   return str_page;
 }
 
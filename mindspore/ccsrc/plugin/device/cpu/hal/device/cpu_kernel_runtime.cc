@@ -58,6 +58,27 @@ bool CPUKernelRuntime::Init() {
   return true;
 }
 
+namespace {
+// The memory plan of CPUSimpleMemPlan gives every kernel output a fixed place, so the graph whose kernel sizes change
+// at runtime, or whose communication kernels need continuous memory, is still assigned by the somas. So is the graph
+// dumped with all kernels, whose memory reuse is turned off by AssignDynamicMemory.
+bool CanPlanMemReuse(const session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  if (kernel_graph->is_dynamic_shape()) {
+    return false;
+  }
+#ifndef ENABLE_SECURITY
+  auto &dump_json_parser = DumpJsonParser::GetInstance();
+  if (dump_json_parser.e2e_dump_enabled() && dump_json_parser.dump_mode() == 0) {
+    return false;
+  }
+#endif
+  const auto &kernels = kernel_graph->execution_order();
+  return std::none_of(kernels.begin(), kernels.end(),
+                      [](const CNodePtr &kernel) { return common::AnfAlgo::IsCommunicationOp(kernel); });
+}
+}  // namespace
+
 const size_t INIT_NODE_REF = 1;
 void CPUKernelRuntime::AssignKernelGraphAddress(session::KernelGraph *kernel_graph) {
   AssignValueNodeAddress(kernel_graph);
@@ -69,7 +90,11 @@ void CPUKernelRuntime::AssignKernelGraphAddress(session::KernelGraph *kernel_gra
     // disable mem reuse for kPynativeMode
     is_enable_mem_reuse = false;
   }
-  if (is_enable_mem_reuse) {
+  if (is_enable_mem_reuse && CanPlanMemReuse(kernel_graph)) {
+    // The kernel outputs and workspaces share one memory by their lifetime in the execution order.
+    AssignKernelOutputAddress(kernel_graph);
+    static_cast<CPUMemoryManager *>(mem_manager_.get())->AssignMemory(kernel_graph, true);
+  } else if (is_enable_mem_reuse) {
     MS_EXCEPTION_IF_NULL(mem_manager_);
     mem_manager_->ResetDynamicMemory();
     MS_EXCEPTION_IF_NULL(kernel_graph);
@@ -80,7 +105,7 @@ void CPUKernelRuntime::AssignKernelGraphAddress(session::KernelGraph *kernel_gra
 #endif
   } else {
     AssignKernelOutputAddress(kernel_graph);
-    static_cast<CPUMemoryManager *>(mem_manager_.get())->AssignMemory(kernel_graph);
+    static_cast<CPUMemoryManager *>(mem_manager_.get())->AssignMemory(kernel_graph, false);
   }
 }
 
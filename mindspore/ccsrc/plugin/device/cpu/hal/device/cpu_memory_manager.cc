@@ -75,27 +75,24 @@ void CPUMemoryManager::ResetDynamicMemory() {
 CPUMemoryManager::~CPUMemoryManager() { MemFree(); }
 
 void CPUMemoryManager::MemFree() noexcept {
-  if (mem_ptr_ != nullptr) {
-    mem_ptr_ = nullptr;
-    mem_size_ = 0;
-  }
+  graph_mem_.clear();
   static_mem_.clear();
   dynamic_mem_.clear();
   cached_mem_.clear();
   mem_block_map_.clear();
 }
 
-void CPUMemoryManager::AssignMemory(const session::KernelGraph *graph) {
-  size_t graph_mem_size = mem_plan_.MemPlan(graph);
-  if (graph_mem_size > mem_size_) {
-    if (mem_size_ > 0) {
-      dynamic_mem_[mem_ptr_] = mem_size_;
-      mem_size_ = 0;
-    }
-    mem_ptr_ = MemMalloc(graph_mem_size);
-    if (mem_ptr_ != nullptr) {
-      MS_LOG(INFO) << "Simple MemPlan GraphMemSize [" << graph_mem_size << "]";
-      mem_size_ = graph_mem_size;
+void CPUMemoryManager::AssignMemory(const session::KernelGraph *graph, bool mem_reuse) {
+  MS_EXCEPTION_IF_NULL(graph);
+  size_t graph_mem_size = mem_plan_.MemPlan(graph, mem_reuse);
+  // Each graph has its own memory, the outputs of a graph must not be overwritten when the other graphs run. The old
+  // memory of a graph assigned again is kept, for the addresses which already point into it.
+  auto &graph_mem = graph_mem_[graph->graph_id()];
+  if (graph_mem_size > graph_mem.second) {
+    auto mem_ptr = MemMalloc(graph_mem_size);
+    if (mem_ptr != nullptr) {
+      MS_LOG(INFO) << "Simple MemPlan graph " << graph->graph_id() << " GraphMemSize [" << graph_mem_size << "]";
+      graph_mem = std::make_pair(mem_ptr, graph_mem_size);
       dynamic_malloc_ = false;
     } else {
       MS_LOG(INFO) << "Switch to dynamic malloc";
@@ -105,7 +102,7 @@ void CPUMemoryManager::AssignMemory(const session::KernelGraph *graph) {
   if (dynamic_malloc_) {
     return;
   }
-  mem_plan_.MemAssign(graph, mem_ptr_);
+  mem_plan_.MemAssign(graph, graph_mem.first);
 }
 
 void *CPUMemoryManager::StaticMemMalloc(size_t mem_size) {
@@ -19,6 +19,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <utility>
 #include "backend/common/session/kernel_graph.h"
 #include "backend/common/session/session_basic.h"
 #include "runtime/device/device_address.h"
@@ -38,7 +39,7 @@ class CPUMemoryManager : public MemoryManager {
   void Finalize() override { CPUMemoryPool::GetInstance().ReleaseDeviceRes(); }
   void ResetDynamicMemory() override;
 
-  void AssignMemory(const session::KernelGraph *graph);
+  void AssignMemory(const session::KernelGraph *graph, bool mem_reuse);
   void IncreaseAddressRefCount(const session::KernelGraph *graph);
   void DecreaseAddressRefCount(const AnfNodePtr &kernel);
   void *StaticMemMalloc(size_t mem_size);
@@ -63,8 +64,8 @@ class CPUMemoryManager : public MemoryManager {
   void MemFree() noexcept;
   CPUSimpleMemPlan mem_plan_;
 
-  size_t mem_size_{0};
-  uint8_t *mem_ptr_{nullptr};
+  // The memory planned for each graph and its size, keyed by the graph id.
+  std::map<uint32_t, std::pair<uint8_t *, size_t>> graph_mem_;
   bool dynamic_malloc_{false};
   std::map<void *, size_t> dynamic_mem_;
   std::map<void *, size_t> static_mem_;
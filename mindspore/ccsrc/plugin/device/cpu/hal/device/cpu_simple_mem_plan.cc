@@ -14,61 +14,83 @@
  * limitations under the License.
  */
 #include "plugin/device/cpu/hal/device/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
 #include "backend/common/session/anf_runtime_algorithm.h"
 #include "include/common/utils/anfalgo.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
-  MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 32;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto kernel_with_index = common::AnfAlgo::GetPrevNodeOutput(kernel, i);
-      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
-      if (kernel_with_index.first->isa<Parameter>()) {
-        continue;
-      }
-      auto address = AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
-    }
+namespace {
+// The reserved size at the end of the memory plan.
+constexpr size_t kMemPlanReservedSize = 32;
+// The offset of memory block is aligned for the vectorized kernels.
+constexpr size_t kMemPlanAlignSize = 64;
 
-    size_t output_num = common::AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
-    }
+size_t AlignMemPlanSize(size_t size) { return (size + kMemPlanAlignSize - 1) / kMemPlanAlignSize * kMemPlanAlignSize; }
+}  // namespace
 
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
-    }
+size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph, bool mem_reuse) {
+  MS_EXCEPTION_IF_NULL(graph);
+  CollectMemPlanBlocks(graph, mem_reuse);
+  size_t naive_mem_size = 0;
+  for (const auto &block : blocks_) {
+    naive_mem_size += block.size_;
   }
-
+  size_t total_mem_size = GreedyBySizePlan(&blocks_) + kMemPlanReservedSize;
+  MS_LOG(INFO) << "The memory plan of graph " << graph->graph_id() << ": block count " << blocks_.size()
+               << ", planned peak size " << total_mem_size << ", naive sum size "
+               << naive_mem_size + kMemPlanReservedSize;
   return total_mem_size;
 }
 
 void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
+  if (plan_graph_ != graph) {
+    (void)MemPlan(graph, plan_mem_reuse_);
+  }
+  for (const auto &block : blocks_) {
+    MS_EXCEPTION_IF_NULL(block.address_);
+    if (block.address_->ptr_ == nullptr) {
+      block.address_->ptr_ = base_ptr + block.offset_;
+    }
+  }
+}
+
+void CPUSimpleMemPlan::CollectMemPlanBlocks(const session::KernelGraph *graph, bool mem_reuse) {
+  MS_EXCEPTION_IF_NULL(graph);
+  plan_graph_ = graph;
+  plan_mem_reuse_ = mem_reuse;
+  blocks_.clear();
+  std::unordered_map<DeviceAddress *, size_t> block_indexes;
   auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  // Without memory reuse, all the blocks live through the whole graph, so that none of them share memory.
+  auto add_block = [this, mem_reuse, &block_indexes, &kernels](DeviceAddress *address, size_t step) {
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->ptr_ != nullptr) {
+      return;
+    }
+    auto iter = block_indexes.find(address);
+    if (iter == block_indexes.end()) {
+      MemPlanBlock block;
+      block.address_ = address;
+      block.size_ = AlignMemPlanSize(address->size_);
+      block.start_ = mem_reuse ? step : 0;
+      block.end_ = mem_reuse ? step : kernels.size();
+      (void)block_indexes.emplace(address, blocks_.size());
+      blocks_.emplace_back(block);
+      return;
+    }
+    auto &block = blocks_[iter->second];
+    block.start_ = std::min(block.start_, step);
+    block.end_ = std::max(block.end_, step);
+  };
+
+  for (size_t step = 0; step < kernels.size(); ++step) {
+    const auto &kernel = kernels[step];
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
@@ -78,34 +100,81 @@ void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *bas
         continue;
       }
       auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+      add_block(address.get(), step);
     }
 
     size_t output_num = common::AnfAlgo::GetOutputTensorNum(kernel);
     for (size_t i = 0; i < output_num; ++i) {
       auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+      add_block(address.get(), step);
     }
 
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+      add_block(AnfAlgo::GetWorkspaceAddr(kernel, i), step);
+    }
+  }
+
+  // The graph outputs and summary outputs are read after the graph runs, so they live to the end of graph.
+  std::vector<KernelWithIndex> live_outputs = common::AnfAlgo::GetAllOutputWithIndex(graph->output());
+  for (const auto &summary_node : graph->summary_nodes()) {
+    (void)live_outputs.emplace_back(summary_node.second.first, IntToSize(summary_node.second.second));
+  }
+  for (const auto &output : live_outputs) {
+    MS_EXCEPTION_IF_NULL(output.first);
+    if (!AnfAlgo::OutputAddrExist(output.first, output.second, true)) {
+      continue;
+    }
+    auto address = AnfAlgo::GetMutableOutputAddr(output.first, output.second, true);
+    auto iter = block_indexes.find(address.get());
+    if (iter != block_indexes.end()) {
+      blocks_[iter->second].end_ = kernels.size();
+    }
+  }
+}
+
+size_t CPUSimpleMemPlan::GreedyBySizePlan(std::vector<MemPlanBlock> *blocks) {
+  MS_EXCEPTION_IF_NULL(blocks);
+  std::vector<MemPlanBlock *> order;
+  for (auto &block : *blocks) {
+    order.push_back(&block);
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [](const MemPlanBlock *a, const MemPlanBlock *b) { return a->size_ > b->size_; });
+
+  size_t total_size = 0;
+  std::vector<const MemPlanBlock *> placed;
+  std::vector<const MemPlanBlock *> overlapped;
+  for (auto block : order) {
+    // The placed blocks which are alive at the same time, sorted by offset.
+    overlapped.clear();
+    for (auto placed_block : placed) {
+      if (placed_block->start_ <= block->end_ && block->start_ <= placed_block->end_) {
+        overlapped.push_back(placed_block);
+      }
+    }
+    std::sort(overlapped.begin(), overlapped.end(),
+              [](const MemPlanBlock *a, const MemPlanBlock *b) { return a->offset_ < b->offset_; });
+    // Find the smallest gap which fits the block, or put it after all the overlapped blocks.
+    size_t best_offset = 0;
+    size_t best_gap = SIZE_MAX;
+    size_t prev_end = 0;
+    for (auto overlapped_block : overlapped) {
+      if (overlapped_block->offset_ > prev_end) {
+        size_t gap = overlapped_block->offset_ - prev_end;
+        if (gap >= block->size_ && gap < best_gap) {
+          best_gap = gap;
+          best_offset = prev_end;
+        }
       }
+      prev_end = std::max(prev_end, overlapped_block->offset_ + overlapped_block->size_);
     }
+    block->offset_ = (best_gap == SIZE_MAX) ? prev_end : best_offset;
+    total_size = std::max(total_size, block->offset_ + block->size_);
+    placed.push_back(block);
   }
+  return total_size;
 }
 }  // namespace cpu
 }  // namespace device
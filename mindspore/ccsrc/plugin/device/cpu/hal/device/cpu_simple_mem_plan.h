@@ -23,13 +23,36 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+// The memory block of device address in the memory plan, the lifetime is the range of kernel indexes in the execution
+// order which use the device address, and the blocks whose lifetime does not overlap can share the same memory.
+struct MemPlanBlock {
+  DeviceAddress *address_{nullptr};
+  size_t size_{0};
+  size_t start_{0};
+  size_t end_{0};
+  size_t offset_{0};
+};
+
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
   ~CPUSimpleMemPlan() = default;
 
-  size_t MemPlan(const session::KernelGraph *graph);
+  // Plan the memory of the kernel outputs and workspaces, the blocks share memory only if mem_reuse is true.
+  size_t MemPlan(const session::KernelGraph *graph, bool mem_reuse);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+
+  // Place the blocks by the greedy by size algorithm: the larger block is placed first, in the smallest gap between
+  // the placed blocks whose lifetime overlaps with it. Return the arena size required by the blocks.
+  static size_t GreedyBySizePlan(std::vector<MemPlanBlock> *blocks);
+
+ private:
+  // Collect the memory blocks and their lifetime by the execution order of graph.
+  void CollectMemPlanBlocks(const session::KernelGraph *graph, bool mem_reuse);
+
+  const session::KernelGraph *plan_graph_{nullptr};
+  bool plan_mem_reuse_{false};
+  std::vector<MemPlanBlock> blocks_;
 };
 }  // namespace cpu
 }  // namespace device
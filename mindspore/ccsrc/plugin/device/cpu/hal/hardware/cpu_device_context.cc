@@ -57,6 +57,14 @@ void CPUDeviceContext::Initialize() {
 
   mem_manager_ = std::make_shared<CPUMemoryManager>();
   MS_EXCEPTION_IF_NULL(mem_manager_);
+  // The small tensors are allocated from the size class free lists of memory pool when it is enabled.
+  static const bool enable_size_class = (common::GetEnv("MS_DEV_MEMPOOL_SIZE_CLASS") == "1");
+  CPUMemoryPool::GetInstance().SetEnableSizeClass(enable_size_class);
+  // Record the memory alloc and free to the trace file for the offline analysis.
+  auto trace_file = common::GetEnv("MS_DEV_MEMPOOL_TRACE_FILE");
+  if (!trace_file.empty()) {
+    (void)CPUMemoryPool::GetInstance().StartAllocTrace(trace_file);
+  }
 
 #ifndef ENABLE_SECURITY
   // Dump json config file if dump is enabled.
@@ -73,6 +81,7 @@ void CPUDeviceContext::Initialize() {
 void CPUDeviceContext::Destroy() {
   // Release memory.
   if (mem_manager_ != nullptr) {
+    CPUMemoryPool::GetInstance().StopAllocTrace();
     mem_manager_->Finalize();
     mem_manager_ = nullptr;
   }
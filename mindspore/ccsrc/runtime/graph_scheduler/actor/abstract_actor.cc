@@ -118,13 +118,21 @@ void AbstractActor::SendOutput(OpContext<DeviceTensor> *const context) {
     UpdateOutputData(output_data.get(), output_data_arrows_[output_data_arrow_index],
                      output_data_nodes_[output_data_arrow_index], context);
     if (output_data->op_id_.Name().find(kStackActorNameSuffix) != std::string::npos) {
-      // Create a new op data for stack actor.
-      auto to_stack_data =
-        std::make_unique<OpData<DeviceTensor>>(output_data->op_id_, output_data->data_, output_data->index_);
-      (void)to_stack_data_.emplace_back(std::move(to_stack_data));
-      ActorDispatcher::Send(output_data->op_id_, &OpActor::RunOpData, to_stack_data_.back().get(), context);
+      // Reuse the op data for stack actor which is created in the previous steps, and create a new one if not enough.
+      if (to_stack_data_num_ < to_stack_data_.size()) {
+        auto &to_stack_data = to_stack_data_[to_stack_data_num_];
+        MS_EXCEPTION_IF_NULL(to_stack_data);
+        to_stack_data->op_id_ = output_data->op_id_;
+        to_stack_data->data_ = output_data->data_;
+        to_stack_data->index_ = output_data->index_;
+      } else {
+        auto to_stack_data =
+          std::make_unique<OpData<DeviceTensor>>(output_data->op_id_, output_data->data_, output_data->index_);
+        (void)to_stack_data_.emplace_back(std::move(to_stack_data));
+      }
+      ActorDispatcher::SendOpData(output_data->op_id_, to_stack_data_[to_stack_data_num_++].get(), context);
     } else {
-      ActorDispatcher::Send(output_data->op_id_, &OpActor::RunOpData, output_data.get(), context);
+      ActorDispatcher::SendOpData(output_data->op_id_, output_data.get(), context);
     }
     ++output_data_arrow_index;
   }
@@ -133,7 +141,7 @@ void AbstractActor::SendOutput(OpContext<DeviceTensor> *const context) {
   if (output_control_arrows_.size() > 0) {
     auto from_aid = const_cast<AID *>(&GetAID());
     for (auto &output_control : output_control_arrows_) {
-      ActorDispatcher::Send(output_control, &OpActor::RunOpControl, from_aid, context);
+      ActorDispatcher::SendOpControl(output_control, from_aid, context);
     }
   }
 
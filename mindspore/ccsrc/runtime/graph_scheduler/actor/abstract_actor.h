@@ -101,8 +101,10 @@ class AbstractActor : public OpActor<DeviceTensor> {
   // When there is recursion in the graph, the actor will send data to the same stack actor multiple times. Since
   // messages are sent asynchronously between actors, there will be multiple messages that remain unprocessed in
   // the channel. In order to prevent old data from being overwritten, it is necessary to allocate a new op data,
-  // and these op data will be uniformly cleared by the scheduler after the step ends.
+  // and these op data will be uniformly recycled by the scheduler after the step ends and reused in the next step.
   std::vector<OpDataUniquePtr<DeviceTensor>> to_stack_data_;
+  // The number of op data in to_stack_data_ which are used in the current step.
+  size_t to_stack_data_num_{0};
 
   // The dependent device tensor stores, the dependent expression is pair<index, AnfNode>.
   // Index is the input position, AnfNode is the key of the device tensor store.
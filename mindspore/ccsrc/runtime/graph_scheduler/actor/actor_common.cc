@@ -15,6 +15,8 @@
  */
 
 #include "runtime/graph_scheduler/actor/actor_common.h"
+#include <memory>
+#include "runtime/graph_scheduler/actor/op_message.h"
 #include "runtime/graph_scheduler/device_tensor_store.h"
 #include "utils/ms_context.h"
 #include "include/common/utils/anfalgo.h"
@@ -23,6 +25,31 @@ namespace mindspore {
 namespace runtime {
 bool ActorDispatcher::is_multi_thread_execution_ = true;
 
+void ActorDispatcher::SendOpData(const AID &aid, OpData<DeviceTensor> *const input_data,
+                                 OpContext<DeviceTensor> *const context) {
+  if (!is_multi_thread_execution_) {
+    Send(aid, &OpActor<DeviceTensor>::RunOpData, input_data, context);
+    return;
+  }
+  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) OpMessage(input_data, nullptr, context));
+  MS_EXCEPTION_IF_NULL(msg);
+  auto actor_manager = ActorMgr::GetActorMgrRef();
+  MS_EXCEPTION_IF_NULL(actor_manager);
+  (void)actor_manager->Send(aid, std::move(msg));
+}
+
+void ActorDispatcher::SendOpControl(const AID &aid, AID *const input_control, OpContext<DeviceTensor> *const context) {
+  if (!is_multi_thread_execution_) {
+    Send(aid, &OpActor<DeviceTensor>::RunOpControl, input_control, context);
+    return;
+  }
+  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) OpMessage(nullptr, input_control, context));
+  MS_EXCEPTION_IF_NULL(msg);
+  auto actor_manager = ActorMgr::GetActorMgrRef();
+  MS_EXCEPTION_IF_NULL(actor_manager);
+  (void)actor_manager->Send(aid, std::move(msg));
+}
+
 void ComputeThreadNums(size_t *actor_thread_num, size_t *actor_and_kernel_thread_num) {
   MS_EXCEPTION_IF_NULL(actor_thread_num);
   MS_EXCEPTION_IF_NULL(actor_and_kernel_thread_num);
@@ -170,6 +170,11 @@ class ActorDispatcher {
     }
   }
 
+  // Send the op data and op control by the recycled op message, which is the most frequent message between actors.
+  static void SendOpData(const AID &aid, OpData<DeviceTensor> *const input_data,
+                         OpContext<DeviceTensor> *const context);
+  static void SendOpControl(const AID &aid, AID *const input_control, OpContext<DeviceTensor> *const context);
+
   static void is_multi_thread_execution(bool is_multi_thread_execution) {
     is_multi_thread_execution_ = is_multi_thread_execution;
   }
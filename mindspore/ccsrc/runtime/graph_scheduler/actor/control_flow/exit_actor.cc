@@ -78,7 +78,7 @@ void ExitActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
   if (branch_data_iter != output_branch_data_.end()) {
     for (const auto &output_data : branch_data_iter->second) {
       MS_EXCEPTION_IF_NULL(output_data.second);
-      ActorDispatcher::Send(output_data.second->op_id_, &OpActor::RunOpData, output_data.second.get(), context);
+      ActorDispatcher::SendOpData(output_data.second->op_id_, output_data.second.get(), context);
     }
   }
 
@@ -87,7 +87,7 @@ void ExitActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
   if (control_iter != output_branch_control_arrows_.end()) {
     auto source_aid = const_cast<AID *>(&GetAID());
     for (const auto &control_arrow : control_iter->second) {
-      ActorDispatcher::Send(control_arrow, &OpActor::RunOpControl, source_aid, context);
+      ActorDispatcher::SendOpControl(control_arrow, source_aid, context);
     }
   }
 
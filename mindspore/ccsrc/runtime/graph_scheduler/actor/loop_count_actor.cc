@@ -94,7 +94,7 @@ void LoopCountActor::SendOutput(OpContext<DeviceTensor> *const context) {
   // Send output control.
   auto from_aid = const_cast<AID *>(&GetAID());
   for (auto &output_control : output_control_arrows_) {
-    ActorDispatcher::Send(output_control, &OpActor::RunOpControl, from_aid, context);
+    ActorDispatcher::SendOpControl(output_control, from_aid, context);
   }
 
   // Send to EntranceActor to clear the data which are generated in the loop body execution.
@@ -109,7 +109,7 @@ void LoopCountActor::SendOutput(OpContext<DeviceTensor> *const context) {
   }
 
   // Send to DataPrepareActor to trigger next step running.
-  ActorDispatcher::Send(data_prepare_aid_, &OpActor::RunOpControl, from_aid, context);
+  ActorDispatcher::SendOpControl(data_prepare_aid_, from_aid, context);
 }
 }  // namespace runtime
 }  // namespace mindspore
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/actor/op_message.h"
+#include <atomic>
+#include <vector>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// The message is allocated by the sender thread and released by the receiver thread. A thread which mostly receives
+// fills its list up to the cap and then releases to the global heap, and a thread which mostly sends drains its list
+// and then allocates from the global heap, so the memory held by a list is bounded whatever the traffic is.
+constexpr size_t kMaxCachedOpMessageNum = 4096;
+
+// Set when the free list of the thread is destroyed. It is trivially destructible, so it can still be read by the
+// messages released later in the teardown of the thread or the process, which then go to the global heap.
+thread_local bool op_message_free_list_destroyed = false;
+
+class OpMessageFreeList {
+ public:
+  OpMessageFreeList() { free_list_.reserve(kMaxCachedOpMessageNum); }
+  ~OpMessageFreeList() {
+    op_message_free_list_destroyed = true;
+    for (auto ptr : free_list_) {
+      ::operator delete(ptr);
+    }
+    free_list_.clear();
+  }
+
+  void *Pop() {
+    if (free_list_.empty()) {
+      return nullptr;
+    }
+    auto ptr = free_list_.back();
+    free_list_.pop_back();
+    return ptr;
+  }
+
+  bool Push(void *ptr) {
+    if (free_list_.size() >= kMaxCachedOpMessageNum) {
+      return false;
+    }
+    free_list_.push_back(ptr);
+    return true;
+  }
+
+ private:
+  std::vector<void *> free_list_;
+};
+
+thread_local OpMessageFreeList op_message_free_list;
+std::atomic<size_t> op_message_heap_alloc_count{0};
+}  // namespace
+
+void OpMessage::Run(ActorBase *actor) {
+  auto op_actor = static_cast<OpActor<DeviceTensor> *>(actor);
+  MS_EXCEPTION_IF_NULL(op_actor);
+  if (input_data_ != nullptr) {
+    op_actor->RunOpData(input_data_, context_);
+  } else {
+    op_actor->RunOpControl(input_control_, context_);
+  }
+}
+
+void *OpMessage::operator new(size_t size) {
+  auto ptr = (size == sizeof(OpMessage) && !op_message_free_list_destroyed) ? op_message_free_list.Pop() : nullptr;
+  if (ptr == nullptr) {
+    (void)op_message_heap_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    ptr = ::operator new(size);
+  }
+  return ptr;
+}
+
+void *OpMessage::operator new(size_t size, const std::nothrow_t &) noexcept {
+  auto ptr = (size == sizeof(OpMessage) && !op_message_free_list_destroyed) ? op_message_free_list.Pop() : nullptr;
+  if (ptr == nullptr) {
+    (void)op_message_heap_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    ptr = ::operator new(size, std::nothrow);
+  }
+  return ptr;
+}
+
+void OpMessage::operator delete(void *ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  if (op_message_free_list_destroyed || !op_message_free_list.Push(ptr)) {
+    ::operator delete(ptr);
+  }
+}
+
+size_t OpMessage::heap_alloc_count() { return op_message_heap_alloc_count.load(std::memory_order_relaxed); }
+}  // namespace runtime
+}  // namespace mindspore
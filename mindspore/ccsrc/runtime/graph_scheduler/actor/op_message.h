@@ -0,0 +1,54 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_OP_MESSAGE_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_OP_MESSAGE_H_
+
+#include <new>
+#include "mindrt/include/actor/op_actor.h"
+#include "runtime/graph_scheduler/actor/actor_common.h"
+
+namespace mindspore {
+namespace runtime {
+// The message which carries the op data or the op control to the downstream actor. It replaces the general async
+// message whose handler is a heap allocated std::function, and the memory of messages is recycled by the thread local
+// free lists, so that sending the op data and op control doesn't allocate the heap memory in the steady state of graph
+// execution.
+class OpMessage final : public MessageBase {
+ public:
+  OpMessage(OpData<DeviceTensor> *const input_data, AID *const input_control, OpContext<DeviceTensor> *const context)
+      : MessageBase(Type::KASYNC), input_data_(input_data), input_control_(input_control), context_(context) {}
+  ~OpMessage() override = default;
+
+  void Run(ActorBase *actor) override;
+
+  static void *operator new(size_t size);
+  static void *operator new(size_t size, const std::nothrow_t &) noexcept;
+  static void operator delete(void *ptr) noexcept;
+
+  // The number of messages allocated from the heap since the process started, the increment in one step is the number
+  // of allocations which are not served by the free lists.
+  static size_t heap_alloc_count();
+
+ private:
+  OpData<DeviceTensor> *input_data_;
+  AID *input_control_;
+  OpContext<DeviceTensor> *context_;
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_OP_MESSAGE_H_
@@ -150,7 +150,7 @@ void OutputActor::RunOpControl(AID *const, OpContext<DeviceTensor> *const contex
   // Send control arrow to trigger next step running.
   auto from_aid = const_cast<AID *>(&GetAID());
   for (auto &output_control : output_control_arrows_) {
-    ActorDispatcher::Send(output_control, &OpActor::RunOpControl, from_aid, context);
+    ActorDispatcher::SendOpControl(output_control, from_aid, context);
   }
 }
 
@@ -19,6 +19,7 @@
 #include "runtime/graph_scheduler/actor/memory_manager_actor.h"
 #include "runtime/graph_scheduler/actor/debug_actor.h"
 #include "runtime/graph_scheduler/actor/recorder_actor.h"
+#include "runtime/graph_scheduler/actor/op_message.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "mindrt/src/actor/actormgr.h"
 #include "mindrt/include/async/async.h"
@@ -386,11 +387,11 @@ void GraphScheduler::ClearActorData(const ActorSet *actor_set) {
 
   control_node_scheduler_.ClearActorData(actor_set->control_actors_.get());
 
-  // At the end of the step, the op data sent to the stack actor in each actor should be clear.
+  // At the end of the step, the op data sent to the stack actor in each actor should be recycled.
   auto total_actors = CollectActors(actor_set);
   for (auto &actor : total_actors) {
     MS_EXCEPTION_IF_NULL(actor);
-    actor->to_stack_data_.clear();
+    actor->to_stack_data_num_ = 0;
   }
 }
 
@@ -590,6 +591,7 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<DeviceCont
   MS_EXCEPTION_IF_NULL(thread_pool);
   ActorDispatcher::is_multi_thread_execution(actor_set->is_multi_thread_execution_);
   double start_time = GetTime();
+  auto op_message_heap_alloc_count = OpMessage::heap_alloc_count();
   ActorDispatcher::Send(actor_set->data_prepare_actor_->GetAID(), &DataPrepareActor::PrepareData, input_tensors,
                         &op_context, GraphExecutionStrategy::kPipeline);
 
@@ -615,6 +617,9 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<DeviceCont
   }
 
   double end_time = GetTime();
+  // The op messages are recycled, and the heap allocations should be close to zero in the steady state.
+  MS_LOG(DEBUG) << "Actor set: " << actor_set->name_ << ", the heap allocation count of op messages in this step: "
+                << (OpMessage::heap_alloc_count() - op_message_heap_alloc_count);
   const size_t kSecondsToMilliseconds = 1000;
   SetActorExecutionStrategy(actor_set, strategy, (end_time - start_time) * kSecondsToMilliseconds);
 
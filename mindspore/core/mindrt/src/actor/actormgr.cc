@@ -246,7 +246,7 @@ AID ActorMgr::Spawn(const ActorReference &actor, bool shareThread) {
   MS_LOG(DEBUG) << "ACTOR was spawned,a=" << actor->GetAID().Name().c_str();
 
   if (shareThread) {
-    auto mailbox = std::make_unique<NonblockingMailBox>();
+    auto mailbox = std::make_unique<MPSCMailBox>();
     auto hook = std::unique_ptr<std::function<void()>>(
       new std::function<void()>([actor]() { ActorMgr::GetActorMgrRef()->SetActorReady(actor); }));
     // the mailbox has this hook, the hook holds the actor reference, the actor has the mailbox. this is a cycle which
@@ -15,6 +15,9 @@
  */
 #include "actor/mailbox.h"
 
+#include <algorithm>
+#include <thread>
+
 namespace mindspore {
 int BlockingMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
   {
@@ -85,4 +88,51 @@ std::unique_ptr<MessageBase> HQueMailBox::GetMsg() {
   std::unique_ptr<MessageBase> msg(mailbox.Dequeue());
   return msg;
 }
+
+MPSCMailBox::~MPSCMailBox() {
+  MessageBase *msg = nullptr;
+  while ((msg = mailbox_.Dequeue()) != nullptr) {
+    delete msg;
+  }
+}
+
+int MPSCMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
+  mailbox_.Enqueue(msg.release());
+  // only the producer which makes the mailbox non-empty notifies, the consumer is responsible for the rest messages
+  if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0 && notifyHook) {
+    (*notifyHook.get())();
+  }
+  return 0;
+}
+
+std::unique_ptr<MessageBase> MPSCMailBox::GetMsg() {
+  if (batch_left_ == 0) {
+    // acknowledge the taken messages, the messages enqueued meanwhile form the next batch
+    size_t left = pending_.fetch_sub(taken_, std::memory_order_acq_rel) - taken_;
+    taken_ = 0;
+    if (left == 0) {
+      // released, the next enqueued message will notify again
+      turn_taken_ = 0;
+      return nullptr;
+    }
+    if (max_batch_size_ != 0 && turn_taken_ >= max_batch_size_) {
+      // yield the thread, the pending messages are taken in the next turn
+      turn_taken_ = 0;
+      if (notifyHook) {
+        (*notifyHook.get())();
+      }
+      return nullptr;
+    }
+    batch_left_ = max_batch_size_ == 0 ? left : std::min(left, max_batch_size_ - turn_taken_);
+  }
+  MessageBase *msg = nullptr;
+  // the counted messages are all enqueued, dequeue fails only while another producer is linking its message
+  while ((msg = mailbox_.Dequeue()) == nullptr) {
+    std::this_thread::yield();
+  }
+  --batch_left_;
+  ++taken_;
+  ++turn_taken_;
+  return std::unique_ptr<MessageBase>(msg);
+}
 }  // namespace mindspore
@@ -24,6 +24,7 @@
 #include <utility>
 #include "actor/msg.h"
 #include "thread/hqueue.h"
+#include "thread/mpsc_queue.h"
 
 namespace mindspore {
 class MailBox {
@@ -94,6 +95,33 @@ class HQueMailBox : public MailBox {
   HQueue<MessageBase> mailbox;
   static const int32_t MAX_MSG_QUE_SIZE = 4096;
 };
+
+// unbounded lock-free mailbox, the messages are linked intrusively so that no memory is allocated when enqueueing.
+// the consumer acknowledges the handled messages in batches: the notify hook is invoked only when the first message
+// arrives at a released mailbox, and the mailbox is released only when all the enqueued messages are handled.
+class MPSCMailBox : public MailBox {
+ public:
+  // max_batch_size limits the messages handled in one turn before the actor yields its thread by invoking the notify
+  // hook again, 0 means no limit.
+  explicit MPSCMailBox(size_t max_batch_size = 0) : max_batch_size_(max_batch_size) { takeAllMsgsEachTime = false; }
+  ~MPSCMailBox() override;
+  int EnqueueMessage(std::unique_ptr<MessageBase> msg) override;
+  std::list<std::unique_ptr<MessageBase>> *GetMsgs() override { return nullptr; }
+  std::unique_ptr<MessageBase> GetMsg() override;
+
+ private:
+  MPSCQueue<MessageBase> mailbox_;
+  // the number of the enqueued messages which are not acknowledged by the consumer
+  std::atomic<size_t> pending_{0};
+  // the following members are only accessed by the consumer
+  size_t max_batch_size_{0};
+  // the messages in the current batch which are not taken yet
+  size_t batch_left_{0};
+  // the messages taken but not acknowledged
+  size_t taken_{0};
+  // the messages taken in the current turn
+  size_t turn_taken_{0};
+};
 }  // namespace mindspore
 
 #endif  // MINDSPORE_MAILBOX_H
@@ -22,10 +22,27 @@
 
 namespace mindspore {
 constexpr size_t MAX_READY_ACTOR_NR = 8192;
+constexpr size_t MAX_LOCAL_READY_ACTOR_NR = 1024;
+namespace {
+// the actor worker which runs on the current thread, nullptr for the threads outside the actor thread pool
+thread_local ActorWorker *current_actor_worker = nullptr;
+}  // namespace
+
 void ActorWorker::CreateThread() { thread_ = std::thread(&ActorWorker::RunWithSpin, this); }
 
+int ActorWorker::InitLocalQueue(size_t worker_index, size_t queue_size) {
+  if (!local_actors_.Init(static_cast<int64_t>(queue_size))) {
+    THREAD_ERROR("init local actor queue failed.");
+    return THREAD_ERROR;
+  }
+  worker_index_ = worker_index;
+  steal_seed_ = static_cast<uint32_t>(worker_index) + 1;
+  return THREAD_OK;
+}
+
 void ActorWorker::RunWithSpin() {
   SetAffinity();
+  current_actor_worker = this;
 #if !defined(__APPLE__) && !defined(SUPPORT_MSVC)
   static std::atomic_int index = {0};
   (void)pthread_setname_np(pthread_self(), ("ActorThread_" + std::to_string(index++)).c_str());
@@ -62,7 +79,15 @@ bool ActorWorker::RunQueueActorTask() {
   if (pool_ == nullptr) {
     return false;
   }
-  auto actor = reinterpret_cast<ActorThreadPool *>(pool_)->PopActorFromQueue();
+  auto pool = reinterpret_cast<ActorThreadPool *>(pool_);
+  // the actors scheduled by this worker are still hot in cache, so run them first
+  auto actor = local_actors_.Pop();
+  if (actor == nullptr) {
+    actor = pool->PopActorFromQueue();
+  }
+  if (actor == nullptr && pool->work_stealing()) {
+    actor = StealActorFromOthers();
+  }
   if (actor == nullptr) {
     return false;
   }
@@ -78,6 +103,33 @@ bool ActorWorker::RunQueueActorTask() {
   return true;
 }
 
+ActorBase *ActorWorker::StealActorFromOthers() {
+  auto pool = reinterpret_cast<ActorThreadPool *>(pool_);
+  if (!pool->actor_workers_ready_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  size_t worker_num = pool->actor_workers_.size();
+  if (worker_num <= 1) {
+    return nullptr;
+  }
+  // xorshift, pick a random victim to start with to spread the thieves
+  steal_seed_ ^= steal_seed_ << 13;
+  steal_seed_ ^= steal_seed_ >> 17;
+  steal_seed_ ^= steal_seed_ << 5;
+  size_t start = steal_seed_ % worker_num;
+  for (size_t i = 0; i < worker_num; ++i) {
+    size_t victim = (start + i) % worker_num;
+    if (victim == worker_index_) {
+      continue;
+    }
+    auto actor = pool->actor_workers_[victim]->StealActor();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
 bool ActorWorker::ActorActive() {
   if (status_ != kThreadIdle) {
     return false;
@@ -96,14 +148,7 @@ ActorThreadPool::~ActorThreadPool() {
   bool terminate = false;
   int count = 0;
   do {
-    {
-#ifdef USE_HQUEUE
-      terminate = actor_queue_.Empty();
-#else
-      std::lock_guard<std::mutex> _l(actor_mutex_);
-      terminate = actor_queue_.empty();
-#endif
-    }
+    terminate = ActorQueueEmpty();
     if (!terminate) {
       for (auto &worker : workers_) {
         worker->Active();
@@ -111,6 +156,11 @@ ActorThreadPool::~ActorThreadPool() {
       std::this_thread::yield();
     }
   } while (!terminate && count++ < kMaxCount);
+  // all the actor threads must exit before any worker is released, since the thieves visit the other local deques
+  for (auto worker : actor_workers_) {
+    worker->StopThread();
+  }
+  actor_workers_.clear();
   for (auto &worker : workers_) {
     delete worker;
     worker = nullptr;
@@ -121,6 +171,20 @@ ActorThreadPool::~ActorThreadPool() {
 #endif
 }
 
+bool ActorThreadPool::ActorQueueEmpty() {
+  for (auto worker : actor_workers_) {
+    if (!worker->LocalQueueEmpty()) {
+      return false;
+    }
+  }
+#ifdef USE_HQUEUE
+  return actor_queue_.Empty();
+#else
+  std::lock_guard<std::mutex> _l(actor_mutex_);
+  return actor_queue_.empty();
+#endif
+}
+
 ActorBase *ActorThreadPool::PopActorFromQueue() {
 #ifdef USE_HQUEUE
   return actor_queue_.Dequeue();
@@ -139,7 +203,11 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
-  {
+  // the actor scheduled by an actor thread of this pool stays on that thread unless it is stolen
+  auto current = current_actor_worker;
+  if (work_stealing_ && current != nullptr && current->BelongTo(this) && current->PushLocalActor(actor)) {
+    THREAD_DEBUG("actor[%s] enqueue local success", actor->GetAID().Name().c_str());
+  } else {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
     }
@@ -147,8 +215,12 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
     std::lock_guard<std::mutex> _l(actor_mutex_);
     actor_queue_.push(actor);
 #endif
+    THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
   }
-  THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
+  ActiveIdleActorWorker();
+}
+
+void ActorThreadPool::ActiveIdleActorWorker() {
   // active one idle actor thread if exist
   for (size_t i = 0; i < actor_thread_num_; ++i) {
     auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
@@ -197,11 +269,17 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
     }
     worker->SetTaskMessages(task_messages);
 #endif
+    if (worker->InitLocalQueue(i, MAX_LOCAL_READY_ACTOR_NR) != THREAD_OK) {
+      delete worker;
+      return THREAD_ERROR;
+    }
     worker->InitWorkerMask(core_list, workers_.size());
     worker->CreateThread();
     workers_.push_back(worker);
+    actor_workers_.push_back(worker);
     THREAD_INFO("create actor thread[%zu]", i);
   }
+  actor_workers_ready_.store(true, std::memory_order_release);
   size_t kernel_thread_num = all_thread_num - actor_thread_num_;
   if (kernel_thread_num > 0) {
     return ThreadPool::CreateThreads(kernel_thread_num, core_list);
@@ -26,6 +26,7 @@
 #include "thread/core_affinity.h"
 #include "actor/actor.h"
 #include "thread/hqueue.h"
+#include "thread/work_stealing_deque.h"
 #ifndef USE_HQUEUE
 #define USE_HQUEUE
 #endif
@@ -38,9 +39,22 @@ class ActorWorker : public Worker {
   bool ActorActive();
   ~ActorWorker() override{};
 
+  int InitLocalQueue(size_t worker_index, size_t queue_size);
+  // called by the worker thread itself only
+  bool PushLocalActor(ActorBase *actor) { return local_actors_.Push(actor); }
+  // called by any other actor thread
+  ActorBase *StealActor() { return local_actors_.Steal(); }
+  bool LocalQueueEmpty() const { return local_actors_.Empty(); }
+  bool BelongTo(const ThreadPool *pool) const { return pool_ == pool; }
+
  private:
   void RunWithSpin();
   bool RunQueueActorTask();
+  ActorBase *StealActorFromOthers();
+
+  size_t worker_index_{0};
+  uint32_t steal_seed_{1};
+  WorkStealingDeque<ActorBase> local_actors_;
 };
 
 class ActorThreadPool : public ThreadPool {
@@ -57,12 +71,23 @@ class ActorThreadPool : public ThreadPool {
   void PushActorToQueue(ActorBase *actor);
   ActorBase *PopActorFromQueue();
 
+  // actors scheduled by an actor thread are pushed to the local deque of that thread and other idle actor threads
+  // steal from it, otherwise all the actors go through the shared queue.
+  void SetWorkStealing(bool work_stealing) { work_stealing_ = work_stealing; }
+  bool work_stealing() const { return work_stealing_; }
+
  private:
+  friend class ActorWorker;
   ActorThreadPool() {}
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
+  bool ActorQueueEmpty();
+  void ActiveIdleActorWorker();
 
   std::mutex actor_mutex_;
   std::condition_variable actor_cond_;
+  bool work_stealing_{true};
+  std::vector<ActorWorker *> actor_workers_;
+  std::atomic_bool actor_workers_ready_{false};
 #ifdef USE_HQUEUE
   HQueue<ActorBase> actor_queue_;
 #else
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_RUNTIME_MPSC_QUEUE_H_
+#define MINDSPORE_CORE_MINDRT_RUNTIME_MPSC_QUEUE_H_
+#include <atomic>
+
+namespace mindspore {
+// implement an unbounded intrusive multi-producer single-consumer queue, the element links itself through its
+// `std::atomic<T *> next` member, so no memory is allocated by the queue.
+// refer to https://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+template <typename T>
+class MPSCQueue {
+ public:
+  MPSCQueue(const MPSCQueue &) = delete;
+  MPSCQueue &operator=(const MPSCQueue &) = delete;
+  MPSCQueue() : head_(&stub_), tail_(&stub_) {}
+  virtual ~MPSCQueue() {}
+
+  // can be called by multiple producers, wait-free
+  void Enqueue(T *t) {
+    t->next.store(nullptr, std::memory_order_relaxed);
+    T *prev = head_.exchange(t, std::memory_order_acq_rel);
+    prev->next.store(t, std::memory_order_release);
+  }
+
+  // can only be called by the consumer. nullptr is returned when the queue is empty, or when the last producer has not
+  // finished linking its element yet, in which case the caller can retry soon.
+  T *Dequeue() {
+    T *tail = tail_;
+    T *next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == nullptr) {
+        return nullptr;
+      }
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    // tail is the last element, push the stub back so that tail can be unlinked
+    Enqueue(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+  // can only be called by the consumer
+  bool Empty() const {
+    return tail_ == &stub_ && stub_.next.load(std::memory_order_acquire) == nullptr &&
+           head_.load(std::memory_order_acquire) == &stub_;
+  }
+
+ private:
+  alignas(64) std::atomic<T *> head_;
+  alignas(64) T *tail_;
+  T stub_;
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_RUNTIME_MPSC_QUEUE_H_
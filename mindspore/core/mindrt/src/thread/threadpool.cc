@@ -22,14 +22,7 @@
 
 namespace mindspore {
 Worker::~Worker() {
-  {
-    std::lock_guard<std::mutex> _l(mutex_);
-    alive_ = false;
-  }
-  cond_var_.notify_one();
-  if (thread_.joinable()) {
-    thread_.join();
-  }
+  StopThread();
   pool_ = nullptr;
 #ifdef OPERATOR_PARALLELISM
   if (task_messages_ != nullptr) {
@@ -41,6 +34,17 @@ Worker::~Worker() {
 
 void Worker::CreateThread() { thread_ = std::thread(&Worker::Run, this); }
 
+void Worker::StopThread() {
+  {
+    std::lock_guard<std::mutex> _l(mutex_);
+    alive_ = false;
+  }
+  cond_var_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
 void Worker::SetAffinity() {
 #ifdef _WIN32
   SetWindowsSelfAffinity(core_id_);
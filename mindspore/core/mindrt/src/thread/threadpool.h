@@ -83,6 +83,8 @@ class Worker {
   virtual ~Worker();
   // create thread and start running at the same time
   virtual void CreateThread();
+  // wake up and join the thread, it is safe to call more than once
+  void StopThread();
   // assign task and then activate thread
   void Active(Task *task, int task_id);
   // activate thread
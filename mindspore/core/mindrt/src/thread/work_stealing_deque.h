@@ -0,0 +1,122 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_DEQUE_H_
+#define MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_DEQUE_H_
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace mindspore {
+// implement a bounded Chase-Lev work-stealing deque
+// refer to https://www.di.ens.fr/~zappa/readings/ppopp13.pdf
+// Push and Pop can only be called by the owner thread, Steal can be called by any thread.
+template <typename T>
+class WorkStealingDeque {
+ public:
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+  WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+  WorkStealingDeque() {}
+  virtual ~WorkStealingDeque() {}
+
+  bool IsInit() const { return buffer_ != nullptr; }
+
+  // the capacity is rounded up to the power of two
+  bool Init(int64_t sz) {
+    if (IsInit() || sz <= 0) {
+      return false;
+    }
+    int64_t capacity = 1;
+    while (capacity < sz) {
+      capacity <<= 1;
+    }
+    buffer_.reset(new (std::nothrow) std::atomic<T *>[capacity]);
+    if (buffer_ == nullptr) {
+      return false;
+    }
+    for (int64_t i = 0; i < capacity; ++i) {
+      buffer_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    mask_ = capacity - 1;
+    return true;
+  }
+
+  // push to the bottom, return false when the deque is full
+  bool Push(T *t) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top > mask_) {
+      return false;
+    }
+    buffer_[bottom & mask_].store(t, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // pop from the bottom, the most recently pushed element is returned first
+  T *Pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      // empty
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T *ret = buffer_[bottom & mask_].load(std::memory_order_relaxed);
+    if (top == bottom) {
+      // the last element, race with the thieves
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        ret = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return ret;
+  }
+
+  // steal from the top, the oldest element is returned first
+  T *Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    T *ret = buffer_[top & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return ret;
+  }
+
+  bool Empty() const {
+    int64_t top = top_.load(std::memory_order_acquire);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    return top >= bottom;
+  }
+
+ private:
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  std::unique_ptr<std::atomic<T *>[]> buffer_;
+  int64_t mask_{0};
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_DEQUE_H_
@@ -65,6 +65,14 @@ static const char *const kMSCacheModelPath = "cache_model_path";
 static const char *const kMSCacheVocabSize = "vocab_size";
 static const char *const kMSCacheDeviceSize = "device_cache_size";
 static const char *const kMSCacheSerializePath = "serialize_path";
+// shared weight cache
+static const char *const kSharedWeightCacheSection = "shared_weight_cache";
+static const char *const kSharedWeightCacheEnable = "enable";
+static const char *const kSharedWeightCacheDir = "cache_dir";
+static const char *const kSharedWeightCachePackedFile = "packed_weight_file";
+// model file
+static const char *const kModelFileSection = "model_file";
+static const char *const kModelFileMmap = "mmap";
 }  // namespace lite
 }  // namespace mindspore
 
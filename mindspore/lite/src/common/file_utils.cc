@@ -23,6 +23,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <dirent.h>
+#include <sys/mman.h>
 #endif
 
 #include <cstdlib>
@@ -187,6 +188,53 @@ char *ReadFile(const char *file, size_t *size) {
   return buf.release();
 }
 
+char *MapFile(const char *file, size_t *size) {
+  if (file == nullptr) {
+    MS_LOG(ERROR) << "File path is nullptr";
+    return nullptr;
+  }
+  MS_ASSERT(size != nullptr);
+#ifdef _WIN32
+  MS_LOG(WARNING) << "Map file is not supported on windows.";
+  return nullptr;
+#else
+  std::string real_path = RealPath(file);
+  if (real_path.empty()) {
+    MS_LOG(DEBUG) << "File path not regular: " << file;
+    return nullptr;
+  }
+  auto fd = open(real_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open file " << real_path << " failed.";
+    return nullptr;
+  }
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "Get the size of file " << real_path << " failed.";
+    close(fd);
+    return nullptr;
+  }
+  auto file_size = static_cast<size_t>(file_stat.st_size);
+  // The pages are shared with the page cache until they are written, and the written pages are private.
+  auto buf = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (buf == MAP_FAILED) {
+    MS_LOG(ERROR) << "Map file " << real_path << " failed.";
+    return nullptr;
+  }
+  *size = file_size;
+  return static_cast<char *>(buf);
+#endif
+}
+
+void UnmapFile(void *buf, size_t size) {
+#ifndef _WIN32
+  if (buf != nullptr && munmap(buf, size) != 0) {
+    MS_LOG(ERROR) << "Unmap file buffer failed.";
+  }
+#endif
+}
+
 std::string RealPath(const char *path) {
   if (path == nullptr) {
     MS_LOG(ERROR) << "path is nullptr";
@@ -43,6 +43,11 @@ char *ReadFileSegment(const std::string &file, int64_t offset, int64_t len);
 
 char *ReadFile(const char *file, size_t *size);
 
+// Map the whole file into memory with copy-on-write, the buffer must be released by UnmapFile.
+char *MapFile(const char *file, size_t *size);
+
+void UnmapFile(void *buf, size_t size);
+
 std::string RealPath(const char *path);
 
 int CreateOutputDir(std::string *dir);
@@ -28,6 +28,7 @@
 #include "src/common/graph_util.h"
 #include "src/common/file_utils.h"
 #include "src/tensor.h"
+#include "src/pack_weight_manager.h"
 
 namespace mindspore::lite {
 namespace {
@@ -36,7 +37,12 @@ constexpr size_t kMaxModelBufferSize = static_cast<size_t>(1024) * 1024 * 1024 *
 
 void LiteModel::Free() {
   if (this->buf != nullptr) {
-    delete[](this->buf);
+    PackWeightManager::GetInstance()->FreeOriginTensorData(this->buf);
+    if (this->model_buf_by_mmap_) {
+      UnmapFile(this->buf, this->buf_size_);
+    } else {
+      delete[](this->buf);
+    }
     this->buf = nullptr;
   }
   auto nodes_size = this->all_nodes_.size();
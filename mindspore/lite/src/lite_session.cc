@@ -606,7 +606,7 @@ int LiteSession::CompileGraph(Model *model) {
     is_running_.store(false);
     return ret;
   }
-  ret = lite::PackWeightManager::GetInstance()->StoreOriginTensorData(model);
+  ret = lite::PackWeightManager::GetInstance()->StoreOriginTensorData(model, config_info_);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "StoreOriginTensorData failed.";
     return RET_ERROR;
@@ -649,6 +649,7 @@ int LiteSession::CompileGraph(Model *model) {
   }
 
   FreePackOpWeight(kernels_);
+  lite::PackWeightManager::GetInstance()->SavePackedTensorData(model->buf);
 
   ret = RuntimeAllocatorInit();
   if (ret != RET_OK) {
@@ -1761,6 +1762,8 @@ int lite::LiteSession::LoadModelAndCompileByBuf(const char *model_buf, mindspore
     return RET_ERROR;
   }
   auto ret = CompileGraph(model);
+  // The model buffer belongs to the caller, the const tensor data in it can not be shared after compile.
+  lite::PackWeightManager::GetInstance()->FreeOriginTensorData(model->buf);
   model->buf = nullptr;
   if (buf_model_type == mindspore::ModelType::kMindIR) {
     delete[] lite_buf;
@@ -1791,6 +1794,8 @@ int lite::LiteSession::LoadModelAndCompileByBuf(const char *model_buf, mindspore
     return RET_ERROR;
   }
   auto ret = CompileGraph(model);
+  // The model buffer belongs to the caller, the const tensor data in it can not be shared after compile.
+  lite::PackWeightManager::GetInstance()->FreeOriginTensorData(model->buf);
   model->buf = nullptr;
   if (buf_model_type == mindspore::ModelType::kMindIR) {
     delete[] lite_buf;
@@ -1805,9 +1810,59 @@ int lite::LiteSession::LoadModelAndCompileByBuf(const char *model_buf, mindspore
   return RET_OK;
 }
 
+bool lite::LiteSession::IsModelFileMmapEnabled() const {
+  if (config_info_ == nullptr) {
+    return false;
+  }
+  auto section_iter = config_info_->find(kModelFileSection);
+  if (section_iter == config_info_->end()) {
+    return false;
+  }
+  auto mmap_iter = section_iter->second.find(kModelFileMmap);
+  return mmap_iter != section_iter->second.end() && mmap_iter->second == "true";
+}
+
+const char *lite::LiteSession::LoadModelByMmap(const std::string &file, mindspore::ModelType model_type,
+                                               size_t *size) {
+  if (model_type != mindspore::ModelType::kMindIR_Lite && model_type != mindspore::ModelType::kMindIR) {
+    return nullptr;
+  }
+  size_t buf_size = 0;
+  auto model_buf = lite::MapFile(file.c_str(), &buf_size);
+  if (model_buf == nullptr) {
+    MS_LOG(WARNING) << "Map model file failed, read the model file instead.";
+    return nullptr;
+  }
+  // Only the mslite model can be used in place, the MindIR model is converted to a new buffer.
+  flatbuffers::Verifier verify(reinterpret_cast<const uint8_t *>(model_buf), buf_size);
+  if (lite::LiteModel::VersionVerify(&verify) == SCHEMA_INVALID) {
+    MS_LOG(INFO) << "The model file is not a mslite model, read the model file instead.";
+    lite::UnmapFile(model_buf, buf_size);
+    return nullptr;
+  }
+  *size = buf_size;
+  return model_buf;
+}
+
+void lite::LiteSession::ReleaseModelBuf(const char *model_buf, size_t size, bool model_buf_by_mmap) {
+  if (model_buf_by_mmap) {
+    lite::UnmapFile(const_cast<char *>(model_buf), size);
+  } else {
+    delete[] model_buf;
+  }
+}
+
 int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path, mindspore::ModelType model_type) {
   size_t model_size;
-  auto model_buf = LoadModelByPath(model_path, model_type, &model_size);
+  const char *model_buf = nullptr;
+  bool model_buf_by_mmap = false;
+  if (IsModelFileMmapEnabled()) {
+    model_buf = LoadModelByMmap(model_path, model_type, &model_size);
+    model_buf_by_mmap = model_buf != nullptr;
+  }
+  if (model_buf == nullptr) {
+    model_buf = LoadModelByPath(model_path, model_type, &model_size);
+  }
   if (model_buf == nullptr) {
     MS_LOG(ERROR) << "Read model file failed";
     return RET_ERROR;
@@ -1815,10 +1870,12 @@ int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path,
   auto *model = lite::ImportFromBuffer(model_buf, model_size, true);
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model failed";
+    ReleaseModelBuf(model_buf, model_size, model_buf_by_mmap);
     return RET_ERROR;
   }
 
   (reinterpret_cast<lite::LiteModel *>(model))->set_keep_model_buf(true);
+  (reinterpret_cast<lite::LiteModel *>(model))->set_model_buf_by_mmap(model_buf_by_mmap);
   auto ret = CompileGraph(model);
   if (ret != lite::RET_OK) {
     delete model;
@@ -1832,7 +1889,15 @@ int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path,
 int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path, mindspore::ModelType model_type,
                                                  const std::shared_ptr<mindspore::Context> &ms_context) {
   size_t model_size;
-  auto model_buf = LoadModelByPath(model_path, model_type, &model_size, ms_context);
+  const char *model_buf = nullptr;
+  bool model_buf_by_mmap = false;
+  if (IsModelFileMmapEnabled()) {
+    model_buf = LoadModelByMmap(model_path, model_type, &model_size);
+    model_buf_by_mmap = model_buf != nullptr;
+  }
+  if (model_buf == nullptr) {
+    model_buf = LoadModelByPath(model_path, model_type, &model_size, ms_context);
+  }
   if (model_buf == nullptr) {
     MS_LOG(ERROR) << "Read model file failed";
     return RET_ERROR;
@@ -1840,16 +1905,15 @@ int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path,
   auto *model = lite::ImportFromBuffer(model_buf, model_size, true);
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model failed";
-    delete[] model_buf;
+    ReleaseModelBuf(model_buf, model_size, model_buf_by_mmap);
     return RET_ERROR;
   }
 
   (reinterpret_cast<lite::LiteModel *>(model))->set_keep_model_buf(true);
+  (reinterpret_cast<lite::LiteModel *>(model))->set_model_buf_by_mmap(model_buf_by_mmap);
   auto ret = CompileGraph(model);
   if (ret != lite::RET_OK) {
     MS_LOG(ERROR) << "Compile model failed";
-    delete[] model_buf;
-    model->buf = nullptr;
     delete model;
     return RET_ERROR;
   }
@@ -65,6 +65,7 @@ class LiteSession : public session::LiteSession {
   static const char *LoadModelByPath(const std::string &file, mindspore::ModelType model_type, size_t *size);
   static const char *LoadModelByPath(const std::string &file, mindspore::ModelType model_type, size_t *size,
                                      const std::shared_ptr<mindspore::Context> &ms_context);
+  static const char *LoadModelByMmap(const std::string &file, mindspore::ModelType model_type, size_t *size);
   virtual int Init(InnerContext *context);
   void BindThread(bool if_bind) override;
   int CompileGraph(Model *model) override;
@@ -126,6 +127,8 @@ class LiteSession : public session::LiteSession {
   int CreateNPUDelegate();
   int DelegateInit();
   int InitGPURuntime();
+  bool IsModelFileMmapEnabled() const;
+  static void ReleaseModelBuf(const char *model_buf, size_t size, bool model_buf_by_mmap);
 
  private:
   int IsolateOutputTensor();
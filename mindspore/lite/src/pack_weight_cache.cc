@@ -0,0 +1,517 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/pack_weight_cache.h"
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include "include/version.h"
+#include "src/common/log_adapter.h"
+#include "nnacl/op_base.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr uint64_t kHashSeed = 0xcbf29ce484222325ULL;
+constexpr uint64_t kHashPrime = 0x100000001b3ULL;
+constexpr int kHashShift = 29;
+constexpr int kHexWidth = 16;
+// The packed weight file is composed of the header, the index of the packed tensors and the packed data:
+//   header: magic "MSPACKWT"(8 bytes), version(uint32), tensor num(uint32), instruction set(16 bytes),
+//           lite version(32 bytes), model hash(uint64), model size(uint64).
+//   index: offset of origin tensor in model(uint64), packed size(uint64), offset of packed data in file(uint64),
+//          layout(uint64).
+// The packed data is aligned to kPackedDataAlign in the file. The integers are in the byte order of the host.
+constexpr char kPackedFileMagic[] = "MSPACKWT";
+constexpr uint32_t kPackedFileVersion = 2;
+constexpr size_t kPackedFileMagicSize = 8;
+constexpr size_t kPackedFileIsaSize = 16;
+constexpr size_t kPackedFileLiteVersionSize = 32;
+constexpr size_t kPackedDataAlign = 64;
+
+struct PackedFileHeader {
+  char magic[kPackedFileMagicSize];
+  uint32_t version;
+  uint32_t tensor_num;
+  char isa[kPackedFileIsaSize];
+  char lite_version[kPackedFileLiteVersionSize];
+  uint64_t model_hash;
+  uint64_t model_size;
+};
+
+struct PackedFileIndex {
+  uint64_t offset;
+  uint64_t size;
+  uint64_t data_offset;
+  uint64_t layout;
+};
+
+// The layout of the packed weights is selected by the instruction set when building.
+const char *PackedWeightIsa() {
+#if defined(ENABLE_AVX512)
+  return "AVX512";
+#elif defined(ENABLE_AVX)
+  return "AVX";
+#elif defined(ENABLE_SSE)
+  return "SSE";
+#elif defined(ENABLE_ARM64)
+  return "ARM64";
+#elif defined(ENABLE_ARM32)
+  return "ARM32";
+#else
+  return "GENERIC";
+#endif
+}
+
+PackedFileHeader CreatePackedFileHeader(uint64_t model_hash, size_t model_size, size_t tensor_num) {
+  PackedFileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kPackedFileMagic, kPackedFileMagicSize);
+  header.version = kPackedFileVersion;
+  header.tensor_num = static_cast<uint32_t>(tensor_num);
+  (void)strncpy(header.isa, PackedWeightIsa(), kPackedFileIsaSize - 1);
+  (void)strncpy(header.lite_version, Version().c_str(), kPackedFileLiteVersionSize - 1);
+  header.model_hash = model_hash;
+  header.model_size = model_size;
+  return header;
+}
+
+uint64_t HashModelBuf(const char *model_buf, size_t model_size) {
+  uint64_t hash = kHashSeed ^ model_size;
+  size_t word_num = model_size / sizeof(uint64_t);
+  for (size_t i = 0; i < word_num; ++i) {
+    uint64_t word;
+    memcpy(&word, model_buf + i * sizeof(uint64_t), sizeof(uint64_t));
+    hash = (hash ^ word) * kHashPrime;
+    hash ^= hash >> kHashShift;
+  }
+  for (size_t i = word_num * sizeof(uint64_t); i < model_size; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(model_buf[i])) * kHashPrime;
+  }
+  return hash;
+}
+
+std::string HashToString(uint64_t hash) {
+  char str[kHexWidth + 1] = {0};
+  (void)snprintf(str, sizeof(str), "%016llx", static_cast<unsigned long long>(hash));
+  return str;
+}
+}  // namespace
+
+struct PackWeightCache::PackedFile {
+  ~PackedFile() {
+#ifndef _WIN32
+    if (addr != nullptr) {
+      (void)munmap(addr, size);
+    }
+#endif
+  }
+  void *addr = nullptr;
+  size_t size = 0;
+  std::map<PackedKey, void *> tensors;
+};
+
+PackWeightCache *PackWeightCache::GetInstance() {
+  static PackWeightCache instance;
+  return &instance;
+}
+
+PackWeightCache::~PackWeightCache() {
+  for (auto &item : packed_tensors_) {
+    FreePackedTensor(&item.second);
+  }
+  packed_tensors_.clear();
+  packed_keys_.clear();
+}
+
+STATUS PackWeightCache::RegisterModel(const char *model_buf, size_t model_size,
+                                      const std::vector<const void *> &tensor_datas, const std::string &cache_dir,
+                                      const std::string &packed_file) {
+  MS_CHECK_TRUE_MSG(model_buf != nullptr && model_size != 0, RET_ERROR, "model buf is invalid in pack weight cache.");
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = models_.find(model_buf);
+  if (iter != models_.end()) {
+    if (iter->second.model_size == model_size && iter->second.cache_dir == cache_dir &&
+        iter->second.packed_file_path == packed_file) {
+      ++iter->second.ref_count;
+      return RET_OK;
+    }
+    MS_LOG(ERROR) << "The model buf is registered with different model size or cache dir.";
+    return RET_ERROR;
+  }
+  ModelInfo model_info;
+  model_info.model_size = model_size;
+  model_info.model_hash = GetModelHash(model_buf, model_size);
+  model_info.cache_dir = cache_dir;
+  model_info.packed_file_path = packed_file;
+  if (!packed_file.empty()) {
+    model_info.packed_file = LoadPackedFile(packed_file, model_info.model_hash, model_size);
+    if (model_info.packed_file != nullptr) {
+      model_info.saved_tensor_num = model_info.packed_file->tensors.size();
+    }
+  }
+  model_info.ref_count = 1;
+  for (auto tensor_data : tensor_datas) {
+    auto data = static_cast<const char *>(tensor_data);
+    if (data < model_buf || data >= model_buf + model_size) {
+      continue;
+    }
+    OriginTensor origin_tensor;
+    origin_tensor.model_buf = model_buf;
+    origin_tensor.model_hash = model_info.model_hash;
+    origin_tensor.offset = static_cast<size_t>(data - model_buf);
+    origin_tensors_[tensor_data] = origin_tensor;
+    model_info.tensor_datas.push_back(tensor_data);
+  }
+  MS_LOG(INFO) << "Register model " << HashToString(model_info.model_hash) << " with "
+               << model_info.tensor_datas.size() << " const tensors to pack weight cache.";
+  models_[model_buf] = std::move(model_info);
+  return RET_OK;
+}
+
+void PackWeightCache::UnregisterModel(const char *model_buf) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = models_.find(model_buf);
+  if (iter == models_.end()) {
+    return;
+  }
+  if (--iter->second.ref_count > 0) {
+    return;
+  }
+  // The packed tensors are kept until the kernels release them, only the origin tensor data is invalid from now on.
+  for (auto tensor_data : iter->second.tensor_datas) {
+    auto origin_iter = origin_tensors_.find(tensor_data);
+    if (origin_iter != origin_tensors_.end() && origin_iter->second.model_buf == model_buf) {
+      (void)origin_tensors_.erase(origin_iter);
+    }
+  }
+  (void)models_.erase(iter);
+}
+
+void *PackWeightCache::GetPackedTensor(const void *tensor_data, size_t size, PackLayout layout, bool *is_packed) {
+  MS_ASSERT(is_packed != nullptr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto origin_iter = origin_tensors_.find(tensor_data);
+  if (origin_iter == origin_tensors_.end()) {
+    return nullptr;
+  }
+  auto model_buf = origin_iter->second.model_buf;
+  PackedKey key(origin_iter->second.model_hash, origin_iter->second.offset, size, layout);
+  auto iter = packed_tensors_.find(key);
+  if (iter != packed_tensors_.end()) {
+    auto &packed_tensor = iter->second;
+    // Another session is packing the weight, it may never finish if the kernel packs at runtime, so do not wait.
+    if (!packed_tensor.packed) {
+      MS_LOG(DEBUG) << "The weight is being packed by another session, use the private packed weight.";
+      return nullptr;
+    }
+    ++packed_tensor.ref_count;
+    *is_packed = true;
+    return packed_tensor.data;
+  }
+  auto model_iter = models_.find(model_buf);
+  MS_CHECK_TRUE_RET(model_iter != models_.end(), nullptr);
+  PackedTensor packed_tensor;
+  void *data = nullptr;
+  auto &packed_file = model_iter->second.packed_file;
+  if (packed_file != nullptr && packed_file->tensors.find(key) != packed_file->tensors.end()) {
+    data = packed_file->tensors[key];
+    packed_tensor.data = data;
+    packed_tensor.size = size;
+    packed_tensor.packed = true;
+    packed_tensor.packed_file = packed_file;
+  } else {
+    data = AllocPackedTensor(key, model_iter->second.cache_dir, &packed_tensor);
+  }
+  if (data == nullptr) {
+    return nullptr;
+  }
+  packed_tensor.ref_count = 1;
+  *is_packed = packed_tensor.packed;
+  packed_tensors_[key] = std::move(packed_tensor);
+  packed_keys_[data] = key;
+  return data;
+}
+
+void PackWeightCache::MarkPacked(const void *packed_data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key_iter = packed_keys_.find(packed_data);
+  if (key_iter == packed_keys_.end()) {
+    return;
+  }
+  auto &packed_tensor = packed_tensors_[key_iter->second];
+  if (packed_tensor.packed) {
+    return;
+  }
+  packed_tensor.packed = true;
+#ifndef _WIN32
+  // The file is complete now, publish it for the later processes.
+  if (packed_tensor.by_mmap && !packed_tensor.tmp_file_path.empty()) {
+    if (rename(packed_tensor.tmp_file_path.c_str(), packed_tensor.file_path.c_str()) != 0) {
+      MS_LOG(WARNING) << "Save packed weight to " << packed_tensor.file_path << " failed.";
+      (void)remove(packed_tensor.tmp_file_path.c_str());
+    }
+    packed_tensor.tmp_file_path.clear();
+  }
+#endif
+}
+
+bool PackWeightCache::Free(const void *packed_data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key_iter = packed_keys_.find(packed_data);
+  if (key_iter == packed_keys_.end()) {
+    return false;
+  }
+  auto iter = packed_tensors_.find(key_iter->second);
+  MS_ASSERT(iter != packed_tensors_.end());
+  if (--iter->second.ref_count > 0) {
+    return true;
+  }
+  FreePackedTensor(&iter->second);
+  (void)packed_tensors_.erase(iter);
+  (void)packed_keys_.erase(key_iter);
+  return true;
+}
+
+uint64_t PackWeightCache::GetModelHash(const char *model_buf, size_t model_size) {
+  // The sessions of the same model usually load it at the same time, comparing with the registered model buffer is
+  // much faster than hashing the whole buffer again.
+  for (const auto &item : models_) {
+    if (item.second.model_size == model_size && memcmp(item.first, model_buf, model_size) == 0) {
+      return item.second.model_hash;
+    }
+  }
+  return HashModelBuf(model_buf, model_size);
+}
+
+size_t PackWeightCache::PackedTensorNum() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return packed_tensors_.size();
+}
+
+void *PackWeightCache::AllocPackedTensor(const PackedKey &key, const std::string &cache_dir,
+                                         PackedTensor *packed_tensor) {
+  MS_ASSERT(packed_tensor != nullptr);
+  auto size = std::get<2>(key);
+  packed_tensor->size = size;
+#ifndef _WIN32
+  if (!cache_dir.empty()) {
+    packed_tensor->file_path = cache_dir + "/" + HashToString(std::get<0>(key)) + "_" + PackedWeightIsa() + "_" +
+                               std::to_string(std::get<1>(key)) + "_" + std::to_string(size) + "_" +
+                               std::to_string(std::get<3>(key)) + ".packed";
+    struct stat file_stat {};
+    bool exist =
+      stat(packed_tensor->file_path.c_str(), &file_stat) == 0 && static_cast<size_t>(file_stat.st_size) == size;
+    auto path = exist ? packed_tensor->file_path : packed_tensor->file_path + "." + std::to_string(getpid()) + ".tmp";
+    auto fd = exist ? open(path.c_str(), O_RDONLY) : open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd >= 0 && (exist || ftruncate(fd, static_cast<off_t>(size)) == 0)) {
+      // The packed weight loaded from file is mapped privately, so that it can never be changed by the kernels.
+      auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, exist ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+      close(fd);
+      if (data != MAP_FAILED) {
+        packed_tensor->data = data;
+        packed_tensor->by_mmap = true;
+        packed_tensor->packed = exist;
+        packed_tensor->tmp_file_path = exist ? "" : path;
+        MS_LOG(DEBUG) << (exist ? "Load" : "Create") << " packed weight file " << path;
+        return data;
+      }
+    } else if (fd >= 0) {
+      close(fd);
+    }
+    if (!exist) {
+      (void)remove(path.c_str());
+    }
+    MS_LOG(WARNING) << "Map packed weight file " << path << " failed, use the memory instead.";
+    packed_tensor->file_path.clear();
+  }
+#endif
+  packed_tensor->data = malloc(size);
+  if (packed_tensor->data == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed weight failed, size: " << size;
+  }
+  return packed_tensor->data;
+}
+
+void PackWeightCache::FreePackedTensor(PackedTensor *packed_tensor) {
+  MS_ASSERT(packed_tensor != nullptr);
+  if (packed_tensor->data == nullptr) {
+    return;
+  }
+  if (packed_tensor->packed_file != nullptr) {
+    packed_tensor->packed_file = nullptr;
+    packed_tensor->data = nullptr;
+    return;
+  }
+#ifndef _WIN32
+  if (packed_tensor->by_mmap) {
+    (void)munmap(packed_tensor->data, packed_tensor->size);
+    // The weight is released before packed, the incomplete file is useless.
+    if (!packed_tensor->tmp_file_path.empty()) {
+      (void)remove(packed_tensor->tmp_file_path.c_str());
+    }
+    packed_tensor->data = nullptr;
+    return;
+  }
+#endif
+  free(packed_tensor->data);
+  packed_tensor->data = nullptr;
+}
+
+STATUS PackWeightCache::SavePackedFile(const char *model_buf) {
+#ifdef _WIN32
+  return RET_OK;
+#else
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto model_iter = models_.find(model_buf);
+  if (model_iter == models_.end() || model_iter->second.packed_file_path.empty()) {
+    return RET_OK;
+  }
+  auto &model_info = model_iter->second;
+  // The loaded file is still mapped, so its weights are written again along with the ones packed after loading.
+  std::map<PackedKey, const void *> packed_datas;
+  if (model_info.packed_file != nullptr) {
+    packed_datas.insert(model_info.packed_file->tensors.begin(), model_info.packed_file->tensors.end());
+  }
+  for (auto &item : packed_tensors_) {
+    if (std::get<0>(item.first) == model_info.model_hash && item.second.packed) {
+      (void)packed_datas.emplace(item.first, item.second.data);
+    }
+  }
+  if (packed_datas.size() <= model_info.saved_tensor_num) {
+    return RET_OK;
+  }
+  std::vector<std::pair<PackedFileIndex, const void *>> tensors;
+  size_t data_offset = sizeof(PackedFileHeader) + packed_datas.size() * sizeof(PackedFileIndex);
+  for (auto &item : packed_datas) {
+    PackedFileIndex index = {std::get<1>(item.first), std::get<2>(item.first), 0, std::get<3>(item.first)};
+    tensors.emplace_back(index, item.second);
+  }
+  for (auto &tensor : tensors) {
+    data_offset = (data_offset + kPackedDataAlign - 1) / kPackedDataAlign * kPackedDataAlign;
+    tensor.first.data_offset = data_offset;
+    data_offset += tensor.first.size;
+  }
+
+  auto &path = model_info.packed_file_path;
+  auto tmp_path = path + "." + std::to_string(getpid()) + ".tmp";
+  std::ofstream ofs(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open packed weight file " << tmp_path << " failed.";
+    return RET_ERROR;
+  }
+  auto header = CreatePackedFileHeader(model_info.model_hash, model_info.model_size, tensors.size());
+  (void)ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  for (auto &tensor : tensors) {
+    (void)ofs.write(reinterpret_cast<const char *>(&tensor.first), sizeof(PackedFileIndex));
+  }
+  for (auto &tensor : tensors) {
+    (void)ofs.seekp(static_cast<std::streamoff>(tensor.first.data_offset));
+    (void)ofs.write(static_cast<const char *>(tensor.second), static_cast<std::streamsize>(tensor.first.size));
+  }
+  ofs.close();
+  if (!ofs.good() || rename(tmp_path.c_str(), path.c_str()) != 0) {
+    MS_LOG(WARNING) << "Save packed weight file " << path << " failed.";
+    (void)remove(tmp_path.c_str());
+    return RET_ERROR;
+  }
+  model_info.saved_tensor_num = tensors.size();
+  MS_LOG(INFO) << "Save " << tensors.size() << " packed weights to " << path;
+  return RET_OK;
+#endif
+}
+
+std::shared_ptr<PackWeightCache::PackedFile> PackWeightCache::LoadPackedFile(const std::string &path,
+                                                                             uint64_t model_hash, size_t model_size) {
+#ifdef _WIN32
+  MS_LOG(WARNING) << "Packed weight file is not supported on windows.";
+  return nullptr;
+#else
+  auto fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(INFO) << "Packed weight file " << path << " does not exist, it will be saved after compile.";
+    return nullptr;
+  }
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(PackedFileHeader)) {
+    close(fd);
+    MS_LOG(WARNING) << "Packed weight file " << path << " is invalid, it will be saved again after compile.";
+    return nullptr;
+  }
+  auto file_size = static_cast<size_t>(file_stat.st_size);
+  // Mapped privately, the packed weights can never be changed by the kernels.
+  auto addr = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(WARNING) << "Map packed weight file " << path << " failed.";
+    return nullptr;
+  }
+  auto packed_file = std::make_shared<PackedFile>();
+  packed_file->addr = addr;
+  packed_file->size = file_size;
+
+  auto base = static_cast<char *>(addr);
+  PackedFileHeader header;
+  memcpy(&header, base, sizeof(header));
+  auto expect_header = CreatePackedFileHeader(model_hash, model_size, header.tensor_num);
+  if (memcmp(header.magic, expect_header.magic, kPackedFileMagicSize) != 0 ||
+      header.version != expect_header.version) {
+    MS_LOG(WARNING) << "Packed weight file " << path << " is not of version " << kPackedFileVersion
+                    << ", it will be saved again after compile.";
+    return nullptr;
+  }
+  if (memcmp(header.isa, expect_header.isa, kPackedFileIsaSize) != 0) {
+    MS_LOG(WARNING) << "Packed weight file " << path << " is packed for instruction set "
+                    << std::string(header.isa, strnlen(header.isa, kPackedFileIsaSize)) << " rather than "
+                    << PackedWeightIsa() << ", it will be saved again after compile.";
+    return nullptr;
+  }
+  if (memcmp(header.lite_version, expect_header.lite_version, kPackedFileLiteVersionSize) != 0) {
+    MS_LOG(WARNING) << "Packed weight file " << path << " is saved by another version of MindSpore Lite, it will be "
+                    << "saved again after compile.";
+    return nullptr;
+  }
+  if (header.model_hash != expect_header.model_hash || header.model_size != expect_header.model_size) {
+    MS_LOG(WARNING) << "Packed weight file " << path << " does not match the model, it will be saved again after "
+                    << "compile.";
+    return nullptr;
+  }
+  if (file_size < sizeof(PackedFileHeader) + header.tensor_num * sizeof(PackedFileIndex)) {
+    MS_LOG(WARNING) << "Packed weight file " << path << " is broken, it will be saved again after compile.";
+    return nullptr;
+  }
+  for (size_t i = 0; i < header.tensor_num; ++i) {
+    PackedFileIndex index;
+    memcpy(&index, base + sizeof(PackedFileHeader) + i * sizeof(PackedFileIndex), sizeof(index));
+    if (index.data_offset % kPackedDataAlign != 0 || index.data_offset > file_size ||
+        index.size > file_size - index.data_offset) {
+      MS_LOG(WARNING) << "Packed weight file " << path << " is broken, it will be saved again after compile.";
+      return nullptr;
+    }
+    packed_file->tensors[PackedKey(model_hash, index.offset, index.size, static_cast<uint8_t>(index.layout))] =
+      base + index.data_offset;
+  }
+  MS_LOG(INFO) << "Load " << header.tensor_num << " packed weights from " << path;
+  return packed_file;
+#endif
+}
+}  // namespace mindspore::lite
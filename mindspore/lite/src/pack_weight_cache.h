@@ -0,0 +1,119 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_PACK_WEIGHT_CACHE_H_
+#define MINDSPORE_LITE_SRC_PACK_WEIGHT_CACHE_H_
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "include/errorcode.h"
+
+namespace mindspore::lite {
+// The layout of the packed weight, the same origin tensor data packed by different kernels is never shared.
+enum PackLayout : uint8_t {
+  PACK_LAYOUT_DEFAULT = 0,
+  PACK_LAYOUT_MATMUL_A = 1,
+  PACK_LAYOUT_MATMUL_B = 2,
+  PACK_LAYOUT_CONV = 3,
+  PACK_LAYOUT_CONV_1X1 = 4,
+  PACK_LAYOUT_CONV_WINOGRAD = 5,
+  PACK_LAYOUT_CONV_DEPTHWISE = 6,
+  PACK_LAYOUT_CONV_DEPTHWISE_INDIRECT = 7,
+  PACK_LAYOUT_CONV_DEPTHWISE_SW = 8,
+};
+
+// Process-wide cache of the packed const weights, shared by all the sessions of the same model.
+// A packed weight is keyed by the hash of the model buffer, the offset of the origin tensor data in the model buffer,
+// the packed size and the layout, so the sessions which load the same model into different buffers share one packed
+// copy. The hash is computed once for the sessions of the same model alive at the same time.
+// The packed weight is reference counted by the kernels using it and is released when the last kernel releases it.
+// If the cache dir is set, the packed weight is stored in a file mapped into memory, which is reused after restart.
+// If the packed weight file is set, all the packed weights of the model are saved into the file after the first
+// compile, and mapped from the file by the later loads. The file is validated by the model hash, the instruction set
+// and the version, because the packed layout depends on them.
+class PackWeightCache {
+ public:
+  static PackWeightCache *GetInstance();
+  ~PackWeightCache();
+
+  // Register the const tensor data of the model buffer, a model buffer can be registered by several sessions.
+  STATUS RegisterModel(const char *model_buf, size_t model_size, const std::vector<const void *> &tensor_datas,
+                       const std::string &cache_dir, const std::string &packed_file = "");
+  void UnregisterModel(const char *model_buf);
+  // Save the packed weights of the model to the packed weight file, if it is not loaded from the file or more weights
+  // are packed after loading. The weights in the loaded file which are not used are saved again as well.
+  STATUS SavePackedFile(const char *model_buf);
+
+  // Return nullptr if the origin tensor data is not registered, or the weight is being packed by another session, then
+  // the caller packs its own copy. If is_packed is false, the caller must pack the weight into the returned buffer and
+  // call MarkPacked.
+  void *GetPackedTensor(const void *tensor_data, size_t size, PackLayout layout, bool *is_packed);
+  void MarkPacked(const void *packed_data);
+  // Return false if the packed data is not from the cache.
+  bool Free(const void *packed_data);
+
+  size_t PackedTensorNum();
+
+ private:
+  PackWeightCache() = default;
+  // model hash, offset in model buffer, packed size, layout
+  using PackedKey = std::tuple<uint64_t, size_t, size_t, uint8_t>;
+  struct PackedFile;
+  struct OriginTensor {
+    const char *model_buf = nullptr;
+    uint64_t model_hash = 0;
+    size_t offset = 0;
+  };
+  struct ModelInfo {
+    size_t model_size = 0;
+    uint64_t model_hash = 0;
+    std::string cache_dir;
+    std::string packed_file_path;
+    std::shared_ptr<PackedFile> packed_file;
+    // The number of the packed weights in the packed weight file loaded or saved.
+    size_t saved_tensor_num = 0;
+    std::vector<const void *> tensor_datas;
+    int ref_count = 0;
+  };
+  struct PackedTensor {
+    void *data = nullptr;
+    size_t size = 0;
+    int ref_count = 0;
+    bool packed = false;
+    bool by_mmap = false;
+    std::string file_path;
+    std::string tmp_file_path;
+    // The packed weight file holding the data, it is unmapped after all the packed weights in it are freed.
+    std::shared_ptr<PackedFile> packed_file;
+  };
+
+  void *AllocPackedTensor(const PackedKey &key, const std::string &cache_dir, PackedTensor *packed_tensor);
+  void FreePackedTensor(PackedTensor *packed_tensor);
+  uint64_t GetModelHash(const char *model_buf, size_t model_size);
+  std::shared_ptr<PackedFile> LoadPackedFile(const std::string &path, uint64_t model_hash, size_t model_size);
+
+  std::mutex mutex_;
+  std::unordered_map<const char *, ModelInfo> models_;
+  std::unordered_map<const void *, OriginTensor> origin_tensors_;
+  std::map<PackedKey, PackedTensor> packed_tensors_;
+  std::unordered_map<const void *, PackedKey> packed_keys_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_PACK_WEIGHT_CACHE_H_
@@ -15,7 +15,36 @@
  */
 #include "src/pack_weight_manager.h"
 #include "src/common/graph_util.h"
+#include "src/common/common.h"
 namespace mindspore::lite {
+namespace {
+// The shared weight cache is used if it is enabled or the packed weight file is set.
+bool GetSharedWeightCacheConfig(const std::map<std::string, std::map<std::string, std::string>> *config_info,
+                                std::string *cache_dir, std::string *packed_file) {
+  if (config_info == nullptr) {
+    return false;
+  }
+  auto section_iter = config_info->find(kSharedWeightCacheSection);
+  if (section_iter == config_info->end()) {
+    return false;
+  }
+  auto &section = section_iter->second;
+  auto file_iter = section.find(kSharedWeightCachePackedFile);
+  if (file_iter != section.end()) {
+    *packed_file = file_iter->second;
+  }
+  auto enable_iter = section.find(kSharedWeightCacheEnable);
+  if ((enable_iter == section.end() || enable_iter->second != "true") && packed_file->empty()) {
+    return false;
+  }
+  auto dir_iter = section.find(kSharedWeightCacheDir);
+  if (dir_iter != section.end()) {
+    *cache_dir = dir_iter->second;
+  }
+  return true;
+}
+}  // namespace
+
 PackWeightManager *PackWeightManager::GetInstance() {
   static PackWeightManager instance;
   return &instance;
@@ -48,8 +77,33 @@ char *PackWeightManager::GetNumaModelBuf(int numa_id) {
   return ret;
 }
 
-STATUS PackWeightManager::StoreOriginTensorData(Model *model) {
+STATUS PackWeightManager::StoreSharedTensorData(Model *model, const std::string &cache_dir,
+                                                const std::string &packed_file) {
+  auto lite_model = reinterpret_cast<LiteModel *>(model);
+  std::vector<const void *> tensor_datas;
+  for (auto node : model->all_nodes_) {
+    for (auto tensor_index : node->input_indices_) {
+      auto src_tensor = lite_model->GetSchemaTensor(tensor_index);
+      if (src_tensor == nullptr || src_tensor->handler() == nullptr || src_tensor->data() == nullptr ||
+          src_tensor->length() == 0) {
+        continue;
+      }
+      tensor_datas.push_back(src_tensor->data());
+    }
+  }
+  return PackWeightCache::GetInstance()->RegisterModel(lite_model->buf, lite_model->buf_size_, tensor_datas,
+                                                       cache_dir, packed_file);
+}
+
+STATUS PackWeightManager::StoreOriginTensorData(
+  Model *model, const std::map<std::string, std::map<std::string, std::string>> *config_info) {
   MS_CHECK_TRUE_MSG(model != nullptr, RET_ERROR, "model is nullptr in pack weight manager.");
+  std::string cache_dir;
+  std::string packed_file;
+  if (pack_weight_ == nullptr && model->buf != nullptr &&
+      GetSharedWeightCacheConfig(config_info, &cache_dir, &packed_file)) {
+    return StoreSharedTensorData(model, cache_dir, packed_file);
+  }
 #ifdef SHARING_MODEL_WEIGHT
   if (pack_weight_ == nullptr) {
     MS_LOG(DEBUG) << "define SHARING_MODEL_WEIGHT but not use parallel predict.";
@@ -78,11 +132,16 @@ STATUS PackWeightManager::StoreOriginTensorData(Model *model) {
   return RET_OK;
 }
 
-void *PackWeightManager::GetPackedTensor(const void *tensor_data, const size_t size, bool *is_packed) {
+void *PackWeightManager::GetPackedTensor(const void *tensor_data, const size_t size, bool *is_packed,
+                                         PackLayout layout) {
   if (size > MAX_MALLOC_SIZE || size == 0) {
     MS_LOG(ERROR) << "malloc size is wrong.";
     return nullptr;
   }
+  auto shared_data = PackWeightCache::GetInstance()->GetPackedTensor(tensor_data, size, layout, is_packed);
+  if (shared_data != nullptr) {
+    return shared_data;
+  }
   if (pack_weight_ == nullptr) {
     void *data = malloc(size);
     *is_packed = false;
@@ -94,7 +153,28 @@ void *PackWeightManager::GetPackedTensor(const void *tensor_data, const size_t s
   return nullptr;
 }
 
+void PackWeightManager::SavePackedTensorData(const char *model_buf) {
+  if (model_buf == nullptr) {
+    return;
+  }
+  (void)PackWeightCache::GetInstance()->SavePackedFile(model_buf);
+}
+
+void PackWeightManager::FreeOriginTensorData(const char *model_buf) {
+  PackWeightCache::GetInstance()->UnregisterModel(model_buf);
+}
+
+void PackWeightManager::MarkPacked(const void *packed_data) {
+  if (packed_data == nullptr) {
+    return;
+  }
+  PackWeightCache::GetInstance()->MarkPacked(packed_data);
+}
+
 void PackWeightManager::Free(void *tensor_data) {
+  if (tensor_data != nullptr && PackWeightCache::GetInstance()->Free(tensor_data)) {
+    return;
+  }
 #ifdef SHARING_MODEL_WEIGHT
   return;
 #endif
@@ -27,6 +27,7 @@
 #include <memory>
 #include "src/tensor.h"
 #include "src/pack_weight.h"
+#include "src/pack_weight_cache.h"
 namespace mindspore::lite {
 enum PackStatus : int8_t { NOTPACK = 1, PACKED = 2, MALLOC = 3 };
 
@@ -36,12 +37,20 @@ class PackWeightManager {
   ~PackWeightManager() = default;
   STATUS InitByBuf(const char *model_buf, size_t model_size, int numa_id = -1);
   char *GetNumaModelBuf(int numa_id);
-  STATUS StoreOriginTensorData(Model *model);
-  void *GetPackedTensor(const void *tensor_data, const size_t size, bool *is_packed);
+  STATUS StoreOriginTensorData(Model *model,
+                               const std::map<std::string, std::map<std::string, std::string>> *config_info = nullptr);
+  // Save the packed weights to the packed weight file after all the kernels are prepared.
+  void SavePackedTensorData(const char *model_buf);
+  void FreeOriginTensorData(const char *model_buf);
+  void *GetPackedTensor(const void *tensor_data, const size_t size, bool *is_packed,
+                        PackLayout layout = PACK_LAYOUT_DEFAULT);
+  // Called after the weight returned by GetPackedTensor with is_packed false is packed.
+  void MarkPacked(const void *packed_data);
   void Free(void *tensor_data);
 
  private:
   PackWeightManager() = default;
+  STATUS StoreSharedTensorData(Model *model, const std::string &cache_dir, const std::string &packed_file);
   std::shared_ptr<PackWeight> pack_weight_ = nullptr;
   std::vector<void *> malloc_data_;
 };
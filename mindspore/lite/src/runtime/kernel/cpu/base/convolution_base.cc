@@ -179,6 +179,7 @@ int ConvolutionBaseCPUKernel::InitConvWeightBias() {
     }
     if (origin_weight_ != nullptr) {
       PackWeight();
+      lite::PackWeightManager::GetInstance()->MarkPacked(packed_weight_);
     } else {
       is_repack_ = true;
       MS_LOG(WARNING) << "The weight is nullptr, will pack in runtime.";
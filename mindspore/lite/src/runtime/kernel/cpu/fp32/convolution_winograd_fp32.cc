@@ -228,7 +228,7 @@ int ConvolutionWinogradCPUKernel::MallocWeightBiasData() {
     if (packed_weight_ == nullptr) {
       CHECK_LESS_RETURN(MAX_MALLOC_SIZE, trans_matrix_data_size);
       packed_weight_ = lite::PackWeightManager::GetInstance()->GetPackedTensor(
-        in_tensors_[1]->data(), trans_matrix_data_size, &weight_is_packed_);
+        in_tensors_[1]->data(), trans_matrix_data_size, &weight_is_packed_, lite::PACK_LAYOUT_CONV_WINOGRAD);
       if (packed_weight_ == nullptr) {
         MS_LOG(ERROR) << "malloc matrix_buffer failed.";
         return RET_MEMORY_FAILED;
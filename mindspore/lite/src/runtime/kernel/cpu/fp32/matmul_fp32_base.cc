@@ -82,7 +82,8 @@ int MatmulFp32BaseCPUKernel::PackMatrixA() {
   } else {
     bool is_packed = false;
     void *data = lite::PackWeightManager::GetInstance()->GetPackedTensor(
-      in_tensors()[FIRST_INPUT]->data(), static_cast<size_t>(matrix_a_.pack_size) * sizeof(float), &is_packed);
+      in_tensors()[FIRST_INPUT]->data(), static_cast<size_t>(matrix_a_.pack_size) * sizeof(float), &is_packed,
+      lite::PACK_LAYOUT_MATMUL_A);
     matrix_a_.pack_ptr = reinterpret_cast<float *>(data);
     if (matrix_a_.pack_ptr == nullptr) {
       MS_LOG(ERROR) << "matrix a pack ptr is nullptr.";
@@ -105,6 +106,9 @@ int MatmulFp32BaseCPUKernel::PackMatrixA() {
       matrix_a_pack_fun_(src, dst, params_->row_, params_->deep_);
     }
   }
+  if (params_->a_const_) {
+    lite::PackWeightManager::GetInstance()->MarkPacked(matrix_a_.pack_ptr);
+  }
   return RET_OK;
 }
 
@@ -130,7 +134,8 @@ int MatmulFp32BaseCPUKernel::PackMatrixB() {
   } else {
     bool is_packed = false;
     void *data = lite::PackWeightManager::GetInstance()->GetPackedTensor(
-      in_tensors()[SECOND_INPUT]->data(), static_cast<size_t>(matrix_b_.pack_size) * sizeof(float), &is_packed);
+      in_tensors()[SECOND_INPUT]->data(), static_cast<size_t>(matrix_b_.pack_size) * sizeof(float), &is_packed,
+      lite::PACK_LAYOUT_MATMUL_B);
     matrix_b_.pack_ptr = reinterpret_cast<float *>(data);
     if (matrix_b_.pack_ptr == nullptr) {
       MS_LOG(ERROR) << "matrix b pack ptr is nullptr.";
@@ -153,6 +158,9 @@ int MatmulFp32BaseCPUKernel::PackMatrixB() {
       matrix_b_pack_fun_(src, dst, params_->deep_, params_->col_);
     }
   }
+  if (params_->b_const_) {
+    lite::PackWeightManager::GetInstance()->MarkPacked(matrix_b_.pack_ptr);
+  }
   return RET_OK;
 }
 
@@ -14,16 +14,20 @@
  * limitations under the License.
  */
 // #include <sys/time.h>
+#include <chrono>
 #include "actor/actor.h"
 #include "actor/op_actor.h"
 #include "async/uuid_base.h"
 #include "async/future.h"
+#include "async/async.h"
 #include "src/lite_mindrt.h"
 #include "thread/hqueue.h"
+#include "actor/mailbox.h"
 #include "thread/actor_threadpool.h"
 #include "common/common_test.h"
 #include "schema/model_generated.h"
 #include "include/model.h"
+#include "src/common/log_adapter.h"
 
 namespace mindspore {
 class LiteMindRtTest : public mindspore::CommonTest {
@@ -112,6 +116,198 @@ class TestActor : public ActorBase {
   int data = 0;
 };
 
+class PingPongActor : public ActorBase {
+ public:
+  PingPongActor(const std::string &nm, ActorThreadPool *pool) : ActorBase(nm, pool) {}
+  void set_peer(const AID &peer) { peer_ = peer; }
+  void Ping(int count, Promise<int> *done) {
+    if (count <= 0) {
+      done->SetValue(0);
+      return;
+    }
+    Async(peer_, &PingPongActor::Ping, count - 1, done);
+  }
+
+ private:
+  AID peer_;
+};
+
+class FanInActor;
+class FanOutLeafActor : public ActorBase {
+ public:
+  FanOutLeafActor(const std::string &nm, ActorThreadPool *pool) : ActorBase(nm, pool) {}
+  void set_hub(const AID &hub) { hub_ = hub; }
+  void Work(int round);
+
+ private:
+  AID hub_;
+};
+
+class FanInActor : public ActorBase {
+ public:
+  FanInActor(const std::string &nm, ActorThreadPool *pool) : ActorBase(nm, pool) {}
+  void set_leaves(const std::vector<AID> &leaves) { leaves_ = leaves; }
+  void Start(int rounds, Promise<int> *done) {
+    rounds_ = rounds;
+    done_ = done;
+    FanOut(0);
+  }
+  void Done(int round) {
+    if (++arrived_ < leaves_.size()) {
+      return;
+    }
+    arrived_ = 0;
+    if (round + 1 >= rounds_) {
+      done_->SetValue(round + 1);
+      return;
+    }
+    FanOut(round + 1);
+  }
+
+ private:
+  void FanOut(int round) {
+    for (auto &leaf : leaves_) {
+      Async(leaf, &FanOutLeafActor::Work, round);
+    }
+  }
+  std::vector<AID> leaves_;
+  size_t arrived_{0};
+  int rounds_{0};
+  Promise<int> *done_{nullptr};
+};
+
+void FanOutLeafActor::Work(int round) { Async(hub_, &FanInActor::Done, round); }
+
+// returns the number of messages handled per second
+double RunPingPong(ActorThreadPool *pool, size_t pairs, int count, std::vector<AID> *actors) {
+  std::vector<Promise<int>> promises(pairs);
+  std::vector<AID> pings;
+  for (size_t i = 0; i < pairs; i++) {
+    std::string suffix = std::to_string(i) + "_" + std::to_string(pool->work_stealing());
+    auto ping = std::make_shared<PingPongActor>("ping_" + suffix, pool);
+    auto pong = std::make_shared<PingPongActor>("pong_" + suffix, pool);
+    ping->set_peer(pong->GetAID());
+    pong->set_peer(ping->GetAID());
+    pings.emplace_back(Spawn(ping));
+    actors->emplace_back(pings.back());
+    actors->emplace_back(Spawn(pong));
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < pairs; i++) {
+    Async(pings[i], &PingPongActor::Ping, count, &promises[i]);
+  }
+  for (auto &promise : promises) {
+    (void)promise.GetFuture().Get();
+  }
+  std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(pairs) * (count + 1) / cost.count();
+}
+
+double RunFanOutFanIn(ActorThreadPool *pool, size_t hubs, size_t leaves, int rounds, std::vector<AID> *actors) {
+  std::vector<Promise<int>> promises(hubs);
+  std::vector<AID> hub_aids;
+  for (size_t i = 0; i < hubs; i++) {
+    std::string suffix = std::to_string(i) + "_" + std::to_string(pool->work_stealing());
+    auto hub = std::make_shared<FanInActor>("hub_" + suffix, pool);
+    std::vector<AID> leaf_aids;
+    for (size_t j = 0; j < leaves; j++) {
+      auto leaf = std::make_shared<FanOutLeafActor>("leaf_" + suffix + "_" + std::to_string(j), pool);
+      leaf->set_hub(hub->GetAID());
+      leaf_aids.emplace_back(Spawn(leaf));
+    }
+    hub->set_leaves(leaf_aids);
+    hub_aids.emplace_back(Spawn(hub));
+    actors->insert(actors->end(), leaf_aids.begin(), leaf_aids.end());
+    actors->emplace_back(hub_aids.back());
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < hubs; i++) {
+    Async(hub_aids[i], &FanInActor::Start, rounds, &promises[i]);
+  }
+  for (auto &promise : promises) {
+    (void)promise.GetFuture().Get();
+  }
+  std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(hubs) * rounds * leaves * 2 / cost.count();
+}
+
+// runs before the other tests since mindrt can not be used any more after Finalize
+TEST_F(LiteMindRtTest, ActorThreadPoolWorkStealingBenchmark) {
+  constexpr size_t kThreadNum = 8;
+  Initialize("", "", "", "", kThreadNum);
+  auto shared_pool = ActorThreadPool::CreateThreadPool(kThreadNum);
+  ASSERT_NE(shared_pool, nullptr);
+  shared_pool->SetWorkStealing(false);
+  auto stealing_pool = ActorThreadPool::CreateThreadPool(kThreadNum);
+  ASSERT_NE(stealing_pool, nullptr);
+  ASSERT_TRUE(stealing_pool->work_stealing());
+  std::vector<AID> actors;
+
+  constexpr size_t kPairs = 16;
+  constexpr int kPingCount = 20000;
+  auto shared_ping_pong = RunPingPong(shared_pool, kPairs, kPingCount, &actors);
+  auto stealing_ping_pong = RunPingPong(stealing_pool, kPairs, kPingCount, &actors);
+  MS_LOG(INFO) << "ping-pong msg/s, shared queue: " << shared_ping_pong << ", work stealing: " << stealing_ping_pong;
+
+  constexpr size_t kHubs = 4;
+  constexpr size_t kLeaves = 64;
+  constexpr int kRounds = 1000;
+  auto shared_fan = RunFanOutFanIn(shared_pool, kHubs, kLeaves, kRounds, &actors);
+  auto stealing_fan = RunFanOutFanIn(stealing_pool, kHubs, kLeaves, kRounds, &actors);
+  MS_LOG(INFO) << "fan-out/fan-in msg/s, shared queue: " << shared_fan << ", work stealing: " << stealing_fan;
+
+  for (auto &actor : actors) {
+    Terminate(actor);
+  }
+  delete shared_pool;
+  delete stealing_pool;
+}
+
+TEST_F(LiteMindRtTest, MPSCMailBoxTest) {
+  MPSCMailBox mailbox(64);
+  std::atomic_int notify_count(0);
+  mailbox.SetNotifyHook(std::make_unique<std::function<void()>>([&notify_count]() { notify_count++; }));
+  ASSERT_FALSE(mailbox.TakeAllMsgsEachTime());
+
+  constexpr int kProducerNum = 4;
+  constexpr int kMsgNum = 10000;
+  std::vector<std::thread> producers;
+  for (int i = 0; i < kProducerNum; i++) {
+    producers.emplace_back([&mailbox, i]() {
+      for (int j = 0; j < kMsgNum; j++) {
+        (void)mailbox.EnqueueMessage(std::make_unique<MessageBase>(std::to_string(i)));
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  // the first message notifies, the rest are taken by the consumer
+  ASSERT_EQ(notify_count, 1);
+
+  std::vector<int> received(kProducerNum, 0);
+  int turns = 1;
+  size_t total = 0;
+  while (total < kProducerNum * kMsgNum) {
+    auto msg = mailbox.GetMsg();
+    if (msg == nullptr) {
+      // yield after a full batch, the hook is invoked to reschedule
+      ASSERT_EQ(notify_count, ++turns);
+      continue;
+    }
+    received[std::stoi(msg->Name())]++;
+    total++;
+  }
+  ASSERT_EQ(mailbox.GetMsg(), nullptr);
+  for (auto count : received) {
+    ASSERT_EQ(count, kMsgNum);
+  }
+  // the mailbox is released, the next message notifies again
+  int notified = notify_count;
+  (void)mailbox.EnqueueMessage(std::make_unique<MessageBase>("0"));
+  ASSERT_EQ(notify_count, notified + 1);
+}
+
 TEST_F(LiteMindRtTest, ActorThreadPoolTest) {
   Initialize("", "", "", "", 40);
   auto pool = ActorThreadPool::CreateThreadPool(40);
@@ -0,0 +1,396 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <dirent.h>
+#endif
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "src/pack_weight_cache.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kModelSize = 1024;
+constexpr size_t kWeightOffset = 128;
+constexpr size_t kPackedSize = 256;
+constexpr auto kLayout = lite::PACK_LAYOUT_CONV;
+
+std::vector<char> CreateModelBuf(char value) {
+  std::vector<char> model_buf(kModelSize);
+  for (size_t i = 0; i < kModelSize; ++i) {
+    model_buf[i] = static_cast<char>(i + value);
+  }
+  return model_buf;
+}
+}  // namespace
+
+class PackWeightCacheTest : public mindspore::CommonTest {
+ public:
+  PackWeightCacheTest() = default;
+};
+
+/// Feature: pack weight cache.
+/// Description: two sessions load the same model into different buffers and get the packed weight.
+/// Expectation: the second session shares the weight packed by the first one, it is freed with the last session.
+TEST_F(PackWeightCacheTest, TestShareSameModel) {
+  auto cache = lite::PackWeightCache::GetInstance();
+  auto model_buf1 = CreateModelBuf(0);
+  auto model_buf2 = CreateModelBuf(0);
+  const void *weight1 = model_buf1.data() + kWeightOffset;
+  const void *weight2 = model_buf2.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(model_buf1.data(), kModelSize, {weight1}, ""), lite::RET_OK);
+  ASSERT_EQ(cache->RegisterModel(model_buf2.data(), kModelSize, {weight2}, ""), lite::RET_OK);
+
+  bool is_packed = true;
+  auto packed1 = cache->GetPackedTensor(weight1, kPackedSize, kLayout, &is_packed);
+  ASSERT_NE(packed1, nullptr);
+  ASSERT_FALSE(is_packed);
+  memset(packed1, 1, kPackedSize);
+  cache->MarkPacked(packed1);
+  auto packed2 = cache->GetPackedTensor(weight2, kPackedSize, kLayout, &is_packed);
+  ASSERT_EQ(packed1, packed2);
+  ASSERT_TRUE(is_packed);
+  ASSERT_EQ(cache->PackedTensorNum(), 1);
+
+  // The origin data which is not registered is not from the cache.
+  ASSERT_EQ(cache->GetPackedTensor(model_buf1.data(), kPackedSize, kLayout, &is_packed), nullptr);
+
+  cache->UnregisterModel(model_buf1.data());
+  ASSERT_TRUE(cache->Free(packed1));
+  ASSERT_EQ(cache->PackedTensorNum(), 1);
+  cache->UnregisterModel(model_buf2.data());
+  ASSERT_TRUE(cache->Free(packed2));
+  ASSERT_EQ(cache->PackedTensorNum(), 0);
+  ASSERT_FALSE(cache->Free(packed2));
+}
+
+/// Feature: pack weight cache.
+/// Description: two models with different content get the packed weight of the same offset.
+/// Expectation: the packed weights are not shared.
+TEST_F(PackWeightCacheTest, TestDifferentModel) {
+  auto cache = lite::PackWeightCache::GetInstance();
+  auto model_buf1 = CreateModelBuf(0);
+  auto model_buf2 = CreateModelBuf(1);
+  const void *weight1 = model_buf1.data() + kWeightOffset;
+  const void *weight2 = model_buf2.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(model_buf1.data(), kModelSize, {weight1}, ""), lite::RET_OK);
+  ASSERT_EQ(cache->RegisterModel(model_buf2.data(), kModelSize, {weight2}, ""), lite::RET_OK);
+  bool is_packed = true;
+  auto packed1 = cache->GetPackedTensor(weight1, kPackedSize, kLayout, &is_packed);
+  cache->MarkPacked(packed1);
+  auto packed2 = cache->GetPackedTensor(weight2, kPackedSize, kLayout, &is_packed);
+  ASSERT_NE(packed1, packed2);
+  ASSERT_FALSE(is_packed);
+  cache->MarkPacked(packed2);
+  cache->UnregisterModel(model_buf1.data());
+  cache->UnregisterModel(model_buf2.data());
+  ASSERT_TRUE(cache->Free(packed1));
+  ASSERT_TRUE(cache->Free(packed2));
+  ASSERT_EQ(cache->PackedTensorNum(), 0);
+}
+
+/// Feature: pack weight cache.
+/// Description: the same weight is packed into different layouts by different kernels.
+/// Expectation: the packed weights are not shared.
+TEST_F(PackWeightCacheTest, TestDifferentLayout) {
+  auto cache = lite::PackWeightCache::GetInstance();
+  auto model_buf = CreateModelBuf(5);
+  const void *weight = model_buf.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(model_buf.data(), kModelSize, {weight}, ""), lite::RET_OK);
+  bool is_packed = true;
+  auto packed1 = cache->GetPackedTensor(weight, kPackedSize, lite::PACK_LAYOUT_MATMUL_A, &is_packed);
+  ASSERT_NE(packed1, nullptr);
+  cache->MarkPacked(packed1);
+  auto packed2 = cache->GetPackedTensor(weight, kPackedSize, lite::PACK_LAYOUT_MATMUL_B, &is_packed);
+  ASSERT_NE(packed2, nullptr);
+  ASSERT_NE(packed1, packed2);
+  ASSERT_FALSE(is_packed);
+  cache->MarkPacked(packed2);
+  ASSERT_EQ(cache->PackedTensorNum(), 2);
+  cache->UnregisterModel(model_buf.data());
+  ASSERT_TRUE(cache->Free(packed1));
+  ASSERT_TRUE(cache->Free(packed2));
+  ASSERT_EQ(cache->PackedTensorNum(), 0);
+}
+
+/// Feature: pack weight cache.
+/// Description: get the weight which is being packed by another session, which never marks it packed.
+/// Expectation: nullptr is returned at once so that the caller packs its own copy, the weight is shared once packed.
+TEST_F(PackWeightCacheTest, TestNotWaitPacking) {
+  auto cache = lite::PackWeightCache::GetInstance();
+  auto model_buf1 = CreateModelBuf(6);
+  auto model_buf2 = CreateModelBuf(6);
+  const void *weight1 = model_buf1.data() + kWeightOffset;
+  const void *weight2 = model_buf2.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(model_buf1.data(), kModelSize, {weight1}, ""), lite::RET_OK);
+  ASSERT_EQ(cache->RegisterModel(model_buf2.data(), kModelSize, {weight2}, ""), lite::RET_OK);
+  bool is_packed = true;
+  auto packed1 = cache->GetPackedTensor(weight1, kPackedSize, kLayout, &is_packed);
+  ASSERT_NE(packed1, nullptr);
+  ASSERT_FALSE(is_packed);
+  ASSERT_EQ(cache->GetPackedTensor(weight2, kPackedSize, kLayout, &is_packed), nullptr);
+  cache->MarkPacked(packed1);
+  auto packed2 = cache->GetPackedTensor(weight2, kPackedSize, kLayout, &is_packed);
+  ASSERT_EQ(packed1, packed2);
+  ASSERT_TRUE(is_packed);
+  cache->UnregisterModel(model_buf1.data());
+  cache->UnregisterModel(model_buf2.data());
+  ASSERT_TRUE(cache->Free(packed1));
+  ASSERT_TRUE(cache->Free(packed2));
+  ASSERT_EQ(cache->PackedTensorNum(), 0);
+}
+
+/// Feature: pack weight cache.
+/// Description: the sessions get the same packed weight concurrently.
+/// Expectation: the weight is packed once, the sessions sharing it see the packed data and the others pack their own.
+TEST_F(PackWeightCacheTest, TestConcurrentGet) {
+  auto cache = lite::PackWeightCache::GetInstance();
+  constexpr size_t kSessionNum = 8;
+  std::vector<std::vector<char>> model_bufs;
+  for (size_t i = 0; i < kSessionNum; ++i) {
+    model_bufs.emplace_back(CreateModelBuf(0));
+    const void *weight = model_bufs[i].data() + kWeightOffset;
+    ASSERT_EQ(cache->RegisterModel(model_bufs[i].data(), kModelSize, {weight}, ""), lite::RET_OK);
+  }
+  std::vector<void *> packed(kSessionNum, nullptr);
+  std::vector<int> pack_count(kSessionNum, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kSessionNum; ++i) {
+    threads.emplace_back([&, i]() {
+      bool is_packed = false;
+      packed[i] = cache->GetPackedTensor(model_bufs[i].data() + kWeightOffset, kPackedSize, kLayout, &is_packed);
+      if (packed[i] != nullptr && !is_packed) {
+        memset(packed[i], 1, kPackedSize);
+        pack_count[i] = 1;
+        cache->MarkPacked(packed[i]);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  void *shared = nullptr;
+  int total_pack_count = 0;
+  for (size_t i = 0; i < kSessionNum; ++i) {
+    total_pack_count += pack_count[i];
+    if (packed[i] == nullptr) {
+      continue;
+    }
+    if (shared == nullptr) {
+      shared = packed[i];
+    }
+    ASSERT_EQ(packed[i], shared);
+    ASSERT_EQ(static_cast<char *>(packed[i])[kPackedSize - 1], 1);
+  }
+  ASSERT_NE(shared, nullptr);
+  ASSERT_EQ(total_pack_count, 1);
+  bool is_packed = false;
+  ASSERT_EQ(cache->GetPackedTensor(model_bufs[0].data() + kWeightOffset, kPackedSize, kLayout, &is_packed), shared);
+  ASSERT_TRUE(is_packed);
+  ASSERT_TRUE(cache->Free(shared));
+  for (size_t i = 0; i < kSessionNum; ++i) {
+    cache->UnregisterModel(model_bufs[i].data());
+    if (packed[i] != nullptr) {
+      ASSERT_TRUE(cache->Free(packed[i]));
+    }
+  }
+  ASSERT_EQ(cache->PackedTensorNum(), 0);
+}
+
+#ifndef _WIN32
+/// Feature: pack weight cache.
+/// Description: pack the weight with the cache dir, release it and get it again as a new process does.
+/// Expectation: the packed weight is loaded from the file without packing again.
+TEST_F(PackWeightCacheTest, TestCacheDir) {
+  auto cache = lite::PackWeightCache::GetInstance();
+  const std::string cache_dir = "./pack_weight_cache_test";
+  (void)mkdir(cache_dir.c_str(), S_IRWXU);
+  auto model_buf = CreateModelBuf(2);
+  const void *weight = model_buf.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(model_buf.data(), kModelSize, {weight}, cache_dir), lite::RET_OK);
+  bool is_packed = true;
+  auto packed = cache->GetPackedTensor(weight, kPackedSize, kLayout, &is_packed);
+  ASSERT_NE(packed, nullptr);
+  ASSERT_FALSE(is_packed);
+  memset(packed, 3, kPackedSize);
+  cache->MarkPacked(packed);
+  ASSERT_TRUE(cache->Free(packed));
+  ASSERT_EQ(cache->PackedTensorNum(), 0);
+
+  packed = cache->GetPackedTensor(weight, kPackedSize, kLayout, &is_packed);
+  ASSERT_NE(packed, nullptr);
+  ASSERT_TRUE(is_packed);
+  ASSERT_EQ(static_cast<char *>(packed)[0], 3);
+  ASSERT_TRUE(cache->Free(packed));
+  cache->UnregisterModel(model_buf.data());
+
+  auto dir = opendir(cache_dir.c_str());
+  ASSERT_NE(dir, nullptr);
+  size_t file_num = 0;
+  for (auto entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name != "." && name != "..") {
+      ++file_num;
+      (void)remove((cache_dir + "/" + name).c_str());
+    }
+  }
+  closedir(dir);
+  (void)rmdir(cache_dir.c_str());
+  ASSERT_EQ(file_num, 1);
+}
+
+/// Feature: pack weight cache.
+/// Description: save the packed weights to the packed weight file, and load the model again with the file.
+/// Expectation: the packed weight is mapped from the file, and the file is not used by the different model.
+TEST_F(PackWeightCacheTest, TestPackedWeightFile) {
+  auto cache = lite::PackWeightCache::GetInstance();
+  const std::string packed_file = "./pack_weight_cache_test.packed";
+  (void)remove(packed_file.c_str());
+  auto model_buf = CreateModelBuf(3);
+  const void *weight = model_buf.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(model_buf.data(), kModelSize, {weight}, "", packed_file), lite::RET_OK);
+  bool is_packed = true;
+  auto packed = cache->GetPackedTensor(weight, kPackedSize, kLayout, &is_packed);
+  ASSERT_NE(packed, nullptr);
+  ASSERT_FALSE(is_packed);
+  memset(packed, 4, kPackedSize);
+  cache->MarkPacked(packed);
+  ASSERT_EQ(cache->SavePackedFile(model_buf.data()), lite::RET_OK);
+  ASSERT_TRUE(cache->Free(packed));
+  cache->UnregisterModel(model_buf.data());
+
+  auto new_model_buf = CreateModelBuf(3);
+  weight = new_model_buf.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(new_model_buf.data(), kModelSize, {weight}, "", packed_file), lite::RET_OK);
+  packed = cache->GetPackedTensor(weight, kPackedSize, kLayout, &is_packed);
+  ASSERT_NE(packed, nullptr);
+  ASSERT_TRUE(is_packed);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(packed) % 64, 0);
+  ASSERT_EQ(static_cast<char *>(packed)[kPackedSize - 1], 4);
+  // The packed weight is still valid after the model is released.
+  cache->UnregisterModel(new_model_buf.data());
+  ASSERT_EQ(static_cast<char *>(packed)[0], 4);
+  ASSERT_TRUE(cache->Free(packed));
+
+  auto other_model_buf = CreateModelBuf(4);
+  weight = other_model_buf.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(other_model_buf.data(), kModelSize, {weight}, "", packed_file), lite::RET_OK);
+  packed = cache->GetPackedTensor(weight, kPackedSize, kLayout, &is_packed);
+  ASSERT_NE(packed, nullptr);
+  ASSERT_FALSE(is_packed);
+  cache->MarkPacked(packed);
+  ASSERT_TRUE(cache->Free(packed));
+  cache->UnregisterModel(other_model_buf.data());
+  (void)remove(packed_file.c_str());
+}
+
+/// Feature: pack weight cache.
+/// Description: pack one more weight after the packed weight file is loaded, and load the model again.
+/// Expectation: the file is saved again with both the loaded weight and the new one.
+TEST_F(PackWeightCacheTest, TestPackedWeightFileResave) {
+  auto cache = lite::PackWeightCache::GetInstance();
+  const std::string packed_file = "./pack_weight_cache_resave_test.packed";
+  (void)remove(packed_file.c_str());
+  auto model_buf = CreateModelBuf(7);
+  const void *weight = model_buf.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(model_buf.data(), kModelSize, {weight}, "", packed_file), lite::RET_OK);
+  bool is_packed = true;
+  auto packed = cache->GetPackedTensor(weight, kPackedSize, lite::PACK_LAYOUT_MATMUL_A, &is_packed);
+  ASSERT_NE(packed, nullptr);
+  memset(packed, 5, kPackedSize);
+  cache->MarkPacked(packed);
+  ASSERT_EQ(cache->SavePackedFile(model_buf.data()), lite::RET_OK);
+  ASSERT_TRUE(cache->Free(packed));
+  cache->UnregisterModel(model_buf.data());
+
+  auto new_model_buf = CreateModelBuf(7);
+  weight = new_model_buf.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(new_model_buf.data(), kModelSize, {weight}, "", packed_file), lite::RET_OK);
+  auto packed_b = cache->GetPackedTensor(weight, kPackedSize, lite::PACK_LAYOUT_MATMUL_B, &is_packed);
+  ASSERT_NE(packed_b, nullptr);
+  ASSERT_FALSE(is_packed);
+  memset(packed_b, 6, kPackedSize);
+  cache->MarkPacked(packed_b);
+  ASSERT_EQ(cache->SavePackedFile(new_model_buf.data()), lite::RET_OK);
+  ASSERT_TRUE(cache->Free(packed_b));
+  cache->UnregisterModel(new_model_buf.data());
+
+  auto last_model_buf = CreateModelBuf(7);
+  weight = last_model_buf.data() + kWeightOffset;
+  ASSERT_EQ(cache->RegisterModel(last_model_buf.data(), kModelSize, {weight}, "", packed_file), lite::RET_OK);
+  auto packed_a = cache->GetPackedTensor(weight, kPackedSize, lite::PACK_LAYOUT_MATMUL_A, &is_packed);
+  ASSERT_NE(packed_a, nullptr);
+  ASSERT_TRUE(is_packed);
+  ASSERT_EQ(static_cast<char *>(packed_a)[0], 5);
+  packed_b = cache->GetPackedTensor(weight, kPackedSize, lite::PACK_LAYOUT_MATMUL_B, &is_packed);
+  ASSERT_NE(packed_b, nullptr);
+  ASSERT_TRUE(is_packed);
+  ASSERT_EQ(static_cast<char *>(packed_b)[kPackedSize - 1], 6);
+  ASSERT_TRUE(cache->Free(packed_a));
+  ASSERT_TRUE(cache->Free(packed_b));
+  cache->UnregisterModel(last_model_buf.data());
+  ASSERT_EQ(cache->PackedTensorNum(), 0);
+  (void)remove(packed_file.c_str());
+}
+
+/// Feature: pack weight cache.
+/// Description: load the packed weight file saved for another instruction set or of another format version.
+/// Expectation: the file is not used and the weight is packed again.
+TEST_F(PackWeightCacheTest, TestPackedWeightFileMismatch) {
+  auto cache = lite::PackWeightCache::GetInstance();
+  const std::string packed_file = "./pack_weight_cache_mismatch_test.packed";
+  // The offsets of the version and the instruction set in the file header.
+  constexpr std::streamoff kVersionOffset = 8;
+  constexpr std::streamoff kIsaOffset = 16;
+  for (auto field_offset : {kVersionOffset, kIsaOffset}) {
+    (void)remove(packed_file.c_str());
+    auto model_buf = CreateModelBuf(8);
+    const void *weight = model_buf.data() + kWeightOffset;
+    ASSERT_EQ(cache->RegisterModel(model_buf.data(), kModelSize, {weight}, "", packed_file), lite::RET_OK);
+    bool is_packed = true;
+    auto packed = cache->GetPackedTensor(weight, kPackedSize, kLayout, &is_packed);
+    ASSERT_NE(packed, nullptr);
+    cache->MarkPacked(packed);
+    ASSERT_EQ(cache->SavePackedFile(model_buf.data()), lite::RET_OK);
+    ASSERT_TRUE(cache->Free(packed));
+    cache->UnregisterModel(model_buf.data());
+    {
+      std::fstream fs(packed_file, std::ios::in | std::ios::out | std::ios::binary);
+      ASSERT_TRUE(fs.is_open());
+      (void)fs.seekp(field_offset);
+      (void)fs.put('X');
+    }
+
+    auto new_model_buf = CreateModelBuf(8);
+    weight = new_model_buf.data() + kWeightOffset;
+    ASSERT_EQ(cache->RegisterModel(new_model_buf.data(), kModelSize, {weight}, "", packed_file), lite::RET_OK);
+    packed = cache->GetPackedTensor(weight, kPackedSize, kLayout, &is_packed);
+    ASSERT_NE(packed, nullptr);
+    ASSERT_FALSE(is_packed);
+    cache->MarkPacked(packed);
+    ASSERT_TRUE(cache->Free(packed));
+    cache->UnregisterModel(new_model_buf.data());
+  }
+  (void)remove(packed_file.c_str());
+}
+#endif
+}  // namespace mindspore
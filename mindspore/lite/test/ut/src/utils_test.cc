@@ -15,7 +15,12 @@
  */
 
 #include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 #include "schema/inner/model_generated.h"
 #include "mindspore/lite/include/model.h"
 #include "common/common_test.h"
@@ -25,6 +30,11 @@
 #include "src/common/log_adapter.h"
 #include "mindspore/lite/src/kernel_exec.h"
 #include "mindspore/lite/src/kernel_exec_util.h"
+#include "mindspore/lite/src/common/file_utils.h"
+#include "mindspore/lite/src/common/common.h"
+#include "mindspore/lite/src/lite_model.h"
+#include "mindspore/lite/src/lite_session.h"
+#include "include/version.h"
 
 namespace mindspore {
 class UtilsTest : public mindspore::CommonTest {
@@ -66,4 +76,127 @@ TEST_F(UtilsTest, TestSubgraph) {
   auto output_tensors = kernel::KernelExecUtil::SubgraphOutputTensors(kernels);
   ASSERT_EQ(output_tensors.size(), 1);
 }
+
+#ifndef _WIN32
+TEST_F(UtilsTest, TestMapFile) {
+  const std::string file_path = "./map_file_test.bin";
+  const std::string content = "mindspore lite map file";
+  {
+    std::ofstream ofs(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+  size_t size = 0;
+  auto buf = lite::MapFile(file_path.c_str(), &size);
+  ASSERT_NE(buf, nullptr);
+  ASSERT_EQ(size, content.size());
+  ASSERT_EQ(memcmp(buf, content.data(), size), 0);
+  // The mapping is private, writing the buffer does not change the file.
+  buf[0] = 'M';
+  size_t read_size = 0;
+  auto read_buf = lite::ReadFile(file_path.c_str(), &read_size);
+  ASSERT_NE(read_buf, nullptr);
+  ASSERT_EQ(read_buf[0], 'm');
+  delete[] read_buf;
+  lite::UnmapFile(buf, size);
+  ASSERT_EQ(lite::MapFile("./not_exist_map_file.bin", &size), nullptr);
+  (void)remove(file_path.c_str());
+}
+
+class MmapTestSession : public lite::LiteSession {
+ public:
+  lite::LiteModel *model() const { return reinterpret_cast<lite::LiteModel *>(model_); }
+};
+
+TEST_F(UtilsTest, TestLoadModelAndCompileByMmap) {
+  constexpr int kElementNum = 8;
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  meta_graph->version = lite::Version();
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_AddFusion;
+  node->primitive->value.value = new schema::AddFusionT;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input = std::make_unique<schema::TensorT>();
+  input->nodeType = lite::NodeType_Parameter;
+  input->format = schema::Format_NHWC;
+  input->dataType = TypeId::kNumberTypeFloat32;
+  input->dims = {1, kElementNum};
+  input->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input));
+
+  std::vector<float> weight_data(kElementNum);
+  for (int i = 0; i < kElementNum; i++) {
+    weight_data[i] = static_cast<float>(i);
+  }
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = lite::NodeType_ValueNode;
+  weight->format = schema::Format_NHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {1, kElementNum};
+  weight->data.resize(sizeof(float) * kElementNum);
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  weight->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = lite::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  schema::FinishMetaGraphBuffer(builder, offset);
+  const std::string model_path = "./mmap_model_test.ms";
+  {
+    std::ofstream ofs(model_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs.write(reinterpret_cast<const char *>(builder.GetBufferPointer()), builder.GetSize());
+  }
+
+  // The model buffer is mapped only if [model_file] mmap=true, the results are the same either way.
+  for (bool mmap : {true, false}) {
+    std::map<std::string, std::map<std::string, std::string>> config_info = {
+      {lite::kModelFileSection, {{lite::kModelFileMmap, mmap ? "true" : "false"}}}};
+    auto context = new lite::InnerContext;
+    lite::DeviceContext device_ctx = {lite::DT_CPU, {false, lite::NO_BIND}};
+    context->device_list_.push_back(device_ctx);
+    context->thread_num_ = 1;
+    auto session = std::make_shared<MmapTestSession>();
+    ASSERT_EQ(session->Init(context), lite::RET_OK);
+    session->SetConfigInfo(&config_info);
+    ASSERT_EQ(session->LoadModelAndCompileByPath(model_path, mindspore::ModelType::kMindIR_Lite), lite::RET_OK);
+    ASSERT_NE(session->model(), nullptr);
+    ASSERT_EQ(session->model()->model_buf_by_mmap(), mmap);
+
+    auto inputs = session->GetInputs();
+    ASSERT_EQ(inputs.size(), 1);
+    auto in_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+    ASSERT_NE(in_data, nullptr);
+    for (int i = 0; i < kElementNum; i++) {
+      in_data[i] = 1.0f;
+    }
+    ASSERT_EQ(session->RunGraph(), lite::RET_OK);
+    auto outputs = session->GetOutputs();
+    ASSERT_EQ(outputs.size(), 1);
+    auto out_tensor = outputs.begin()->second;
+    ASSERT_EQ(out_tensor->ElementsNum(), kElementNum);
+    auto out_data = reinterpret_cast<float *>(out_tensor->MutableData());
+    for (int i = 0; i < kElementNum; i++) {
+      ASSERT_FLOAT_EQ(out_data[i], weight_data[i] + 1.0f);
+    }
+  }
+  (void)remove(model_path.c_str());
+}
+#endif
 }  // namespace mindspore
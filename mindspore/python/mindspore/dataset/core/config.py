@@ -42,9 +42,17 @@ __all__ = ['set_sending_batches', 'load', '_init_device_info',
            'set_enable_shared_mem', 'get_enable_shared_mem',
            'set_enable_autotune', 'get_enable_autotune',
            'set_autotune_interval', 'get_autotune_interval',
+           'set_autotune_cpu_budget', 'get_autotune_cpu_budget',
            'set_auto_offload', 'get_auto_offload',
            'set_enable_watchdog', 'get_enable_watchdog',
-           'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval']
+           'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval',
+           'set_map_batch_size', 'get_map_batch_size',
+           'set_enable_tfrecord_index', 'get_enable_tfrecord_index',
+           'set_shuffle_num_shards', 'get_shuffle_num_shards',
+           'set_enable_jpeg_dct_scaling', 'get_enable_jpeg_dct_scaling',
+           'set_mindrecord_read_ahead_threads', 'get_mindrecord_read_ahead_threads',
+           'set_mindrecord_read_ahead_size', 'get_mindrecord_read_ahead_size',
+           'set_enable_lock_free_connector', 'get_enable_lock_free_connector']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
@@ -469,6 +477,11 @@ def set_enable_autotune(enable, filepath_prefix=None):
     Note:
         - When `enable` is False, `json_filepath` will be ignored.
         - The JSON file can be loaded by API `mindspore.dataset.deserialize` to build a tuned pipeline.
+        - Each change made by AutoTune is kept only if the throughput of the data pipeline measured afterwards
+          is better, otherwise it is reverted. Besides adding workers, AutoTune may also remove workers from an
+          operation whose workers are mostly idle when the data pipeline is not the bottleneck, or when the CPU
+          usage exceeds the budget set by `mindspore.dataset.config.set_autotune_cpu_budget` . Hence the tuned
+          `num_parallel_workers` can be smaller than the one set by the user.
 
     An example of the generated JSON file is as follows. "remark" file will conclude that if the dataset has been
     tuned or not. "summary" filed will show the tuned configuration of dataset pipeline. Users can modify scripts
@@ -599,6 +612,45 @@ def get_autotune_interval():
     return _config.get_autotune_interval()
 
 
+def set_autotune_cpu_budget(cpu_budget):
+    """
+    Set the number of CPU cores the data pipeline can use while AutoTune tunes it. AutoTune only adds workers or
+    enlarges the prefetch size if the measured CPU usage of the pipeline stays within the budget, and removes workers
+    from the least busy operations when the budget is exceeded. It is useful when several jobs share the host.
+
+    Args:
+        cpu_budget (int): The number of CPU cores the data pipeline can use. System default: 0, which means all the
+          CPU cores of the host.
+
+    Raises:
+        TypeError: If `cpu_budget` is not of type int.
+        ValueError: If `cpu_budget` < 0 or `cpu_budget` > INT32_MAX(2147483647).
+
+    Examples:
+        >>> # Let the data pipeline use at most 16 CPU cores.
+        >>> ds.config.set_autotune_cpu_budget(16)
+    """
+    if not isinstance(cpu_budget, int) or isinstance(cpu_budget, bool):
+        raise TypeError("cpu_budget must be of type int.")
+    if cpu_budget < 0 or cpu_budget > INT32_MAX:
+        raise ValueError("CPU budget given is not within the required range [0, INT32_MAX(2147483647)].")
+    _config.set_autotune_cpu_budget(cpu_budget)
+
+
+def get_autotune_cpu_budget():
+    """
+    Get the number of CPU cores the data pipeline can use while AutoTune tunes it.
+
+    Returns:
+        int, the number of CPU cores, 0 means all the CPU cores of the host (default is 0).
+
+    Examples:
+        >>> # Get the global configuration of the AutoTune CPU budget.
+        >>> cpu_budget = ds.config.get_autotune_cpu_budget()
+    """
+    return _config.get_autotune_cpu_budget()
+
+
 def get_enable_shared_mem():
     """
     Get the default state of shared mem enabled variable.
@@ -780,3 +832,279 @@ def get_multiprocessing_timeout_interval():
         >>> multiprocessing_timeout_interval = ds.config.get_multiprocessing_timeout_interval()
     """
     return _config.get_multiprocessing_timeout_interval()
+
+
+def set_map_batch_size(size):
+    """
+    Set the default number of consecutive rows sent to a worker of map operation at once. The operations supporting
+    batch, such as Normalize, process all the rows in one call, which reduces the overhead of processing the rows one
+    by one. The order of the rows is not changed.
+
+    Args:
+        size (int): The number of rows sent to a map worker at once. System default: 1, which means the rows are
+          sent one by one.
+
+    Raises:
+        TypeError: If `size` is not of type int.
+        ValueError: If `size` <= 0 or `size` > INT32_MAX(2147483647).
+
+    Examples:
+        >>> # Send 32 rows to a map worker at once.
+        >>> ds.config.set_map_batch_size(32)
+    """
+    if not isinstance(size, int) or isinstance(size, bool):
+        raise TypeError("size isn't of type int.")
+    if size <= 0 or size > INT32_MAX:
+        raise ValueError("Map batch size given is not within the required range (0, INT32_MAX(2147483647)].")
+    _config.set_map_batch_size(size)
+
+
+def get_map_batch_size():
+    """
+    Get the global configuration of the number of consecutive rows sent to a worker of map operation at once.
+
+    Returns:
+        int, the number of rows sent to a map worker at once (default is 1).
+
+    Examples:
+        >>> # Get the global configuration of map batch size.
+        >>> # If set_map_batch_size() is never called before, the default value(1) will be returned.
+        >>> map_batch_size = ds.config.get_map_batch_size()
+    """
+    return _config.get_map_batch_size()
+
+
+def set_enable_tfrecord_index(enable):
+    """
+    Set the default state of saving the offset index of TFRecord files. If enabled, the offsets of the records are
+    saved to a sidecar file named "<TFRecord file>.msindex" next to the TFRecord file when it is scanned for the first
+    time. Later pipelines load the index instead of scanning the file again to count and shard the rows. The index is
+    ignored if the size or the modification time of the TFRecord file is changed.
+
+    Args:
+        enable (bool): Whether to save the offset index of TFRecord files. System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> # Save the offset index of TFRecord files to speed up the startup of later pipelines.
+        >>> ds.config.set_enable_tfrecord_index(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_enable_tfrecord_index(enable)
+
+
+def get_enable_tfrecord_index():
+    """
+    Get the state of saving the offset index of TFRecord files. This is the DEFAULT state, which is False.
+
+    Returns:
+        bool, the state of saving the offset index of TFRecord files.
+
+    Examples:
+        >>> # Get the flag of saving the offset index of TFRecord files.
+        >>> enable_tfrecord_index = ds.config.get_enable_tfrecord_index()
+    """
+    return _config.get_enable_tfrecord_index()
+
+
+def set_shuffle_num_shards(num_shards):
+    """
+    Set the default number of shards the buffer of shuffle operation is split into. When it is greater than 1, each
+    shard is shuffled by its own thread, while reading the input rows and sending the output rows are done by two
+    other threads. The rows are spread to the shards in a random order, and the output order only depends on the
+    seed, so the result is still reproducible with `mindspore.dataset.config.set_seed()`.
+
+    Args:
+        num_shards (int): The number of shards of the shuffle buffer. System default: 1, which means the rows are
+          shuffled with a single buffer.
+
+    Raises:
+        TypeError: If `num_shards` is not of type int.
+        ValueError: If `num_shards` <= 0 or `num_shards` > INT32_MAX(2147483647).
+
+    Examples:
+        >>> # Shuffle the rows with 4 shards.
+        >>> ds.config.set_shuffle_num_shards(4)
+    """
+    if not isinstance(num_shards, int) or isinstance(num_shards, bool):
+        raise TypeError("num_shards isn't of type int.")
+    if num_shards <= 0 or num_shards > INT32_MAX:
+        raise ValueError("Shuffle num_shards given is not within the required range (0, INT32_MAX(2147483647)].")
+    _config.set_shuffle_num_shards(num_shards)
+
+
+def get_shuffle_num_shards():
+    """
+    Get the global configuration of the number of shards the buffer of shuffle operation is split into.
+
+    Returns:
+        int, the number of shards of the shuffle buffer (default is 1).
+
+    Examples:
+        >>> # Get the global configuration of shuffle num_shards.
+        >>> # If set_shuffle_num_shards() is never called before, the default value(1) will be returned.
+        >>> shuffle_num_shards = ds.config.get_shuffle_num_shards()
+    """
+    return _config.get_shuffle_num_shards()
+
+
+def set_enable_jpeg_dct_scaling(enable):
+    """
+    Set the default state of DCT downscaling in RandomCropDecodeResize and DecodeResize. If enabled, a JPEG image or
+    crop which is at least twice the target size is decoded at 1/2, 1/4 or 1/8 of its size by libjpeg, and then
+    resized to the target size, and Decode followed by Resize is fused into DecodeResize when the dataset
+    optimization is on. It saves most of the decoding work for small targets, but the output is close to and not
+    exactly the same as decoding at full size.
+
+    Args:
+        enable (bool): Whether to decode JPEG images with DCT downscaling in RandomCropDecodeResize and DecodeResize.
+            System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> # Decode JPEG crops close to the target size in RandomCropDecodeResize.
+        >>> ds.config.set_enable_jpeg_dct_scaling(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_enable_jpeg_dct_scaling(enable)
+
+
+def get_enable_jpeg_dct_scaling():
+    """
+    Get the state of DCT downscaling in RandomCropDecodeResize and DecodeResize. This is the DEFAULT state, which is
+    False.
+
+    Returns:
+        bool, the state of DCT downscaling in RandomCropDecodeResize and DecodeResize.
+
+    Examples:
+        >>> # Get the flag of DCT downscaling in RandomCropDecodeResize.
+        >>> enable_jpeg_dct_scaling = ds.config.get_enable_jpeg_dct_scaling()
+    """
+    return _config.get_enable_jpeg_dct_scaling()
+
+
+def set_mindrecord_read_ahead_threads(num_threads):
+    """
+    Set the default number of threads reading the samples of MindDataset ahead. If it is greater than 0, the threads
+    read the blobs of the samples in the order of the sampler before the workers need them. The reads of samples close
+    to each other in the file are merged, and several reads are issued at once, which hides the latency of network
+    filesystems. The samples read ahead are kept in memory up to the size set by
+    `mindspore.dataset.config.set_mindrecord_read_ahead_size()`. It does not work with the lazy load mode of
+    MindDataset.
+
+    Args:
+        num_threads (int): The number of threads reading the samples ahead. System default: 0, which means the
+            samples are read by the workers of MindDataset.
+
+    Raises:
+        TypeError: If `num_threads` is not of type int.
+        ValueError: If `num_threads` < 0 or `num_threads` > INT32_MAX(2147483647).
+
+    Examples:
+        >>> # Read the samples of MindDataset ahead with 8 threads.
+        >>> ds.config.set_mindrecord_read_ahead_threads(8)
+    """
+    if not isinstance(num_threads, int) or isinstance(num_threads, bool):
+        raise TypeError("num_threads isn't of type int.")
+    if num_threads < 0 or num_threads > INT32_MAX:
+        raise ValueError("MindRecord read ahead num_threads given is not within the required range "
+                         "[0, INT32_MAX(2147483647)].")
+    _config.set_mindrecord_read_ahead_threads(num_threads)
+
+
+def get_mindrecord_read_ahead_threads():
+    """
+    Get the global configuration of the number of threads reading the samples of MindDataset ahead.
+
+    Returns:
+        int, the number of threads reading the samples ahead (default is 0).
+
+    Examples:
+        >>> # Get the global configuration of the number of threads reading the samples of MindDataset ahead.
+        >>> # If set_mindrecord_read_ahead_threads() is never called before, the default value(0) will be returned.
+        >>> num_threads = ds.config.get_mindrecord_read_ahead_threads()
+    """
+    return _config.get_mindrecord_read_ahead_threads()
+
+
+def set_mindrecord_read_ahead_size(size):
+    """
+    Set the default max size in MB of the samples of MindDataset which are read ahead and not taken by the workers yet.
+    The threads reading ahead wait when the size is exceeded.
+
+    Args:
+        size (int): The max size in MB of the samples read ahead. System default: 256.
+
+    Raises:
+        TypeError: If `size` is not of type int.
+        ValueError: If `size` <= 0 or `size` > INT32_MAX(2147483647).
+
+    Examples:
+        >>> # Keep at most 1024MB of samples read ahead in memory.
+        >>> ds.config.set_mindrecord_read_ahead_size(1024)
+    """
+    if not isinstance(size, int) or isinstance(size, bool):
+        raise TypeError("size isn't of type int.")
+    if size <= 0 or size > INT32_MAX:
+        raise ValueError("MindRecord read ahead size given is not within the required range "
+                         "(0, INT32_MAX(2147483647)].")
+    _config.set_mindrecord_read_ahead_size(size)
+
+
+def get_mindrecord_read_ahead_size():
+    """
+    Get the global configuration of the max size in MB of the samples of MindDataset read ahead.
+
+    Returns:
+        int, the max size in MB of the samples read ahead (default is 256).
+
+    Examples:
+        >>> # Get the global configuration of the max size of the samples of MindDataset read ahead.
+        >>> # If set_mindrecord_read_ahead_size() is never called before, the default value(256) will be returned.
+        >>> size = ds.config.get_mindrecord_read_ahead_size()
+    """
+    return _config.get_mindrecord_read_ahead_size()
+
+
+def set_enable_lock_free_connector(enable):
+    """
+    Set the default state of the lock free connector. If enabled, the workers of the non-mappable source datasets,
+    such as TFRecordDataset, TextFileDataset, CSVDataset and CLUEDataset, pass the rows to the dataset through lock free
+    ring buffers instead of mutex protected queues. The order of the rows is the same. A blocked thread polls with a
+    short sleep instead of waiting, which saves the lock handoff when the rows are small and produced fast.
+
+    Args:
+        enable (bool): Whether to pass the rows of the non-mappable source datasets with the lock free connector.
+            System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> # Pass the rows of TFRecordDataset with the lock free connector.
+        >>> ds.config.set_enable_lock_free_connector(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_enable_lock_free_connector(enable)
+
+
+def get_enable_lock_free_connector():
+    """
+    Get the state of the lock free connector. This is the DEFAULT state, which is False.
+
+    Returns:
+        bool, the state of the lock free connector.
+
+    Examples:
+        >>> # Get the flag of the lock free connector.
+        >>> enable_lock_free_connector = ds.config.get_enable_lock_free_connector()
+    """
+    return _config.get_enable_lock_free_connector()
@@ -1794,7 +1794,7 @@ def check_gnn_graphdata(method):
     @wraps(method)
     def new_method(self, *args, **kwargs):
         [dataset_file, num_parallel_workers, working_mode, hostname,
-         port, num_client, auto_shutdown], _ = parse_user_args(method, *args, **kwargs)
+         port, num_client, auto_shutdown, storage_format], _ = parse_user_args(method, *args, **kwargs)
         check_file(dataset_file)
         if num_parallel_workers is not None:
             check_num_parallel_workers(num_parallel_workers)
@@ -1809,6 +1809,9 @@ def check_gnn_graphdata(method):
         type_check(num_client, (int,), "num_client")
         check_value(num_client, (1, 255), "num_client")
         type_check(auto_shutdown, (bool,), "auto_shutdown")
+        type_check(storage_format, (str,), "storage_format")
+        if storage_format not in {'default', 'csr'}:
+            raise ValueError("Invalid storage format, please enter 'default' or 'csr'.")
         return method(self, *args, **kwargs)
 
     return new_method
@@ -1944,6 +1947,19 @@ def check_gnn_random_walk(method):
     return new_method
 
 
+def check_gnn_save_snapshot(method):
+    """A wrapper that wraps a parameter checker around the GNN `save_snapshot` function."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        [snapshot_file], _ = parse_user_args(method, *args, **kwargs)
+        type_check(snapshot_file, (str,), "snapshot_file")
+
+        return method(self, *args, **kwargs)
+
+    return new_method
+
+
 def check_aligned_list(param, param_name, member_type):
     """Check whether the structure of each member of the list is the same."""
 
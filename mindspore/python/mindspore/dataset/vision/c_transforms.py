@@ -599,6 +599,58 @@ class Decode(ImageTensorOperation):
         return cde.DecodeOperation(self.rgb)
 
 
+class DecodeResize(ImageTensorOperation):
+    """
+    Decode the input image and resize it to the given size with a given interpolation mode. If
+    :func:`mindspore.dataset.config.set_enable_jpeg_dct_scaling` is enabled, a JPEG image is downscaled by the decoder
+    while it is decoded, which is much faster than Decode followed by Resize when the image is a lot larger than the
+    output size. Otherwise the output is the same as Decode followed by Resize.
+
+    Args:
+        size (Union[int, Sequence[int]]): The output size of the resized image. The size value(s) must be positive.
+            If size is an integer, smaller edge of the image will be resized to this value with
+            the same image aspect ratio.
+            If size is a sequence of length 2, it should be (height, width).
+        interpolation (Inter, optional): Image interpolation mode (default=Inter.LINEAR).
+            It can be any of [Inter.LINEAR, Inter.NEAREST, Inter.BICUBIC, Inter.AREA, Inter.PILCUBIC].
+
+            - Inter.LINEAR, means interpolation method is bilinear interpolation.
+
+            - Inter.NEAREST, means interpolation method is nearest-neighbor interpolation.
+
+            - Inter.BICUBIC, means interpolation method is bicubic interpolation.
+
+            - Inter.AREA, means interpolation method is pixel area interpolation.
+
+            - Inter.PILCUBIC, means interpolation method is bicubic interpolation like implemented in pillow.
+
+    Raises:
+        TypeError: If `size` is not of type int or Sequence[int].
+        TypeError: If `interpolation` is not of type :class:`mindspore.dataset.vision.Inter`.
+        ValueError: If `size` is not positive.
+        RuntimeError: If given tensor is not a 1D sequence.
+
+    Supported Platforms:
+        ``CPU``
+
+    Examples:
+        >>> from mindspore.dataset.vision import Inter
+        >>> decode_resize_op = c_vision.DecodeResize([224, 224], Inter.BICUBIC)
+        >>> image_folder_dataset = image_folder_dataset.map(operations=[decode_resize_op],
+        ...                                                 input_columns=["image"])
+    """
+
+    @check_resize_interpolation
+    def __init__(self, size, interpolation=Inter.LINEAR):
+        if isinstance(size, int):
+            size = (size,)
+        self.size = size
+        self.interpolation = interpolation
+
+    def parse(self):
+        return cde.DecodeResizeOperation(self.size, DE_C_INTER_MODE[self.interpolation])
+
+
 class Equalize(ImageTensorOperation):
     """
     Apply histogram equalization on input image.
@@ -102,6 +102,7 @@ class FileWriter:
 
         self._overwrite = overwrite
         self._append = False
+        self._mmap_index = False
         self._flush = False
         self._header = ShardHeader()
         self._writer = ShardWriter()
@@ -381,6 +382,95 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_column_page(self, column_page):
+        """
+        Set whether to also write the non-blob fields into column pages, where each field \
+        of a page is stored contiguously and encoded on its own. When the dataset is read \
+        with `columns_list`, only the selected fields are decoded, and pages whose minimum \
+        and maximum do not match the criteria of the sampler are skipped. The raw pages are \
+        still written, so the files can be read by older versions as well.
+
+        Args:
+           column_page (bool): Write column pages or not. Default is False.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            ParamTypeError: If `column_page` is not of type bool.
+
+        Examples:
+            >>> from mindspore.mindrecord import FileWriter
+            >>> writer = FileWriter(file_name="test.mindrecord", shard_num=1)
+            >>> writer.set_column_page(True)
+            MSRStatus.SUCCESS
+        """
+        if not isinstance(column_page, bool):
+            raise ParamTypeError('column_page', 'bool')
+        return self._writer.set_column_page(column_page)
+
+    def set_mmap_index(self, mmap_index):
+        """
+        Set whether to also generate a sorted index file which can be memory mapped for each \
+        MindRecord file, named by appending `.idx` to the file name. When the index file is up \
+        to date, the reader looks up the samples in it by binary search instead of opening the \
+        database file, which makes opening a large number of MindRecord files much faster. \
+        The database files are still generated, so the files can be read by older versions as well.
+
+        Args:
+           mmap_index (bool): Generate the index files or not. Default is False.
+
+        Raises:
+            ParamTypeError: If `mmap_index` is not of type bool.
+
+        Examples:
+            >>> from mindspore.mindrecord import FileWriter
+            >>> writer = FileWriter(file_name="test.mindrecord", shard_num=1)
+            >>> writer.set_mmap_index(True)
+        """
+        if not isinstance(mmap_index, bool):
+            raise ParamTypeError('mmap_index', 'bool')
+        self._mmap_index = mmap_index
+        self._writer.set_mmap_index(mmap_index)
+
+    def set_pipeline(self, pipeline, max_memory=1 << 30):
+        """
+        Set whether to write the raw data through a pipeline, where the blobs are compressed, \
+        the non-blob fields are serialized, the pages are written and the index is generated \
+        by threads of their own. Then `write_raw_data` returns once the raw data is queued, \
+        and the index is generated while writing instead of after `commit` flushes the pages, \
+        unless appending to existing MindRecord files. The errors of a batch are raised by the \
+        next `write_raw_data` or `commit`.
+
+        Note:
+            It should be called before `write_raw_data`, and can not be used with `parallel_writer`.
+
+        Args:
+           pipeline (bool): Write through the pipeline or not. Default is False.
+           max_memory (int, optional): Max bytes of the raw data queued and not written yet, \
+               `write_raw_data` waits when it is exceeded. Default: 1GB.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            ParamTypeError: If `pipeline` is not of type bool or `max_memory` is not of type int.
+            ParamValueError: If `max_memory` is not positive.
+
+        Examples:
+            >>> from mindspore.mindrecord import FileWriter
+            >>> writer = FileWriter(file_name="test.mindrecord", shard_num=1)
+            >>> writer.set_pipeline(True, 1 << 28) # 256MB
+            MSRStatus.SUCCESS
+        """
+        if not isinstance(pipeline, bool):
+            raise ParamTypeError('pipeline', 'bool')
+        if not isinstance(max_memory, int) or isinstance(max_memory, bool):
+            raise ParamTypeError('max_memory', 'int')
+        if max_memory <= 0:
+            raise ParamValueError("The parameter max_memory {} should be positive.".format(max_memory))
+        return self._writer.set_pipeline(pipeline, max_memory)
+
     def commit(self):
         """
         Flush data in memory to disk and generate the corresponding database files.
@@ -405,11 +495,12 @@ class FileWriter:
         if not self._writer.get_shard_header():
             self._writer.set_shard_header(self._header)
         ret = self._writer.commit()
-        if self._index_generator:
+        if self._index_generator and not self._writer.is_index_written():
             if self._append:
-                self._generator = ShardIndexGenerator(self._file_name, self._append)
+                self._generator = ShardIndexGenerator(self._file_name, self._append, self._mmap_index)
             elif len(self._paths) >= 1:
-                self._generator = ShardIndexGenerator(os.path.realpath(self._paths[0]), self._append)
+                self._generator = ShardIndexGenerator(os.path.realpath(self._paths[0]), self._append,
+                                                      self._mmap_index)
             self._generator.build()
             self._generator.write_to_db()
 
@@ -420,10 +511,10 @@ class FileWriter:
             if os.path.exists(item):
                 os.chmod(item, stat.S_IRUSR | stat.S_IWUSR)
                 mindrecord_files.append(item)
-            index_file = item + ".db"
-            if os.path.exists(index_file):
-                os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
-                index_files.append(index_file)
+            for index_file in [item + ".db", item + ".idx"]:
+                if os.path.exists(index_file):
+                    os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
+                    index_files.append(index_file)
 
         logger.info("The list of mindrecord files created are: {}, and the list of index files are: {}".format(
             mindrecord_files, index_files))
@@ -114,6 +114,47 @@ class ShardWriter:
             raise MRMInvalidPageSizeError
         return ret
 
+    def set_column_page(self, column_page):
+        """
+        Set whether to write the non-blob fields column by column besides the raw pages.
+
+        Args:
+           column_page (bool): Write column pages or not.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+        """
+        return self._writer.set_column_page(column_page)
+
+    def set_pipeline(self, pipeline, max_memory):
+        """
+        Set whether to write the raw data through a pipeline, which generates the index while writing.
+
+        Args:
+           pipeline (bool): Write through the pipeline or not.
+           max_memory (int): Max bytes of the raw data queued and not written yet.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+        """
+        return self._writer.set_pipeline(pipeline, max_memory)
+
+    def set_mmap_index(self, mmap_index):
+        """
+        Set whether to also write the mmap index when the index is generated while writing.
+
+        Args:
+           mmap_index (bool): Write the mmap index or not.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+        """
+        return self._writer.set_mmap_index(mmap_index)
+
+    def is_index_written(self):
+        """Whether the index was generated while writing."""
+        return self._writer.is_index_written()
+
     def set_shard_header(self, shard_header):
         """
         Set header which contains schema and index before write raw data.
@@ -0,0 +1,267 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""
+Function:
+    Replay the memory alloc trace recorded by the dynamic memory pool(MS_DEV_MEMPOOL_TRACE_FILE) offline, and report
+    the peak usage, the fragmentation over time and the theoretical optimum.
+Usage:
+    python mem_trace_replay.py --trace_file=mem.trace [--unit_size=1024] [--capacity=0] [--interval=1000]
+                               [--timeline_file=timeline.csv]
+"""
+import argparse
+import bisect
+import csv
+import struct
+from collections import defaultdict
+
+MAGIC = b"MSMEMTRC"
+VERSION = 1
+RECORD_NAME = 0
+RECORD_ALLOC = 1
+RECORD_FREE = 2
+FLAG_PERSISTENT = 1
+FLAG_CONTINUOUS = 2
+ALIGN_SIZE = 512
+MB = 1024 * 1024
+ALLOCATOR_TYPES = ["weight", "constant value", "kernel output", "other"]
+
+
+def read_trace(trace_file):
+    """Read the alloc and free events from the trace file."""
+    events = []
+    names = []
+    with open(trace_file, "rb") as f:
+        data = f.read()
+    if data[:8] != MAGIC:
+        raise ValueError("{} is not a memory alloc trace file.".format(trace_file))
+    version, _ = struct.unpack_from("<II", data, 8)
+    if version != VERSION:
+        raise ValueError("The version {} of trace file is not supported.".format(version))
+    offset = 16
+    while offset < len(data):
+        record_type = data[offset]
+        offset += 1
+        if record_type == RECORD_NAME:
+            name_id, name_len = struct.unpack_from("<II", data, offset)
+            offset += 8
+            if name_id != len(names):
+                raise ValueError("The trace file is broken at offset {}.".format(offset))
+            names.append(data[offset:offset + name_len].decode("utf-8", errors="replace"))
+            offset += name_len
+        elif record_type == RECORD_ALLOC:
+            flags, allocator_type, name_id, size, addr, timestamp = struct.unpack_from("<BBIQQQ", data, offset)
+            offset += 30
+            events.append((RECORD_ALLOC, flags, allocator_type, names[name_id], size, addr, timestamp))
+        elif record_type == RECORD_FREE:
+            addr, timestamp = struct.unpack_from("<QQ", data, offset)
+            offset += 16
+            events.append((RECORD_FREE, 0, 0, "", 0, addr, timestamp))
+        else:
+            raise ValueError("Unknown record type {} at offset {}.".format(record_type, offset - 1))
+    return events
+
+
+class BestFitPool:
+    """Simulate the best fit memory pool with the memory buf combination of DynamicMemPoolBestFit."""
+
+    def __init__(self, unit_size):
+        self.unit_size = unit_size
+        self.next_base = 0
+        self.total_size = 0
+        self.used_size = 0
+        self.idle_size = 0
+        # start address -> [size, used, block id]
+        self.bufs = {}
+        # end address -> start address
+        self.buf_ends = {}
+        # sorted (size, address) of the idle bufs
+        self.idle_bufs = []
+
+    def alloc(self, size, free_device_size):
+        """Alloc the aligned size, return the address or None if the device memory is not enough."""
+        index = bisect.bisect_left(self.idle_bufs, (size, -1))
+        if index == len(self.idle_bufs):
+            if not self._add_block(size, free_device_size):
+                return None
+            index = bisect.bisect_left(self.idle_bufs, (size, -1))
+        buf_size, addr = self.idle_bufs.pop(index)
+        self.idle_size -= buf_size
+        block = self.bufs[addr][2]
+        if buf_size - size >= ALIGN_SIZE:
+            self._set_buf(addr, size, True, block)
+            self._set_buf(addr + size, buf_size - size, False, block)
+            bisect.insort(self.idle_bufs, (buf_size - size, addr + size))
+            self.idle_size += buf_size - size
+            buf_size = size
+        else:
+            self._set_buf(addr, buf_size, True, block)
+        self.used_size += buf_size
+        return addr
+
+    def free(self, addr):
+        """Free the buf and combine it with the idle neighbours in the same block."""
+        size, _, block = self.bufs[addr]
+        self.used_size -= size
+        next_buf = self.bufs.get(addr + size)
+        if next_buf is not None and not next_buf[1] and next_buf[2] == block:
+            self._remove_idle(addr + size, next_buf[0])
+            size += next_buf[0]
+        prev_addr = self.buf_ends.get(addr)
+        if prev_addr is not None and not self.bufs[prev_addr][1] and self.bufs[prev_addr][2] == block:
+            prev_size = self.bufs[prev_addr][0]
+            self._remove_idle(prev_addr, prev_size)
+            self._del_buf(addr)
+            addr = prev_addr
+            size += prev_size
+        self._set_buf(addr, size, False, block)
+        bisect.insort(self.idle_bufs, (size, addr))
+        self.idle_size += size
+
+    def largest_idle(self):
+        return self.idle_bufs[-1][0] if self.idle_bufs else 0
+
+    def _add_block(self, size, free_device_size):
+        block_size = self.unit_size
+        while block_size < size:
+            block_size *= 2
+        block_size = min(block_size, free_device_size)
+        if block_size < size:
+            return False
+        # Leave a gap between the blocks, so that the bufs of different blocks are never adjacent.
+        addr = self.next_base
+        self.next_base += block_size + ALIGN_SIZE
+        self.total_size += block_size
+        self._set_buf(addr, block_size, False, addr)
+        bisect.insort(self.idle_bufs, (block_size, addr))
+        self.idle_size += block_size
+        return True
+
+    def _set_buf(self, addr, size, used, block):
+        old = self.bufs.get(addr)
+        if old is not None:
+            del self.buf_ends[addr + old[0]]
+        self.bufs[addr] = [size, used, block]
+        self.buf_ends[addr + size] = addr
+
+    def _del_buf(self, addr):
+        size = self.bufs.pop(addr)[0]
+        del self.buf_ends[addr + size]
+
+    def _remove_idle(self, addr, size):
+        index = bisect.bisect_left(self.idle_bufs, (size, addr))
+        del self.idle_bufs[index]
+        self.idle_size -= size
+        self._del_buf(addr)
+
+
+def align(size):
+    if size == 0:
+        return ALIGN_SIZE
+    return (size + ALIGN_SIZE - 1) // ALIGN_SIZE * ALIGN_SIZE
+
+
+def replay(events, unit_size, capacity, interval):
+    """Replay the events on the simulated pools, return the report and the timeline."""
+    pools = {False: BestFitPool(unit_size), True: BestFitPool(unit_size)}
+    live = {}
+    live_size = 0
+    live_by_name = defaultdict(int)
+    report = defaultdict(int)
+    peak_live_by_name = {}
+    timeline = []
+
+    def free_device_size():
+        if capacity == 0:
+            return 1 << 62
+        return capacity - pools[False].total_size - pools[True].total_size
+
+    for index, (record_type, flags, allocator_type, name, size, addr, timestamp) in enumerate(events):
+        if record_type == RECORD_ALLOC:
+            report["alloc_count"] += 1
+            if addr == 0:
+                report["recorded_failed_count"] += 1
+                continue
+            persistent = bool(flags & FLAG_PERSISTENT)
+            align_size = align(size)
+            sim_addr = pools[persistent].alloc(align_size, free_device_size())
+            if sim_addr is None:
+                report["replay_failed_count"] += 1
+                continue
+            key = "{}({})".format(name, ALLOCATOR_TYPES[allocator_type % len(ALLOCATOR_TYPES)])
+            live[addr] = (persistent, sim_addr, size, key)
+            live_size += size
+            live_by_name[key] += size
+            if live_size > report["optimum"]:
+                report["optimum"] = live_size
+                peak_live_by_name = dict(live_by_name)
+        else:
+            report["free_count"] += 1
+            if addr not in live:
+                report["unknown_free_count"] += 1
+                continue
+            persistent, sim_addr, size, key = live.pop(addr)
+            pools[persistent].free(sim_addr)
+            live_size -= size
+            live_by_name[key] -= size
+
+        total = pools[False].total_size + pools[True].total_size
+        used = pools[False].used_size + pools[True].used_size
+        report["peak_total"] = max(report["peak_total"], total)
+        report["peak_used"] = max(report["peak_used"], used)
+        if index % interval == 0:
+            idle = pools[False].idle_size
+            fragmentation = 1.0 - pools[False].largest_idle() / idle if idle else 0.0
+            timeline.append((index, timestamp, live_size, used, total, idle, pools[False].largest_idle(),
+                             fragmentation))
+    return report, peak_live_by_name, timeline
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay the memory alloc trace of the dynamic memory pool.")
+    parser.add_argument("--trace_file", type=str, required=True, help="The trace file recorded by memory pool.")
+    parser.add_argument("--unit_size", type=int, default=1024, help="The memory block unit size in MB.")
+    parser.add_argument("--capacity", type=int, default=0, help="The device memory size in MB, 0 means unlimited.")
+    parser.add_argument("--interval", type=int, default=1000, help="The event interval to sample the timeline.")
+    parser.add_argument("--timeline_file", type=str, default="", help="The csv file to save the timeline.")
+    args = parser.parse_args()
+
+    events = read_trace(args.trace_file)
+    report, peak_live_by_name, timeline = replay(events, args.unit_size * MB, args.capacity * MB,
+                                                 max(args.interval, 1))
+    print("Events: {}, alloc: {}, free: {}, failed alloc in trace: {}, failed alloc in replay: {}, "
+          "free of unknown address: {}.".format(len(events), report["alloc_count"], report["free_count"],
+                                                report["recorded_failed_count"], report["replay_failed_count"],
+                                                report["unknown_free_count"]))
+    print("Peak allocated memory: {:.2f}M, peak used memory: {:.2f}M, theoretical optimum: {:.2f}M.".format(
+        report["peak_total"] / MB, report["peak_used"] / MB, report["optimum"] / MB))
+    if report["optimum"] > 0:
+        print("Peak allocated memory is {:.2f}x of the theoretical optimum.".format(
+            report["peak_total"] / report["optimum"]))
+    if timeline:
+        print("Max fragmentation of common memory over time: {:.2%}.".format(max(item[-1] for item in timeline)))
+    print("Live memory at the theoretical optimum by allocator:")
+    for key, size in sorted(peak_live_by_name.items(), key=lambda item: item[1], reverse=True)[:10]:
+        print("  {}: {:.2f}M".format(key, size / MB))
+
+    if args.timeline_file:
+        with open(args.timeline_file, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["event", "timestamp_us", "live", "used", "allocated", "idle", "largest_idle",
+                             "fragmentation"])
+            writer.writerows(timeline)
+
+
+if __name__ == "__main__":
+    main()
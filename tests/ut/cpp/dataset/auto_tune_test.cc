@@ -0,0 +1,361 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <memory>
+#include <string>
+#include "common/common.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#include "minddata/dataset/include/dataset/datasets.h"
+#include "minddata/dataset/include/dataset/vision.h"
+
+using namespace mindspore::dataset;
+
+namespace mindspore {
+namespace dataset {
+namespace test {
+/// AutoTune whose profiling statistics are set by the test instead of measured
+class MockAutoTune : public AutoTune {
+ public:
+  explicit MockAutoTune(TreeAdapter *tree_adapter) : AutoTune(tree_adapter, nullptr) {}
+
+  ~MockAutoTune() override = default;
+
+  /// Set the statistics of an operator, as if they were reported by the profiler
+  void SetOpStats(int32_t op_id, int32_t num_workers, double cpu_util, double in_queue_util, double out_queue_util) {
+    num_workers_[op_id] = num_workers;
+    cpu_util_[op_id] = cpu_util;
+    in_queue_util_[op_id] = in_queue_util;
+    out_queue_util_[op_id] = out_queue_util;
+  }
+
+  /// Run an iteration of the controller with the given average pipeline time
+  Status Iterate(bool is_bottleneck, double pipeline_time) {
+    avg_pipeline_times_.push_back(pipeline_time);
+    return Analyse(is_bottleneck);
+  }
+
+  /// Find the id of the first operator with the name
+  int32_t OpId(const std::string &name) const {
+    for (const auto &op : ops_) {
+      if (op.second->Name() == name) {
+        return op.first;
+      }
+    }
+    return -1;
+  }
+
+  uint64_t RequestsCount() const { return tree_modifier_->GetRequestsCount(); }
+
+  using AutoTune::ApplyTuneStep;
+  using AutoTune::CollectOpsInfo;
+  using AutoTune::FindStepDown;
+  using AutoTune::FindStepUp;
+  using AutoTune::KeepTrialStep;
+  using AutoTune::kTuneNumWorkers;
+  using AutoTune::kTunePrefetchSize;
+  using AutoTune::TuneKnob;
+  using AutoTune::TuneStep;
+
+  using AutoTune::baseline_throughput_;
+  using AutoTune::cpu_budget_;
+  using AutoTune::max_workers_;
+  using AutoTune::on_trial_;
+  using AutoTune::ops_;
+  using AutoTune::parallel_ops_ids_;
+  using AutoTune::rejected_steps_;
+  using AutoTune::trial_step_;
+
+  std::map<int32_t, int32_t> num_workers_;
+  std::map<int32_t, double> cpu_util_;
+  std::map<int32_t, double> in_queue_util_;
+  std::map<int32_t, double> out_queue_util_;
+
+ protected:
+  Status GetOpsCpuUtil(std::map<int32_t, double> *ops_cpu_util) override {
+    *ops_cpu_util = cpu_util_;
+    return Status::OK();
+  }
+
+  Status GetOpsQueueUtil(std::map<int32_t, double> *out_ops_queue_util,
+                         std::map<int32_t, double> *in_ops_queue_util) override {
+    *out_ops_queue_util = out_queue_util_;
+    *in_ops_queue_util = in_queue_util_;
+    return Status::OK();
+  }
+
+  Status GetOpsNumWorker(std::map<int32_t, int32_t> *ops_num_workers) override {
+    *ops_num_workers = num_workers_;
+    return Status::OK();
+  }
+};
+
+class MindDataTestAutoTune : public UT::DatasetOpTesting {
+ protected:
+  /// Build the execution tree of ImageFolder -> Map(Decode) and an AutoTune on it, without launching it.
+  /// The map op is busy and slow, the leaf op is mostly idle, and the budget is 8 cpu cores.
+  void SetUp() override {
+    DatasetOpTesting::SetUp();
+    std::string folder_path = datasets_root_path_ + "/testPK/data/";
+    std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 10));
+    ASSERT_NE(ds, nullptr);
+    ds = ds->Map({std::make_shared<vision::Decode>()}, {"image"});
+    ASSERT_NE(ds, nullptr);
+    tree_adapter_ = std::make_shared<TreeAdapter>();
+    ASSERT_OK(tree_adapter_->Compile(ds->IRNode(), 1));
+    auto_tune_ = std::make_unique<MockAutoTune>(tree_adapter_.get());
+    ASSERT_OK(auto_tune_->CollectOpsInfo());
+    map_id_ = auto_tune_->OpId(kMapOp);
+    leaf_id_ = auto_tune_->OpId("ImageFolderOp");
+    ASSERT_GE(map_id_, 0);
+    ASSERT_GE(leaf_id_, 0);
+    ASSERT_EQ(auto_tune_->parallel_ops_ids_.size(), 2);
+    auto_tune_->max_workers_ = 8;
+    auto_tune_->cpu_budget_ = 8;
+    // cpu usage is 2 cores
+    auto_tune_->SetOpStats(map_id_, 2, 160, 0.9, 0.2);
+    auto_tune_->SetOpStats(leaf_id_, 2, 40, 1, 0.8);
+  }
+
+  void ExpectStep(const MockAutoTune::TuneStep &step, int32_t op_id, MockAutoTune::TuneKnob knob, int32_t old_value,
+                  int32_t new_value) {
+    EXPECT_EQ(step.op_id, op_id);
+    EXPECT_EQ(step.knob, knob);
+    EXPECT_EQ(step.old_value, old_value);
+    EXPECT_EQ(step.new_value, new_value);
+  }
+
+  bool FindStepUp(MockAutoTune::TuneStep *step) {
+    return auto_tune_->FindStepUp({map_id_, leaf_id_}, auto_tune_->num_workers_, auto_tune_->cpu_util_,
+                                  auto_tune_->out_queue_util_, auto_tune_->in_queue_util_, CpuUsage(), step);
+  }
+
+  bool FindStepDown(bool skip_rejected, MockAutoTune::TuneStep *step) {
+    return auto_tune_->FindStepDown({map_id_, leaf_id_}, auto_tune_->num_workers_, auto_tune_->cpu_util_,
+                                    skip_rejected, step);
+  }
+
+  double CpuUsage() const { return (auto_tune_->cpu_util_[map_id_] + auto_tune_->cpu_util_[leaf_id_]) / 100; }
+
+  std::shared_ptr<TreeAdapter> tree_adapter_;
+  std::unique_ptr<MockAutoTune> auto_tune_;
+  int32_t map_id_ = -1;
+  int32_t leaf_id_ = -1;
+};
+
+/// Feature: AutoTune
+/// Description: Test KeepTrialStep with the throughput measured after a step up and a step down
+/// Expectation: A step up is kept only if it gains 3%, a step down is kept unless it loses more than 2%
+TEST_F(MindDataTestAutoTune, TestKeepTrialStep) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestKeepTrialStep.";
+  auto_tune_->trial_step_ = {map_id_, MockAutoTune::kTuneNumWorkers, 2, 4};
+  // Nothing to compare with
+  auto_tune_->baseline_throughput_ = 0;
+  EXPECT_TRUE(auto_tune_->KeepTrialStep(50));
+
+  auto_tune_->baseline_throughput_ = 100;
+  EXPECT_FALSE(auto_tune_->KeepTrialStep(90));
+  EXPECT_FALSE(auto_tune_->KeepTrialStep(102));
+  EXPECT_TRUE(auto_tune_->KeepTrialStep(104));
+
+  auto_tune_->trial_step_ = {map_id_, MockAutoTune::kTuneNumWorkers, 2, 1};
+  EXPECT_TRUE(auto_tune_->KeepTrialStep(100));
+  EXPECT_TRUE(auto_tune_->KeepTrialStep(98.5));
+  EXPECT_FALSE(auto_tune_->KeepTrialStep(97));
+}
+
+/// Feature: AutoTune
+/// Description: Test FindStepUp picks the bottleneck op, and respects the cpu budget and the rejected steps
+/// Expectation: The expected op and knob are chosen in each case
+TEST_F(MindDataTestAutoTune, TestFindStepUp) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestFindStepUp.";
+  MockAutoTune::TuneStep step{};
+  // The map op is the bottleneck, and a new worker of it fits in the budget
+  ASSERT_TRUE(FindStepUp(&step));
+  ExpectStep(step, map_id_, MockAutoTune::kTuneNumWorkers, 2, 4);
+
+  // A new map worker needs 0.8 more cores, but a new leaf worker only needs 0.2
+  auto_tune_->cpu_budget_ = 2.5;
+  ASSERT_TRUE(FindStepUp(&step));
+  ExpectStep(step, leaf_id_, MockAutoTune::kTuneNumWorkers, 2, 4);
+
+  // No worker fits in the budget, the output connector of the leaf op is mostly full so it prefetches more
+  auto_tune_->cpu_budget_ = 2.1;
+  EXPECT_FALSE(FindStepUp(&step));
+  auto_tune_->out_queue_util_[leaf_id_] = 0.95;
+  ASSERT_TRUE(FindStepUp(&step));
+  int32_t capacity = auto_tune_->ops_[leaf_id_]->ConnectorCapacity();
+  ExpectStep(step, leaf_id_, MockAutoTune::kTunePrefetchSize, capacity, capacity + 4);
+
+  // The rejected step of the map op is not tried again
+  auto_tune_->cpu_budget_ = 8;
+  auto_tune_->out_queue_util_[leaf_id_] = 0.8;
+  auto_tune_->rejected_steps_.emplace_back(MockAutoTune::TuneStep{map_id_, MockAutoTune::kTuneNumWorkers, 2, 4}, 5);
+  ASSERT_TRUE(FindStepUp(&step));
+  ExpectStep(step, leaf_id_, MockAutoTune::kTuneNumWorkers, 2, 4);
+
+  // The ops have the maximum number of workers already
+  auto_tune_->max_workers_ = 2;
+  EXPECT_FALSE(FindStepUp(&step));
+}
+
+/// Feature: AutoTune
+/// Description: Test FindStepDown picks the least busy op, and gives back busy workers only over the budget
+/// Expectation: The expected op is chosen in each case
+TEST_F(MindDataTestAutoTune, TestFindStepDown) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestFindStepDown.";
+  MockAutoTune::TuneStep step{};
+  ASSERT_TRUE(FindStepDown(true, &step));
+  ExpectStep(step, leaf_id_, MockAutoTune::kTuneNumWorkers, 2, 1);
+
+  // The step down of the leaf op was rejected, the workers of the map op are busy
+  auto_tune_->rejected_steps_.emplace_back(MockAutoTune::TuneStep{leaf_id_, MockAutoTune::kTuneNumWorkers, 2, 1}, 5);
+  EXPECT_FALSE(FindStepDown(true, &step));
+  // Over the budget, the least busy op gives back a worker anyway
+  ASSERT_TRUE(FindStepDown(false, &step));
+  ExpectStep(step, leaf_id_, MockAutoTune::kTuneNumWorkers, 2, 1);
+
+  // The leaf op has the minimum number of workers
+  auto_tune_->rejected_steps_.clear();
+  auto_tune_->SetOpStats(leaf_id_, 1, 10, 1, 0.8);
+  EXPECT_FALSE(FindStepDown(true, &step));
+  ASSERT_TRUE(FindStepDown(false, &step));
+  ExpectStep(step, map_id_, MockAutoTune::kTuneNumWorkers, 2, 1);
+}
+
+/// Feature: AutoTune
+/// Description: Test ApplyTuneStep sends the change requests with the values clipped to the limits
+/// Expectation: A request is sent for each step, and the new value of the step is the clipped value
+TEST_F(MindDataTestAutoTune, TestApplyTuneStep) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestApplyTuneStep.";
+  auto_tune_->max_workers_ = 3;
+  MockAutoTune::TuneStep step = {map_id_, MockAutoTune::kTuneNumWorkers, 2, 4};
+  ASSERT_OK(auto_tune_->ApplyTuneStep(&step));
+  EXPECT_EQ(step.new_value, 3);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 1);
+
+  step = {map_id_, MockAutoTune::kTuneNumWorkers, 1, 0};
+  ASSERT_OK(auto_tune_->ApplyTuneStep(&step));
+  EXPECT_EQ(step.new_value, 1);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 2);
+
+  step = {map_id_, MockAutoTune::kTunePrefetchSize, 126, 130};
+  ASSERT_OK(auto_tune_->ApplyTuneStep(&step));
+  EXPECT_EQ(step.new_value, 128);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 3);
+}
+
+/// Feature: AutoTune
+/// Description: Test Analyse keeps a step up which makes the pipeline faster and takes the next one
+/// Expectation: The step is kept without a revert, and the next step is on trial
+TEST_F(MindDataTestAutoTune, TestAnalyseKeepStep) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestAnalyseKeepStep.";
+  // 100 steps/s
+  ASSERT_OK(auto_tune_->Iterate(true, 10));
+  ASSERT_TRUE(auto_tune_->on_trial_);
+  ExpectStep(auto_tune_->trial_step_, map_id_, MockAutoTune::kTuneNumWorkers, 2, 4);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 1);
+
+  // The map op has 4 workers now, and the pipeline runs at 125 steps/s. The leaf op is the next to try, its
+  // input connector is fuller than its output connector by more
+  auto_tune_->SetOpStats(map_id_, 4, 200, 0.5, 0.4);
+  ASSERT_OK(auto_tune_->Iterate(true, 8));
+  EXPECT_TRUE(auto_tune_->rejected_steps_.empty());
+  EXPECT_DOUBLE_EQ(auto_tune_->baseline_throughput_, 125);
+  ASSERT_TRUE(auto_tune_->on_trial_);
+  ExpectStep(auto_tune_->trial_step_, leaf_id_, MockAutoTune::kTuneNumWorkers, 2, 4);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 2);
+}
+
+/// Feature: AutoTune
+/// Description: Test Analyse reverts a step up which does not make the pipeline faster
+/// Expectation: The step is reverted and rejected, and another op is tried in the next iteration
+TEST_F(MindDataTestAutoTune, TestAnalyseRevertStep) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestAnalyseRevertStep.";
+  ASSERT_OK(auto_tune_->Iterate(true, 10));
+  ExpectStep(auto_tune_->trial_step_, map_id_, MockAutoTune::kTuneNumWorkers, 2, 4);
+
+  // The throughput is the same with 4 workers
+  auto_tune_->SetOpStats(map_id_, 4, 160, 0.9, 0.2);
+  ASSERT_OK(auto_tune_->Iterate(true, 10));
+  EXPECT_FALSE(auto_tune_->on_trial_);
+  EXPECT_DOUBLE_EQ(auto_tune_->baseline_throughput_, 0);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 2);
+  ASSERT_EQ(auto_tune_->rejected_steps_.size(), 1);
+  ExpectStep(auto_tune_->rejected_steps_[0].first, map_id_, MockAutoTune::kTuneNumWorkers, 2, 4);
+
+  // Back to 2 workers, the map op is still the bottleneck but the rejected step is not tried again
+  auto_tune_->SetOpStats(map_id_, 2, 160, 0.9, 0.2);
+  ASSERT_OK(auto_tune_->Iterate(true, 10));
+  ASSERT_TRUE(auto_tune_->on_trial_);
+  ExpectStep(auto_tune_->trial_step_, leaf_id_, MockAutoTune::kTuneNumWorkers, 2, 4);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 3);
+}
+
+/// Feature: AutoTune
+/// Description: Test Analyse removes a worker of the least busy op when the pipeline is not the bottleneck
+/// Expectation: The step down is kept if the throughput holds, and reverted if it drops
+TEST_F(MindDataTestAutoTune, TestAnalyseRemoveWorker) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestAnalyseRemoveWorker.";
+  ASSERT_OK(auto_tune_->Iterate(false, 10));
+  ASSERT_TRUE(auto_tune_->on_trial_);
+  ExpectStep(auto_tune_->trial_step_, leaf_id_, MockAutoTune::kTuneNumWorkers, 2, 1);
+
+  // A little slower, within the noise
+  auto_tune_->SetOpStats(leaf_id_, 1, 30, 1, 0.8);
+  ASSERT_OK(auto_tune_->Iterate(false, 10.1));
+  EXPECT_TRUE(auto_tune_->rejected_steps_.empty());
+  // Neither op can give back a worker now
+  EXPECT_FALSE(auto_tune_->on_trial_);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 1);
+
+  // The map op becomes idle and gives back a worker, but the pipeline gets much slower
+  auto_tune_->SetOpStats(map_id_, 2, 40, 0.9, 0.2);
+  ASSERT_OK(auto_tune_->Iterate(false, 10));
+  ExpectStep(auto_tune_->trial_step_, map_id_, MockAutoTune::kTuneNumWorkers, 2, 1);
+  auto_tune_->SetOpStats(map_id_, 1, 40, 0.9, 0.2);
+  ASSERT_OK(auto_tune_->Iterate(false, 11));
+  EXPECT_EQ(auto_tune_->RequestsCount(), 3);
+  ASSERT_EQ(auto_tune_->rejected_steps_.size(), 1);
+  ExpectStep(auto_tune_->rejected_steps_[0].first, map_id_, MockAutoTune::kTuneNumWorkers, 2, 1);
+}
+
+/// Feature: AutoTune
+/// Description: Test Analyse removes workers when the cpu usage exceeds the budget, even if it is the bottleneck
+/// Expectation: A worker of the least busy op is removed without a trial
+TEST_F(MindDataTestAutoTune, TestAnalyseOverBudget) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestAnalyseOverBudget.";
+  auto_tune_->cpu_budget_ = 1.5;
+  ASSERT_OK(auto_tune_->Iterate(true, 10));
+  EXPECT_FALSE(auto_tune_->on_trial_);
+  EXPECT_DOUBLE_EQ(auto_tune_->baseline_throughput_, 0);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 1);
+
+  // Still over the budget, the busy map op gives back a worker too
+  auto_tune_->SetOpStats(leaf_id_, 1, 20, 1, 0.8);
+  ASSERT_OK(auto_tune_->Iterate(true, 10));
+  EXPECT_FALSE(auto_tune_->on_trial_);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 2);
+
+  // Within the budget, a new map worker needs 0.8 more cores but only 0.5 are left, so the leaf op gets one
+  auto_tune_->SetOpStats(map_id_, 1, 80, 0.9, 0.2);
+  ASSERT_OK(auto_tune_->Iterate(true, 10));
+  ASSERT_TRUE(auto_tune_->on_trial_);
+  ExpectStep(auto_tune_->trial_step_, leaf_id_, MockAutoTune::kTuneNumWorkers, 1, 3);
+  EXPECT_EQ(auto_tune_->RequestsCount(), 3);
+}
+}  // namespace test
+}  // namespace dataset
+}  // namespace mindspore
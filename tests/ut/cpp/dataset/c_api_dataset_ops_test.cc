@@ -15,6 +15,7 @@
  */
 #include "common/common.h"
 #include "include/api/types.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/include/dataset/datasets.h"
 #include "minddata/dataset/include/dataset/vision.h"
@@ -1509,6 +1510,68 @@ TEST_F(MindDataTestPipeline, TestShuffleTFRecord) {
  TestShuffleTFRecord(100, datasets_root_path_);
 }
 
+namespace {
+// Shuffle the images with the number of shards, and return the label and the size of each image.
+void RunShuffleWithShards(const std::string &folder_path, int32_t num_shards, int32_t shuffle_size,
+                          std::vector<std::pair<int32_t, int64_t>> *rows) {
+  auto config_manager = GlobalContext::config_manager();
+  int32_t original_num_shards = config_manager->shuffle_num_shards();
+  uint32_t original_seed = config_manager->seed();
+  config_manager->set_shuffle_num_shards(num_shards);
+  config_manager->set_seed(1234);
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 20));
+  EXPECT_NE(ds, nullptr);
+  if (shuffle_size > 0) {
+    ds = ds->Shuffle(shuffle_size);
+    EXPECT_NE(ds, nullptr);
+  }
+  // Repeat to cover the rows drained from the shards at the end of epoch.
+  ds = ds->Repeat(2);
+  EXPECT_NE(ds, nullptr);
+
+  std::shared_ptr<Iterator> iter = ds->CreateIterator();
+  EXPECT_NE(iter, nullptr);
+  std::unordered_map<std::string, mindspore::MSTensor> row;
+  ASSERT_OK(iter->GetNextRow(&row));
+  while (row.size() != 0) {
+    auto label = row["label"];
+    rows->emplace_back(*reinterpret_cast<const int32_t *>(label.Data().get()), row["image"].ElementNum());
+    ASSERT_OK(iter->GetNextRow(&row));
+  }
+  iter->Stop();
+  config_manager->set_shuffle_num_shards(original_num_shards);
+  config_manager->set_seed(original_seed);
+}
+}  // namespace
+
+/// Feature: Test Shuffle with shards
+/// Description: Shuffle ImageFolder with the shuffle buffer split into 3 shards, twice with the same seed
+/// Expectation: Each epoch has all the rows, and the order is the same in both runs
+TEST_F(MindDataTestPipeline, TestShuffleNumShards) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline-TestShuffleNumShards.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::vector<std::pair<int32_t, int64_t>> expected_rows;
+  RunShuffleWithShards(folder_path, 1, 0, &expected_rows);
+  ASSERT_EQ(expected_rows.size(), 40);
+
+  // 20 rows of an epoch are not divisible by 3 shards, the last round does not reach all the shards.
+  std::vector<std::pair<int32_t, int64_t>> rows;
+  RunShuffleWithShards(folder_path, 3, 8, &rows);
+  ASSERT_EQ(rows.size(), expected_rows.size());
+  for (size_t epoch_begin = 0; epoch_begin < rows.size(); epoch_begin += 20) {
+    std::vector<std::pair<int32_t, int64_t>> epoch(rows.begin() + epoch_begin, rows.begin() + epoch_begin + 20);
+    std::vector<std::pair<int32_t, int64_t>> expected_epoch(expected_rows.begin() + epoch_begin,
+                                                            expected_rows.begin() + epoch_begin + 20);
+    std::sort(epoch.begin(), epoch.end());
+    std::sort(expected_epoch.begin(), expected_epoch.end());
+    EXPECT_EQ(epoch, expected_epoch);
+  }
+
+  std::vector<std::pair<int32_t, int64_t>> rerun_rows;
+  RunShuffleWithShards(folder_path, 3, 8, &rerun_rows);
+  EXPECT_EQ(rerun_rows, rows);
+}
+
 TEST_F(MindDataTestPipeline, TestSkipDataset) {
   MS_LOG(INFO) << "Doing MindDataTestPipeline-TestSkipDataset.";
 
@@ -2522,6 +2585,62 @@ TEST_F(MindDataTestPipeline, TestMap) {
   iter->Stop();
 }
 
+namespace {
+// Run decode, resize and normalize on the images with the map batch size, and return the labels and the images.
+void RunMapWithBatchSize(const std::string &folder_path, int32_t map_batch_size, std::vector<int32_t> *labels,
+                         std::vector<std::vector<float>> *images) {
+  int32_t original_map_batch_size = GlobalContext::config_manager()->map_batch_size();
+  GlobalContext::config_manager()->set_map_batch_size(map_batch_size);
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 20));
+  EXPECT_NE(ds, nullptr);
+  auto decode = std::make_shared<vision::Decode>();
+  auto resize = std::make_shared<vision::Resize>(std::vector<int32_t>{32, 32});
+  auto normalize = std::make_shared<vision::Normalize>(std::vector<float>{121.0, 115.0, 100.0},
+                                                       std::vector<float>{70.0, 68.0, 71.0});
+  ds = ds->Map({decode, resize, normalize}, {"image"});
+  EXPECT_NE(ds, nullptr);
+  ds = ds->SetNumWorkers(3);
+  EXPECT_NE(ds, nullptr);
+  // Repeat to cover the rows left at the end of epoch.
+  ds = ds->Repeat(2);
+  EXPECT_NE(ds, nullptr);
+
+  std::shared_ptr<Iterator> iter = ds->CreateIterator();
+  EXPECT_NE(iter, nullptr);
+  std::unordered_map<std::string, mindspore::MSTensor> row;
+  ASSERT_OK(iter->GetNextRow(&row));
+  while (row.size() != 0) {
+    auto label = row["label"];
+    labels->push_back(*reinterpret_cast<const int32_t *>(label.Data().get()));
+    auto image = row["image"];
+    auto data = reinterpret_cast<const float *>(image.Data().get());
+    images->emplace_back(data, data + image.ElementNum());
+    ASSERT_OK(iter->GetNextRow(&row));
+  }
+  iter->Stop();
+  GlobalContext::config_manager()->set_map_batch_size(original_map_batch_size);
+}
+}  // namespace
+
+// Feature: Test Map with map batch size
+// Description: Apply decode, resize and normalize on ImageFolder with the rows sent to the workers in batches
+// Expectation: The rows are in the same order and have the same data as the rows processed one by one
+TEST_F(MindDataTestPipeline, TestMapBatchSize) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline.TestMapBatchSize";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::vector<int32_t> expected_labels;
+  std::vector<std::vector<float>> expected_images;
+  RunMapWithBatchSize(folder_path, 1, &expected_labels, &expected_images);
+  EXPECT_EQ(expected_labels.size(), 40);
+
+  // 20 rows of an epoch are not divisible by 8, the rows left are sent as a smaller batch.
+  std::vector<int32_t> labels;
+  std::vector<std::vector<float>> images;
+  RunMapWithBatchSize(folder_path, 8, &labels, &images);
+  EXPECT_EQ(labels, expected_labels);
+  EXPECT_EQ(images, expected_images);
+}
+
 // Feature: Test Map on TFRecord
 // Description: Apply Map with a TensorOp that swaps 3 input columns with 1 output column
 // Expectation: "Image", "A", "B" are replaced with "X"
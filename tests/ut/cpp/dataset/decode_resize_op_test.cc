@@ -0,0 +1,117 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestDecodeResizeOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestDecodeResizeOp() : CVOpCommon() {}
+};
+
+/// Feature: DecodeResize op
+/// Description: Decode and resize the 4032x2268 jpeg image to 224x224 with enable_jpeg_dct_scaling on, and compare
+///     with Decode followed by Resize
+/// Expectation: The output has the target shape and is close to the output of Decode followed by Resize
+TEST_F(MindDataTestDecodeResizeOp, TestOp1) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeOp-TestOp1.";
+  GlobalContext::config_manager()->set_enable_jpeg_dct_scaling(true);
+  constexpr int32_t target_size = 224;
+  // The area interpolation averages the pixels like the scaled IDCT, so the difference only comes from the decoder
+  const InterpolationMode interpolation = InterpolationMode::kArea;
+  std::shared_ptr<Tensor> decode_resize_output;
+  DecodeResizeOp decode_resize_op(target_size, target_size, interpolation);
+  ASSERT_OK(decode_resize_op.Compute(raw_input_tensor_, &decode_resize_output));
+  EXPECT_EQ(decode_resize_output->shape(), TensorShape({target_size, target_size, 3}));
+
+  std::shared_ptr<Tensor> resize_output;
+  ResizeOp resize_op(target_size, target_size, interpolation);
+  ASSERT_OK(resize_op.Compute(input_tensor_, &resize_output));
+
+  cv::Mat output1 = CVTensor::AsCVTensor(decode_resize_output)->mat();
+  cv::Mat output2 = CVTensor::AsCVTensor(resize_output)->mat();
+  double diff_sum = 0;
+  for (int i = 0; i < target_size; i++) {
+    for (int j = 0; j < target_size; j++) {
+      diff_sum += std::abs(output1.at<cv::Vec3b>(i, j)[1] - output2.at<cv::Vec3b>(i, j)[1]);
+    }
+  }
+  double mean_diff = diff_sum / (target_size * target_size);
+  MS_LOG(INFO) << "mean diff: " << mean_diff;
+  constexpr double kMeanDiffThreshold = 10.0;
+  EXPECT_LT(mean_diff, kMeanDiffThreshold);
+  GlobalContext::config_manager()->set_enable_jpeg_dct_scaling(false);
+}
+
+/// Feature: DecodeResize op
+/// Description: Decode and resize the jpeg image with enable_jpeg_dct_scaling off, which is the default
+/// Expectation: The output is exactly the same as Decode followed by Resize
+TEST_F(MindDataTestDecodeResizeOp, TestOpNoDctScaling) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeOp-TestOpNoDctScaling.";
+  ASSERT_FALSE(GlobalContext::config_manager()->enable_jpeg_dct_scaling());
+  constexpr int32_t target_size = 224;
+  std::shared_ptr<Tensor> decode_resize_output;
+  DecodeResizeOp decode_resize_op(target_size, target_size);
+  ASSERT_OK(decode_resize_op.Compute(raw_input_tensor_, &decode_resize_output));
+
+  std::shared_ptr<Tensor> decode_output;
+  DecodeOp decode_op(true);
+  ASSERT_OK(decode_op.Compute(raw_input_tensor_, &decode_output));
+  std::shared_ptr<Tensor> resize_output;
+  ResizeOp resize_op(target_size, target_size);
+  ASSERT_OK(resize_op.Compute(decode_output, &resize_output));
+  ASSERT_EQ(decode_resize_output->shape(), resize_output->shape());
+  EXPECT_EQ(*decode_resize_output, *resize_output);
+}
+
+/// Feature: DecodeResize op
+/// Description: Decode and resize the jpeg image with a single size, so the aspect ratio is kept
+/// Expectation: The output has the same shape as Decode followed by Resize
+TEST_F(MindDataTestDecodeResizeOp, TestOp2) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeOp-TestOp2.";
+  constexpr int32_t target_size = 256;
+  std::shared_ptr<Tensor> decode_resize_output;
+  DecodeResizeOp decode_resize_op(target_size);
+  ASSERT_OK(decode_resize_op.Compute(raw_input_tensor_, &decode_resize_output));
+
+  std::shared_ptr<Tensor> resize_output;
+  ResizeOp resize_op(target_size);
+  ASSERT_OK(resize_op.Compute(input_tensor_, &resize_output));
+  EXPECT_EQ(decode_resize_output->shape(), resize_output->shape());
+  EXPECT_EQ(decode_resize_output->type(), DataType(DataType::DE_UINT8));
+}
+
+/// Feature: GetJpegScaleDenom
+/// Description: Get the scale denominator of the jpeg decoder for various crop and target sizes
+/// Expectation: It is the largest power of 2 up to 8 which keeps the scaled crop not smaller than the target
+TEST_F(MindDataTestDecodeResizeOp, TestScaleDenom) {
+  EXPECT_EQ(GetJpegScaleDenom(4032, 2268, 224, 224), 8);
+  EXPECT_EQ(GetJpegScaleDenom(4032, 2268, 512, 256), 4);
+  EXPECT_EQ(GetJpegScaleDenom(1134, 2268, 512, 256), 2);
+  EXPECT_EQ(GetJpegScaleDenom(800, 600, 700, 500), 1);
+  EXPECT_EQ(GetJpegScaleDenom(224, 224, 224, 224), 1);
+}
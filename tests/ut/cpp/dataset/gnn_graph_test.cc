@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <fstream>
+#include <functional>
+#include <limits>
 #include <string>
 #include <map>
 #include <memory>
@@ -22,6 +25,7 @@
 #include "common/common.h"
 #include "gtest/gtest.h"
 #include "minddata/dataset/util/status.h"
+#include "minddata/dataset/engine/gnn/csr_graph.h"
 #include "minddata/dataset/engine/gnn/node.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
@@ -408,3 +412,366 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+/// Feature: CSR storage format of GraphDataImpl.
+/// Description: load the same graph in default and CSR storage format and query the neighbors, edges and features.
+/// Expectation: the CSR graph returns the same results as the default graph.
+TEST_F(MindDataTestGNNGraph, TestCsrStorageFormat) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  GraphDataImpl graph(path, 1);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+  GraphDataImpl csr_graph(path, 1, false, GraphStorageFormat::kCsr);
+  s = csr_graph.Init();
+  EXPECT_TRUE(s.IsOk());
+
+  MetaInfo meta_info;
+  s = csr_graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(meta_info.node_type.size() == 2);
+
+  std::shared_ptr<Tensor> nodes;
+  s = graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<NodeIdType> node_list(nodes->begin<NodeIdType>(), nodes->end<NodeIdType>());
+  for (auto format : {OutputFormat::kNormal, OutputFormat::kCoo, OutputFormat::kCsr}) {
+    std::shared_ptr<Tensor> neighbors;
+    std::shared_ptr<Tensor> csr_neighbors;
+    s = graph.GetAllNeighbors(node_list, meta_info.node_type[1], format, &neighbors);
+    EXPECT_TRUE(s.IsOk());
+    s = csr_graph.GetAllNeighbors(node_list, meta_info.node_type[1], format, &csr_neighbors);
+    EXPECT_TRUE(s.IsOk());
+    EXPECT_EQ(neighbors->ToString(), csr_neighbors->ToString());
+  }
+
+  TensorRow features;
+  TensorRow csr_features;
+  s = graph.GetNodeFeature(nodes, meta_info.node_feature_type, &features);
+  EXPECT_TRUE(s.IsOk());
+  s = csr_graph.GetNodeFeature(nodes, meta_info.node_feature_type, &csr_features);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(features.size(), csr_features.size());
+  for (size_t i = 0; i < features.size(); ++i) {
+    EXPECT_EQ(features[i]->ToString(), csr_features[i]->ToString());
+  }
+
+  std::vector<std::pair<NodeIdType, NodeIdType>> src_dst_list = {{101, 201}, {103, 207}, {108, 208},
+                                                                 {110, 201}, {204, 105}, {208, 108}};
+  std::shared_ptr<Tensor> edges;
+  s = csr_graph.GetEdgesFromNodes(src_dst_list, &edges);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(edges->ToString() == "Tensor (shape: <6>, Type: int32)\n[1,9,17,19,31,37]");
+
+  edges.reset();
+  s = csr_graph.GetAllEdges(meta_info.edge_type[0], &edges);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<EdgeIdType> edge_list(edges->begin<EdgeIdType>(), edges->end<EdgeIdType>());
+  std::shared_ptr<Tensor> edge_nodes;
+  std::shared_ptr<Tensor> csr_edge_nodes;
+  s = graph.GetNodesFromEdges(edge_list, &edge_nodes);
+  EXPECT_TRUE(s.IsOk());
+  s = csr_graph.GetNodesFromEdges(edge_list, &csr_edge_nodes);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(edge_nodes->ToString(), csr_edge_nodes->ToString());
+
+  TensorRow edge_features;
+  s = csr_graph.GetEdgeFeature(edges, meta_info.edge_feature_type, &edge_features);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(edge_features[1]->ToString() ==
+              "Tensor (shape: <40>, Type: float32)\n"
+              "[0.1,0.2,0.3,0.4,0.5,0.6,0.7,0.8,0.9,1,1.1,1.2,1.3,1.4,1.5,1.6,1.7,1.8,1.9,2,2.1,2.2,2.3,2.4,2.5,2.6,2."
+              "7,2.8,2.9,3,3.1,3.2,3.3,3.4,3.5,3.6,3.7,3.8,3.9,4]");
+
+  std::shared_ptr<Tensor> neighbors;
+  s = csr_graph.GetSampledNeighbors({301}, {10}, {meta_info.node_type[1]}, SamplingStrategy::kRandom, &neighbors);
+  EXPECT_TRUE(s.ToString().find("Invalid node id:301") != std::string::npos);
+  s = csr_graph.GetNegSampledNeighbors(node_list, 3, meta_info.node_type[1], &neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(neighbors->shape().ToString() == "<10,4>");
+}
+
+/// Feature: CSR storage format of GraphDataImpl.
+/// Description: sample the neighbors of the CSR graph randomly and by edge weight.
+/// Expectation: the random sampling is uniform and the weighted sampling follows the edge weight with the alias table.
+TEST_F(MindDataTestGNNGraph, TestCsrSampledNeighbors) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  GraphDataImpl graph(path, 1, false, GraphStorageFormat::kCsr);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+
+  MetaInfo meta_info;
+  s = graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+
+  std::shared_ptr<Tensor> neighbors;
+  NodeNeighborsMap random_neighbors;
+  NodeNeighborsMap weight_neighbors;
+  for (int count = 0; count < 1000; ++count) {
+    neighbors.reset();
+    s = graph.GetSampledNeighbors({103}, {10}, {meta_info.node_type[1]}, SamplingStrategy::kRandom, &neighbors);
+    EXPECT_TRUE(s.IsOk());
+    EXPECT_TRUE(neighbors->shape().ToString() == "<1,11>");
+    ParsingNeighbors(neighbors, random_neighbors);
+    neighbors.reset();
+    s = graph.GetSampledNeighbors({103}, {10}, {meta_info.node_type[1]}, SamplingStrategy::kEdgeWeight, &neighbors);
+    EXPECT_TRUE(s.IsOk());
+    ParsingNeighbors(neighbors, weight_neighbors);
+  }
+  CheckNeighborsRatio(random_neighbors[103], {1, 1, 1, 1, 1});
+  CheckNeighborsRatio(weight_neighbors[103], {3, 5, 6, 7, 8});
+
+  neighbors.reset();
+  s = graph.GetSampledNeighbors({103}, {2, 3}, {meta_info.node_type[1], meta_info.node_type[0]},
+                                SamplingStrategy::kRandom, &neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(neighbors->shape().ToString() == "<1,9>");
+}
+
+/// Feature: CSR storage format of GraphDataImpl.
+/// Description: random walk on the CSR graph.
+/// Expectation: the walk path has the same shape as the default graph.
+TEST_F(MindDataTestGNNGraph, TestCsrRandomWalk) {
+  std::string path = "data/mindrecord/testGraphData/sns";
+  GraphDataImpl graph(path, 1, false, GraphStorageFormat::kCsr);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+
+  MetaInfo meta_info;
+  s = graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+
+  std::shared_ptr<Tensor> nodes;
+  s = graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<NodeIdType> node_list(nodes->begin<NodeIdType>(), nodes->end<NodeIdType>());
+  std::vector<NodeType> meta_path(59, 1);
+  std::shared_ptr<Tensor> walk_path;
+  s = graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &walk_path);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
+}
+
+/// Feature: graph snapshot of GraphDataImpl.
+/// Description: save the CSR graph into a snapshot and load the snapshot as the dataset file.
+/// Expectation: the graph loaded from the snapshot returns the same meta info, neighbors and features.
+TEST_F(MindDataTestGNNGraph, TestGraphSnapshot) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  std::string snapshot_path = "./gnn_graph_test.snapshot";
+  GraphDataImpl graph(path, 1, false, GraphStorageFormat::kCsr);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+  s = graph.SaveSnapshot(snapshot_path);
+  EXPECT_TRUE(s.IsOk());
+
+  GraphDataImpl snapshot_graph(snapshot_path, 1);
+  s = snapshot_graph.Init();
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(graph.GetDataSchema(), snapshot_graph.GetDataSchema());
+
+  MetaInfo meta_info;
+  MetaInfo snapshot_meta_info;
+  s = graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+  s = snapshot_graph.GetMetaInfo(&snapshot_meta_info);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(meta_info.node_type, snapshot_meta_info.node_type);
+  EXPECT_EQ(meta_info.edge_type, snapshot_meta_info.edge_type);
+  EXPECT_EQ(meta_info.node_num, snapshot_meta_info.node_num);
+  EXPECT_EQ(meta_info.edge_num, snapshot_meta_info.edge_num);
+  EXPECT_EQ(meta_info.node_feature_type, snapshot_meta_info.node_feature_type);
+  EXPECT_EQ(meta_info.edge_feature_type, snapshot_meta_info.edge_feature_type);
+
+  std::shared_ptr<Tensor> nodes;
+  s = snapshot_graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<NodeIdType> node_list(nodes->begin<NodeIdType>(), nodes->end<NodeIdType>());
+  std::shared_ptr<Tensor> neighbors;
+  std::shared_ptr<Tensor> snapshot_neighbors;
+  s = graph.GetAllNeighbors(node_list, meta_info.node_type[1], OutputFormat::kNormal, &neighbors);
+  EXPECT_TRUE(s.IsOk());
+  s = snapshot_graph.GetAllNeighbors(node_list, meta_info.node_type[1], OutputFormat::kNormal, &snapshot_neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(neighbors->ToString(), snapshot_neighbors->ToString());
+
+  // The default feature recreated from the snapshot is returned for kDefaultNodeId.
+  std::shared_ptr<Tensor> feature_nodes;
+  s = Tensor::CreateFromVector(std::vector<NodeIdType>{101, 102, kDefaultNodeId}, &feature_nodes);
+  EXPECT_TRUE(s.IsOk());
+  TensorRow features;
+  TensorRow snapshot_features;
+  s = graph.GetNodeFeature(feature_nodes, meta_info.node_feature_type, &features);
+  EXPECT_TRUE(s.IsOk());
+  s = snapshot_graph.GetNodeFeature(feature_nodes, meta_info.node_feature_type, &snapshot_features);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(features.size(), snapshot_features.size());
+  for (size_t i = 0; i < features.size(); ++i) {
+    EXPECT_EQ(features[i]->ToString(), snapshot_features[i]->ToString());
+  }
+
+  std::shared_ptr<Tensor> edges;
+  s = snapshot_graph.GetAllEdges(meta_info.edge_type[0], &edges);
+  EXPECT_TRUE(s.IsOk());
+  TensorRow edge_features;
+  TensorRow snapshot_edge_features;
+  s = graph.GetEdgeFeature(edges, meta_info.edge_feature_type, &edge_features);
+  EXPECT_TRUE(s.IsOk());
+  s = snapshot_graph.GetEdgeFeature(edges, meta_info.edge_feature_type, &snapshot_edge_features);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(edge_features.size(), snapshot_edge_features.size());
+  for (size_t i = 0; i < edge_features.size(); ++i) {
+    EXPECT_EQ(edge_features[i]->ToString(), snapshot_edge_features[i]->ToString());
+  }
+
+  // The snapshot is only saved in CSR storage format.
+  GraphDataImpl default_graph(path, 1);
+  s = default_graph.Init();
+  EXPECT_TRUE(s.IsOk());
+  s = default_graph.SaveSnapshot(snapshot_path);
+  EXPECT_FALSE(s.IsOk());
+  (void)remove(snapshot_path.c_str());
+}
+
+namespace {
+// The arrays of a CSR graph snapshot with two nodes, an edge from the first node to the second one, and a feature of
+// each node.
+struct CsrSnapshotArrays {
+  std::vector<NodeIdType> node_ids = {1, 2};
+  std::vector<NodeType> node_types = {0, 0};
+  std::vector<EdgeIdType> edge_ids = {10};
+  std::vector<EdgeType> edge_types = {0};
+  std::vector<int32_t> edge_src = {0};
+  std::vector<int32_t> edge_dst = {1};
+  std::vector<int64_t> offsets = {0, 1, 1};
+  std::vector<int32_t> neighbors = {1};
+  std::vector<int32_t> edges = {0};
+  std::vector<float> alias_prob = {1};
+  std::vector<int32_t> alias_slot = {0};
+  std::vector<int32_t> feature_values = {5, 6};
+  std::vector<int32_t> feature_rows = {0, 1};
+};
+
+Status SaveCsrSnapshot(const CsrSnapshotArrays &arrays, const std::string &path) {
+  GraphSnapshotWriter writer(path);
+  RETURN_IF_NOT_OK(writer.Open());
+  RETURN_IF_NOT_OK(writer.Write("csr/node_ids", arrays.node_ids));
+  RETURN_IF_NOT_OK(writer.Write("csr/node_types", arrays.node_types));
+  RETURN_IF_NOT_OK(writer.Write("csr/edge_ids", arrays.edge_ids));
+  RETURN_IF_NOT_OK(writer.Write("csr/edge_types", arrays.edge_types));
+  RETURN_IF_NOT_OK(writer.Write("csr/edge_src", arrays.edge_src));
+  RETURN_IF_NOT_OK(writer.Write("csr/edge_dst", arrays.edge_dst));
+  RETURN_IF_NOT_OK(writer.Write("csr/adjacency_types", std::vector<NodeType>{0}));
+  RETURN_IF_NOT_OK(writer.Write("csr/adjacency/0/offsets", arrays.offsets));
+  RETURN_IF_NOT_OK(writer.Write("csr/adjacency/0/neighbors", arrays.neighbors));
+  RETURN_IF_NOT_OK(writer.Write("csr/adjacency/0/edges", arrays.edges));
+  RETURN_IF_NOT_OK(writer.Write("csr/adjacency/0/alias_prob", arrays.alias_prob));
+  RETURN_IF_NOT_OK(writer.Write("csr/adjacency/0/alias_slot", arrays.alias_slot));
+  RETURN_IF_NOT_OK(writer.Write("csr/node_feature_types", std::vector<FeatureType>{1}));
+  RETURN_IF_NOT_OK(writer.Write("csr/node_feature/1/meta", std::vector<uint64_t>{DataType::DE_INT32, sizeof(int32_t)}));
+  RETURN_IF_NOT_OK(writer.WriteBlock("csr/node_feature/1/values", arrays.feature_values.data(),
+                                     arrays.feature_values.size() * sizeof(int32_t)));
+  RETURN_IF_NOT_OK(writer.Write("csr/node_feature/1/rows", arrays.feature_rows));
+  RETURN_IF_NOT_OK(writer.Write("csr/edge_feature_types", std::vector<FeatureType>{}));
+  return writer.Close();
+}
+
+Status LoadCsrSnapshot(const std::string &path) {
+  auto reader = std::make_shared<GraphSnapshotReader>(path);
+  RETURN_IF_NOT_OK(reader->Open());
+  CsrGraph graph;
+  return graph.Load(reader);
+}
+}  // namespace
+
+/// Feature: graph snapshot of CsrGraph.
+/// Description: load the snapshots whose indexes, offsets or directory are out of range.
+/// Expectation: the valid snapshot is loaded, and an error is returned for each broken one.
+TEST_F(MindDataTestGNNGraph, TestCsrSnapshotBoundsCheck) {
+  std::string snapshot_path = "./gnn_csr_bounds_test.snapshot";
+  CsrSnapshotArrays valid_arrays;
+  ASSERT_OK(SaveCsrSnapshot(valid_arrays, snapshot_path));
+  EXPECT_OK(LoadCsrSnapshot(snapshot_path));
+
+  std::vector<std::function<void(CsrSnapshotArrays *)>> breakers = {
+    [](CsrSnapshotArrays *arrays) { arrays->edge_src = {2}; },
+    [](CsrSnapshotArrays *arrays) { arrays->neighbors = {-1}; },
+    [](CsrSnapshotArrays *arrays) { arrays->edges = {1}; },
+    [](CsrSnapshotArrays *arrays) { arrays->offsets = {0, 2, 1}; },
+    [](CsrSnapshotArrays *arrays) { arrays->offsets = {1, 1, 1}; },
+    [](CsrSnapshotArrays *arrays) { arrays->alias_slot = {1}; },
+    [](CsrSnapshotArrays *arrays) { arrays->feature_rows = {0, 2}; },
+    [](CsrSnapshotArrays *arrays) { arrays->feature_rows = {-2, 1}; },
+  };
+  for (size_t i = 0; i < breakers.size(); ++i) {
+    CsrSnapshotArrays arrays;
+    breakers[i](&arrays);
+    ASSERT_OK(SaveCsrSnapshot(arrays, snapshot_path));
+    EXPECT_FALSE(LoadCsrSnapshot(snapshot_path).IsOk()) << "The broken snapshot " << i << " is loaded.";
+  }
+
+  // The size of the first block in the directory makes its end overflow.
+  ASSERT_OK(SaveCsrSnapshot(valid_arrays, snapshot_path));
+  std::fstream file(snapshot_path, std::ios::in | std::ios::out | std::ios::binary);
+  uint64_t directory_offset = 0;
+  (void)file.seekg(kSnapshotMagicSize + sizeof(uint32_t) * 2);
+  (void)file.read(reinterpret_cast<char *>(&directory_offset), sizeof(directory_offset));
+  uint64_t block_size = std::numeric_limits<uint64_t>::max();
+  (void)file.seekp(directory_offset + sizeof(uint64_t));
+  (void)file.write(reinterpret_cast<const char *>(&block_size), sizeof(block_size));
+  file.close();
+  GraphSnapshotReader reader(snapshot_path);
+  EXPECT_ERROR(reader.Open());
+  (void)remove(snapshot_path.c_str());
+}
+
+/// Feature: batched neighbor sampling of GraphDataImpl.
+/// Description: sample two hops of neighbors of many nodes with several workers on the CSR graph.
+/// Expectation: each node row is written in place, and every sampled neighbor is adjacent to its input node.
+TEST_F(MindDataTestGNNGraph, TestCsrParallelSampledNeighbors) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  GraphDataImpl graph(path, 4, false, GraphStorageFormat::kCsr);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+
+  MetaInfo meta_info;
+  s = graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<Tensor> nodes;
+  s = graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<NodeIdType> all_nodes(nodes->begin<NodeIdType>(), nodes->end<NodeIdType>());
+  std::vector<NodeIdType> node_list;
+  const int kRepeat = 20;
+  for (int i = 0; i < kRepeat; ++i) {
+    node_list.insert(node_list.end(), all_nodes.begin(), all_nodes.end());
+  }
+
+  const NodeIdType kFirstHop = 3;
+  const NodeIdType kSecondHop = 2;
+  std::shared_ptr<Tensor> neighbors;
+  s = graph.GetSampledNeighbors(node_list, {kFirstHop, kSecondHop}, {meta_info.node_type[1], meta_info.node_type[0]},
+                                SamplingStrategy::kRandom, &neighbors);
+  EXPECT_TRUE(s.IsOk());
+  const size_t row_size = 1 + kFirstHop + kFirstHop * kSecondHop;
+  EXPECT_EQ(neighbors->shape().ToString(),
+            "<" + std::to_string(node_list.size()) + "," + std::to_string(row_size) + ">");
+
+  auto is_neighbor = [&graph](NodeIdType src, NodeIdType dst, NodeType type) {
+    std::shared_ptr<Tensor> all_neighbors;
+    Status rc = graph.GetAllNeighbors({src}, type, OutputFormat::kNormal, &all_neighbors);
+    return rc.IsOk() && std::find(all_neighbors->begin<NodeIdType>() + 1, all_neighbors->end<NodeIdType>(), dst) !=
+                          all_neighbors->end<NodeIdType>();
+  };
+  std::vector<NodeIdType> result(neighbors->begin<NodeIdType>(), neighbors->end<NodeIdType>());
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    const NodeIdType *row = result.data() + i * row_size;
+    EXPECT_EQ(row[0], node_list[i]);
+    for (NodeIdType k = 0; k < kFirstHop; ++k) {
+      NodeIdType hop1 = row[1 + k];
+      EXPECT_TRUE(hop1 == kDefaultNodeId || is_neighbor(row[0], hop1, meta_info.node_type[1]));
+      for (NodeIdType j = 0; j < kSecondHop; ++j) {
+        NodeIdType hop2 = row[1 + kFirstHop + k * kSecondHop + j];
+        EXPECT_TRUE(hop2 == kDefaultNodeId || is_neighbor(hop1, hop2, meta_info.node_type[0]));
+      }
+    }
+  }
+}
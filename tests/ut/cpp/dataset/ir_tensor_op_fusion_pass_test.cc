@@ -97,3 +97,38 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResizeEnabled) {
   // EXPECT_EQ(++func_it, tfuncs.end());
 }
 
+
+/// Feature: TensorOpFusionPass
+/// Description: Map Normalize, HWC2CHW and TypeCast to float16 with the IR optimization pass enabled
+/// Expectation: The three ops are fused into NormalizeHwcToChw, the op before them is kept
+TEST_F(MindDataTestTensorOpFusionPass, NormalizeHwcToChwEnabled) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-NormalizeHwcToChwEnabled";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 11));
+
+  // Create objects for the tensor ops
+  std::shared_ptr<TensorTransform> resize(new vision::Resize({32, 32}));
+  std::shared_ptr<TensorTransform> normalize(new vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0}));
+  std::shared_ptr<TensorTransform> hwc2chw(new vision::HWC2CHW());
+  std::shared_ptr<TensorTransform> type_cast(new transforms::TypeCast(mindspore::DataType::kNumberTypeFloat16));
+  ds = ds->Map({resize, normalize, hwc2chw, type_cast}, {"image"});
+
+  std::shared_ptr<DatasetNode> node = ds->IRNode();
+  auto ir_tree = std::make_shared<TreeAdapter>();
+  // Enable IR optimization pass
+  ir_tree->SetOptimize(true);
+  Status rc;
+  rc = ir_tree->Compile(node);
+  EXPECT_TRUE(rc);
+  auto root_op = ir_tree->GetRoot();
+
+  auto tree = std::make_shared<ExecutionTree>();
+  auto it = tree->begin(static_cast<std::shared_ptr<DatasetOp>>(root_op));
+  ++it;
+  auto *map_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(map_op)->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 2);
+  EXPECT_EQ(tfuncs[0]->Name(), kResizeOp);
+  EXPECT_EQ(tfuncs[1]->Name(), kNormalizeHwcToChwOp);
+}
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/connector.h"
+#include "minddata/dataset/engine/jagged_connector.h"
+#include "minddata/dataset/engine/lock_free_connector.h"
+#include "minddata/dataset/util/ring_buffer.h"
+#include "minddata/dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestLockFreeConnector : public UT::Common {};
+
+namespace {
+// Producer worker_id pushes the elements worker_id, worker_id + num_producers, ... so the whole input is pushed in
+// round robin order of the workers.
+template <typename ConnectorType>
+Status ProduceRoundRobin(int32_t worker_id, int32_t num_producers, uint64_t num_elements, ConnectorType *conn) {
+  TaskManager::FindMe()->Post();
+  for (uint64_t i = worker_id; i < num_elements; i += num_producers) {
+    RETURN_IF_NOT_OK(conn->Push(worker_id, i));
+  }
+  return Status::OK();
+}
+
+// Consumer worker_id pops every num_consumers-th element and checks it gets them in order.
+template <typename ConnectorType>
+Status ConsumeRoundRobin(int32_t worker_id, int32_t num_consumers, uint64_t num_elements, ConnectorType *conn) {
+  TaskManager::FindMe()->Post();
+  for (uint64_t expected = worker_id; expected < num_elements; expected += num_consumers) {
+    uint64_t el = 0;
+    RETURN_IF_NOT_OK(conn->Pop(worker_id, &el));
+    CHECK_FAIL_RETURN_UNEXPECTED(el == expected, "Expect " + std::to_string(expected) + ", but got " +
+                                                   std::to_string(el) + " from consumer " + std::to_string(worker_id));
+  }
+  return Status::OK();
+}
+
+// Run the producers and the consumers through the connector, and return the rows per second.
+template <typename ConnectorType>
+Status RunConnector(int32_t num_producers, int32_t num_consumers, uint64_t num_elements, double *rows_per_second) {
+  auto conn = std::make_unique<ConnectorType>(num_producers, num_consumers, 16);
+  TaskGroup vg;
+  RETURN_IF_NOT_OK(conn->Register(&vg));
+  auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < num_producers; ++i) {
+    RETURN_IF_NOT_OK(vg.CreateAsyncTask(
+      "Producer", std::bind(&ProduceRoundRobin<ConnectorType>, i, num_producers, num_elements, conn.get())));
+  }
+  for (int32_t i = 0; i < num_consumers; ++i) {
+    RETURN_IF_NOT_OK(vg.CreateAsyncTask(
+      "Consumer", std::bind(&ConsumeRoundRobin<ConnectorType>, i, num_consumers, num_elements, conn.get())));
+  }
+  RETURN_IF_NOT_OK(vg.join_all());
+  RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  *rows_per_second = static_cast<double>(num_elements) / elapsed.count();
+  return Status::OK();
+}
+}  // namespace
+
+/// Feature: SpscRingBuffer
+/// Description: Push and pop single elements and batches across the end of the ring
+/// Expectation: The elements come out in order, a batch is cut to the free space and the data available
+TEST_F(MindDataTestLockFreeConnector, TestSpscRingBuffer) {
+  SpscRingBuffer<int32_t> ring(6);
+  EXPECT_EQ(ring.capacity(), 8);
+  std::vector<int32_t> in = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_EQ(ring.TryPush(in.data(), 5), 5);
+  std::vector<int32_t> out(10, -1);
+  EXPECT_EQ(ring.TryPop(out.data(), 3), 3);
+  EXPECT_EQ(out[2], 2);
+  // 2 elements left, 6 slots free and the push wraps around the end of the ring
+  EXPECT_EQ(ring.TryPush(in.data() + 5, 5), 5);
+  EXPECT_EQ(ring.TryPush(in.data(), 5), 1);
+  EXPECT_EQ(ring.size(), 8);
+  EXPECT_EQ(ring.TryPop(out.data(), 10), 8);
+  std::vector<int32_t> expected = {3, 4, 5, 6, 7, 8, 9, 0};
+  EXPECT_EQ(std::vector<int32_t>(out.begin(), out.begin() + 8), expected);
+  int32_t el = 0;
+  EXPECT_FALSE(ring.TryPop(&el));
+}
+
+/// Feature: LockFreeConnector
+/// Description: Push from 4 producers and pop from 3 consumers, then push and pop in batches
+/// Expectation: Each consumer gets its share of the elements in round robin order
+TEST_F(MindDataTestLockFreeConnector, TestOrder) {
+  double rows_per_second = 0;
+  ASSERT_OK(RunConnector<LockFreeConnector<uint64_t>>(4, 3, 3000, &rows_per_second));
+  ASSERT_OK(RunConnector<LockFreeConnector<uint64_t>>(1, 1, 3000, &rows_per_second));
+
+  LockFreeConnector<uint64_t> conn(1, 1, 8);
+  std::vector<uint64_t> batch = {0, 1, 2, 3, 4};
+  ASSERT_OK(conn.PushBatch(0, &batch));
+  EXPECT_TRUE(batch.empty());
+  ASSERT_OK(conn.Push(0, 5));
+  std::vector<uint64_t> result;
+  ASSERT_OK(conn.PopBatch(0, 4, &result));
+  EXPECT_EQ(result, std::vector<uint64_t>({0, 1, 2, 3}));
+  ASSERT_OK(conn.PopBatch(0, 4, &result));
+  EXPECT_EQ(result, std::vector<uint64_t>({4, 5}));
+  EXPECT_EQ(conn.out_rows_count(), 6);
+}
+
+/// Feature: JaggedConnector
+/// Description: Pass the rows of 4 producers with different row counts, with enable_lock_free_connector off and on
+/// Expectation: The rows are popped in the same order, the producers are skipped after their EOE in both cases
+TEST_F(MindDataTestLockFreeConnector, TestJaggedConnector) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  const std::vector<int64_t> row_counts = {5, 0, 9, 2};
+  const auto num_producers = static_cast<int32_t>(row_counts.size());
+  std::vector<std::vector<int64_t>> popped_ids;
+  for (bool lock_free : {false, true}) {
+    cfg->set_enable_lock_free_connector(lock_free);
+    JaggedConnector conn(num_producers, 1, 2);
+    ASSERT_EQ(conn.IsLockFree(), lock_free);
+    TaskGroup vg;
+    ASSERT_OK(conn.Register(&vg));
+    for (int32_t i = 0; i < num_producers; ++i) {
+      ASSERT_OK(vg.CreateAsyncTask("Producer", [&conn, &row_counts, i]() -> Status {
+        TaskManager::FindMe()->Post();
+        for (int64_t k = 0; k < row_counts[i]; ++k) {
+          TensorRow row;
+          row.setId(i * 100 + k);
+          RETURN_IF_NOT_OK(conn.Add(i, std::move(row)));
+        }
+        return conn.Add(i, TensorRow(TensorRow::kFlagEOE));
+      }));
+    }
+    std::vector<int64_t> ids;
+    int32_t num_eoe = 0;
+    while (num_eoe < num_producers) {
+      TensorRow row;
+      ASSERT_OK(conn.Pop(0, &row));
+      if (row.eoe()) {
+        ++num_eoe;
+      } else {
+        ids.push_back(row.getId());
+      }
+    }
+    ASSERT_OK(vg.join_all());
+    EXPECT_EQ(ids.size(), 16);
+    // The rows of a producer are in order
+    for (size_t k = 1; k < ids.size(); ++k) {
+      if (ids[k] / 100 == ids[k - 1] / 100) {
+        EXPECT_LT(ids[k - 1], ids[k]);
+      }
+    }
+    popped_ids.push_back(ids);
+  }
+  EXPECT_EQ(popped_ids[0], popped_ids[1]);
+  cfg->set_enable_lock_free_connector(false);
+}
+
+/// Feature: LockFreeConnector
+/// Description: Microbenchmark of Connector and LockFreeConnector with 1 to 64 producers and a single consumer
+/// Expectation: All the elements are popped in order, the rows per second are logged
+/// It spins up to 64 threads for seconds, so it only runs with --gtest_also_run_disabled_tests
+TEST_F(MindDataTestLockFreeConnector, DISABLED_TestThroughput) {
+  const uint64_t num_elements = 100000;
+  for (int32_t num_workers = 1; num_workers <= 64; num_workers *= 2) {
+    double mutex_rows_per_second = 0;
+    double lock_free_rows_per_second = 0;
+    ASSERT_OK(RunConnector<Connector<uint64_t>>(num_workers, 1, num_elements, &mutex_rows_per_second));
+    ASSERT_OK(RunConnector<LockFreeConnector<uint64_t>>(num_workers, 1, num_elements, &lock_free_rows_per_second));
+    MS_LOG(INFO) << "Producers: " << num_workers << ", Connector: " << static_cast<int64_t>(mutex_rows_per_second)
+                 << " rows/s, LockFreeConnector: " << static_cast<int64_t>(lock_free_rows_per_second) << " rows/s.";
+  }
+}
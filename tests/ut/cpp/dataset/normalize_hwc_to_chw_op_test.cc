@@ -0,0 +1,94 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/data/data_utils.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestNormalizeHwcToChwOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestNormalizeHwcToChwOp() : CVOpCommon() {}
+
+ protected:
+  // Normalize, HwcToChw and TypeCast done one by one
+  void Expected(const std::shared_ptr<Tensor> &input, const std::vector<float> &mean, const std::vector<float> &std,
+                const DataType &output_type, std::shared_ptr<Tensor> *expected) {
+    std::shared_ptr<Tensor> normalized;
+    std::shared_ptr<Tensor> swapped;
+    ASSERT_OK(NormalizeOp(mean, std).Compute(input, &normalized));
+    ASSERT_OK(HwcToChwOp().Compute(normalized, &swapped));
+    ASSERT_OK(TypeCast(swapped, expected, output_type));
+  }
+};
+
+/// Feature: NormalizeHwcToChw op
+/// Description: Normalize the uint8 and float32 HWC image to float32 and float16 CHW images
+/// Expectation: The output is the same as Normalize followed by HwcToChw and TypeCast
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestOp) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestOp.";
+  std::vector<float> mean = {121.0, 115.0, 100.0};
+  std::vector<float> std = {70.0, 68.0, 71.0};
+  std::shared_ptr<Tensor> float_tensor;
+  ASSERT_OK(TypeCast(input_tensor_, &float_tensor, DataType(DataType::DE_FLOAT32)));
+
+  for (const auto &input : {input_tensor_, float_tensor}) {
+    for (auto type : {DataType::DE_FLOAT32, DataType::DE_FLOAT16}) {
+      NormalizeHwcToChwOp op(mean, std, DataType(type));
+      std::shared_ptr<Tensor> output;
+      ASSERT_OK(op.Compute(input, &output));
+      std::shared_ptr<Tensor> expected;
+      Expected(input, mean, std, DataType(type), &expected);
+      EXPECT_EQ(output->shape(), TensorShape({3, input->shape()[0], input->shape()[1]}));
+      EXPECT_EQ(output->type(), DataType(type));
+      EXPECT_TRUE(*output == *expected);
+    }
+  }
+}
+
+/// Feature: NormalizeHwcToChw op
+/// Description: Normalize a 2D image with a single mean and std, and an int32 image which is not fused
+/// Expectation: The output is the same as Normalize followed by HwcToChw and TypeCast
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestFallback) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestFallback.";
+  std::vector<float> mean = {120.0};
+  std::vector<float> std = {70.0};
+  std::shared_ptr<Tensor> gray_tensor;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<uint8_t>({0, 10, 20, 30, 40, 50}), TensorShape({2, 3}), &gray_tensor));
+  std::shared_ptr<Tensor> int_tensor;
+  ASSERT_OK(TypeCast(input_tensor_, &int_tensor, DataType(DataType::DE_INT32)));
+
+  for (const auto &input : {gray_tensor, int_tensor, input_tensor_}) {
+    NormalizeHwcToChwOp op(mean, std, DataType(DataType::DE_FLOAT16));
+    std::shared_ptr<Tensor> output;
+    ASSERT_OK(op.Compute(input, &output));
+    std::shared_ptr<Tensor> expected;
+    Expected(input, mean, std, DataType(DataType::DE_FLOAT16), &expected);
+    EXPECT_EQ(output->shape(), expected->shape());
+    EXPECT_TRUE(*output == *expected);
+
+    std::vector<TensorShape> output_shapes;
+    ASSERT_OK(op.OutputShape({input->shape()}, output_shapes));
+    EXPECT_EQ(output_shapes[0], output->shape());
+  }
+}
@@ -55,3 +55,34 @@ TEST_F(MindDataTestNormalizeOP, TestOp) {
   cv::FileStorage file(output_filename, cv::FileStorage::WRITE);
   file << "imageData" << cv_output_image;
 }
+
+/// Feature: NormalizeOp
+/// Description: normalize a batch of rows with BatchCompute, including the image which is not uint8
+/// Expectation: the outputs are the same as the outputs of Compute row by row
+TEST_F(MindDataTestNormalizeOP, TestBatchCompute) {
+  MS_LOG(INFO) << "Doing TestNormalizeOp::TestBatchCompute.";
+  std::vector<float> mean = {121.0, 115.0, 100.0};
+  std::vector<float> std = {70.0, 68.0, 71.0};
+  auto op = std::make_unique<NormalizeOp>(mean, std);
+  EXPECT_TRUE(op->SupportBatch());
+
+  std::shared_ptr<Tensor> float_tensor;
+  ASSERT_OK(Tensor::CreateEmpty(input_tensor_->shape(), DataType(DataType::DE_FLOAT32), &float_tensor));
+  auto in_itr = input_tensor_->begin<uint8_t>();
+  for (auto itr = float_tensor->begin<float>(); itr != float_tensor->end<float>(); ++itr, ++in_itr) {
+    *itr = static_cast<float>(*in_itr);
+  }
+  std::vector<TensorRow> input = {TensorRow(0, {input_tensor_}), TensorRow(1, {float_tensor}),
+                                  TensorRow(2, {input_tensor_})};
+  std::vector<TensorRow> output;
+  ASSERT_OK(op->BatchCompute(input, &output));
+  ASSERT_EQ(output.size(), input.size());
+  for (size_t i = 0; i < input.size(); i++) {
+    std::shared_ptr<Tensor> expected;
+    ASSERT_OK(op->Compute(input[i][0], &expected));
+    ASSERT_EQ(output[i].size(), 1);
+    EXPECT_EQ(output[i][0]->shape(), expected->shape());
+    EXPECT_EQ(output[i][0]->type(), expected->type());
+    EXPECT_TRUE(*output[i][0] == *expected);
+  }
+}
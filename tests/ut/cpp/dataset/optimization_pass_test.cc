@@ -20,6 +20,8 @@
 #include "common/common.h"
 #include "gtest/gtest.h"
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
@@ -29,8 +31,10 @@
 #include "minddata/dataset/include/dataset/vision_lite.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/resize_ir.h"
 
 using namespace mindspore::dataset;
 using mindspore::LogStream;
@@ -111,3 +115,34 @@ TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassPreBuiltTensorO
   ASSERT_EQ(fused_ops.size(), 1);
   ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeOp);
 }
+
+/// Feature: TensorOpFusionPass
+/// Description: Run the fusion pass on Decode followed by Resize with enable_jpeg_dct_scaling off and on
+/// Expectation: The two ops are fused into DecodeResize only if enable_jpeg_dct_scaling is on
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassDecodeResize) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassDecodeResize.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  for (bool enable : {false, true}) {
+    cfg->set_enable_jpeg_dct_scaling(enable);
+    std::shared_ptr<Dataset> root =
+      ImageFolder(folder_path, false)->Map({vision::Decode(), vision::Resize({100, 100})}, {"image"});
+    TensorOpFusionPass fusion_pass;
+    bool modified = false;
+    std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+    ASSERT_NE(map_node, nullptr);
+    // no deepcopy is performed because this doesn't go through tree_adapter
+    ASSERT_OK(fusion_pass.Run(root->IRNode(), &modified));
+    EXPECT_EQ(modified, enable);
+    auto ops = map_node->operations();
+    if (enable) {
+      ASSERT_EQ(ops.size(), 1);
+      EXPECT_EQ(ops[0]->Name(), vision::kDecodeResizeOperation);
+    } else {
+      ASSERT_EQ(ops.size(), 2);
+      EXPECT_EQ(ops[0]->Name(), vision::kDecodeOperation);
+      EXPECT_EQ(ops[1]->Name(), vision::kResizeOperation);
+    }
+  }
+  cfg->set_enable_jpeg_dct_scaling(false);
+}
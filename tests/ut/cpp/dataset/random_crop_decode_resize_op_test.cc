@@ -158,3 +158,49 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp1) {
   }
   MS_LOG(INFO) << "RandomCropDecodeResizeOp test 2 finished";
 }
+
+/// Feature: RandomCropDecodeResize op
+/// Description: Crop, decode and resize the jpeg image to a small target with DCT downscaling enabled
+/// Expectation: The output has the target shape and is close to the output of Decode followed by RandomResizedCrop
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp3) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeOp-TestOp3.";
+  constexpr int target_height = 224;
+  constexpr int target_width = 224;
+  constexpr float scale_lb = 0.5;
+  constexpr float scale_ub = 1.0;
+  constexpr float aspect_lb = 0.75;
+  constexpr float aspect_ub = 1.333333;
+  // The area interpolation averages the pixels like the scaled IDCT, so the difference only comes from the decoder
+  const InterpolationMode interpolation = InterpolationMode::kArea;
+  constexpr uint32_t max_iter = 10;
+  constexpr double kMeanDiffThreshold = 10.0;
+
+  auto crop_and_decode = RandomCropDecodeResizeOp(target_height, target_width, scale_lb, scale_ub, aspect_lb, aspect_ub,
+                                                  interpolation, max_iter);
+  auto crop_and_decode_copy = crop_and_decode;
+  auto decode_and_crop = static_cast<RandomCropAndResizeOp>(crop_and_decode_copy);
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  cfg->set_seed(42);
+  cfg->set_enable_jpeg_dct_scaling(true);
+  TensorRow input_tensor_row_decode = {raw_input_tensor_};
+  TensorRow input_tensor_row = {input_tensor_};
+  for (int k = 0; k < 5; k++) {
+    TensorRow output_tensor_row_decode;
+    TensorRow output_tensor_row;
+    ASSERT_OK(crop_and_decode.Compute(input_tensor_row_decode, &output_tensor_row_decode));
+    ASSERT_OK(decode_and_crop.Compute(input_tensor_row, &output_tensor_row));
+    EXPECT_EQ(output_tensor_row_decode[0]->shape(), TensorShape({target_height, target_width, 3}));
+    cv::Mat output1 = CVTensor::AsCVTensor(output_tensor_row_decode[0])->mat();
+    cv::Mat output2 = CVTensor::AsCVTensor(output_tensor_row[0])->mat();
+    double diff_sum = 0;
+    for (int i = 0; i < target_height; i++) {
+      for (int j = 0; j < target_width; j++) {
+        diff_sum += std::abs(output1.at<cv::Vec3b>(i, j)[1] - output2.at<cv::Vec3b>(i, j)[1]);
+      }
+    }
+    double mean_diff = diff_sum / (target_height * target_width);
+    MS_LOG(INFO) << "mean diff: " << mean_diff;
+    EXPECT_LT(mean_diff, kMeanDiffThreshold);
+  }
+  cfg->set_enable_jpeg_dct_scaling(false);
+}
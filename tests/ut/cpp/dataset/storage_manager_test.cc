@@ -0,0 +1,311 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common.h"
+#include "minddata/dataset/engine/cache/storage_manager.h"
+#include "minddata/dataset/util/services.h"
+
+using namespace mindspore::dataset;
+
+namespace mindspore {
+namespace dataset {
+namespace test {
+/// StorageManager which lets the test look into the read ahead tier
+class TestStorageManager : public StorageManager {
+ public:
+  explicit TestStorageManager(const Path &root) : StorageManager(root, 1) {}
+
+  TestStorageManager(const Path &root, size_t read_ahead_budget, int32_t num_read_ahead_tasks)
+      : StorageManager(root, 1, read_ahead_budget, num_read_ahead_tasks) {}
+
+  ~TestStorageManager() override = default;
+
+  /// Wait until all the reads ahead are done
+  void WaitReadAhead() {
+    std::unique_lock<std::mutex> lck(read_ahead_mux_);
+    read_ahead_cv_.wait(lck, [this]() { return read_ahead_pending_ == 0; });
+  }
+
+  bool IsReadAhead(key_type key) {
+    std::unique_lock<std::mutex> lck(read_ahead_mux_);
+    return read_ahead_entries_.find(key) != read_ahead_entries_.end();
+  }
+
+  bool IsReady(key_type key) {
+    std::unique_lock<std::mutex> lck(read_ahead_mux_);
+    auto it = read_ahead_entries_.find(key);
+    return it != read_ahead_entries_.end() && it->second.ready;
+  }
+
+  /// Number of the buffers the rows in the tier are read into, one for each run
+  size_t NumReadAheadBuffers() {
+    std::unique_lock<std::mutex> lck(read_ahead_mux_);
+    std::set<uint8_t *> bufs;
+    for (const auto &entry : read_ahead_entries_) {
+      bufs.insert(entry.second.buf.get());
+    }
+    return bufs.size();
+  }
+
+  /// The read ahead tasks read the containers under a shared lock, so they stall while we hold it exclusively
+  void StallReadAhead() { rw_lock_.LockExclusive(); }
+
+  void ResumeReadAhead() { rw_lock_.Unlock(); }
+};
+
+class MindDataTestStorageManager : public UT::Common {
+ protected:
+  void SetUp() override {
+    ASSERT_OK(Services::CreateInstance());
+    ASSERT_OK(root_.CreateDirectory());
+  }
+
+  void TearDown() override {
+    if (sm_ != nullptr) {
+      EXPECT_OK(sm_->ServiceStop());
+      sm_.reset();
+    }
+    Path container = root_ / "IMG00000.LB";
+    EXPECT_OK(container.Remove());
+    EXPECT_OK(root_.Remove());
+  }
+
+  void CreateStorageManager(size_t read_ahead_budget, int32_t num_read_ahead_tasks = 1) {
+    sm_ = std::make_unique<TestStorageManager>(root_, read_ahead_budget, num_read_ahead_tasks);
+    ASSERT_OK(sm_->ServiceStart());
+  }
+
+  /// Bytes of the i-th row, a misplaced byte shows up as a different value
+  std::string MakeRow(int i, size_t sz) {
+    std::string row(sz, 0);
+    for (size_t j = 0; j < sz; ++j) {
+      row[j] = static_cast<char>((i * 31 + j) & 0xff);
+    }
+    return row;
+  }
+
+  void WriteRows(const std::vector<size_t> &sizes) {
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      rows_.push_back(MakeRow(i, sizes[i]));
+      StorageManager::key_type key;
+      ASSERT_OK(sm_->Write(&key, {ReadableSlice(rows_.back().data(), rows_.back().size())}));
+      keys_.push_back(key);
+    }
+  }
+
+  /// Read the i-th row, and compare it with what was written, or with zeros if it is read from the disk after
+  /// ZeroContainer
+  void ExpectRow(int i, bool from_disk) {
+    std::string out(rows_[i].size(), 1);
+    WritableSlice dest(out.data(), out.size());
+    size_t bytes_read = 0;
+    ASSERT_OK(sm_->Read(keys_[i], &dest, &bytes_read));
+    EXPECT_EQ(bytes_read, rows_[i].size());
+    EXPECT_TRUE(out == (from_disk ? std::string(out.size(), 0) : rows_[i])) << "row " << i;
+  }
+
+  /// Overwrite the container with zeros, so a row read from the disk from now on is different from the one written
+  void ZeroContainer() {
+    std::fstream fs((root_ / "IMG00000.LB").ToString(), std::ios::in | std::ios::out | std::ios::binary);
+    ASSERT_TRUE(fs.is_open());
+    fs.seekg(0, std::ios::end);
+    std::string zeros(static_cast<size_t>(fs.tellg()), 0);
+    fs.seekp(0);
+    fs.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+    fs.flush();
+  }
+
+  Path root_ = Path("./storage_manager_test");
+  std::unique_ptr<TestStorageManager> sm_;
+  std::vector<std::string> rows_;
+  std::vector<StorageManager::key_type> keys_;
+};
+
+/// Feature: StorageManager read ahead
+/// Description: Test that the rows read ahead are copied from memory, and the others are read from the disk
+/// Expectation: The rows read ahead are intact after the container is overwritten, the others come from the disk
+TEST_F(MindDataTestStorageManager, TestReadFromReadAhead) {
+  MS_LOG(INFO) << "Doing MindDataTestStorageManager-TestReadFromReadAhead.";
+  CreateStorageManager(1024 * 1024);
+  WriteRows({1000, 1100, 1200, 1300, 1400, 1500, 1600, 1700});
+  ASSERT_OK(sm_->ReadAhead({keys_[0], keys_[1], keys_[2], keys_[3]}));
+  sm_->WaitReadAhead();
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(sm_->IsReady(keys_[i]));
+  }
+  EXPECT_FALSE(sm_->IsReadAhead(keys_[4]));
+  ZeroContainer();
+  for (int i = 0; i < 4; ++i) {
+    ExpectRow(i, false);
+    // A row can be read again from the tier
+    ExpectRow(i, false);
+  }
+  // Not read ahead, falls back to pread
+  for (int i = 4; i < 8; ++i) {
+    ExpectRow(i, true);
+  }
+}
+
+/// Feature: StorageManager read ahead
+/// Description: Test that the read ahead is turned off by a zero budget
+/// Expectation: The rows are read from the disk
+TEST_F(MindDataTestStorageManager, TestReadAheadOff) {
+  MS_LOG(INFO) << "Doing MindDataTestStorageManager-TestReadAheadOff.";
+  CreateStorageManager(0);
+  WriteRows({1000, 2000});
+  ASSERT_OK(sm_->ReadAhead(keys_));
+  EXPECT_FALSE(sm_->IsReadAhead(keys_[0]));
+  ExpectRow(0, false);
+  ZeroContainer();
+  ExpectRow(1, true);
+}
+
+/// Feature: StorageManager read ahead
+/// Description: Test that the read ahead is off if no budget is given
+/// Expectation: Nothing is read ahead, and the rows are read from the disk
+TEST_F(MindDataTestStorageManager, TestReadAheadOffByDefault) {
+  MS_LOG(INFO) << "Doing MindDataTestStorageManager-TestReadAheadOffByDefault.";
+  sm_ = std::make_unique<TestStorageManager>(root_);
+  ASSERT_OK(sm_->ServiceStart());
+  WriteRows({1000, 2000});
+  ASSERT_OK(sm_->ReadAhead(keys_));
+  EXPECT_FALSE(sm_->IsReadAhead(keys_[0]));
+  EXPECT_FALSE(sm_->IsReadAhead(keys_[1]));
+  ZeroContainer();
+  ExpectRow(0, true);
+  ExpectRow(1, true);
+}
+
+/// Feature: StorageManager read ahead
+/// Description: Test that a read of a row being read ahead waits for it rather than reading the disk
+/// Expectation: The read blocks while the read ahead is stalled, and returns the row when it is done
+TEST_F(MindDataTestStorageManager, TestWaitForReadAhead) {
+  MS_LOG(INFO) << "Doing MindDataTestStorageManager-TestWaitForReadAhead.";
+  CreateStorageManager(1024 * 1024);
+  WriteRows({3000, 3000, 3000});
+  sm_->StallReadAhead();
+  ASSERT_OK(sm_->ReadAhead(keys_));
+  EXPECT_TRUE(sm_->IsReadAhead(keys_[1]));
+  EXPECT_FALSE(sm_->IsReady(keys_[1]));
+
+  std::atomic<bool> done(false);
+  std::string out(rows_[1].size(), 0);
+  Status rc;
+  std::thread reader([this, &done, &out, &rc]() {
+    WritableSlice dest(out.data(), out.size());
+    size_t bytes_read = 0;
+    rc = sm_->Read(keys_[1], &dest, &bytes_read);
+    done = true;
+  });
+  // A read from the disk does not need the lock, so the reader can only be waiting for the read ahead
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_FALSE(done);
+  sm_->ResumeReadAhead();
+  reader.join();
+  EXPECT_TRUE(done);
+  ASSERT_OK(rc);
+  EXPECT_TRUE(out == rows_[1]);
+  EXPECT_TRUE(sm_->IsReady(keys_[0]));
+  EXPECT_TRUE(sm_->IsReady(keys_[2]));
+}
+
+/// Feature: StorageManager read ahead
+/// Description: Test the eviction of the read ahead tier under a budget of three rows
+/// Expectation: The rows read already go first, least recently used first, then the rows not read yet, oldest first,
+///     and a row larger than the budget is not read ahead
+TEST_F(MindDataTestStorageManager, TestReadAheadEviction) {
+  MS_LOG(INFO) << "Doing MindDataTestStorageManager-TestReadAheadEviction.";
+  constexpr size_t kRowSize = 4096;
+  CreateStorageManager(3 * kRowSize);
+  WriteRows({kRowSize, kRowSize, kRowSize, kRowSize, kRowSize, kRowSize, 4 * kRowSize});
+  ASSERT_OK(sm_->ReadAhead({keys_[0], keys_[1], keys_[2]}));
+  sm_->WaitReadAhead();
+  ExpectRow(0, false);
+
+  // Row 0 is read already
+  ASSERT_OK(sm_->ReadAhead({keys_[3]}));
+  sm_->WaitReadAhead();
+  EXPECT_FALSE(sm_->IsReadAhead(keys_[0]));
+  EXPECT_TRUE(sm_->IsReadAhead(keys_[1]));
+  EXPECT_TRUE(sm_->IsReadAhead(keys_[2]));
+  EXPECT_TRUE(sm_->IsReadAhead(keys_[3]));
+
+  // Row 2 is read already, even though row 1 is older
+  ExpectRow(2, false);
+  ASSERT_OK(sm_->ReadAhead({keys_[4]}));
+  sm_->WaitReadAhead();
+  EXPECT_TRUE(sm_->IsReadAhead(keys_[1]));
+  EXPECT_FALSE(sm_->IsReadAhead(keys_[2]));
+  EXPECT_TRUE(sm_->IsReadAhead(keys_[4]));
+
+  // No row is read, row 1 is the oldest
+  ASSERT_OK(sm_->ReadAhead({keys_[5]}));
+  sm_->WaitReadAhead();
+  EXPECT_FALSE(sm_->IsReadAhead(keys_[1]));
+  EXPECT_TRUE(sm_->IsReadAhead(keys_[3]));
+  EXPECT_TRUE(sm_->IsReadAhead(keys_[4]));
+  EXPECT_TRUE(sm_->IsReadAhead(keys_[5]));
+
+  // Too large for the budget, nothing is evicted for it
+  ASSERT_OK(sm_->ReadAhead({keys_[6]}));
+  sm_->WaitReadAhead();
+  EXPECT_FALSE(sm_->IsReadAhead(keys_[6]));
+  EXPECT_TRUE(sm_->IsReadAhead(keys_[3]));
+
+  ZeroContainer();
+  ExpectRow(1, true);
+  ExpectRow(3, false);
+  ExpectRow(4, false);
+  ExpectRow(5, false);
+  ExpectRow(6, true);
+}
+
+/// Feature: StorageManager read ahead
+/// Description: Test rows of different sizes, asked for out of order, which are read ahead in a few merged runs by
+///     several read ahead tasks
+/// Expectation: Every row is byte exact
+TEST_F(MindDataTestStorageManager, TestReadAheadMergedRuns) {
+  MS_LOG(INFO) << "Doing MindDataTestStorageManager-TestReadAheadMergedRuns.";
+  constexpr int kNumRows = 64;
+  constexpr int32_t kNumReadAheadTasks = 4;
+  CreateStorageManager(16 * 1024 * 1024, kNumReadAheadTasks);
+  std::vector<size_t> sizes;
+  for (int i = 0; i < kNumRows; ++i) {
+    sizes.push_back(1 + (i * 997) % 8000);
+  }
+  WriteRows(sizes);
+  std::vector<StorageManager::key_type> keys(keys_.rbegin(), keys_.rend());
+  ASSERT_OK(sm_->ReadAhead(keys));
+  sm_->WaitReadAhead();
+  for (int i = 0; i < kNumRows; ++i) {
+    EXPECT_TRUE(sm_->IsReady(keys_[i]));
+  }
+  EXPECT_LT(sm_->NumReadAheadBuffers(), kNumRows);
+  ZeroContainer();
+  for (int i = 0; i < kNumRows; ++i) {
+    ExpectRow(i, false);
+  }
+}
+}  // namespace test
+}  // namespace dataset
+}  // namespace mindspore
@@ -13,16 +13,20 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/engine/datasetops/source/tf_record_file.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "proto/example.pb.h"
 
 namespace common = mindspore::common;
 
@@ -363,3 +367,105 @@ TEST_F(MindDataTestTFReaderOp, TestTotalRowsBasic) {
   TFReaderOp::CountTotalRows(&total_rows, filenames, 729, true);
   ASSERT_EQ(total_rows, 60);
 }
+
+/// Feature: TFReaderOp
+/// Description: Read two tfrecord files with 2 workers, with enable_lock_free_connector off and on
+/// Expectation: The rows are the same and in the same order
+TEST_F(MindDataTestTFReaderOp, TestTFReaderLockFreeConnector) {
+  std::string dataset_path = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+  std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
+  bool enable_lock_free = config_manager->enable_lock_free_connector();
+  std::vector<std::vector<std::string>> outputs;
+  for (bool lock_free : {false, true}) {
+    config_manager->set_enable_lock_free_connector(lock_free);
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+    ASSERT_OK(schema->LoadSchemaFile(datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json", {}));
+    int32_t op_connector_size = config_manager->op_connector_size();
+    int32_t num_workers = 2;
+    int32_t worker_connector_size = config_manager->worker_connector_size();
+    std::vector<std::string> files = {dataset_path, dataset_path};
+    std::vector<std::string> columns_to_load = {};
+    std::shared_ptr<TFReaderOp> my_tfreader_op =
+      std::make_shared<TFReaderOp>(num_workers, worker_connector_size, 0, files, std::move(schema), op_connector_size,
+                                   columns_to_load, false, 1, 0, false);
+    ASSERT_OK(my_tfreader_op->Init());
+    ASSERT_OK(my_tree->AssociateNode(my_tfreader_op));
+    ASSERT_OK(my_tree->AssignRoot(my_tfreader_op));
+    ASSERT_OK(my_tree->Prepare());
+    ASSERT_OK(my_tree->Launch());
+
+    DatasetIterator di(my_tree);
+    TensorRow tensor_list;
+    ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+    std::vector<std::string> rows;
+    while (!tensor_list.empty()) {
+      std::ostringstream ss;
+      for (auto &tensor : tensor_list) {
+        ss << *tensor;
+      }
+      rows.push_back(ss.str());
+      ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+    }
+    EXPECT_EQ(rows.size(), 24);
+    outputs.push_back(rows);
+  }
+  EXPECT_EQ(outputs[0], outputs[1]);
+  config_manager->set_enable_lock_free_connector(enable_lock_free);
+}
+
+/// Feature: TFRecordFile
+/// Description: Count the rows of a tfrecord file with the sidecar index enabled, then read records from the index
+/// Expectation: The index is saved and loaded, the row count and the records match the ones scanned from the file
+TEST_F(MindDataTestTFReaderOp, TestTFRecordFileIndex) {
+  std::string tf_file = "./tfreader_op_test_index.data";
+  std::ifstream src(datasets_root_path_ + "/testTFTestAllTypes/test.data", std::ios::binary);
+  std::ofstream dst(tf_file, std::ios::binary | std::ios::trunc);
+  dst << src.rdbuf();
+  dst.close();
+  (void)std::remove(TFRecordFile::IndexPath(tf_file).c_str());
+
+  std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
+  bool enable_index = config_manager->enable_tfrecord_index();
+  config_manager->set_enable_tfrecord_index(true);
+
+  // Scan the record headers and save the index
+  TFRecordFile scanned(tf_file);
+  ASSERT_OK(scanned.Open());
+  EXPECT_FALSE(scanned.HasIndex());
+  int64_t count = 0;
+  ASSERT_OK(scanned.CountRecords(&count));
+  EXPECT_EQ(count, 12);
+  std::ifstream index_file(TFRecordFile::IndexPath(tf_file));
+  EXPECT_TRUE(index_file.good());
+
+  // Load the index and read the same records
+  TFRecordFile indexed(tf_file);
+  ASSERT_OK(indexed.Open());
+  EXPECT_TRUE(indexed.HasIndex());
+  ASSERT_OK(indexed.CountRecords(&count));
+  EXPECT_EQ(count, 12);
+  for (int64_t row = 0; row < count; ++row) {
+    uint64_t scanned_offset = 0;
+    uint64_t indexed_offset = 0;
+    ASSERT_OK(scanned.Seek(row, &scanned_offset));
+    ASSERT_OK(indexed.Seek(row, &indexed_offset));
+    EXPECT_EQ(scanned_offset, indexed_offset);
+    const char *data = nullptr;
+    uint64_t length = 0;
+    ASSERT_OK(indexed.ReadRecord(&indexed_offset, &data, &length));
+    dataengine::Example example;
+    EXPECT_TRUE(example.ParseFromArray(data, static_cast<int>(length)));
+  }
+  uint64_t end_offset = 0;
+  ASSERT_OK(indexed.Seek(count, &end_offset));
+  EXPECT_EQ(end_offset, indexed.FileSize());
+
+  int64_t total_rows = 0;
+  ASSERT_OK(TFReaderOp::CountTotalRows(&total_rows, {tf_file, tf_file}, 2));
+  EXPECT_EQ(total_rows, 24);
+
+  config_manager->set_enable_tfrecord_index(enable_index);
+  (void)std::remove(TFRecordFile::IndexPath(tf_file).c_str());
+  (void)std::remove(tf_file.c_str());
+}
@@ -20,12 +20,15 @@
 #include "common/common.h"
 #include "minddata/dataset/text/kernels/basic_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/case_fold_op.h"
+#include "minddata/dataset/text/kernels/lookup_op.h"
 #include "minddata/dataset/text/kernels/normalize_utf8_op.h"
 #include "minddata/dataset/text/kernels/regex_replace_op.h"
 #include "minddata/dataset/text/kernels/regex_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
+#include "minddata/dataset/text/vocab_trie.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -358,4 +361,99 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+/// Feature: VocabTrie
+/// Description: Look up words, prefixes and missing words in the trie of a vocab, then add a word to the vocab
+/// Expectation: The ids are the same as the map of the vocab, and the trie is rebuilt after the word is added
+TEST_F(MindDataTestTokenizerOp, TestVocabTrie) {
+  MS_LOG(INFO) << "Doing TestVocabTrie.";
+  std::shared_ptr<Vocab> vocab;
+  ASSERT_OK(Vocab::BuildFromVector({"un", "unaffable", "##aff", "##able", "中国", "中"}, {"[UNK]"}, true, &vocab));
+  auto trie = VocabTrie::Of(*vocab);
+  for (const auto &[word, id] : vocab->GetVocab()) {
+    EXPECT_EQ(trie->Find(word), id);
+    EXPECT_EQ(vocab->LookupToken(word), id);
+  }
+  EXPECT_EQ(trie->Find("una"), Vocab::kNoTokenExists);
+  EXPECT_EQ(trie->Find("unaffables"), Vocab::kNoTokenExists);
+  EXPECT_EQ(trie->Find(""), Vocab::kNoTokenExists);
+  EXPECT_EQ(trie->Find("\xE4"), Vocab::kNoTokenExists);
+
+  int32_t node = VocabTrie::kRoot;
+  ASSERT_TRUE(trie->Walk("un", &node));
+  EXPECT_EQ(trie->Value(node), vocab->TokensToIds("un"));
+  ASSERT_TRUE(trie->Walk("aff", &node));
+  EXPECT_EQ(trie->Value(node), Vocab::kNoTokenExists);
+  int32_t prefix_node = node;
+  EXPECT_FALSE(trie->Walk("x", &node));
+  EXPECT_EQ(node, prefix_node);
+
+  vocab->AppendWord("unaff");
+  EXPECT_EQ(VocabTrie::Of(*vocab)->Find("unaff"), vocab->TokensToIds("unaff"));
+  EXPECT_EQ(trie->Find("unaff"), Vocab::kNoTokenExists);
+}
+
+/// Feature: WordpieceTokenizer
+/// Description: Tokenize words which are split into the longest subwords, including multi-byte ones and unknown ones
+/// Expectation: The subwords and offsets are as expected
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizer) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizer.";
+  std::shared_ptr<Vocab> vocab;
+  ASSERT_OK(Vocab::BuildFromVector({"un", "unaffable", "##aff", "##able", "##a", "中", "##国", "##"}, {}, true, &vocab));
+  std::unique_ptr<WordpieceTokenizerOp> op(new WordpieceTokenizerOp(vocab, "##", 100, "[UNK]", true));
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateFromVector(std::vector<std::string>{"unaffable", "unaffa", "中国", "xun", "国"}, &input);
+  TensorRow output;
+  ASSERT_OK(op->Compute(TensorRow(0, {input}), &output));
+  std::vector<std::string> expected_tokens = {"unaffable", "un", "##aff", "##a", "中", "##国", "[UNK]", "[UNK]"};
+  std::vector<uint32_t> expected_start = {0, 0, 2, 5, 0, 3, 0, 0};
+  std::vector<uint32_t> expected_limit = {9, 2, 5, 6, 3, 6, 3, 3};
+  ASSERT_EQ(output[0]->Size(), expected_tokens.size());
+  for (dsize_t i = 0; i < static_cast<dsize_t>(expected_tokens.size()); ++i) {
+    CheckEqual(output[0], {i}, expected_tokens[i]);
+    uint32_t start = 0;
+    uint32_t limit = 0;
+    ASSERT_OK(output[1]->GetItemAt(&start, {i}));
+    ASSERT_OK(output[2]->GetItemAt(&limit, {i}));
+    EXPECT_EQ(start, expected_start[i]);
+    EXPECT_EQ(limit, expected_limit[i]);
+  }
+}
+
+/// Feature: Vocab
+/// Description: Add words to the vocab after Lookup and WordpieceTokenizer are created, then run them again
+/// Expectation: The words added are found by both ops
+TEST_F(MindDataTestTokenizerOp, TestAppendWordAfterOpCreated) {
+  MS_LOG(INFO) << "Doing TestAppendWordAfterOpCreated.";
+  std::shared_ptr<Vocab> vocab;
+  ASSERT_OK(Vocab::BuildFromVector({"[UNK]", "un"}, {}, true, &vocab));
+  std::unique_ptr<LookupOp> lookup(new LookupOp(vocab, 0, DataType(DataType::DE_INT32)));
+  std::unique_ptr<WordpieceTokenizerOp> wordpiece(new WordpieceTokenizerOp(vocab, "##", 100, "[UNK]", false));
+  std::shared_ptr<Tensor> input;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<std::string>{"unx"}, &input));
+
+  std::shared_ptr<Tensor> ids;
+  ASSERT_OK(lookup->Compute(input, &ids));
+  int32_t id = -1;
+  ASSERT_OK(ids->GetItemAt(&id, {0}));
+  EXPECT_EQ(id, 0);
+  TensorRow output;
+  ASSERT_OK(wordpiece->Compute(TensorRow(0, {input}), &output));
+  CheckEqual(output[0], {0}, "[UNK]");
+
+  vocab->AppendWord("unx");
+  vocab->AppendWord("##x");
+  ASSERT_OK(lookup->Compute(input, &ids));
+  ASSERT_OK(ids->GetItemAt(&id, {0}));
+  EXPECT_EQ(id, vocab->TokensToIds("unx"));
+  TensorRow new_output;
+  ASSERT_OK(wordpiece->Compute(TensorRow(0, {input}), &new_output));
+  CheckEqual(new_output[0], {0}, "unx");
+
+  // a copy of the vocab does not share the trie
+  Vocab copy(*vocab);
+  copy.AppendWord("x");
+  EXPECT_EQ(vocab->LookupToken("x"), Vocab::kNoTokenExists);
+  EXPECT_EQ(copy.LookupToken("x"), copy.TokensToIds("x"));
+}
@@ -0,0 +1,184 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+#include <random>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+#include "plugin/device/cpu/hal/device/cpu_device_address.h"
+#include "plugin/device/cpu/hal/device/cpu_memory_manager.h"
+#include "plugin/device/cpu/hal/device/cpu_simple_mem_plan.h"
+
+namespace mindspore::device::cpu {
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() = default;
+};
+
+namespace {
+MemPlanBlock CreateBlock(size_t size, size_t start, size_t end) {
+  MemPlanBlock block;
+  block.size_ = size;
+  block.start_ = start;
+  block.end_ = end;
+  return block;
+}
+
+// Check the blocks whose lifetime overlaps never share the memory.
+bool CheckNoConflict(const std::vector<MemPlanBlock> &blocks, size_t total_size) {
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    if (blocks[i].offset_ + blocks[i].size_ > total_size) {
+      return false;
+    }
+    for (size_t j = i + 1; j < blocks.size(); ++j) {
+      bool time_overlap = blocks[i].start_ <= blocks[j].end_ && blocks[j].start_ <= blocks[i].end_;
+      bool space_overlap = blocks[i].offset_ < blocks[j].offset_ + blocks[j].size_ &&
+                           blocks[j].offset_ < blocks[i].offset_ + blocks[i].size_;
+      if (time_overlap && space_overlap) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+constexpr size_t kTensorSize = 16;
+
+// The kernel writes its input plus the value to the output, or the value if it has no input.
+class AddValueKernelMod : public kernel::KernelMod {
+ public:
+  explicit AddValueKernelMod(float value) : value_(value) {}
+  ~AddValueKernelMod() override = default;
+
+  bool Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &outputs, void *) override {
+    auto output = static_cast<float *>(outputs[0]->addr);
+    for (size_t i = 0; i < kTensorSize; ++i) {
+      output[i] = (inputs.empty() ? 0 : static_cast<float *>(inputs[0]->addr)[i]) + value_;
+    }
+    return true;
+  }
+
+ private:
+  float value_;
+};
+
+// Create a graph of a chain of kernels, each one adds the value to the output of the previous one.
+std::shared_ptr<session::KernelGraph> CreateChainGraph(uint32_t graph_id, float value, size_t kernel_num) {
+  auto graph = std::make_shared<session::KernelGraph>();
+  graph->set_graph_id(graph_id);
+  auto abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{SizeToLong(kTensorSize)});
+  std::vector<CNodePtr> kernels;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    std::vector<AnfNodePtr> inputs = {NewValueNode(prim::kPrimAdd)};
+    if (!kernels.empty()) {
+      inputs.push_back(kernels.back());
+    }
+    auto kernel = graph->NewCNode(inputs);
+    kernel->set_abstract(abstract);
+    AnfAlgo::SetKernelMod(std::make_shared<AddValueKernelMod>(value), kernel.get());
+    AnfAlgo::SetOutputAddr(std::make_shared<CPUDeviceAddress>(nullptr, kTensorSize * sizeof(float)), 0,
+                           kernel.get());
+    kernels.push_back(kernel);
+  }
+  graph->set_execution_order(kernels);
+  graph->set_output(kernels.back());
+  return graph;
+}
+
+// Launch the kernels of graph by the execution order, like CPUKernelRuntime::Run.
+void RunGraph(const session::KernelGraph &graph) {
+  auto to_address = [](const DeviceAddressPtr &device_address) {
+    return std::make_shared<kernel::Address>(device_address->GetMutablePtr(), device_address->GetSize());
+  };
+  for (const auto &kernel : graph.execution_order()) {
+    std::vector<kernel::AddressPtr> inputs;
+    for (size_t i = 0; i < common::AnfAlgo::GetInputTensorNum(kernel); ++i) {
+      inputs.push_back(to_address(AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i)));
+    }
+    std::vector<kernel::AddressPtr> outputs = {to_address(AnfAlgo::GetMutableOutputAddr(kernel, 0))};
+    ASSERT_TRUE(AnfAlgo::GetKernelMod(kernel)->Launch(inputs, {}, outputs, nullptr));
+  }
+}
+
+std::vector<float> GetGraphOutput(const session::KernelGraph &graph) {
+  auto output = static_cast<float *>(AnfAlgo::GetMutableOutputAddr(graph.execution_order().back(), 0)->GetMutablePtr());
+  return std::vector<float>(output, output + kTensorSize);
+}
+}  // namespace
+
+/// Feature: memory plan of cpu kernel graph.
+/// Description: plan the blocks of a chain graph, every kernel output is only used by the next kernel.
+/// Expectation: the peak is the size of two blocks instead of the sum of all blocks.
+TEST_F(TestCPUSimpleMemPlan, test_greedy_by_size_chain) {
+  std::vector<MemPlanBlock> blocks;
+  for (size_t i = 0; i < 10; ++i) {
+    blocks.emplace_back(CreateBlock(1024, i, i + 1));
+  }
+  auto total_size = CPUSimpleMemPlan::GreedyBySizePlan(&blocks);
+  ASSERT_TRUE(CheckNoConflict(blocks, total_size));
+  ASSERT_EQ(total_size, 1024 * 2);
+}
+
+/// Feature: memory plan of cpu kernel graph.
+/// Description: plan the blocks whose lifetime all overlap.
+/// Expectation: the peak is the sum of all blocks.
+TEST_F(TestCPUSimpleMemPlan, test_greedy_by_size_all_alive) {
+  std::vector<MemPlanBlock> blocks = {CreateBlock(64, 0, 4), CreateBlock(128, 1, 3), CreateBlock(256, 2, 2)};
+  auto total_size = CPUSimpleMemPlan::GreedyBySizePlan(&blocks);
+  ASSERT_TRUE(CheckNoConflict(blocks, total_size));
+  ASSERT_EQ(total_size, 64 + 128 + 256);
+}
+
+/// Feature: memory plan of cpu kernel graph.
+/// Description: plan the random blocks.
+/// Expectation: the blocks alive at the same time do not share memory, and the peak is not larger than the naive sum.
+TEST_F(TestCPUSimpleMemPlan, test_greedy_by_size_random) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<size_t> size_dist(1, 1024);
+  std::uniform_int_distribution<size_t> step_dist(0, 100);
+  std::uniform_int_distribution<size_t> lifetime_dist(0, 10);
+  std::vector<MemPlanBlock> blocks;
+  size_t naive_size = 0;
+  for (size_t i = 0; i < 300; ++i) {
+    auto start = step_dist(gen);
+    blocks.emplace_back(CreateBlock(size_dist(gen) * 64, start, start + lifetime_dist(gen)));
+    naive_size += blocks.back().size_;
+  }
+  auto total_size = CPUSimpleMemPlan::GreedyBySizePlan(&blocks);
+  ASSERT_TRUE(CheckNoConflict(blocks, total_size));
+  ASSERT_LT(total_size, naive_size);
+}
+
+/// Feature: memory plan of cpu kernel graph.
+/// Description: assign the memory of two graphs by the memory plan, and run them one after the other.
+/// Expectation: the second graph does not overwrite the outputs of the first graph.
+TEST_F(TestCPUSimpleMemPlan, test_assign_memory_two_graphs) {
+  CPUMemoryManager mem_manager;
+  auto first_graph = CreateChainGraph(0, 1, 4);
+  mem_manager.AssignMemory(first_graph.get(), true);
+  RunGraph(*first_graph);
+  ASSERT_EQ(GetGraphOutput(*first_graph), std::vector<float>(kTensorSize, 4));
+
+  auto second_graph = CreateChainGraph(1, 10, 4);
+  mem_manager.AssignMemory(second_graph.get(), true);
+  RunGraph(*second_graph);
+  ASSERT_EQ(GetGraphOutput(*second_graph), std::vector<float>(kTensorSize, 40));
+  ASSERT_EQ(GetGraphOutput(*first_graph), std::vector<float>(kTensorSize, 4));
+}
+}  // namespace mindspore::device::cpu
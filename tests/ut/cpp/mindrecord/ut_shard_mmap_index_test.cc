@@ -0,0 +1,213 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_mmap_index.h"
+#include "ut_common.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardMmapIndex : public UT::Common {
+ public:
+  TestShardMmapIndex() {}
+};
+
+namespace {
+const char kFileName[] = "./mmap_index_test.mindrecord";
+const int kRowsPerPage = 4;
+const int kNumRows = 10;
+
+// the rows look like the ones bound to the insert statement of the sqlite index
+std::vector<std::tuple<std::string, std::string, std::string>> MakeRow(int row_id) {
+  int page_id = row_id / kRowsPerPage * 2 + 1;
+  return {{":ROW_ID", "INTEGER", std::to_string(row_id)},
+          {":ROW_GROUP_ID", "INTEGER", std::to_string(row_id / kRowsPerPage)},
+          {":PAGE_ID_RAW", "INTEGER", "0"},
+          {":PAGE_OFFSET_RAW", "INTEGER", std::to_string(row_id * 10)},
+          {":PAGE_OFFSET_RAW_END", "INTEGER", std::to_string(row_id * 10 + 10)},
+          {":PAGE_ID_BLOB", "INTEGER", std::to_string(page_id)},
+          {":PAGE_OFFSET_BLOB", "INTEGER", std::to_string(row_id % kRowsPerPage * 100)},
+          {":PAGE_OFFSET_BLOB_END", "INTEGER", std::to_string(row_id % kRowsPerPage * 100 + 100)},
+          {":INC_0", "INTEGER", "0"},
+          {":label_0", "INTEGER", std::to_string(row_id % 3 - 1)},
+          {":INC_1", "INTEGER", "0"},
+          {":file_name_0", "TEXT", "file_" + std::to_string(row_id % 4)}};
+}
+}  // namespace
+
+/// Feature: ShardMmapIndex
+/// Description: Write the rows into the mmap index in shuffled order, then select them by page, row and criteria
+/// Expectation: The records are the same as the sqlite index would return, in the order of ROW_ID
+TEST_F(TestShardMmapIndex, TestSelect) {
+  MS_LOG(INFO) << FormatInfo("Test ShardMmapIndex select");
+  { std::ofstream(kFileName) << "mindrecord"; }
+  ShardMmapIndexBuilder builder;
+  for (int row_id : {4, 5, 6, 7, 0, 1, 2, 3, 8, 9}) {
+    ASSERT_TRUE(builder.AddRow(MakeRow(row_id)).IsOk());
+  }
+  ASSERT_TRUE(builder.Write(kFileName).IsOk());
+
+  ShardMmapIndex index(kFileName);
+  ASSERT_TRUE(index.Open().IsOk());
+  EXPECT_EQ(kNumRows, index.GetRowCount());
+
+  std::vector<std::vector<std::string>> records;
+  IndexQuery query;
+  query.columns = {"ROW_ID", "PAGE_OFFSET_BLOB", "label_0"};
+  ASSERT_TRUE(index.Select(query, &records).IsOk());
+  ASSERT_EQ(kNumRows, records.size());
+  std::vector<std::string> golden_record = {"5", "100", "1"};
+  ASSERT_TRUE(golden_record == records[5]);
+
+  records.clear();
+  query.columns = {"ROW_ID"};
+  query.blob_page_id = 3;
+  query.criteria = {"file_name_0", "file_1"};
+  ASSERT_TRUE(index.Select(query, &records).IsOk());
+  std::vector<std::vector<std::string>> golden_records = {{"5"}};
+  ASSERT_TRUE(golden_records == records);
+
+  records.clear();
+  query.blob_page_id = -1;
+  query.criteria = {"label_0", "-1.0"};
+  ASSERT_TRUE(index.Select(query, &records).IsOk());
+  golden_records = {{"0"}, {"3"}, {"6"}, {"9"}};
+  ASSERT_TRUE(golden_records == records);
+
+  records.clear();
+  query.columns = {"PAGE_ID_BLOB"};
+  query.distinct = true;
+  ASSERT_TRUE(index.Select(query, &records).IsOk());
+  golden_records = {{"1"}, {"3"}, {"5"}};
+  ASSERT_TRUE(golden_records == records);
+
+  records.clear();
+  query = IndexQuery();
+  query.columns = {"file_name_0"};
+  query.row_id = 6;
+  ASSERT_TRUE(index.Select(query, &records).IsOk());
+  golden_records = {{"file_2"}};
+  ASSERT_TRUE(golden_records == records);
+
+  std::vector<std::string> values;
+  ASSERT_TRUE(index.GetDistinctValues("label_0", &values).IsOk());
+  std::vector<std::string> golden_values = {"-1", "0", "1"};
+  ASSERT_TRUE(golden_values == values);
+
+  query.columns = {"unknown_0"};
+  ASSERT_FALSE(index.Select(query, &records).IsOk());
+  (void)std::remove(ShardMmapIndex::IndexPath(kFileName).c_str());
+  (void)std::remove(kFileName);
+}
+
+/// Feature: ShardMmapIndex
+/// Description: Open the mmap index after the mindrecord file is changed or without the index file
+/// Expectation: The index is rejected
+TEST_F(TestShardMmapIndex, TestOutOfDate) {
+  MS_LOG(INFO) << FormatInfo("Test ShardMmapIndex out of date");
+  { std::ofstream(kFileName) << "mindrecord"; }
+  ShardMmapIndex missing_index(kFileName);
+  ASSERT_FALSE(missing_index.Open().IsOk());
+
+  ShardMmapIndexBuilder builder;
+  ASSERT_TRUE(builder.AddRow(MakeRow(0)).IsOk());
+  ASSERT_TRUE(builder.Write(kFileName).IsOk());
+  { std::ofstream(kFileName, std::ios::app) << "appended"; }
+  ShardMmapIndex index(kFileName);
+  ASSERT_FALSE(index.Open().IsOk());
+
+  ShardMmapIndexBuilder incomplete_builder;
+  auto row = MakeRow(0);
+  row.erase(row.begin());
+  ASSERT_FALSE(incomplete_builder.AddRow(row).IsOk());
+  (void)std::remove(ShardMmapIndex::IndexPath(kFileName).c_str());
+  (void)std::remove(kFileName);
+}
+
+/// Feature: ShardMmapIndex
+/// Description: Select the values of a real field
+/// Expectation: The values are the same text as sqlite prints for a real, with a decimal point
+TEST_F(TestShardMmapIndex, TestRealText) {
+  MS_LOG(INFO) << FormatInfo("Test ShardMmapIndex real text");
+  { std::ofstream(kFileName) << "mindrecord"; }
+  std::vector<std::string> scores = {"1", "2.5", "-0.25", "1e20", "0", "0.1"};
+  ShardMmapIndexBuilder builder;
+  for (int row_id = 0; row_id < static_cast<int>(scores.size()); ++row_id) {
+    auto row = MakeRow(row_id);
+    row.emplace_back(":score_0", "NUMERIC", scores[row_id]);
+    ASSERT_TRUE(builder.AddRow(row).IsOk());
+  }
+  ASSERT_TRUE(builder.Write(kFileName).IsOk());
+
+  ShardMmapIndex index(kFileName);
+  ASSERT_TRUE(index.Open().IsOk());
+  std::vector<std::vector<std::string>> records;
+  IndexQuery query;
+  query.columns = {"score_0"};
+  ASSERT_TRUE(index.Select(query, &records).IsOk());
+  std::vector<std::vector<std::string>> golden_records = {{"1.0"}, {"2.5"}, {"-0.25"}, {"1.0e+20"}, {"0.0"}, {"0.1"}};
+  ASSERT_TRUE(golden_records == records);
+
+  records.clear();
+  query.columns = {"ROW_ID"};
+  query.criteria = {"score_0", "1.0"};
+  ASSERT_TRUE(index.Select(query, &records).IsOk());
+  golden_records = {{"0"}};
+  ASSERT_TRUE(golden_records == records);
+  (void)std::remove(ShardMmapIndex::IndexPath(kFileName).c_str());
+  (void)std::remove(kFileName);
+}
+
+/// Feature: ShardMmapIndex
+/// Description: Open the mmap index whose rows sorted by value point beyond the rows
+/// Expectation: The index is rejected
+TEST_F(TestShardMmapIndex, TestBrokenSortedRows) {
+  MS_LOG(INFO) << FormatInfo("Test ShardMmapIndex broken sorted rows");
+  { std::ofstream(kFileName) << "mindrecord"; }
+  ShardMmapIndexBuilder builder;
+  for (int row_id = 0; row_id < kNumRows; ++row_id) {
+    ASSERT_TRUE(builder.AddRow(MakeRow(row_id)).IsOk());
+  }
+  ASSERT_TRUE(builder.Write(kFileName).IsOk());
+
+  // the sorted rows of the last field end at the string pool, whose offset is the last one of the header
+  std::fstream index_file(ShardMmapIndex::IndexPath(kFileName), std::ios::in | std::ios::out | std::ios::binary);
+  uint64_t strings_offset = 0;
+  (void)index_file.seekg(kMmapIndexHeaderSize - sizeof(strings_offset));
+  (void)index_file.read(reinterpret_cast<char *>(&strings_offset), sizeof(strings_offset));
+  uint64_t sorted_row = kNumRows;
+  (void)index_file.seekp(strings_offset - sizeof(sorted_row));
+  (void)index_file.write(reinterpret_cast<const char *>(&sorted_row), sizeof(sorted_row));
+  index_file.close();
+
+  ShardMmapIndex index(kFileName);
+  ASSERT_FALSE(index.Open().IsOk());
+  (void)std::remove(ShardMmapIndex::IndexPath(kFileName).c_str());
+  (void)std::remove(kFileName);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
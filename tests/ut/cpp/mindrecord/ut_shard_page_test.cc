@@ -21,6 +21,7 @@
 
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_column_page.h"
 #include "minddata/mindrecord/include/shard_page.h"
 #include "ut_common.h"
 
@@ -157,5 +158,67 @@ TEST_F(TestShardPage, TestJson) {
     ++i;
   }
 }
+
+/// Feature: ShardColumnPage
+/// Description: Encode a range of rows into a column page and decode every column back
+/// Expectation: The values are the same, the encodings and the statistics are as expected
+TEST_F(TestShardPage, TestColumnPage) {
+  MS_LOG(INFO) << FormatInfo("Test ShardColumnPage encode and decode");
+  json schema = {{"schema",
+                  {{"label", {{"type", "int32"}}},
+                   {"file_name", {{"type", "string"}}},
+                   {"score", {{"type", "float64"}}},
+                   {"name", {{"type", "string"}}},
+                   {"data", {{"type", "bytes"}}}}},
+                 {"blob_fields", {"data"}}};
+  ShardColumnPage column_page(schema);
+  std::vector<std::string> golden_columns = {"file_name", "label", "name", "score"};
+  ASSERT_TRUE(golden_columns == column_page.GetColumns());
+  EXPECT_EQ(-1, column_page.GetColumnId("data"));
+
+  const int kStart = 100;
+  const int kEnd = 900;
+  std::vector<json> rows;
+  for (int i = 0; i < 1000; i++) {
+    rows.push_back({{"label", i % 10 - 3},
+                    {"file_name", "file_" + std::to_string(i % 7)},
+                    {"score", i * 0.25},
+                    {"name", "name_" + std::to_string(i)}});
+  }
+  std::vector<uint8_t> page;
+  json column_stats;
+  ASSERT_TRUE(column_page.Encode(rows, kStart, kEnd, &page, &column_stats).IsOk());
+
+  std::vector<uint8_t> head(page.begin(), page.begin() + column_page.GetHeadSize());
+  uint64_t num_rows = 0;
+  std::vector<ColumnChunk> chunks;
+  ASSERT_TRUE(column_page.DecodeHead(head, &num_rows, &chunks).IsOk());
+  EXPECT_EQ(kEnd - kStart, num_rows);
+  ASSERT_EQ(golden_columns.size(), chunks.size());
+  EXPECT_EQ(kColumnDictionary, chunks[column_page.GetColumnId("file_name")].encoding);
+  EXPECT_EQ(kColumnDeltaVarint, chunks[column_page.GetColumnId("label")].encoding);
+  EXPECT_EQ(kColumnPlain, chunks[column_page.GetColumnId("name")].encoding);
+  EXPECT_EQ(kColumnPlain, chunks[column_page.GetColumnId("score")].encoding);
+  for (int column_id = 0; column_id < static_cast<int>(chunks.size()); ++column_id) {
+    auto &chunk = chunks[column_id];
+    std::vector<uint8_t> data(page.begin() + chunk.offset, page.begin() + chunk.offset + chunk.size);
+    std::vector<json> values;
+    ASSERT_TRUE(column_page.DecodeColumn(column_id, chunk, data, num_rows, &values).IsOk());
+    ASSERT_EQ(num_rows, values.size());
+    for (uint64_t i = 0; i < num_rows; ++i) {
+      ASSERT_TRUE(values[i] == rows[kStart + i][golden_columns[column_id]]);
+    }
+  }
+
+  ASSERT_TRUE(column_page.MayContain(column_stats, "label", "5"));
+  ASSERT_FALSE(column_page.MayContain(column_stats, "label", "7"));
+  ASSERT_TRUE(column_page.MayContain(column_stats, "file_name", "file_3"));
+  ASSERT_FALSE(column_page.MayContain(column_stats, "file_name", "file_9"));
+  ASSERT_FALSE(column_page.MayContain(column_stats, "score", "-1.0"));
+  ASSERT_TRUE(column_page.MayContain(column_stats, "data", "anything"));
+
+  rows[kStart]["extra"] = 1;
+  ASSERT_FALSE(column_page.Encode(rows, kStart, kEnd, &page, &column_stats).IsOk());
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_read_ahead.h"
+#include "ut_common.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardReadAhead : public UT::Common {
+ public:
+  TestShardReadAhead() {}
+};
+
+namespace {
+const char kFileName[] = "./read_ahead_test.mindrecord";
+const int64_t kNumRows = 200;
+const int64_t kPaddedRow = 7;
+
+// the blobs of the rows are close to each other, with gaps of different sizes
+bool Locate(int64_t task_id, BlobLocation *location) {
+  if (task_id == kPaddedRow) {
+    return false;
+  }
+  location->shard_id = 0;
+  location->offset = static_cast<uint64_t>(task_id * 100 + task_id % 3 * 7);
+  location->length = static_cast<uint64_t>(50 + task_id % 40);
+  return true;
+}
+
+std::vector<uint8_t> ReadBlob(int64_t task_id) {
+  BlobLocation location;
+  (void)Locate(task_id, &location);
+  std::vector<uint8_t> blob(location.length);
+  std::ifstream in(kFileName, std::ios::in | std::ios::binary);
+  in.seekg(location.offset, std::ios::beg);
+  in.read(reinterpret_cast<char *>(blob.data()), location.length);
+  return blob;
+}
+
+void WriteFile() {
+  std::ofstream out(kFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  for (int64_t i = 0; i < kNumRows * 100; ++i) {
+    out.put(static_cast<char>(i * 31 % 251));
+  }
+}
+
+// a shuffled plan which samples some rows twice
+std::vector<int64_t> MakePlan() {
+  std::vector<int64_t> plan;
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    plan.push_back(i * 37 % kNumRows);
+    if (i % 10 == 0) {
+      plan.push_back(i * 37 % kNumRows);
+    }
+  }
+  return plan;
+}
+}  // namespace
+
+/// Feature: ShardReadAhead
+/// Description: Read the rows ahead with a large cache, and take them in the order of the plan
+/// Expectation: The rows except the padded one are read ahead, and the blobs are the same as reading them directly
+TEST_F(TestShardReadAhead, TestReadAhead) {
+  MS_LOG(INFO) << FormatInfo("Test ShardReadAhead read ahead");
+  WriteFile();
+  auto plan = MakePlan();
+  ShardReadAhead read_ahead({kFileName}, 4, 1 << 20);
+  ASSERT_TRUE(read_ahead.Start(plan, Locate).IsOk());
+  // the cache can hold all the rows, wait for them to be planned
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  for (auto task_id : plan) {
+    std::vector<uint8_t> blob;
+    if (task_id == kPaddedRow) {
+      ASSERT_FALSE(read_ahead.Get(task_id, &blob));
+      continue;
+    }
+    ASSERT_TRUE(read_ahead.Get(task_id, &blob));
+    ASSERT_TRUE(blob == ReadBlob(task_id));
+  }
+  read_ahead.Stop();
+  std::vector<uint8_t> blob;
+  ASSERT_FALSE(read_ahead.Get(0, &blob));
+  (void)std::remove(kFileName);
+}
+
+/// Feature: ShardReadAhead
+/// Description: Read the rows ahead with a tiny cache by several readers, which also read the rows missed directly,
+///     then restart the read ahead in the middle of the plan
+/// Expectation: The threads do not hang, and the blobs are the same as reading them directly
+TEST_F(TestShardReadAhead, TestSmallCache) {
+  MS_LOG(INFO) << FormatInfo("Test ShardReadAhead small cache");
+  WriteFile();
+  auto plan = MakePlan();
+  ShardReadAhead read_ahead({kFileName}, 2, 1);
+  ASSERT_TRUE(read_ahead.Start(plan, Locate).IsOk());
+  const int kNumReaders = 3;
+  std::vector<int> num_failed(kNumReaders, 0);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < kNumReaders; ++r) {
+    readers.emplace_back([&read_ahead, &plan, &num_failed, r]() {
+      for (size_t i = r; i < plan.size(); i += kNumReaders) {
+        std::vector<uint8_t> blob;
+        if (!read_ahead.Get(plan[i], &blob)) {
+          blob = ReadBlob(plan[i]);
+        }
+        if (plan[i] != kPaddedRow && blob != ReadBlob(plan[i])) {
+          ++num_failed[r];
+        }
+      }
+    });
+  }
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  for (int r = 0; r < kNumReaders; ++r) {
+    EXPECT_EQ(num_failed[r], 0);
+  }
+
+  ASSERT_TRUE(read_ahead.Start(plan, Locate).IsOk());
+  for (size_t i = 0; i < plan.size() / 2; ++i) {
+    std::vector<uint8_t> blob;
+    if (read_ahead.Get(plan[i], &blob)) {
+      ASSERT_TRUE(blob == ReadBlob(plan[i]));
+    }
+  }
+  ASSERT_TRUE(read_ahead.Start(plan, Locate).IsOk());
+  read_ahead.Stop();
+  (void)std::remove(kFileName);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -1241,5 +1241,88 @@ TEST_F(TestShardWriter, TestOverWrite) {
 
 }
 
+namespace {
+// the rows of the index database in the order of ROW_ID
+std::vector<std::vector<std::string>> ReadIndexRows(const std::string &db_file) {
+  std::vector<std::vector<std::string>> rows;
+  sqlite3 *db = nullptr;
+  if (sqlite3_open_v2(db_file.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+    sqlite3_close(db);
+    return rows;
+  }
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(db, "SELECT * FROM INDEXES ORDER BY ROW_ID;", -1, &stmt, nullptr) == SQLITE_OK) {
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      std::vector<std::string> row;
+      for (int i = 0; i < sqlite3_column_count(stmt); ++i) {
+        auto text = sqlite3_column_text(stmt, i);
+        row.emplace_back(text == nullptr ? "NULL" : reinterpret_cast<const char *>(text));
+      }
+      rows.push_back(row);
+    }
+  }
+  (void)sqlite3_finalize(stmt);
+  sqlite3_close(db);
+  return rows;
+}
+}  // namespace
+
+/// Feature: ShardWriter
+/// Description: Write the batches through the pipeline with small pages and a small memory limit, so the row groups
+///     are shifted to new raw pages and the batches wait for each other
+/// Expectation: The index written while writing is the same as the one generated after commit
+TEST_F(TestShardWriter, TestPipelineWriter) {
+  MS_LOG(INFO) << FormatInfo("Test pipeline writer");
+  std::vector<std::string> file_names = {"./pipeline.mindrecord0", "./pipeline.mindrecord1", "./pipeline.mindrecord2"};
+  json schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "text": {"type": "string"},
+        "data": {"type": "bytes"}})"_json;
+  ShardHeader header_data;
+  int schema_id = header_data.AddSchema(Schema::Build("pipeline", schema_json));
+  std::vector<std::pair<uint64_t, std::string>> fields = {{schema_id, "file_name"}, {schema_id, "label"}};
+  ASSERT_TRUE(header_data.AddIndexFields(fields).IsOk());
+  {
+    ShardWriter fw;
+    ASSERT_TRUE(fw.Open(file_names, false, true).IsOk());
+    ASSERT_TRUE(fw.SetPageSize(1 << 15).IsOk());
+    ASSERT_TRUE(fw.SetShardHeader(std::make_shared<ShardHeader>(header_data)).IsOk());
+    ASSERT_TRUE(fw.SetPipeline(true, 1 << 16).IsOk());
+    ASSERT_TRUE(fw.SetMmapIndex(true).IsOk());
+    int row_id = 0;
+    for (int batch = 0; batch < 20; ++batch) {
+      std::map<uint64_t, std::vector<json>> raw_data;
+      std::vector<std::vector<uint8_t>> blob_data;
+      for (int i = 0; i < 7 + batch % 5; ++i, ++row_id) {
+        raw_data[schema_id].push_back(json{{"file_name", "file_" + std::to_string(row_id)},
+                                           {"label", row_id % 10},
+                                           {"text", std::string(500 + row_id * 13 % 2500, 'a' + row_id % 26)}});
+        blob_data.emplace_back(1000 + row_id * 37 % 3000, static_cast<uint8_t>(row_id));
+      }
+      ASSERT_TRUE(fw.WriteRawData(raw_data, blob_data).IsOk());
+    }
+    ASSERT_TRUE(fw.Commit().IsOk());
+    ASSERT_TRUE(fw.IsIndexWritten());
+  }
+
+  std::vector<std::vector<std::vector<std::string>>> index_rows;
+  for (const auto &file_name : file_names) {
+    index_rows.push_back(ReadIndexRows(file_name + ".db"));
+    ASSERT_FALSE(index_rows.back().empty());
+    ShardMmapIndex mmap_index(file_name);
+    ASSERT_TRUE(mmap_index.Open().IsOk());
+    ASSERT_EQ(index_rows.back().size(), mmap_index.GetRowCount());
+    (void)std::remove((file_name + ".db").c_str());
+  }
+  ShardIndexGenerator sg{file_names[0]};
+  ASSERT_TRUE(sg.Build().IsOk());
+  ASSERT_TRUE(sg.WriteToDatabase().IsOk());
+  for (size_t i = 0; i < file_names.size(); ++i) {
+    ASSERT_TRUE(index_rows[i] == ReadIndexRows(file_names[i] + ".db"));
+    (void)std::remove((file_names[i] + ".db").c_str());
+    (void)std::remove(ShardMmapIndex::IndexPath(file_names[i]).c_str());
+    (void)std::remove(file_names[i].c_str());
+  }
+}
+
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,421 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+
+#include "common/mem_reuse/mem_dynamic_allocator.h"
+#include "common/mem_reuse/mem_alloc_trace.h"
+#include "common/common_test.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+class TestMemPool : public DynamicMemPoolBestFit {
+ public:
+  explicit TestMemPool(size_t capacity) : capacity_(capacity) { SetMemAllocUintSize(kUnitSize, kUnitSize); }
+  ~TestMemPool() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    size = std::min(size, free_mem_size());
+    *addr = malloc(size);
+    if (*addr == nullptr) {
+      return 0;
+    }
+    allocated_ += size;
+    sizes_[*addr] = size;
+    return size;
+  }
+
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    allocated_ -= sizes_[addr];
+    (void)sizes_.erase(addr);
+    free(addr);
+    return true;
+  }
+
+  size_t free_mem_size() override { return capacity_ - allocated_; }
+
+  static constexpr size_t kUnitSize = 16 << 20;
+
+ private:
+  size_t capacity_;
+  size_t allocated_{0};
+  std::map<DeviceMemPtr, size_t> sizes_;
+};
+
+class TestDynamicMemPool : public UT::Common {
+ public:
+  TestDynamicMemPool() = default;
+
+  void TearDown() override {
+    if (!temp_file_.empty()) {
+      (void)remove(temp_file_.c_str());
+      temp_file_.clear();
+    }
+    UT::Common::TearDown();
+  }
+
+ protected:
+  // Create an empty file in the temporary directory, it is removed in the tear down.
+  const std::string &CreateTempFile() {
+    auto path = (std::filesystem::temp_directory_path() / "mem_dynamic_allocator_test_XXXXXX").string();
+    auto fd = mkstemp(path.data());
+    if (fd >= 0) {
+      (void)close(fd);
+      temp_file_ = path;
+    }
+    return temp_file_;
+  }
+
+ private:
+  std::string temp_file_;
+};
+
+namespace {
+// The alloc trace of three LeNet5 training steps with batch size 32, in the format of MemAllocTraceRecorder.
+constexpr char kLeNetTraceFile[] = "./data/mem_trace/lenet5_train.trace";
+
+// The peak of the memory requested by the live tensors in the trace, which is the theoretical optimum of the pool.
+size_t LiveMemPeak(const std::vector<MemAllocTraceEvent> &events) {
+  std::unordered_map<uint64_t, size_t> sizes;
+  size_t live_size = 0;
+  size_t peak_size = 0;
+  for (const auto &event : events) {
+    if (event.type_ == MemAllocTraceRecordType::kAlloc) {
+      if (event.device_addr_ != 0) {
+        sizes[event.device_addr_] = event.size_;
+        live_size += event.size_;
+        peak_size = std::max(peak_size, live_size);
+      }
+    } else {
+      auto iter = sizes.find(event.device_addr_);
+      if (iter != sizes.end()) {
+        live_size -= iter->second;
+        (void)sizes.erase(iter);
+      }
+    }
+  }
+  return peak_size;
+}
+
+// Replay the recorded trace, the recorded device addresses are mapped to the device addresses of the pool. The memory
+// still in use at the end of the trace is freed, so the trace can be replayed repeatedly.
+void ReplayRecordedTrace(TestMemPool *pool, const std::vector<MemAllocTraceEvent> &events, bool set_debug_info) {
+  std::unordered_map<uint64_t, DeviceMemPtr> addrs;
+  for (const auto &event : events) {
+    if (event.type_ == MemAllocTraceRecordType::kAlloc) {
+      if (event.device_addr_ == 0) {
+        continue;
+      }
+      if (set_debug_info) {
+        DynamicMemAllocatorDebugInfo::SetDebugInfo(event.allocator_name_,
+                                                   static_cast<AllocatorType>(event.allocator_type_));
+      }
+      auto addr = pool->AllocTensorMem(event.size_, (event.flags_ & kMemAllocTraceFlagPersistent) != 0);
+      ASSERT_NE(addr, nullptr);
+      addrs[event.device_addr_] = addr;
+    } else {
+      auto iter = addrs.find(event.device_addr_);
+      if (iter != addrs.end()) {
+        pool->FreeTensorMem(iter->second);
+        (void)addrs.erase(iter);
+      }
+    }
+  }
+  for (const auto &iter : addrs) {
+    pool->FreeTensorMem(iter.second);
+  }
+}
+
+// Replay the recorded trace repeatedly from every thread, and return the replayed events per second.
+double ReplayRecordedTraceConcurrently(TestMemPool *pool, const std::vector<MemAllocTraceEvent> &events,
+                                       size_t thread_num, size_t repeat) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([pool, &events, repeat]() {
+      for (size_t j = 0; j < repeat; ++j) {
+        ReplayRecordedTrace(pool, events, false);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return static_cast<double>(events.size() * thread_num * repeat) / cost;
+}
+}  // namespace
+
+/// Feature: size class mode of the dynamic memory pool.
+/// Description: alloc and free the small memory in the size class mode.
+/// Expectation: the memory in the same size class is reused by the thread cache.
+TEST_F(TestDynamicMemPool, test_size_class_reuse) {
+  TestMemPool pool(1UL << 30);
+  pool.SetEnableSizeClass(true);
+  ASSERT_TRUE(pool.enable_size_class());
+  auto addr1 = pool.AllocTensorMem(1000);
+  ASSERT_NE(addr1, nullptr);
+  pool.FreeTensorMem(addr1);
+  ASSERT_EQ(pool.SizeClassCachedMemStatistics(), 1024);
+  // 900 and 1000 are in the same size class.
+  auto addr2 = pool.AllocTensorMem(900);
+  ASSERT_EQ(addr1, addr2);
+  ASSERT_EQ(pool.SizeClassCachedMemStatistics(), 0);
+  // The large memory and persistent memory are from the best fit.
+  auto large_addr = pool.AllocTensorMem(SIZE_CLASS_MAX_SIZE + 1);
+  auto persistent_addr = pool.AllocTensorMem(1000, true);
+  ASSERT_NE(large_addr, nullptr);
+  ASSERT_NE(persistent_addr, nullptr);
+  pool.FreeTensorMem(large_addr);
+  pool.FreeTensorMem(persistent_addr);
+  ASSERT_EQ(pool.SizeClassCachedMemStatistics(), 0);
+  pool.FreeTensorMem(addr2);
+  pool.FlushSizeClassMem();
+  ASSERT_EQ(pool.SizeClassCachedMemStatistics(), 0);
+  ASSERT_EQ(pool.TotalUsedMemStatistics(), 0);
+}
+
+/// Feature: size class mode of the dynamic memory pool.
+/// Description: alloc the continuous memory in the size class mode.
+/// Expectation: the continuous memory is from the best fit and can be freed one by one.
+TEST_F(TestDynamicMemPool, test_size_class_continuous_mem) {
+  TestMemPool pool(1UL << 30);
+  pool.SetEnableSizeClass(true);
+  std::vector<size_t> size_list = {512, 1024, 512};
+  auto addr_list = pool.AllocContinuousTensorMem(2048, size_list);
+  ASSERT_EQ(addr_list.size(), size_list.size());
+  ASSERT_EQ(static_cast<uint8_t *>(addr_list[0]) + 512, addr_list[1]);
+  ASSERT_EQ(static_cast<uint8_t *>(addr_list[1]) + 1024, addr_list[2]);
+  for (auto addr : addr_list) {
+    pool.FreeTensorMem(addr);
+  }
+  ASSERT_EQ(pool.SizeClassCachedMemStatistics(), 0);
+  ASSERT_EQ(pool.TotalUsedMemStatistics(), 0);
+}
+
+/// Feature: size class mode of the dynamic memory pool.
+/// Description: the device memory is exhausted by the memory cached in the size classes.
+/// Expectation: the cached memory is flushed and combined, then the alloc succeeds.
+TEST_F(TestDynamicMemPool, test_size_class_flush_when_exhausted) {
+  TestMemPool pool(TestMemPool::kUnitSize);
+  pool.SetEnableSizeClass(true);
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < TestMemPool::kUnitSize / SIZE_CLASS_MAX_SIZE; ++i) {
+    addrs.push_back(pool.AllocTensorMem(SIZE_CLASS_MAX_SIZE));
+    ASSERT_NE(addrs.back(), nullptr);
+  }
+  for (auto addr : addrs) {
+    pool.FreeTensorMem(addr);
+  }
+  ASSERT_EQ(pool.SizeClassCachedMemStatistics(), TestMemPool::kUnitSize);
+  auto addr = pool.AllocTensorMem(SIZE_CLASS_MAX_SIZE / 2);
+  ASSERT_NE(addr, nullptr);
+  ASSERT_EQ(pool.SizeClassCachedMemStatistics(), 0);
+  pool.FreeTensorMem(addr);
+}
+
+/// Feature: size class mode of the dynamic memory pool.
+/// Description: alloc and free the memory from multiple threads in the size class mode.
+/// Expectation: the memory in use is never shared by two tensors, and all memory is returned after flush.
+TEST_F(TestDynamicMemPool, test_size_class_multi_thread) {
+  TestMemPool pool(1UL << 31);
+  pool.SetEnableSizeClass(true);
+  const size_t thread_num = 4;
+  const size_t loop_num = 2000;
+  std::vector<std::thread> threads;
+  std::vector<int> results(thread_num, 1);
+  for (size_t t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&pool, &results, t, loop_num]() {
+      std::mt19937 gen(t);
+      std::uniform_int_distribution<size_t> size_dist(1, 2 * SIZE_CLASS_MAX_SIZE);
+      std::vector<std::pair<DeviceMemPtr, size_t>> live;
+      for (size_t i = 0; i < loop_num; ++i) {
+        size_t size = size_dist(gen) >> (i % 10);
+        auto addr = pool.AllocTensorMem(size);
+        if (addr == nullptr) {
+          results[t] = 0;
+          return;
+        }
+        (void)memset(addr, static_cast<int>(t + 1), size);
+        live.emplace_back(addr, size);
+        if (live.size() > 16 || i % 3 == 0) {
+          auto &front = live.front();
+          auto data = static_cast<unsigned char *>(front.first);
+          for (size_t k = 0; k < front.second; ++k) {
+            if (data[k] != t + 1) {
+              results[t] = 0;
+            }
+          }
+          pool.FreeTensorMem(front.first);
+          (void)live.erase(live.begin());
+        }
+      }
+      for (auto &iter : live) {
+        pool.FreeTensorMem(iter.first);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t t = 0; t < thread_num; ++t) {
+    ASSERT_TRUE(results[t]);
+  }
+  // The thread caches are returned to the central free lists when the threads exit.
+  pool.FlushSizeClassMem();
+  ASSERT_EQ(pool.SizeClassCachedMemStatistics(), 0);
+  ASSERT_EQ(pool.TotalUsedMemStatistics(), 0);
+}
+
+/// Feature: size class mode of the dynamic memory pool.
+/// Description: a thread frees the memory to its own cache and keeps running, the other thread flushes the pool.
+/// Expectation: the memory cached by the running thread is returned to the best fit pool.
+TEST_F(TestDynamicMemPool, test_size_class_flush_other_thread_cache) {
+  TestMemPool pool(TestMemPool::kUnitSize);
+  pool.SetEnableSizeClass(true);
+  std::promise<void> cached;
+  std::promise<void> flushed;
+  auto flushed_future = flushed.get_future();
+  std::thread thread([&pool, &cached, &flushed_future]() {
+    std::vector<DeviceMemPtr> addrs;
+    for (size_t i = 0; i < 8; ++i) {
+      addrs.push_back(pool.AllocTensorMem(DYNAMIC_MEM_ALIGN_SIZE * (i + 1)));
+    }
+    for (auto addr : addrs) {
+      pool.FreeTensorMem(addr);
+    }
+    cached.set_value();
+    flushed_future.wait();
+  });
+  cached.get_future().wait();
+  ASSERT_GT(pool.SizeClassCachedMemStatistics(), 0);
+  pool.FlushSizeClassMem();
+  EXPECT_EQ(pool.SizeClassCachedMemStatistics(), 0);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+  flushed.set_value();
+  thread.join();
+}
+
+/// Feature: size class mode of the dynamic memory pool.
+/// Description: replay the recorded trace of LeNet5 training on the best fit and the size class mode.
+/// Expectation: the peak used memory is close to the theoretical optimum and the device memory does not grow when the
+///     trace is replayed again.
+TEST_F(TestDynamicMemPool, test_size_class_replay_peak) {
+  std::vector<MemAllocTraceEvent> events;
+  ASSERT_TRUE(ReadMemAllocTrace(kLeNetTraceFile, &events));
+  ASSERT_FALSE(events.empty());
+  auto optimum = LiveMemPeak(events);
+  for (bool enable_size_class : {false, true}) {
+    TestMemPool pool(1UL << 31);
+    pool.SetEnableSizeClass(enable_size_class);
+    ReplayRecordedTrace(&pool, events, false);
+    auto total_size = pool.TotalMemStatistics();
+    auto peak_size = pool.UsedMemPeakStatistics();
+    ReplayRecordedTrace(&pool, events, false);
+    MS_LOG(INFO) << "Replay the recorded trace, size class: " << enable_size_class << ", optimum: " << optimum
+                 << ", used peak: " << peak_size << ", total: " << total_size;
+    // The best fit only pays the alignment, the size class also pays the rounding up and the cached memory.
+    ASSERT_GE(peak_size, optimum);
+    ASSERT_LE(peak_size, enable_size_class ? optimum * 2 : optimum * 11 / 10);
+    ASSERT_EQ(pool.UsedMemPeakStatistics(), peak_size);
+    ASSERT_EQ(pool.TotalMemStatistics(), total_size);
+    pool.FlushSizeClassMem();
+    ASSERT_EQ(pool.TotalUsedMemStatistics(), 0);
+  }
+}
+
+/// Feature: size class mode of the dynamic memory pool.
+/// Description: replay the recorded trace of LeNet5 training on the best fit and the size class mode from threads.
+/// Expectation: both modes replay the trace and return all the memory, and the throughput is logged.
+TEST_F(TestDynamicMemPool, test_size_class_replay_benchmark) {
+  std::vector<MemAllocTraceEvent> events;
+  ASSERT_TRUE(ReadMemAllocTrace(kLeNetTraceFile, &events));
+  const size_t repeat = 200;
+  for (size_t thread_num : {1, 4}) {
+    double throughput[2] = {0, 0};
+    for (bool enable_size_class : {false, true}) {
+      TestMemPool pool(1UL << 31);
+      pool.SetEnableSizeClass(enable_size_class);
+      throughput[enable_size_class] = ReplayRecordedTraceConcurrently(&pool, events, thread_num, repeat);
+      pool.FlushSizeClassMem();
+      ASSERT_EQ(pool.TotalUsedMemStatistics(), 0);
+    }
+    MS_LOG(INFO) << "Replay " << events.size() << " events with " << thread_num
+                 << " threads, best fit: " << throughput[0] << " events/s, size class: " << throughput[1]
+                 << " events/s.";
+  }
+}
+
+/// Feature: memory alloc trace of the dynamic memory pool.
+/// Description: replay the recorded trace of LeNet5 training with the recording on, then read the new trace.
+/// Expectation: all the events are recorded again with the same sizes, flags and allocator debug info.
+TEST_F(TestDynamicMemPool, test_alloc_trace_record_and_replay) {
+  std::vector<MemAllocTraceEvent> events;
+  ASSERT_TRUE(ReadMemAllocTrace(kLeNetTraceFile, &events));
+  const std::string trace_file = CreateTempFile();
+  ASSERT_FALSE(trace_file.empty());
+  {
+    TestMemPool pool(1UL << 31);
+    ASSERT_TRUE(pool.StartAllocTrace(trace_file));
+    ASSERT_FALSE(pool.StartAllocTrace(trace_file));
+    ReplayRecordedTrace(&pool, events, true);
+    DynamicMemAllocatorDebugInfo::SetDebugInfo("weight", AllocatorType::kWeight);
+    auto addr_list = pool.AllocContinuousTensorMem(2048, {1024, 1024});
+    ASSERT_EQ(addr_list.size(), 2);
+    pool.StopAllocTrace();
+    // The memory alloc after stopping is not recorded.
+    auto addr = pool.AllocTensorMem(1000);
+    pool.FreeTensorMem(addr);
+  }
+
+  std::vector<MemAllocTraceEvent> replayed_events;
+  ASSERT_TRUE(ReadMemAllocTrace(trace_file, &replayed_events));
+  // The persistent memory is still in use at the end of the recorded trace, it is freed after the replay.
+  size_t persistent_num = 0;
+  for (const auto &event : events) {
+    persistent_num += (event.flags_ & kMemAllocTraceFlagPersistent) != 0 ? 1 : 0;
+  }
+  ASSERT_GT(persistent_num, 0);
+  ASSERT_EQ(replayed_events.size(), events.size() + persistent_num + 2);
+  for (size_t i = 0; i < events.size(); ++i) {
+    ASSERT_EQ(replayed_events[i].type_, events[i].type_);
+    if (events[i].type_ == MemAllocTraceRecordType::kAlloc) {
+      ASSERT_EQ(replayed_events[i].size_, events[i].size_);
+      ASSERT_EQ(replayed_events[i].flags_, events[i].flags_);
+      ASSERT_NE(replayed_events[i].device_addr_, 0);
+      ASSERT_EQ(replayed_events[i].allocator_name_, events[i].allocator_name_);
+      ASSERT_EQ(replayed_events[i].allocator_type_, events[i].allocator_type_);
+    }
+  }
+  for (size_t i = events.size(); i < events.size() + persistent_num; ++i) {
+    ASSERT_EQ(replayed_events[i].type_, MemAllocTraceRecordType::kFree);
+  }
+  ASSERT_EQ(replayed_events.back().flags_, kMemAllocTraceFlagContinuous);
+  ASSERT_EQ(replayed_events.back().size_, 1024);
+  ASSERT_EQ(replayed_events.back().allocator_name_, "weight");
+}
+}  // namespace device
+}  // namespace mindspore
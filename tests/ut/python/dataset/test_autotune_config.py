@@ -51,6 +51,20 @@ class TestAutotuneConfig:
         with pytest.raises(ValueError):
             ds.config.set_autotune_interval(-999)
 
+        cpu_budget = ds.config.get_autotune_cpu_budget()
+        assert cpu_budget == 0
+
+        ds.config.set_autotune_cpu_budget(8)
+        cpu_budget = ds.config.get_autotune_cpu_budget()
+        assert cpu_budget == 8
+        ds.config.set_autotune_cpu_budget(0)
+
+        with pytest.raises(TypeError):
+            ds.config.set_autotune_cpu_budget(True)
+
+        with pytest.raises(ValueError):
+            ds.config.set_autotune_cpu_budget(-1)
+
     @staticmethod
     def test_autotune_config_filepath_invalid():
         """
@@ -235,6 +235,32 @@ def test_tfrecord_shard_equal_rows():
     assert len(worker4_res) == 40
 
 
+def test_tfrecord_lock_free_connector():
+    """
+    Feature: TFRecordDataset
+    Description: Read the tfrecord files with 4 workers, with the lock free connector disabled and enabled
+    Expectation: The rows are the same and in the same order
+    """
+    logger.info("test_tfrecord_lock_free_connector")
+    tf_files = ["../data/dataset/tf_file_dataset/test1.data", "../data/dataset/tf_file_dataset/test2.data",
+                "../data/dataset/tf_file_dataset/test3.data", "../data/dataset/tf_file_dataset/test4.data"]
+
+    def get_res():
+        ds1 = ds.TFRecordDataset(tf_files, shuffle=False, num_parallel_workers=4)
+        return [data["scalars"][0] for data in ds1.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    assert ds.config.get_enable_lock_free_connector() is False
+    with pytest.raises(TypeError):
+        ds.config.set_enable_lock_free_connector(1)
+    res = get_res()
+    ds.config.set_enable_lock_free_connector(True)
+    assert ds.config.get_enable_lock_free_connector() is True
+    lock_free_res = get_res()
+    ds.config.set_enable_lock_free_connector(False)
+    assert len(res) == 40
+    assert lock_free_res == res
+
+
 def test_tfrecord_no_schema_columns_list():
     logger.info("test_tfrecord_no_schema_columns_list")
     data = ds.TFRecordDataset(FILES, shuffle=False, columns_list=["col_sint16"])
@@ -375,6 +401,7 @@ if __name__ == '__main__':
     test_tfrecord_shuffle()
     test_tfrecord_shard()
     test_tfrecord_shard_equal_rows()
+    test_tfrecord_lock_free_connector()
     test_tfrecord_no_schema_columns_list()
     test_tfrecord_schema_columns_list()
     test_tfrecord_invalid_files()
@@ -0,0 +1,145 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""
+Testing DecodeResize op in DE
+"""
+import numpy as np
+import pytest
+
+import mindspore.dataset as ds
+import mindspore.dataset.vision.c_transforms as vision
+from mindspore.dataset.vision.utils import Inter
+from mindspore import log as logger
+
+DATA_DIR = ["../data/dataset/test_tf_file_3_images/train-0000-of-0001.data"]
+SCHEMA_DIR = "../data/dataset/test_tf_file_3_images/datasetSchema.json"
+
+
+def test_decode_resize_op():
+    """
+    Feature: DecodeResize op
+    Description: Test DecodeResize with DCT downscaling against Decode followed by Resize with the area interpolation
+    Expectation: The output shapes are the same and the images are close
+    """
+    logger.info("test_decode_resize_op")
+    ds.config.set_enable_jpeg_dct_scaling(True)
+
+    data1 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+    data1 = data1.map(operations=vision.DecodeResize((224, 224), Inter.AREA), input_columns=["image"])
+
+    data2 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+    data2 = data2.map(operations=[vision.Decode(), vision.Resize((224, 224), Inter.AREA)], input_columns=["image"])
+
+    num_iter = 0
+    for item1, item2 in zip(data1.create_dict_iterator(num_epochs=1, output_numpy=True),
+                            data2.create_dict_iterator(num_epochs=1, output_numpy=True)):
+        image1 = item1["image"]
+        image2 = item2["image"]
+        assert image1.shape == (224, 224, 3)
+        assert image1.shape == image2.shape
+        mean_diff = np.mean(np.abs(image1.astype(np.float32) - image2.astype(np.float32)))
+        logger.info("decode_resize_op_{}, mean diff: {}".format(num_iter + 1, mean_diff))
+        assert mean_diff < 10
+        num_iter += 1
+    assert num_iter == 3
+    ds.config.set_enable_jpeg_dct_scaling(False)
+
+
+def test_decode_resize_op_no_dct_scaling():
+    """
+    Feature: DecodeResize op
+    Description: Test DecodeResize with DCT downscaling disabled, which is the default
+    Expectation: The output is exactly the same as Decode followed by Resize
+    """
+    logger.info("test_decode_resize_op_no_dct_scaling")
+    assert ds.config.get_enable_jpeg_dct_scaling() is False
+
+    data1 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+    data1 = data1.map(operations=vision.DecodeResize((224, 224)), input_columns=["image"])
+
+    data2 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+    data2 = data2.map(operations=[vision.Decode(), vision.Resize((224, 224))], input_columns=["image"])
+
+    num_iter = 0
+    for item1, item2 in zip(data1.create_dict_iterator(num_epochs=1, output_numpy=True),
+                            data2.create_dict_iterator(num_epochs=1, output_numpy=True)):
+        np.testing.assert_array_equal(item1["image"], item2["image"])
+        num_iter += 1
+    assert num_iter == 3
+
+
+def test_decode_resize_op_keep_ratio():
+    """
+    Feature: DecodeResize op
+    Description: Test DecodeResize with a single size
+    Expectation: The smaller edge is resized to the size and the aspect ratio is kept
+    """
+    logger.info("test_decode_resize_op_keep_ratio")
+
+    data1 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+    data1 = data1.map(operations=vision.DecodeResize(256), input_columns=["image"])
+
+    data2 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+    data2 = data2.map(operations=[vision.Decode(), vision.Resize(256)], input_columns=["image"])
+
+    for item1, item2 in zip(data1.create_dict_iterator(num_epochs=1, output_numpy=True),
+                            data2.create_dict_iterator(num_epochs=1, output_numpy=True)):
+        assert item1["image"].shape == item2["image"].shape
+
+
+def test_decode_resize_op_invalid_input():
+    """
+    Feature: DecodeResize op
+    Description: Test DecodeResize with invalid size
+    Expectation: Error is raised as expected
+    """
+    logger.info("test_decode_resize_op_invalid_input")
+
+    with pytest.raises(ValueError):
+        vision.DecodeResize(0)
+    with pytest.raises(TypeError):
+        vision.DecodeResize("224")
+
+
+def test_jpeg_dct_scaling_config():
+    """
+    Feature: RandomCropDecodeResize op
+    Description: Test RandomCropDecodeResize with DCT downscaling of the JPEG decoder enabled
+    Expectation: The config can be set, and the output has the target size
+    """
+    logger.info("test_jpeg_dct_scaling_config")
+
+    assert ds.config.get_enable_jpeg_dct_scaling() is False
+    with pytest.raises(TypeError):
+        ds.config.set_enable_jpeg_dct_scaling(1)
+    ds.config.set_enable_jpeg_dct_scaling(True)
+    assert ds.config.get_enable_jpeg_dct_scaling() is True
+
+    data = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+    data = data.map(operations=vision.RandomCropDecodeResize((256, 512), (1, 1), (0.5, 0.5)), input_columns=["image"])
+    num_iter = 0
+    for item in data.create_dict_iterator(num_epochs=1, output_numpy=True):
+        assert item["image"].shape == (256, 512, 3)
+        num_iter += 1
+    assert num_iter == 3
+    ds.config.set_enable_jpeg_dct_scaling(False)
+
+
+if __name__ == "__main__":
+    test_decode_resize_op()
+    test_decode_resize_op_no_dct_scaling()
+    test_decode_resize_op_keep_ratio()
+    test_decode_resize_op_invalid_input()
+    test_jpeg_dct_scaling_config()
@@ -29,6 +29,7 @@ import mindspore.dataset.vision.c_transforms as vision
 from mindspore import log as logger
 from mindspore.dataset.vision import Inter
 from mindspore.mindrecord import FileWriter
+from mindspore.mindrecord.common.exceptions import ParamTypeError, ParamValueError
 
 FILES_NUM = 4
 CV_DIR_NAME = "../data/mindrecord/testImageNetData"
@@ -2713,6 +2714,222 @@ def test_for_loop_dataset_iterator(add_and_remove_nlp_compress_file):
     assert (next(dataset_iter3)["array_a"] == data[4]["array_a"]).all()
     assert (next(dataset_iter3)["array_a"] == data[5]["array_a"]).all()
 
+def test_cv_minddataset_column_page():
+    """
+    Feature: Column page of MindRecord
+    Description: Write the same data with and without column pages in two batches, then read them with columns_list
+        and with PKSampler
+    Expectation: The output is the same
+    """
+    file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    file_names = [file_name + "_raw", file_name + "_column"]
+    for x in file_names:
+        if os.path.exists(x):
+            os.remove(x)
+        if os.path.exists("{}.db".format(x)):
+            os.remove("{}.db".format(x))
+    data = get_data(CV_DIR_NAME)
+    cv_schema_json = {"id": {"type": "int32"},
+                      "file_name": {"type": "string"},
+                      "label": {"type": "int32"},
+                      "data": {"type": "bytes"}}
+    for column_page, x in zip([False, True], file_names):
+        writer = FileWriter(x)
+        # one image per page, so there are several column pages
+        writer.set_page_size(1 << 17)
+        writer.set_column_page(column_page)
+        writer.add_schema(cv_schema_json, "img_schema")
+        writer.add_index(["label"])
+        writer.write_raw_data(data[:4])
+        writer.write_raw_data(data[4:])
+        writer.commit()
+
+    with pytest.raises(ParamTypeError):
+        FileWriter(file_name + "_invalid").set_column_page(1)
+
+    def read(x, columns_list, sampler=None):
+        data_set = ds.MindDataset(x, columns_list, shuffle=None if sampler else False, sampler=sampler)
+        return [item for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    try:
+        for columns_list in [["data", "label"], ["file_name", "id", "data"], None]:
+            rows_raw = read(file_names[0], columns_list)
+            rows_column = read(file_names[1], columns_list)
+            assert len(rows_raw) == len(rows_column) == 10
+            for row_raw, row_column in zip(rows_raw, rows_column):
+                assert row_raw.keys() == row_column.keys()
+                for key in row_raw:
+                    assert (row_raw[key] == row_column[key]).all()
+
+        rows_column = read(file_names[1], ["file_name", "label", "data"], ds.PKSampler(1, None, False, 'label'))
+        assert len(rows_column) == 10
+        assert sorted([item["label"] for item in rows_column]) == sorted([item["label"] for item in data])
+    finally:
+        for x in file_names:
+            os.remove(x)
+            os.remove("{}.db".format(x))
+
+def test_cv_minddataset_mmap_index():
+    """
+    Feature: Mmap index of MindRecord
+    Description: Write the same data with and without the mmap index, then read them sequentially, with PKSampler
+        and with num_shards
+    Expectation: The output is the same
+    """
+    file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    file_names = [file_name + "_sqlite", file_name + "_mmap"]
+    for x in file_names:
+        for suffix in ["", ".db", ".idx"]:
+            if os.path.exists(x + suffix):
+                os.remove(x + suffix)
+    data = get_data(CV_DIR_NAME)
+    cv_schema_json = {"id": {"type": "int32"},
+                      "file_name": {"type": "string"},
+                      "label": {"type": "int32"},
+                      "data": {"type": "bytes"}}
+    for mmap_index, x in zip([False, True], file_names):
+        writer = FileWriter(x)
+        writer.set_mmap_index(mmap_index)
+        writer.add_schema(cv_schema_json, "img_schema")
+        writer.add_index(["file_name", "label"])
+        writer.write_raw_data(data)
+        writer.commit()
+    assert not os.path.exists(file_names[0] + ".idx")
+    assert os.path.exists(file_names[1] + ".idx")
+
+    with pytest.raises(ParamTypeError):
+        FileWriter(file_name + "_invalid").set_mmap_index(1)
+
+    def read(x, sampler=None, num_shards=None, shard_id=None):
+        data_set = ds.MindDataset(x, ["file_name", "label", "data"], shuffle=False, sampler=sampler,
+                                  num_shards=num_shards, shard_id=shard_id)
+        return [item for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    def check_same(rows_sqlite, rows_mmap):
+        assert len(rows_sqlite) == len(rows_mmap)
+        for row_sqlite, row_mmap in zip(rows_sqlite, rows_mmap):
+            for key in row_sqlite:
+                assert (row_sqlite[key] == row_mmap[key]).all()
+
+    try:
+        check_same(read(file_names[0]), read(file_names[1]))
+        check_same(read(file_names[0], num_shards=3, shard_id=1), read(file_names[1], num_shards=3, shard_id=1))
+        rows_mmap = read(file_names[1], ds.PKSampler(2, None, False, 'label'))
+        rows_sqlite = read(file_names[0], ds.PKSampler(2, None, False, 'label'))
+        assert sorted([item["label"] for item in rows_mmap]) == sorted([item["label"] for item in rows_sqlite])
+    finally:
+        for x in file_names:
+            for suffix in ["", ".db", ".idx"]:
+                if os.path.exists(x + suffix):
+                    os.remove(x + suffix)
+
+def test_cv_minddataset_pipeline_writer():
+    """
+    Feature: Pipeline of FileWriter
+    Description: Write the same data into two shards with and without the pipeline in several batches, then read them
+        sequentially and with PKSampler
+    Expectation: The index is generated while writing, and the output is the same
+    """
+    file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    file_names = [file_name + "_serial", file_name + "_pipeline"]
+    shard_num = 2
+
+    def remove_files():
+        for x in file_names:
+            for i in range(shard_num):
+                for suffix in ["", ".db", ".idx"]:
+                    if os.path.exists(x + str(i) + suffix):
+                        os.remove(x + str(i) + suffix)
+
+    remove_files()
+    data = get_data(CV_DIR_NAME)
+    cv_schema_json = {"id": {"type": "int32"},
+                      "file_name": {"type": "string"},
+                      "label": {"type": "int32"},
+                      "data": {"type": "bytes"}}
+    for pipeline, x in zip([False, True], file_names):
+        writer = FileWriter(x, shard_num)
+        # one image per page and a tiny memory limit, so the batches wait for each other
+        writer.set_page_size(1 << 17)
+        writer.set_pipeline(pipeline, 1 << 16)
+        writer.set_mmap_index(True)
+        writer.add_schema(cv_schema_json, "img_schema")
+        writer.add_index(["file_name", "label"])
+        for i in range(0, len(data), 3):
+            writer.write_raw_data(data[i:i + 3])
+        writer.commit()
+        for i in range(shard_num):
+            assert os.path.exists(x + str(i) + ".db")
+            assert os.path.exists(x + str(i) + ".idx")
+
+    with pytest.raises(ParamTypeError):
+        FileWriter(file_name + "_invalid").set_pipeline(1)
+    with pytest.raises(ParamValueError):
+        FileWriter(file_name + "_invalid").set_pipeline(True, 0)
+
+    def read(x, sampler=None):
+        data_set = ds.MindDataset(x + "0", ["file_name", "label", "data"], shuffle=None if sampler else False,
+                                  sampler=sampler)
+        return [item for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    try:
+        rows_serial = read(file_names[0])
+        rows_pipeline = read(file_names[1])
+        assert len(rows_serial) == len(rows_pipeline) == 10
+        for row_serial, row_pipeline in zip(rows_serial, rows_pipeline):
+            for key in row_serial:
+                assert (row_serial[key] == row_pipeline[key]).all()
+        rows_pipeline = read(file_names[1], ds.PKSampler(1, None, False, 'label'))
+        assert sorted([item["label"] for item in rows_pipeline]) == sorted([item["label"] for item in data])
+    finally:
+        remove_files()
+
+def test_cv_minddataset_read_ahead(add_and_remove_cv_file):
+    """
+    Feature: Read ahead of MindDataset
+    Description: Read the shuffled samples of two epochs and a padded sample with and without read ahead threads
+    Expectation: The output is the same
+    """
+    columns_list = ["data", "file_name", "label"]
+    file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    padded_sample = get_data(CV_DIR_NAME)[0]
+    padded_sample['label'] = -1
+    padded_sample['file_name'] = 'dummy.jpg'
+    original_threads = ds.config.get_mindrecord_read_ahead_threads()
+    original_size = ds.config.get_mindrecord_read_ahead_size()
+    original_seed = ds.config.get_seed()
+
+    def read(num_threads):
+        ds.config.set_mindrecord_read_ahead_threads(num_threads)
+        ds.config.set_seed(1)
+        data_set = ds.MindDataset(file_name + "0", columns_list, 4, shuffle=True, padded_sample=padded_sample,
+                                  num_padded=2, num_shards=3, shard_id=0)
+        rows = []
+        for _ in range(2):
+            rows.extend(data_set.create_dict_iterator(num_epochs=1, output_numpy=True))
+        return rows
+
+    try:
+        rows = read(0)
+        ds.config.set_mindrecord_read_ahead_size(1)
+        rows_read_ahead = read(4)
+        assert len(rows) == len(rows_read_ahead) == 8
+        for row, row_read_ahead in zip(rows, rows_read_ahead):
+            for key in columns_list:
+                assert (row[key] == row_read_ahead[key]).all()
+    finally:
+        ds.config.set_mindrecord_read_ahead_threads(original_threads)
+        ds.config.set_mindrecord_read_ahead_size(original_size)
+        ds.config.set_seed(original_seed)
+
+    with pytest.raises(TypeError):
+        ds.config.set_mindrecord_read_ahead_threads(True)
+    with pytest.raises(ValueError):
+        ds.config.set_mindrecord_read_ahead_threads(-1)
+    with pytest.raises(ValueError):
+        ds.config.set_mindrecord_read_ahead_size(0)
+
+
 if __name__ == '__main__':
     test_nlp_compress_data(add_and_remove_nlp_compress_file)
     test_nlp_compress_data_old_version(add_and_remove_nlp_compress_file)
@@ -2750,3 +2967,7 @@ if __name__ == '__main__':
     test_distributed_shuffle_with_multi_epochs(create_multi_mindrecord_files)
     test_field_is_null_numpy()
     test_for_loop_dataset_iterator(add_and_remove_nlp_compress_file)
+    test_cv_minddataset_column_page()
+    test_cv_minddataset_mmap_index()
+    test_cv_minddataset_read_ahead(add_and_remove_cv_file)
+    test_cv_minddataset_pipeline_writer()